@@ -0,0 +1,427 @@
+/**
+ * @file mini_so_bench.cpp
+ * @brief Mini SObjectizer 벤치마크 - 재현 가능한 처리량/지연 시나리오 (JSON 출력)
+ *
+ * 시나리오:
+ * - ping_pong:        두 Agent 간 왕복 지연 (p50/p99)
+ * - broadcast_1_to_N: 한 발신자 → N 수신자 복사 브로드캐스트 / 공유 payload 브로드캐스트
+ * - fan_in_N_to_1:    N 발신자 → 한 수신자
+ * - send_copy / send_pooled: 최대 크기에 가까운 payload의 복사 전송 vs 풀 전송
+ * - queue_saturation: 가득 찬 메일박스에 대한 push 비용과 비우기 처리량
+ * - fan_in_N_to_1_threads: N개 생산자 스레드가 동시에 전송, 메인 스레드가 소비 (실제 경합)
+ * - dispatch_virtual / dispatch_typed: 같은 메시지 흐름을 가상 handle_message Agent와 TypedAgent로 처리
+ * - replay:<파일>: 타겟 trace 덤프(trace::dump_all)를 벤치 Agent에 재생 (--replay, host/replay.h).
+ *   캡처 대상 Agent는 처음 나온 순서대로 peers에 대응하고, 모르는 타입은 0 payload 이미지로 보냄.
+ *   p50/p99는 큐 대기 시간(MINI_SO_ENABLE_LATENCY_HISTOGRAMS 빌드, mini_so_bench_replay),
+ *   queue_high_water는 대상 메일박스 최대 대기 수
+ *
+ * 빌드 설정(MINI_SO_MAX_QUEUE_SIZE, MINI_SO_MAX_MESSAGE_SIZE 등)은 JSON "config"에 기록되며
+ * bench/CMakeLists.txt가 설정 조합별 실행 파일을 만듦.
+ *
+ *     mini_so_bench [--iterations N] [--out results.json]
+ *     mini_so_bench_replay --replay field.bin [--replay more.bin] [--pacing original|fast] [--source ID]
+ */
+
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#include "mini_sobjectizer/host/replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mini_so;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+#ifndef MINI_SO_BENCH_BACKEND
+#define MINI_SO_BENCH_BACKEND "mock"
+#endif
+
+constexpr std::size_t PEERS = 8;  // broadcast/fan-in 상대 수 (드라이버 Agent 제외)
+static_assert(PEERS + 2 <= MINI_SO_MAX_AGENTS, "Benchmark needs PEERS + 2 agents");
+
+struct Ping { uint32_t seq; };
+struct Pong { uint32_t seq; };
+struct Sample { uint32_t seq; uint32_t value; };
+
+// 복사/풀 비교용 - 메일박스 레코드에 들어가는 가장 큰 payload
+struct Bulk {
+    uint8_t bytes[MINI_SO_MAX_MESSAGE_SIZE - sizeof(MessageBase)];
+};
+static_assert(sizeof(Message<Bulk>) <= MINI_SO_MAX_MESSAGE_SIZE, "Bulk payload must fit a mailbox record");
+
+// 모든 시나리오에서 재사용하는 Agent (Agent id는 재사용되지 않으므로 한 번만 등록)
+class BenchAgent : public Agent {
+public:
+    bool echo = false;       // Ping을 받으면 발신자에게 Pong
+    uint64_t received = 0;
+    uint32_t last_pong = 0;
+
+    bool handle_message(const MessageBase& msg) noexcept override {
+        ++received;
+        if (msg.type_id() == MESSAGE_TYPE_ID(Ping)) {
+            if (echo) {
+                const auto& ping = static_cast<const Message<Ping>&>(msg).data;
+                Environment::instance().send_message(id(), msg.sender_id(), Pong{ping.seq});
+            }
+        } else if (msg.type_id() == MESSAGE_TYPE_ID(Pong)) {
+            last_pong = static_cast<const Message<Pong>&>(msg).data.seq;
+        }
+        return true;
+    }
+};
+
+// dispatch_typed 비교용 - BenchAgent와 같은 일을 정적 디스패치로
+class TypedBenchAgent : public TypedAgent<TypedBenchAgent, Ping, Pong, Sample> {
+public:
+    uint64_t received = 0;
+    uint32_t last_pong = 0;
+    uint64_t checksum = 0;
+
+    void on(const Ping&) noexcept { ++received; }
+    void on(const Pong& pong) noexcept {
+        ++received;
+        last_pong = pong.seq;
+    }
+    void on(const Sample& sample) noexcept {
+        ++received;
+        checksum += sample.value;
+    }
+};
+
+struct Result {
+    const char* name;
+    uint64_t operations;   // 메시지(또는 왕복) 수
+    double seconds;
+    double p50_ns;         // 0 = 분포 없음
+    double p99_ns;
+    uint64_t dropped;
+    uint32_t high_water = 0;   // 메일박스 최대 대기 수 (replay만)
+};
+
+struct Bench {
+    Environment& env = Environment::instance();
+    BenchAgent driver;
+    BenchAgent peers[PEERS];
+    TypedBenchAgent typed;
+    std::vector<Result> results;
+    std::deque<std::string> names;   // replay 결과 이름 (deque - 추가해도 c_str 유지)
+    uint32_t iterations;
+
+    explicit Bench(uint32_t n) noexcept : iterations(n) {
+        env.initialize();
+        env.register_agent(&driver);
+        for (auto& peer : peers) env.register_agent(&peer);
+        env.register_agent(&typed);
+    }
+
+    void reset() noexcept {
+        env.process_all_messages();
+        driver.received = 0;
+        driver.echo = false;
+        for (auto& peer : peers) {
+            peer.received = 0;
+            peer.echo = false;
+        }
+        typed.received = 0;
+    }
+
+    uint64_t peer_received() const noexcept {
+        uint64_t total = 0;
+        for (const auto& peer : peers) total += peer.received;
+        return total;
+    }
+
+    // 메일박스가 차기 전에 처리하도록 배치 단위로 전송 (용량의 절반)
+    static constexpr uint32_t batch_for(std::size_t record_payload) noexcept {
+        const std::size_t fit = MINI_SO_MAILBOX_BYTES / MessageQueue::record_bytes(record_payload) / 2;
+        return static_cast<uint32_t>(fit > 0 ? fit : 1);
+    }
+
+    template<typename Fn>
+    static double seconds_of(Fn&& fn) noexcept {
+        const auto start = Clock::now();
+        fn();
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    void ping_pong() noexcept {
+        reset();
+        BenchAgent& echo = peers[0];
+        echo.echo = true;
+
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        const double total = seconds_of([&]() noexcept {
+            for (uint32_t i = 0; i < iterations; ++i) {
+                const auto start = Clock::now();
+                env.send_message(driver.id(), echo.id(), Ping{i});
+                env.process_all_messages();
+                samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+            }
+        });
+
+        std::sort(samples.begin(), samples.end());
+        const double p50 = samples.empty() ? 0 : samples[samples.size() / 2];
+        const double p99 = samples.empty() ? 0 : samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        results.push_back(Result{"ping_pong", iterations, total, p50, p99, iterations - driver.received});
+    }
+
+    void broadcast(bool shared) noexcept {
+        reset();
+        const uint32_t batch = batch_for(sizeof(Message<Sample>));
+        const double total = seconds_of([&]() noexcept {
+            for (uint32_t i = 0; i < iterations; ) {
+                for (uint32_t b = 0; b < batch && i < iterations; ++b, ++i) {
+                    if (shared) {
+                        env.broadcast_pooled_message(driver.id(), Sample{i, b});
+                    } else {
+                        env.broadcast_message(driver.id(), Sample{i, b});
+                    }
+                }
+                env.process_all_messages();
+            }
+        });
+        const uint64_t expected = uint64_t{iterations} * PEERS;
+        results.push_back(Result{shared ? "broadcast_1_to_N_shared" : "broadcast_1_to_N", peer_received(), total, 0, 0,
+                                 expected - peer_received()});
+    }
+
+    void fan_in() noexcept {
+        reset();
+        const uint32_t batch = batch_for(sizeof(Message<Sample>));
+        const double total = seconds_of([&]() noexcept {
+            for (uint32_t i = 0; i < iterations; ) {
+                for (uint32_t b = 0; b < batch && i < iterations; ++b, ++i) {
+                    env.send_message(peers[i % PEERS].id(), driver.id(), Sample{i, b});
+                }
+                env.process_all_messages();
+            }
+        });
+        results.push_back(Result{"fan_in_N_to_1", driver.received, total, 0, 0, iterations - driver.received});
+    }
+
+    void send_bulk(bool pooled) noexcept {
+        reset();
+        Bulk bulk;
+        std::memset(bulk.bytes, 0xA5, sizeof(bulk.bytes));
+        const uint32_t batch = batch_for(pooled ? sizeof(detail::MessageHandle) : sizeof(Message<Bulk>));
+        BenchAgent& sink = peers[0];
+        const double total = seconds_of([&]() noexcept {
+            for (uint32_t i = 0; i < iterations; ) {
+                for (uint32_t b = 0; b < batch && i < iterations; ++b, ++i) {
+                    if (pooled) {
+                        env.send_pooled_message(driver.id(), sink.id(), bulk);
+                    } else {
+                        env.send_message(driver.id(), sink.id(), bulk);
+                    }
+                }
+                env.process_all_messages();
+            }
+        });
+        results.push_back(Result{pooled ? "send_pooled" : "send_copy", sink.received, total, 0, 0,
+                                 iterations - sink.received});
+    }
+
+    // 메일박스를 채운 뒤 iterations번 push (모두 QUEUE_FULL) 비용, 이어서 비우기
+    void queue_saturation() noexcept {
+        reset();
+        BenchAgent& sink = peers[0];
+        uint32_t accepted = 0;
+        while (env.send_message(driver.id(), sink.id(), Sample{accepted, 0})) ++accepted;
+
+        const OverloadStats before = sink.overload_stats();
+        const double full = seconds_of([&]() noexcept {
+            for (uint32_t i = 0; i < iterations; ++i) {
+                env.send_message(driver.id(), sink.id(), Sample{i, 0});
+            }
+        });
+        const uint64_t dropped = sink.overload_stats().dropped - before.dropped;
+        results.push_back(Result{"queue_saturation_push_full", iterations, full, 0, 0, dropped});
+
+        const double drain = seconds_of([&]() noexcept { env.process_all_messages(); });
+        results.push_back(Result{"queue_saturation_drain", sink.received, drain, 0, 0, 0});
+    }
+
+    // 생산자 스레드별로 QUEUE_FULL이면 양보 후 재시도 ("dropped" = 재시도 횟수)
+    void fan_in_threads() noexcept {
+        reset();
+        const uint32_t per_producer = (iterations + PEERS - 1) / PEERS;
+        const uint64_t total = uint64_t{per_producer} * PEERS;
+        std::atomic<uint64_t> retries{0};
+
+        const double seconds = seconds_of([&]() noexcept {
+            std::vector<std::thread> producers;
+            producers.reserve(PEERS);
+            for (std::size_t p = 0; p < PEERS; ++p) {
+                producers.emplace_back([&, p]() noexcept {
+                    uint64_t local_retries = 0;
+                    for (uint32_t i = 0; i < per_producer; ++i) {
+                        while (!env.send_message(peers[p].id(), driver.id(), Sample{i, static_cast<uint32_t>(p)})) {
+                            ++local_retries;
+                            std::this_thread::yield();
+                        }
+                    }
+                    retries.fetch_add(local_retries, std::memory_order_relaxed);
+                });
+            }
+            while (driver.received < total) {
+                env.process_all_messages();
+                std::this_thread::yield();
+            }
+            for (auto& producer : producers) producer.join();
+        });
+        results.push_back(Result{"fan_in_N_to_1_threads", driver.received, seconds, 0, 0,
+                                 retries.load(std::memory_order_relaxed)});
+    }
+
+    // 전송 경로는 같고 수신 측 디스패치만 다름 (가상 handle_message + 타입 분기 vs TypedAgent)
+    template<typename Sink>
+    void dispatch(const char* name, Sink& sink) noexcept {
+        reset();
+        const uint32_t batch = batch_for(sizeof(Message<Sample>));
+        const double total = seconds_of([&]() noexcept {
+            for (uint32_t i = 0; i < iterations; ) {
+                for (uint32_t b = 0; b < batch && i < iterations; ++b, ++i) {
+                    env.send_message(driver.id(), sink.id(), Sample{i, i});
+                }
+                env.process_all_messages();
+            }
+        });
+        results.push_back(Result{name, sink.received, total, 0, 0, iterations - sink.received});
+    }
+
+    void run_all() noexcept {
+        ping_pong();
+        broadcast(false);
+        broadcast(true);
+        fan_in();
+        send_bulk(false);
+        send_bulk(true);
+        queue_saturation();
+        fan_in_threads();
+        dispatch("dispatch_virtual", peers[0]);
+        dispatch("dispatch_typed", typed);
+    }
+
+    // 캡처를 재생해 처리량/큐 대기 분위/high-water 기록. false: 덤프를 읽을 수 없음
+    bool replay(const char* path, replay::Pacing pacing, const std::vector<AgentId>& sources) noexcept {
+        replay::Capture capture;
+        if (!capture.load_file(path)) return false;
+        reset();
+
+        replay::Replayer replayer(env);
+        replayer.add_type<Ping>();
+        replayer.add_type<Pong>();
+        replayer.add_type<Sample>();
+        replayer.set_raw_fallback(0);
+        for (AgentId source : sources) replayer.add_source(source);
+
+        // 캡처 대상 Agent → peers (처음 나온 순서, PEERS개를 넘으면 순환)
+        std::vector<AgentId> targets;
+        for (const replay::Event& event : capture.events()) {
+            if (event.target == INVALID_AGENT_ID ||
+                std::find(targets.begin(), targets.end(), event.target) != targets.end()) {
+                continue;
+            }
+            replayer.map_agent(event.target, peers[targets.size() % PEERS].id());
+            targets.push_back(event.target);
+        }
+
+        const replay::Report report = replayer.run(capture, pacing);
+        const char* base = std::strrchr(path, '/');
+        names.push_back(std::string("replay:") + (base ? base + 1 : path));
+        results.push_back(Result{names.back().c_str(), report.sent, report.seconds,
+                                 report.queue.p50_us * 1000.0, report.queue.p99_us * 1000.0,
+                                 report.dropped, report.high_water});
+        return true;
+    }
+
+    void write_json(FILE* out) const noexcept {
+        std::fprintf(out, "{\n  \"config\": {\n");
+        std::fprintf(out, "    \"max_agents\": %d,\n", MINI_SO_MAX_AGENTS);
+        std::fprintf(out, "    \"max_queue_size\": %d,\n", MINI_SO_MAX_QUEUE_SIZE);
+        std::fprintf(out, "    \"max_message_size\": %d,\n", MINI_SO_MAX_MESSAGE_SIZE);
+        std::fprintf(out, "    \"mailbox_bytes\": %lu,\n", static_cast<unsigned long>(MINI_SO_MAILBOX_BYTES));
+        std::fprintf(out, "    \"queue_policy\": %d,\n", MINI_SO_QUEUE_POLICY);
+        std::fprintf(out, "    \"metrics\": %d,\n", MINI_SO_ENABLE_METRICS);
+        std::fprintf(out, "    \"latency_histograms\": %d,\n", MINI_SO_ENABLE_LATENCY_HISTOGRAMS);
+        std::fprintf(out, "    \"host_backend\": \"%s\",\n", MINI_SO_BENCH_BACKEND);
+        std::fprintf(out, "    \"iterations\": %u,\n", iterations);
+        std::fprintf(out, "    \"compiler\": \"%s\"\n  },\n", __VERSION__);
+        std::fprintf(out, "  \"results\": [\n");
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            const double ns_per_op = r.operations > 0 ? r.seconds * 1e9 / static_cast<double>(r.operations) : 0;
+            const double ops_per_sec = r.seconds > 0 ? static_cast<double>(r.operations) / r.seconds : 0;
+            std::fprintf(out,
+                         "    {\"name\": \"%s\", \"operations\": %llu, \"seconds\": %.6f, \"ns_per_op\": %.1f, "
+                         "\"ops_per_sec\": %.0f, \"p50_ns\": %.1f, \"p99_ns\": %.1f, \"dropped\": %llu, "
+                         "\"queue_high_water\": %u}%s\n",
+                         r.name, static_cast<unsigned long long>(r.operations), r.seconds, ns_per_op, ops_per_sec,
+                         r.p50_ns, r.p99_ns, static_cast<unsigned long long>(r.dropped), r.high_water,
+                         i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(out, "  ]\n}\n");
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t iterations = 20000;
+    const char* out_path = nullptr;
+    std::vector<const char*> replays;
+    std::vector<AgentId> sources;
+    replay::Pacing pacing = replay::Pacing::AS_FAST_AS_POSSIBLE;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replays.push_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--source") == 0 && i + 1 < argc) {
+            sources.push_back(static_cast<AgentId>(std::strtoul(argv[++i], nullptr, 0)));
+        } else if (std::strcmp(argv[i], "--pacing") == 0 && i + 1 < argc) {
+            pacing = std::strcmp(argv[++i], "original") == 0 ? replay::Pacing::ORIGINAL
+                                                             : replay::Pacing::AS_FAST_AS_POSSIBLE;
+        } else {
+            std::fprintf(stderr, "usage: %s [--iterations N] [--out results.json] "
+                                 "[--replay dump.bin]... [--pacing original|fast] [--source ID]...\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iterations == 0) iterations = 1;
+
+    static Bench bench(iterations);
+
+    // 재생 모드: 캡처만 실행 (합성 시나리오와 결과를 섞지 않음)
+    if (!replays.empty()) {
+        for (const char* path : replays) {
+            if (!bench.replay(path, pacing, sources)) {
+                std::fprintf(stderr, "cannot read trace dump %s\n", path);
+                return 1;
+            }
+        }
+    } else {
+        bench.run_all();
+    }
+
+    FILE* out = out_path ? std::fopen(out_path, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot open %s\n", out_path);
+        return 1;
+    }
+    bench.write_json(out);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
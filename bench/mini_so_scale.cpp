@@ -0,0 +1,438 @@
+/**
+ * @file mini_so_scale.cpp
+ * @brief Mini SObjectizer 확장성 곡선 - 부하 생성기/싱크 Agent로 포화점과 지연 knee를 찾음 (CSV 출력)
+ *
+ * LoadGenerator(생산자 스레드가 구동하는 Agent)가 open-loop 속도로 LoadSink Agent들에게 보내고,
+ * 싱크가 payload의 전송 시각으로 end-to-end 지연을 기록. 기준점에서 한 차원씩 바꾸는 sweep:
+ * - rate:    전송 속도 (msg/s, 기하 증가, --max-rate까지) - 싱크 1개
+ * - payload: payload 크기 (16바이트 ~ 메일박스 레코드 최대) - closed loop (가득 차면 양보 후 재시도)
+ * - fanout:  메시지마다 보내는 싱크 수 (1 ~ MINI_SO_MAX_AGENTS-1), 같은 원본 속도
+ * - agents:  싱크 수 (1 ~ MINI_SO_MAX_AGENTS-1), 같은 총 속도를 round-robin 분배
+ *
+ * 소비 모드(디스패처 변형)마다 같은 sweep을 반복: env(메인 스레드 process_all_messages),
+ * one_thread, thread_pool(2), work_stealing(2). 큐 정책은 컴파일 타임 설정이라 bench/CMakeLists.txt가
+ * mutex/mpsc/spsc 실행 파일을 따로 만들고 CSV의 queue_policy 열로 합쳐 비교 (SPSC는 env 모드만).
+ *
+ * 각 행: 제공/전송/전달/유실 수, 유실률, 처리량, p50/p99 지연(ns). open-loop sweep에서
+ * 처리량이 제공 속도의 95% 미만이거나 유실률 1% 초과인 첫 점은 saturated=1,
+ * p99가 첫 점의 --knee-factor배(기본 4)를 넘는 첫 점은 knee=1 (요약은 stderr).
+ *
+ *     mini_so_scale [--window-ms N] [--max-rate R] [--knee-factor F] [--out curves.csv]
+ */
+
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#if MINI_SO_QUEUE_POLICY != MINI_SO_QUEUE_SPSC
+#include "mini_sobjectizer/dispatcher/dispatcher.h"
+#include "mini_sobjectizer/dispatcher/work_stealing_dispatcher.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace mini_so;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+#ifndef MINI_SO_BENCH_BACKEND
+#define MINI_SO_BENCH_BACKEND "sim"
+#endif
+
+inline uint64_t now_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count());
+}
+
+// 모든 payload 크기가 공유하는 앞부분 - 싱크는 타입별로 캐스트해 이 부분만 읽음
+struct LoadStamp {
+    uint64_t sent_ns;
+    uint32_t seq;
+    uint32_t reserved;
+};
+
+template<std::size_t Bytes>
+struct Load {
+    static_assert(Bytes >= sizeof(LoadStamp), "Load payload must hold the stamp");
+    LoadStamp stamp;
+    uint8_t fill[Bytes - sizeof(LoadStamp) > 0 ? Bytes - sizeof(LoadStamp) : 1];
+};
+
+// 메일박스 레코드에 들어가는 가장 큰 8의 배수 payload
+constexpr std::size_t MAX_PAYLOAD = (MINI_SO_MAX_MESSAGE_SIZE - sizeof(MessageBase)) & ~std::size_t{7};
+static_assert(MAX_PAYLOAD >= 16, "MINI_SO_MAX_MESSAGE_SIZE too small for the scale benchmark");
+constexpr std::size_t mid_payload(std::size_t want) noexcept { return want < MAX_PAYLOAD ? want : MAX_PAYLOAD; }
+
+template<std::size_t Bytes>
+bool send_load(Environment& env, AgentId from, AgentId to, uint32_t seq) noexcept {
+    Load<Bytes> load{};
+    load.stamp.sent_ns = now_ns();
+    load.stamp.seq = seq;
+    return env.try_send(from, to, load) == SendResult::SENT;
+}
+
+template<std::size_t Bytes>
+const LoadStamp* stamp_of(const MessageBase& msg) noexcept {
+    return msg.type_id() == MESSAGE_TYPE_ID(Load<Bytes>) ? &static_cast<const Message<Load<Bytes>>&>(msg).data.stamp
+                                                         : nullptr;
+}
+
+struct PayloadSize {
+    std::size_t bytes;
+    bool (*send)(Environment&, AgentId, AgentId, uint32_t) noexcept;
+};
+
+constexpr PayloadSize PAYLOADS[] = {
+    {16, &send_load<16>},
+    {mid_payload(32), &send_load<mid_payload(32)>},
+    {mid_payload(64), &send_load<mid_payload(64)>},
+    {MAX_PAYLOAD, &send_load<MAX_PAYLOAD>},
+};
+constexpr std::size_t PAYLOAD_COUNT = sizeof(PAYLOADS) / sizeof(PAYLOADS[0]);
+
+// 여러 싱크/워커가 동시에 기록 (ns, 최대 2^32 - 약 4초)
+using NsHistogram = LogLinearHistogram<3, 32>;
+NsHistogram latency;
+
+class LoadSink : public Agent {
+public:
+    std::atomic<uint64_t> received{0};
+
+    bool handle_message(const MessageBase& msg) noexcept override {
+        const LoadStamp* stamp = stamp_of<16>(msg);
+        if (!stamp) stamp = stamp_of<mid_payload(32)>(msg);
+        if (!stamp) stamp = stamp_of<mid_payload(64)>(msg);
+        if (!stamp) stamp = stamp_of<MAX_PAYLOAD>(msg);
+        if (!stamp) return false;
+        const uint64_t elapsed = now_ns() - stamp->sent_ns;
+        latency.record(elapsed < 0xFFFFFFFFu ? static_cast<uint32_t>(elapsed) : 0xFFFFFFFFu);
+        received.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+};
+
+// 수신하지 않는 발신 전용 Agent - 생산자 스레드가 emit()으로 구동
+class LoadGenerator : public Agent {
+public:
+    struct Shape {
+        double rate;              // 원본 메시지/초 (0 = closed loop, 최대 속도)
+        const PayloadSize* payload;
+        std::size_t fanout;       // 메시지마다 보내는 싱크 수
+        std::size_t agents;       // round-robin 대상 싱크 수 (fanout과 함께 쓰지 않음)
+    };
+
+    struct Outcome {
+        uint64_t offered = 0;     // 시도한 전송 (fanout 포함)
+        uint64_t sent = 0;
+        uint64_t dropped = 0;     // open loop: 가득 참 등으로 거부
+        double seconds = 0;
+    };
+
+    bool handle_message(const MessageBase&) noexcept override { return false; }
+
+    Outcome emit(const Shape& shape, LoadSink* const* sinks, std::chrono::nanoseconds window) noexcept {
+        Environment& env = Environment::instance();
+        Outcome outcome;
+        const auto start = Clock::now();
+        const auto end = start + window;
+        uint64_t originals = 0;
+
+        for (auto now = start; now < end; now = Clock::now()) {
+            // open loop: 지금까지 보냈어야 할 수만큼 따라잡음 (늦으면 몰아서)
+            uint64_t due = originals + 1;
+            if (shape.rate > 0) {
+                due = static_cast<uint64_t>(std::chrono::duration<double>(now - start).count() * shape.rate);
+                if (due <= originals) {
+                    std::this_thread::yield();  // 소비 스레드에 코어 양보 (코어가 적은 호스트)
+                    continue;
+                }
+            }
+            for (; originals < due; ++originals) {
+                const std::size_t first = shape.agents > 1 ? originals % shape.agents : 0;
+                for (std::size_t k = 0; k < shape.fanout; ++k) {
+                    const AgentId target = sinks[first + k]->id();
+                    const uint32_t seq = static_cast<uint32_t>(originals);
+                    ++outcome.offered;
+                    bool sent = shape.payload->send(env, id(), target, seq);
+                    while (!sent && shape.rate <= 0 && Clock::now() < end) {
+                        std::this_thread::yield();
+                        sent = shape.payload->send(env, id(), target, seq);
+                    }
+                    if (sent) {
+                        ++outcome.sent;
+                    } else {
+                        ++outcome.dropped;
+                    }
+                }
+            }
+        }
+        outcome.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return outcome;
+    }
+};
+
+enum class Mode : uint8_t { ENV, ONE_THREAD, THREAD_POOL, WORK_STEALING };
+
+const char* mode_name(Mode mode) noexcept {
+    switch (mode) {
+        case Mode::ENV: return "env";
+        case Mode::ONE_THREAD: return "one_thread";
+        case Mode::THREAD_POOL: return "thread_pool";
+        case Mode::WORK_STEALING: return "work_stealing";
+    }
+    return "unknown";
+}
+
+const char* queue_policy_name() noexcept {
+    switch (MINI_SO_QUEUE_POLICY) {
+        case MINI_SO_QUEUE_MUTEX: return "mutex";
+        case MINI_SO_QUEUE_SPSC: return "spsc";
+        case MINI_SO_QUEUE_MPSC: return "mpsc";
+    }
+    return "unknown";
+}
+
+struct Row {
+    const char* sweep;
+    LoadGenerator::Shape shape;
+    LoadGenerator::Outcome outcome;
+    uint64_t delivered;
+    uint32_t p50_ns;
+    uint32_t p99_ns;
+    bool saturated = false;
+    bool knee = false;
+
+    double throughput() const noexcept {
+        return outcome.seconds > 0 ? static_cast<double>(delivered) / outcome.seconds : 0;
+    }
+    double drop_rate() const noexcept {
+        return outcome.offered > 0 ? static_cast<double>(outcome.dropped) / static_cast<double>(outcome.offered) : 0;
+    }
+};
+
+struct Scale {
+    Environment& env = Environment::instance();
+    LoadGenerator generator;
+    LoadSink sinks[MINI_SO_MAX_AGENTS];
+    LoadSink* sink_ptrs[MINI_SO_MAX_AGENTS] = {};
+    std::size_t sink_count = 0;
+
+    std::chrono::milliseconds window{20};
+    double max_rate = 12.8e6;
+    double knee_factor = 4.0;
+    std::vector<Row> rows;
+    std::vector<Mode> modes_run;
+    Mode mode = Mode::ENV;
+
+    Scale() noexcept {
+        env.initialize();
+        env.register_agent(&generator);
+        // 남은 슬롯을 모두 싱크로 (sweep은 앞에서부터 필요한 수만 사용)
+        for (auto& sink : sinks) {
+            if (env.agent_count() >= MINI_SO_MAX_AGENTS) break;
+            if (env.register_agent(&sink) == INVALID_AGENT_ID) break;
+            sink_ptrs[sink_count++] = &sink;
+        }
+    }
+
+    uint64_t delivered() const noexcept {
+        uint64_t total = 0;
+        for (std::size_t i = 0; i < sink_count; ++i) total += sink_ptrs[i]->received.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // 생산자 스레드가 window 동안 보내고, env 모드면 메인 스레드가 소비. 끝나면 전달될 때까지(최대 1초) 대기
+    Row measure(const char* sweep, const LoadGenerator::Shape& shape) noexcept {
+        const uint64_t before = delivered();
+        latency.reset();
+        std::atomic<bool> done{false};
+        LoadGenerator::Outcome outcome;
+
+        std::thread producer([&]() noexcept {
+            outcome = generator.emit(shape, sink_ptrs, window);
+            done.store(true, std::memory_order_release);
+        });
+        const auto deadline = Clock::now() + window + std::chrono::seconds(1);
+        auto drained = [&]() noexcept {
+            return done.load(std::memory_order_acquire) && delivered() - before >= outcome.sent;
+        };
+        while (!drained() && Clock::now() < deadline) {
+            if (mode == Mode::ENV) env.process_all_messages();
+            std::this_thread::yield();
+        }
+        producer.join();
+        if (mode == Mode::ENV) env.process_all_messages();
+
+        return Row{sweep, shape, outcome, delivered() - before, latency.value_at(500), latency.value_at(990)};
+    }
+
+    // open-loop 곡선에서 포화점과 knee 표시 (첫 점 기준)
+    void mark(std::size_t first) noexcept {
+        if (first >= rows.size()) return;
+        const uint32_t base_p99 = rows[first].p99_ns > 0 ? rows[first].p99_ns : 1;
+        bool saturated = false;
+        bool knee = false;
+        for (std::size_t i = first; i < rows.size(); ++i) {
+            Row& row = rows[i];
+            if (row.shape.rate <= 0) continue;
+            const double offered_rate = row.shape.rate * static_cast<double>(row.shape.fanout);
+            if (!saturated && (row.throughput() < offered_rate * 0.95 || row.drop_rate() > 0.01)) {
+                row.saturated = saturated = true;
+            }
+            if (!knee && row.p99_ns > base_p99 * knee_factor) {
+                row.knee = knee = true;
+            }
+        }
+    }
+
+    void sweep_rate() noexcept {
+        const std::size_t first = rows.size();
+        for (double rate = 50e3; rate <= max_rate; rate *= 2) {
+            rows.push_back(measure("rate", {rate, &PAYLOADS[0], 1, 1}));
+        }
+        mark(first);
+    }
+
+    void sweep_payload() noexcept {
+        for (const PayloadSize& payload : PAYLOADS) {
+            rows.push_back(measure("payload", {0, &payload, 1, 1}));
+        }
+    }
+
+    void sweep_fanout(double rate) noexcept {
+        const std::size_t first = rows.size();
+        for (std::size_t fanout = 1; fanout <= sink_count; fanout = fanout < sink_count && fanout * 2 > sink_count
+                                                                           ? sink_count : fanout * 2) {
+            rows.push_back(measure("fanout", {rate, &PAYLOADS[0], fanout, 1}));
+            if (fanout == sink_count) break;
+        }
+        mark(first);
+    }
+
+    void sweep_agents(double rate) noexcept {
+        const std::size_t first = rows.size();
+        for (std::size_t agents = 1; agents <= sink_count; agents = agents < sink_count && agents * 2 > sink_count
+                                                                          ? sink_count : agents * 2) {
+            rows.push_back(measure("agents", {rate, &PAYLOADS[0], 1, agents}));
+            if (agents == sink_count) break;
+        }
+        mark(first);
+    }
+
+    void run(Mode m) noexcept {
+        mode = m;
+        modes_run.push_back(m);
+        sweep_rate();
+        sweep_payload();
+        sweep_fanout(200e3);
+        sweep_agents(1e6);
+    }
+
+    template<typename Dispatcher>
+    void run_bound(Mode m, Dispatcher& dispatcher) noexcept {
+        for (std::size_t i = 0; i < sink_count; ++i) dispatcher.bind(*sink_ptrs[i]);
+        dispatcher.start();
+        run(m);
+        dispatcher.stop();
+        for (std::size_t i = 0; i < sink_count; ++i) dispatcher.unbind(*sink_ptrs[i]);
+    }
+
+    void write_csv(FILE* out) const noexcept {
+        std::fprintf(out, "queue_policy,mode,sweep,rate,payload_bytes,fanout,agents,offered,sent,delivered,dropped,"
+                          "drop_rate,throughput,p50_ns,p99_ns,saturated,knee\n");
+        std::size_t index = 0;
+        for (Mode m : modes_run) {
+            // 모드마다 같은 sweep 순서로 행이 쌓임
+            const std::size_t per_mode = rows.size() / modes_run.size();
+            for (std::size_t i = 0; i < per_mode; ++i, ++index) {
+                const Row& row = rows[index];
+                std::fprintf(out, "%s,%s,%s,%.0f,%zu,%zu,%zu,%llu,%llu,%llu,%llu,%.6f,%.0f,%u,%u,%d,%d\n",
+                             queue_policy_name(), mode_name(m), row.sweep, row.shape.rate, row.shape.payload->bytes,
+                             row.shape.fanout, row.shape.agents,
+                             static_cast<unsigned long long>(row.outcome.offered),
+                             static_cast<unsigned long long>(row.outcome.sent),
+                             static_cast<unsigned long long>(row.delivered),
+                             static_cast<unsigned long long>(row.outcome.dropped),
+                             row.drop_rate(), row.throughput(), row.p50_ns, row.p99_ns,
+                             row.saturated ? 1 : 0, row.knee ? 1 : 0);
+            }
+        }
+    }
+
+    void write_summary(FILE* out) const noexcept {
+        const std::size_t per_mode = modes_run.empty() ? 0 : rows.size() / modes_run.size();
+        for (std::size_t m = 0; m < modes_run.size(); ++m) {
+            double best = 0;
+            const Row* saturation = nullptr;
+            const Row* knee = nullptr;
+            for (std::size_t i = m * per_mode; i < (m + 1) * per_mode; ++i) {
+                const Row& row = rows[i];
+                if (std::strcmp(row.sweep, "rate") != 0) continue;
+                best = std::max(best, row.throughput());
+                if (row.saturated && !saturation) saturation = &row;
+                if (row.knee && !knee) knee = &row;
+            }
+            std::fprintf(out, "%s/%s: peak %.0f msg/s, saturation at %.0f msg/s, latency knee at %.0f msg/s\n",
+                         queue_policy_name(), mode_name(modes_run[m]), best,
+                         saturation ? saturation->shape.rate : 0.0, knee ? knee->shape.rate : 0.0);
+        }
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    static Scale scale;
+    const char* out_path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--window-ms") == 0 && i + 1 < argc) {
+            scale.window = std::chrono::milliseconds(std::max(1l, std::strtol(argv[++i], nullptr, 10)));
+        } else if (std::strcmp(argv[i], "--max-rate") == 0 && i + 1 < argc) {
+            scale.max_rate = std::max(50e3, std::strtod(argv[++i], nullptr));
+        } else if (std::strcmp(argv[i], "--knee-factor") == 0 && i + 1 < argc) {
+            scale.knee_factor = std::max(1.0, std::strtod(argv[++i], nullptr));
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--window-ms N] [--max-rate R] [--knee-factor F] [--out curves.csv]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+    if (scale.sink_count == 0) {
+        std::fprintf(stderr, "no free agent slots for sinks (MINI_SO_MAX_AGENTS=%d)\n", MINI_SO_MAX_AGENTS);
+        return 1;
+    }
+
+    scale.run(Mode::ENV);
+#if MINI_SO_QUEUE_POLICY != MINI_SO_QUEUE_SPSC
+    {
+        OneThreadDispatcher one;
+        scale.run_bound(Mode::ONE_THREAD, one);
+    }
+    {
+        ThreadPoolDispatcher<2> pool;
+        scale.run_bound(Mode::THREAD_POOL, pool);
+    }
+    {
+        WorkStealingDispatcher<2> stealing;
+        scale.run_bound(Mode::WORK_STEALING, stealing);
+    }
+#endif
+
+    FILE* out = out_path ? std::fopen(out_path, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot open %s\n", out_path);
+        return 1;
+    }
+    scale.write_csv(out);
+    if (out != stdout) std::fclose(out);
+    scale.write_summary(stderr);
+    return 0;
+}
@@ -0,0 +1,373 @@
+/**
+ * @file bench_firmware.cpp
+ * @brief Mini SObjectizer 타겟 벤치마크 펌웨어 - DWT 사이클 단위 send/dispatch 측정
+ *
+ * 실제 FreeRTOS 포트(ARM_CM3/ARM_CM4F) 위에서 시나리오마다 별도 태스크를 만들어 실행하고
+ * 연산당 사이클(min/avg/max)과 태스크 스택 high-water mark를 JSON으로 보고.
+ * 코드/BSS 크기는 빌드 시 tools/footprint_report.py가 ELF에서 집계.
+ *
+ * 출력: mini_so_bench_write() (기본 ITM stimulus port 0 / SWO, 보드 코드에서 UART로 재정의 가능).
+ * 같은 내용이 mini_so_bench_report[]에 남으므로 디버거에서 mini_so_bench_finished에
+ * 중단점을 걸고 메모리를 덤프해도 됨.
+ */
+
+#include "mini_sobjectizer/mini_sobjectizer.h"
+
+#include <cstring>
+
+using namespace mini_so;
+
+#ifndef MINI_SO_BENCH_ITERATIONS
+#define MINI_SO_BENCH_ITERATIONS 256
+#endif
+
+// 시나리오 태스크 스택 (워드)
+#ifndef MINI_SO_BENCH_STACK_WORDS
+#define MINI_SO_BENCH_STACK_WORDS 512
+#endif
+
+#ifndef MINI_SO_BENCH_REPORT_BYTES
+#define MINI_SO_BENCH_REPORT_BYTES 2048
+#endif
+
+#ifndef MINI_SO_BENCH_CPU
+#define MINI_SO_BENCH_CPU "cortex-m"
+#endif
+
+extern "C" {
+    char mini_so_bench_report[MINI_SO_BENCH_REPORT_BYTES];
+    volatile uint32_t mini_so_bench_done = 0;
+
+    // 보고서 출력 - 보드 코드에서 재정의 (기본: ITM port 0)
+    void mini_so_bench_write(const char* text, std::size_t length) __attribute__((weak));
+
+    // 완료 시 호출 - 디버거 중단점용
+    void mini_so_bench_finished() __attribute__((noinline));
+
+    // 빠른 RAM 배치 영역 경계 (mini_so_placement.ld)
+    extern uint32_t _smini_so_fast, _emini_so_fast;
+}
+
+void mini_so_bench_write(const char* text, std::size_t length) {
+    volatile uint32_t* const itm_port0 = reinterpret_cast<volatile uint32_t*>(0xE0000000u);
+    const uint32_t itm_tcr = *reinterpret_cast<volatile uint32_t*>(0xE0000E80u);
+    const uint32_t itm_ter = *reinterpret_cast<volatile uint32_t*>(0xE0000E00u);
+    if ((itm_tcr & 1u) == 0 || (itm_ter & 1u) == 0) return;  // SWO 연결 없음
+
+    for (std::size_t i = 0; i < length; ++i) {
+        while (*itm_port0 == 0) {}
+        *reinterpret_cast<volatile uint8_t*>(itm_port0) = static_cast<uint8_t>(text[i]);
+    }
+}
+
+void mini_so_bench_finished() {
+    __asm volatile ("" ::: "memory");
+}
+
+namespace {
+
+constexpr std::size_t PEERS = 4;
+constexpr uint32_t ITERATIONS = MINI_SO_BENCH_ITERATIONS;
+
+struct Ping { uint32_t seq; };
+struct Pong { uint32_t seq; };
+struct Sample { uint32_t seq; uint32_t value; };
+
+struct Bulk {
+    uint8_t bytes[MINI_SO_MAX_MESSAGE_SIZE - sizeof(MessageBase)];
+};
+static_assert(sizeof(Message<Bulk>) <= MINI_SO_MAX_MESSAGE_SIZE, "Bulk payload must fit a mailbox record");
+
+class BenchAgent : public Agent {
+public:
+    bool echo = false;
+    uint32_t received = 0;
+
+    bool handle_message(const MessageBase& msg) noexcept override {
+        ++received;
+        if (echo && msg.type_id() == MESSAGE_TYPE_ID(Ping)) {
+            const auto& ping = static_cast<const Message<Ping>&>(msg).data;
+            Environment::instance().send_message(id(), msg.sender_id(), Pong{ping.seq});
+        }
+        return true;
+    }
+};
+
+BenchAgent driver;
+BenchAgent peers[PEERS];
+// dispatch_fast_ram 수신자: 메일박스 버퍼가 MINI_SO_FAST 영역(F407 CCM)에 놓임 (peers[0]과 비교)
+BenchAgent fast_peer;
+alignas(64) uint8_t fast_mailbox[MINI_SO_MAILBOX_BYTES] MINI_SO_MAILBOX_PLACEMENT;
+
+// 연산당 사이클 분포 (측정 오버헤드 제외)
+struct CycleStats {
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+    uint64_t total = 0;
+    uint32_t operations = 0;
+
+    void add(uint32_t cycles, uint32_t ops = 1) noexcept {
+        const uint32_t per_op = cycles / ops;
+        if (per_op < min) min = per_op;
+        if (per_op > max) max = per_op;
+        total += cycles;
+        operations += ops;
+    }
+
+    uint32_t average() const noexcept {
+        return operations > 0 ? static_cast<uint32_t>(total / operations) : 0;
+    }
+};
+
+HiresTime measure_overhead = 0;
+
+inline uint32_t cycles_since(HiresTime start) noexcept {
+    const uint32_t elapsed = hires_now() - start;
+    return elapsed > measure_overhead ? elapsed - measure_overhead : 0;
+}
+
+void calibrate() noexcept {
+    uint32_t best = UINT32_MAX;
+    for (int i = 0; i < 32; ++i) {
+        const HiresTime start = hires_now();
+        const uint32_t elapsed = hires_now() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    measure_overhead = best;
+}
+
+// 메일박스 절반까지 채우고 비움 (무제한 누적으로 QUEUE_FULL이 섞이지 않도록)
+constexpr uint32_t batch_for(std::size_t record_payload) noexcept {
+    return MINI_SO_MAILBOX_BYTES / MessageQueue::record_bytes(record_payload) / 2 > 0
+        ? static_cast<uint32_t>(MINI_SO_MAILBOX_BYTES / MessageQueue::record_bytes(record_payload) / 2)
+        : 1u;
+}
+
+void reset_agents() noexcept {
+    Environment::instance().process_all_messages();
+    driver.echo = false;
+    driver.received = 0;
+    for (auto& peer : peers) {
+        peer.echo = false;
+        peer.received = 0;
+    }
+    fast_peer.received = 0;
+}
+
+void run_send_copy(CycleStats& stats) noexcept {
+    Environment& env = Environment::instance();
+    constexpr uint32_t batch = batch_for(sizeof(Message<Sample>));
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        if (i % batch == 0) env.process_all_messages();
+        const HiresTime start = hires_now();
+        env.send_message(driver.id(), peers[0].id(), Sample{i, 0});
+        stats.add(cycles_since(start));
+    }
+}
+
+void run_send_pooled(CycleStats& stats) noexcept {
+    Environment& env = Environment::instance();
+    static Bulk bulk;
+    std::memset(bulk.bytes, 0xA5, sizeof(bulk.bytes));
+    constexpr uint32_t batch = batch_for(sizeof(detail::MessageHandle));
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        if (i % batch == 0) env.process_all_messages();
+        const HiresTime start = hires_now();
+        env.send_pooled_message(driver.id(), peers[0].id(), bulk);
+        stats.add(cycles_since(start));
+    }
+}
+
+// 한 배치를 처리하는 데 든 사이클을 메시지 수로 나눈 값
+void dispatch_to(BenchAgent& target, CycleStats& stats) noexcept {
+    Environment& env = Environment::instance();
+    constexpr uint32_t batch = batch_for(sizeof(Message<Sample>));
+    for (uint32_t sent = 0; sent < ITERATIONS; ) {
+        uint32_t queued = 0;
+        for (; queued < batch && sent < ITERATIONS; ++queued, ++sent) {
+            env.send_message(driver.id(), target.id(), Sample{sent, 0});
+        }
+        const HiresTime start = hires_now();
+        env.process_all_messages();
+        stats.add(cycles_since(start), queued);
+    }
+}
+
+void run_dispatch(CycleStats& stats) noexcept { dispatch_to(peers[0], stats); }
+
+// 같은 측정을 빠른 RAM에 놓인 수신자로 - SRAM 대비 메일박스 접근 비용 차이
+void run_dispatch_fast_ram(CycleStats& stats) noexcept { dispatch_to(fast_peer, stats); }
+
+void run_ping_pong(CycleStats& stats) noexcept {
+    Environment& env = Environment::instance();
+    peers[0].echo = true;
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        const HiresTime start = hires_now();
+        env.send_message(driver.id(), peers[0].id(), Ping{i});
+        env.process_all_messages();
+        stats.add(cycles_since(start));
+    }
+}
+
+// 수신자당 사이클 (broadcast 1회 / PEERS)
+void run_broadcast(CycleStats& stats) noexcept {
+    Environment& env = Environment::instance();
+    constexpr uint32_t batch = batch_for(sizeof(Message<Sample>));
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        if (i % batch == 0) env.process_all_messages();
+        const HiresTime start = hires_now();
+        env.broadcast_message(driver.id(), Sample{i, 0});
+        stats.add(cycles_since(start), PEERS);
+    }
+}
+
+struct Scenario {
+    const char* name;
+    void (*run)(CycleStats& stats) noexcept;
+};
+
+constexpr Scenario SCENARIOS[] = {
+    {"send_copy", &run_send_copy},
+    {"send_pooled", &run_send_pooled},
+    {"dispatch", &run_dispatch},
+    {"dispatch_fast_ram", &run_dispatch_fast_ram},
+    {"ping_pong", &run_ping_pong},
+    {"broadcast_1_to_N", &run_broadcast},
+};
+constexpr std::size_t SCENARIO_COUNT = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+struct ScenarioRun {
+    const Scenario* scenario;
+    CycleStats stats;
+    uint32_t stack_used_bytes;
+    TaskHandle_t controller;
+};
+
+ScenarioRun runs[SCENARIO_COUNT];
+
+// 시나리오 태스크 - 측정 후 컨트롤러에 알리고, 스택 high-water mark를 읽을 때까지 정지
+void scenario_task(void* arg) {
+    auto* run = static_cast<ScenarioRun*>(arg);
+    reset_agents();
+    run->scenario->run(run->stats);
+    xTaskNotifyGive(run->controller);
+    vTaskSuspend(nullptr);
+}
+
+// 고정 크기 버퍼 JSON 작성기 (printf 계열 없이 코드 크기 최소화)
+class ReportWriter {
+public:
+    void text(const char* str) noexcept {
+        while (*str && length_ + 1 < sizeof(mini_so_bench_report)) {
+            mini_so_bench_report[length_++] = *str++;
+        }
+        mini_so_bench_report[length_] = '\0';
+    }
+
+    void number(uint32_t value) noexcept {
+        char digits[11];
+        char* cursor = digits + sizeof(digits) - 1;
+        *cursor = '\0';
+        do {
+            *--cursor = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        text(cursor);
+    }
+
+    void field(const char* name, uint32_t value, bool last = false) noexcept {
+        text("\"");
+        text(name);
+        text("\": ");
+        number(value);
+        if (!last) text(", ");
+    }
+
+    std::size_t length() const noexcept { return length_; }
+
+private:
+    std::size_t length_ = 0;
+};
+
+void write_report() noexcept {
+    ReportWriter out;
+    out.text("{\"config\": {\"cpu\": \"" MINI_SO_BENCH_CPU "\", ");
+    out.field("core_clock_hz", static_cast<uint32_t>(configCPU_CLOCK_HZ));
+    out.field("max_agents", MINI_SO_MAX_AGENTS);
+    out.field("max_queue_size", MINI_SO_MAX_QUEUE_SIZE);
+    out.field("max_message_size", MINI_SO_MAX_MESSAGE_SIZE);
+    out.field("mailbox_bytes", static_cast<uint32_t>(MINI_SO_MAILBOX_BYTES));
+    out.field("queue_policy", MINI_SO_QUEUE_POLICY);
+    out.field("fast_ram", MINI_SO_FAST_RAM);
+    out.field("fast_ram_bytes", static_cast<uint32_t>(&_emini_so_fast - &_smini_so_fast) * 4u);
+    out.field("fast_mailbox_address", static_cast<uint32_t>(reinterpret_cast<uintptr_t>(fast_mailbox)));
+    out.field("iterations", ITERATIONS);
+    out.field("measure_overhead_cycles", measure_overhead);
+    out.field("stack_bytes", static_cast<uint32_t>(MINI_SO_BENCH_STACK_WORDS * sizeof(StackType_t)));
+    out.field("heap_free_bytes", static_cast<uint32_t>(xPortGetFreeHeapSize()));
+    out.field("heap_min_free_bytes", static_cast<uint32_t>(xPortGetMinimumEverFreeHeapSize()), true);
+    out.text("},\n \"results\": [\n");
+
+    for (std::size_t i = 0; i < SCENARIO_COUNT; ++i) {
+        const ScenarioRun& run = runs[i];
+        out.text("  {\"name\": \"");
+        out.text(run.scenario->name);
+        out.text("\", ");
+        out.field("operations", run.stats.operations);
+        out.field("min_cycles", run.stats.operations > 0 ? run.stats.min : 0);
+        out.field("avg_cycles", run.stats.average());
+        out.field("max_cycles", run.stats.max);
+        out.field("stack_used_bytes", run.stack_used_bytes, true);
+        out.text(i + 1 < SCENARIO_COUNT ? "},\n" : "}\n");
+    }
+    out.text(" ]}\n");
+
+    mini_so_bench_write(mini_so_bench_report, out.length());
+}
+
+void controller_task(void*) {
+    calibrate();
+    const UBaseType_t priority = uxTaskPriorityGet(nullptr) + 1;
+
+    for (std::size_t i = 0; i < SCENARIO_COUNT; ++i) {
+        ScenarioRun& run = runs[i];
+        run.scenario = &SCENARIOS[i];
+        run.controller = xTaskGetCurrentTaskHandle();
+
+        TaskHandle_t task = nullptr;
+        if (xTaskCreate(&scenario_task, run.scenario->name, MINI_SO_BENCH_STACK_WORDS, &run, priority, &task) != pdPASS) {
+            continue;
+        }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        const UBaseType_t free_words = uxTaskGetStackHighWaterMark(task);
+        run.stack_used_bytes = static_cast<uint32_t>((MINI_SO_BENCH_STACK_WORDS - free_words) * sizeof(StackType_t));
+        vTaskDelete(task);
+    }
+
+    write_report();
+    mini_so_bench_done = 1;
+    mini_so_bench_finished();
+
+    for (;;) {
+        vTaskDelay(portMAX_DELAY);
+    }
+}
+
+} // namespace
+
+int main() {
+    hires_clock_init();
+
+    Environment& env = Environment::instance();
+    env.initialize();
+    env.register_agent(&driver);
+    for (auto& peer : peers) env.register_agent(&peer);
+    fast_peer.set_mailbox_storage(fast_mailbox, sizeof(fast_mailbox));
+    env.register_agent(&fast_peer);
+
+    xTaskCreate(&controller_task, "bench", MINI_SO_BENCH_STACK_WORDS, nullptr, tskIDLE_PRIORITY + 1, nullptr);
+    vTaskStartScheduler();
+
+    for (;;) {}
+}
@@ -0,0 +1,121 @@
+/**
+ * @file startup_cortex_m.c
+ * @brief 벤치마크 펌웨어용 최소 Cortex-M3/M4 시작 코드 (벡터 테이블, Reset, FreeRTOS 훅)
+ *
+ * 보드 클럭/주변장치는 건드리지 않음 (리셋 직후 내부 RC 클럭으로 실행).
+ * 사이클 수는 클럭과 무관하며, PLL 설정이 필요하면 보드 코드에서 SystemInit()을 재정의.
+ */
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef MINI_SO_BENCH_RESET_CLOCK_HZ
+#define MINI_SO_BENCH_RESET_CLOCK_HZ 8000000u  /* STM32F1 HSI, STM32F4는 16 MHz */
+#endif
+
+uint32_t SystemCoreClock = MINI_SO_BENCH_RESET_CLOCK_HZ;
+
+/* 링크 스크립트 심볼 */
+extern uint32_t _sidata, _sdata, _edata, _sbss, _ebss, _estack;
+extern uint32_t _smini_so_fast, _emini_so_fast;
+
+extern int main(void);
+extern void __libc_init_array(void);
+
+extern void SVC_Handler(void);
+extern void PendSV_Handler(void);
+extern void SysTick_Handler(void);
+
+void Reset_Handler(void);
+void Fault_Handler(void);
+
+__attribute__((weak)) void SystemInit(void) {}
+
+/* 벤치마크 결과 확인용 - 디버거에서 이 값으로 중단 원인 판별 */
+volatile uint32_t mini_so_bench_fault = 0;
+
+void Fault_Handler(void) {
+    mini_so_bench_fault = 1;
+    for (;;) {}
+}
+
+void Reset_Handler(void) {
+    uint32_t* src = &_sidata;
+    for (uint32_t* dst = &_sdata; dst < &_edata;) {
+        *dst++ = *src++;
+    }
+    for (uint32_t* dst = &_sbss; dst < &_ebss;) {
+        *dst++ = 0;
+    }
+    /* 빠른 RAM 배치 영역 (mini_so_placement.ld - CCM/DTCM의 메일박스, 풀, trace ring) */
+    for (uint32_t* dst = &_smini_so_fast; dst < &_emini_so_fast;) {
+        *dst++ = 0;
+    }
+
+#if defined(__ARM_FP)
+    /* Cortex-M4F: CP10/CP11 full access (ARM_CM4F 포트는 FPU 사용) */
+    *(volatile uint32_t*)0xE000ED88u |= (0xFu << 20);
+    __asm volatile ("dsb\n isb");
+#endif
+
+    SystemInit();
+    __libc_init_array();
+    main();
+    for (;;) {}
+}
+
+__attribute__((section(".isr_vector"), used))
+void (* const mini_so_vector_table[16])(void) = {
+    (void (*)(void))(&_estack),
+    Reset_Handler,
+    Fault_Handler,      /* NMI */
+    Fault_Handler,      /* HardFault */
+    Fault_Handler,      /* MemManage */
+    Fault_Handler,      /* BusFault */
+    Fault_Handler,      /* UsageFault */
+    0, 0, 0, 0,
+    SVC_Handler,
+    Fault_Handler,      /* DebugMon */
+    0,
+    PendSV_Handler,
+    SysTick_Handler,
+};
+
+/* ============================================================================
+ * FreeRTOS application hooks (FreeRTOSConfig.h 설정에 필요)
+ * ============================================================================ */
+
+void vApplicationMallocFailedHook(void) {
+    mini_so_bench_fault = 2;
+    taskDISABLE_INTERRUPTS();
+    for (;;) {}
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char* pcTaskName) {
+    (void)xTask;
+    (void)pcTaskName;
+    mini_so_bench_fault = 3;
+    taskDISABLE_INTERRUPTS();
+    for (;;) {}
+}
+
+void vApplicationGetIdleTaskMemory(StaticTask_t** ppxIdleTaskTCBBuffer,
+                                   StackType_t** ppxIdleTaskStackBuffer,
+                                   configSTACK_DEPTH_TYPE* puxIdleTaskStackSize) {
+    static StaticTask_t idle_tcb;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+    *ppxIdleTaskTCBBuffer = &idle_tcb;
+    *ppxIdleTaskStackBuffer = idle_stack;
+    *puxIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t** ppxTimerTaskTCBBuffer,
+                                    StackType_t** ppxTimerTaskStackBuffer,
+                                    configSTACK_DEPTH_TYPE* puxTimerTaskStackSize) {
+    static StaticTask_t timer_tcb;
+    static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH];
+    *ppxTimerTaskTCBBuffer = &timer_tcb;
+    *ppxTimerTaskStackBuffer = timer_stack;
+    *puxTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
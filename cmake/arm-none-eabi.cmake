@@ -0,0 +1,24 @@
+# arm-none-eabi toolchain file - Mini SObjectizer Cortex-M 타겟 빌드
+#
+#   cmake -S bench/target -B build-cm4 -DCMAKE_TOOLCHAIN_FILE=cmake/arm-none-eabi.cmake -DMINI_SO_BENCH_PORT=ARM_CM4F
+#
+# MINI_SO_ARM_TOOLCHAIN_PREFIX로 툴체인 경로 지정 가능 (예: /opt/gcc-arm/bin/arm-none-eabi-)
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR arm)
+
+set(MINI_SO_ARM_TOOLCHAIN_PREFIX "arm-none-eabi-" CACHE STRING "Prefix of the arm-none-eabi tools")
+
+set(CMAKE_C_COMPILER ${MINI_SO_ARM_TOOLCHAIN_PREFIX}gcc)
+set(CMAKE_CXX_COMPILER ${MINI_SO_ARM_TOOLCHAIN_PREFIX}g++)
+set(CMAKE_ASM_COMPILER ${MINI_SO_ARM_TOOLCHAIN_PREFIX}gcc)
+set(CMAKE_OBJCOPY ${MINI_SO_ARM_TOOLCHAIN_PREFIX}objcopy CACHE FILEPATH "objcopy")
+set(CMAKE_SIZE ${MINI_SO_ARM_TOOLCHAIN_PREFIX}size CACHE FILEPATH "size")
+set(CMAKE_NM ${MINI_SO_ARM_TOOLCHAIN_PREFIX}nm CACHE FILEPATH "nm")
+
+# 링크 스크립트 없이 컴파일러 검사만 통과하도록 정적 라이브러리로 시험
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
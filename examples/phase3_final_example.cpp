@@ -139,6 +139,7 @@ private:
         response.message_count = reading_count_;
         response.uptime_ms = now();
         response.health_level = calibrated_ ? 0 : 1;
+        Environment::instance().fill_mailbox_status(response);
         
         send_message(requester, response);
     }
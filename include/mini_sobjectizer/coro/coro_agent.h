@@ -0,0 +1,361 @@
+/**
+ * @file coro_agent.h
+ * @brief Mini SObjectizer C++20 코루틴 Agent - 요청/응답과 지연을 핸들러 안에서 co_await
+ *
+ * 상관관계 상태(요청 ID, 대기 플래그)를 멤버 변수로 직접 관리하거나 블로킹하는 대신:
+ *
+ *     class Supervisor : public mini_so::CoroAgent<Supervisor> {
+ *     public:
+ *         bool on_message(const MessageBase& msg) noexcept {
+ *             if (msg.type_id() == MESSAGE_TYPE_ID(HealthTick)) return spawn(check(motor_id_));
+ *             return false;
+ *         }
+ *
+ *         mini_so::CoTask check(AgentId motor) noexcept {
+ *             auto status = co_await request<StatusResponse>(motor, StatusRequest{}, 100);
+ *             if (!status) { ... timeout ... co_return; }
+ *             co_await sleep_for(10);
+ *             ...
+ *         }
+ *     };
+ *
+ * - 코루틴 frame은 힙이 아닌 전역 고정 arena(MINI_SO_CORO_FRAMES × MINI_SO_CORO_FRAME_BYTES)에서 할당.
+ *   arena가 가득 차거나 frame이 슬롯보다 크면 spawn()이 false (coro_arena().failed()에 셈)
+ * - 재개는 항상 Agent 자신의 메시지 처리 중(일반 디스패처 경로)에 일어남: 응답 메시지, 또는
+ *   send_delayed로 자신에게 보낸 내부 wake 메시지가 도착하면 handle_message가 대기 코루틴을 재개
+ * - CoTask 코루틴 안에서는 이 Agent의 awaitable(request, sleep_for)만 co_await (다른 awaitable로
+ *   중단된 코루틴은 Agent가 모르므로 재개/해제되지 않음)
+ *
+ * 빌드: C++20 (-std=c++20). 라이브러리 자체는 C++17로 유지되며 이 헤더를 포함한 번역 단위만 C++20 필요.
+ */
+
+#pragma once
+
+#include "../mini_sobjectizer.h"
+
+#if !defined(__cpp_impl_coroutine) || __cpp_impl_coroutine < 201902L
+#error "coro_agent.h requires C++20 coroutines (-std=c++20)"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <optional>
+
+// 동시에 살아 있는 코루틴 frame 수 (전체 Agent 합계, <= 64)
+#ifndef MINI_SO_CORO_FRAMES
+#define MINI_SO_CORO_FRAMES 16
+#endif
+
+// frame 슬롯 크기 - 지역 변수, awaiter(응답 payload 포함), 인자 복사본이 들어가야 함
+#ifndef MINI_SO_CORO_FRAME_BYTES
+#define MINI_SO_CORO_FRAME_BYTES 256
+#endif
+
+// Agent 하나가 동시에 기다릴 수 있는 co_await 수 (진행 중인 코루틴 수와 같음)
+#ifndef MINI_SO_CORO_MAX_WAITS
+#define MINI_SO_CORO_MAX_WAITS 4
+#endif
+
+namespace mini_so {
+
+namespace detail {
+    // sleep_for / request timeout 만료 (자기 자신에게 send_delayed)
+    struct CoroWake {
+        uint8_t slot;
+        uint8_t reserved;
+        uint16_t epoch;  // 등록마다 증가 - 응답과 경합한 늦은 만료 무시
+    };
+    
+    // 고정 크기 frame 슬롯 arena - 여러 디스패처 스레드의 핸들러가 동시에 할당하므로 lock-free 비트맵
+    class CoroArena {
+        static_assert(MINI_SO_CORO_FRAMES > 0 && MINI_SO_CORO_FRAMES <= 64, "Coroutine arena holds 1..64 frames");
+        static constexpr std::size_t SLOT_BYTES =
+            (MINI_SO_CORO_FRAME_BYTES + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    
+    public:
+        void* allocate(std::size_t size) noexcept {
+            if (size <= SLOT_BYTES) [[likely]] {
+                uint64_t used = used_.load(std::memory_order_relaxed);
+                for (;;) {
+                    const uint64_t free_bits = ~used & ALL;
+                    if (free_bits == 0) break;
+                    const uint64_t bit = free_bits & (~free_bits + 1);
+                    if (used_.compare_exchange_weak(used, used | bit, std::memory_order_acquire,
+                                                    std::memory_order_relaxed)) {
+                        return &storage_[index_of(bit) * SLOT_BYTES];
+                    }
+                }
+            }
+            failed_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        
+        void release(void* frame) noexcept {
+            const std::size_t index = static_cast<std::size_t>(static_cast<uint8_t*>(frame) - storage_) / SLOT_BYTES;
+            used_.fetch_and(~(uint64_t{1} << index), std::memory_order_release);
+        }
+        
+        std::size_t in_use() const noexcept {
+            uint64_t used = used_.load(std::memory_order_relaxed);
+            std::size_t count = 0;
+            for (; used; used &= used - 1) count++;
+            return count;
+        }
+        
+        // 할당 실패 수 (arena 가득 참 또는 frame > MINI_SO_CORO_FRAME_BYTES)
+        uint32_t failed() const noexcept { return failed_.load(std::memory_order_relaxed); }
+        
+        static constexpr std::size_t slot_bytes() noexcept { return SLOT_BYTES; }
+    
+    private:
+        static constexpr uint64_t ALL =
+            MINI_SO_CORO_FRAMES == 64 ? ~uint64_t{0} : (uint64_t{1} << MINI_SO_CORO_FRAMES) - 1;
+        
+        static std::size_t index_of(uint64_t bit) noexcept {
+            std::size_t index = 0;
+            while (bit >>= 1) index++;
+            return index;
+        }
+        
+        alignas(std::max_align_t) uint8_t storage_[SLOT_BYTES * MINI_SO_CORO_FRAMES];
+        std::atomic<uint64_t> used_{0};
+        std::atomic<uint32_t> failed_{0};
+    };
+    
+    inline CoroArena coro_arena_instance;
+}
+
+inline detail::CoroArena& coro_arena() noexcept { return detail::coro_arena_instance; }
+
+// ============================================================================
+// CoTask - CoroAgent 코루틴 반환 타입
+// ============================================================================
+// 생성 시 중단 상태로 시작, spawn()이 첫 co_await까지 실행. 완료하면 frame을 arena에 반환.
+class CoTask {
+public:
+    struct promise_type {
+        static void* operator new(std::size_t size) noexcept { return coro_arena().allocate(size); }
+        static void operator delete(void* frame) noexcept { coro_arena().release(frame); }
+        static CoTask get_return_object_on_allocation_failure() noexcept { return CoTask{}; }
+        
+        CoTask get_return_object() noexcept { return CoTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }  // 핸들러는 noexcept
+    };
+    
+    CoTask() noexcept = default;
+    CoTask(CoTask&& other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+    CoTask& operator=(CoTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = other.handle_;
+            other.handle_ = nullptr;
+        }
+        return *this;
+    }
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+    ~CoTask() { reset(); }
+    
+    explicit operator bool() const noexcept { return static_cast<bool>(handle_); }
+    
+    // 소유권 포기 (spawn용) - 이후 frame은 완료 시 스스로 해제되거나 대기 중인 Agent가 해제
+    std::coroutine_handle<> release() noexcept {
+        std::coroutine_handle<> handle = handle_;
+        handle_ = nullptr;
+        return handle;
+    }
+
+private:
+    explicit CoTask(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+    
+    void reset() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+    
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// ============================================================================
+// CoroAgent - 코루틴 핸들러를 지원하는 Agent
+// ============================================================================
+// Derived는 bool on_message(const MessageBase&) noexcept 를 제공 (대기 코루틴이 받지 않은 메시지).
+// 응답 매칭: 타입 + 발신자 (같은 대상에게 같은 응답 타입을 동시에 기다리면 먼저 등록한 쪽이 받음)
+template<typename Derived>
+class CoroAgent : public Agent {
+    static_assert(MINI_SO_CORO_MAX_WAITS > 0 && MINI_SO_CORO_MAX_WAITS < 256, "Wait slots must fit in uint8_t");
+
+public:
+    CoroAgent() noexcept = default;
+    
+    // 중단된 코루틴 frame 해제, 남은 timeout 취소
+    ~CoroAgent() override {
+        for (auto& wait : waits_) {
+            if (wait.handle) {
+                if (wait.timer != INVALID_TIMER_ID) cancel_timer(wait.timer);
+                std::coroutine_handle<> handle = wait.handle;
+                wait.handle = nullptr;
+                handle.destroy();
+            }
+        }
+    }
+    
+    bool handle_message(const MessageBase& msg) noexcept override {
+        if (msg.type_id() == MESSAGE_TYPE_ID(detail::CoroWake)) [[unlikely]] {
+            return on_wake(static_cast<const Message<detail::CoroWake>&>(msg).data);
+        }
+        if (waiting_ > 0 && resume_response(msg)) {
+            return true;
+        }
+        return self().on_message(msg);
+    }
+    
+    // 대기 중인 co_await 수
+    std::size_t waiting() const noexcept { return waiting_; }
+
+protected:
+    // 코루틴 시작 - 첫 co_await(또는 완료)까지 현재 핸들러 안에서 실행
+    // 반환: frame 할당 실패 시 false
+    bool spawn(CoTask task) noexcept {
+        if (!task) [[unlikely]] return false;
+        task.release().resume();
+        return true;
+    }
+    
+    // co_await request<Resp>(target, req, timeout): 요청을 보내고 target의 Resp를 기다림.
+    // 결과: 응답 payload, 또는 timeout / 전송 실패 / 대기 슬롯 부족이면 nullopt. timeout 0 = 무기한
+    template<typename Resp, typename Req>
+    auto request(AgentId target_id, const Req& request, Duration timeout = 0) noexcept {
+        static_assert(std::is_trivially_copyable_v<Resp>, "Response payload is copied out of the mailbox");
+        return RequestAwaiter<Resp, Req>{*this, target_id, request, timeout, std::nullopt};
+    }
+    
+    // co_await sleep_for(ms): 다른 메시지 처리를 막지 않고 지연 후 재개. 결과: 타이머 실패 시 false
+    auto sleep_for(Duration delay) noexcept { return SleepAwaiter{*this, delay, false}; }
+
+private:
+    static constexpr uint8_t NO_SLOT = 0xFF;
+    
+    struct Wait {
+        std::coroutine_handle<> handle;
+        MessageId type_id = 0;
+        AgentId from = INVALID_AGENT_ID;
+        uint16_t epoch = 0;
+        TimerId timer = INVALID_TIMER_ID;
+        void* result = nullptr;  // nullptr = sleep_for
+        void (*store)(void* result, const MessageBase& msg) noexcept = nullptr;
+    };
+    
+    template<typename Resp>
+    static void store_response(void* result, const MessageBase& msg) noexcept {
+        *static_cast<std::optional<Resp>*>(result) = static_cast<const Message<Resp>&>(msg).data;
+    }
+    
+    template<typename Resp, typename Req>
+    struct RequestAwaiter {
+        CoroAgent& agent;
+        AgentId target_id;
+        Req request;
+        Duration timeout;
+        std::optional<Resp> result;
+        
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle) noexcept {
+            const uint8_t slot = agent.add_wait(handle, MESSAGE_TYPE_ID(Resp), target_id, &result,
+                                                &store_response<Resp>, timeout);
+            if (slot == NO_SLOT) [[unlikely]] return false;
+            if (!agent.environment().send_message(agent.id(), target_id, request)) [[unlikely]] {
+                agent.remove_wait(slot);
+                return false;  // 중단 없이 nullopt로 계속
+            }
+            return true;
+        }
+        std::optional<Resp> await_resume() noexcept { return result; }
+    };
+    
+    struct SleepAwaiter {
+        CoroAgent& agent;
+        Duration delay;
+        bool armed;
+        
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle) noexcept {
+            armed = agent.add_wait(handle, 0, INVALID_AGENT_ID, nullptr, nullptr, delay > 0 ? delay : 1) != NO_SLOT;
+            return armed;
+        }
+        bool await_resume() const noexcept { return armed; }
+    };
+    
+    Derived& self() noexcept { return static_cast<Derived&>(*this); }
+    
+    // 반환: 슬롯 번호, 슬롯 부족 또는 timeout 타이머 실패면 NO_SLOT
+    uint8_t add_wait(std::coroutine_handle<> handle, MessageId type_id, AgentId from, void* result,
+                     void (*store)(void*, const MessageBase&) noexcept, Duration timeout) noexcept {
+        for (uint8_t slot = 0; slot < MINI_SO_CORO_MAX_WAITS; ++slot) {
+            Wait& wait = waits_[slot];
+            if (wait.handle) continue;
+            
+            wait.epoch++;
+            wait.timer = INVALID_TIMER_ID;
+            if (timeout > 0) {
+                wait.timer = send_delayed(id(), detail::CoroWake{slot, 0, wait.epoch}, timeout);
+                if (wait.timer == INVALID_TIMER_ID) [[unlikely]] return NO_SLOT;
+            }
+            wait.handle = handle;
+            wait.type_id = type_id;
+            wait.from = from;
+            wait.result = result;
+            wait.store = store;
+            waiting_++;
+            return slot;
+        }
+        return NO_SLOT;
+    }
+    
+    // 슬롯을 비우고 대기하던 코루틴 반환 (재개 중 새 co_await가 같은 슬롯을 쓸 수 있도록 먼저 비움)
+    std::coroutine_handle<> remove_wait(uint8_t slot) noexcept {
+        Wait& wait = waits_[slot];
+        if (wait.timer != INVALID_TIMER_ID) {
+            cancel_timer(wait.timer);
+            wait.timer = INVALID_TIMER_ID;
+        }
+        std::coroutine_handle<> handle = wait.handle;
+        wait.handle = nullptr;
+        waiting_--;
+        return handle;
+    }
+    
+    bool resume_response(const MessageBase& msg) noexcept {
+        for (uint8_t slot = 0; slot < MINI_SO_CORO_MAX_WAITS; ++slot) {
+            Wait& wait = waits_[slot];
+            if (wait.handle && wait.result && wait.type_id == msg.type_id() && wait.from == msg.sender_id()) {
+                wait.store(wait.result, msg);
+                remove_wait(slot).resume();
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    bool on_wake(const detail::CoroWake& wake) noexcept {
+        if (wake.slot >= MINI_SO_CORO_MAX_WAITS) [[unlikely]] return false;
+        Wait& wait = waits_[wake.slot];
+        if (!wait.handle || wait.epoch != wake.epoch) {
+            return true;  // 응답이 먼저 도착한 요청의 늦은 timeout
+        }
+        wait.timer = INVALID_TIMER_ID;  // 이미 발사됨 (단발)
+        remove_wait(wake.slot).resume();  // request면 result가 비어 있으므로 nullopt
+        return true;
+    }
+    
+    std::array<Wait, MINI_SO_CORO_MAX_WAITS> waits_{};
+    std::size_t waiting_ = 0;
+};
+
+} // namespace mini_so
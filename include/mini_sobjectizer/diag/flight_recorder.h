@@ -0,0 +1,325 @@
+/**
+ * @file flight_recorder.h
+ * @brief Mini SObjectizer 플라이트 레코더 - trace ring, 에러, FailureContext를 보존 RAM/플래시 로그에 기록
+ *
+ * 구성:
+ * - FlightStorage:        페이지 저장소 드라이버 인터페이스 (erase/program/read). 플래시 드라이버가 구현
+ * - RetainedStorage<P,N>: 보존 SRAM 구현 - MINI_SO_RETAINED 정적 객체로 두면 워치독 리셋 후에도 유지
+ * - FlightRecorder:       append-only 레코드 로그. 페이지를 round-robin으로 돌며 쓰고(가장 오래된 페이지를 지워
+ *                         재사용 - 모든 페이지가 같은 횟수로 지워짐) 부팅 시 로그를 다시 읽어 쓰기 위치를 복구
+ * - FlightRecorderAgent:  주기 타이머마다 flush (저장소 기록을 디스패치 경로 밖에서 일괄 처리)
+ *
+ * 생산자(ErrorAgent sink, append)는 RAM 스테이징 버퍼에 레코드를 추가만 하고, flush가 이중 버퍼를 교체해
+ * 모인 레코드와 새 trace 이벤트를 한 번에 program. FailureContext는 재시작 직전일 수 있으므로 즉시 flush.
+ *
+ *     static mini_so::RetainedStorage<1024, 8> flight_ram MINI_SO_RETAINED;
+ *     static mini_so::FlightRecorder recorder(flight_ram);
+ *     static mini_so::FlightRecorderAgent flight_agent(recorder);
+ *
+ *     recorder.mount();                                   // 부팅 시 1회 - 이전 부팅 로그는 그대로 읽을 수 있음
+ *     flight::FailureRecord failure;
+ *     if (recorder.last_failure(failure)) report(failure);
+ *     recorder.attach(mini_so::System::instance().error());
+ *     env.register_agent(&flight_agent);
+ *     flight_agent.start(1000);                           // 1초마다 flush
+ *
+ * 페이지: [PageHeader 16B][Record ...], 지워진 영역은 0xFF.
+ * 레코드: [RecordHeader 8B][payload, 8바이트 정렬 패딩] - CRC-32 범위 = 헤더 앞 4바이트 + payload.
+ * 쓰다 끊긴 레코드(CRC 불일치)에서 그 페이지 읽기를 멈추고, mount 후 첫 기록은 새 페이지에서 시작.
+ */
+
+#pragma once
+
+#include "../mini_sobjectizer.h"
+
+// ============================================================================
+// Flight Recorder Configuration
+// ============================================================================
+// 스테이징 버퍼 하나의 크기 (이중 버퍼, 8의 배수). flush 주기 사이의 레코드가 여기에 모임
+#ifndef MINI_SO_FLIGHT_STAGING_BYTES
+#define MINI_SO_FLIGHT_STAGING_BYTES 512
+#endif
+
+// 레코드 payload 최대 크기 (TRACE 레코드 하나 = 이 크기 / 16 이벤트)
+#ifndef MINI_SO_FLIGHT_MAX_RECORD
+#define MINI_SO_FLIGHT_MAX_RECORD 256
+#endif
+
+namespace mini_so {
+
+// ============================================================================
+// Log Format
+// ============================================================================
+namespace flight {
+    constexpr uint32_t PAGE_MAGIC = 0x5246534Du;  // "MSFR" (리틀 엔디언)
+    constexpr std::size_t RECORD_ALIGN = 8;
+    constexpr uint16_t ERASED_SIZE = 0xFFFF;
+    
+    enum class RecordKind : uint8_t {
+        BOOT = 1,      // BootRecord - mount마다 하나
+        FAILURE = 2,   // FailureRecord - emergency::save_failure_context
+        ERROR = 3,     // ErrorRecord - ErrorAgent 로그
+        TRACE = 4      // trace::Event × (size / 16)
+    };
+    
+    struct PageHeader {
+        uint32_t magic;
+        uint32_t sequence;    // 페이지를 연 순번 (1부터) - 가장 큰 값이 현재 페이지
+        uint32_t boot;        // 페이지를 연 부팅 번호 (BOOT 레코드가 지워진 뒤에도 부팅 번호 유지)
+        uint32_t reserved;
+    };
+    
+    struct RecordHeader {
+        uint16_t size;        // payload 바이트 (패딩 제외), 0xFFFF = 지워진 영역
+        uint8_t kind;
+        uint8_t check;        // ~kind
+        uint32_t crc;
+    };
+    
+    static_assert(sizeof(PageHeader) == 16 && sizeof(RecordHeader) == 8, "Flight log headers must stay 16/8 bytes");
+    
+    struct BootRecord {
+        uint32_t boot_count;  // 1부터
+        uint32_t reserved;
+    };
+    
+    // FailureContext의 재부팅 후에도 의미 있는 부분 (포인터 대신 문자열 사본)
+    struct FailureRecord {
+        uint32_t reason;      // emergency::CriticalFailure
+        int32_t line;
+        uint32_t timestamp;
+        uint32_t heap_free_bytes;
+        uint32_t stack_usage;
+        char file[32];        // 경로를 뺀 파일 이름
+        char function[32];
+        char info[64];        // FailureContext::additional_info
+    };
+    
+    struct ErrorRecord {
+        uint32_t error_code;
+        uint32_t timestamp;
+        AgentId source_agent;
+        uint8_t level;        // system_messages::ErrorReport::Level
+        uint8_t reserved;
+    };
+    
+    static_assert(sizeof(FailureRecord) <= MINI_SO_FLIGHT_MAX_RECORD, "MINI_SO_FLIGHT_MAX_RECORD too small for failures");
+    
+    // for_each가 전달하는 레코드 (data는 콜백 동안만 유효)
+    struct Record {
+        RecordKind kind;
+        uint32_t boot;        // 이 레코드를 남긴 부팅 번호 (첫 BOOT 이전이면 0)
+        const void* data;
+        uint16_t size;
+        
+        template<typename T>
+        const T* as() const noexcept { return size >= sizeof(T) ? static_cast<const T*>(data) : nullptr; }
+    };
+    
+    struct Stats {
+        uint32_t records_written;
+        uint32_t pages_erased;
+        uint32_t dropped;         // 스테이징 버퍼 부족 또는 경합으로 버린 레코드
+        uint32_t write_errors;    // erase/program 실패
+    };
+    
+    constexpr std::size_t record_bytes(std::size_t payload_size) noexcept {
+        return sizeof(RecordHeader) + ((payload_size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1));
+    }
+    
+    // FlightRecorderAgent 주기 타이머
+    struct FlushTick {};
+}
+
+// ============================================================================
+// FlightStorage - 페이지 저장소 드라이버
+// ============================================================================
+// offset/size는 8바이트 배수로 호출됨 (플래시 program 단위가 8바이트 이하여야 함).
+// erase 후 내용은 0xFF. program은 지워진 영역에만 호출됨
+class FlightStorage {
+public:
+    virtual ~FlightStorage() = default;
+    
+    virtual std::size_t page_size() const noexcept = 0;
+    virtual std::size_t page_count() const noexcept = 0;
+    virtual bool erase(std::size_t page) noexcept = 0;
+    virtual bool program(std::size_t page, std::size_t offset, const void* data, std::size_t size) noexcept = 0;
+    virtual bool read(std::size_t page, std::size_t offset, void* data, std::size_t size) const noexcept = 0;
+};
+
+// 보존 SRAM 저장소. bytes_는 일부러 초기화하지 않음 - MINI_SO_RETAINED 정적 객체는 리셋 후에도 내용 유지,
+// 첫 부팅의 임의 값은 mount가 유효하지 않은 페이지로 보고 버림
+template<std::size_t PageBytes, std::size_t Pages>
+class RetainedStorage : public FlightStorage {
+    static_assert(PageBytes % flight::RECORD_ALIGN == 0 && PageBytes >= 64, "Flight pages must be 8-byte aligned (>= 64)");
+    static_assert(Pages >= 2, "Flight log needs at least two pages");
+
+public:
+    std::size_t page_size() const noexcept override { return PageBytes; }
+    std::size_t page_count() const noexcept override { return Pages; }
+    
+    bool erase(std::size_t page) noexcept override {
+        if (page >= Pages) [[unlikely]] return false;
+        std::memset(bytes_[page], 0xFF, PageBytes);
+        return true;
+    }
+    
+    bool program(std::size_t page, std::size_t offset, const void* data, std::size_t size) noexcept override {
+        if (page >= Pages || offset + size > PageBytes) [[unlikely]] return false;
+        std::memcpy(&bytes_[page][offset], data, size);
+        return true;
+    }
+    
+    bool read(std::size_t page, std::size_t offset, void* data, std::size_t size) const noexcept override {
+        if (page >= Pages || offset + size > PageBytes) [[unlikely]] return false;
+        std::memcpy(data, &bytes_[page][offset], size);
+        return true;
+    }
+
+private:
+    alignas(8) uint8_t bytes_[Pages][PageBytes];
+};
+
+// ============================================================================
+// FlightRecorder - append-only 보존 로그
+// ============================================================================
+class FlightRecorder {
+public:
+    static constexpr std::size_t STAGING_BYTES = MINI_SO_FLIGHT_STAGING_BYTES;
+    static constexpr std::size_t MAX_RECORD = MINI_SO_FLIGHT_MAX_RECORD;
+    static_assert(STAGING_BYTES % flight::RECORD_ALIGN == 0 && STAGING_BYTES >= flight::record_bytes(MAX_RECORD),
+                  "MINI_SO_FLIGHT_STAGING_BYTES must hold one maximum-size record");
+    static_assert(MAX_RECORD < flight::ERASED_SIZE, "MINI_SO_FLIGHT_MAX_RECORD too large");
+    
+    explicit FlightRecorder(FlightStorage& storage) noexcept : storage_(storage) {}
+    
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+    
+    // 부팅 시 1회 (기록 전): 로그에서 현재 페이지와 부팅 번호를 복구하고 BOOT 레코드를 기록.
+    // 저장소 페이지가 레코드 하나를 담지 못하거나 첫 페이지를 열 수 없으면 false
+    bool mount() noexcept;
+    
+    // ErrorAgent sink와 emergency failure hook을 이 recorder로 연결 (한 번에 recorder 하나)
+    void attach(ErrorAgent& errors) noexcept;
+    void detach(ErrorAgent& errors) noexcept;
+    
+    // 생산자: 스테이징 버퍼에 레코드 추가 (저장소 접근 없음). 공간이 없거나 다른 생산자와 겹치면 버림
+    bool append(flight::RecordKind kind, const void* data, std::size_t size) noexcept;
+    void record_error(const ErrorAgent::ErrorEntry& entry) noexcept;
+    // 실패 기록 후 즉시 flush (재시작 직전 경로)
+    void record_failure(const emergency::FailureContext& context) noexcept;
+    
+    // 스테이징 버퍼를 교체해 모인 레코드와 새 trace 이벤트를 저장소에 기록. 반환: 기록한 레코드 수
+    // (다른 flush 중이면 0). 페이지 erase가 여기서 일어나므로 디스패치 핫 경로에서 호출하지 말 것
+    std::size_t flush() noexcept;
+    
+    // 가장 오래된 것부터 로그의 유효 레코드를 fn(const flight::Record&)로 전달 (이전 부팅 포함).
+    // 반환: 전달한 레코드 수
+    template<typename Fn>
+    std::size_t for_each(Fn&& fn) const noexcept {
+        Cursor cursor = begin();
+        alignas(8) uint8_t payload[MAX_RECORD];
+        flight::RecordHeader header{};
+        uint32_t boot = 0;
+        std::size_t count = 0;
+        while (next(cursor, header, payload, boot)) {
+            const auto kind = static_cast<flight::RecordKind>(header.kind);
+            if (kind == flight::RecordKind::BOOT && header.size >= sizeof(flight::BootRecord)) {
+                boot = reinterpret_cast<const flight::BootRecord*>(payload)->boot_count;
+            }
+            fn(flight::Record{kind, boot, payload, header.size});
+            count++;
+        }
+        return count;
+    }
+    
+    // 이번 부팅 번호 (mount 전 0)
+    constexpr uint32_t boot_count() const noexcept { return boot_; }
+    // 이전 부팅들이 남긴 가장 최근 FAILURE 레코드
+    bool last_failure(flight::FailureRecord& failure) const noexcept;
+    flight::Stats stats() const noexcept;
+
+private:
+    struct Cursor {
+        std::size_t visited;  // 읽은 페이지 수 (page_count까지)
+        std::size_t page;
+        std::size_t offset;   // 0 = 페이지 헤더 검사 전
+    };
+    
+    struct Staging {
+        alignas(8) uint8_t bytes[STAGING_BYTES];
+        std::size_t used = 0;
+    };
+    
+    Cursor begin() const noexcept;
+    // 다음 유효 레코드 (끊긴 레코드나 지워진 영역에서 다음 페이지로, 새 페이지에서 boot = 페이지의 부팅 번호)
+    bool next(Cursor& cursor, flight::RecordHeader& header, uint8_t* payload, uint32_t& boot) const noexcept;
+    // 페이지 안 offset의 레코드 검증 - 유효하면 header/payload 채움
+    bool read_record(std::size_t page, std::size_t offset, flight::RecordHeader& header, uint8_t* payload) const noexcept;
+    bool open_page(std::size_t page) noexcept;
+    void program_staged(const Staging& staging) noexcept;
+    void collect_trace() noexcept;
+    
+    static void failure_hook(const emergency::FailureContext& context) noexcept;
+    static void error_sink(void* context, const ErrorAgent::ErrorEntry& entry) noexcept;
+    
+    FlightStorage& storage_;
+    std::size_t page_ = 0;            // 현재 쓰기 페이지
+    std::size_t write_offset_ = 0;    // 현재 페이지 안 다음 레코드 위치 (page_size = 다음 기록 시 새 페이지)
+    uint32_t sequence_ = 0;           // 현재 페이지 순번
+    uint32_t boot_ = 0;
+    bool mounted_ = false;
+    
+    Staging staging_[2];
+    std::atomic<uint8_t> active_{0};  // 생산자가 쓰는 스테이징 버퍼
+    std::atomic_flag append_lock_ = ATOMIC_FLAG_INIT;
+    std::atomic_flag flush_lock_ = ATOMIC_FLAG_INIT;
+
+#if MINI_SO_ENABLE_TRACE
+    std::array<uint32_t, MINI_SO_TRACE_CORES> trace_seen_{};  // 코어별 마지막으로 기록한 sequence
+#endif
+    
+    std::atomic<uint32_t> records_written_{0};
+    std::atomic<uint32_t> pages_erased_{0};
+    std::atomic<uint32_t> dropped_{0};
+    std::atomic<uint32_t> write_errors_{0};
+};
+
+// ============================================================================
+// FlightRecorderAgent - 주기 flush
+// ============================================================================
+class FlightRecorderAgent : public Agent {
+public:
+    explicit FlightRecorderAgent(FlightRecorder& recorder) noexcept : recorder_(recorder) {}
+    
+    // 등록 후 호출: period_ms마다 flush
+    bool start(Duration period_ms) noexcept {
+        if (timer_ != INVALID_TIMER_ID) {
+            cancel_timer(timer_);
+        }
+        timer_ = send_periodic(id(), flight::FlushTick{}, period_ms);
+        return timer_ != INVALID_TIMER_ID;
+    }
+    
+    void stop() noexcept {
+        if (timer_ != INVALID_TIMER_ID) {
+            cancel_timer(timer_);
+            timer_ = INVALID_TIMER_ID;
+        }
+    }
+    
+    bool handle_message(const MessageBase& msg) noexcept override {
+        if (msg.type_id() == MESSAGE_TYPE_ID(flight::FlushTick)) {
+            recorder_.flush();
+            return true;
+        }
+        return false;
+    }
+
+private:
+    FlightRecorder& recorder_;
+    TimerId timer_ = INVALID_TIMER_ID;
+};
+
+} // namespace mini_so
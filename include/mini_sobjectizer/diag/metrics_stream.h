@@ -0,0 +1,380 @@
+/**
+ * @file metrics_stream.h
+ * @brief Mini SObjectizer 메트릭 스냅샷 스트림 - 모든 카운터를 이전 스냅샷 대비 델타 인코딩한 이진 프레임으로 주기 전송
+ *
+ * 구성:
+ * - MetricsSink:         프레임 출력 인터페이스 (UART DMA, Node Transport, 호스트 소켓 등이 구현)
+ * - MetricsStream:       Environment의 카운터를 정렬된 (key, value) 표로 모아 바뀐 항목만 인코딩
+ * - MetricsStreamAgent:  주기 타이머마다 emit (수집/인코딩을 디스패치 경로 밖에서 일괄 처리)
+ * - MetricsDecoder<N>:   수신 측(게이트웨이/호스트)에서 프레임을 적용해 현재 값 표를 복원
+ *
+ *     static UartDmaSink uart;                            // MetricsSink 구현
+ *     static mini_so::MetricsStream metrics(env, uart);
+ *     static mini_so::MetricsStreamAgent metrics_agent(metrics);
+ *
+ *     metrics.add_pool<SensorFrame>(1);                   // 메시지 풀 사용량 (선택)
+ *     env.register_agent(&metrics_agent);
+ *     metrics_agent.start(1000);                          // 1초마다 스냅샷
+ *
+ * 프레임: [FrameHeader 16B][항목 ...][CRC-32 4B] - CRC 범위 = 헤더 + 항목.
+ * 항목: varint((key - 앞 항목 key) << 1 | removed) [+ zigzag varint(value - 이전 스냅샷 value)], 32비트 wrap 차이.
+ * 프레임마다 첫 항목의 key 기준은 0. 키프레임(KEYFRAME)은 수신 측 표를 비우고 모든 값을 0 기준으로 보냄.
+ * 델타 프레임은 sequence가 이어질 때만 적용되고, 끊기면 수신 측은 다음 키프레임까지 기다림.
+ * 한 스냅샷이 프레임 하나에 들어가지 않으면 이어지는 sequence의 프레임 여러 개로 나눔.
+ * 바뀐 값이 없는 스냅샷은 프레임을 보내지 않음 (키프레임은 MINI_SO_METRICS_KEYFRAME_INTERVAL 스냅샷마다 항상).
+ */
+
+#pragma once
+
+#include "../mini_sobjectizer.h"
+
+// ============================================================================
+// Metrics Stream Configuration
+// ============================================================================
+// 스냅샷 표 크기 (항목 수) - 현재/이전 표 두 개 × 8바이트. 넘는 항목은 버리고 stats().truncated에 집계
+#ifndef MINI_SO_METRICS_FIELDS
+#define MINI_SO_METRICS_FIELDS 128
+#endif
+
+// 프레임 버퍼 크기 (헤더/CRC 포함) - 링크 MTU나 DMA 버퍼에 맞춤
+#ifndef MINI_SO_METRICS_FRAME_BYTES
+#define MINI_SO_METRICS_FRAME_BYTES 256
+#endif
+
+// 키프레임 주기 (스냅샷 수) - 수신 측이 중간에 붙거나 프레임을 잃었을 때 이만큼 안에 다시 맞춰짐
+#ifndef MINI_SO_METRICS_KEYFRAME_INTERVAL
+#define MINI_SO_METRICS_KEYFRAME_INTERVAL 16
+#endif
+
+// add_pool로 등록할 수 있는 풀/게이지 수
+#ifndef MINI_SO_METRICS_MAX_POOLS
+#define MINI_SO_METRICS_MAX_POOLS 8
+#endif
+
+namespace mini_so {
+
+// ============================================================================
+// Wire Format
+// ============================================================================
+namespace metrics {
+    constexpr uint16_t FRAME_MAGIC = 0x534Du;  // "MS" (리틀 엔디언)
+    constexpr uint8_t VERSION = 1;
+    constexpr uint8_t KEYFRAME = 0x01;
+
+    // key = [group 8비트 | subject 16비트 | metric 8비트] - 정렬 순서가 곧 전송 순서
+    enum class Group : uint8_t {
+        ENVIRONMENT = 0,   // subject 0
+        AGENT = 1,         // subject = AgentId (세대 포함 - 슬롯이 재사용되면 새 key)
+        ARENA = 2,         // subject = size-class (0..3)
+        MAILBOX_POOL = 3,  // subject 0 (Environment::mailbox_pool)
+        ERRORS = 4,        // subject 0 (Environment::system()의 ErrorAgent)
+        POOL = 5           // subject = add_pool id
+    };
+
+    enum EnvironmentMetric : uint8_t {
+        AGENTS = 0,           // 등록된 Agent 수
+        SENT = 1,             // 전송 메시지 수 (하위 32비트, MINI_SO_ENABLE_METRICS)
+        PROCESSED = 2,        // 처리 메시지 수 (하위 32비트)
+        MAX_LOOP_US = 3,      // 가장 긴 run() 루프
+        ISR_DROPPED = 4,      // ISR/원격 수신함이 가득 차 버린 수
+        THROTTLED = 5         // 속도 한도로 버려진 전송 (Environment::throttled)
+    };
+
+    enum AgentMetric : uint8_t {
+        MESSAGES = 0,         // AgentCounters (MINI_SO_ENABLE_METRICS)
+        VISITS = 1,
+        BUSY_US = 2,
+        MAX_VISIT_US = 3,
+        HIGH_WATER_BYTES = 4, // MailboxStats (MINI_SO_MAILBOX_STATS)
+        PUSH_FAILURES = 5,
+        SATURATIONS = 6,
+        DROPPED = 7,          // OverloadStats::dropped
+        DEADLINE_MISSES = 8,
+        QUEUE_P99_US = 9,     // LatencyMonitor (MINI_SO_ENABLE_LATENCY_HISTOGRAMS)
+        HANDLER_P99_US = 10,
+        HANDLER_MAX_US = 11,
+        THROTTLED_SENDS = 12  // OverloadStats::throttled (이 Agent로 오다 한도에 걸린 전송)
+    };
+
+    enum PoolMetric : uint8_t {
+        IN_USE = 0,           // 사용 중인 슬롯/블록
+        FAILURES = 1          // 고갈로 실패한 할당
+    };
+
+    enum ErrorMetric : uint8_t {
+        ERROR_COUNT = 0,
+        MAX_LEVEL = 1         // system_messages::ErrorReport::Level
+    };
+
+    constexpr uint32_t make_key(Group group, uint32_t subject, uint8_t metric) noexcept {
+        return (static_cast<uint32_t>(group) << 24) | ((subject & 0xFFFFu) << 8) | metric;
+    }
+    constexpr Group group_of(uint32_t key) noexcept { return static_cast<Group>(key >> 24); }
+    constexpr uint16_t subject_of(uint32_t key) noexcept { return static_cast<uint16_t>(key >> 8); }
+    constexpr uint8_t metric_of(uint32_t key) noexcept { return static_cast<uint8_t>(key); }
+
+    struct FrameHeader {
+        uint16_t magic;
+        uint8_t version;
+        uint8_t flags;        // KEYFRAME
+        uint16_t sequence;    // 프레임마다 1씩 (wrap)
+        uint16_t entries;
+        uint32_t time_ms;     // 스냅샷 시각 (now())
+        uint16_t body_bytes;  // 항목 바이트 수
+        uint16_t reserved;
+    };
+    static_assert(sizeof(FrameHeader) == 16, "Metrics frame header must stay 16 bytes");
+
+    constexpr std::size_t CRC_BYTES = 4;
+    constexpr std::size_t MAX_ENTRY_BYTES = 10;  // key varint 5 + value varint 5
+
+    struct Field {
+        uint32_t key;
+        uint32_t value;
+    };
+
+    struct Stats {
+        uint32_t snapshots;       // emit 호출 (수집한 스냅샷)
+        uint32_t frames;          // sink로 보낸 프레임
+        uint32_t keyframes;
+        uint32_t bytes;           // sink로 보낸 바이트
+        uint32_t sink_failures;   // sink가 거부한 프레임 (다음 스냅샷은 키프레임)
+        uint32_t truncated;       // 표가 가득 차 빠진 항목 (MINI_SO_METRICS_FIELDS)
+    };
+
+    constexpr uint32_t zigzag(int32_t value) noexcept {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+    constexpr int32_t unzigzag(uint32_t value) noexcept {
+        return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1u);
+    }
+
+    // LEB128 - 반환: 쓴 바이트 수 (최대 5)
+    inline std::size_t put_varint(uint8_t* out, uint32_t value) noexcept {
+        std::size_t n = 0;
+        while (value >= 0x80u) {
+            out[n++] = static_cast<uint8_t>(value | 0x80u);
+            value >>= 7;
+        }
+        out[n++] = static_cast<uint8_t>(value);
+        return n;
+    }
+
+    // 반환: 읽은 바이트 수, 0 = 잘림/5바이트 초과
+    inline std::size_t get_varint(const uint8_t* in, std::size_t size, uint32_t& value) noexcept {
+        value = 0;
+        for (std::size_t n = 0; n < size && n < 5; ++n) {
+            value |= static_cast<uint32_t>(in[n] & 0x7Fu) << (7 * n);
+            if (!(in[n] & 0x80u)) return n + 1;
+        }
+        return 0;
+    }
+}
+
+// ============================================================================
+// MetricsSink - 프레임 출력 드라이버 인터페이스
+// ============================================================================
+class MetricsSink {
+public:
+    virtual ~MetricsSink() = default;
+
+    // 완성된 프레임 하나 (emit 문맥에서 호출). 반환 후 버퍼가 재사용되므로 DMA 드라이버는 복사하거나
+    // 전송 완료 전 다음 emit이 오지 않도록 주기를 잡을 것. false면 버려진 것으로 보고 다음에 키프레임을 보냄
+    virtual bool write(const uint8_t* frame, std::size_t size) noexcept = 0;
+};
+
+// ============================================================================
+// MetricsStream - 스냅샷 수집과 델타 인코딩
+// ============================================================================
+class MetricsStream {
+public:
+    static constexpr std::size_t FIELDS = MINI_SO_METRICS_FIELDS;
+    static constexpr std::size_t FRAME_BYTES = MINI_SO_METRICS_FRAME_BYTES;
+    static constexpr std::size_t KEYFRAME_INTERVAL = MINI_SO_METRICS_KEYFRAME_INTERVAL;
+    static constexpr std::size_t MAX_POOLS = MINI_SO_METRICS_MAX_POOLS;
+    static_assert(FRAME_BYTES >= sizeof(metrics::FrameHeader) + metrics::MAX_ENTRY_BYTES + metrics::CRC_BYTES &&
+                  FRAME_BYTES <= 0xFFFF, "MINI_SO_METRICS_FRAME_BYTES must hold one entry");
+    static_assert(KEYFRAME_INTERVAL >= 1, "MINI_SO_METRICS_KEYFRAME_INTERVAL must be >= 1");
+
+    using Probe = uint32_t (*)() noexcept;
+
+    MetricsStream(Environment& env, MetricsSink& sink) noexcept : env_(env), sink_(sink) {}
+
+    MetricsStream(const MetricsStream&) = delete;
+    MetricsStream& operator=(const MetricsStream&) = delete;
+
+    // 풀/게이지 등록 (POOL 그룹, subject = id): in_use는 IN_USE, failures(선택)는 FAILURES 항목.
+    // 같은 id가 있거나 MAX_POOLS를 넘으면 false
+    bool add_pool(uint16_t id, Probe in_use, Probe failures = nullptr) noexcept;
+
+    // 메시지 타입 T의 전역 풀 (arena 타입이면 그 arena 클래스)
+    template<typename T>
+    bool add_pool(uint16_t id) noexcept {
+        return add_pool(id, &pool_in_use<T>, &pool_exhausted<T>);
+    }
+
+    // 스냅샷 수집 → 이전 스냅샷과 비교 → 프레임 인코딩 → sink. 반환: 보낸 프레임 수 (다른 emit 중이면 0).
+    // 디스패치 핫 경로가 아닌 곳(MetricsStreamAgent)에서 호출
+    std::size_t emit() noexcept;
+
+    // 다음 emit을 키프레임으로 (수신 측이 새로 붙었을 때 등)
+    void request_keyframe() noexcept { keyframe_pending_.store(true, std::memory_order_relaxed); }
+
+    metrics::Stats stats() const noexcept;
+
+private:
+    struct PoolProbe {
+        uint16_t id;
+        Probe in_use;
+        Probe failures;
+    };
+
+    // 프레임 하나를 채우는 중인 상태
+    struct Encoder {
+        std::size_t offset;    // frame_ 안 다음 항목 위치
+        uint16_t entries;
+        uint32_t last_key;
+        uint8_t flags;
+    };
+
+    template<typename T>
+    static uint32_t pool_in_use() noexcept {
+        using Pool = detail::GlobalMessagePool<T>;
+        return static_cast<uint32_t>(Pool::capacity() - Pool::available_count());
+    }
+    template<typename T>
+    static uint32_t pool_exhausted() noexcept { return detail::GlobalMessagePool<T>::exhausted_count(); }
+
+    // current_에 스냅샷을 모아 key 순으로 정렬 - 반환: 항목 수
+    std::size_t collect() noexcept;
+    void push(uint32_t key, uint32_t value) noexcept;
+
+    void begin_frame(Encoder& encoder, uint8_t flags) noexcept;
+    bool put(Encoder& encoder, uint32_t key, bool removed, uint32_t delta) noexcept;
+    bool finish_frame(Encoder& encoder) noexcept;
+
+    Environment& env_;
+    MetricsSink& sink_;
+
+    std::array<metrics::Field, FIELDS> current_{};
+    std::array<metrics::Field, FIELDS> previous_{};   // 수신 측이 가진 것으로 보는 마지막 스냅샷
+    std::size_t current_count_ = 0;
+    std::size_t previous_count_ = 0;
+
+    std::array<PoolProbe, MAX_POOLS> pools_{};
+    std::size_t pool_count_ = 0;
+
+    alignas(4) uint8_t frame_[FRAME_BYTES];
+    uint16_t sequence_ = 0;
+    uint32_t time_ms_ = 0;            // 이번 스냅샷 시각
+    std::size_t since_keyframe_ = 0;  // 마지막 키프레임 뒤 스냅샷 수
+    std::atomic<bool> keyframe_pending_{true};
+    std::atomic_flag emit_lock_ = ATOMIC_FLAG_INIT;
+
+    std::atomic<uint32_t> snapshots_{0};
+    std::atomic<uint32_t> frames_{0};
+    std::atomic<uint32_t> keyframes_{0};
+    std::atomic<uint32_t> bytes_{0};
+    std::atomic<uint32_t> sink_failures_{0};
+    std::atomic<uint32_t> truncated_{0};
+};
+
+// ============================================================================
+// MetricsDecoder - 수신 측 표 복원
+// ============================================================================
+class MetricsDecoderBase {
+public:
+    enum class Result : uint8_t {
+        APPLIED,       // 표 갱신됨
+        BAD_FRAME,     // magic/version/길이/CRC 불일치 또는 항목 손상
+        OUT_OF_SYNC,   // 델타 프레임 sequence 끊김 - 다음 키프레임까지 무시
+        FULL           // 표가 가득 차 일부 항목을 버림 (다음 키프레임까지 동기화 해제)
+    };
+
+    MetricsDecoderBase(const MetricsDecoderBase&) = delete;
+    MetricsDecoderBase& operator=(const MetricsDecoderBase&) = delete;
+
+    Result apply(const uint8_t* frame, std::size_t size) noexcept;
+
+    bool value(uint32_t key, uint32_t& value) const noexcept;
+    bool value(metrics::Group group, uint32_t subject, uint8_t metric, uint32_t& out) const noexcept {
+        return value(metrics::make_key(group, subject, metric), out);
+    }
+
+    // key 순으로 fn(const metrics::Field&)
+    template<typename Fn>
+    void for_each(Fn&& fn) const noexcept {
+        for (std::size_t i = 0; i < count_; ++i) fn(static_cast<const metrics::Field&>(fields_[i]));
+    }
+
+    constexpr std::size_t size() const noexcept { return count_; }
+    constexpr bool synced() const noexcept { return synced_; }
+    constexpr uint16_t sequence() const noexcept { return sequence_; }
+    constexpr uint32_t time_ms() const noexcept { return time_ms_; }
+
+protected:
+    MetricsDecoderBase(metrics::Field* fields, std::size_t capacity) noexcept : fields_(fields), capacity_(capacity) {}
+    ~MetricsDecoderBase() = default;
+
+private:
+    // key 위치 (없으면 삽입 위치) - 이분 탐색
+    std::size_t lower_bound(uint32_t key) const noexcept;
+
+    metrics::Field* fields_;
+    std::size_t capacity_;
+    std::size_t count_ = 0;
+    uint16_t sequence_ = 0;
+    uint32_t time_ms_ = 0;
+    bool synced_ = false;
+};
+
+template<std::size_t Fields = MINI_SO_METRICS_FIELDS>
+class MetricsDecoder : public MetricsDecoderBase {
+public:
+    MetricsDecoder() noexcept : MetricsDecoderBase(fields_, Fields) {}
+
+private:
+    metrics::Field fields_[Fields];
+};
+
+// ============================================================================
+// MetricsStreamAgent - 주기 emit
+// ============================================================================
+namespace metrics {
+    struct EmitTick {};
+}
+
+class MetricsStreamAgent : public Agent {
+public:
+    explicit MetricsStreamAgent(MetricsStream& stream) noexcept : stream_(stream) {}
+
+    // 등록 후 호출: period_ms마다 스냅샷
+    bool start(Duration period_ms) noexcept {
+        if (timer_ != INVALID_TIMER_ID) {
+            cancel_timer(timer_);
+        }
+        timer_ = send_periodic(id(), metrics::EmitTick{}, period_ms);
+        return timer_ != INVALID_TIMER_ID;
+    }
+
+    void stop() noexcept {
+        if (timer_ != INVALID_TIMER_ID) {
+            cancel_timer(timer_);
+            timer_ = INVALID_TIMER_ID;
+        }
+    }
+
+    bool handle_message(const MessageBase& msg) noexcept override {
+        if (msg.type_id() == MESSAGE_TYPE_ID(metrics::EmitTick)) {
+            stream_.emit();
+            return true;
+        }
+        return false;
+    }
+
+private:
+    MetricsStream& stream_;
+    TimerId timer_ = INVALID_TIMER_ID;
+};
+
+} // namespace mini_so
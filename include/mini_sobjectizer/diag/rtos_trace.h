@@ -0,0 +1,319 @@
+/**
+ * @file rtos_trace.h
+ * @brief Mini SObjectizer RTOS 트레이스 도구 백엔드 - Agent 디스패치를 SEGGER SystemView / Percepio Tracealyzer
+ *        사용자 이벤트로 기록
+ *
+ * Environment::run을 도는 FreeRTOS 태스크 안에서 어느 Agent가 어떤 메시지로 CPU를 쓰는지를 RTOS 타임라인 옆에
+ * 보여줌. 디스패치 관찰자(MINI_SO_OBSERVER)로 동작하므로 MINI_SO_RTOS_TRACE를 라이브러리와 애플리케이션에
+ * 같은 값으로 정의하면 mini_sobjectizer.h가 이 헤더를 관찰자로 선택함 (직접 include하지 않음).
+ *
+ *     // -DMINI_SO_RTOS_TRACE=MINI_SO_RTOS_TRACE_SYSVIEW (또는 _TRACEALYZER)
+ *     SEGGER_SYSVIEW_Conf();                       // Tracealyzer: xTraceEnable(TRC_START)
+ *     mini_so::rtos_trace::start();                // 모듈/채널 등록 - 도구 초기화 뒤 1회
+ *     mini_so::rtos_trace::name_agent(env.register_agent(&motor), "motor");
+ *     MINI_SO_TRACE_MESSAGE(MotorCommand);         // 메시지 타입 이름 (정적 문자열)
+ *
+ * SystemView: "MiniSO" 모듈 이벤트 (Dispatch 구간 = 시작/EndCall, Drop, Idle, 선택적으로 Send).
+ *             Agent/메시지 이름은 리소스 이름(%I)으로 전달되고 녹화 시작 때마다 다시 보냄.
+ *             Agent별 디스패치 구간은 마커 (Agent 슬롯 인덱스)로도 기록되어 Agent별 CPU 점유율이 보임.
+ * Tracealyzer: "Agents" 인터벌 채널 세트에 Agent별 채널 (인터벌 값 = 메시지 타입 ID),
+ *              메시지 이름/Drop은 "MiniSO" 사용자 이벤트 채널 (TraceRecorder 4.6 이상 API).
+ *
+ * 이름 등록은 초기화 단계에서 한 태스크가 수행 (표는 잠금 없이 읽힘). 이름 문자열은 정적 수명이어야 함.
+ * 이 헤더는 mini_sobjectizer.h의 기본 타입 선언 직후 전역 범위에서 include되므로 그 앞 선언만 사용.
+ */
+
+#pragma once
+
+#if MINI_SO_RTOS_TRACE == MINI_SO_RTOS_TRACE_SYSVIEW
+#include "SEGGER_SYSVIEW.h"
+#elif MINI_SO_RTOS_TRACE == MINI_SO_RTOS_TRACE_TRACEALYZER
+#include "trcRecorder.h"
+#else
+#error "rtos_trace.h requires MINI_SO_RTOS_TRACE (MINI_SO_RTOS_TRACE_SYSVIEW or MINI_SO_RTOS_TRACE_TRACEALYZER)"
+#endif
+
+// ============================================================================
+// RTOS Trace Configuration
+// ============================================================================
+// 메일박스 push 성공마다 Send 이벤트 기록 (기본 off - 메시지 수만큼 이벤트가 생김)
+#ifndef MINI_SO_RTOS_TRACE_SENDS
+#define MINI_SO_RTOS_TRACE_SENDS 0
+#endif
+
+// 이름을 등록할 수 있는 메시지 타입 수 (2의 거듭제곱)
+#ifndef MINI_SO_RTOS_TRACE_MESSAGE_NAMES
+#define MINI_SO_RTOS_TRACE_MESSAGE_NAMES 32
+#endif
+
+// 메시지 타입 이름 등록 (전역/함수 범위 어디서나, 정적 문자열 #Type 사용)
+#define MINI_SO_TRACE_MESSAGE(Type) \
+    ::mini_so::rtos_trace::name_message(::mini_so::detail::MessageTypeRegistry<Type>::id(), #Type)
+
+namespace mini_so {
+namespace rtos_trace {
+
+static_assert(MINI_SO_RTOS_TRACE_MESSAGE_NAMES > 0 &&
+              (MINI_SO_RTOS_TRACE_MESSAGE_NAMES & (MINI_SO_RTOS_TRACE_MESSAGE_NAMES - 1)) == 0,
+              "MINI_SO_RTOS_TRACE_MESSAGE_NAMES must be a power of two");
+
+// ============================================================================
+// Name Tables - Agent 슬롯과 메시지 타입 ID별 정적 문자열
+// ============================================================================
+namespace detail {
+    struct MessageName {
+        MessageId id = INVALID_MESSAGE_ID;
+        const char* name = nullptr;
+    };
+
+    struct Names {
+        std::array<const char*, MINI_SO_MAX_AGENTS> agents{};
+        std::array<MessageName, MINI_SO_RTOS_TRACE_MESSAGE_NAMES> messages{};
+        bool started = false;
+    };
+
+    inline Names& names() noexcept {
+        static Names instance;
+        return instance;
+    }
+
+    // 열린 주소법 (선형 탐사) - 없으면 빈 슬롯 또는 nullptr (표가 가득 참)
+    inline MessageName* find_message(MessageId id) noexcept {
+        auto& table = names().messages;
+        constexpr std::size_t mask = MINI_SO_RTOS_TRACE_MESSAGE_NAMES - 1;
+        for (std::size_t probe = 0; probe < table.size(); ++probe) {
+            MessageName& entry = table[(id + probe) & mask];
+            if (entry.id == id || entry.id == INVALID_MESSAGE_ID) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    // 리소스 ID 공간 (SystemView %I) - Agent와 메시지 타입이 겹치지 않게 분리
+    constexpr uint32_t AGENT_RESOURCE = 0x10000u;
+    constexpr uint32_t MESSAGE_RESOURCE = 0x20000u;
+
+    constexpr uint32_t agent_resource(std::size_t slot) noexcept { return AGENT_RESOURCE | static_cast<uint32_t>(slot); }
+    constexpr uint32_t message_resource(MessageId id) noexcept { return MESSAGE_RESOURCE | id; }
+
+    // 메일박스가 보고하는 target은 슬롯 인덱스, 디스패치 쪽은 AgentId - 둘 다 슬롯으로
+    constexpr std::size_t slot_of(AgentId agent) noexcept { return mini_so::detail::agent_index(agent); }
+}
+
+inline const char* agent_name(AgentId agent) noexcept {
+    const std::size_t slot = detail::slot_of(agent);
+    return agent != INVALID_AGENT_ID && slot < MINI_SO_MAX_AGENTS ? detail::names().agents[slot] : nullptr;
+}
+
+inline const char* message_name(MessageId id) noexcept {
+    const detail::MessageName* entry = detail::find_message(id);
+    return entry && entry->id == id ? entry->name : nullptr;
+}
+
+// ============================================================================
+// SEGGER SystemView
+// ============================================================================
+#if MINI_SO_RTOS_TRACE == MINI_SO_RTOS_TRACE_SYSVIEW
+namespace detail {
+    enum Event : uint32_t {
+        DISPATCH = 0,   // agent, message - EndCall로 종료
+        SEND = 1,       // message, sender, target, depth
+        DROP = 2,       // message, sender, target, depth
+        IDLE = 3,       // ticks
+        EVENT_COUNT = 4
+    };
+
+    inline void send_agent_name(std::size_t slot, const char* name) noexcept {
+        SEGGER_SYSVIEW_NameResource(agent_resource(slot), name);
+        SEGGER_SYSVIEW_NameMarker(static_cast<U32>(slot), name);
+    }
+
+    // 녹화 시작 시 SystemView가 모듈 설명과 함께 호출 - 이전에 등록된 이름 재전송
+    inline void send_names() noexcept {
+        const Names& table = names();
+        for (std::size_t slot = 0; slot < table.agents.size(); ++slot) {
+            if (table.agents[slot]) send_agent_name(slot, table.agents[slot]);
+        }
+        for (const MessageName& entry : table.messages) {
+            if (entry.name) SEGGER_SYSVIEW_NameResource(message_resource(entry.id), entry.name);
+        }
+    }
+    
+    inline SEGGER_SYSVIEW_MODULE& module() noexcept {
+        static SEGGER_SYSVIEW_MODULE instance = {
+            "M=MiniSO, "
+            "0 Dispatch agent=%I msg=%I, "
+            "1 Send msg=%I from=%I to=%I depth=%u, "
+            "2 Drop msg=%I from=%I to=%I depth=%u, "
+            "3 Idle ticks=%u",
+            EVENT_COUNT,
+            0,
+            [] { send_names(); },
+            nullptr
+        };
+        return instance;
+    }
+
+    inline uint32_t event_id(Event event) noexcept { return module().EventOffset + event; }
+}
+
+// SEGGER_SYSVIEW_Conf()/SEGGER_SYSVIEW_Init() 뒤 1회
+inline void start() noexcept {
+    if (detail::names().started) return;
+    detail::names().started = true;
+    SEGGER_SYSVIEW_RegisterModule(&detail::module());
+}
+
+struct Observer : NullObserver {
+    static void on_send(MessageId type, AgentId sender, AgentId target, std::size_t depth) noexcept {
+#if MINI_SO_RTOS_TRACE_SENDS
+        SEGGER_SYSVIEW_RecordU32x4(detail::event_id(detail::SEND), detail::message_resource(type),
+                                   detail::agent_resource(detail::slot_of(sender)), detail::agent_resource(target),
+                                   static_cast<U32>(depth));
+#else
+        (void)type; (void)sender; (void)target; (void)depth;
+#endif
+    }
+
+    static void on_enqueue_fail(MessageId type, AgentId sender, AgentId target, std::size_t depth) noexcept {
+        SEGGER_SYSVIEW_RecordU32x4(detail::event_id(detail::DROP), detail::message_resource(type),
+                                   detail::agent_resource(detail::slot_of(sender)), detail::agent_resource(target),
+                                   static_cast<U32>(depth));
+    }
+
+    static void on_dispatch_begin(MessageId type, AgentId, AgentId agent, std::size_t) noexcept {
+        const std::size_t slot = detail::slot_of(agent);
+        SEGGER_SYSVIEW_MarkStart(static_cast<U32>(slot));
+        SEGGER_SYSVIEW_RecordU32x2(detail::event_id(detail::DISPATCH), detail::agent_resource(slot),
+                                   detail::message_resource(type));
+    }
+
+    static void on_dispatch_end(MessageId, AgentId agent, bool) noexcept {
+        SEGGER_SYSVIEW_RecordEndCall(detail::event_id(detail::DISPATCH));
+        SEGGER_SYSVIEW_MarkStop(static_cast<U32>(detail::slot_of(agent)));
+    }
+
+    static void on_idle(TickType_t ticks) noexcept {
+        SEGGER_SYSVIEW_RecordU32(detail::event_id(detail::IDLE), static_cast<U32>(ticks));
+    }
+};
+
+// ============================================================================
+// Percepio Tracealyzer (TraceRecorder 4.6+)
+// ============================================================================
+#else
+namespace detail {
+    struct Channels {
+        TraceIntervalChannelSetHandle_t agent_set = nullptr;
+        std::array<TraceIntervalChannelHandle_t, MINI_SO_MAX_AGENTS> agents{};
+        std::array<TraceIntervalInstanceHandle_t, MINI_SO_MAX_AGENTS> running{};
+        TraceIntervalChannelHandle_t unnamed = nullptr;  // 이름 없는 Agent 공용
+        TraceStringHandle_t events = nullptr;            // 메시지 이름 / Drop 사용자 이벤트
+    };
+
+    inline Channels& channels() noexcept {
+        static Channels instance;
+        return instance;
+    }
+
+    inline void create_agent_channel(std::size_t slot, const char* name) noexcept {
+        xTraceIntervalChannelCreate(name, channels().agent_set, &channels().agents[slot]);
+    }
+
+    inline TraceIntervalChannelHandle_t agent_channel(std::size_t slot) noexcept {
+        TraceIntervalChannelHandle_t channel = slot < MINI_SO_MAX_AGENTS ? channels().agents[slot] : nullptr;
+        return channel ? channel : channels().unnamed;
+    }
+}
+
+// xTraceEnable() 뒤 1회 - 이전에 등록된 Agent 이름의 채널을 만듦
+inline void start() noexcept {
+    if (detail::names().started) return;
+    detail::names().started = true;
+    detail::Channels& ch = detail::channels();
+    xTraceIntervalChannelSetCreate("Agents", &ch.agent_set);
+    xTraceIntervalChannelCreate("(agent)", ch.agent_set, &ch.unnamed);
+    xTraceStringRegister("MiniSO", &ch.events);
+    for (std::size_t slot = 0; slot < detail::names().agents.size(); ++slot) {
+        if (detail::names().agents[slot]) detail::create_agent_channel(slot, detail::names().agents[slot]);
+    }
+}
+
+struct Observer : NullObserver {
+    static void on_send(MessageId type, AgentId sender, AgentId target, std::size_t depth) noexcept {
+#if MINI_SO_RTOS_TRACE_SENDS
+        if (detail::channels().events) {
+            const char* name = message_name(type);
+            xTracePrintF(detail::channels().events, "send %s %d->%d (%d)", name ? name : "?",
+                         static_cast<int>(detail::slot_of(sender)), static_cast<int>(target), static_cast<int>(depth));
+        }
+#else
+        (void)type; (void)sender; (void)target; (void)depth;
+#endif
+    }
+
+    static void on_enqueue_fail(MessageId type, AgentId sender, AgentId target, std::size_t depth) noexcept {
+        if (detail::channels().events) {
+            const char* name = message_name(type);
+            xTracePrintF(detail::channels().events, "drop %s %d->%d (%d)", name ? name : "?",
+                         static_cast<int>(detail::slot_of(sender)), static_cast<int>(target), static_cast<int>(depth));
+        }
+    }
+
+    // Agent는 한 번에 한 워커만 디스패치하므로 슬롯별 인스턴스 핸들 하나로 충분
+    static void on_dispatch_begin(MessageId type, AgentId, AgentId agent, std::size_t) noexcept {
+        const std::size_t slot = detail::slot_of(agent);
+        TraceIntervalChannelHandle_t channel = detail::agent_channel(slot);
+        if (!channel || slot >= MINI_SO_MAX_AGENTS) return;
+        if (const char* name = message_name(type)) {
+            xTracePrint(detail::channels().events, name);
+        }
+        xTraceIntervalStart(channel, type, &detail::channels().running[slot]);
+    }
+
+    static void on_dispatch_end(MessageId, AgentId agent, bool) noexcept {
+        const std::size_t slot = detail::slot_of(agent);
+        TraceIntervalChannelHandle_t channel = detail::agent_channel(slot);
+        if (!channel || slot >= MINI_SO_MAX_AGENTS) return;
+        xTraceIntervalStop(channel, detail::channels().running[slot]);
+    }
+};
+#endif
+
+// ============================================================================
+// 이름 등록
+// ============================================================================
+// Agent 이름 (register_agent가 돌려준 ID). start() 전후 어느 때나 가능
+inline void name_agent(AgentId agent, const char* name) noexcept {
+    const std::size_t slot = detail::slot_of(agent);
+    if (agent == INVALID_AGENT_ID || slot >= MINI_SO_MAX_AGENTS || !name) [[unlikely]] {
+        return;
+    }
+    detail::names().agents[slot] = name;
+    if (!detail::names().started) return;
+#if MINI_SO_RTOS_TRACE == MINI_SO_RTOS_TRACE_SYSVIEW
+    detail::send_agent_name(slot, name);
+#else
+    detail::create_agent_channel(slot, name);
+#endif
+}
+
+// 메시지 타입 이름 - 표가 가득 차면 false (MINI_SO_RTOS_TRACE_MESSAGE_NAMES)
+inline bool name_message(MessageId id, const char* name) noexcept {
+    detail::MessageName* entry = detail::find_message(id);
+    if (!entry || !name || id == INVALID_MESSAGE_ID) [[unlikely]] {
+        return false;
+    }
+    entry->id = id;
+    entry->name = name;
+#if MINI_SO_RTOS_TRACE == MINI_SO_RTOS_TRACE_SYSVIEW
+    if (detail::names().started) {
+        SEGGER_SYSVIEW_NameResource(detail::message_resource(id), name);
+    }
+#endif
+    return true;
+}
+
+} // namespace rtos_trace
+} // namespace mini_so
@@ -0,0 +1,367 @@
+/**
+ * @file dispatcher.h
+ * @brief Mini SObjectizer 디스패처 - Agent 그룹을 워커 태스크(코어)에 바인딩
+ *
+ * SObjectizer 모델의 디스패처:
+ * - OneThreadDispatcher:     Agent 그룹 하나를 워커 하나가 처리
+ * - ThreadPoolDispatcher<N>: Agent 그룹을 워커 N개가 처리 (Agent는 한 번에 한 워커에서만 실행)
+ * - ActiveObjectDispatcher<N>: Agent마다 전용 워커
+ *
+ * 워커는 타겟에서 코어 고정 FreeRTOS 태스크, 호스트(UNIT_TEST)에서 std::thread.
+ * 디스패처에 묶이지 않은 Agent는 기존처럼 Environment::run()이 처리.
+ * 그룹 간 전송은 lock-free 메일박스를 통해 이루어지며, 수신 Agent의 ReadySet에
+ * ready 비트가 설정되고 대기 중인 워커가 task notification으로 깨어남.
+ */
+
+#pragma once
+
+#include "../mini_sobjectizer.h"
+
+#ifdef UNIT_TEST
+#include <thread>
+#endif
+
+static_assert(MINI_SO_QUEUE_POLICY != MINI_SO_QUEUE_SPSC,
+              "Dispatchers require multi-producer mailboxes (MINI_SO_QUEUE_MPSC or MINI_SO_QUEUE_MUTEX)");
+
+// ============================================================================
+// Dispatcher Configuration
+// ============================================================================
+#ifndef MINI_SO_DISPATCHER_STACK_WORDS
+#define MINI_SO_DISPATCHER_STACK_WORDS 512
+#endif
+
+#ifndef MINI_SO_DISPATCHER_TASK_PRIORITY
+#define MINI_SO_DISPATCHER_TASK_PRIORITY 2
+#endif
+
+// 처리할 Agent가 없을 때 워커 대기 시간 (ready 알림이 오면 즉시 깨어남)
+#ifndef MINI_SO_DISPATCHER_IDLE_TICKS
+#define MINI_SO_DISPATCHER_IDLE_TICKS portMAX_DELAY
+#endif
+
+namespace mini_so {
+
+constexpr int32_t ANY_CORE = -1;
+
+// 워커 태스크 설정 (호스트에서는 name/stack/priority/core 무시)
+struct WorkerConfig {
+    const char* name = "mso_disp";
+    uint32_t stack_words = MINI_SO_DISPATCHER_STACK_WORDS;
+    UBaseType_t priority = MINI_SO_DISPATCHER_TASK_PRIORITY;
+    int32_t core = ANY_CORE;
+};
+
+namespace detail {
+
+// 플랫폼 워커 스레드: FreeRTOS 태스크 (코어 고정) 또는 호스트 std::thread
+class WorkerThread {
+public:
+    using Entry = void (*)(void* arg) noexcept;
+    
+    WorkerThread() noexcept = default;
+    ~WorkerThread() noexcept { join(); }
+    
+    WorkerThread(const WorkerThread&) = delete;
+    WorkerThread& operator=(const WorkerThread&) = delete;
+    
+    bool start(Entry entry, void* arg, const WorkerConfig& config) noexcept;
+    // entry가 반환된 뒤 스레드 자원 회수 (정지 요청은 디스패처가 담당)
+    void join() noexcept;
+    
+    bool started() const noexcept { return started_; }
+    bool exited() const noexcept { return exited_.load(std::memory_order_acquire); }
+    
+    // 정지 대기 루프용 양보
+    static void yield() noexcept;
+
+private:
+    Entry entry_ = nullptr;
+    void* arg_ = nullptr;
+    bool started_ = false;
+    std::atomic<bool> exited_{false};
+
+#ifdef UNIT_TEST
+    std::thread thread_;
+#else
+    TaskHandle_t task_ = nullptr;
+    static void task_entry(void* self);
+#endif
+
+    void run() noexcept {
+        entry_(arg_);
+        exited_.store(true, std::memory_order_release);
+    }
+};
+
+// 여러 워커가 공유하는 Agent 그룹의 배타 실행: Agent별 busy 비트로 한 Agent가
+// 동시에 두 워커에서 실행되지 않도록 보장 (Agent 단위 단일 스레드 의미 유지)
+class ExclusiveVisitor {
+public:
+    // from의 level 클래스에서 Agent 하나를 꺼내 실행. 남은 메시지는 Agent 메일박스가
+    // 연결된 ReadySet(홈)에 다시 표시 - from이 다른 워커의 ReadySet이어도 동일
+    template<std::size_t N>
+    bool run_one(ReadySet& from, std::size_t level, std::array<Agent*, N>& agents) noexcept {
+        std::size_t index;
+        while (from.take_next(level, index)) {
+            Agent* agent = agents[index];
+            if (!agent) [[unlikely]] continue;
+            
+            const uint32_t bit = 1u << (index % ReadySet::WORD_BITS);
+            auto& busy = busy_[index / ReadySet::WORD_BITS];
+            if (busy.fetch_or(bit, std::memory_order_acq_rel) & bit) {
+                // 다른 워커가 실행 중 - 그 워커가 종료 후 메시지를 보고 다시 표시함
+                continue;
+            }
+            
+            visit_agent(*agent, level);
+            
+            // busy 해제 후 잔여 메시지 확인 (순서가 바뀌면 위 continue와 경합해 wakeup 유실)
+            busy.fetch_and(~bit, std::memory_order_acq_rel);
+            if (agent->has_messages()) {
+                agent->message_queue_.mark_ready(static_cast<std::size_t>(agent->priority()));
+            }
+            return true;
+        }
+        return false;
+    }
+
+private:
+    std::array<std::atomic<uint32_t>, ReadySet::WORDS> busy_{};
+};
+
+// 디스패처 공통: Agent 바인딩과 ReadySet
+// 바인딩된 Agent의 메일박스는 Environment 대신 이 ReadySet에 ready 비트를 설정
+class DispatcherBase {
+public:
+    DispatcherBase() noexcept = default;
+    
+    DispatcherBase(const DispatcherBase&) = delete;
+    DispatcherBase& operator=(const DispatcherBase&) = delete;
+    
+    // Environment에 등록된 Agent를 이 디스패처로 이동
+    // 이동 시점에 다른 스케줄러가 그 Agent를 처리 중이면 안 됨 (start 전 바인딩 권장)
+    bool bind(Agent& agent) noexcept { return attach(agent, ready_); }
+    // Environment 기본 스케줄러로 되돌림 - unregister_agent 전에 호출
+    void unbind(Agent& agent) noexcept {
+        if (detach(agent)) {
+            ready_.clear(detail::agent_index(agent.id()));
+        }
+    }
+    
+    bool is_bound(const Agent& agent) const noexcept {
+        const std::size_t index = detail::agent_index(agent.id());
+        return index < MINI_SO_MAX_AGENTS && agents_[index] == &agent;
+    }
+    std::size_t bound_agents() const noexcept { return bound_count_; }
+    bool has_ready_agents() const noexcept { return ready_.any(); }
+    bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+protected:
+    ~DispatcherBase() noexcept = default;
+    
+    // 워커 공통 루프: 정지 요청까지 round()를 반복, 할 일이 없으면 ready 알림 대기
+    template<typename RoundFn>
+    void worker_loop(RoundFn&& round) noexcept {
+        while (running_.load(std::memory_order_acquire)) {
+            if (!round()) {
+                ready_.wait(MINI_SO_DISPATCHER_IDLE_TICKS);
+            }
+        }
+    }
+    
+    // Agent 메일박스를 set에 연결 / Environment로 되돌림 (set의 남은 비트는 호출자가 정리)
+    bool attach(Agent& agent, ReadySet& set) noexcept;
+    bool detach(Agent& agent) noexcept;
+    
+    // 정지 요청 후 모든 워커가 루프를 빠져나올 때까지 깨우고 회수
+    void stop_workers(WorkerThread* workers, std::size_t count) noexcept {
+        stop_workers(workers, count, [this]() noexcept { ready_.wake_all(); });
+    }
+    
+    // wake: 대기 중인 워커를 모두 깨우는 함수 (워커별 ReadySet을 쓰는 디스패처용)
+    template<typename WakeFn>
+    void stop_workers(WorkerThread* workers, std::size_t count, WakeFn&& wake) noexcept {
+        running_.store(false, std::memory_order_release);
+        
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!workers[i].started()) {
+                continue;
+            }
+            // 대기 슬롯에 들어가기 직전의 워커도 놓치지 않도록 종료할 때까지 반복해서 깨움
+            while (!workers[i].exited()) {
+                wake();
+                WorkerThread::yield();
+            }
+            workers[i].join();
+        }
+    }
+    
+    detail::ReadySet ready_;
+    alignas(64) std::array<Agent*, MINI_SO_MAX_AGENTS> agents_{};
+    std::size_t bound_count_ = 0;
+    std::atomic<bool> running_{false};
+};
+
+} // namespace detail
+
+// ============================================================================
+// OneThreadDispatcher - Agent 그룹 하나를 워커 하나가 처리
+// ============================================================================
+class OneThreadDispatcher : public detail::DispatcherBase {
+public:
+    explicit OneThreadDispatcher(const WorkerConfig& config = WorkerConfig{}) noexcept : config_(config) {
+        ready_.set_exclusive(true);  // 워커 하나 - 같은 그룹 파이프라인 단계는 직접 호출
+    }
+    ~OneThreadDispatcher() noexcept { stop(); }
+    
+    void configure(const WorkerConfig& config) noexcept { config_ = config; }
+    
+    bool start() noexcept;
+    void stop() noexcept;
+
+private:
+    static void worker_entry(void* self) noexcept;
+    
+    WorkerConfig config_;
+    detail::WorkerThread worker_;
+};
+
+// ============================================================================
+// ThreadPoolDispatcher - Agent 그룹을 워커 N개가 공유
+// ============================================================================
+// 워커들은 같은 ReadySet에서 ready Agent를 가져가며, busy 비트로 Agent가 동시에
+// 두 워커에서 실행되지 않도록 보장 (Agent 단위 단일 스레드 의미 유지).
+template<std::size_t Workers>
+class ThreadPoolDispatcher : public detail::DispatcherBase {
+    static_assert(Workers > 0, "Thread pool needs at least one worker");
+    static_assert(Workers <= detail::ReadySet::MAX_WAITERS,
+                  "Increase MINI_SO_MAX_READY_WAITERS for more pool workers");
+
+public:
+    // config.core가 지정되면 워커 i는 core + i 코어에 배치 (configure_worker로 개별 지정 가능)
+    explicit ThreadPoolDispatcher(const WorkerConfig& config = WorkerConfig{}) noexcept {
+        for (std::size_t i = 0; i < Workers; ++i) {
+            configs_[i] = config;
+            if (config.core != ANY_CORE) {
+                configs_[i].core = config.core + static_cast<int32_t>(i);
+            }
+        }
+        ready_.set_exclusive(Workers == 1);  // 워커가 여럿이면 단계가 서로 다른 워커에서 동시에 돌 수 있음
+    }
+    ~ThreadPoolDispatcher() noexcept { stop(); }
+    
+    void configure_worker(std::size_t worker, const WorkerConfig& config) noexcept {
+        if (worker < Workers) configs_[worker] = config;
+    }
+    
+    static constexpr std::size_t worker_count() noexcept { return Workers; }
+    
+    bool start() noexcept {
+        if (running()) return true;
+        running_.store(true, std::memory_order_release);
+        for (std::size_t i = 0; i < Workers; ++i) {
+            if (!workers_[i].start(&ThreadPoolDispatcher::worker_entry, this, configs_[i])) [[unlikely]] {
+                stop();
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    void stop() noexcept {
+        stop_workers(workers_.data(), Workers);
+    }
+
+private:
+    static void worker_entry(void* self) noexcept {
+        auto* pool = static_cast<ThreadPoolDispatcher*>(self);
+        pool->worker_loop([pool]() noexcept { return pool->run_round(); });
+    }
+    
+    // run_ready_round와 같은 우선순위 규칙, Agent 방문은 busy 비트로 배타 실행
+    bool run_round() noexcept {
+        for (std::size_t level = 0; level < detail::ReadySet::LEVELS; ++level) {
+            if (!ready_.any(level)) continue;
+            
+            bool processed = false;
+            for (std::size_t visit = 0; visit < MINI_SO_PRIORITY_QUANTUM; ++visit) {
+                if (!exclusive_.run_one(ready_, level, agents_)) break;
+                processed = true;
+            }
+            if (processed) return true;
+        }
+        return false;
+    }
+    
+    std::array<WorkerConfig, Workers> configs_{};
+    std::array<detail::WorkerThread, Workers> workers_;
+    detail::ExclusiveVisitor exclusive_;
+};
+
+// ============================================================================
+// ActiveObjectDispatcher - Agent마다 전용 워커
+// ============================================================================
+template<std::size_t MaxAgents>
+class ActiveObjectDispatcher {
+    static_assert(MaxAgents > 0 && MaxAgents <= MINI_SO_MAX_AGENTS, "Invalid active object count");
+
+public:
+    explicit ActiveObjectDispatcher(const WorkerConfig& config = WorkerConfig{}) noexcept : config_(config) {}
+    
+    ActiveObjectDispatcher(const ActiveObjectDispatcher&) = delete;
+    ActiveObjectDispatcher& operator=(const ActiveObjectDispatcher&) = delete;
+    
+    // 빈 슬롯 워커에 Agent 바인딩 (core 지정 시 해당 코어에 고정)
+    bool bind(Agent& agent, int32_t core = ANY_CORE) noexcept {
+        for (auto& slot : slots_) {
+            if (slot.bound_agents() == 0) {
+                WorkerConfig config = config_;
+                if (core != ANY_CORE) {
+                    config.core = core;
+                }
+                slot.configure(config);
+                if (!slot.bind(agent)) [[unlikely]] return false;
+                return !running_ || slot.start();
+            }
+        }
+        return false;
+    }
+    
+    void unbind(Agent& agent) noexcept {
+        for (auto& slot : slots_) {
+            if (slot.is_bound(agent)) {
+                slot.stop();
+                slot.unbind(agent);
+                return;
+            }
+        }
+    }
+    
+    bool start() noexcept {
+        running_ = true;
+        for (auto& slot : slots_) {
+            if (slot.bound_agents() > 0 && !slot.start()) [[unlikely]] {
+                stop();
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    void stop() noexcept {
+        running_ = false;
+        for (auto& slot : slots_) {
+            slot.stop();
+        }
+    }
+    
+    bool running() const noexcept { return running_; }
+
+private:
+    WorkerConfig config_;
+    std::array<OneThreadDispatcher, MaxAgents> slots_;
+    bool running_ = false;
+};
+
+} // namespace mini_so
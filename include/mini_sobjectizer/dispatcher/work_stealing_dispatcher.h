@@ -0,0 +1,202 @@
+/**
+ * @file work_stealing_dispatcher.h
+ * @brief Mini SObjectizer Work-stealing 디스패처 - CPU 부하가 큰 Agent용
+ *
+ * 각 Agent는 바인딩 시 홈 워커를 가지며 메일박스 push는 홈 워커의 ReadySet을 표시.
+ * 워커는 자기 ReadySet을 우선순위 규칙대로 처리하고, 비면 다른 워커의 ReadySet에서
+ * ready Agent를 가져와(steal) 실행. ExclusiveVisitor의 busy 비트로 Agent는 항상
+ * 한 번에 한 워커에서만 실행됨.
+ *
+ * 워커별 카운터(방문, steal, 실행 시간, 대기 횟수)로 코어 사용률 편차를 관찰 가능.
+ */
+
+#pragma once
+
+#include "dispatcher.h"
+
+namespace mini_so {
+
+// 워커 카운터 스냅샷 (busy_time은 마이크로초, hires 클럭)
+struct WorkerStats {
+    uint32_t visits;        // 실행한 Agent 방문 수 (steal 포함)
+    uint32_t steals;        // 다른 워커의 ReadySet에서 가져온 방문 수
+    uint32_t busy_time;     // Agent 실행에 쓴 시간
+    uint32_t idle_waits;    // 처리할 Agent가 없어 대기한 횟수
+};
+
+template<std::size_t Workers>
+class WorkStealingDispatcher : public detail::DispatcherBase {
+    static_assert(Workers > 1, "Work stealing needs at least two workers");
+    static_assert(Workers <= detail::ReadySet::MAX_WAITERS,
+                  "Increase MINI_SO_MAX_READY_WAITERS for more workers");
+
+public:
+    // config.core가 지정되면 워커 i는 core + i 코어에 배치
+    explicit WorkStealingDispatcher(const WorkerConfig& config = WorkerConfig{}) noexcept {
+        for (std::size_t i = 0; i < Workers; ++i) {
+            contexts_[i].owner = this;
+            contexts_[i].index = i;
+            configs_[i] = config;
+            if (config.core != ANY_CORE) {
+                configs_[i].core = config.core + static_cast<int32_t>(i);
+            }
+        }
+    }
+    ~WorkStealingDispatcher() noexcept { stop(); }
+    
+    void configure_worker(std::size_t worker, const WorkerConfig& config) noexcept {
+        if (worker < Workers) configs_[worker] = config;
+    }
+    
+    static constexpr std::size_t worker_count() noexcept { return Workers; }
+    
+    // 홈 워커를 round-robin으로 배정
+    bool bind(Agent& agent) noexcept {
+        return bind(agent, next_home_++ % Workers);
+    }
+    
+    // 홈 워커 지정 (같은 워커에 묶인 Agent는 steal이 없을 때 캐시 지역성 유지)
+    bool bind(Agent& agent, std::size_t worker) noexcept {
+        if (worker >= Workers) [[unlikely]] return false;
+        return attach(agent, contexts_[worker].ready);
+    }
+    
+    void unbind(Agent& agent) noexcept {
+        if (detach(agent)) {
+            for (auto& context : contexts_) {
+                context.ready.clear(agent.id());
+            }
+        }
+    }
+    
+    bool start() noexcept {
+        if (running()) return true;
+        running_.store(true, std::memory_order_release);
+        for (std::size_t i = 0; i < Workers; ++i) {
+            if (!workers_[i].start(&WorkStealingDispatcher::worker_entry, &contexts_[i], configs_[i])) [[unlikely]] {
+                stop();
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    void stop() noexcept {
+        stop_workers(workers_.data(), Workers, [this]() noexcept {
+            for (auto& context : contexts_) {
+                context.ready.wake_all();
+            }
+        });
+    }
+    
+    WorkerStats worker_stats(std::size_t worker) const noexcept {
+        if (worker >= Workers) [[unlikely]] return WorkerStats{0, 0, 0, 0};
+        const auto& counters = contexts_[worker];
+        return WorkerStats{
+            counters.visits.load(std::memory_order_relaxed),
+            counters.steals.load(std::memory_order_relaxed),
+            counters.busy_time.load(std::memory_order_relaxed),
+            counters.idle_waits.load(std::memory_order_relaxed)
+        };
+    }
+    
+    uint32_t total_steals() const noexcept {
+        uint32_t total = 0;
+        for (const auto& context : contexts_) {
+            total += context.steals.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+    
+    void reset_stats() noexcept {
+        for (auto& context : contexts_) {
+            context.visits.store(0, std::memory_order_relaxed);
+            context.steals.store(0, std::memory_order_relaxed);
+            context.busy_time.store(0, std::memory_order_relaxed);
+            context.idle_waits.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    // 워커별 상태 - 카운터는 워커만 쓰고 모니터링 태스크가 읽음 (캐시 라인 분리)
+    struct alignas(64) WorkerContext {
+        detail::ReadySet ready;
+        WorkStealingDispatcher* owner = nullptr;
+        std::size_t index = 0;
+        std::atomic<uint32_t> visits{0};
+        std::atomic<uint32_t> steals{0};
+        std::atomic<uint32_t> busy_time{0};
+        std::atomic<uint32_t> idle_waits{0};
+    };
+    
+    static void worker_entry(void* arg) noexcept {
+        auto* context = static_cast<WorkerContext*>(arg);
+        WorkStealingDispatcher* self = context->owner;
+        
+        while (self->running()) {
+            const HiresTime start = hires_now();
+            if (self->run_round(*context)) {
+                context->busy_time.fetch_add(hires_since_us(start), std::memory_order_relaxed);
+            } else {
+                context->idle_waits.fetch_add(1, std::memory_order_relaxed);
+                self->wait_for_work();
+            }
+        }
+    }
+    
+    // 자기 ReadySet 우선 (run_ready_round 규칙), 비었으면 높은 클래스부터 다른 워커에서 steal
+    bool run_round(WorkerContext& context) noexcept {
+        for (std::size_t level = 0; level < detail::ReadySet::LEVELS; ++level) {
+            if (!context.ready.any(level)) continue;
+            
+            bool processed = false;
+            for (std::size_t visit = 0; visit < MINI_SO_PRIORITY_QUANTUM; ++visit) {
+                if (!exclusive_.run_one(context.ready, level, agents_)) break;
+                context.visits.fetch_add(1, std::memory_order_relaxed);
+                processed = true;
+            }
+            if (processed) return true;
+        }
+        
+        for (std::size_t level = 0; level < detail::ReadySet::LEVELS; ++level) {
+            for (std::size_t offset = 1; offset < Workers; ++offset) {
+                detail::ReadySet& victim = contexts_[(context.index + offset) % Workers].ready;
+                if (victim.any(level) && exclusive_.run_one(victim, level, agents_)) {
+                    context.visits.fetch_add(1, std::memory_order_relaxed);
+                    context.steals.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    
+    // 모든 워커의 ReadySet에 대기 등록 - 어느 홈에 일이 생겨도 유휴 워커가 깨어나 steal
+    void wait_for_work() noexcept {
+        TaskHandle_t self = xTaskGetCurrentTaskHandle();
+        std::array<std::atomic<TaskHandle_t>*, Workers> slots{};
+        
+        bool ready = false;
+        for (std::size_t i = 0; i < Workers; ++i) {
+            slots[i] = contexts_[i].ready.add_waiter(self);
+        }
+        for (const auto& context : contexts_) {
+            ready = ready || context.ready.any();
+        }
+        if (!ready && running()) {
+            Observer::on_idle(MINI_SO_DISPATCHER_IDLE_TICKS);
+            ulTaskNotifyTake(pdTRUE, MINI_SO_DISPATCHER_IDLE_TICKS);
+        }
+        for (std::size_t i = 0; i < Workers; ++i) {
+            contexts_[i].ready.remove_waiter(slots[i], self);
+        }
+    }
+    
+    std::array<WorkerContext, Workers> contexts_;
+    std::array<WorkerConfig, Workers> configs_{};
+    std::array<detail::WorkerThread, Workers> workers_;
+    detail::ExclusiveVisitor exclusive_;
+    std::size_t next_home_ = 0;
+};
+
+} // namespace mini_so
@@ -0,0 +1,286 @@
+/**
+ * @file batch_kernels.h
+ * @brief Mini SObjectizer 메시지 배치용 센서 커널 - SoA 뷰 위의 SIMD 합/평균, min/max, 임계 검사
+ *
+ * handle_batch가 받은 같은 타입 메시지 배치에서 float 필드를 필드별 연속 배열(SoA)로 한 번 모은 뒤
+ * 커널이 4개(SSE/NEON/Helium) 단위로 처리. 배치 포인터는 핸들러 반환 후 무효이므로 뷰는 스택에 둠.
+ *
+ *     std::size_t handle_batch(Span<const MessageBase* const> batch) noexcept override {
+ *         if (batch[0]->type_id() != MESSAGE_TYPE_ID(SensorReading)) return Agent::handle_batch(batch);
+ *         dsp::BatchView<SensorReading, &SensorReading::temperature, &SensorReading::pressure> view(batch);
+ *         const dsp::MinMax range = dsp::min_max(view.column<&SensorReading::temperature>());
+ *         if (dsp::count_outside(view.column<&SensorReading::pressure>(), 950.0f, 1050.0f) > 0) { ... }
+ *         average_.add(view.column<&SensorReading::temperature>());
+ *         return batch.size();
+ *     }
+ *
+ * 백엔드 (컴파일 타임 선택, MINI_SO_DSP_BACKEND로 확인):
+ * - MINI_SO_USE_CMSIS_DSP 정의 시 CMSIS-DSP (arm_mean_f32/arm_min_f32/arm_max_f32 - Cortex-M55/M85에서는
+ *   라이브러리의 Helium 구현). 임계 검사는 스칼라 루프 (-O2 MVE 자동 벡터화 대상)
+ * - __ARM_NEON: NEON (AArch64는 가로 축약 명령, ARMv7은 pairwise)
+ * - __SSE__ / x86-64: SSE
+ * - 그 외: 스칼라
+ */
+
+#pragma once
+
+#include "../mini_sobjectizer.h"
+
+#if defined(MINI_SO_USE_CMSIS_DSP)
+#include "arm_math.h"
+#define MINI_SO_DSP_BACKEND "cmsis-dsp"
+#define MINI_SO_DSP_CMSIS 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MINI_SO_DSP_BACKEND "neon"
+#define MINI_SO_DSP_NEON 1
+#elif defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define MINI_SO_DSP_BACKEND "sse"
+#define MINI_SO_DSP_SSE 1
+#else
+#define MINI_SO_DSP_BACKEND "scalar"
+#endif
+
+namespace mini_so {
+namespace dsp {
+
+struct MinMax {
+    float min;
+    float max;
+};
+
+// ============================================================================
+// BatchView - 배치의 float 필드를 필드별 연속 배열로 모은 SoA 뷰
+// ============================================================================
+// Fields: float T::* 멤버 포인터. 행 수는 배치 크기 (최대 MINI_SO_MAX_BATCH)
+template<typename T, auto... Fields>
+class BatchView {
+    static_assert(sizeof...(Fields) > 0, "BatchView needs at least one field");
+    static_assert((std::is_same_v<decltype(Fields), float T::*> && ...), "BatchView fields must be float members of T");
+
+public:
+    static constexpr std::size_t ROWS = MINI_SO_MAX_BATCH;
+    
+    // batch는 모두 Message<T>여야 함 (handle_batch는 같은 타입 연속 메시지만 전달)
+    explicit BatchView(Span<const MessageBase* const> batch) noexcept
+        : size_(batch.size() < ROWS ? batch.size() : ROWS) {
+        for (std::size_t row = 0; row < size_; ++row) {
+            const T& data = static_cast<const Message<T>*>(batch[row])->data;
+            std::size_t column = 0;
+            ((columns_[column++][row] = data.*Fields), ...);
+        }
+    }
+    
+    constexpr std::size_t size() const noexcept { return size_; }
+    
+    template<auto Field>
+    Span<const float> column() const noexcept {
+        constexpr std::size_t index = index_of<Field>();
+        static_assert(index < sizeof...(Fields), "Field is not part of this BatchView");
+        return Span<const float>(columns_[index], size_);
+    }
+
+private:
+    template<auto Field>
+    static constexpr std::size_t index_of() noexcept {
+        static_assert(std::is_same_v<decltype(Field), float T::*>, "Field must be a float member of T");
+        std::size_t index = 0;
+        bool found = false;
+        ((found = found || Field == Fields, index += found ? 0 : 1), ...);
+        return index;
+    }
+    
+    alignas(16) float columns_[sizeof...(Fields)][ROWS];
+    std::size_t size_;
+};
+
+// ============================================================================
+// 커널 - 길이 제한 없음 (뷰 열 또는 임의 float 배열)
+// ============================================================================
+
+inline float sum(Span<const float> x) noexcept {
+    const float* p = x.data();
+    const std::size_t n = x.size();
+    std::size_t i = 0;
+    float total = 0.0f;
+#if defined(MINI_SO_DSP_CMSIS)
+    if (n > 0) {
+        float32_t mean_value;
+        arm_mean_f32(p, static_cast<uint32_t>(n), &mean_value);
+        return mean_value * static_cast<float>(n);
+    }
+#elif defined(MINI_SO_DSP_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (; i + 4 <= n; i += 4) {
+        acc = vaddq_f32(acc, vld1q_f32(p + i));
+    }
+#if defined(__aarch64__)
+    total = vaddvq_f32(acc);
+#else
+    float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    total = vget_lane_f32(vpadd_f32(pair, pair), 0);
+#endif
+#elif defined(MINI_SO_DSP_SSE)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_add_ps(acc, _mm_loadu_ps(p + i));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; i < n; ++i) {
+        total += p[i];
+    }
+    return total;
+}
+
+inline float mean(Span<const float> x) noexcept {
+    return x.empty() ? 0.0f : sum(x) / static_cast<float>(x.size());
+}
+
+// 빈 입력이면 {0, 0}
+inline MinMax min_max(Span<const float> x) noexcept {
+    const float* p = x.data();
+    const std::size_t n = x.size();
+    if (n == 0) [[unlikely]] {
+        return MinMax{0.0f, 0.0f};
+    }
+#if defined(MINI_SO_DSP_CMSIS)
+    MinMax result;
+    uint32_t index;
+    arm_min_f32(p, static_cast<uint32_t>(n), &result.min, &index);
+    arm_max_f32(p, static_cast<uint32_t>(n), &result.max, &index);
+    return result;
+#else
+    MinMax result{p[0], p[0]};
+    std::size_t i = 0;
+#if defined(MINI_SO_DSP_NEON)
+    if (n >= 4) {
+        float32x4_t low = vld1q_f32(p);
+        float32x4_t high = low;
+        for (i = 4; i + 4 <= n; i += 4) {
+            const float32x4_t v = vld1q_f32(p + i);
+            low = vminq_f32(low, v);
+            high = vmaxq_f32(high, v);
+        }
+#if defined(__aarch64__)
+        result.min = vminvq_f32(low);
+        result.max = vmaxvq_f32(high);
+#else
+        float32x2_t low_pair = vpmin_f32(vget_low_f32(low), vget_high_f32(low));
+        float32x2_t high_pair = vpmax_f32(vget_low_f32(high), vget_high_f32(high));
+        result.min = vget_lane_f32(vpmin_f32(low_pair, low_pair), 0);
+        result.max = vget_lane_f32(vpmax_f32(high_pair, high_pair), 0);
+#endif
+    }
+#elif defined(MINI_SO_DSP_SSE)
+    if (n >= 4) {
+        __m128 low = _mm_loadu_ps(p);
+        __m128 high = low;
+        for (i = 4; i + 4 <= n; i += 4) {
+            const __m128 v = _mm_loadu_ps(p + i);
+            low = _mm_min_ps(low, v);
+            high = _mm_max_ps(high, v);
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, low);
+        result.min = lanes[0];
+        for (int lane = 1; lane < 4; ++lane) result.min = lanes[lane] < result.min ? lanes[lane] : result.min;
+        _mm_store_ps(lanes, high);
+        result.max = lanes[0];
+        for (int lane = 1; lane < 4; ++lane) result.max = lanes[lane] > result.max ? lanes[lane] : result.max;
+    }
+#endif
+    for (; i < n; ++i) {
+        result.min = p[i] < result.min ? p[i] : result.min;
+        result.max = p[i] > result.max ? p[i] : result.max;
+    }
+    return result;
+#endif
+}
+
+// [low, high] 밖의 값 비트마스크 (비트 i = x[i], 앞 64개까지) - 알람 대상 행 찾기
+inline uint64_t outside_mask(Span<const float> x, float low, float high) noexcept {
+    const float* p = x.data();
+    const std::size_t n = x.size() < 64 ? x.size() : 64;
+    uint64_t mask = 0;
+    std::size_t i = 0;
+#if defined(MINI_SO_DSP_NEON)
+    const float32x4_t lo = vdupq_n_f32(low);
+    const float32x4_t hi = vdupq_n_f32(high);
+    static const uint32_t lane_bits[4] = {1, 2, 4, 8};
+    const uint32x4_t bits = vld1q_u32(lane_bits);
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t v = vld1q_f32(p + i);
+        const uint32x4_t outside = vorrq_u32(vcltq_f32(v, lo), vcgtq_f32(v, hi));
+        const uint32x4_t selected = vandq_u32(outside, bits);
+#if defined(__aarch64__)
+        const uint64_t lanes = vaddvq_u32(selected);
+#else
+        const uint32x2_t pair = vadd_u32(vget_low_u32(selected), vget_high_u32(selected));
+        const uint64_t lanes = vget_lane_u32(vpadd_u32(pair, pair), 0);
+#endif
+        mask |= lanes << i;
+    }
+#elif defined(MINI_SO_DSP_SSE)
+    const __m128 lo = _mm_set1_ps(low);
+    const __m128 hi = _mm_set1_ps(high);
+    for (; i + 4 <= n; i += 4) {
+        const __m128 v = _mm_loadu_ps(p + i);
+        const __m128 outside = _mm_or_ps(_mm_cmplt_ps(v, lo), _mm_cmpgt_ps(v, hi));
+        mask |= static_cast<uint64_t>(_mm_movemask_ps(outside)) << i;
+    }
+#endif
+    for (; i < n; ++i) {
+        mask |= static_cast<uint64_t>(p[i] < low || p[i] > high) << i;
+    }
+    return mask;
+}
+
+// [low, high] 밖의 값 개수 (길이 제한 없음)
+inline std::size_t count_outside(Span<const float> x, float low, float high) noexcept {
+    std::size_t count = 0;
+    for (std::size_t offset = 0; offset < x.size(); offset += 64) {
+        const std::size_t chunk = x.size() - offset < 64 ? x.size() - offset : 64;
+        uint64_t mask = outside_mask(Span<const float>(x.data() + offset, chunk), low, high);
+        for (; mask; mask &= mask - 1) count++;
+    }
+    return count;
+}
+
+// ============================================================================
+// MovingAverage - 최근 Window개 샘플의 이동 평균 (배치 단위로 누적)
+// ============================================================================
+// 슬라이딩 합은 샘플마다 앞 값에 의존하므로 스칼라 O(1)/샘플. 배치 평균만 필요하면 mean() 사용
+template<std::size_t Window>
+class MovingAverage {
+    static_assert(Window > 0, "Moving average window must be at least 1");
+
+public:
+    void add(Span<const float> x) noexcept {
+        for (float value : x) {
+            total_ += value - samples_[next_];
+            samples_[next_] = value;
+            next_ = next_ + 1 < Window ? next_ + 1 : 0;
+            if (count_ < Window) count_++;
+        }
+    }
+    
+    float value() const noexcept { return count_ > 0 ? total_ / static_cast<float>(count_) : 0.0f; }
+    std::size_t count() const noexcept { return count_; }
+    
+    void reset() noexcept {
+        *this = MovingAverage{};
+    }
+
+private:
+    float samples_[Window] = {};
+    float total_ = 0.0f;
+    std::size_t next_ = 0;
+    std::size_t count_ = 0;
+};
+
+} // namespace dsp
+} // namespace mini_so
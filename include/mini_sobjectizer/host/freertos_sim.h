@@ -0,0 +1,56 @@
+/**
+ * @file freertos_sim.h
+ * @brief 호스트용 스레드 기반 FreeRTOS 시뮬레이터 API (src/freertos_sim.cpp)
+ *
+ * freertos_mock.cpp 대신 링크하면 태스크는 std::thread, 뮤텍스/큐/태스크 알림은
+ * std::mutex + std::condition_variable로 실제 동작. 1 tick = 1 ms (configTICK_RATE_HZ 1000).
+ * mini_sobjectizer.h가 선언하는 mock 부분집합에 태스크 생성, 지연, 큐 API를 더함.
+ *
+ * FreeRTOS와의 차이:
+ * - 우선순위는 기록만 함 (호스트 스케줄러가 선점 결정)
+ * - vTaskDelete(other)는 대상 태스크가 다음 시뮬레이터 API를 호출할 때 적용됨
+ * - 같은 태스크의 뮤텍스 재획득은 FreeRTOS에서 교착이므로 진단 후 abort
+ */
+
+#pragma once
+
+#include "../mini_sobjectizer.h"
+
+#ifdef UNIT_TEST
+
+#ifndef pdPASS
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#endif
+
+#ifndef errQUEUE_FULL
+#define errQUEUE_FULL 0
+#endif
+
+#ifndef tskIDLE_PRIORITY
+#define tskIDLE_PRIORITY 0
+#endif
+
+extern "C" {
+    typedef void (*TaskFunction_t)(void* pvParameters);
+
+    // 스케줄러 시작 전 생성된 태스크는 vTaskStartScheduler()에서 시작
+    BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char* pcName, uint32_t usStackDepth,
+                           void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pxCreatedTask);
+    void vTaskDelete(TaskHandle_t xTaskToDelete);
+    void vTaskDelay(TickType_t xTicksToDelay);
+    const char* pcTaskGetName(TaskHandle_t xTaskToQuery);
+    UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask);
+
+    // 모든 태스크가 끝나거나 vTaskEndScheduler()가 호출될 때까지 반환하지 않음
+    void vTaskStartScheduler(void);
+    void vTaskEndScheduler(void);
+
+    QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+    BaseType_t xQueueSend(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait);
+    BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait);
+    UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
+    void vQueueDelete(QueueHandle_t xQueue);
+}
+
+#endif // UNIT_TEST
@@ -0,0 +1,381 @@
+/**
+ * @file replay.h
+ * @brief 호스트 기록-재생 - 타겟 trace ring 덤프(trace::dump_all)를 같은 Agent 구성에 다시 보냄
+ *
+ * Capture가 코어별 [DumpHeader][Event × N] 스트림에서 SEND 이벤트(선택 시 DROP 포함)를 시각 순으로 모으고,
+ * Replayer가 원래 간격대로(Pacing::ORIGINAL) 또는 최대 속도로(Pacing::AS_FAST_AS_POSSIBLE) 재전송.
+ * trace에는 payload가 없으므로 타입별로 add_type<T>(make)로 메시지를 만들거나, 등록되지 않은 타입은
+ * set_raw_fallback(bytes)으로 type_id만 같은 0 payload 이미지를 send_raw로 보냄.
+ *
+ *     replay::Capture capture;
+ *     capture.load_file("field.bin");
+ *     replay::Replayer replayer;                       // Environment::instance()
+ *     replayer.add_type<SensorReading>();              // 기본 생성 payload
+ *     replayer.add_source(SENSOR_TASK_ID);             // 핸들러가 다시 보낸 메시지는 재생하지 않음
+ *     replay::Report report = replayer.run(capture, replay::Pacing::ORIGINAL);
+ *
+ * 결과: 처리량(offered/sent/dropped, 시간), 대상 Agent별 메일박스 high-water(MINI_SO_MAILBOX_STATS),
+ * 대상 Agent들의 큐 대기/핸들러 시간 분위(MINI_SO_ENABLE_LATENCY_HISTOGRAMS).
+ * Agent ID는 캡처와 같은 순서로 등록하면 그대로 맞고, 다르면 map_agent로 바꿈.
+ */
+
+#pragma once
+
+#include "../mini_sobjectizer.h"
+
+#ifdef UNIT_TEST
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace mini_so {
+namespace replay {
+
+// 재생할 전송 하나 (캡처 시각은 첫 이벤트 기준 마이크로초)
+struct Event {
+    uint64_t time_us;
+    MessageId type_id;
+    AgentId sender;
+    AgentId target;
+    bool dropped;         // 캡처에서 DROP (push 실패) - include_drops일 때만
+};
+
+class Capture {
+public:
+    // trace::dump_all 스트림 해석. false: magic/버전 불일치, 잘린 스트림 (이전 내용은 비워짐)
+    bool load(const void* data, std::size_t size, bool include_drops = false) noexcept {
+        events_.clear();
+        overwritten_ = 0;
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        std::size_t offset = 0;
+        uint64_t first_us = UINT64_MAX;
+        
+        while (offset + sizeof(trace::DumpHeader) <= size) {
+            trace::DumpHeader header;
+            std::memcpy(&header, bytes + offset, sizeof(header));
+            offset += sizeof(header);
+            if (header.magic != trace::DUMP_MAGIC || header.version != trace::DUMP_VERSION ||
+                header.timestamp_hz == 0 ||
+                size - offset < std::size_t{header.event_count} * sizeof(trace::Event)) [[unlikely]] {
+                events_.clear();
+                return false;
+            }
+            
+            // 코어별 32비트 카운터 wrap 보정 (동시 기록으로 인한 작은 역전은 wrap이 아님)
+            uint64_t wraps = 0;
+            uint32_t last = 0;
+            bool seen = false;
+            for (uint32_t i = 0; i < header.event_count; ++i, offset += sizeof(trace::Event)) {
+                trace::Event event;
+                std::memcpy(&event, bytes + offset, sizeof(event));
+                if (event.sequence == 0) {
+                    ++overwritten_;
+                    continue;
+                }
+                if (seen && event.timestamp < last && last - event.timestamp > 0x80000000u) ++wraps;
+                last = event.timestamp;
+                seen = true;
+                
+                const trace::EventKind kind = event.kind();
+                if (kind != trace::EventKind::SEND && !(include_drops && kind == trace::EventKind::DROP)) {
+                    continue;
+                }
+                const uint64_t ticks = (wraps << 32) | event.timestamp;
+                const uint64_t time_us = ticks * 1000000u / header.timestamp_hz;
+                first_us = std::min(first_us, time_us);
+                events_.push_back(Event{time_us, event.type_id(), event.sender(), event.target(),
+                                        kind == trace::EventKind::DROP});
+            }
+        }
+        
+        // 코어 스트림 병합 (같은 시각은 기록 순서 유지)
+        std::stable_sort(events_.begin(), events_.end(),
+                         [](const Event& a, const Event& b) noexcept { return a.time_us < b.time_us; });
+        for (Event& event : events_) event.time_us -= first_us;
+        return offset == size;
+    }
+    
+    bool load_file(const char* path, bool include_drops = false) noexcept {
+        FILE* file = std::fopen(path, "rb");
+        if (!file) return false;
+        std::vector<uint8_t> data;
+        uint8_t chunk[4096];
+        std::size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            data.insert(data.end(), chunk, chunk + n);
+        }
+        std::fclose(file);
+        return load(data.data(), data.size(), include_drops);
+    }
+    
+    const std::vector<Event>& events() const noexcept { return events_; }
+    std::size_t size() const noexcept { return events_.size(); }
+    uint64_t duration_us() const noexcept { return events_.empty() ? 0 : events_.back().time_us; }
+    // 덤프 중 덮어써져 빠진 이벤트 수 (ring이 가득 찬 채 기록 중이었음)
+    std::size_t overwritten() const noexcept { return overwritten_; }
+
+private:
+    std::vector<Event> events_;
+    std::size_t overwritten_ = 0;
+};
+
+enum class Pacing : uint8_t {
+    ORIGINAL,              // 캡처 간격대로 전송, 시각이 바뀔 때와 기다리는 동안 process_all_messages
+    AS_FAST_AS_POSSIBLE    // drain_every개마다(또는 가득 차면) 비우며 연속 전송
+};
+
+// 합친 히스토그램의 분위 (마이크로초, 버킷 상한)
+struct LatencySummary {
+    uint64_t count = 0;
+    uint32_t p50_us = 0;
+    uint32_t p99_us = 0;
+    uint32_t p999_us = 0;
+    uint32_t max_us = 0;
+};
+
+struct AgentReport {
+    AgentId agent;
+    uint64_t sent;             // 이 Agent로 재생한 전송 수
+    MailboxStats mailbox;      // 재생 중 high-water/push 실패 (MINI_SO_MAILBOX_STATS)
+};
+
+struct Report {
+    uint64_t offered = 0;      // 재생 대상 이벤트 수
+    uint64_t sent = 0;
+    uint64_t dropped = 0;      // 재전송 실패 (가득 참 후 비우고 재시도해도 실패, 대상 없음)
+    uint64_t skipped = 0;      // 등록되지 않은 타입 (raw fallback 없음) 또는 source 밖 발신자
+    double seconds = 0;
+    uint64_t capture_us = 0;   // 캡처 구간 길이
+    uint32_t high_water = 0;   // 대상 메일박스 중 최대 high-water
+    LatencySummary queue;      // 대상 Agent들의 enqueue→dispatch (MINI_SO_ENABLE_LATENCY_HISTOGRAMS)
+    LatencySummary handler;
+    std::vector<AgentReport> agents;
+    
+    double messages_per_second() const noexcept { return seconds > 0 ? static_cast<double>(sent) / seconds : 0; }
+};
+
+class Replayer {
+public:
+    explicit Replayer(Environment& env = Environment::instance()) noexcept : env_(env) {}
+    
+    // T 재생 등록. make(event)가 payload를 만듦 (nullptr = 기본 생성). false: 이미 등록된 type_id
+    template<typename T>
+    bool add_type(T (*make)(const Event&) = nullptr) noexcept {
+        const MessageId id = MESSAGE_TYPE_ID(T);
+        if (find_type(id)) return false;
+        types_.push_back(TypeEntry{id, &send_typed<T>, reinterpret_cast<void (*)()>(make)});
+        return true;
+    }
+    
+    // 등록되지 않은 타입을 payload_bytes 크기의 0 payload 이미지로 전송 (send_raw). false: 메시지 크기 초과
+    bool set_raw_fallback(std::size_t payload_bytes) noexcept {
+        if (sizeof(MessageBase) + payload_bytes > MINI_SO_MAX_MESSAGE_SIZE) return false;
+        raw_fallback_ = true;
+        raw_payload_ = payload_bytes;
+        return true;
+    }
+    
+    // 캡처 Agent ID → 호스트 Agent ID (기본: 같은 ID). 발신자와 대상 모두에 적용
+    void map_agent(AgentId captured, AgentId host) noexcept {
+        for (auto& entry : agent_map_) {
+            if (entry.first == captured) {
+                entry.second = host;
+                return;
+            }
+        }
+        agent_map_.emplace_back(captured, host);
+    }
+    
+    // 이 (캡처) 발신자의 전송만 재생. 없으면 전부 - 핸들러가 다시 보낸 메시지가 두 번 생기지 않도록
+    // 외부 입력(태스크/ISR/드라이버 Agent)만 지정
+    void add_source(AgentId captured_sender) noexcept { sources_.push_back(captured_sender); }
+    
+    // AS_FAST_AS_POSSIBLE에서 몇 개 보낼 때마다 비울지 (기본 32)
+    void set_drain_every(uint32_t messages) noexcept { drain_every_ = messages > 0 ? messages : 1; }
+    
+    Report run(const Capture& capture, Pacing pacing) noexcept {
+        using Clock = std::chrono::steady_clock;
+        Report report;
+        report.capture_us = capture.duration_us();
+        
+        // 대상 Agent 통계를 재생 구간만으로
+        for (const Event& event : capture.events()) {
+            if (!replayed(event)) continue;
+            const AgentId target = map(event.target);
+            if (!find_agent(report, target)) report.agents.push_back(AgentReport{target, 0, MailboxStats{}});
+        }
+        env_.process_all_messages();
+        for (const AgentReport& agent : report.agents) reset_stats(agent.agent);
+        
+        const auto start = Clock::now();
+        uint32_t since_drain = 0;
+        uint64_t previous_us = 0;
+        for (const Event& event : capture.events()) {
+            if (!replayed(event)) {
+                ++report.skipped;
+                continue;
+            }
+            ++report.offered;
+            
+            // 시각이 바뀔 때마다 디스패처가 한 번은 돈다고 봄 (늦어져도) - 같은 시각의 묶음은 그대로 몰아 보냄
+            if (pacing == Pacing::ORIGINAL && event.time_us != previous_us) {
+                const auto due = start + std::chrono::microseconds(event.time_us);
+                env_.process_all_messages();
+                while (Clock::now() < due) {
+                    std::this_thread::yield();
+                    env_.process_all_messages();
+                }
+                previous_us = event.time_us;
+            }
+            
+            const AgentId sender = map(event.sender);
+            const AgentId target = map(event.target);
+            int sent = send(event, sender, target);
+            if (sent == 0) {
+                // 가득 참으로 보고 비운 뒤 한 번 재시도
+                env_.process_all_messages();
+                since_drain = 0;
+                sent = send(event, sender, target);
+            }
+            if (sent < 0) {
+                ++report.skipped;
+                --report.offered;
+                continue;
+            }
+            if (sent > 0) {
+                ++report.sent;
+                ++find_agent(report, target)->sent;
+            } else {
+                ++report.dropped;
+            }
+            
+            if (pacing == Pacing::AS_FAST_AS_POSSIBLE && ++since_drain >= drain_every_) {
+                env_.process_all_messages();
+                since_drain = 0;
+            }
+        }
+        env_.process_all_messages();
+        report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        
+        for (AgentReport& agent : report.agents) {
+            agent.mailbox = env_.mailbox_stats(agent.agent);
+            report.high_water = std::max(report.high_water, agent.mailbox.high_water);
+        }
+#if MINI_SO_ENABLE_LATENCY_HISTOGRAMS
+        report.queue = summarize(report, &LatencyProfile::queue);
+        report.handler = summarize(report, &LatencyProfile::handler);
+#endif
+        return report;
+    }
+
+private:
+    using SendFn = bool (*)(Environment&, AgentId, AgentId, const Event&, void (*)());
+    
+    struct TypeEntry {
+        MessageId id;
+        SendFn send;
+        void (*make)();   // T (*)(const Event&)로 되돌려 호출
+    };
+    
+    template<typename T>
+    static bool send_typed(Environment& env, AgentId sender, AgentId target, const Event& event,
+                           void (*make)()) noexcept {
+        const auto maker = reinterpret_cast<T (*)(const Event&)>(make);
+        return env.try_send(sender, target, maker ? maker(event) : T{}) == SendResult::SENT;
+    }
+    
+    // 1 = 전송, 0 = 실패 (재시도 대상), -1 = 보낼 방법 없음 (등록되지 않은 타입)
+    int send(const Event& event, AgentId sender, AgentId target) noexcept {
+        if (const TypeEntry* type = find_type(event.type_id)) {
+            return type->send(env_, sender, target, event, type->make) ? 1 : 0;
+        }
+        if (!raw_fallback_) return -1;
+        
+        alignas(std::max_align_t) uint8_t image[MINI_SO_MAX_MESSAGE_SIZE] = {};
+        auto* message = new (image) MessageBase(event.type_id, sender);
+        message->mark_sent();
+        return env_.send_raw(target, *message, static_cast<uint16_t>(sizeof(MessageBase) + raw_payload_)) ? 1 : 0;
+    }
+    
+    const TypeEntry* find_type(MessageId id) const noexcept {
+        for (const TypeEntry& type : types_) {
+            if (type.id == id) return &type;
+        }
+        return nullptr;
+    }
+    
+    bool replayed(const Event& event) const noexcept {
+        if (event.target == INVALID_AGENT_ID) return false;   // 연결되지 않은 큐로의 push
+        return sources_.empty() || std::find(sources_.begin(), sources_.end(), event.sender) != sources_.end();
+    }
+    
+    AgentId map(AgentId captured) const noexcept {
+        for (const auto& entry : agent_map_) {
+            if (entry.first == captured) return entry.second;
+        }
+        return captured;
+    }
+    
+    static AgentReport* find_agent(Report& report, AgentId id) noexcept {
+        for (AgentReport& agent : report.agents) {
+            if (agent.agent == id) return &agent;
+        }
+        return nullptr;
+    }
+    
+    void reset_stats(AgentId id) noexcept {
+        if (Agent* agent = env_.get_agent(id)) agent->reset_mailbox_stats();
+#if MINI_SO_ENABLE_LATENCY_HISTOGRAMS
+        env_.latency().reset_agent(id);
+#endif
+    }
+
+#if MINI_SO_ENABLE_LATENCY_HISTOGRAMS
+    // 대상 Agent 히스토그램을 버킷 단위로 합쳐 분위 계산
+    LatencySummary summarize(const Report& report, LatencyHistogram LatencyProfile::*which) const noexcept {
+        std::vector<uint64_t> counts(LatencyHistogram::BUCKETS, 0);
+        LatencySummary summary;
+        for (const AgentReport& agent : report.agents) {
+            const LatencyProfile* profile = env_.latency().agent(agent.agent);
+            if (!profile) continue;
+            const LatencyHistogram& histogram = profile->*which;
+            for (std::size_t i = 0; i < LatencyHistogram::BUCKETS; ++i) counts[i] += histogram.bucket_count(i);
+            summary.count += histogram.count();
+            summary.max_us = std::max(summary.max_us, histogram.max());
+        }
+        auto value_at = [&](uint64_t per_mille) noexcept {
+            const uint64_t rank = (summary.count * per_mille + 999) / 1000;
+            uint64_t seen = 0;
+            for (std::size_t i = 0; i < LatencyHistogram::BUCKETS; ++i) {
+                seen += counts[i];
+                if (seen >= rank && seen > 0) return std::min(LatencyHistogram::bucket_upper(i), summary.max_us);
+            }
+            return summary.max_us;
+        };
+        if (summary.count > 0) {
+            summary.p50_us = value_at(500);
+            summary.p99_us = value_at(990);
+            summary.p999_us = value_at(999);
+        }
+        return summary;
+    }
+#endif
+
+    Environment& env_;
+    std::vector<TypeEntry> types_;
+    std::vector<std::pair<AgentId, AgentId>> agent_map_;
+    std::vector<AgentId> sources_;
+    bool raw_fallback_ = false;
+    std::size_t raw_payload_ = 0;
+    uint32_t drain_every_ = 32;
+};
+
+} // namespace replay
+} // namespace mini_so
+
+#endif // UNIT_TEST
@@ -0,0 +1,294 @@
+/**
+ * @file shm_transport.h
+ * @brief 호스트 프로세스 간 공유 메모리 전송 - HIL 시뮬레이션에서 Environment 여러 개를 연결
+ *
+ * POSIX shm_open + mmap으로 만든 세그먼트에 방향별 SPSC byte ring 두 개를 둠.
+ * 레코드 = [ShmRecord 8B][Message<T> 이미지 (MessageHeader + payload), 8바이트 정렬]
+ * 송신 proxy(ShmRemoteAgent)는 자기 메일박스 레코드를 ring으로 memcpy 한 번, 수신 측 poll()은 ring의
+ * 이미지를 그대로 MessageBase로 보고 Environment::send_raw로 대상 메일박스에 넣음 (직렬화/스키마 없음).
+ * 두 프로세스가 같은 바이너리 구성(타입 ID, 메시지 레이아웃)으로 빌드되었다고 가정.
+ *
+ *     // 프로세스 A                                  // 프로세스 B
+ *     ShmChannel link("/hil_bus", ShmSide::A);      ShmChannel link("/hil_bus", ShmSide::B);
+ *     ShmRemoteAgent motor(link, MOTOR_ID_IN_B);    // MOTOR_ID_IN_B = B에서 register_agent한 ID
+ *     AgentId motor_id = env.register_agent(&motor);
+ *     env.send_message(self, motor_id, Cmd{..});    for (;;) { link.poll(); env.run(); }
+ *
+ * 수신은 polling (poll()을 부르는 루프의 주기가 지연 시간을 결정 - busy poll이면 1us 미만).
+ */
+
+#pragma once
+
+#include "../mini_sobjectizer.h"
+
+#ifdef UNIT_TEST
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 방향별 ring 크기 (바이트, 2의 거듭제곱)
+#ifndef MINI_SO_SHM_RING_BYTES
+#define MINI_SO_SHM_RING_BYTES 65536
+#endif
+
+// 채널 하나에 연결할 수 있는 ShmRemoteAgent 수 (수신 메시지의 발신자를 proxy ID로 변환)
+#ifndef MINI_SO_SHM_MAX_PROXIES
+#define MINI_SO_SHM_MAX_PROXIES 8
+#endif
+
+namespace mini_so {
+
+namespace detail {
+
+// 공유 메모리 단일 생산자/단일 소비자 byte ring. head/tail은 단조 증가 64비트 위치.
+// 끝에 맞지 않는 레코드는 남은 공간을 padding 레코드로 채우고 처음부터 씀 (메일박스와 같은 방식).
+template<std::size_t CapacityBytes>
+struct ShmRing {
+    static_assert((CapacityBytes & (CapacityBytes - 1)) == 0 && CapacityBytes >= 1024,
+                  "Shared memory ring must be a power of two (>= 1KB)");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Cross-process ring needs lock-free 64-bit atomics");
+    
+    static constexpr std::size_t MASK = CapacityBytes - 1;
+    static constexpr std::size_t ALIGN = 8;
+    static constexpr uint16_t PADDING = 0xFFFF;
+    
+    struct Record {
+        uint16_t size;        // Message<T> 이미지 바이트 (PADDING = 끝까지 건너뜀)
+        AgentId target_id;    // 수신 프로세스 Environment의 Agent ID
+        uint32_t reserved;
+    };
+    
+    static constexpr std::size_t record_bytes(std::size_t size) noexcept {
+        return sizeof(Record) + ((size + ALIGN - 1) & ~(ALIGN - 1));
+    }
+    
+    alignas(64) std::atomic<uint64_t> head{0};   // 소비자 전용
+    alignas(64) std::atomic<uint64_t> tail{0};   // 생산자 전용
+    alignas(64) uint8_t data[CapacityBytes];
+    
+    // 생산자: 공간이 없으면 false (대기 없음)
+    bool push(AgentId target_id, const MessageBase& message, uint16_t size) noexcept {
+        const std::size_t need = record_bytes(size);
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        const uint64_t used = position - head.load(std::memory_order_acquire);
+        const std::size_t offset = static_cast<std::size_t>(position & MASK);
+        const std::size_t contiguous = CapacityBytes - offset;
+        
+        if (contiguous < need) {
+            if (CapacityBytes - used < contiguous + need) return false;
+            const Record padding{PADDING, INVALID_AGENT_ID, 0};
+            std::memcpy(&data[offset], &padding, sizeof(padding));
+            position += contiguous;
+        } else if (CapacityBytes - used < need) {
+            return false;
+        }
+        
+        uint8_t* at = &data[position & MASK];
+        const Record record{size, target_id, 0};
+        std::memcpy(at, &record, sizeof(record));
+        std::memcpy(at + sizeof(record), &message, size);
+        tail.store(position + need, std::memory_order_release);
+        return true;
+    }
+    
+    // 소비자: 게시된 레코드를 순서대로 fn(target_id, MessageBase&, size)로 전달 - 반환: 레코드 수
+    template<typename Fn>
+    std::size_t drain(std::size_t max_records, Fn&& fn) noexcept {
+        uint64_t position = head.load(std::memory_order_relaxed);
+        const uint64_t end = tail.load(std::memory_order_acquire);
+        std::size_t drained = 0;
+        while (position != end && drained < max_records) {
+            const std::size_t offset = static_cast<std::size_t>(position & MASK);
+            Record record;
+            std::memcpy(&record, &data[offset], sizeof(record));
+            if (record.size == PADDING) {
+                position += CapacityBytes - offset;
+                continue;
+            }
+            fn(record.target_id, *reinterpret_cast<MessageBase*>(&data[offset + sizeof(record)]), record.size);
+            position += record_bytes(record.size);
+            drained++;
+        }
+        head.store(position, std::memory_order_release);
+        return drained;
+    }
+};
+
+} // namespace detail
+
+enum class ShmSide : uint8_t { A, B };
+
+// ============================================================================
+// ShmChannel - 두 프로세스 사이의 양방향 채널 (세그먼트 하나, ring 두 개)
+// ============================================================================
+class ShmChannel {
+public:
+    static constexpr std::size_t RING_BYTES = MINI_SO_SHM_RING_BYTES;
+    static constexpr std::size_t MAX_PROXIES = MINI_SO_SHM_MAX_PROXIES;
+    using Ring = detail::ShmRing<RING_BYTES>;
+    
+    // 같은 name으로 양쪽이 연다. 세그먼트를 처음 만든 쪽이 초기화하고, 다른 쪽은 magic이 게시될 때까지 대기
+    ShmChannel(const char* name, ShmSide side) noexcept : side_(side) {
+        int fd = ::shm_open(name, O_CREAT | O_RDWR, 0600);
+        if (fd < 0) [[unlikely]] return;
+        struct stat info{};
+        const bool fresh = ::fstat(fd, &info) == 0 && info.st_size == 0;
+        if (fresh && ::ftruncate(fd, sizeof(Segment)) != 0) [[unlikely]] {
+            ::close(fd);
+            return;
+        }
+        void* mapped = ::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) [[unlikely]] return;
+        
+        segment_ = static_cast<Segment*>(mapped);
+        if (fresh) {
+            new (segment_) Segment();
+            segment_->magic.store(MAGIC, std::memory_order_release);
+        }
+        while (segment_->magic.load(std::memory_order_acquire) != MAGIC) {
+            ::usleep(100);  // 상대가 초기화하는 중 (ftruncate 직후 0으로 채워진 상태)
+        }
+    }
+    
+    ~ShmChannel() noexcept {
+        if (segment_) {
+            ::munmap(segment_, sizeof(Segment));
+        }
+    }
+    
+    ShmChannel(const ShmChannel&) = delete;
+    ShmChannel& operator=(const ShmChannel&) = delete;
+    
+    // 세그먼트 이름 제거 (매핑은 양쪽이 닫을 때까지 유지) - 보통 시뮬레이션 종료 시 한쪽에서 호출
+    static void unlink(const char* name) noexcept { ::shm_unlink(name); }
+    
+    bool ready() const noexcept { return segment_ != nullptr; }
+    
+    // 상대 프로세스의 target_id Agent에게 메시지 이미지 전송 - ring이 가득 차면 false
+    bool send(AgentId target_id, const MessageBase& message, uint16_t size) noexcept {
+        if (!segment_ || !tx().push(target_id, message, size)) [[unlikely]] {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+    
+    // 상대가 보낸 메시지를 로컬 Environment에 주입 - 반환: 전달한 수. 수신 루프에서 주기적으로 호출
+    std::size_t poll(std::size_t max_records = SIZE_MAX) noexcept {
+        if (!segment_) [[unlikely]] return 0;
+        Environment& env = Environment::instance();
+        std::size_t delivered = 0;
+        rx().drain(max_records, [&](AgentId target_id, MessageBase& message, uint16_t size) noexcept {
+            // ring 안에서 제자리 수정: 발신자는 로컬 proxy ID로, 전송 시각은 로컬 클럭으로
+            message.header.set_sender(local_sender(message.sender_id()));
+            message.mark_sent();
+            delivered += env.send_raw(target_id, message, size) ? 1 : 0;
+        });
+        return delivered;
+    }
+    
+    bool has_pending() const noexcept {
+        return segment_ && rx().head.load(std::memory_order_relaxed) != rx().tail.load(std::memory_order_acquire);
+    }
+    
+    uint32_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    
+    // proxy 연결 - 상대의 remote_id가 보낸 메시지는 proxy의 로컬 ID를 발신자로 주입 (답장 가능)
+    bool attach(const Agent& proxy, AgentId remote_id) noexcept {
+        for (auto& entry : proxies_) {
+            if (!entry.proxy) {
+                entry.remote_id = remote_id;
+                entry.proxy = &proxy;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void detach(const Agent& proxy) noexcept {
+        for (auto& entry : proxies_) {
+            if (entry.proxy == &proxy) entry.proxy = nullptr;
+        }
+    }
+
+private:
+    static constexpr uint32_t MAGIC = 0x4D534F31;  // "MSO1"
+    
+    struct Segment {
+        std::atomic<uint32_t> magic{0};
+        Ring rings[2];  // rings[0]: A → B, rings[1]: B → A
+    };
+    
+    struct Proxy {
+        const Agent* proxy = nullptr;
+        AgentId remote_id = INVALID_AGENT_ID;
+    };
+    
+    Ring& tx() noexcept { return segment_->rings[side_ == ShmSide::A ? 0 : 1]; }
+    Ring& rx() noexcept { return segment_->rings[side_ == ShmSide::A ? 1 : 0]; }
+    const Ring& rx() const noexcept { return segment_->rings[side_ == ShmSide::A ? 1 : 0]; }
+    
+    AgentId local_sender(AgentId remote_sender) const noexcept {
+        for (const auto& entry : proxies_) {
+            if (entry.proxy && entry.remote_id == remote_sender) return entry.proxy->id();
+        }
+        return INVALID_AGENT_ID;
+    }
+    
+    Segment* segment_ = nullptr;
+    const ShmSide side_;
+    std::array<Proxy, MAX_PROXIES> proxies_{};
+    std::atomic<uint32_t> dropped_{0};
+};
+
+// ============================================================================
+// ShmRemoteAgent - 상대 프로세스 Agent의 로컬 proxy 메일박스
+// ============================================================================
+// 로컬 Agent는 이 proxy의 ID로 평소처럼 send_message/publish. 방문마다 메일박스 레코드를
+// (타입과 무관하게) 크기 그대로 ring으로 복사하므로 핸들러/스키마가 필요 없음.
+// ring이 차면 메시지를 버리고 channel.dropped()에 셈 - 메일박스에 남겨두면 run()이 상대의 poll()을
+// 기다리며 proxy를 계속 다시 방문하므로 (양쪽이 run() 안에서 서로를 기다리는 livelock), UART FIFO처럼 버림.
+// ring 크기(MINI_SO_SHM_RING_BYTES)를 poll 주기 동안의 최대 전송량 이상으로 설정.
+class ShmRemoteAgent : public Agent {
+public:
+    ShmRemoteAgent(ShmChannel& channel, AgentId remote_id) noexcept
+        : channel_(channel), remote_id_(remote_id) {
+        channel_.attach(*this, remote_id);
+    }
+    
+    ~ShmRemoteAgent() override { channel_.detach(*this); }
+    
+    constexpr AgentId remote_id() const noexcept { return remote_id_; }
+    
+    using Agent::process_messages;
+    void process_messages(uint32_t max_messages) noexcept override {
+        if (!message_queue_.try_lock_consumer()) [[unlikely]] {
+            return;
+        }
+        for (uint32_t i = 0; i < max_messages; ++i) {
+            const bool consumed = message_queue_.consume([this](const MessageBase& msg, uint16_t size) noexcept {
+                detail::LatestCells::Buffer latest;
+                if (const MessageBase* resolved = latest_.resolve(msg, size, latest)) {
+                    channel_.send(remote_id_, *resolved, size);  // 가득 차면 channel.dropped()
+                }
+            });
+            if (!consumed) break;
+        }
+        message_queue_.unlock_consumer();
+        message_queue_.notify_space();
+    }
+    
+    // process_messages가 메일박스를 직접 옮기므로 호출되지 않음
+    bool handle_message(const MessageBase&) noexcept override { return false; }
+
+private:
+    ShmChannel& channel_;
+    const AgentId remote_id_;
+};
+
+} // namespace mini_so
+
+#endif // UNIT_TEST
@@ -19,8 +19,12 @@
 #include <cstddef>
 #include <functional>
 #include <array>
+#include <tuple>
+#include <utility>
 #include <type_traits>
 #include <atomic>  // Atomic operations for lock-free queue implementation
+#include <cstring> // memcpy/memset for mailbox records
+#include <new>     // placement new (Lazy<T> 활성화)
 
 // FreeRTOS includes or mock definitions for testing
 #ifdef UNIT_TEST
@@ -49,16 +53,36 @@ typedef uint32_t UBaseType_t;
 #define configTICK_RATE_HZ 1000
 #endif
 
+// 정적 뮤텍스 제어 블록 - 호스트 백엔드가 내부 상태를 이 안에 제자리 생성
+typedef struct {
+    alignas(16) unsigned char storage[128];
+} StaticSemaphore_t;
+
+#ifndef configSUPPORT_STATIC_ALLOCATION
+#define configSUPPORT_STATIC_ALLOCATION 1
+#endif
+
 // Mock FreeRTOS function declarations for testing
 extern "C" {
     SemaphoreHandle_t xSemaphoreCreateMutex(void);
+    SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* pxMutexBuffer);
     BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait);
     BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
     void vSemaphoreDelete(SemaphoreHandle_t xSemaphore);
     TickType_t xTaskGetTickCount(void);
+    void vTaskDelay(TickType_t xTicksToDelay);
     void taskDISABLE_INTERRUPTS(void);
+    TaskHandle_t xTaskGetCurrentTaskHandle(void);
+    BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify);
+    void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t* pxHigherPriorityTaskWoken);
+    uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
 }
 
+// 호스트에는 인터럽트 컨텍스트가 없으므로 yield 요청은 무시
+#ifndef portYIELD_FROM_ISR
+#define portYIELD_FROM_ISR(x) ((void)(x))
+#endif
+
 #else
 // Real FreeRTOS includes for embedded target
 #include "FreeRTOS.h"
@@ -74,6 +98,27 @@ extern "C" {
 #define MINI_SO_MAX_AGENTS 16
 #endif
 
+// Cooperation 하나에 담는 최대 Agent 수
+#ifndef MINI_SO_COOP_MAX_AGENTS
+#define MINI_SO_COOP_MAX_AGENTS 8
+#endif
+
+// deregister_coop 해제 전 대기 메시지 처리 라운드 수 (coop 안의 Agent끼리 주고받는 메시지 한도)
+#ifndef MINI_SO_COOP_DRAIN_ROUNDS
+#define MINI_SO_COOP_DRAIN_ROUNDS 4
+#endif
+
+// Router 하나가 분배하는 최대 worker 수
+#ifndef MINI_SO_ROUTER_MAX_WORKERS
+#define MINI_SO_ROUTER_MAX_WORKERS 8
+#endif
+
+// 지연 활성화 Agent (Environment::register_lazy, Lazy<T>): 슬롯별 예약 포인터 표와
+// 전달 경로의 빈 슬롯 확인 한 번이 추가됨 (기본 off)
+#ifndef MINI_SO_ENABLE_LAZY_AGENTS
+#define MINI_SO_ENABLE_LAZY_AGENTS 0
+#endif
+
 #ifndef MINI_SO_MAX_QUEUE_SIZE
 #define MINI_SO_MAX_QUEUE_SIZE 64
 #endif
@@ -91,6 +136,296 @@ extern "C" {
 #define MINI_SO_ENABLE_VALIDATION 1
 #endif
 
+// 메일박스별 high-water mark, push 실패 코드별 수, 포화 시간 (MailboxStats, 메일박스당 32바이트)
+#ifndef MINI_SO_MAILBOX_STATS
+#define MINI_SO_MAILBOX_STATS MINI_SO_ENABLE_METRICS
+#endif
+
+// 포화로 보는 메일박스 바이트 점유율 (%)
+#ifndef MINI_SO_MAILBOX_SATURATION_PERCENT
+#define MINI_SO_MAILBOX_SATURATION_PERCENT 75
+#endif
+
+// 메시지별 큐 대기/핸들러 시간 히스토그램 (Agent별 + 타입별, RAM 사용량이 커서 기본 off)
+#ifndef MINI_SO_ENABLE_LATENCY_HISTOGRAMS
+#define MINI_SO_ENABLE_LATENCY_HISTOGRAMS 0
+#endif
+
+// 타입별 히스토그램을 유지하는 메시지 타입 수
+#ifndef MINI_SO_LATENCY_TYPES
+#define MINI_SO_LATENCY_TYPES 8
+#endif
+
+// 압축 메시지 헤더: 16비트 타입 ID + 8비트 발신자 (4바이트), 전송 타임스탬프는 지연 히스토그램이
+// 켜졌을 때만. 메일박스 레코드 헤더/정렬도 4바이트로 줄어듦 (64비트 호스트는 포인터 정렬 8바이트).
+// AgentId가 8비트에 들어가야 하므로 MINI_SO_MAX_AGENTS <= 64, 메시지 정렬은 레코드 정렬 이하
+#ifndef MINI_SO_COMPACT_HEADER
+#define MINI_SO_COMPACT_HEADER 0
+#endif
+
+#if !MINI_SO_COMPACT_HEADER || MINI_SO_ENABLE_LATENCY_HISTOGRAMS
+#define MINI_SO_HEADER_TIMESTAMP 1
+#else
+#define MINI_SO_HEADER_TIMESTAMP 0
+#endif
+
+// 바이너리 trace ring (send/dispatch/핸들러 종료 이벤트, 기본 off)
+#ifndef MINI_SO_ENABLE_TRACE
+#define MINI_SO_ENABLE_TRACE 0
+#endif
+
+// RTOS 트레이스 도구 백엔드 (diag/rtos_trace.h를 관찰자로 선택): 0 = 없음
+#define MINI_SO_RTOS_TRACE_SYSVIEW 1       // SEGGER SystemView
+#define MINI_SO_RTOS_TRACE_TRACEALYZER 2   // Percepio Tracealyzer (TraceRecorder 4.6+)
+
+#ifndef MINI_SO_RTOS_TRACE
+#define MINI_SO_RTOS_TRACE 0
+#endif
+
+// 디스패치 관찰자: send/enqueue 실패/디스패치 시작·끝/idle 훅을 정적 함수로 가진 타입 (Observer 참고).
+// 기본 NullObserver는 빈 inline 훅이라 코드가 생성되지 않음.
+// MINI_SO_OBSERVER_HEADER: 관찰자 타입을 선언한 헤더 (기본 타입 선언 뒤 전역 범위에서 include)
+#if MINI_SO_RTOS_TRACE && !defined(MINI_SO_OBSERVER)
+#define MINI_SO_OBSERVER ::mini_so::rtos_trace::Observer
+#define MINI_SO_OBSERVER_HEADER "diag/rtos_trace.h"
+#endif
+#ifndef MINI_SO_OBSERVER
+#define MINI_SO_OBSERVER ::mini_so::NullObserver
+#endif
+
+// 코어별 ring 이벤트 수 (2의 거듭제곱, 이벤트당 16바이트)
+#ifndef MINI_SO_TRACE_EVENTS
+#define MINI_SO_TRACE_EVENTS 256
+#endif
+
+// trace ring 개수 (SMP 포트는 코어 수, 그 외 1)
+#ifndef MINI_SO_TRACE_CORES
+#if defined(configNUMBER_OF_CORES)
+#define MINI_SO_TRACE_CORES configNUMBER_OF_CORES
+#else
+#define MINI_SO_TRACE_CORES 1
+#endif
+#endif
+
+// 고해상도 클럭 소스 (측정 경로 전용 - 스케줄링/타이머/워치독은 now() 틱 유지)
+#define MINI_SO_HIRES_TICKS 0   // FreeRTOS 틱 (1/configTICK_RATE_HZ 해상도)
+#define MINI_SO_HIRES_DWT 1     // Cortex-M3/M4/M7 DWT CYCCNT (configCPU_CLOCK_HZ 사이클)
+#define MINI_SO_HIRES_STEADY 2  // 호스트 std::chrono::steady_clock
+#define MINI_SO_HIRES_CUSTOM 3  // 사용자 제공 mini_so_hires_clock_now() (MINI_SO_HIRES_COUNTS_PER_US)
+
+#ifndef MINI_SO_HIRES_CLOCK
+#if defined(UNIT_TEST)
+#define MINI_SO_HIRES_CLOCK MINI_SO_HIRES_STEADY
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define MINI_SO_HIRES_CLOCK MINI_SO_HIRES_DWT
+#else
+#define MINI_SO_HIRES_CLOCK MINI_SO_HIRES_TICKS
+#endif
+#endif
+
+#if MINI_SO_HIRES_CLOCK == MINI_SO_HIRES_CUSTOM
+#ifndef MINI_SO_HIRES_COUNTS_PER_US
+#define MINI_SO_HIRES_COUNTS_PER_US 1
+#endif
+extern "C" uint32_t mini_so_hires_clock_now(void);
+#endif
+
+// 메일박스 동기화 정책 (QueuePolicy 참고)
+#define MINI_SO_QUEUE_MUTEX 0
+#define MINI_SO_QUEUE_SPSC 1
+#define MINI_SO_QUEUE_MPSC 2
+
+#ifndef MINI_SO_QUEUE_POLICY
+#define MINI_SO_QUEUE_POLICY MINI_SO_QUEUE_MPSC
+#endif
+
+// Agent당 내장 메일박스 바이트 크기 (2의 거듭제곱, 0 = 내장 버퍼 없음 - SizedAgent로 Agent마다 지정)
+// 기본값: 평균 32바이트 레코드 기준 MINI_SO_MAX_QUEUE_SIZE개
+#ifndef MINI_SO_MAILBOX_BYTES
+#define MINI_SO_MAILBOX_BYTES (MINI_SO_MAX_QUEUE_SIZE * 32)
+#endif
+
+// 빠른 RAM(CCM/DTCM) 배치: 1이면 아래 속성이 .bss.mini_so.* 섹션을 가리키고, 링커 스크립트 조각
+// bench/target/mini_so_placement.ld가 이를 MINI_SO_FAST 영역으로 모음 (0 = 속성 없음, 기본 배치)
+#ifndef MINI_SO_FAST_RAM
+#define MINI_SO_FAST_RAM 0
+#endif
+
+// set_mailbox_storage 버퍼에 붙이는 배치 속성. .bss. 접두사라 0이 아닌 정적 초기값을 가진 객체
+// (vtable이 있는 Agent 객체 자체)에 붙이면 컴파일 오류 - startup이 0으로만 채우는 영역
+//   alignas(64) static uint8_t motor_box[1024] MINI_SO_MAILBOX_PLACEMENT;
+#ifndef MINI_SO_MAILBOX_PLACEMENT
+#if MINI_SO_FAST_RAM
+#define MINI_SO_MAILBOX_PLACEMENT __attribute__((section(".bss.mini_so.mailbox")))
+#else
+#define MINI_SO_MAILBOX_PLACEMENT
+#endif
+#endif
+
+// trace ring 배치 속성 (inline 함수의 정적 객체라 메일박스와 다른 섹션 이름 사용)
+#ifndef MINI_SO_TRACE_PLACEMENT
+#if MINI_SO_FAST_RAM
+#define MINI_SO_TRACE_PLACEMENT __attribute__((section(".bss.mini_so.trace")))
+#else
+#define MINI_SO_TRACE_PLACEMENT
+#endif
+#endif
+
+// 보존 RAM 배치 속성 - 링커 스크립트의 NOLOAD 섹션 (startup 코드가 0으로 지우지 않는 영역)
+#ifndef MINI_SO_RETAINED
+#if defined(UNIT_TEST)
+#define MINI_SO_RETAINED
+#else
+#define MINI_SO_RETAINED __attribute__((section(".noinit")))
+#endif
+#endif
+
+// 웜 재시작: 제어된 재시작 직전 Agent::snapshot 상태를 CRC 보호 보존 RAM 이미지에 저장하고
+// 다음 부팅의 등록 시점에 Agent::restore로 되돌림 (기본 off - Agent vtable에 가상 함수 2개 추가)
+#ifndef MINI_SO_ENABLE_WARM_RESTART
+#define MINI_SO_ENABLE_WARM_RESTART 0
+#endif
+
+// 보존 이미지의 레코드 영역 크기 (헤더 16바이트 별도, 레코드마다 4바이트 + payload 4바이트 정렬)
+#ifndef MINI_SO_WARM_RESTART_BYTES
+#define MINI_SO_WARM_RESTART_BYTES 512
+#endif
+
+// 커널 뮤텍스를 객체 안의 정적 제어 블록으로 생성 (xSemaphoreCreateMutexStatic - 힙 사용, 생성 실패 없음)
+// 기본값: FreeRTOSConfig.h의 configSUPPORT_STATIC_ALLOCATION
+#ifndef MINI_SO_STATIC_SEMAPHORES
+#if defined(configSUPPORT_STATIC_ALLOCATION) && configSUPPORT_STATIC_ALLOCATION
+#define MINI_SO_STATIC_SEMAPHORES 1
+#else
+#define MINI_SO_STATIC_SEMAPHORES 0
+#endif
+#endif
+
+// ReadySet 하나를 동시에 기다릴 수 있는 태스크 수 (디스패처 워커 수 상한)
+#ifndef MINI_SO_MAX_READY_WAITERS
+#define MINI_SO_MAX_READY_WAITERS 4
+#endif
+
+// Agent 1회 방문당 최대 처리 메시지 수
+#ifndef MINI_SO_MESSAGE_QUANTUM
+#define MINI_SO_MESSAGE_QUANTUM 8
+#endif
+
+// OverloadPolicy::BLOCK 기본 대기 한도 (틱)
+#ifndef MINI_SO_OVERLOAD_BLOCK_TICKS
+#define MINI_SO_OVERLOAD_BLOCK_TICKS 10
+#endif
+
+// Environment::run() 몇 회마다 PerformanceAgent가 Agent 카운터를 수집하는지
+// (32비트 카운터 wrap 전에 증분을 누적하기 위함, 조회 시에도 수집)
+#ifndef MINI_SO_METRICS_COLLECT_RUNS
+#define MINI_SO_METRICS_COLLECT_RUNS 64
+#endif
+
+// handle_batch로 한 번에 전달하는 같은 타입 메시지 최대 수 (스택 포인터 배열 크기)
+#ifndef MINI_SO_MAX_BATCH
+#define MINI_SO_MAX_BATCH 16
+#endif
+
+// 같은 우선순위 클래스에서 연속 방문하는 Agent 수 (이후 상위 클래스 재확인)
+// 상위 클래스 최악 대기 = QUANTUM × MESSAGE_QUANTUM개 하위 핸들러 실행 시간
+#ifndef MINI_SO_PRIORITY_QUANTUM
+#define MINI_SO_PRIORITY_QUANTUM 2
+#endif
+
+// 적응형 quantum (Agent::set_adaptive_quantum)의 스케줄링 라운드 시간 목표 (마이크로초).
+// 방문 예산 = 라운드 예산 / MINI_SO_PRIORITY_QUANTUM. Environment::set_round_budget_us로 변경
+#ifndef MINI_SO_ROUND_BUDGET_US
+#define MINI_SO_ROUND_BUDGET_US 1000
+#endif
+
+// 적응형 quantum 기본 상한 (방문당 메시지 수)
+#ifndef MINI_SO_ADAPTIVE_QUANTUM_MAX
+#define MINI_SO_ADAPTIVE_QUANTUM_MAX 64
+#endif
+
+// 타입별 공유(참조 카운트) 브로드캐스트 payload 슬롯 수
+#ifndef MINI_SO_SHARED_POOL_SIZE
+#define MINI_SO_SHARED_POOL_SIZE 16
+#endif
+
+// send_pooled_message용 타입별 전용 풀 기본 슬롯 수 (MessagePoolSize<T>로 타입별 변경, 0이면 arena)
+#ifndef MINI_SO_MESSAGE_POOL_SIZE
+#define MINI_SO_MESSAGE_POOL_SIZE 32
+#endif
+
+// UniqueBuffer<T> 타입별 블록 풀 기본 블록 수 (BufferPoolSize<T>로 타입별 변경)
+#ifndef MINI_SO_BUFFER_POOL_SIZE
+#define MINI_SO_BUFFER_POOL_SIZE 4
+#endif
+
+// 공유 size-class arena (16/32/64/128바이트) 클래스별 슬롯 수
+#ifndef MINI_SO_ARENA_SLOTS
+#define MINI_SO_ARENA_SLOTS 8
+#endif
+
+// 동시에 걸 수 있는 지연/주기 타이머 수 (정적 노드 풀)
+#ifndef MINI_SO_MAX_TIMERS
+#define MINI_SO_MAX_TIMERS 32
+#endif
+
+// 타이머 노드에 복사해 두는 메시지 payload 최대 크기
+#ifndef MINI_SO_TIMER_PAYLOAD_SIZE
+#define MINI_SO_TIMER_PAYLOAD_SIZE 32
+#endif
+
+// send_from_isr용 인터럽트 메일박스 슬롯 수 (2의 거듭제곱)
+#ifndef MINI_SO_ISR_QUEUE_SIZE
+#define MINI_SO_ISR_QUEUE_SIZE 16
+#endif
+
+// 인터럽트 메일박스 슬롯에 복사해 두는 메시지 payload 최대 크기
+#ifndef MINI_SO_ISR_PAYLOAD_SIZE
+#define MINI_SO_ISR_PAYLOAD_SIZE 32
+#endif
+
+// 최신 값 메일박스(MessageCoalesce<T>): Agent당 타입 cell 수 (0 = 비활성)
+#ifndef MINI_SO_LATEST_CELLS
+#define MINI_SO_LATEST_CELLS 2
+#endif
+
+// 최신 값 cell 크기 (sizeof(Message<T>) 이상, 4의 배수)
+#ifndef MINI_SO_LATEST_BYTES
+#define MINI_SO_LATEST_BYTES 48
+#endif
+
+// Mbox 하나가 구독을 추적하는 메시지 타입 수 (고정 해시 테이블 크기)
+#ifndef MINI_SO_MAX_SUBSCRIBED_TYPES
+#define MINI_SO_MAX_SUBSCRIBED_TYPES 32
+#endif
+
+// Agent당 수신 필터(타입별 술어) 수 (0 = 비활성)
+#ifndef MINI_SO_MAX_RECEIVE_FILTERS
+#define MINI_SO_MAX_RECEIVE_FILTERS 4
+#endif
+
+// Environment당 토큰 버킷 한도(발신자 / 발신자+타입 / 구독) 수 (0 = 비활성)
+#ifndef MINI_SO_MAX_RATE_LIMITS
+#define MINI_SO_MAX_RATE_LIMITS 4
+#endif
+
+// 비상 모드에서도 실행하는 중요 Agent 수 (0 = 비상 디스패치 비활성)와 Agent별 전용 메일박스 크기
+// (2의 거듭제곱, 0 = 최대 크기 메시지 레코드 2개가 들어가는 가장 작은 2의 거듭제곱)
+#ifndef MINI_SO_EMERGENCY_AGENTS
+#define MINI_SO_EMERGENCY_AGENTS 4
+#endif
+#ifndef MINI_SO_EMERGENCY_MAILBOX_BYTES
+#define MINI_SO_EMERGENCY_MAILBOX_BYTES 0
+#endif
+
+// 비상 루프 한 라운드에서 중요 Agent당 처리하는 최대 메시지 수와 라운드 주기 (ms)
+#ifndef MINI_SO_EMERGENCY_BUDGET
+#define MINI_SO_EMERGENCY_BUDGET 4
+#endif
+#ifndef MINI_SO_EMERGENCY_PERIOD_MS
+#define MINI_SO_EMERGENCY_PERIOD_MS 10
+#endif
+
 namespace mini_so {
 
 // ============================================================================
@@ -104,6 +439,80 @@ using TimePoint = uint32_t;
 constexpr AgentId INVALID_AGENT_ID = 0xFFFF;
 constexpr MessageId INVALID_MESSAGE_ID = 0xFFFF;
 
+// AgentId = (세대 << 인덱스 비트) | 슬롯 인덱스. unregister 시 슬롯 세대가 올라가므로
+// 해제된 Agent의 옛 ID로 보낸 메시지는 재사용된 슬롯의 새 Agent에 닿지 않고 거부됨.
+// 첫 세대(0)의 ID는 슬롯 인덱스와 같음 (0, 1, 2, ...)
+namespace detail {
+    constexpr unsigned agent_index_bits() noexcept {
+        unsigned bits = 0;
+        while ((std::size_t{1} << bits) < MINI_SO_MAX_AGENTS) ++bits;
+        return bits;
+    }
+    
+    constexpr unsigned AGENT_INDEX_BITS = agent_index_bits();
+    constexpr AgentId AGENT_INDEX_MASK = static_cast<AgentId>((1u << AGENT_INDEX_BITS) - 1);
+    constexpr unsigned AGENT_ID_BITS = MINI_SO_COMPACT_HEADER ? 8 : 16;  // 압축 헤더의 발신자 필드 폭
+    constexpr AgentId AGENT_ID_ALL_ONES = static_cast<AgentId>((1u << AGENT_ID_BITS) - 1);  // INVALID_AGENT_ID로 예약
+    constexpr uint32_t AGENT_GENERATIONS = 1u << (AGENT_ID_BITS - AGENT_INDEX_BITS);
+    
+    constexpr std::size_t agent_index(AgentId id) noexcept { return id & AGENT_INDEX_MASK; }
+    
+    constexpr AgentId make_agent_id(std::size_t index, uint16_t generation) noexcept {
+        return static_cast<AgentId>((static_cast<uint32_t>(generation) << AGENT_INDEX_BITS) | index);
+    }
+    
+    // 다음 세대 - 결과 ID가 INVALID_AGENT_ID가 되는 세대는 건너뜀
+    constexpr uint16_t next_agent_generation(std::size_t index, uint16_t generation) noexcept {
+        uint16_t next = static_cast<uint16_t>((generation + 1u) % AGENT_GENERATIONS);
+        if (make_agent_id(index, next) == AGENT_ID_ALL_ONES) {
+            next = static_cast<uint16_t>((next + 1u) % AGENT_GENERATIONS);
+        }
+        return next;
+    }
+}
+
+#if MINI_SO_COMPACT_HEADER
+static_assert(MINI_SO_MAX_AGENTS >= 1 && detail::AGENT_INDEX_BITS <= 6,
+              "MINI_SO_COMPACT_HEADER needs an 8-bit AgentId with at least 2 generation bits (MINI_SO_MAX_AGENTS <= 64)");
+#else
+static_assert(MINI_SO_MAX_AGENTS >= 1 && detail::AGENT_INDEX_BITS <= 12,
+              "MINI_SO_MAX_AGENTS must leave at least 4 AgentId generation bits (<= 4096)");
+#endif
+
+// 타이머 ID: 하위 16비트 = 노드 인덱스, 상위 16비트 = 세대 (만료/재사용된 타이머의 늦은 cancel 무시)
+using TimerId = uint32_t;
+constexpr TimerId INVALID_TIMER_ID = 0xFFFFFFFF;
+
+// 연속 메모리 뷰 (C++17용 최소 std::span 대체) - 배치 전송/수신에 사용
+template<typename T>
+class Span {
+public:
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+    
+    template<std::size_t N>
+    constexpr Span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+    
+    template<typename U, std::size_t N,
+             typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(std::array<U, N>& array) noexcept : data_(array.data()), size_(N) {}
+    
+    template<typename U, std::size_t N,
+             typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    constexpr Span(const std::array<U, N>& array) noexcept : data_(array.data()), size_(N) {}
+    
+    constexpr T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T& operator[](std::size_t index) const noexcept { return data_[index]; }
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+    
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
 // Phase 3: Zero-overhead 시간 함수
 inline TimePoint now() noexcept {
 #ifdef UNIT_TEST
@@ -114,74 +523,404 @@ inline TimePoint now() noexcept {
 #endif
 }
 
+// 고해상도 클럭: 원시 카운터 값과 마이크로초 변환.
+// 카운터는 32비트로 wrap되므로 구간 측정(차이)에만 사용 (DWT @168 MHz ≈ 25초까지).
+using HiresTime = uint32_t;
+
+#if MINI_SO_HIRES_CLOCK == MINI_SO_HIRES_DWT
+namespace detail {
+    // CMSIS 없이 코어 디버그 레지스터 직접 접근
+    inline volatile uint32_t& dwt_register(uintptr_t address) noexcept {
+        return *reinterpret_cast<volatile uint32_t*>(address);
+    }
+    constexpr uintptr_t DEMCR = 0xE000EDFCu;       // CoreDebug->DEMCR
+    constexpr uintptr_t DWT_CTRL = 0xE0001000u;
+    constexpr uintptr_t DWT_CYCCNT = 0xE0001004u;
+    constexpr uintptr_t DWT_LAR = 0xE0001FB0u;     // Cortex-M7 lock access (M3/M4에서는 무시됨)
+}
+
+inline void hires_clock_init() noexcept {
+    detail::dwt_register(detail::DEMCR) |= (1u << 24);  // TRCENA
+    detail::dwt_register(detail::DWT_LAR) = 0xC5ACCE55u;
+    detail::dwt_register(detail::DWT_CYCCNT) = 0;
+    detail::dwt_register(detail::DWT_CTRL) |= 1u;       // CYCCNTENA
+}
+
+inline HiresTime hires_now() noexcept { return detail::dwt_register(detail::DWT_CYCCNT); }
+
+inline uint32_t hires_elapsed_us(HiresTime start, HiresTime end) noexcept {
+    const uint32_t cycles_per_us = static_cast<uint32_t>(configCPU_CLOCK_HZ) / 1000000u;
+    return (end - start) / (cycles_per_us > 0 ? cycles_per_us : 1u);
+}
+
+inline HiresTime hires_from_us(uint32_t us) noexcept {
+    const uint32_t cycles_per_us = static_cast<uint32_t>(configCPU_CLOCK_HZ) / 1000000u;
+    return us * (cycles_per_us > 0 ? cycles_per_us : 1u);
+}
+#elif MINI_SO_HIRES_CLOCK == MINI_SO_HIRES_STEADY
+inline void hires_clock_init() noexcept {}
+HiresTime hires_now() noexcept;  // steady_clock 마이크로초 (mini_sobjectizer.cpp)
+inline uint32_t hires_elapsed_us(HiresTime start, HiresTime end) noexcept { return end - start; }
+inline HiresTime hires_from_us(uint32_t us) noexcept { return us; }
+#elif MINI_SO_HIRES_CLOCK == MINI_SO_HIRES_CUSTOM
+inline void hires_clock_init() noexcept {}
+inline HiresTime hires_now() noexcept { return mini_so_hires_clock_now(); }
+inline uint32_t hires_elapsed_us(HiresTime start, HiresTime end) noexcept {
+    return (end - start) / MINI_SO_HIRES_COUNTS_PER_US;
+}
+inline HiresTime hires_from_us(uint32_t us) noexcept { return us * MINI_SO_HIRES_COUNTS_PER_US; }
+#else
+inline void hires_clock_init() noexcept {}
+inline HiresTime hires_now() noexcept { return now(); }
+inline uint32_t hires_elapsed_us(HiresTime start, HiresTime end) noexcept {
+    return (end - start) * (1000000u / configTICK_RATE_HZ);
+}
+// 틱 클럭: 올림 (1틱 미만 예산도 최소 1틱)
+inline HiresTime hires_from_us(uint32_t us) noexcept {
+    constexpr uint32_t us_per_tick = 1000000u / configTICK_RATE_HZ;
+    return (us + us_per_tick - 1) / us_per_tick;
+}
+#endif
+
+inline uint32_t hires_since_us(HiresTime start) noexcept { return hires_elapsed_us(start, hires_now()); }
+
+// wrap을 고려한 시각 비교 (두 시각 차이가 카운터 범위의 절반 미만일 때)
+constexpr bool hires_before(HiresTime a, HiresTime b) noexcept { return static_cast<int32_t>(a - b) < 0; }
+
+// 고해상도 카운터의 초당 카운트 (trace 덤프 변환용)
+inline uint32_t hires_frequency_hz() noexcept {
+#if MINI_SO_HIRES_CLOCK == MINI_SO_HIRES_DWT
+    return static_cast<uint32_t>(configCPU_CLOCK_HZ);
+#elif MINI_SO_HIRES_CLOCK == MINI_SO_HIRES_STEADY
+    return 1000000u;
+#elif MINI_SO_HIRES_CLOCK == MINI_SO_HIRES_CUSTOM
+    return MINI_SO_HIRES_COUNTS_PER_US * 1000000u;
+#else
+    return configTICK_RATE_HZ;
+#endif
+}
+
 // ============================================================================
-// Message System - Phase 3: Zero-overhead 메시지 시스템
+// Trace Ring - 메시지 흐름 바이너리 기록 (lock-free, 코어별)
 // ============================================================================
-
-// Phase 3: 최적화된 메시지 헤더 (8바이트로 최소화)
-struct alignas(8) MessageHeader {
-    MessageId type_id;
-    AgentId sender_id;
-    uint32_t timestamp;
+// 이벤트 = 4워드 (16바이트): timestamp | type·kind·depth | sender·target | sequence.
+// 기록자는 fetch_add로 슬롯을 얻어 덮어쓰고 sequence를 마지막에 release로 게시
+// (가장 오래된 이벤트부터 덮어씀). 읽기 측은 sequence 전후 비교로 찢어진 이벤트를 버림.
+// 비활성화(MINI_SO_ENABLE_TRACE=0) 시 trace::record는 빈 inline 함수.
+namespace trace {
+    enum class EventKind : uint8_t {
+        NONE = 0,       // 빈 슬롯 / 덤프 중 덮어써진 이벤트
+        SEND = 1,       // 메일박스 push 성공 (depth = push 후 대기 수)
+        DROP = 2,       // 메일박스 가득 참 등 push 실패
+        DISPATCH = 3,   // 핸들러 호출 직전 (depth = 남은 대기 수)
+        HANDLED = 4,    // 핸들러 종료, 처리됨
+        REJECTED = 5    // 핸들러 종료, 처리하지 않음 (false 반환)
+    };
     
-    constexpr MessageHeader(MessageId id, AgentId sender = INVALID_AGENT_ID) noexcept
-        : type_id(id), sender_id(sender), timestamp(0) {}
+    // 덤프/변환용 이벤트 레이아웃 (리틀 엔디언 워드 4개)
+    struct Event {
+        uint32_t timestamp;   // hires_now() 원시값
+        uint32_t info;        // type_id[31:16] | kind[15:8] | depth[7:0] (255 포화)
+        uint32_t agents;      // sender[31:16] | target[15:0]
+        uint32_t sequence;    // 기록 순번 + 1 (0 = 무효)
         
-    void set_timestamp() noexcept { timestamp = now(); }
-};
-
-// Phase 3: Zero-overhead 메시지 기본 클래스
-class MessageBase {
-public:
-    MessageHeader header;
+        constexpr MessageId type_id() const noexcept { return static_cast<MessageId>(info >> 16); }
+        constexpr EventKind kind() const noexcept { return static_cast<EventKind>((info >> 8) & 0xFFu); }
+        constexpr uint8_t depth() const noexcept { return static_cast<uint8_t>(info & 0xFFu); }
+        constexpr AgentId sender() const noexcept { return static_cast<AgentId>(agents >> 16); }
+        constexpr AgentId target() const noexcept { return static_cast<AgentId>(agents & 0xFFFFu); }
+    };
+    static_assert(sizeof(Event) == 16, "Trace event must stay 4 words");
     
-    constexpr MessageBase(MessageId id, AgentId sender = INVALID_AGENT_ID) noexcept
-        : header(id, sender) {}
+    // 덤프 스트림 헤더 - 코어별 [DumpHeader][Event × event_count]
+    struct DumpHeader {
+        uint32_t magic;           // 'MSOT'
+        uint16_t version;
+        uint16_t core;
+        uint32_t event_count;
+        uint32_t timestamp_hz;    // hires_frequency_hz()
+    };
+    constexpr uint32_t DUMP_MAGIC = 0x544F534Du;  // "MSOT" (리틀 엔디언)
+    constexpr uint16_t DUMP_VERSION = 1;
     
-    // virtual ~MessageBase() = default;  // 제거: memcpy 안전성을 위해
+    template<std::size_t Events>
+    class Ring {
+        static_assert(Events > 0 && (Events & (Events - 1)) == 0, "Trace ring size must be a power of two");
+        
+    public:
+        void record(EventKind kind, MessageId type_id, AgentId sender, AgentId target, std::size_t depth) noexcept {
+            const uint32_t sequence = head_.fetch_add(1, std::memory_order_relaxed);
+            Slot& slot = slots_[sequence & (Events - 1)];
+            const uint32_t info = (static_cast<uint32_t>(type_id) << 16) |
+                                  (static_cast<uint32_t>(kind) << 8) |
+                                  static_cast<uint32_t>(depth < 0xFFu ? depth : 0xFFu);
+            
+            slot.sequence.store(0, std::memory_order_relaxed);  // 기록 중
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.timestamp.store(hires_now(), std::memory_order_relaxed);
+            slot.info.store(info, std::memory_order_relaxed);
+            slot.agents.store((static_cast<uint32_t>(sender) << 16) | target, std::memory_order_relaxed);
+            slot.sequence.store(sequence + 1, std::memory_order_release);
+        }
+        
+        // 기록된 총 이벤트 수 (덮어쓴 것 포함)
+        uint32_t recorded() const noexcept { return head_.load(std::memory_order_relaxed); }
+        static constexpr std::size_t capacity() noexcept { return Events; }
+        
+        // 가장 오래된 것부터 현재 남아 있는 이벤트를 fn(const Event&)로 전달.
+        // 읽는 도중 덮어써진 이벤트는 kind = NONE으로 전달 (개수 유지). 반환: 전달 수
+        template<typename Fn>
+        std::size_t for_each(Fn&& fn) const noexcept {
+            const uint32_t head = head_.load(std::memory_order_acquire);
+            const uint32_t first = head > Events ? head - static_cast<uint32_t>(Events) : 0;
+            for (uint32_t sequence = first; sequence != head; ++sequence) {
+                fn(read(sequence));
+            }
+            return head - first;
+        }
+        
+        // 바이너리 덤프: write(const void* data, std::size_t size) - UART/SWO/파일
+        template<typename Write>
+        std::size_t dump(uint16_t core, Write&& write) const noexcept {
+            const uint32_t head = head_.load(std::memory_order_acquire);
+            const uint32_t first = head > Events ? head - static_cast<uint32_t>(Events) : 0;
+            const DumpHeader header{DUMP_MAGIC, DUMP_VERSION, core, head - first, hires_frequency_hz()};
+            write(static_cast<const void*>(&header), sizeof(header));
+            for (uint32_t sequence = first; sequence != head; ++sequence) {
+                const Event event = read(sequence);
+                write(static_cast<const void*>(&event), sizeof(event));
+            }
+            return head - first;
+        }
+        
+        void reset() noexcept {
+            for (auto& slot : slots_) {
+                slot.sequence.store(0, std::memory_order_relaxed);
+            }
+            head_.store(0, std::memory_order_release);
+        }
+        
+    private:
+        struct Slot {
+            std::atomic<uint32_t> timestamp{0};
+            std::atomic<uint32_t> info{0};
+            std::atomic<uint32_t> agents{0};
+            std::atomic<uint32_t> sequence{0};
+        };
+        
+        Event read(uint32_t sequence) const noexcept {
+            const Slot& slot = slots_[sequence & (Events - 1)];
+            Event event{};
+            if (slot.sequence.load(std::memory_order_acquire) == sequence + 1) {
+                event.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+                event.info = slot.info.load(std::memory_order_relaxed);
+                event.agents = slot.agents.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == sequence + 1) {
+                    event.sequence = sequence + 1;
+                    return event;
+                }
+            }
+            return Event{};  // 덮어써짐
+        }
+        
+        alignas(64) std::atomic<uint32_t> head_{0};
+        std::array<Slot, Events> slots_;
+    };
     
-    // Zero-overhead 접근자 (inline)
-    constexpr MessageId type_id() const noexcept { return header.type_id; }
-    constexpr AgentId sender_id() const noexcept { return header.sender_id; }
-    constexpr TimePoint timestamp() const noexcept { return header.timestamp; }
+    using TraceRing = Ring<MINI_SO_TRACE_EVENTS>;
     
-    void mark_sent() noexcept { header.set_timestamp(); }
-};
-
-// Phase 3: 컴파일 타임 메시지 타입 ID 생성 (충돌 방지)
-namespace detail {
-    // constexpr 문자열 해시 함수 (FNV-1a 기반)
-    constexpr uint32_t fnv1a_hash(const char* str, std::size_t len) noexcept {
-        uint32_t hash = 2166136261u;  // FNV offset basis
-        for (std::size_t i = 0; i < len; ++i) {
-            hash ^= static_cast<uint32_t>(str[i]);
-            hash *= 16777619u;  // FNV prime
-        }
-        return hash;
+#if MINI_SO_ENABLE_TRACE
+    // 현재 코어 번호 (ring 선택)
+    inline std::size_t current_core() noexcept {
+#if defined(UNIT_TEST) || MINI_SO_TRACE_CORES == 1
+        return 0;
+#elif defined(ESP_PLATFORM)
+        return static_cast<std::size_t>(xPortGetCoreID());
+#else
+        return static_cast<std::size_t>(portGET_CORE_ID());
+#endif
     }
     
-    // 컴파일 타임 문자열 길이 계산
-    constexpr std::size_t const_strlen(const char* str) noexcept {
-        std::size_t len = 0;
-        while (str[len] != '\0') {
-            ++len;
+    inline std::array<TraceRing, MINI_SO_TRACE_CORES>& rings() noexcept {
+        static std::array<TraceRing, MINI_SO_TRACE_CORES> instance MINI_SO_TRACE_PLACEMENT;
+        return instance;
+    }
+    
+    inline TraceRing& ring(std::size_t core) noexcept { return rings()[core < MINI_SO_TRACE_CORES ? core : 0]; }
+    constexpr std::size_t core_count() noexcept { return MINI_SO_TRACE_CORES; }
+    
+    inline void record(EventKind kind, MessageId type_id, AgentId sender, AgentId target, std::size_t depth) noexcept {
+        rings()[current_core()].record(kind, type_id, sender, target, depth);
+    }
+    
+    // 모든 코어 ring을 차례로 덤프 - 반환: 전달한 이벤트 수
+    template<typename Write>
+    std::size_t dump_all(Write&& write) noexcept {
+        std::size_t total = 0;
+        for (std::size_t core = 0; core < MINI_SO_TRACE_CORES; ++core) {
+            total += rings()[core].dump(static_cast<uint16_t>(core), write);
         }
-        return len;
+        return total;
     }
     
-    template<typename T>
-    struct MessageTypeRegistry {
-        static constexpr MessageId id() noexcept {
-            // 타입명 기반 고유 ID 생성 (__PRETTY_FUNCTION__ 사용)
-            constexpr const char* type_name = __PRETTY_FUNCTION__;
-            constexpr std::size_t name_len = const_strlen(type_name);
-            constexpr uint32_t hash = fnv1a_hash(type_name, name_len);
-            
-            // 추가 엔트로피: 타입 크기와 특성 조합
-            constexpr uint32_t size_factor = static_cast<uint32_t>(sizeof(T));
-            constexpr uint32_t trait_factor = std::is_trivially_copyable_v<T> ? 1u : 0u;
-            constexpr uint32_t alignment_factor = static_cast<uint32_t>(alignof(T));
-            
+    inline void reset() noexcept {
+        for (auto& ring : rings()) ring.reset();
+    }
+#else
+    inline void record(EventKind, MessageId, AgentId, AgentId, std::size_t) noexcept {}
+#endif
+}
+
+// ============================================================================
+// Observer - 디스패치 이벤트 컴파일 타임 훅
+// ============================================================================
+// MINI_SO_OBSERVER 타입의 정적 noexcept 함수를 trace 기록 지점에서 직접 호출 (가상 호출/함수 포인터 없음).
+// 프로파일러나 SystemView/Tracealyzer 어댑터는 NullObserver를 상속해 필요한 훅만 가림.
+// 훅은 송신 태스크/ISR drain/워커 문맥에서 불리므로 짧고 블록하지 않아야 함.
+struct NullObserver {
+    // 메일박스 push 성공. target = 수신 Agent 슬롯 인덱스 (미연결 큐는 INVALID_AGENT_ID), depth = push 후 대기 수
+    static void on_send(MessageId, AgentId /*sender*/, AgentId /*target*/, std::size_t /*depth*/) noexcept {}
+    // push 실패 (가득 참/너무 큼) - 과부하 정책으로 재시도되는 push도 매번 호출
+    static void on_enqueue_fail(MessageId, AgentId /*sender*/, AgentId /*target*/, std::size_t /*depth*/) noexcept {}
+    // 핸들러 호출 직전/직후. depth = 남은 대기 수
+    static void on_dispatch_begin(MessageId, AgentId /*sender*/, AgentId /*agent*/, std::size_t /*depth*/) noexcept {}
+    static void on_dispatch_end(MessageId, AgentId /*agent*/, bool /*handled*/) noexcept {}
+    // 처리할 일이 없어 최대 ticks 동안 블록하기 직전 (run_until_idle, wait_for_messages, 디스패처 워커)
+    static void on_idle(TickType_t /*ticks*/) noexcept {}
+};
+
+} // namespace mini_so
+
+#ifdef MINI_SO_OBSERVER_HEADER
+#include MINI_SO_OBSERVER_HEADER
+#endif
+
+namespace mini_so {
+
+using Observer = MINI_SO_OBSERVER;
+
+// ============================================================================
+// Message System - Phase 3: Zero-overhead 메시지 시스템
+// ============================================================================
+
+#if MINI_SO_COMPACT_HEADER
+// 압축 헤더 (4바이트, MINI_SO_HEADER_TIMESTAMP면 8바이트) - 발신자는 8비트 AgentId (0xFF = INVALID_AGENT_ID)
+struct alignas(4) MessageHeader {
+    MessageId type_id;
+    uint8_t compact_sender;
+    uint8_t reserved;
+#if MINI_SO_HEADER_TIMESTAMP
+    uint32_t timestamp;  // 전송 시각 (hires_now() 원시값, 큐 대기 시간 측정용)
+#endif
+    
+    constexpr MessageHeader(MessageId id = INVALID_MESSAGE_ID, AgentId sender = INVALID_AGENT_ID) noexcept
+        : type_id(id), compact_sender(pack_sender(sender)), reserved(0)
+#if MINI_SO_HEADER_TIMESTAMP
+        , timestamp(0)
+#endif
+    {}
+    
+    constexpr AgentId sender() const noexcept {
+        return compact_sender == detail::AGENT_ID_ALL_ONES ? INVALID_AGENT_ID : compact_sender;
+    }
+    void set_sender(AgentId sender) noexcept { compact_sender = pack_sender(sender); }
+    
+#if MINI_SO_HEADER_TIMESTAMP
+    constexpr HiresTime sent_at() const noexcept { return timestamp; }
+    void set_sent_at(HiresTime time) noexcept { timestamp = time; }
+    void set_timestamp() noexcept { timestamp = hires_now(); }
+#else
+    constexpr HiresTime sent_at() const noexcept { return 0; }  // 0 = 전송 시각 없음
+    void set_sent_at(HiresTime) noexcept {}
+    void set_timestamp() noexcept {}
+#endif
+    
+private:
+    // 8비트에 들어가지 않는 ID(원격 프록시 등)는 INVALID로
+    static constexpr uint8_t pack_sender(AgentId sender) noexcept {
+        return sender < detail::AGENT_ID_ALL_ONES ? static_cast<uint8_t>(sender)
+                                                  : static_cast<uint8_t>(detail::AGENT_ID_ALL_ONES);
+    }
+};
+
+namespace detail {
+    inline constexpr std::size_t MAILBOX_RECORD_ALIGN = sizeof(void*) > 4 ? 8 : 4;  // 핸들 레코드의 포인터 정렬
+}
+#else
+// Phase 3: 최적화된 메시지 헤더 (8바이트로 최소화)
+struct alignas(8) MessageHeader {
+    MessageId type_id;
+    AgentId sender_id;
+    uint32_t timestamp;  // 전송 시각 (hires_now() 원시값, 큐 대기 시간 측정용)
+    
+    constexpr MessageHeader(MessageId id = INVALID_MESSAGE_ID, AgentId sender = INVALID_AGENT_ID) noexcept
+        : type_id(id), sender_id(sender), timestamp(0) {}
+    
+    constexpr AgentId sender() const noexcept { return sender_id; }
+    void set_sender(AgentId sender) noexcept { sender_id = sender; }
+    constexpr HiresTime sent_at() const noexcept { return timestamp; }
+    void set_sent_at(HiresTime time) noexcept { timestamp = time; }
+    void set_timestamp() noexcept { timestamp = hires_now(); }
+};
+
+namespace detail {
+    inline constexpr std::size_t MAILBOX_RECORD_ALIGN = 8;
+}
+#endif
+
+// Phase 3: Zero-overhead 메시지 기본 클래스
+class MessageBase {
+public:
+    MessageHeader header;
+    
+    constexpr MessageBase(MessageId id, AgentId sender = INVALID_AGENT_ID) noexcept
+        : header(id, sender) {}
+    
+    // virtual ~MessageBase() = default;  // 제거: memcpy 안전성을 위해
+    
+    // Zero-overhead 접근자 (inline)
+    constexpr MessageId type_id() const noexcept { return header.type_id; }
+    constexpr AgentId sender_id() const noexcept { return header.sender(); }
+    constexpr HiresTime timestamp() const noexcept { return header.sent_at(); }
+    
+    void mark_sent() noexcept { header.set_timestamp(); }
+};
+
+// Phase 3: 컴파일 타임 메시지 타입 ID 생성 (충돌 방지)
+namespace detail {
+    // constexpr 문자열 해시 함수 (FNV-1a 기반)
+    constexpr uint32_t fnv1a_hash(const char* str, std::size_t len) noexcept {
+        uint32_t hash = 2166136261u;  // FNV offset basis
+        for (std::size_t i = 0; i < len; ++i) {
+            hash ^= static_cast<uint32_t>(str[i]);
+            hash *= 16777619u;  // FNV prime
+        }
+        return hash;
+    }
+    
+    // 컴파일 타임 문자열 길이 계산
+    constexpr std::size_t const_strlen(const char* str) noexcept {
+        std::size_t len = 0;
+        while (str[len] != '\0') {
+            ++len;
+        }
+        return len;
+    }
+    
+    template<typename T>
+    struct MessageTypeRegistry {
+        static constexpr MessageId id() noexcept {
+            // 타입명 기반 고유 ID 생성 (__PRETTY_FUNCTION__ 사용)
+            constexpr const char* type_name = __PRETTY_FUNCTION__;
+            constexpr std::size_t name_len = const_strlen(type_name);
+            constexpr uint32_t hash = fnv1a_hash(type_name, name_len);
+            
+            // 추가 엔트로피: 타입 크기와 특성 조합
+            constexpr uint32_t size_factor = static_cast<uint32_t>(sizeof(T));
+            constexpr uint32_t trait_factor = std::is_trivially_copyable_v<T> ? 1u : 0u;
+            constexpr uint32_t alignment_factor = static_cast<uint32_t>(alignof(T));
+            
             // 개선된 해시 조합 (더 나은 엔트로피 분산)
             constexpr uint32_t hash1 = hash ^ (size_factor * 0x9E3779B9u);
             constexpr uint32_t hash2 = hash1 ^ (trait_factor * 0x85EBCA6Bu);
@@ -232,93 +971,102 @@ namespace detail {
         }
     };
     
-    // 런타임 충돌 검증을 위한 ID 레지스트리
+    // Ts 안에서 T의 개수
+    template<typename T, typename... Ts>
+    constexpr std::size_t type_count() noexcept {
+        return (std::size_t{0} + ... + (std::is_same_v<T, Ts> ? 1 : 0));
+    }
+    
+    // Flags[i]가 처음 참인 위치 (없으면 sizeof...)
+    template<bool... Flags>
+    constexpr std::size_t first_true() noexcept {
+        constexpr bool flags[] = {Flags..., false};
+        std::size_t index = 0;
+        while (index < sizeof...(Flags) && !flags[index]) {
+            ++index;
+        }
+        return index;
+    }
+    
+    // 런타임 충돌 검증을 위한 ID 레지스트리 (MessageSchema를 쓸 수 없는 동적 구성용).
+    // ID를 정렬 상태로 유지해 등록 시 이진 탐색, 충돌은 등록 시점에 기록 (사후 O(n²) 비교 없음).
     class TypeIdRegistry {
     private:
         static constexpr std::size_t MAX_REGISTERED_TYPES = 256;
+        static constexpr std::size_t MAX_RECORDED_COLLISIONS = 32;
         
-        struct TypeInfo {
-            MessageId id;
-            const char* type_name;
-            std::size_t type_size;
-            bool valid;
-            
-            constexpr TypeInfo() noexcept : id(0), type_name(nullptr), type_size(0), valid(false) {}
-            constexpr TypeInfo(MessageId id_, const char* name, std::size_t size) noexcept 
-                : id(id_), type_name(name), type_size(size), valid(true) {}
+        struct State {
+            MessageId ids[MAX_REGISTERED_TYPES];
+            MessageId collisions[MAX_RECORDED_COLLISIONS];
+            std::size_t count;
+            std::size_t collision_count;
         };
         
-        static TypeInfo* get_registered_types() noexcept {
-            static TypeInfo registered_types[MAX_REGISTERED_TYPES] = {};
-            return registered_types;
+        static State& state() noexcept {
+            static State registry = {};
+            return registry;
         }
         
-        static std::size_t& get_registered_count() noexcept {
-            static std::size_t registered_count = 0;
-            return registered_count;
+        // id 이상인 첫 위치
+        static std::size_t lower_bound(const State& registry, MessageId id) noexcept {
+            std::size_t low = 0;
+            std::size_t high = registry.count;
+            while (low < high) {
+                const std::size_t mid = (low + high) / 2;
+                if (registry.ids[mid] < id) {
+                    low = mid + 1;
+                } else {
+                    high = mid;
+                }
+            }
+            return low;
         }
         
     public:
-        // 타입 등록 (런타임)
+        // 타입 등록 (런타임) - 충돌 또는 공간 부족 시 false
         template<typename T>
         static bool register_type() noexcept {
-            std::size_t& count = get_registered_count();
-            TypeInfo* types = get_registered_types();
-            
-            if (count >= MAX_REGISTERED_TYPES) {
-                return false; // 등록 공간 부족
-            }
-            
-            MessageId new_id = MessageTypeRegistry<T>::id();
-            const char* type_name = __PRETTY_FUNCTION__; // 근사치
-            
-            // 기존 등록된 타입들과 충돌 검사
-            for (std::size_t i = 0; i < count; ++i) {
-                if (types[i].valid && types[i].id == new_id) {
-                    // 충돌 발견!
-                    return false;
+            return register_id(MessageTypeRegistry<T>::id());
+        }
+        
+        static bool register_id(MessageId id) noexcept {
+            State& registry = state();
+            const std::size_t position = lower_bound(registry, id);
+            if (position < registry.count && registry.ids[position] == id) [[unlikely]] {
+                if (registry.collision_count < MAX_RECORDED_COLLISIONS) {
+                    registry.collisions[registry.collision_count++] = id;
                 }
+                return false;
+            }
+            if (registry.count >= MAX_REGISTERED_TYPES) [[unlikely]] {
+                return false; // 등록 공간 부족
             }
             
-            // 충돌 없음 - 등록
-            types[count] = TypeInfo(new_id, type_name, sizeof(T));
-            ++count;
+            std::memmove(&registry.ids[position + 1], &registry.ids[position],
+                         (registry.count - position) * sizeof(MessageId));
+            registry.ids[position] = id;
+            ++registry.count;
             return true;
         }
         
-        // 충돌 발생한 타입들 조회
+        // 충돌 발생한 ID 조회 (등록 시 기록된 값)
         static std::size_t find_collisions(MessageId* collision_ids, std::size_t max_collisions) noexcept {
-            std::size_t collision_count = 0;
-            std::size_t count = get_registered_count();
-            TypeInfo* types = get_registered_types();
-            
-            for (std::size_t i = 0; i < count && collision_count < max_collisions; ++i) {
-                if (!types[i].valid) continue;
-                
-                for (std::size_t j = i + 1; j < count; ++j) {
-                    if (!types[j].valid) continue;
-                    
-                    if (types[i].id == types[j].id) {
-                        collision_ids[collision_count++] = types[i].id;
-                        break;
-                    }
-                }
+            const State& registry = state();
+            const std::size_t count = registry.collision_count < max_collisions ? registry.collision_count : max_collisions;
+            for (std::size_t i = 0; i < count; ++i) {
+                collision_ids[i] = registry.collisions[i];
             }
-            
-            return collision_count;
+            return count;
         }
         
         // 통계 정보
-        static std::size_t registered_count() noexcept { return get_registered_count(); }
+        static std::size_t registered_count() noexcept { return state().count; }
+        static std::size_t collision_count() noexcept { return state().collision_count; }
         static constexpr std::size_t max_capacity() noexcept { return MAX_REGISTERED_TYPES; }
         
         // 등록 정보 초기화 (테스트용)
         static void reset() noexcept {
-            TypeInfo* types = get_registered_types();
-            for (std::size_t i = 0; i < MAX_REGISTERED_TYPES; ++i) {
-                types[i] = TypeInfo{};
-            }
-            get_registered_count() = 0;
+            state() = State{};
         }
     };
 }
@@ -335,14 +1083,101 @@ namespace detail {
     static_assert(!mini_so::detail::TypeCollisionDetector<__VA_ARGS__>::has_collisions(), \
                   "Message type ID collision detected in type list: " #__VA_ARGS__)
 
-// 런타임 타입 등록 및 충돌 검증 매크로
+// ============================================================================
+// MessageSchema - 단일 타입 목록에서 생성되는 컴파일 타임 메시지 레지스트리
+// ============================================================================
+// 목록 순서로 dense 인덱스 0..N-1을 부여하고, 해시 ID 충돌은 정의 시점에 static_assert로 거부.
+// 헤더의 type_id(해시)는 그대로이며, index_of(type_id)는 정렬된 constexpr 테이블을 이진 탐색하므로
+// 타입별 통계/디스패치 테이블을 Table<V>로 직접 인덱싱할 수 있음.
+//
+//     MINI_SO_MESSAGE_SCHEMA(AppMessages, SensorReading, MotorCommand, Alarm);
+//     AppMessages::Table<uint32_t> received{};
+//     received[AppMessages::index_of(msg.type_id())]++;   // 목록 밖 타입은 INVALID_MESSAGE_ID
+template<typename... Types>
+struct MessageSchema {
+    static constexpr std::size_t size = sizeof...(Types);
+    static_assert(size > 0 && size < INVALID_MESSAGE_ID, "Message schema needs 1..65534 types");
+    static_assert(((detail::type_count<Types, Types...>() == 1) && ...), "Each message type may appear only once");
+    
+    template<typename V>
+    using Table = std::array<V, size>;
+    
+    template<typename T>
+    static constexpr bool contains() noexcept { return detail::type_count<T, Types...>() == 1; }
+    
+    template<typename T>
+    static constexpr MessageId index_of() noexcept {
+        static_assert(contains<T>(), "Type is not part of this message schema");
+        return static_cast<MessageId>(detail::first_true<std::is_same_v<T, Types>...>());
+    }
+    
+    // 런타임 type_id → dense 인덱스, 목록 밖이면 INVALID_MESSAGE_ID
+    static constexpr MessageId index_of(MessageId type_id) noexcept {
+        std::size_t low = 0;
+        std::size_t high = size;
+        while (low < high) {
+            const std::size_t mid = (low + high) / 2;
+            if (sorted_[mid].id < type_id) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low < size && sorted_[low].id == type_id ? sorted_[low].index : INVALID_MESSAGE_ID;
+    }
+    
+    // 정렬 후 인접 비교 (컴파일 타임)
+    static constexpr bool collision_free() noexcept {
+        for (std::size_t i = 1; i < size; ++i) {
+            if (sorted_[i - 1].id == sorted_[i].id) return false;
+        }
+        return true;
+    }
+    
+private:
+    struct Entry {
+        MessageId id;
+        MessageId index;
+    };
+    
+    static constexpr std::array<Entry, size> sort_entries() noexcept {
+        std::array<Entry, size> entries{{Entry{detail::MessageTypeRegistry<Types>::id(), 0}...}};
+        for (std::size_t i = 0; i < size; ++i) {
+            entries[i].index = static_cast<MessageId>(i);
+        }
+        // 삽입 정렬 (타입 수가 적고 컴파일 타임에만 실행)
+        for (std::size_t i = 1; i < size; ++i) {
+            const Entry entry = entries[i];
+            std::size_t j = i;
+            while (j > 0 && entries[j - 1].id > entry.id) {
+                entries[j] = entries[j - 1];
+                --j;
+            }
+            entries[j] = entry;
+        }
+        return entries;
+    }
+    
+    static constexpr std::array<Entry, size> sorted_ = sort_entries();
+};
+
+namespace detail {
+    template<typename Schema>
+    constexpr bool check_message_schema() noexcept {
+        static_assert(Schema::collision_free(), "Message type ID collision detected in message schema");
+        return true;
+    }
+}
+
+// 스키마 정의 + 충돌 검사
+#define MINI_SO_MESSAGE_SCHEMA(Name, ...) \
+    using Name = mini_so::MessageSchema<__VA_ARGS__>; \
+    static_assert(mini_so::detail::check_message_schema<Name>(), "Invalid message schema " #Name)
+
+// 런타임 타입 등록 (충돌은 기록되어 VERIFY_NO_RUNTIME_COLLISIONS가 보고, 시작 시 출력 없음)
 #define REGISTER_MESSAGE_TYPE(T) \
     do { \
-        bool success = mini_so::detail::TypeIdRegistry::register_type<T>(); \
-        if (!success) { \
-            printf("WARNING: Type ID collision or registration failure for type: %s (ID: %u)\n", \
-                   #T, static_cast<unsigned>(MESSAGE_TYPE_ID(T))); \
-        } \
+        (void)mini_so::detail::TypeIdRegistry::register_type<T>(); \
     } while(0)
 
 // 전체 시스템 충돌 검증 매크로  
@@ -421,11 +1256,11 @@ namespace detail {
 #define MINI_SO_SEND_POOLED(target_id, msg_data) send_pooled_message(target_id, msg_data)
 #define MINI_SO_BROADCAST_POOLED(msg_data) broadcast_pooled_message(msg_data)
 
-// 6. 타입 안전성 convenience 매크로
+// 6. 타입 안전성 convenience 매크로 - 타입 목록을 컴파일 타임에 검증 (런타임 등록 없음)
 #define MINI_SO_REGISTER_TYPES(...) \
     do { \
-        (REGISTER_MESSAGE_TYPE(__VA_ARGS__), ...); \
-        VERIFY_NO_RUNTIME_COLLISIONS(); \
+        static_assert(mini_so::MessageSchema<__VA_ARGS__>::collision_free(), \
+                      "Message type ID collision detected in type list: " #__VA_ARGS__); \
     } while(0)
 
 // 7. 디버깅/개발 helper 매크로 (optional)
@@ -445,16 +1280,16 @@ namespace detail {
     mini_so::System::instance().report_error(level, code, id())
 
 #define MINI_SO_HEARTBEAT() \
-    mini_so::System::instance().heartbeat(id())
+    heartbeat()
 
 #define MINI_SO_RECORD_PERFORMANCE(time_us, msg_count) \
-    mini_so::System::instance().record_performance(time_us, msg_count)
+    report_performance(time_us, msg_count)
 
 // 9. 새로운 고급 User-Friendly 매크로들
 // 자신에게 메시지 전송
 #define MINI_SO_SEND_TO_SELF(msg_data) \
     do { \
-        mini_so::Environment& env = mini_so::Environment::instance(); \
+        mini_so::Environment& env = environment(); \
         env.send_message(id(), id(), msg_data); \
     } while(0)
 
@@ -489,20 +1324,165 @@ namespace detail {
 #define MESSAGE_HANDLER_BEGIN() BEGIN_MESSAGE_HANDLER()
 #define MESSAGE_HANDLER_END() END_MESSAGE_HANDLER()
 
+// Message data를 기본 초기화 (대형 버퍼를 생성 시 0으로 채우지 않음)
+struct DefaultInit {};
+
 // Phase 3: Zero-overhead 타입이 지정된 메시지
 template<typename T>
 class Message : public MessageBase {
+#if MINI_SO_COMPACT_HEADER
+    static_assert(alignof(T) <= detail::MAILBOX_RECORD_ALIGN,
+                  "MINI_SO_COMPACT_HEADER: message alignment exceeds the packed mailbox record alignment");
+#endif
+
 public:
     T data;
     
     constexpr Message(const T& msg_data, AgentId sender = INVALID_AGENT_ID) noexcept
         : MessageBase(MESSAGE_TYPE_ID(T), sender), data(msg_data) {}
+    
+    Message(AgentId sender, DefaultInit) noexcept : MessageBase(MESSAGE_TYPE_ID(T), sender) {}
         
+    // 제자리 생성: 생성자가 없는 집합체(aggregate)는 중괄호 초기화
     template<typename... Args>
     constexpr Message(AgentId sender, Args&&... args) noexcept
-        : MessageBase(MESSAGE_TYPE_ID(T), sender), data(std::forward<Args>(args)...) {}
+        : MessageBase(MESSAGE_TYPE_ID(T), sender), data(make_data(std::forward<Args>(args)...)) {}
+
+private:
+    template<typename... Args>
+    static constexpr T make_data(Args&&... args) noexcept {
+        if constexpr (std::is_constructible_v<T, Args&&...>) {
+            return T(std::forward<Args>(args)...);
+        } else {
+            return T{std::forward<Args>(args)...};
+        }
+    }
+};
+
+// ============================================================================
+// Handler Tables - 컴파일 타임 디스패치 테이블
+// ============================================================================
+// HANDLE_MESSAGE if-chain 대신 타입 ID로 정렬된 constexpr 테이블을 이진 탐색 (O(log n)).
+// 사용법:
+//   class MyAgent : public mini_so::Agent {
+//       bool on_reading(const SensorReading& r) noexcept;
+//       void on_command(const Command& c) noexcept;       // void → 처리됨(true)
+//   public:
+//       MINI_SO_HANDLER_TABLE(MyAgent, &MyAgent::on_reading, &MyAgent::on_command)
+//   };
+// 기존 HANDLE_MESSAGE 계열 매크로는 그대로 사용 가능 (dispatch()가 false면 fallback).
+namespace detail {
+    template<typename Fn>
+    struct HandlerTraits;
+    
+    template<typename R, typename C, typename T>
+    struct HandlerTraits<R (C::*)(const T&)> {
+        using agent_type = C;
+        using message_type = T;
+    };
+    
+    template<typename R, typename C, typename T>
+    struct HandlerTraits<R (C::*)(const T&) noexcept> : HandlerTraits<R (C::*)(const T&)> {};
+    
+    template<typename R, typename C, typename T>
+    struct HandlerTraits<R (C::*)(const T&) const> : HandlerTraits<R (C::*)(const T&)> {};
+    
+    template<typename R, typename C, typename T>
+    struct HandlerTraits<R (C::*)(const T&) const noexcept> : HandlerTraits<R (C::*)(const T&)> {};
+    
+    template<typename AgentT>
+    struct HandlerEntry {
+        MessageId id;
+        bool (*invoke)(AgentT& agent, const MessageBase& msg) noexcept;
+    };
+    
+    // C++17 constexpr 삽입 정렬 (테이블 크기가 작으므로 충분)
+    template<typename Entry, std::size_t N>
+    constexpr std::array<Entry, N> sort_by_id(std::array<Entry, N> entries) noexcept {
+        for (std::size_t i = 1; i < N; ++i) {
+            for (std::size_t j = i; j > 0 && entries[j].id < entries[j - 1].id; --j) {
+                Entry tmp = entries[j];
+                entries[j] = entries[j - 1];
+                entries[j - 1] = tmp;
+            }
+        }
+        return entries;
+    }
+    
+    template<typename Entry, std::size_t N>
+    constexpr bool has_duplicate_ids(const std::array<Entry, N>& sorted) noexcept {
+        for (std::size_t i = 1; i < N; ++i) {
+            if (sorted[i].id == sorted[i - 1].id) return true;
+        }
+        return false;
+    }
+}
+
+template<typename AgentT, auto... HandlerFns>
+class Handlers {
+    static_assert(sizeof...(HandlerFns) > 0, "Handler table must contain at least one handler");
+    static_assert((std::is_base_of_v<typename detail::HandlerTraits<decltype(HandlerFns)>::agent_type, AgentT> && ...),
+                  "Handlers must be member functions of the agent (or its bases)");
+    
+    using Entry = detail::HandlerEntry<AgentT>;
+    static constexpr std::size_t N = sizeof...(HandlerFns);
+    
+    template<auto Fn>
+    static bool invoke(AgentT& agent, const MessageBase& msg) noexcept {
+        using T = typename detail::HandlerTraits<decltype(Fn)>::message_type;
+        const auto& typed_msg = static_cast<const Message<T>&>(msg);
+        if constexpr (std::is_void_v<decltype((agent.*Fn)(typed_msg.data))>) {
+            (agent.*Fn)(typed_msg.data);
+            return true;
+        } else {
+            return static_cast<bool>((agent.*Fn)(typed_msg.data));
+        }
+    }
+    
+    static constexpr std::array<Entry, N> table_ = detail::sort_by_id(std::array<Entry, N>{{
+        Entry{MESSAGE_TYPE_ID(typename detail::HandlerTraits<decltype(HandlerFns)>::message_type),
+              &invoke<HandlerFns>}...
+    }});
+    
+    static_assert(!detail::has_duplicate_ids(table_),
+                  "Duplicate message type (or type ID collision) in handler table");
+    
+public:
+    static constexpr std::size_t size() noexcept { return N; }
+    
+    // 정렬된 ID 배열에서 lower_bound 탐색
+    static bool dispatch(AgentT& agent, const MessageBase& msg) noexcept {
+        const MessageId id = msg.type_id();
+        std::size_t lo = 0;
+        std::size_t len = N;
+        while (len > 1) {
+            std::size_t half = len / 2;
+            lo = table_[lo + half - 1].id < id ? lo + half : lo;
+            len -= half;
+        }
+        if (table_[lo].id == id) [[likely]] {
+            return table_[lo].invoke(agent, msg);
+        }
+        return false;
+    }
+    
+    static constexpr bool handles(MessageId id) noexcept {
+        for (const auto& entry : table_) {
+            if (entry.id == id) return true;
+        }
+        return false;
+    }
 };
 
+// handle_message override를 핸들러 테이블로 정의
+#define MINI_SO_HANDLER_TABLE(ClassName, ...) \
+    using MiniSoHandlerTable = mini_so::Handlers<ClassName, __VA_ARGS__>; \
+    bool handle_message(const mini_so::MessageBase& msg) noexcept override { \
+        return MiniSoHandlerTable::dispatch(*this, msg); \
+    }
+
+#define HANDLER_TABLE(ClassName, ...) MINI_SO_HANDLER_TABLE(ClassName, __VA_ARGS__)
+
 // ============================================================================
 // System Messages - Phase 3: 완전한 메시지 기반 시스템
 // ============================================================================
@@ -540,6 +1520,12 @@ namespace system_messages {
         uint32_t message_count;
         uint32_t uptime_ms;
         uint8_t health_level;  // 0=healthy, 1=warning, 2=critical
+        
+        // 메일박스 포화 요약 (Environment::fill_mailbox_status)
+        uint8_t fullest_percent = 0;               // 가장 높은 high-water 바이트 점유율 (%)
+        AgentId fullest_agent = INVALID_AGENT_ID;  // 그 메일박스의 Agent
+        uint32_t push_failures = 0;                // 모든 메일박스의 push 실패 합
+        uint32_t saturated_us = 0;                 // 모든 메일박스의 포화 시간 합
     };
     
     // 시스템 명령 - 일반화된 명령 구조
@@ -549,7 +1535,8 @@ namespace system_messages {
             RESET = 1, 
             SUSPEND = 2, 
             RESUME = 3,
-            COLLECT_GARBAGE = 4
+            COLLECT_GARBAGE = 4,
+            EMERGENCY_STOP = 5     // 액추에이터 즉시 정지 (MessagePriority: CRITICAL)
         };
         Type command;
         AgentId target_agent;  // INVALID_AGENT_ID면 전체 시스템
@@ -560,919 +1547,6648 @@ namespace system_messages {
 // ============================================================================
 // Message Queue - Phase 3: Zero-overhead 큐
 // ============================================================================
-class MessageQueue {
-public:
-    enum class Result : uint8_t {
-        SUCCESS = 0,
-        QUEUE_FULL = 1,
-        MESSAGE_TOO_LARGE = 2,
-        INVALID_MESSAGE = 3
-    };
-    
-private:
-    // Phase 3: 캐시 라인 최적화된 엔트리 (Zero-overhead 동시성)
-    struct alignas(64) QueueEntry {  // CPU 캐시 라인 크기에 맞춤
-        alignas(8) uint8_t data[MINI_SO_MAX_MESSAGE_SIZE];
-        uint16_t size;
-        bool valid;  // FreeRTOS 뮤텍스 보호하에 안전, volatile 불필요
-        uint8_t padding[45];  // 64바이트 정렬 패딩
-    };
-    
-    // Zero-overhead: volatile 제거로 컴파일러 최적화 활성화
-    alignas(64) std::array<QueueEntry, MINI_SO_MAX_QUEUE_SIZE> queue_;
-    alignas(64) std::size_t head_{0};    // FreeRTOS 뮤텍스로 동기화
-    alignas(64) std::size_t tail_{0};    // FreeRTOS 뮤텍스로 동기화
-    alignas(64) std::size_t count_{0};   // FreeRTOS 뮤텍스로 동기화
-    SemaphoreHandle_t mutex_;
-    
-public:
-    MessageQueue() noexcept;
-    ~MessageQueue() noexcept;
-    
-    Result push(const MessageBase& msg, uint16_t size) noexcept;
-    bool pop(uint8_t* buffer, uint16_t& size) noexcept;
-    
-    bool empty() const noexcept { return count_ == 0; }
-    bool full() const noexcept { return count_ >= MINI_SO_MAX_QUEUE_SIZE; }
-    std::size_t size() const noexcept { return count_; }
-    void clear() noexcept;
+
+// 큐 동기화 정책
+// - MUTEX: FreeRTOS 뮤텍스 보호 (기존 동작, 비교/디버깅용)
+// - SPSC:  단일 생산자/단일 소비자 lock-free (atomic head/tail)
+// - MPSC:  다중 생산자/단일 소비자 lock-free (슬롯별 sequence, Vyukov 방식)
+enum class QueuePolicy : uint8_t {
+    MUTEX = MINI_SO_QUEUE_MUTEX,
+    SPSC = MINI_SO_QUEUE_SPSC,
+    MPSC = MINI_SO_QUEUE_MPSC
 };
 
-// ============================================================================
-// Agent - Phase 3: Zero-overhead Agent 시스템
-// ============================================================================
-class Agent {
-protected:
-    AgentId id_ = INVALID_AGENT_ID;
-    
-public:
-    MessageQueue message_queue_;
-    
-    Agent() = default;
-    virtual ~Agent() = default;
-    
-    // Phase 3: 순수 가상 함수 - 성능 최적화
-    virtual bool handle_message(const MessageBase& msg) noexcept = 0;
-    
-    // Agent 생명주기 - noexcept 보장
-    void initialize(AgentId id) noexcept { id_ = id; }
-    void process_messages() noexcept;
-    
-    // Phase 3: Zero-overhead 메시지 전송
-    template<typename T>
-    void send_message(AgentId target_id, const T& message) noexcept;
-    
-    template<typename T>
-    void broadcast_message(const T& message) noexcept;
-    
-    // Phase 2.2: 풀링된 메시지 전송 (Agent 편의 메서드)
-    template<typename T>
-    void send_pooled_message(AgentId target_id, const T& message) noexcept;
-    
-    template<typename T>
-    void broadcast_pooled_message(const T& message) noexcept;
-    
-    // Phase 3: inline 접근자 (noexcept 보장)
-    bool has_messages() const noexcept { return !message_queue_.empty(); }
-    constexpr AgentId id() const noexcept { return id_; }
+enum class QueueResult : uint8_t {
+    SUCCESS = 0,
+    QUEUE_FULL = 1,
+    MESSAGE_TOO_LARGE = 2,
+    INVALID_MESSAGE = 3
+};
+
+// try_send/send_for 결과 (성공 외의 값은 메시지가 전달되지 않았음)
+enum class SendResult : uint8_t {
+    SENT = 0,
+    QUEUE_FULL = 1,          // 메일박스가 가득 참 (send_for는 timeout까지 공간이 생기지 않음)
+    MESSAGE_TOO_LARGE = 2,   // 레코드가 대상 메일박스 용량보다 큼
+    NO_SUCH_AGENT = 3,       // 대상이 등록되어 있지 않음
+    FILTERED = 4,            // 대상의 수신 필터가 거부
+    BUSY = 5,                // MUTEX 메일박스 잠금을 한도 안에 얻지 못함
+    THROTTLED = 6            // 토큰 버킷 한도 초과로 버림 (RateLimit)
+};
+
+// send_with_deadline 메시지가 기한을 넘겨 디스패치될 때의 처리 (모두 Agent::deadline_misses에 집계)
+enum class DeadlineMiss : uint8_t {
+    DELIVER = 0,   // 늦게라도 핸들러에 전달
+    DROP = 1,      // 버림
+    ESCALATE = 2   // 버리고 ErrorAgent에 WARNING 보고 (코드 1002 DEADLINE_MISSED)
+};
+
+// 스케줄링 우선순위 클래스 (값이 작을수록 먼저 처리)
+// 스케줄러는 항상 상위 클래스를 비운 뒤 하위 클래스로 내려가고, 하위 클래스는
+// MINI_SO_PRIORITY_QUANTUM 방문마다 상위 클래스를 다시 확인함
+enum class Priority : uint8_t {
+    CRITICAL = 0,   // 비상 정지, 액추에이터 안전 경로
+    HIGH = 1,
+    NORMAL = 2,     // 기본값
+    LOW = 3         // 로깅, 진단
+};
+
+constexpr std::size_t PRIORITY_LEVELS = 4;
+
+// 메시지 타입별 우선순위: 대상 Agent보다 높으면 해당 방문만 상위 클래스로 승격
+// 기본값 LOW = 승격 없음 (Agent 자신의 클래스를 따름)
+template<typename T>
+struct MessagePriority {
+    static constexpr Priority value = Priority::LOW;
+};
+
+template<>
+struct MessagePriority<system_messages::SystemCommand> {
+    static constexpr Priority value = Priority::CRITICAL;
+};
+
+// 사용자 메시지 우선순위 지정 (전역 네임스페이스에서 사용)
+#define MINI_SO_MESSAGE_PRIORITY(Type, Level) \
+    template<> struct mini_so::MessagePriority<Type> { \
+        static constexpr mini_so::Priority value = mini_so::Priority::Level; \
+    }
+
+// 메일박스가 가득 찼을 때의 반응 - Agent별 set_overload_policy(), 타입별 MessageOverload<T>
+enum class OverloadPolicy : uint8_t {
+    DEFAULT = 0,      // 타입 트레이트용: 대상 Agent의 정책을 따름
+    DROP_NEWEST = 1,  // 새 메시지를 버림 (Agent 기본값)
+    DROP_OLDEST = 2,  // 가장 오래된 메시지를 버리고 새 메시지를 넣음
+    KEEP_LATEST = 3,  // 대기 중인 같은 타입 메시지 값을 교체 (없으면 DROP_OLDEST)
+    BLOCK = 4,        // 공간이 생기거나 overload timeout까지 발신 태스크 대기
+    REDIRECT = 5      // overflow 대상 Agent로 전달 (한 단계만)
+};
+
+// 메시지 타입별 과부하 정책 (DEFAULT가 아니면 Agent 정책보다 우선)
+template<typename T>
+struct MessageOverload {
+    static constexpr OverloadPolicy value = OverloadPolicy::DEFAULT;
+};
+
+// 사용자 메시지 과부하 정책 지정 (전역 네임스페이스에서 사용)
+#define MINI_SO_MESSAGE_OVERLOAD(Type, Policy) \
+    template<> struct mini_so::MessageOverload<Type> { \
+        static constexpr mini_so::OverloadPolicy value = mini_so::OverloadPolicy::Policy; \
+    }
+
+// Router 분배 방식
+enum class RoutePolicy : uint8_t {
+    ROUND_ROBIN = 0,   // worker를 차례로
+    LEAST_DEPTH = 1,   // 대기 메시지가 가장 적은 worker (같으면 차례로)
+    KEY_HASH = 2       // MessageRouteKey<T> 키(없으면 발신자 ID)의 해시 - 같은 키는 같은 worker로 (키별 순서 보존)
+};
+
+// KEY_HASH Router의 메시지 타입별 분배 키
+template<typename T>
+struct MessageRouteKey {
+    static constexpr bool defined = false;
+};
+
+// 사용자 메시지 분배 키 지정 (전역 네임스페이스에서 사용) - member는 정수로 변환 가능한 필드
+#define MINI_SO_MESSAGE_ROUTE_KEY(Type, member) \
+    template<> struct mini_so::MessageRouteKey<Type> { \
+        static constexpr bool defined = true; \
+        static uint32_t key(const Type& message) noexcept { return static_cast<uint32_t>(message.member); } \
+    }
+
+// 메시지 타입별 풀링 슬롯 수 (send_pooled_message). 0이면 전용 풀 대신 공유 size-class arena 사용 -
+// 드물게 쓰는 타입들이 슬롯을 따로 잡지 않고 메모리를 나눠 씀
+template<typename T>
+struct MessagePoolSize {
+    static constexpr std::size_t value = MINI_SO_MESSAGE_POOL_SIZE;
+};
+
+// 사용자 메시지 풀 크기 지정 (전역 네임스페이스에서 사용)
+#define MINI_SO_MESSAGE_POOL(Type, Slots) \
+    template<> struct mini_so::MessagePoolSize<Type> { \
+        static constexpr std::size_t value = Slots; \
+    }
+
+// UniqueBuffer<T> 블록 수 (동시에 파이프라인 안에 있을 수 있는 버퍼 수)
+template<typename T>
+struct BufferPoolSize {
+    static constexpr std::size_t value = MINI_SO_BUFFER_POOL_SIZE;
+};
+
+// 사용자 버퍼 풀 크기 지정 (전역 네임스페이스에서 사용)
+#define MINI_SO_BUFFER_POOL(Type, Blocks) \
+    template<> struct mini_so::BufferPoolSize<Type> { \
+        static constexpr std::size_t value = Blocks; \
+    }
+
+// 최신 값만 의미 있는 타입 (고속 센서 토픽 등): 수신 Agent마다 타입별 cell 하나에 최신 값을 두고
+// 메일박스에는 대기 표지 하나만 둠. 소비 전에 도착한 값은 대기 값을 덮어쓰고, 핸들러는 가장 최근 값만 받음
+template<typename T>
+struct MessageCoalesce {
+    static constexpr bool value = false;
+};
+
+// 사용자 메시지 최신 값 전달 지정 (전역 네임스페이스에서 사용)
+#define MINI_SO_MESSAGE_COALESCE(Type) \
+    template<> struct mini_so::MessageCoalesce<Type> { \
+        static constexpr bool value = true; \
+    }
+
+// 과부하 반응 카운터 스냅샷
+struct OverloadStats {
+    uint32_t dropped;      // 결국 전달되지 못한 메시지
+    uint32_t evicted;      // DROP_OLDEST/KEEP_LATEST로 밀려난 대기 메시지
+    uint32_t coalesced;    // KEEP_LATEST 또는 MessageCoalesce로 대기 메시지 값을 교체한 횟수
+    uint32_t blocked;      // BLOCK으로 대기 후 전달된 메시지
+    uint32_t timed_out;    // BLOCK 대기 timeout (dropped에도 포함)
+    uint32_t redirected;   // overflow 대상으로 전달된 메시지
+    uint32_t throttled;    // 토큰 버킷 한도로 메일박스 전에 버려진 메시지 (COALESCE 성공은 coalesced)
+};
+
+// 토큰 버킷 한도 초과 메시지 처리
+enum class Throttle : uint8_t {
+    SHED = 0,      // 버림
+    COALESCE = 1   // 대상 메일박스에 대기 중인 같은 타입/크기의 가장 최근 메시지를 새 값으로 교체 (없으면 버림)
+};
+
+// 토큰 버킷: 초당 rate_per_s개씩 채워지고 최대 burst개까지 모임 (메시지 하나 = 토큰 하나)
+struct RateLimit {
+    uint32_t rate_per_s;
+    uint32_t burst;
+    Throttle action = Throttle::SHED;
+};
+
+// 한도 하나의 판정 카운터
+struct ThrottleStats {
+    uint32_t passed;
+    uint32_t shed;
+    uint32_t coalesced;
+};
+
+// 메일박스 점유 텔레메트리 스냅샷 (MINI_SO_MAILBOX_STATS=0이면 capacity_bytes 외 0)
+// 포화 = 바이트 점유율이 MINI_SO_MAILBOX_SATURATION_PERCENT 이상인 구간 (push 시 진입, 소비 시 이탈)
+struct MailboxStats {
+    uint32_t high_water;        // 최대 동시 대기 메시지 수
+    uint32_t high_water_bytes;  // 최대 점유 바이트 (레코드 헤더/정렬/wrap padding 포함)
+    uint32_t capacity_bytes;
+    uint32_t full;              // push 실패: QUEUE_FULL
+    uint32_t too_large;         // push 실패: MESSAGE_TOO_LARGE
+    uint32_t invalid;           // push 실패: INVALID_MESSAGE
+    uint32_t saturations;       // 포화 진입 횟수
+    uint32_t saturated_us;      // 포화 상태로 지낸 시간 합 (진행 중인 구간 포함)
     
-    // Phase 3: 성능 메트릭 자동 보고
-    void report_performance(uint32_t processing_time_us, uint32_t message_count = 1) noexcept;
-    void heartbeat() noexcept;
+    uint32_t push_failures() const noexcept { return full + too_large + invalid; }
+    // high-water 바이트 점유율 (%) - 메일박스 크기 조정 기준
+    uint32_t high_water_percent() const noexcept {
+        return capacity_bytes > 0 ? static_cast<uint32_t>(uint64_t{high_water_bytes} * 100u / capacity_bytes) : 0;
+    }
 };
 
-// ============================================================================
-// Message Pool - Phase 3: Zero-overhead 메시지 생명주기 최적화
-// ============================================================================
 namespace detail {
-// Lock-free 메시지 풀 (고정 크기)
-template<typename T, std::size_t PoolSize>
-class MessagePool {
-    // 완화된 타입 제약 - virtual 상속을 지원하기 위해 제약 완화
-    static_assert(std::is_destructible_v<T>, "Message type must be destructible");
-    static_assert(PoolSize > 0 && PoolSize <= 256, "Pool size must be between 1 and 256");
+    inline uint32_t count_trailing_zeros(uint32_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint32_t>(__builtin_ctz(value));
+#else
+        uint32_t n = 0;
+        while (!(value & 1u)) {
+            value >>= 1;
+            ++n;
+        }
+        return n;
+#endif
+    }
     
-private:
-    struct PoolEntry {
-        alignas(T) uint8_t data[sizeof(T)];
-        std::atomic<bool> available;  // CAS를 위한 atomic bool
+    // 2단계 원자 비트맵 - 잎 워드(워드당 32 Agent) + 비어 있지 않은 잎 워드의 요약 비트.
+    // 찾기는 요약 워드에서 곧바로 잎 워드로 내려가므로 Agent 수가 늘어도 방문 비용이 거의 일정.
+    // 잎이 한 워드(MAX_AGENTS ≤ 32)면 요약 없이 기존 단일 워드와 같음.
+    // 표시는 잎 → 요약 순, 잎을 비운 쪽이 요약 비트를 지운 뒤 잎을 다시 확인 (seq_cst라 표시와 경합해도 유실 없음)
+    template<std::size_t Words>
+    class ReadyBitmap {
+    public:
+        static constexpr std::size_t WORD_BITS = 32;
+        static constexpr bool SUMMARY = Words > 1;
+        static constexpr std::size_t SUMMARY_WORDS = SUMMARY ? (Words + WORD_BITS - 1) / WORD_BITS : 0;
+        
+        void set(std::size_t index) noexcept {
+            const std::size_t w = index / WORD_BITS;
+            leaf_[w].fetch_or(1u << (index % WORD_BITS));
+            if constexpr (SUMMARY) {
+                summary_[w / WORD_BITS].fetch_or(1u << (w % WORD_BITS));
+            }
+        }
+        
+        // 비트를 지우고 이전에 설정되어 있었는지 반환
+        bool reset(std::size_t index) noexcept {
+            const std::size_t w = index / WORD_BITS;
+            const uint32_t bit = 1u << (index % WORD_BITS);
+            const uint32_t previous = leaf_[w].fetch_and(~bit, std::memory_order_acq_rel);
+            if ((previous & ~bit) == 0 && previous != 0) {
+                settle(w);
+            }
+            return (previous & bit) != 0;
+        }
+        
+        bool any() const noexcept {
+            if constexpr (SUMMARY) {
+                for (const auto& word : summary_) {
+                    if (word.load()) return true;
+                }
+                return false;
+            } else {
+                return leaf_[0].load() != 0;
+            }
+        }
+        
+        // cursor 위치의 상위 비트 → 다음 워드들 → 앞 워드들 → cursor 워드의 하위 비트 (wrap) 순으로
+        // 첫 비트를 원자적으로 가져옴. 다음 워드는 요약 비트로 건너뜀
+        bool take(std::size_t cursor, std::size_t& index) noexcept {
+            const std::size_t first = cursor / WORD_BITS;
+            const uint32_t offset = static_cast<uint32_t>(cursor % WORD_BITS);
+            if (take_in(first, ~0u << offset, index)) return true;
+            if constexpr (SUMMARY) {
+                for (std::size_t w = next(first + 1); w < Words; w = next(w + 1)) {
+                    if (take_in(w, ~0u, index)) return true;
+                }
+                for (std::size_t w = next(0); w < first; w = next(w + 1)) {
+                    if (take_in(w, ~0u, index)) return true;
+                }
+            }
+            return take_in(first, (1u << offset) - 1u, index);
+        }
+        
+        template<typename Fn>
+        void for_each(Fn&& fn) const noexcept {
+            for (std::size_t w = next(0); w < Words; w = next(w + 1)) {
+                for (uint32_t word = leaf_[w].load(std::memory_order_acquire); word; word &= word - 1) {
+                    fn(w * WORD_BITS + count_trailing_zeros(word));
+                }
+            }
+        }
+        
+    private:
+        // from 이상에서 요약 비트가 설정된 첫 잎 워드 (없으면 Words)
+        std::size_t next(std::size_t from) const noexcept {
+            if constexpr (SUMMARY) {
+                for (std::size_t s = from / WORD_BITS; s < SUMMARY_WORDS; ++s) {
+                    uint32_t bits = summary_[s].load(std::memory_order_acquire);
+                    if (s == from / WORD_BITS) bits &= ~0u << (from % WORD_BITS);
+                    if (bits) return s * WORD_BITS + count_trailing_zeros(bits);
+                }
+                return Words;
+            } else {
+                return from == 0 ? 0 : Words;
+            }
+        }
+        
+        bool take_in(std::size_t w, uint32_t mask, std::size_t& index) noexcept {
+            uint32_t word = leaf_[w].load(std::memory_order_acquire);
+            while (word & mask) {
+                const uint32_t candidates = word & mask;
+                const uint32_t bit = candidates & (~candidates + 1u);
+                if (leaf_[w].compare_exchange_weak(word, word & ~bit, std::memory_order_acq_rel)) {
+                    if ((word & ~bit) == 0) settle(w);
+                    index = w * WORD_BITS + count_trailing_zeros(bit);
+                    return true;
+                }
+            }
+            return false;
+        }
         
-        PoolEntry() noexcept : available(true) {}  // 생성자에서 초기화
+        // 잎 워드 w를 비운 뒤: 요약 비트 제거 → 잎 재확인 (그사이 set()이 있었으면 요약 복구)
+        void settle(std::size_t w) noexcept {
+            if constexpr (SUMMARY) {
+                const uint32_t bit = 1u << (w % WORD_BITS);
+                summary_[w / WORD_BITS].fetch_and(~bit);
+                if (leaf_[w].load()) {
+                    summary_[w / WORD_BITS].fetch_or(bit);
+                }
+            } else {
+                (void)w;
+            }
+        }
+        
+        std::array<std::atomic<uint32_t>, Words> leaf_{};
+        std::array<std::atomic<uint32_t>, SUMMARY_WORDS> summary_{};
     };
     
-    alignas(64) std::array<PoolEntry, PoolSize> pool_;
-    alignas(64) std::atomic<std::size_t> next_index_{0};  // atomic index
-    
-public:
-    MessagePool() noexcept {
-        // PoolEntry 생성자에서 available = true로 이미 초기화됨
-        // atomic 변수들도 기본 초기화됨
-    }
-    
-    // 메시지 할당 (True Lock-free with CAS)
-    T* allocate() noexcept {
-        for (std::size_t attempts = 0; attempts < PoolSize * 2; ++attempts) {
-            // 원자적으로 현재 인덱스 읽기
-            std::size_t index = next_index_.load(std::memory_order_acquire);
+    // Ready 비트맵 - 메시지가 있는 메일박스만 스케줄러가 방문하도록 push 시 비트 설정.
+    // 우선순위 클래스별로 비트맵을 두고, 클래스 안에서는 cursor 기준 round-robin.
+    // 스케줄러 태스크는 wait()에서 task notification으로 블록 (spin 없음).
+    // 여러 워커가 같은 ReadySet을 기다릴 수 있으며 mark()는 대기 중인 워커 하나를 깨움.
+    // 클래스/기한 비트맵은 ReadyBitmap (2단계)이라 MAX_AGENTS가 커져도 take_next 비용이 평탄함.
+    class ReadySet {
+    public:
+        static constexpr std::size_t WORD_BITS = 32;
+        static constexpr std::size_t WORDS = (MINI_SO_MAX_AGENTS + WORD_BITS - 1) / WORD_BITS;
+        static constexpr std::size_t LEVELS = PRIORITY_LEVELS;
+        static constexpr std::size_t MAX_WAITERS = MINI_SO_MAX_READY_WAITERS;
+        
+        void mark(std::size_t index, std::size_t level = static_cast<std::size_t>(Priority::NORMAL)) noexcept {
+            // seq_cst: wait()의 waiter 등록과 Dekker 방식으로 짝 (wakeup 유실 방지)
+            bits_[level].set(index);
+            if (waiting_.load()) [[unlikely]] {
+                wake(false);
+            }
+        }
+        
+        // 대기 중인 모든 태스크를 깨움 (디스패처 정지 등)
+        void wake_all() noexcept { wake(true); }
+        // 비트 표시 없이 대기 중인 태스크 하나를 깨움 (수신함 전달 등 태스크 문맥)
+        void wake_one() noexcept {
+            std::atomic_thread_fence(std::memory_order_seq_cst);  // 게시 후 waiting_ 확인 (Dekker)
+            if (waiting_.load()) wake(false);
+        }
+        
+        // ISR에서 대기 중인 태스크 하나를 깨움 - higher_priority_woken은 portYIELD_FROM_ISR용
+        void wake_from_isr(BaseType_t* higher_priority_woken) noexcept {
+            if (!waiting_.load()) return;
+            for (auto& candidate : waiters_) {
+                if (!candidate.load()) continue;
+                if (TaskHandle_t waiter = candidate.exchange(nullptr)) {
+                    vTaskNotifyGiveFromISR(waiter, higher_priority_woken);
+                    return;
+                }
+            }
+        }
+        
+        // 모든 우선순위 클래스에서 index 비트 제거
+        void clear(std::size_t index) noexcept {
+            for (auto& level : bits_) {
+                level.reset(index);
+            }
+            clear_deadline(index);
+        }
+        
+        // 기한 메시지(send_with_deadline)가 대기 중인 Agent - 스케줄러는 우선순위 클래스보다 먼저
+        // 이 중 가장 이른 기한의 Agent를 방문 (EDF). ready 비트와 별개라 표시만으로 방문되지 않음
+        void mark_deadline(std::size_t index) noexcept { deadline_bits_.set(index); }
+        
+        void clear_deadline(std::size_t index) noexcept { deadline_bits_.reset(index); }
+        
+        bool any_deadline() const noexcept { return deadline_bits_.any(); }
+        
+        template<typename Fn>
+        void for_each_deadline(Fn&& fn) const noexcept {
+            deadline_bits_.for_each(std::forward<Fn>(fn));
+        }
+        
+        // 특정 Agent의 ready 비트를 가장 높은 클래스부터 하나 가져옴 (take_next와 같은 소유권 규칙)
+        bool claim(std::size_t index, std::size_t& level) noexcept {
+            for (level = 0; level < LEVELS; ++level) {
+                if (bits_[level].reset(index)) return true;
+            }
+            return false;
+        }
+        
+        bool any() const noexcept {
+            for (std::size_t level = 0; level < LEVELS; ++level) {
+                if (any(level)) return true;
+            }
+            return false;
+        }
+        
+        bool any(std::size_t level) const noexcept { return bits_[level].any(); }
+        
+        // level 클래스에서 cursor 이후 첫 ready 비트를 원자적으로 가져옴
+        // 가져온 다음 위치로 cursor를 옮겨 같은 클래스 Agent 사이의 기아를 방지
+        // (cursor는 공정성 힌트일 뿐이라 여러 워커가 동시에 갱신해도 무방)
+        bool take_next(std::size_t level, std::size_t& index) noexcept {
+            const std::size_t cursor = cursor_[level].load(std::memory_order_relaxed);
+            if (!bits_[level].take(cursor, index)) return false;
+            cursor_[level].store((index + 1) % (WORDS * WORD_BITS), std::memory_order_relaxed);
+            return true;
+        }
+        
+        // ready 비트가 생길 때까지 최대 timeout 동안 호출 태스크를 블록
+        bool wait(TickType_t timeout) noexcept {
+            TaskHandle_t self = xTaskGetCurrentTaskHandle();
+            std::atomic<TaskHandle_t>* slot = add_waiter(self);
             
-            // CAS: available을 true→false로 원자적 변경 시도
-            bool expected = true;
-            if (pool_[index].available.compare_exchange_weak(
-                    expected, false,
-                    std::memory_order_acq_rel,    // 성공 시: acquire-release
-                    std::memory_order_relaxed)) { // 실패 시: relaxed
-                
-                // 성공! 다음 인덱스 업데이트 (다른 스레드를 위해)
-                std::size_t next_idx = (index + 1) % PoolSize;
-                next_index_.store(next_idx, std::memory_order_release);
-                
-                return reinterpret_cast<T*>(pool_[index].data);
+            // 슬롯이 없으면 (MAX_WAITERS 초과) 짧게 양보 후 재확인
+            if (!any()) {
+                Observer::on_idle(slot ? timeout : 1);
+                ulTaskNotifyTake(pdTRUE, slot ? timeout : 1);
             }
             
-            // 실패 시 다음 인덱스로 이동 (다른 스레드와 겹치지 않도록)
-            std::size_t next_idx = (index + 1) % PoolSize;
-            next_index_.compare_exchange_weak(index, next_idx, std::memory_order_relaxed);
+            remove_waiter(slot, self);
+            return any();
         }
-        return nullptr;  // 풀 고갈
-    }
-    
-    // 메시지 해제 (원자적)
-    void deallocate(T* ptr) noexcept {
-        if (!ptr) return;
         
-        for (auto& entry : pool_) {
-            if (reinterpret_cast<T*>(entry.data) == ptr) {
-                // 원자적으로 available을 true로 설정
-                entry.available.store(true, std::memory_order_release);
-                return;
+        // 이 set을 소비하는 스레드가 하나뿐인지 (Environment::run, OneThreadDispatcher).
+        // 같은 배타 set에 묶인 Agent끼리는 파이프라인 Outlet이 메일박스 대신 직접 호출할 수 있음
+        void set_exclusive(bool exclusive) noexcept { exclusive_.store(exclusive, std::memory_order_relaxed); }
+        bool exclusive() const noexcept { return exclusive_.load(std::memory_order_relaxed); }
+        
+        // 여러 ReadySet을 한 번에 기다리는 경우용: 등록 → any() 재확인 → ulTaskNotifyTake → 해제
+        // 등록 후 재확인해야 mark()와의 wakeup 유실이 없음. 슬롯이 없으면 nullptr
+        std::atomic<TaskHandle_t>* add_waiter(TaskHandle_t self) noexcept {
+            waiting_.fetch_add(1);
+            for (auto& candidate : waiters_) {
+                TaskHandle_t expected = nullptr;
+                if (candidate.compare_exchange_strong(expected, self)) {
+                    return &candidate;
+                }
             }
+            return nullptr;
         }
-    }
+        
+        void remove_waiter(std::atomic<TaskHandle_t>* slot, TaskHandle_t self) noexcept {
+            if (slot) {
+                TaskHandle_t expected = self;
+                slot->compare_exchange_strong(expected, nullptr);
+            }
+            waiting_.fetch_sub(1);
+        }
+        
+    private:
+        void wake(bool all) noexcept {
+            for (auto& candidate : waiters_) {
+                if (!candidate.load()) continue;
+                TaskHandle_t waiter = candidate.exchange(nullptr);
+                if (waiter) {
+                    xTaskNotifyGive(waiter);
+                    if (!all) return;
+                }
+            }
+        }
+        
+        std::array<ReadyBitmap<WORDS>, LEVELS> bits_{};
+        ReadyBitmap<WORDS> deadline_bits_{};
+        std::array<std::atomic<std::size_t>, LEVELS> cursor_{};
+        std::atomic<uint32_t> waiting_{0};
+        std::array<std::atomic<TaskHandle_t>, MAX_WAITERS> waiters_{};
+        std::atomic<bool> exclusive_{false};
+    };
     
-    // 풀 상태 조회
-    constexpr std::size_t capacity() const noexcept { return PoolSize; }
+    // 풀 메시지 참조 레코드 - payload 대신 풀 슬롯 포인터만 큐에 저장 (Zero-copy)
+    // 수신 Agent는 풀 저장소에서 직접 읽고, handle_message 반환 후 release 호출
+    struct MessageHandle {
+        MessageBase* message;
+        void (*release)(MessageBase* message) noexcept;
+        uint16_t size;
+    };
     
-    std::size_t available_count() const noexcept {
-        std::size_t count = 0;
-        for (const auto& entry : pool_) {
-            // 원자적으로 available 상태 읽기
-            if (entry.available.load(std::memory_order_relaxed)) ++count;
-        }
-        return count;
+    // 커널 뮤텍스 저장소 - MINI_SO_STATIC_SEMAPHORES면 제어 블록을 소유 객체 안에 둠 (힙 없음)
+#if MINI_SO_STATIC_SEMAPHORES
+    using MutexStorage = StaticSemaphore_t;
+    
+    inline SemaphoreHandle_t create_mutex(MutexStorage& storage) noexcept {
+        return xSemaphoreCreateMutexStatic(&storage);
     }
-};
-
-// 전역 메시지 풀 관리자
-template<typename T>
-class GlobalMessagePool {
-private:
-    static constexpr std::size_t DEFAULT_POOL_SIZE = 32;
-    static inline MessagePool<Message<T>, DEFAULT_POOL_SIZE> pool_;
+#else
+    struct MutexStorage {};
     
-public:
-    static Message<T>* allocate() noexcept {
-        return pool_.allocate();
+    inline SemaphoreHandle_t create_mutex(MutexStorage&) noexcept {
+        return xSemaphoreCreateMutex();
     }
+#endif
+}
+
+// 가변 크기 레코드 메일박스 (byte ring)
+// 레코드 = [8바이트 헤더 | payload(8바이트 정렬)]. 끝에 맞지 않는 레코드는
+// 남은 공간을 padding 레코드로 채우고 버퍼 시작에서 이어 씀 (wrap-aware).
+// 메모리는 최대 메시지 크기가 아니라 실제 전송되는 메시지 크기에 비례.
+// CapacityBytes는 내장 버퍼 크기 - attach_storage로 외부 버퍼(다른 2의 거듭제곱 크기)로 바꿀 수 있고,
+// 0이면 내장 버퍼 없이 attach_storage 전까지 모든 push가 실패
+template<QueuePolicy Policy, std::size_t CapacityBytes = MINI_SO_MAILBOX_BYTES>
+class BasicMessageQueue {
+public:
+    using Result = QueueResult;
     
-    static void deallocate(Message<T>* msg) noexcept {
-        pool_.deallocate(msg);
+    // 레코드 헤더 = 상태 워드 4바이트 + payload 정렬용 채움 (압축 헤더 모드의 32비트 타깃은 채움 없음)
+    static constexpr std::size_t RECORD_HEADER_SIZE = detail::MAILBOX_RECORD_ALIGN;
+    static constexpr std::size_t RECORD_ALIGN = detail::MAILBOX_RECORD_ALIGN;
+    
+    static_assert(CapacityBytes == 0 || ((CapacityBytes & (CapacityBytes - 1)) == 0 && CapacityBytes >= RECORD_ALIGN),
+                  "Mailbox capacity must be a power of two (bytes)");
+    static_assert(CapacityBytes == 0 || CapacityBytes >= RECORD_HEADER_SIZE + MINI_SO_MAX_MESSAGE_SIZE,
+                  "Mailbox must hold at least one maximum-size message");
+    
+    static constexpr QueuePolicy policy = Policy;
+    static constexpr std::size_t INLINE_BYTES = CapacityBytes;
+    std::size_t capacity_bytes() const noexcept { return capacity_; }
+    
+    // 레코드가 차지하는 바이트 수 (헤더 + 정렬된 payload)
+    static constexpr std::size_t record_bytes(std::size_t payload_size) noexcept {
+        return RECORD_HEADER_SIZE + ((payload_size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1));
     }
     
-    static std::size_t available_count() noexcept {
-        return pool_.available_count();
+private:
+    // 레코드 헤더 상태 워드: [flags | payload size(16bit)]
+    static constexpr uint32_t SIZE_MASK = 0x0000FFFFu;
+    static constexpr uint32_t COMMITTED = 0x80000000u;  // 게시 완료 (MPSC)
+    static constexpr uint32_t PADDING = 0x40000000u;    // wrap용 빈 레코드
+    static constexpr uint32_t HANDLE = 0x20000000u;     // payload가 detail::MessageHandle
+    static constexpr uint32_t DEADLINE = 0x10000000u;   // payload 뒤에 절대 기한 트레일러 (RECORD_ALIGN 바이트)
+    static constexpr uint32_t MISS_MASK = 0x0C000000u;  // 기한 초과 시 DeadlineMiss
+    static constexpr unsigned MISS_SHIFT = 26;
+    
+    // 레코드 헤더 상태로 본 레코드 전체 바이트 수 (기한 트레일러 포함)
+    static constexpr std::size_t stored_bytes(uint32_t state) noexcept {
+        return record_bytes(state & SIZE_MASK) + ((state & DEADLINE) ? RECORD_ALIGN : 0);
     }
     
-    static constexpr std::size_t capacity() noexcept {
-        return pool_.capacity();
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Record header must be 4 bytes");
+    
+    // head_는 소비자 전용, tail_은 생산자 전용 - 서로 다른 캐시 라인 배치 (false sharing 방지)
+    alignas(64) std::array<uint8_t, CapacityBytes> storage_{};  // 내장 버퍼 (attach_storage 전)
+    uint8_t* buffer_ = storage_.data();
+    std::size_t capacity_ = CapacityBytes;
+    std::size_t mask_ = CapacityBytes > 0 ? CapacityBytes - 1 : 0;
+    alignas(64) std::atomic<std::size_t> head_{0};   // 소비 위치 (바이트, 단조 증가)
+    alignas(64) std::atomic<std::size_t> tail_{0};   // 예약 위치 (바이트, 단조 증가)
+    std::atomic<uint32_t> count_{0};                 // 게시된 레코드 수
+    std::atomic<uint16_t> deadlines_pending_{0};     // 대기 중인 기한 레코드 수
+    std::atomic<HiresTime> earliest_deadline_{0};    // 그중 가장 이른 기한 (EDF 선택 힌트)
+#if MINI_SO_MAILBOX_STATS
+    std::atomic<uint32_t> high_water_{0};
+    std::atomic<uint32_t> high_water_bytes_{0};
+    std::array<std::atomic<uint32_t>, 3> push_failures_{};  // QUEUE_FULL, MESSAGE_TOO_LARGE, INVALID_MESSAGE
+    std::atomic<HiresTime> saturated_since_{0};             // 포화 진입 시각 (0 = 포화 아님)
+    std::atomic<uint32_t> saturations_{0};
+    std::atomic<uint32_t> saturated_us_{0};                 // 끝난 포화 구간의 합
+#endif
+    SemaphoreHandle_t mutex_ = nullptr;              // MUTEX 정책에서만 생성
+    [[no_unique_address]] std::conditional_t<Policy == QueuePolicy::MUTEX, detail::MutexStorage, std::array<uint8_t, 0>>
+        mutex_storage_{};
+    std::atomic<detail::ReadySet*> ready_set_{nullptr};  // push 성공 시 표시할 스케줄러 비트맵
+    std::size_t ready_index_ = 0;
+    std::atomic<uint8_t> ready_level_{static_cast<uint8_t>(Priority::NORMAL)};
+    std::atomic<bool> consumer_locked_{false};           // 방문 또는 과부하 처리 중
+    std::atomic<TaskHandle_t> space_waiter_{nullptr};    // BLOCK 정책 대기 태스크
+    
+    std::atomic<uint32_t>& header_at(std::size_t pos) noexcept {
+        return *reinterpret_cast<std::atomic<uint32_t>*>(&buffer_[pos & mask_]);
+    }
+    uint8_t* payload_at(std::size_t pos) noexcept {
+        return &buffer_[(pos & mask_) + RECORD_HEADER_SIZE];
     }
-};
-}   // namespace detail
-
-// 풀링된 메시지 래퍼
-template<typename T>
-class PooledMessage {
-private:
-    Message<T>* msg_;
-    bool owns_message_;
     
 public:
-    // 풀에서 할당
-    static PooledMessage<T> create(const T& data, AgentId sender = INVALID_AGENT_ID) noexcept {
-        Message<T>* msg = detail::GlobalMessagePool<T>::allocate();
-        if (msg) [[likely]] {
-            // Placement new로 메시지 생성
-            new (msg) Message<T>(data, sender);
-            return PooledMessage<T>(msg, true);
-        } else {
-            // 풀 고갈 시 스택 할당 (fallback)
-            static thread_local Message<T> fallback_msg(data, sender);
-            fallback_msg = Message<T>(data, sender);
-            return PooledMessage<T>(&fallback_msg, false);
-        }
+    // MUTEX 정책이 아니면 상수 초기화 가능 (정적 Agent/메일박스가 생성자 코드 없이 .bss에 놓임)
+    constexpr BasicMessageQueue() noexcept;
+    ~BasicMessageQueue() noexcept;
+    
+    BasicMessageQueue(const BasicMessageQueue&) = delete;
+    BasicMessageQueue& operator=(const BasicMessageQueue&) = delete;
+    
+    // 생산자: 여러 태스크에서 호출 가능 (SPSC는 단일 생산자만)
+    // lock_wait: MUTEX 정책의 잠금 대기 한도 (틱, 초과 시 INVALID_MESSAGE). 다른 정책은 잠금 없음
+    Result push(const MessageBase& msg, uint16_t size, TickType_t lock_wait = portMAX_DELAY) noexcept;
+    // 풀 메시지 참조만 큐잉 - 성공 시 소유권이 큐로 이동, 소비 후 handle.release 호출
+    Result push_handle(const detail::MessageHandle& handle) noexcept;
+    // 같은 크기 레코드 count개를 연속 구간 단위로 한 번에 예약 (wrap 시 최대 2회)
+    // construct(void* payload, std::size_t i)가 제자리 작성. 반환: 넣은 개수 (공간 부족 시 일부)
+    template<typename Fn>
+    std::size_t push_batch(uint16_t size, std::size_t count, Fn&& construct) noexcept;
+    // 레코드 하나를 예약하고 construct(void* payload)가 size 바이트 메시지를 슬롯에 직접 생성
+    // (스크래치 버퍼와 memcpy 없음). 생성된 객체는 MessageBase 파생이어야 함
+    template<typename Fn>
+    Result push_in_place(uint16_t size, Fn&& construct, TickType_t lock_wait = portMAX_DELAY) noexcept;
+    // Message<T>(sender, args...)를 메일박스 레코드에 직접 생성 (전송 시각 기록)
+    template<typename T, typename... Args>
+    Result emplace(AgentId sender, Args&&... args) noexcept;
+    // 기한 메시지: 레코드 뒤에 절대 기한(hires_now() 기준)을 두고 소비 시 검사 - 기한을 넘겼으면
+    // consume의 late 콜백 후 miss에 따라 전달 또는 폐기. 성공 시 스케줄러의 EDF 후보로 표시
+    Result push_deadline(const MessageBase& msg, uint16_t size, HiresTime deadline, DeadlineMiss miss) noexcept;
+    
+    // 소비자: 소유 Agent의 처리 컨텍스트에서만 호출
+    // consume: 맨 앞 메시지를 제자리(in-place)에서 fn(const MessageBase&, uint16_t size)로
+    //          전달한 뒤 해제. 복사 없음.
+    // late: 기한을 넘긴 기한 레코드마다 fn 전에 late(const MessageBase&, DeadlineMiss, HiresTime deadline) 호출
+    template<typename Fn, typename Late>
+    bool consume(Fn&& fn, Late&& late) noexcept;
+    template<typename Fn>
+    bool consume(Fn&& fn) noexcept {
+        return consume(std::forward<Fn>(fn), [](const MessageBase&, DeadlineMiss, HiresTime) noexcept {});
     }
+    // consume_run: 맨 앞부터 같은 타입 ID의 연속 메시지를 최대 max_count개 모아
+    //              fn(Span<const MessageBase* const>)로 제자리 전달한 뒤 한꺼번에 해제.
+    //              반환: 소비한 메시지 수 (max_count <= MINI_SO_MAX_BATCH). 기한 레코드는 1개짜리 run
+    template<typename Fn, typename Late>
+    std::size_t consume_run(std::size_t max_count, Fn&& fn, Late&& late) noexcept;
+    template<typename Fn>
+    std::size_t consume_run(std::size_t max_count, Fn&& fn) noexcept {
+        return consume_run(max_count, std::forward<Fn>(fn), [](const MessageBase&, DeadlineMiss, HiresTime) noexcept {});
+    }
+    // pop: buffer(MINI_SO_MAX_MESSAGE_SIZE)로 복사. 이보다 큰 풀 메시지는 복사할 수
+    //      없으므로 해제 후 false 반환 (consume 사용)
+    bool pop(uint8_t* buffer, uint16_t& size) noexcept;
     
-    // 이동 생성자
-    PooledMessage(PooledMessage&& other) noexcept 
-        : msg_(other.msg_), owns_message_(other.owns_message_) {
-        other.msg_ = nullptr;
-        other.owns_message_ = false;
+    bool empty() const noexcept { return count_.load(std::memory_order_acquire) == 0; }
+    // 최대 크기 메시지를 더 받을 수 없으면 full
+    bool full() const noexcept { return free_bytes() < 2 * record_bytes(MINI_SO_MAX_MESSAGE_SIZE); }
+    std::size_t size() const noexcept { return count_.load(std::memory_order_acquire); }
+    std::size_t used_bytes() const noexcept {
+        // 소비자 위치를 먼저 읽어야 tail - head가 음수가 되지 않음
+        std::size_t head = head_.load(std::memory_order_acquire);
+        std::size_t tail = tail_.load(std::memory_order_acquire);
+        std::size_t used = tail - head;
+        return used > capacity_ ? capacity_ : used;
     }
+    std::size_t free_bytes() const noexcept { return capacity_ - used_bytes(); }
+    void clear() noexcept;
     
-    // 복사 금지
-    PooledMessage(const PooledMessage&) = delete;
-    PooledMessage& operator=(const PooledMessage&) = delete;
-    PooledMessage& operator=(PooledMessage&&) = delete;
+    // 점유 텔레메트리 (push/소비 경로에서 갱신, 경합 중인 스냅샷은 근사값)
+    MailboxStats stats() const noexcept;
+    void reset_stats() noexcept;
     
-    // 소멸자에서 자동 해제
-    ~PooledMessage() noexcept {
-        if (msg_ && owns_message_) {
-            detail::GlobalMessagePool<T>::deallocate(msg_);
-        }
+    // 대기 중인 기한 레코드의 가장 이른 기한 - 없으면 false. 소비 순서와 무관하게 최소값만 유지하므로
+    // 이미 처리된 기한이 다음 기한 레코드가 올 때까지 남을 수 있음 (더 급하게 보는 쪽으로만 틀림)
+    bool earliest_deadline(HiresTime& deadline) const noexcept {
+        if (deadlines_pending_.load(std::memory_order_acquire) == 0) return false;
+        deadline = earliest_deadline_.load(std::memory_order_acquire);
+        return true;
     }
+    std::size_t pending_deadlines() const noexcept { return deadlines_pending_.load(std::memory_order_relaxed); }
     
-    // 메시지 접근
-    const Message<T>& get() const noexcept { return *msg_; }
-    Message<T>& get() noexcept { return *msg_; }
+    // 외부 버퍼 사용 (bytes: 2의 거듭제곱, buffer: 8바이트 정렬) - 비어 있고 생산자가 없을 때만
+    // (Agent 등록 전). 버퍼는 0으로 초기화됨. 받은 메시지보다 작은 버퍼로는 그 메시지를 받을 수 없음
+    bool attach_storage(uint8_t* buffer, std::size_t bytes) noexcept;
+    // 내장 버퍼로 되돌림 (비어 있고 생산자가 없을 때만, Agent 해제 후) - 외부 버퍼 반납용
+    void detach_storage() noexcept {
+        buffer_ = storage_.data();
+        capacity_ = CapacityBytes;
+        mask_ = CapacityBytes > 0 ? CapacityBytes - 1 : 0;
+    }
+    const uint8_t* storage() const noexcept { return buffer_; }
     
-    const Message<T>* operator->() const noexcept { return msg_; }
-    Message<T>* operator->() noexcept { return msg_; }
+    // 소비자 역할 점유 - 소유 Agent의 방문과 생산자의 과부하 처리(evict/replace)를 상호 배제.
+    // 방문당 한 번 (메시지마다가 아님)
+    bool try_lock_consumer() noexcept { return !consumer_locked_.exchange(true, std::memory_order_acquire); }
+    void unlock_consumer() noexcept { consumer_locked_.store(false, std::memory_order_release); }
+    bool consumer_locked() const noexcept { return consumer_locked_.load(std::memory_order_acquire); }
     
-    const Message<T>& operator*() const noexcept { return *msg_; }
-    Message<T>& operator*() noexcept { return *msg_; }
+    // 소비자 역할 점유 중에만 호출: 맨 앞 메시지 폐기 (풀 슬롯 반환)
+    bool evict_front() noexcept;
+    // 소비자 역할 점유 중에만 호출: 대기 중인 같은 타입/크기의 가장 최근 메시지를 msg로 덮어씀
+    bool replace_latest(const MessageBase& msg, uint16_t size) noexcept;
     
-    bool is_pooled() const noexcept { return owns_message_; }
+    // BLOCK 정책: 공간을 기다리는 발신 태스크 하나 (나머지는 1틱 폴링). 소비자가 방문 뒤 깨움
+    bool add_space_waiter(TaskHandle_t task) noexcept {
+        TaskHandle_t expected = nullptr;
+        return space_waiter_.compare_exchange_strong(expected, task, std::memory_order_acq_rel);
+    }
+    void remove_space_waiter(TaskHandle_t task) noexcept {
+        space_waiter_.compare_exchange_strong(task, nullptr, std::memory_order_acq_rel);
+    }
+    void notify_space() noexcept {
+        if (space_waiter_.load(std::memory_order_relaxed)) [[unlikely]] {
+            if (TaskHandle_t waiter = space_waiter_.exchange(nullptr, std::memory_order_acq_rel)) {
+                xTaskNotifyGive(waiter);
+            }
+        }
+    }
     
-private:
-    explicit PooledMessage(Message<T>* msg, bool owns) noexcept 
-        : msg_(msg), owns_message_(owns) {}
-};
-
-// ============================================================================
-// Static Environment - Phase 3: 컴파일 타임 Agent 등록 최적화
-// ============================================================================
-namespace detail {
-    // 컴파일 타임 Agent 카운터
-    template<typename... Agents>
-    struct AgentCounter {
-        static constexpr std::size_t count = sizeof...(Agents);
-    };
-    
-    // 컴파일 타임 Agent 타입 검증
-    template<typename T>
-    constexpr bool is_valid_agent() noexcept {
-        return std::is_base_of_v<Agent, T> && !std::is_abstract_v<T>;
+    // 스케줄러 연결: push 성공 시 set의 index 비트를 설정 (nullptr이면 해제)
+    // 다른 스케줄러(디스패처)로 옮길 때도 사용 - 생산자는 release/acquire로 새 set을 봄
+    void bind_ready_set(detail::ReadySet* set, std::size_t index) noexcept {
+        ready_index_ = index;
+        ready_set_.store(set, std::memory_order_release);
+        if (set && !empty()) {
+            if (pending_deadlines() > 0) set->mark_deadline(index);
+            set->mark(index, ready_level());
+        }
     }
     
-    // 컴파일 타임 Agent 리스트 유효성 검사
-    template<typename... Agents>
-    constexpr bool all_valid_agents() noexcept {
-        return (is_valid_agent<Agents>() && ...);
+    // push 시 표시할 우선순위 클래스 변경 - 대기 중인 메시지는 새 클래스로 다시 표시
+    void set_ready_level(std::size_t level) noexcept {
+        ready_level_.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+        if (!empty()) {
+            mark_ready(level);
+        }
     }
-}
-
-// Static Environment for compile-time Agent registration
-template<typename... StaticAgents>
-class StaticEnvironment {
-    static_assert(detail::all_valid_agents<StaticAgents...>(), 
-                  "All template parameters must be valid Agent types");
-    static_assert(sizeof...(StaticAgents) <= MINI_SO_MAX_AGENTS,
-                  "Too many static agents defined");
-    
-private:
-    alignas(64) std::array<Agent*, MINI_SO_MAX_AGENTS> agents_;
-    std::size_t agent_count_ = 0;
-    SemaphoreHandle_t mutex_;
-    static inline bool env_initialized_ = false;
     
-public:
-    StaticEnvironment() noexcept {
-        mutex_ = xSemaphoreCreateMutex();
-        if (!mutex_) [[unlikely]] {
-            // 현대적 Fail-Safe: 헤더에서는 간단히 처리
-            taskDISABLE_INTERRUPTS();
-            for(;;);
-        }
-        
-        for (auto& agent : agents_) {
-            agent = nullptr;
-        }
+    bool bound_to(const detail::ReadySet* set) const noexcept {
+        return ready_set_.load(std::memory_order_acquire) == set;
     }
+    detail::ReadySet* ready_set() const noexcept { return ready_set_.load(std::memory_order_acquire); }
     
-    ~StaticEnvironment() noexcept {
-        if (mutex_) {
-            vSemaphoreDelete(mutex_);
+    // 연결된 스케줄러에 이 메일박스를 level 클래스로 표시 (메시지 우선순위 승격)
+    void mark_ready(std::size_t level) noexcept {
+        if (detail::ReadySet* set = ready_set_.load(std::memory_order_acquire)) {
+            set->mark(ready_index_, level);
         }
     }
     
-    // 컴파일 타임 Agent 등록
-    template<typename T>
-    constexpr AgentId register_static_agent(T& agent) noexcept {
-        static_assert(detail::is_valid_agent<T>(), "T must be a valid Agent type");
-        
-        // 컴파일 타임에 Agent 타입이 리스트에 있는지 확인
-        static_assert(((std::is_same_v<T, StaticAgents>) || ...), 
-                      "Agent type must be in the StaticAgents list");
-        
-        // 런타임 등록 (컴파일 타임 검증 완료 후)
-        return register_agent_impl(&agent);
-    }
+    std::size_t ready_level() const noexcept { return ready_level_.load(std::memory_order_relaxed); }
     
-    // 동적 Agent 등록 (기존 호환성)
-    AgentId register_agent(Agent* agent) noexcept {
-        return register_agent_impl(agent);
-    }
+private:
+    // 바이트 예약: 성공 시 레코드 시작 위치 반환 (wrap padding 포함 처리)
+    bool reserve(std::size_t record_len, std::size_t& record_pos) noexcept;
+    // 최대 max_count개 레코드를 버퍼 끝을 넘지 않는 한 구간으로 예약, granted에 개수
+    bool reserve_run(std::size_t record_len, std::size_t max_count,
+                     std::size_t& record_pos, std::size_t& granted) noexcept;
+    // 예약된 레코드 게시 (payload는 이미 작성됨)
+    void commit(std::size_t record_pos, uint16_t size, uint32_t flags) noexcept;
+    // 레코드 하나 예약 → write(void* payload)로 작성 → 게시
+    template<typename Write>
+    Result push_record(uint16_t size, uint32_t flags, Write&& write, TickType_t lock_wait = portMAX_DELAY) noexcept;
     
-    // 나머지 메서드들은 기존과 동일 (인라인 구현)
-    void unregister_agent(AgentId id) noexcept {
-        if (id >= agent_count_) [[unlikely]] return;
-        
-        if (xSemaphoreTake(mutex_, portMAX_DELAY) == pdTRUE) {
-            if (agents_[id]) {
-                agents_[id]->message_queue_.clear();
-                agents_[id] = nullptr;
-            }
-            xSemaphoreGive(mutex_);
+    // 텔레메트리: 게시 후 high-water/포화 진입, 실패 코드 집계, 해제 후 포화 이탈
+    void note_pushed(uint32_t records) noexcept;
+    void note_failed(Result result, uint32_t count = 1) noexcept;
+    void note_released() noexcept;
+    
+    // trace/관찰자: 대상 = 연결된 Agent (ready_index_), 미연결 큐는 INVALID_AGENT_ID
+    void trace_push(const MessageHeader& header, Result result) noexcept {
+        const AgentId target =
+            ready_set_.load(std::memory_order_relaxed) ? static_cast<AgentId>(ready_index_) : INVALID_AGENT_ID;
+        const std::size_t depth = size();
+        if (result == Result::SUCCESS) [[likely]] {
+            trace::record(trace::EventKind::SEND, header.type_id, header.sender(), target, depth);
+            Observer::on_send(header.type_id, header.sender(), target, depth);
+        } else {
+            trace::record(trace::EventKind::DROP, header.type_id, header.sender(), target, depth);
+            Observer::on_enqueue_fail(header.type_id, header.sender(), target, depth);
+            note_failed(result);
         }
     }
     
-    Agent* get_agent(AgentId id) noexcept {
-        if (id >= agent_count_) [[unlikely]] {
-            return nullptr;
-        }
-        return agents_[id];
+    // 소비자: padding을 건너뛰고 맨 앞 게시 레코드 위치/상태 조회, 처리 후 release_front
+    bool front(std::size_t& head, uint32_t& state) noexcept;
+    void release_front(std::size_t head, uint32_t state) noexcept;
+    
+    // 기한 레코드: 트레일러 위치, 맨 앞 기한 레코드 소비, 대기 기한 등록/해제
+    uint8_t* trailer_at(std::size_t pos, uint32_t state) noexcept {
+        return payload_at(pos) + (((state & SIZE_MASK) + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1));
     }
+    template<typename Fn, typename Late>
+    void consume_deadline(std::size_t head, uint32_t state, Fn&& fn, Late&& late) noexcept;
+    void note_deadline(HiresTime deadline) noexcept;
+    void finish_deadline() noexcept;
+};
+
+// 기본 Agent 메일박스 (MINI_SO_QUEUE_POLICY로 선택)
+using MessageQueue = BasicMessageQueue<static_cast<QueuePolicy>(MINI_SO_QUEUE_POLICY)>;
+
+namespace detail {
+    // 최신 값 cell의 메일박스 대기 표지 - 소비 시 cell의 현재 값으로 바뀌어 디스패치
+    struct LatestNotice {
+        uint8_t cell;
+    };
     
-    template<typename T>
-    bool send_message(AgentId sender_id, AgentId target_id, const T& message) noexcept {
-        if (target_id >= agent_count_ || !agents_[target_id]) [[unlikely]] {
-            return false;
+    // 수신 Agent의 타입별 최신 값 cell (seqlock). cell은 첫 전송 때 타입에 배정되고 Agent 해제까지 유지.
+    // 생산자는 seq를 홀수로 점유해 서로 배제 - 점유 실패면 동시에 쓰는 다른 생산자의 값이 최신 값이 되고
+    // 이쪽 값은 덮어쓴 것으로 침 (대기 없음 - 우선순위 역전 없음). 배정할 cell이 없으면 호출자가 일반 레코드로 보냄.
+    // 소비자는 표지를 꺼내며 queued를 먼저 내리므로 읽는 중 갱신된 값은 그 생산자가 넣은 새 표지로 전달됨
+    class LatestCells {
+    public:
+        static constexpr std::size_t CELLS = MINI_SO_LATEST_CELLS;
+        static constexpr std::size_t BYTES = MINI_SO_LATEST_BYTES;
+        static constexpr uint8_t NO_CELL = 0xFF;
+        static_assert(CELLS < NO_CELL, "Latest-value cells must fit in uint8_t");
+        static_assert(BYTES % 4 == 0 && BYTES >= 16, "MINI_SO_LATEST_BYTES must be a multiple of 4 (>= 16)");
+        
+        struct alignas(std::max_align_t) Buffer {
+            uint8_t bytes[BYTES];
+        };
+        
+        // 생산자: 반환 = 값을 넣은 cell (NO_CELL이면 일반 경로), notify = 표지를 새로 넣어야 함
+        uint8_t store(MessageId type_id, const MessageBase& msg, uint16_t size, bool& notify) noexcept {
+            for (uint8_t index = 0; index < CELLS; ++index) {
+                Cell& cell = cells_[index];
+                MessageId owner = cell.type_id.load(std::memory_order_acquire);
+                if (owner == INVALID_MESSAGE_ID &&
+                    cell.type_id.compare_exchange_strong(owner, type_id, std::memory_order_acq_rel)) {
+                    owner = type_id;  // 빈 cell 배정 (실패하면 owner = 먼저 배정된 타입)
+                }
+                if (owner != type_id) continue;
+                
+                uint32_t seq = cell.seq.load(std::memory_order_relaxed);
+                if ((seq & 1) || !cell.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire,
+                                                                   std::memory_order_relaxed)) [[unlikely]] {
+                    notify = false;  // 쓰는 중인 생산자가 표지를 책임짐
+                    return index;
+                }
+                std::atomic_thread_fence(std::memory_order_release);
+                uint32_t words[WORDS] = {};
+                std::memcpy(words, &msg, size);
+                for (std::size_t i = 0; i < WORDS; ++i) {
+                    cell.words[i].store(words[i], std::memory_order_relaxed);
+                }
+                cell.size.store(size, std::memory_order_relaxed);
+                cell.seq.store(seq + 2, std::memory_order_release);
+                notify = !cell.queued.exchange(true, std::memory_order_acq_rel);
+                return index;
+            }
+            return NO_CELL;
         }
         
-        Message<T> typed_msg(message, sender_id);
-        typed_msg.mark_sent();
+        // 생산자: 표지 push 실패 - 값은 cell에 남고 소비자가 다음 방문 끝에 표지를 다시 넣음 (requeue)
+        void cancel_notice(uint8_t index) noexcept {
+            cells_[index].queued.store(false, std::memory_order_release);
+            requeue_.store(true, std::memory_order_release);
+        }
         
-        constexpr uint16_t msg_size = sizeof(Message<T>);
-        static_assert(msg_size <= MINI_SO_MAX_MESSAGE_SIZE, "Message too large");
+        // 표지 없이 cell에 남은 값이 있을 수 있음 (Agent::has_messages가 방문을 유지)
+        bool requeue_pending() const noexcept {
+            if constexpr (CELLS > 0) {
+                return requeue_.load(std::memory_order_acquire);
+            } else {
+                return false;
+            }
+        }
         
-        return agents_[target_id]->message_queue_.push(typed_msg, msg_size) == MessageQueue::Result::SUCCESS;
-    }
-    
-    template<typename T>
-    void broadcast_message(AgentId sender_id, const T& message) noexcept {
-        for (std::size_t i = 0; i < agent_count_; ++i) {
-            if (agents_[i] && i != sender_id) {
-                send_message(sender_id, static_cast<AgentId>(i), message);
+        // 소비자: 전달하지 않은 값이 있고 표지가 없는 cell마다 push(cell)로 표지를 다시 넣음 (실패하면 다음 방문)
+        template<typename Push>
+        void requeue(Push&& push) noexcept {
+            if (!requeue_.exchange(false, std::memory_order_acq_rel)) return;
+            for (uint8_t index = 0; index < CELLS; ++index) {
+                Cell& cell = cells_[index];
+                if (cell.type_id.load(std::memory_order_acquire) == INVALID_MESSAGE_ID ||
+                    cell.seq.load(std::memory_order_acquire) == cell.delivered) {
+                    continue;
+                }
+                if (!cell.queued.exchange(true, std::memory_order_acq_rel) && !push(index)) [[unlikely]] {
+                    cancel_notice(index);
+                }
             }
         }
-    }
-    
-    // Phase 2.2: 풀링된 메시지 전송 (Zero-allocation)
-    template<typename T>
-    bool send_pooled_message(AgentId sender_id, AgentId target_id, const T& message) noexcept {
-        if (target_id >= agent_count_ || !agents_[target_id]) [[unlikely]] {
+        
+        // type_id의 cell에 아직 전달하지 않은 값이 있음 (표지 대기 중, 생산자가 쓰는 중, 또는 표지를 다시 넣어야 함)
+        bool pending(MessageId type_id) const noexcept {
+            for (const Cell& cell : cells_) {
+                if (cell.type_id.load(std::memory_order_acquire) != type_id) continue;
+                return cell.queued.load(std::memory_order_acquire) || (cell.seq.load(std::memory_order_acquire) & 1) ||
+                       requeue_.load(std::memory_order_acquire);
+            }
             return false;
         }
         
-        // 풀에서 메시지 할당
-        auto pooled_msg = PooledMessage<T>::create(message, sender_id);
-        pooled_msg->mark_sent();
-        
-        constexpr uint16_t msg_size = sizeof(Message<T>);
-        static_assert(msg_size <= MINI_SO_MAX_MESSAGE_SIZE, "Message too large");
-        
-        return agents_[target_id]->message_queue_.push(pooled_msg.get(), msg_size) == MessageQueue::Result::SUCCESS;
-    }
-    
-    template<typename T>
-    void broadcast_pooled_message(AgentId sender_id, const T& message) noexcept {
-        for (std::size_t i = 0; i < agent_count_; ++i) {
-            if (agents_[i] && i != sender_id) {
-                send_pooled_message(sender_id, static_cast<AgentId>(i), message);
+        // 소비자: 표지면 cell의 현재 값을 buffer로 꺼내 반환 (이미 전달한 값이거나 쓰는 중이면 nullptr),
+        //         표지가 아니면 msg 그대로
+        const MessageBase* resolve(const MessageBase& msg, uint16_t& size, Buffer& buffer) noexcept {
+            if constexpr (CELLS > 0) {
+                if (msg.type_id() == MessageTypeRegistry<LatestNotice>::id()) [[unlikely]] {
+                    const uint8_t index = static_cast<const Message<LatestNotice>&>(msg).data.cell;
+                    return index < CELLS ? load(cells_[index], size, buffer) : nullptr;
+                }
             }
+            return &msg;
         }
-    }
-    
-    bool process_one_message() noexcept {
-        for (std::size_t i = 0; i < agent_count_; ++i) {
-            if (agents_[i] && !agents_[i]->message_queue_.empty()) {
-                agents_[i]->process_messages();
-                return true;
+        
+        // Agent 해제 시 (소비자 방문이 없는 상태)
+        void reset() noexcept {
+            for (Cell& cell : cells_) {
+                cell.type_id.store(INVALID_MESSAGE_ID, std::memory_order_relaxed);
+                cell.queued.store(false, std::memory_order_relaxed);
+                cell.delivered = cell.seq.load(std::memory_order_relaxed);
             }
+            requeue_.store(false, std::memory_order_relaxed);
         }
-        return false;
-    }
-    
-    void process_all_messages() noexcept {
-        bool has_messages = true;
-        while (has_messages) {
-            has_messages = false;
-            for (std::size_t i = 0; i < agent_count_; ++i) {
-                if (agents_[i] && !agents_[i]->message_queue_.empty()) {
-                    agents_[i]->process_messages();
-                    has_messages = true;
+        
+    private:
+        static constexpr std::size_t WORDS = BYTES / 4;
+        static constexpr int READ_ATTEMPTS = 4;
+        
+        // payload는 relaxed 원자 워드 - seqlock 재시도 구간의 동시 읽기/쓰기가 데이터 경합이 되지 않도록
+        struct Cell {
+            std::atomic<MessageId> type_id{INVALID_MESSAGE_ID};
+            std::atomic<uint16_t> size{0};
+            std::atomic<uint32_t> seq{0};        // 홀수 = 생산자가 쓰는 중
+            std::atomic<bool> queued{false};     // 메일박스에 표지가 있음
+            uint32_t delivered = 0;              // 소비자 전용: 마지막으로 전달한 seq
+            std::array<std::atomic<uint32_t>, WORDS> words{};
+        };
+        
+        // 쓰기와 겹치면 몇 번 다시 읽고, 그래도 겹치면 포기 - 겹친 생산자가 넣는 새 표지로 다시 전달됨
+        const MessageBase* load(Cell& cell, uint16_t& size, Buffer& buffer) noexcept {
+            cell.queued.exchange(false, std::memory_order_acq_rel);  // 이후 갱신은 새 표지를 넣음
+            for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+                const uint32_t seq = cell.seq.load(std::memory_order_acquire);
+                if (seq == cell.delivered) {
+                    return nullptr;  // 이미 전달한 값 (늦게 처리된 표지)
+                }
+                if (seq & 1) [[unlikely]] {
+                    continue;
                 }
+                uint32_t words[WORDS];
+                for (std::size_t i = 0; i < WORDS; ++i) {
+                    words[i] = cell.words[i].load(std::memory_order_relaxed);
+                }
+                size = cell.size.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (cell.seq.load(std::memory_order_relaxed) != seq) [[unlikely]] {
+                    continue;
+                }
+                cell.delivered = seq;
+                std::memcpy(buffer.bytes, words, sizeof(words));
+                return reinterpret_cast<const MessageBase*>(buffer.bytes);
             }
+            return nullptr;
         }
-    }
+        
+        std::array<Cell, CELLS> cells_{};
+        std::atomic<bool> requeue_{false};   // 표지 push가 실패한 cell이 있음
+    };
+}
+
+namespace detail {
+    // 타입별 메일박스의 메인 메일박스 대기 표지 - 소비 시 해당 TypedMailbox를 비움
+    struct TypedNotice {
+        uint8_t box;
+    };
     
-    void run() noexcept {
-        process_all_messages();
-    }
+    template<typename P>
+    struct MemberPointer;
+    template<typename C, typename M>
+    struct MemberPointer<M C::*> {
+        using owner = C;
+        using type = M;
+    };
     
-    bool initialize() noexcept {
-        if (env_initialized_) {
-            return true;
+    // 타입이 다른 멤버 포인터끼리도 비교 가능한 ==
+    template<auto A, auto B>
+    constexpr bool same_member() noexcept {
+        if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+            return A == B;
+        } else {
+            return false;
         }
-        env_initialized_ = true;
-        return true;
     }
     
-    constexpr std::size_t agent_count() const noexcept { return agent_count_; }
-    
-    std::size_t total_pending_messages() const noexcept {
-        std::size_t total = 0;
-        for (std::size_t i = 0; i < agent_count_; ++i) {
-            if (agents_[i]) {
-                total += agents_[i]->message_queue_.size();
-            }
+    // TypedMailbox의 타입 비의존 부분: MPSC 슬롯 링 제어 + Agent 연결.
+    // 슬롯 i의 seq = 게시된 위치 + 1 (생산자가 작성을 마치면 release), 소비자는 head부터 연속 게시분만 읽음
+    class TypedMailboxBase {
+    public:
+        using Handler = bool (*)(void* context, const MessageBase& msg) noexcept;
+        
+        TypedMailboxBase(const TypedMailboxBase&) = delete;
+        TypedMailboxBase& operator=(const TypedMailboxBase&) = delete;
+        
+        constexpr MessageId type_id() const noexcept { return type_id_; }
+        constexpr uint8_t index() const noexcept { return index_; }
+        constexpr std::size_t capacity() const noexcept { return mask_ + 1; }
+        std::size_t size() const noexcept {
+            const uint32_t head = head_.load(std::memory_order_acquire);
+            return tail_.load(std::memory_order_acquire) - head;
         }
-        return total;
-    }
-    
-private:
-    AgentId register_agent_impl(Agent* agent) noexcept {
-        if (!agent) [[unlikely]] {
-            return INVALID_AGENT_ID;
+        bool empty() const noexcept { return size() == 0; }
+        
+        // 생산자: Message<T> 하나를 헤더/필드 열로 나눠 저장. 가득 차면 false
+        bool push(const MessageBase& msg) noexcept { return push_(*this, msg); }
+        // 생산자: 메인 메일박스에 표지를 새로 넣어야 하면 true (이미 대기 중이면 false)
+        bool claim_notice() noexcept { return !notice_.exchange(true, std::memory_order_acq_rel); }
+        void cancel_notice() noexcept { notice_.store(false, std::memory_order_release); }
+        
+        // 소비자: 최대 max개를 Message<T>로 다시 조립해 handler로 전달 (열 단위 처리가 없는 Agent의 기본 경로)
+        std::size_t dispatch(std::size_t max_count, Handler handler, void* context) noexcept {
+            return dispatch_(*this, max_count, handler, context);
         }
         
-        if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
-            return INVALID_AGENT_ID;
+        // 소비자: 게시된 메시지를 모두 버림 (Agent 해제 시)
+        void discard() noexcept {
+            notice_.store(false, std::memory_order_relaxed);
+            release(ready(capacity()));
         }
         
-        if (agent_count_ >= MINI_SO_MAX_AGENTS) [[unlikely]] {
-            xSemaphoreGive(mutex_);
-            return INVALID_AGENT_ID;
+        // Agent::attach_mailbox 전용: 소유 Agent 목록에 연결 (한 Agent에만)
+        bool link(uint8_t index, TypedMailboxBase* next) noexcept {
+            if (linked_) return false;
+            linked_ = true;
+            index_ = index;
+            next_ = next;
+            return true;
         }
+        TypedMailboxBase* next() const noexcept { return next_; }
         
-        AgentId id = static_cast<AgentId>(agent_count_);
-        agents_[agent_count_] = agent;
-        agent_count_++;
+    protected:
+        using PushFn = bool (*)(TypedMailboxBase& box, const MessageBase& msg) noexcept;
+        using DispatchFn = std::size_t (*)(TypedMailboxBase& box, std::size_t max_count, Handler handler,
+                                           void* context) noexcept;
         
-        xSemaphoreGive(mutex_);
+        // seq: capacity개의 슬롯 게시 번호 (파생 클래스 저장소)
+        TypedMailboxBase(MessageId type_id, std::atomic<uint32_t>* seq, uint32_t capacity, PushFn push,
+                         DispatchFn dispatch) noexcept
+            : type_id_(type_id), mask_(capacity - 1), seq_(seq), push_(push), dispatch_(dispatch) {}
         
-        agent->initialize(id);
-        return id;
-    }
-};
+        // 생산자: 빈 슬롯 위치 예약
+        bool reserve(uint32_t& pos) noexcept {
+            pos = tail_.load(std::memory_order_relaxed);
+            do {
+                if (pos - head_.load(std::memory_order_acquire) > mask_) [[unlikely]] {
+                    return false;
+                }
+            } while (!tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+            return true;
+        }
+        void commit(uint32_t pos) noexcept { seq_[pos & mask_].store(pos + 1, std::memory_order_release); }
+        
+        // 소비자: head부터 게시 완료된 연속 메시지 수 (최대 max_count)
+        uint32_t ready(std::size_t max_count) const noexcept {
+            const uint32_t head = head_.load(std::memory_order_relaxed);
+            uint32_t count = 0;
+            while (count < max_count && seq_[(head + count) & mask_].load(std::memory_order_acquire) == head + count + 1) {
+                count++;
+            }
+            return count;
+        }
+        void release(uint32_t count) noexcept { head_.fetch_add(count, std::memory_order_release); }
+        constexpr uint32_t slot(uint32_t pos) const noexcept { return pos & mask_; }
+        uint32_t head() const noexcept { return head_.load(std::memory_order_relaxed); }
+        
+    private:
+        MessageId type_id_;
+        uint8_t index_ = 0;                  // 소유 Agent 안의 번호 (TypedNotice::box)
+        bool linked_ = false;
+        uint32_t mask_;
+        std::atomic<uint32_t>* seq_;
+        PushFn push_;
+        DispatchFn dispatch_;
+        TypedMailboxBase* next_ = nullptr;   // 소유 Agent의 목록
+        std::atomic<bool> notice_{false};    // 메인 메일박스에 표지가 있음
+        alignas(64) std::atomic<uint32_t> head_{0};
+        alignas(64) std::atomic<uint32_t> tail_{0};
+    };
+}
 
 // ============================================================================
-// Environment - Phase 3: Zero-overhead 환경 관리 (SIOF-Safe)
+// TypedMailbox - 한 메시지 타입 전용 SoA 메일박스 (opt-in)
 // ============================================================================
-class Environment {
-private:
-    alignas(64) std::array<Agent*, MINI_SO_MAX_AGENTS> agents_;
-    std::size_t agent_count_ = 0;
-    SemaphoreHandle_t mutex_;
-    
-    // Phase 3: 성능 통계 (조건부 컴파일)
-#if MINI_SO_ENABLE_METRICS
-    uint64_t total_messages_sent_ = 0;     // 64-bit for long-term operation
-    uint64_t total_messages_processed_ = 0; // 64-bit for long-term operation
-    uint32_t max_processing_time_us_ = 0;
-#endif
+// 헤더와 payload를 슬롯별 레코드가 아니라 각각의 연속 배열에 저장. Fields를 주면 T의 필드마다 열을 두며,
+// 필드 크기 합이 sizeof(T)와 같아야 함 (모든 필드를 나열, padding 없음). Fields가 없으면 T 배열 하나.
+// Agent::attach_mailbox로 연결하면 해당 타입의 send/publish/broadcast/타이머 전송이 이 메일박스로 들어오고,
+// 메인 메일박스에는 대기 표지 하나만 남음 (같은 Agent의 다른 타입 메시지와의 FIFO 순서는 보장하지 않음).
+// 가득 차면 새 메시지를 버림 (DROPPED). 풀 메시지와 send_batch는 메인 메일박스를 그대로 사용
+//
+//     TypedMailbox<SensorReading, 64, &SensorReading::temperature, &SensorReading::humidity,
+//                  &SensorReading::pressure, &SensorReading::timestamp> readings_;
+//
+//     std::size_t handle_typed(detail::TypedMailboxBase& box, std::size_t max_count) noexcept override {
+//         if (&box != &readings_) return Agent::handle_typed(box, max_count);
+//         return readings_.consume(max_count, [this](const auto& run) noexcept {
+//             update(dsp::min_max(run.template column<&SensorReading::temperature>()));
+//         });
+//     }
+template<typename T, std::size_t N, auto... Fields>
+class TypedMailbox : public detail::TypedMailboxBase {
+    static_assert(std::is_trivially_copyable_v<T>, "TypedMailbox payloads are copied field by field");
+    static_assert((N & (N - 1)) == 0 && N >= 2 && N <= 0x8000, "TypedMailbox capacity must be a power of two");
+    static_assert((std::is_same_v<typename detail::MemberPointer<decltype(Fields)>::owner, T> && ...),
+                  "TypedMailbox fields must be members of T");
+    static_assert(sizeof...(Fields) == 0 ||
+                  (std::size_t{0} + ... + sizeof(typename detail::MemberPointer<decltype(Fields)>::type)) == sizeof(T),
+                  "TypedMailbox fields must cover every byte of T (list all fields, no padding)");
+    static_assert(sizeof...(Fields) == 0 || std::is_default_constructible_v<T>,
+                  "TypedMailbox reassembles T from its field columns");
     
-    Environment() noexcept;
-    ~Environment() noexcept;
+    template<auto Field>
+    using FieldType = typename detail::MemberPointer<decltype(Field)>::type;
     
 public:
-    // SIOF-Safe Pure Meyers' Singleton
-    static Environment& instance() noexcept {
-        static Environment env;
-        return env;
+    // slots_는 기반 클래스보다 늦게 생성되지만 주소만 넘김 (생산자는 연결 후에만 접근)
+    TypedMailbox() noexcept
+        : TypedMailboxBase(MESSAGE_TYPE_ID(T), slots_, static_cast<uint32_t>(N), &push_message, &dispatch_messages) {}
+    
+    // 연속 구간 하나 (링 끝에서 나뉘면 consume이 두 번 호출)
+    class Run {
+    public:
+        constexpr std::size_t size() const noexcept { return count_; }
+        Span<const MessageHeader> headers() const noexcept { return Span<const MessageHeader>(&box_.headers_[first_], count_); }
+        
+        // Fields가 없을 때: payload 배열
+        Span<const T> payloads() const noexcept {
+            static_assert(sizeof...(Fields) == 0, "Use column<&T::field>() on a field-split TypedMailbox");
+            return Span<const T>(&box_.payloads_[first_], count_);
+        }
+        
+        template<auto Field>
+        Span<const FieldType<Field>> column() const noexcept {
+            static_assert(index_of<Field>() < sizeof...(Fields), "Field is not a column of this TypedMailbox");
+            return Span<const FieldType<Field>>(&std::get<index_of<Field>()>(box_.columns_)[first_], count_);
+        }
+        
+        // i번째 메시지 payload (Fields가 있으면 열에서 조립)
+        T operator[](std::size_t i) const noexcept { return box_.load(first_ + static_cast<uint32_t>(i)); }
+        
+    private:
+        friend class TypedMailbox;
+        constexpr Run(const TypedMailbox& box, uint32_t first, uint32_t count) noexcept
+            : box_(box), first_(first), count_(count) {}
+        
+        const TypedMailbox& box_;
+        uint32_t first_;
+        uint32_t count_;
+    };
+    
+    // 소비자 (소유 Agent의 handle_typed 안): 최대 max_count개를 연속 구간 단위로 fn(const Run&)에 전달한 뒤 해제.
+    // 반환: 소비한 메시지 수
+    template<typename Fn>
+    std::size_t consume(std::size_t max_count, Fn&& fn) noexcept {
+        const uint32_t count = ready(max_count);
+        const uint32_t first = slot(head());
+        const uint32_t until_end = static_cast<uint32_t>(N) - first;
+        if (count > 0) {
+            fn(Run(*this, first, count < until_end ? count : until_end));
+        }
+        if (count > until_end) {
+            fn(Run(*this, 0, count - until_end));
+        }
+        release(count);
+        return count;
     }
     
-    // SIOF-Safe 초기화
-    bool initialize() noexcept;
+private:
+    template<auto Field>
+    static constexpr std::size_t index_of() noexcept {
+        std::size_t index = 0;
+        bool found = false;
+        ((found = found || detail::same_member<Field, Fields>(), index += found ? 0 : 1), ...);
+        return index;
+    }
     
-    // Phase 3: noexcept Agent 관리
-    AgentId register_agent(Agent* agent) noexcept;
-    void unregister_agent(AgentId id) noexcept;
-    Agent* get_agent(AgentId id) noexcept;
+    void store(uint32_t index, const T& data) noexcept {
+        if constexpr (sizeof...(Fields) == 0) {
+            payloads_[index] = data;
+        } else {
+            store_fields(index, data, std::index_sequence_for<decltype(Fields)...>{});
+        }
+    }
     
-    // Phase 3: Zero-overhead 메시지 라우팅
-    template<typename T>
-    bool send_message(AgentId sender_id, AgentId target_id, const T& message) noexcept;
+    T load(uint32_t index) const noexcept {
+        if constexpr (sizeof...(Fields) == 0) {
+            return payloads_[index];
+        } else {
+            return load_fields(index, std::index_sequence_for<decltype(Fields)...>{});
+        }
+    }
     
-    template<typename T>
-    void broadcast_message(AgentId sender_id, const T& message) noexcept;
+    template<std::size_t... Is>
+    void store_fields(uint32_t index, const T& data, std::index_sequence<Is...>) noexcept {
+        ((std::get<Is>(columns_)[index] = data.*Fields), ...);
+    }
     
-    // Phase 2.2: 풀링된 메시지 전송 (Zero-allocation)
-    template<typename T>
-    bool send_pooled_message(AgentId sender_id, AgentId target_id, const T& message) noexcept {
-        if (target_id >= agent_count_ || !agents_[target_id]) [[unlikely]] {
+    template<std::size_t... Is>
+    T load_fields(uint32_t index, std::index_sequence<Is...>) const noexcept {
+        T data;
+        ((data.*Fields = std::get<Is>(columns_)[index]), ...);
+        return data;
+    }
+    
+    static bool push_message(TypedMailboxBase& base, const MessageBase& msg) noexcept {
+        TypedMailbox& box = static_cast<TypedMailbox&>(base);
+        uint32_t pos = 0;
+        if (!box.reserve(pos)) [[unlikely]] {
             return false;
         }
-        
-        // 풀에서 메시지 할당
-        auto pooled_msg = PooledMessage<T>::create(message, sender_id);
-        pooled_msg->mark_sent();
-        
-        constexpr uint16_t msg_size = sizeof(Message<T>);
-        static_assert(msg_size <= MINI_SO_MAX_MESSAGE_SIZE, "Message too large");
-        
-        return agents_[target_id]->message_queue_.push(pooled_msg.get(), msg_size) == MessageQueue::Result::SUCCESS;
+        const uint32_t index = box.slot(pos);
+        box.headers_[index] = msg.header;
+        box.store(index, static_cast<const Message<T>&>(msg).data);
+        box.commit(pos);
+        return true;
     }
     
-    template<typename T>
-    void broadcast_pooled_message(AgentId sender_id, const T& message) noexcept {
-        for (std::size_t i = 0; i < agent_count_; ++i) {
-            if (agents_[i] && i != sender_id) {
-                send_pooled_message(sender_id, static_cast<AgentId>(i), message);
+    static std::size_t dispatch_messages(TypedMailboxBase& base, std::size_t max_count, Handler handler,
+                                         void* context) noexcept {
+        TypedMailbox& box = static_cast<TypedMailbox&>(base);
+        return box.consume(max_count, [handler, context](const Run& run) noexcept {
+            for (std::size_t i = 0; i < run.size(); ++i) {
+                Message<T> msg(run[i]);
+                msg.header = run.headers()[i];
+                handler(context, msg);
             }
-        }
+        });
     }
     
-    // Phase 3: 최적화된 시스템 실행
-    bool process_one_message() noexcept;
-    void process_all_messages() noexcept;
-    void run() noexcept;  // 통합된 고성능 루프
-    
-    // Phase 3: constexpr 상태 조회
-    constexpr std::size_t agent_count() const noexcept { return agent_count_; }
-    std::size_t total_pending_messages() const noexcept;
+    template<auto Field>
+    struct Column {
+        alignas(16) std::array<FieldType<Field>, N> values;
+        FieldType<Field>& operator[](std::size_t i) noexcept { return values[i]; }
+        const FieldType<Field>& operator[](std::size_t i) const noexcept { return values[i]; }
+    };
     
-    // Phase 3: 공개 메트릭 접근 (모니터링용)
-#if MINI_SO_ENABLE_METRICS
-    constexpr uint64_t total_messages_sent() const noexcept { return total_messages_sent_; }
-    constexpr uint64_t total_messages_processed() const noexcept { return total_messages_processed_; }
-    constexpr uint32_t max_processing_time_us() const noexcept { return max_processing_time_us_; }
-#endif
-
-private:
-    // static 포인터 제거 (InitializationGuard가 상태 관리)
+    alignas(16) MessageHeader headers_[N] = {};
+    std::conditional_t<sizeof...(Fields) == 0, std::array<T, N>, std::array<uint8_t, 0>> payloads_{};
+    std::tuple<Column<Fields>...> columns_{};
+    std::atomic<uint32_t> slots_[N] = {};
 };
 
-// ============================================================================
-// Emergency System Recovery - 현대적 Fail-Safe 메커니즘
-// ============================================================================
-namespace emergency {
-    // 크리티컬 실패 원인
-    enum class CriticalFailure : uint32_t {
-        MUTEX_CREATION_FAILED = 0x1001,
-        MEMORY_EXHAUSTION = 0x1002,
-        HEAP_CORRUPTION = 0x1003,
-        FREERTOS_INIT_FAILED = 0x1004,
-        SYSTEM_AGENT_FAILURE = 0x1005
+namespace detail {
+    template<typename T>
+    struct Identity {
+        using type = T;
     };
     
-    // 실패 컨텍스트 정보
-    struct FailureContext {
-        CriticalFailure reason;
-        const char* file;
-        int line;
-        const char* function;
-        TimePoint timestamp;
-        uint32_t heap_free_bytes;
-        uint32_t stack_usage;
-        char additional_info[64];
+    template<typename T>
+    using identity_t = typename Identity<T>::type;
+    
+    // 수신 필터 테이블: Agent가 타입별로 등록한 술어를 발신자 쪽 전송 경로가 평가 -
+    // 통과하지 못한 메시지는 메일박스 레코드/풀 슬롯을 쓰지 않고 핸들러도 깨우지 않음.
+    // 필터가 없는 Agent의 비용은 count load 한 번. 항목 변경은 이 Agent로 전송이 없을 때 (보통 등록 전후 설정 단계)
+    class ReceiveFilters {
+    public:
+        static constexpr std::size_t CAPACITY = MINI_SO_MAX_RECEIVE_FILTERS;
         
-        FailureContext() noexcept 
-            : reason(CriticalFailure::MUTEX_CREATION_FAILED)
-            , file(nullptr)
-            , line(0)
-            , function(nullptr)
-            , timestamp(0)
-            , heap_free_bytes(0)
-            , stack_usage(0) {
-            additional_info[0] = '\0';
+        struct Entry;
+        using Test = bool (*)(const Entry& entry, const void* data, AgentId sender) noexcept;
+        
+        struct Entry {
+            MessageId type = INVALID_MESSAGE_ID;
+            Test test = nullptr;
+            void (*predicate)() = nullptr;  // 타입 소거된 사용자 술어 (test가 원래 타입으로 복원)
+            const void* context = nullptr;
+        };
+        
+        bool active() const noexcept {
+            if constexpr (CAPACITY == 0) {
+                return false;
+            } else {
+                return count_.load(std::memory_order_acquire) != 0;
+            }
         }
-    };
+        
+        const Entry* find(MessageId type) const noexcept {
+            const std::size_t count = count_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (entries_[i].type == type) return &entries_[i];
+            }
+            return nullptr;
+        }
+        
+        // 같은 타입이 있으면 교체. false: 테이블 가득 참
+        bool set(const Entry& entry) noexcept {
+            const std::size_t count = count_.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (entries_[i].type == entry.type) {
+                    entries_[i] = entry;
+                    return true;
+                }
+            }
+            if (count >= CAPACITY) [[unlikely]] {
+                return false;
+            }
+            entries_[count] = entry;
+            count_.store(static_cast<uint8_t>(count + 1), std::memory_order_release);
+            return true;
+        }
+        
+        void remove(MessageId type) noexcept {
+            const std::size_t count = count_.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (entries_[i].type == type) {
+                    entries_[i] = entries_[count - 1];
+                    count_.store(static_cast<uint8_t>(count - 1), std::memory_order_release);
+                    return;
+                }
+            }
+        }
+        
+        void clear() noexcept { count_.store(0, std::memory_order_release); }
+        
+        // 술어 평가 - 거부하면 filtered 카운터 증가
+        bool accepts(const Entry& entry, const void* data, AgentId sender) noexcept {
+            if (entry.test(entry, data, sender)) [[likely]] {
+                return true;
+            }
+            filtered_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        
+        uint32_t filtered() const noexcept { return filtered_.load(std::memory_order_relaxed); }
+        void reset_filtered() noexcept { filtered_.store(0, std::memory_order_relaxed); }
     
-    // Emergency mode 상태
-    struct EmergencyState {
-        bool is_active;
-        TimePoint entered_time;
-        uint32_t restart_countdown_ms;
-        bool restart_scheduled;
-        FailureContext last_failure;
+    private:
+        static_assert(CAPACITY <= 0xFF, "Too many receive filters per agent");
         
-        EmergencyState() noexcept 
-            : is_active(false)
-            , entered_time(0)
-            , restart_countdown_ms(0)
-            , restart_scheduled(false) {}
+        std::array<Entry, CAPACITY> entries_{};
+        std::atomic<uint8_t> count_{0};
+        std::atomic<uint32_t> filtered_{0};
     };
     
-    // 실패 컨텍스트 저장 (Flash 메모리 등에 저장)
-    void save_failure_context(CriticalFailure reason, const char* file, int line, const char* function = nullptr) noexcept;
-    
-    // Emergency mode 진입
-    void enter_emergency_mode() noexcept;
-    
-    // 제어된 재시작 스케줄링
-    void schedule_controlled_restart(uint32_t delay_ms) noexcept;
+    // 토큰 버킷 - 밀리토큰 단위 (rate 토큰/초 = 밀리토큰/ms), 시각은 now() 밀리초
+    // 여러 발신 태스크가 잠금 없이 같은 버킷을 씀: 경과 구간은 stamp CAS에 성공한 발신자만 보충하고,
+    // 토큰은 CAS 루프로 하나씩 꺼냄 - 경합해도 한도를 넘기지 않고 토큰을 잃지 않음 (32비트 원자만 사용)
+    class TokenBucket {
+    public:
+        static constexpr uint32_t SCALE = 1000;
+        
+        void configure(const RateLimit& limit, TimePoint at) noexcept {
+            const uint32_t capacity = limit.burst < UINT32_MAX / SCALE ? limit.burst * SCALE : UINT32_MAX / SCALE * SCALE;
+            rate_.store(limit.rate_per_s, std::memory_order_relaxed);
+            capacity_.store(capacity, std::memory_order_relaxed);
+            tokens_.store(capacity, std::memory_order_relaxed);
+            stamp_.store(at, std::memory_order_relaxed);
+        }
+        
+        bool take(TimePoint at) noexcept {
+            TimePoint stamp = stamp_.load(std::memory_order_relaxed);
+            // 다른 발신자가 더 늦은 시각으로 이미 보충했으면 음수 - 보충 없음
+            const int32_t elapsed = static_cast<int32_t>(at - stamp);
+            if (elapsed > 0 && stamp_.compare_exchange_strong(stamp, at, std::memory_order_relaxed)) {
+                add(static_cast<uint64_t>(elapsed) * rate_.load(std::memory_order_relaxed));
+            }
+            uint32_t tokens = tokens_.load(std::memory_order_relaxed);
+            do {
+                if (tokens < SCALE) return false;
+            } while (!tokens_.compare_exchange_weak(tokens, tokens - SCALE, std::memory_order_relaxed));
+            return true;
+        }
+        
+        // 다른 한도가 거부한 메시지의 토큰 반환
+        void refund() noexcept { add(SCALE); }
     
-    // Emergency mode에서 최소 기능 실행
-    void run_emergency_loop() noexcept;
+    private:
+        void add(uint64_t amount) noexcept {
+            const uint32_t capacity = capacity_.load(std::memory_order_relaxed);
+            uint32_t tokens = tokens_.load(std::memory_order_relaxed);
+            uint32_t next;
+            do {
+                next = tokens >= capacity || amount >= capacity - tokens ? capacity : tokens + static_cast<uint32_t>(amount);
+            } while (!tokens_.compare_exchange_weak(tokens, next, std::memory_order_relaxed));
+        }
+        
+        std::atomic<uint32_t> rate_{0};
+        std::atomic<uint32_t> capacity_{0};
+        std::atomic<uint32_t> tokens_{0};
+        std::atomic<TimePoint> stamp_{0};
+    };
     
-    // 시스템 상태 체크
-    bool is_emergency_mode() noexcept;
+    // 토큰 버킷 한도 표 (Environment 소유) - 메일박스에 넣기 전, 수신 필터 다음에 발신자 쪽에서 평가.
+    // 키의 INVALID_AGENT_ID/INVALID_MESSAGE_ID는 "모두": (sender, *, *) 발신자, (sender, *, T) 발신자+타입,
+    // (*, receiver, T) 구독. 메시지 하나가 일치하는 모든 한도에서 토큰을 하나씩 쓰며, 하나라도 모자라면
+    // 앞서 쓴 토큰을 돌려주고 그 한도의 Throttle로 처리. 한도가 없으면 비용은 count load 한 번.
+    // 항목 변경은 보통 설정 단계에서 (ReceiveFilters와 같은 조건)
+    class RateLimiter {
+    public:
+        static constexpr std::size_t CAPACITY = MINI_SO_MAX_RATE_LIMITS;
+        static constexpr std::size_t NONE = CAPACITY;
+        
+        enum class Verdict : uint8_t { PASS, SHED, COALESCE };
+        
+        bool active() const noexcept {
+            if constexpr (CAPACITY == 0) {
+                return false;
+            } else {
+                return count_.load(std::memory_order_acquire) != 0;
+            }
+        }
+        
+        // 같은 키면 버킷을 새 한도로 다시 채움. false: 표가 가득 참 또는 키가 모두 "모두"
+        bool set(AgentId sender, AgentId receiver, MessageId type, const RateLimit& limit) noexcept {
+            if (sender == INVALID_AGENT_ID && receiver == INVALID_AGENT_ID) [[unlikely]] {
+                return false;
+            }
+            const std::size_t count = count_.load(std::memory_order_relaxed);
+            std::size_t slot = NONE;
+            for (std::size_t i = 0; i < count; ++i) {
+                Entry& entry = entries_[i];
+                const bool used = entry.active.load(std::memory_order_relaxed);
+                if (used && entry.sender == sender && entry.receiver == receiver && entry.type == type) {
+                    entry.action.store(limit.action, std::memory_order_relaxed);
+                    entry.bucket.configure(limit, now());
+                    return true;
+                }
+                if (!used && slot == NONE) slot = i;
+            }
+            if (slot == NONE) {
+                if (count >= CAPACITY) [[unlikely]] return false;
+                slot = count;
+            }
+            Entry& entry = entries_[slot];
+            entry.sender = sender;
+            entry.receiver = receiver;
+            entry.type = type;
+            entry.action.store(limit.action, std::memory_order_relaxed);
+            entry.bucket.configure(limit, now());
+            entry.passed.store(0, std::memory_order_relaxed);
+            entry.shed.store(0, std::memory_order_relaxed);
+            entry.coalesced.store(0, std::memory_order_relaxed);
+            entry.active.store(true, std::memory_order_release);
+            if (slot == count) count_.store(static_cast<uint8_t>(count + 1), std::memory_order_release);
+            return true;
+        }
+        
+        void remove(AgentId sender, AgentId receiver, MessageId type) noexcept {
+            if (Entry* entry = find(sender, receiver, type)) entry->active.store(false, std::memory_order_release);
+        }
+        
+        // 등록 해제된 Agent가 발신자/수신자인 한도 제거
+        void remove_agent(AgentId agent) noexcept {
+            const std::size_t count = count_.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < count; ++i) {
+                Entry& entry = entries_[i];
+                if (entry.sender == agent || entry.receiver == agent) {
+                    entry.active.store(false, std::memory_order_release);
+                }
+            }
+        }
+        
+        // 일치하는 한도마다 토큰 하나. 거부하면 denied에 그 항목 - 호출자가 settle로 결과 집계
+        Verdict admit(AgentId sender, AgentId receiver, MessageId type, std::size_t& denied) noexcept {
+            const std::size_t count = count_.load(std::memory_order_acquire);
+            const TimePoint at = now();
+            std::size_t taken[CAPACITY > 0 ? CAPACITY : 1];
+            std::size_t taken_count = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                Entry& entry = entries_[i];
+                if (!entry.active.load(std::memory_order_acquire) || !entry.matches(sender, receiver, type)) {
+                    continue;
+                }
+                if (!entry.bucket.take(at)) {
+                    for (std::size_t j = 0; j < taken_count; ++j) {
+                        entries_[taken[j]].bucket.refund();
+                    }
+                    denied = i;
+                    return entry.action.load(std::memory_order_relaxed) == Throttle::COALESCE ? Verdict::COALESCE
+                                                                                               : Verdict::SHED;
+                }
+                taken[taken_count++] = i;
+            }
+            for (std::size_t j = 0; j < taken_count; ++j) {
+                Entry& entry = entries_[taken[j]];
+                entry.passed.fetch_add(1, std::memory_order_relaxed);
+            }
+            return Verdict::PASS;
+        }
+        
+        // 거부된 메시지의 최종 처리 (coalesced = 대기 메시지를 교체함)
+        void settle(std::size_t denied, bool coalesced) noexcept {
+            if (denied >= CAPACITY) [[unlikely]] return;
+            (coalesced ? entries_[denied].coalesced : entries_[denied].shed).fetch_add(1, std::memory_order_relaxed);
+            throttled_.fetch_add(1, std::memory_order_relaxed);
+        }
+        
+        bool stats(AgentId sender, AgentId receiver, MessageId type, ThrottleStats& out) const noexcept {
+            const Entry* entry = const_cast<RateLimiter*>(this)->find(sender, receiver, type);
+            if (!entry) return false;
+            out = ThrottleStats{entry->passed.load(std::memory_order_relaxed), entry->shed.load(std::memory_order_relaxed),
+                                entry->coalesced.load(std::memory_order_relaxed)};
+            return true;
+        }
+        
+        // 모든 한도가 거부한 메시지 수 (shed + coalesced)
+        uint32_t throttled() const noexcept { return throttled_.load(std::memory_order_relaxed); }
     
-    // 마지막 실패 정보 조회
-    const FailureContext& get_last_failure() noexcept;
+    private:
+        static_assert(CAPACITY <= 0xFF, "Too many rate limits per environment");
+        
+        struct Entry {
+            AgentId sender = INVALID_AGENT_ID;
+            AgentId receiver = INVALID_AGENT_ID;
+            MessageId type = INVALID_MESSAGE_ID;
+            std::atomic<Throttle> action{Throttle::SHED};
+            std::atomic<bool> active{false};
+            TokenBucket bucket;
+            std::atomic<uint32_t> passed{0};
+            std::atomic<uint32_t> shed{0};
+            std::atomic<uint32_t> coalesced{0};
+            
+            bool matches(AgentId from, AgentId to, MessageId id) const noexcept {
+                return (sender == INVALID_AGENT_ID || sender == from) && (receiver == INVALID_AGENT_ID || receiver == to) &&
+                       (type == INVALID_MESSAGE_ID || type == id);
+            }
+        };
+        
+        Entry* find(AgentId sender, AgentId receiver, MessageId type) noexcept {
+            const std::size_t count = count_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < count; ++i) {
+                Entry& entry = entries_[i];
+                if (entry.active.load(std::memory_order_acquire) && entry.sender == sender &&
+                    entry.receiver == receiver && entry.type == type) {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+        
+        std::array<Entry, CAPACITY> entries_{};
+        std::atomic<uint8_t> count_{0};
+        std::atomic<uint32_t> throttled_{0};
+    };
     
-    // 실패 로그 출력 (UART 등)
-    void emergency_log_failure(const FailureContext& context) noexcept;
+    // 스케줄링 라운드 시간 목표 (모든 스케줄러 공용, Environment::set_round_budget_us)
+    inline std::atomic<uint32_t>& round_budget_us() noexcept {
+        static std::atomic<uint32_t> budget{MINI_SO_ROUND_BUDGET_US};
+        return budget;
+    }
 }
 
 // ============================================================================
-// System Services - Phase 3: 순수 Agent 기반 시스템 서비스
+// Agent - Phase 3: Zero-overhead Agent 시스템
 // ============================================================================
 
-// Phase 3: 오류 처리 Agent - 순수 메시지 기반
-class ErrorAgent : public Agent {
-private:
-    struct ErrorEntry {
-        system_messages::ErrorReport::Level level;
-        uint32_t error_code;
-        AgentId source_agent;
-        TimePoint timestamp;
-    };
+template<typename T> class UniqueBuffer;
+template<typename T> class BufferRef;
+
+// Agent 로컬 카운터 스냅샷 (32비트 wrap - 누적은 PerformanceAgent가 차이로 계산)
+struct AgentCounters {
+    uint32_t visits;          // process_messages 방문 수 (메시지를 처리한 방문)
+    uint32_t messages;        // 핸들러가 처리한 메시지 수
+    uint32_t busy_time_us;    // 방문에 쓴 시간 합 (hires 클럭)
+    uint32_t max_visit_us;    // 가장 긴 방문
+};
+
+class Router;
+class Environment;
+class System;
+
+class Agent {
+public:
+    // 과부하 반응 카운터 인덱스 (OverloadStats 필드 순서)
+    enum class OverloadEvent : uint8_t { DROPPED, EVICTED, COALESCED, BLOCKED, TIMED_OUT, REDIRECTED, THROTTLED, COUNT };
     
-    std::array<ErrorEntry, 32> error_log_;
-    std::size_t error_count_ = 0;
-    std::size_t next_index_ = 0;  // 순환 버퍼 인덱스
-    system_messages::ErrorReport::Level max_level_ = system_messages::ErrorReport::INFO;
+protected:
+    AgentId id_ = INVALID_AGENT_ID;
+    Environment* environment_ = nullptr;  // 등록한 Environment (등록 전이면 Environment::instance())
+    Priority priority_ = Priority::NORMAL;
+    uint32_t quantum_messages_ = MINI_SO_MESSAGE_QUANTUM;  // 방문당 최대 메시지 수
+    Duration quantum_time_ = 0;                           // 방문당 시간 예산 (마이크로초, 0 = 없음)
+    uint32_t adaptive_max_ = 0;                           // 적응형 quantum 상한 (0 = 고정 quantum)
+    uint32_t message_cost_x16_ = 0;                       // 메시지당 방문 시간 EWMA (1/16 마이크로초)
+    bool batch_receive_ = false;                          // handle_batch 경로 사용
+    OverloadPolicy overload_policy_ = OverloadPolicy::DROP_NEWEST;
+    TickType_t overload_timeout_ = MINI_SO_OVERLOAD_BLOCK_TICKS;
+    Agent* overflow_target_ = nullptr;
+    Router* router_ = nullptr;                            // 이 Agent가 Router면 자신 (전송 시 worker로 대체)
+    std::array<std::atomic<uint32_t>, static_cast<std::size_t>(OverloadEvent::COUNT)> overload_counters_{};
+    std::atomic<uint32_t> deadline_misses_{0};
     
 public:
-    bool handle_message(const MessageBase& msg) noexcept override;
-    void report_error(system_messages::ErrorReport::Level level, uint32_t code, AgentId source) noexcept;
+    MessageQueue message_queue_;
+    detail::LatestCells latest_;  // MessageCoalesce<T> 타입의 최신 값
+    detail::TypedMailboxBase* typed_mailboxes_ = nullptr;  // attach_mailbox로 연결한 타입 전용 메일박스
+    detail::ReceiveFilters receive_filters_;                // 타입별 수신 술어 (발신자 쪽에서 평가)
     
-    constexpr std::size_t error_count() const noexcept { return error_count_; }
-    constexpr std::size_t logged_errors() const noexcept { 
-        // 실제 로그된 에러 수 (최대 32개)
-        return std::min(error_count_, error_log_.size()); 
-    }
-    constexpr system_messages::ErrorReport::Level max_level() const noexcept { return max_level_; }
-    constexpr bool is_healthy() const noexcept { return max_level_ <= system_messages::ErrorReport::WARNING; }
-};
-
-// Phase 3: 성능 모니터링 Agent - 고성능 메트릭
-class PerformanceAgent : public Agent {
-private:
-    uint32_t max_processing_time_us_ = 0;
-    uint64_t total_messages_ = 0;      // 64-bit for long-term operation (584M years)
-    uint32_t cycle_count_ = 0;
-    TimePoint last_report_time_ = 0;
+    Agent() = default;
+    virtual ~Agent() = default;
     
-public:
-    bool handle_message(const MessageBase& msg) noexcept override;
-    void record_performance(uint32_t processing_time_us, uint32_t message_count) noexcept;
+    // Phase 3: 순수 가상 함수 - 성능 최적화
+    virtual bool handle_message(const MessageBase& msg) noexcept = 0;
     
-    constexpr uint32_t max_processing_time_us() const noexcept { return max_processing_time_us_; }
-    constexpr uint64_t total_messages() const noexcept { return total_messages_; }
-    constexpr uint32_t cycle_count() const noexcept { return cycle_count_; }
-};
-
-// Phase 3: Watchdog Agent - 효율적 모니터링
-class WatchdogAgent : public Agent {
-private:
-    struct MonitoredAgent {
-        AgentId agent_id;
-        TimePoint last_heartbeat;
-        Duration timeout_ms;
-        bool active;
-    };
+    // 배치 수신 (set_batch_receive(true) 시): 메일박스의 같은 타입 연속 메시지를
+    // 복사 없이 한 번에 전달. 반환: 처리한 메시지 수. 기본 구현은 handle_message 반복
+    virtual std::size_t handle_batch(Span<const MessageBase* const> batch) noexcept {
+        std::size_t handled = 0;
+        for (const MessageBase* msg : batch) {
+            if (handle_message(*msg)) {
+                handled++;
+            }
+        }
+        return handled;
+    }
     
-    std::array<MonitoredAgent, MINI_SO_MAX_AGENTS> monitored_;
-    std::size_t monitored_count_ = 0;
-    Duration default_timeout_ms_ = 5000;
-    TimePoint last_check_time_ = 0;
+    // 타입 전용 메일박스(TypedMailbox) 수신: 대기 표지 하나당 box에서 최대 max_count개.
+    // 반환: 소비한 메시지 수. 기본 구현은 Message<T>로 다시 조립해 handle_message 반복 -
+    // 열 단위로 처리하려면 재정의해 box.consume 사용
+    virtual std::size_t handle_typed(detail::TypedMailboxBase& box, std::size_t max_count) noexcept {
+        return box.dispatch(max_count, [](void* self, const MessageBase& msg) noexcept {
+            return static_cast<Agent*>(self)->handle_message(msg);
+        }, this);
+    }
     
-public:
-    bool handle_message(const MessageBase& msg) noexcept override;
-    void register_for_monitoring(AgentId agent_id, Duration timeout_ms = 0) noexcept;
-    void check_timeouts() noexcept;
+#if MINI_SO_ENABLE_WARM_RESTART
+    // 웜 재시작 저장 (warm::save): 재보정 없이 되살릴 핵심 상태를 out에 직렬화 - 반환: 쓴 바이트 (0 = 저장 안 함).
+    // 인터럽트를 끈 채 호출될 수 있으므로 블록/전송/할당 금지
+    virtual std::size_t snapshot(void* out, std::size_t capacity) const noexcept {
+        (void)out;
+        (void)capacity;
+        return 0;
+    }
     
-    constexpr bool is_healthy() const noexcept;
-    constexpr std::size_t monitored_count() const noexcept { return monitored_count_; }
-};
-
-// ============================================================================
-// Initialization Order Management - Phase 3: 컴파일 타임 의존성 해결
-// ============================================================================
-namespace detail {
-    // 초기화 상태 추적
-    enum class InitState : uint8_t {
-        NOT_INITIALIZED = 0,
-        INITIALIZING = 1,
-        INITIALIZED = 2,
-        FAILED = 3
-    };
+    // 다음 부팅에서 같은 AgentId로 등록될 때 첫 메시지 전에 호출 - false면 레코드를 버림 (형식/버전 불일치 등)
+    virtual bool restore(const void* data, std::size_t size) noexcept {
+        (void)data;
+        (void)size;
+        return false;
+    }
     
-    // CRTP 기반 초기화 순서 보장
-    template<typename Derived>
-    class InitializationGuard {
-    private:
-        static inline InitState state_ = InitState::NOT_INITIALIZED;
-        static inline uint32_t init_attempt_count_ = 0;
-        
-    public:
-        static bool is_initialized() noexcept {
-            return state_ == InitState::INITIALIZED;
+#endif
+    // T 전용 메일박스 연결 - 등록 전에 호출 (생산자는 목록을 잠금 없이 읽음).
+    // 실패: box가 이미 다른 Agent에 연결됨, 같은 타입이 이미 연결됨, 255개 초과
+    bool attach_mailbox(detail::TypedMailboxBase& box) noexcept {
+        uint8_t count = 0;
+        for (detail::TypedMailboxBase* it = typed_mailboxes_; it; it = it->next()) {
+            if (it->type_id() == box.type_id()) return false;
+            count++;
         }
-        
-        static bool is_failed() noexcept {
-            return state_ == InitState::FAILED;
+        if (count == 0xFF || !box.link(count, typed_mailboxes_)) [[unlikely]] {
+            return false;
         }
+        typed_mailboxes_ = &box;
+        return true;
+    }
+    
+    detail::TypedMailboxBase* typed_mailbox(MessageId type_id) const noexcept {
+        for (detail::TypedMailboxBase* it = typed_mailboxes_; it; it = it->next()) {
+            if (it->type_id() == type_id) return it;
+        }
+        return nullptr;
+    }
+    
+    bool typed_pending() const noexcept {
+        for (const detail::TypedMailboxBase* it = typed_mailboxes_; it; it = it->next()) {
+            if (!it->empty()) return true;
+        }
+        return false;
+    }
+    
+    // 수신 필터: T 메시지를 predicate(data, sender)가 true일 때만 메일박스에 넣음 (같은 T는 교체).
+    // 전송 경로(send/emplace, publish/broadcast, 풀/공유 payload, 타이머, ISR 전달)가 push 전에 평가하므로
+    // 술어는 발신자 문맥(다른 태스크/코어)에서 실행됨 - 짧고 부작용 없이. send_raw 이미지는 평가하지 않음.
+    // false: 필터 테이블 가득 참 (MINI_SO_MAX_RECEIVE_FILTERS)
+    template<typename T>
+    bool set_receive_filter(bool (*predicate)(const T& data, AgentId sender) noexcept) noexcept;
+    
+    // context 참조를 함께 넘기는 술어 (예: 실행 중 바뀌는 임계값) - context는 필터보다 오래 살아야 함
+    template<typename T, typename Context>
+    bool set_receive_filter(bool (*predicate)(const T& data, AgentId sender,
+                                              const detail::identity_t<Context>& context) noexcept,
+                            const Context& context) noexcept;
+    
+    template<typename T>
+    void clear_receive_filter() noexcept { receive_filters_.remove(MESSAGE_TYPE_ID(T)); }
+    
+    // 필터가 거부해 메일박스에 들어가지 않은 메시지 수
+    uint32_t filtered_count() const noexcept { return receive_filters_.filtered(); }
+    
+    // 기한(send_with_deadline)을 넘겨 디스패치된 메시지 수 (DeadlineMiss와 무관하게 모두 집계)
+    uint32_t deadline_misses() const noexcept { return deadline_misses_.load(std::memory_order_relaxed); }
+    void reset_deadline_misses() noexcept { deadline_misses_.store(0, std::memory_order_relaxed); }
+    
+    // Agent 생명주기 - noexcept 보장
+    // env: 전송 경로가 쓸 Environment (nullptr = Environment::instance(), StaticEnvironment 등)
+    void initialize(AgentId id, Environment* env = nullptr) noexcept {
+        id_ = id;
+        environment_ = env;
+    }
+    // 방문 1회: Agent quantum(메시지 수/시간 예산)만큼 처리
+    void process_messages() noexcept { process_messages(quantum_messages_); }
+    // 스케줄러 진입점 (방문당 가상 호출 1회). 기본 구현은 메시지마다 가상 handle_message,
+    // TypedAgent는 정적 디스패치로 재정의
+    virtual void process_messages(uint32_t max_messages) noexcept;
+    // 방문 1회를 주어진 핸들러로 처리 - process_messages는 가상 handle_message/handle_batch를 넘김.
+    // 정적 배선(StaticEnvironment, TypedAgent)은 구체 타입 핸들러를 넘겨 가상 호출 없이 디스패치
+    template<typename OnMessage, typename OnBatch>
+    void process_messages_with(uint32_t max_messages, OnMessage&& on_message, OnBatch&& on_batch) noexcept;
+    
+    // 방문당 처리 한도: 최대 메시지 수, 선택적 시간 예산 (now() 단위)
+    // time_budget_us: 방문당 시간 예산 (고해상도 클럭 마이크로초, 0 = 메시지 수로만 제한)
+    void set_quantum(uint32_t max_messages, Duration time_budget_us = 0) noexcept {
+        quantum_messages_ = max_messages > 0 ? max_messages : 1;
+        quantum_time_ = time_budget_us;
+    }
+    constexpr uint32_t quantum_messages() const noexcept { return quantum_messages_; }
+    constexpr Duration quantum_time() const noexcept { return quantum_time_; }
+    
+    // 적응형 quantum: 방문마다 메시지당 처리 시간(EWMA)을 재고, 방문 예산(라운드 예산 /
+    // MINI_SO_PRIORITY_QUANTUM)에 맞는 메시지 수로 quantum을 조정 - 빠른 핸들러는 크게(처리량),
+    // 느린 핸들러는 작게(다른 Agent 지연 보호). [1, max_messages] 범위, 늘 때는 방문당 최대 2배.
+    // 끄면 현재 quantum이 그대로 고정 quantum으로 남음
+    void set_adaptive_quantum(bool enabled, uint32_t max_messages = MINI_SO_ADAPTIVE_QUANTUM_MAX) noexcept {
+        adaptive_max_ = enabled ? (max_messages > 0 ? max_messages : 1) : 0;
+        message_cost_x16_ = 0;
+    }
+    constexpr bool adaptive_quantum() const noexcept { return adaptive_max_ > 0; }
+    // 적응형 quantum이 측정한 메시지당 처리 시간 (마이크로초, 측정 전/1us 미만이면 0)
+    constexpr uint32_t message_cost_us() const noexcept { return message_cost_x16_ / 16; }
+    
+    void set_batch_receive(bool enabled) noexcept { batch_receive_ = enabled; }
+    
+    // 메일박스가 가득 찼을 때의 반응 (MessageOverload<T>가 지정된 타입은 그 정책 우선)
+    void set_overload_policy(OverloadPolicy policy) noexcept {
+        overload_policy_ = policy == OverloadPolicy::DEFAULT ? OverloadPolicy::DROP_NEWEST : policy;
+    }
+    constexpr OverloadPolicy overload_policy() const noexcept { return overload_policy_; }
+    // BLOCK 정책 대기 한도 (틱). 소비 Agent와 같은 태스크에서 보내면 timeout까지 대기하므로 주의
+    void set_overload_timeout(TickType_t ticks) noexcept { overload_timeout_ = ticks; }
+    constexpr TickType_t overload_timeout() const noexcept { return overload_timeout_; }
+    // REDIRECT 정책 대상 (nullptr = 버림)
+    void set_overflow_target(Agent* target) noexcept { overflow_target_ = target != this ? target : nullptr; }
+    constexpr Agent* overflow_target() const noexcept { return overflow_target_; }
+    
+    OverloadStats overload_stats() const noexcept {
+        auto get = [this](OverloadEvent event) noexcept {
+            return overload_counters_[static_cast<std::size_t>(event)].load(std::memory_order_relaxed);
+        };
+        return OverloadStats{get(OverloadEvent::DROPPED), get(OverloadEvent::EVICTED), get(OverloadEvent::COALESCED),
+                             get(OverloadEvent::BLOCKED), get(OverloadEvent::TIMED_OUT), get(OverloadEvent::REDIRECTED),
+                             get(OverloadEvent::THROTTLED)};
+    }
+    void reset_overload_stats() noexcept {
+        for (auto& counter : overload_counters_) counter.store(0, std::memory_order_relaxed);
+    }
+    
+    // 메일박스 high-water/push 실패/포화 시간 (MINI_SO_MAILBOX_STATS)
+    MailboxStats mailbox_stats() const noexcept { return message_queue_.stats(); }
+    void reset_mailbox_stats() noexcept { message_queue_.reset_stats(); }
+    
+    // 과부하 반응 기록 (생산자 경로, 가득 찬 경우에만)
+    void count_overload(OverloadEvent event) noexcept {
+        overload_counters_[static_cast<std::size_t>(event)].fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // 메일박스를 외부 버퍼로 교체 - 등록 전에 (보통 생성자에서, SizedAgent 사용).
+    // false: 크기가 2의 거듭제곱이 아님, 정렬 불량, 메일박스가 비어 있지 않음
+    bool set_mailbox_storage(uint8_t* buffer, std::size_t bytes) noexcept {
+        return message_queue_.attach_storage(buffer, bytes);
+    }
+    std::size_t mailbox_bytes() const noexcept { return message_queue_.capacity_bytes(); }
+    
+    // 스케줄링 우선순위 클래스 (등록 전후 모두 변경 가능)
+    void set_priority(Priority priority) noexcept {
+        priority_ = priority;
+        message_queue_.set_ready_level(static_cast<std::size_t>(priority));
+    }
+    constexpr Priority priority() const noexcept { return priority_; }
+    
+    // Phase 3: Zero-overhead 메시지 전송
+    template<typename T>
+    bool send_message(AgentId target_id, const T& message) noexcept;
+    
+    // 결과를 구분하는 전송 (Environment::try_send/send_for)
+    template<typename T>
+    SendResult try_send(AgentId target_id, const T& message) noexcept;
+    template<typename T>
+    SendResult send_for(AgentId target_id, const T& message, TickType_t timeout) noexcept;
+    
+    // T를 args로 대상 메일박스 슬롯에 직접 생성 (임시 객체 복사 없음)
+    template<typename T, typename... Args>
+    bool send_emplace(AgentId target_id, Args&&... args) noexcept;
+    
+    template<typename T>
+    void broadcast_message(const T& message) noexcept;
+    
+    // 지연/주기 전송 (Environment 타이머 휠)
+    template<typename T>
+    TimerId send_delayed(AgentId target_id, const T& message, Duration delay) noexcept;
+    
+    template<typename T>
+    TimerId send_periodic(AgentId target_id, const T& message, Duration period) noexcept;
+    
+    bool cancel_timer(TimerId id) noexcept;
+    
+    // 기본 Mbox 구독/발행 (등록 후 호출)
+    template<typename T>
+    bool subscribe() noexcept;
+    
+    template<typename T>
+    void unsubscribe() noexcept;
+    
+    // 필터 구독: set_receive_filter + subscribe (구독 해제해도 필터는 남음)
+    template<typename T>
+    bool subscribe(bool (*predicate)(const T& data, AgentId sender) noexcept) noexcept {
+        return set_receive_filter<T>(predicate) && subscribe<T>();
+    }
+    
+    // 한도 구독: 이 Agent로 오는 T(발행/직접 전송 모두)에 토큰 버킷 + subscribe
+    template<typename T>
+    bool subscribe(const RateLimit& limit) noexcept;
+    
+    // 이 Agent가 보내는 모든 메시지 / T 메시지의 토큰 버킷 한도 (등록 후, Environment::set_rate_limit)
+    bool limit_send(const RateLimit& limit) noexcept;
+    template<typename T>
+    bool limit_send(const RateLimit& limit) noexcept;
+    
+    template<typename T>
+    std::size_t publish(const T& message) noexcept;
+    
+    // 같은 대상에게 여러 메시지를 한 번의 예약으로 전송 - 반환: 전송된 개수
+    template<typename T>
+    std::size_t send_batch(AgentId target_id, Span<const T> messages) noexcept;
+    
+    template<typename T, std::size_t N>
+    std::size_t send_batch(AgentId target_id, const std::array<T, N>& messages) noexcept {
+        return send_batch(target_id, Span<const T>(messages));
+    }
+    
+    // Phase 2.2: 풀링된 메시지 전송 (Agent 편의 메서드)
+    template<typename T>
+    void send_pooled_message(AgentId target_id, const T& message) noexcept;
+    
+    template<typename T>
+    void broadcast_pooled_message(const T& message) noexcept;
+    
+    // 소유권 이전 버퍼 전송/발행 (Environment::send_buffer/publish_buffer)
+    template<typename T>
+    bool send_buffer(AgentId target_id, UniqueBuffer<T>&& buffer) noexcept;
+    
+    template<typename T>
+    std::size_t publish_buffer(UniqueBuffer<T>&& buffer) noexcept;
+    
+    // 기한 메시지 전송 (Environment::send_with_deadline)
+    template<typename T>
+    bool send_with_deadline(AgentId target_id, const T& message, Duration budget_us,
+                            DeadlineMiss on_miss = DeadlineMiss::DELIVER) noexcept;
+    
+    // Phase 3: inline 접근자 (noexcept 보장)
+    // 표지 push가 실패해 값만 남은 타입 전용 메일박스/최신 값 cell도 포함 (다음 방문이 표지를 다시 넣음)
+    bool has_messages() const noexcept {
+        return !message_queue_.empty() || (typed_mailboxes_ && typed_pending()) || latest_.requeue_pending();
+    }
+    constexpr AgentId id() const noexcept { return id_; }
+    // 이 Agent를 등록한 Environment - Agent의 전송/구독/타이머는 모두 여기로 감
+    Environment& environment() const noexcept;
+    // Router면 자신, 아니면 nullptr (전송 경로의 worker 선택용)
+    constexpr Router* as_router() const noexcept { return router_; }
+    
+    // 외부 측정값을 PerformanceAgent에 직접 보고 (디스패치 경로는 로컬 카운터 사용)
+    void report_performance(uint32_t processing_time_us, uint32_t message_count = 1) noexcept;
+    void heartbeat() noexcept;
+    
+#if MINI_SO_ENABLE_METRICS
+    // 로컬 카운터 - 메시지/System 호출 없이 방문 끝에 갱신, 모니터링 측이 끌어감
+    AgentCounters counters() const noexcept {
+        return AgentCounters{
+            counters_.visits.load(std::memory_order_relaxed),
+            counters_.messages.load(std::memory_order_relaxed),
+            counters_.busy_time_us.load(std::memory_order_relaxed),
+            counters_.max_visit_us.load(std::memory_order_relaxed)
+        };
+    }
+#endif
+
+private:
+    friend class OutletBase;  // 직접 호출한 파이프라인 메시지를 방문 카운터에 집계
+    
+#if MINI_SO_ENABLE_METRICS
+    // 쓰기는 Agent를 실행 중인 스레드 하나뿐 (ExclusiveVisitor) - RMW 없이 load+store.
+    // 다른 Agent/모니터 태스크의 읽기와 false sharing이 없도록 캐시 라인 분리
+    struct alignas(64) LocalCounters {
+        std::atomic<uint32_t> visits{0};
+        std::atomic<uint32_t> messages{0};
+        std::atomic<uint32_t> busy_time_us{0};
+        std::atomic<uint32_t> max_visit_us{0};
+    };
+    LocalCounters counters_;
+    
+    void count_visit(uint32_t elapsed_us, uint32_t messages) noexcept {
+        counters_.visits.store(counters_.visits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        counters_.messages.store(counters_.messages.load(std::memory_order_relaxed) + messages, std::memory_order_relaxed);
+        counters_.busy_time_us.store(counters_.busy_time_us.load(std::memory_order_relaxed) + elapsed_us,
+                                     std::memory_order_relaxed);
+        if (elapsed_us > counters_.max_visit_us.load(std::memory_order_relaxed)) {
+            counters_.max_visit_us.store(elapsed_us, std::memory_order_relaxed);
+        }
+    }
+#endif
+    
+    // 기한을 넘긴 메시지 (소비자 문맥): 집계 후 ESCALATE면 ErrorAgent에 보고
+    void count_deadline_miss(const MessageBase& msg, DeadlineMiss miss) noexcept;
+    
+    // 적응형 quantum 갱신 (방문 끝, 소비자 문맥)
+    void adapt_quantum(uint32_t elapsed_us, uint32_t messages) noexcept {
+        const uint32_t sample = (elapsed_us < (UINT32_MAX >> 4) ? elapsed_us << 4 : UINT32_MAX) / messages;
+        message_cost_x16_ = message_cost_x16_ == 0 ? sample
+                          : message_cost_x16_ - (message_cost_x16_ >> 2) + (sample >> 2);  // α = 1/4
         
-        static bool ensure_initialized() noexcept {
-            // 이미 초기화됨
-            if (state_ == InitState::INITIALIZED) [[likely]] {
-                return true;
+        const uint32_t visit_budget = detail::round_budget_us().load(std::memory_order_relaxed) / MINI_SO_PRIORITY_QUANTUM;
+        uint32_t target = message_cost_x16_ > 0
+            ? static_cast<uint32_t>((uint64_t{visit_budget} << 4) / message_cost_x16_)
+            : adaptive_max_;
+        if (target > quantum_messages_ * 2) target = quantum_messages_ * 2;
+        if (target > adaptive_max_) target = adaptive_max_;
+        quantum_messages_ = target > 0 ? target : 1;
+    }
+};
+
+// messages개의 payload_size 바이트 메시지(Message<T> 기준)를 담는 메일박스 크기 - 2의 거듭제곱으로 올림.
+// 레코드 크기가 2의 거듭제곱이 아니면 wrap padding 한 레코드를 더 둠
+constexpr std::size_t mailbox_bytes_for(std::size_t messages, std::size_t payload_size = 24) noexcept {
+    const std::size_t record = MessageQueue::record_bytes(payload_size);
+    const std::size_t needed = (messages + ((record & (record - 1)) != 0 ? 1 : 0)) * record;
+    std::size_t bytes = MessageQueue::RECORD_HEADER_SIZE + MessageQueue::RECORD_ALIGN;
+    while (bytes < needed) bytes <<= 1;
+    return bytes;
+}
+
+// Agent별 메일박스 크기: Base(Agent 또는 TypedAgent/StateAgent 등 Agent 파생)에 MailboxBytes 버퍼를 붙여
+// 메일박스로 사용. 내장 버퍼는 모든 Agent에 있으므로 MINI_SO_MAILBOX_BYTES=0이어야 함 (버퍼가 둘이 되지 않도록) -
+// 나머지 Agent는 MailboxPool 또는 set_mailbox_storage로 저장소를 받음.
+//   class Logger : public mini_so::SizedAgent<mini_so::mailbox_bytes_for(256)> { ... };
+//   class Config : public mini_so::SizedAgent<256> { ... };
+template<std::size_t MailboxBytes, typename Base = Agent>
+class SizedAgent : public Base {
+    static_assert(std::is_base_of_v<Agent, Base>, "SizedAgent base must derive from Agent");
+    static_assert(MailboxBytes != 0 && MINI_SO_MAILBOX_BYTES == 0,  // 인스턴스화할 때만 검사
+                  "SizedAgent needs MINI_SO_MAILBOX_BYTES=0 (otherwise every agent also keeps the unused inline mailbox)");
+    static_assert((MailboxBytes & (MailboxBytes - 1)) == 0 &&
+                  MailboxBytes >= MessageQueue::RECORD_HEADER_SIZE + MessageQueue::RECORD_ALIGN,
+                  "Mailbox size must be a power of two (bytes)");
+    
+public:
+    template<typename... Args>
+    explicit SizedAgent(Args&&... args) noexcept : Base(std::forward<Args>(args)...) {
+        this->set_mailbox_storage(mailbox_, MailboxBytes);
+    }
+    
+private:
+    alignas(64) uint8_t mailbox_[MailboxBytes];
+};
+
+// 등록 시에만 메일박스를 나눠 주는 블록 풀 (Environment::set_mailbox_pool). 저장소가 없는 Agent
+// (MINI_SO_MAILBOX_BYTES=0에 set_mailbox_storage 미호출)는 등록/지연 활성화 때 한 블록을 받고 해제 때 반납.
+// Agent가 수백 개여도 동시에 등록된 수만큼만 메일박스 RAM을 씀. 빈 블록은 원자 비트맵 (잠금 없음)
+class MailboxPoolBase {
+public:
+    MailboxPoolBase(const MailboxPoolBase&) = delete;
+    MailboxPoolBase& operator=(const MailboxPoolBase&) = delete;
+    
+    uint8_t* acquire() noexcept {
+        for (std::size_t w = 0; w < words_; ++w) {
+            uint32_t word = free_[w].load(std::memory_order_relaxed);
+            while (word) {
+                const uint32_t bit = word & (~word + 1u);
+                if (free_[w].compare_exchange_weak(word, word & ~bit, std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                    return bytes_ + (w * 32 + detail::count_trailing_zeros(bit)) * block_bytes_;
+                }
             }
-            
-            // 실패 상태면 재시도 금지
-            if (state_ == InitState::FAILED) [[unlikely]] {
-                return false;
+        }
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    
+    bool release(const uint8_t* block) noexcept {
+        if (!owns(block)) [[unlikely]] return false;
+        const std::size_t index = static_cast<std::size_t>(block - bytes_) / block_bytes_;
+        free_[index / 32].fetch_or(1u << (index % 32), std::memory_order_release);
+        return true;
+    }
+    
+    bool owns(const uint8_t* block) const noexcept {
+        return block >= bytes_ && block < bytes_ + blocks_ * block_bytes_ &&
+               static_cast<std::size_t>(block - bytes_) % block_bytes_ == 0;
+    }
+    
+    constexpr std::size_t block_bytes() const noexcept { return block_bytes_; }
+    constexpr std::size_t blocks() const noexcept { return blocks_; }
+    std::size_t available() const noexcept {
+        std::size_t count = 0;
+        for (std::size_t w = 0; w < words_; ++w) {
+            for (uint32_t word = free_[w].load(std::memory_order_relaxed); word; word &= word - 1) ++count;
+        }
+        return count;
+    }
+    // 블록이 없어 등록이 실패한 횟수
+    uint32_t failures() const noexcept { return failures_.load(std::memory_order_relaxed); }
+
+protected:
+    MailboxPoolBase(uint8_t* bytes, std::atomic<uint32_t>* free, std::size_t block_bytes, std::size_t blocks) noexcept
+        : bytes_(bytes), free_(free), block_bytes_(block_bytes), blocks_(blocks), words_((blocks + 31) / 32) {}
+    ~MailboxPoolBase() = default;
+    
+    // 파생 클래스 생성자 본문에서 (비트맵 멤버 생성 후) 모든 블록을 빈 상태로
+    void reset_free() noexcept {
+        for (std::size_t w = 0; w < words_; ++w) {
+            const std::size_t left = blocks_ - w * 32;
+            free_[w].store(left >= 32 ? ~0u : (1u << left) - 1u, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    uint8_t* bytes_;
+    std::atomic<uint32_t>* free_;
+    std::size_t block_bytes_;
+    std::size_t blocks_;
+    std::size_t words_;
+    std::atomic<uint32_t> failures_{0};
+};
+
+template<std::size_t BlockBytes, std::size_t Blocks>
+class MailboxPool : public MailboxPoolBase {
+    static_assert(BlockBytes != 0 && MINI_SO_MAILBOX_BYTES == 0,  // 인스턴스화할 때만 검사
+                  "MailboxPool needs MINI_SO_MAILBOX_BYTES=0 (agents with an inline mailbox never take a block)");
+    static_assert(Blocks > 0, "Mailbox pool needs at least one block");
+    static_assert((BlockBytes & (BlockBytes - 1)) == 0 &&
+                  BlockBytes >= MessageQueue::RECORD_HEADER_SIZE + MINI_SO_MAX_MESSAGE_SIZE,
+                  "Mailbox pool blocks must be a power of two holding one maximum-size message");
+
+public:
+    MailboxPool() noexcept : MailboxPoolBase(bytes_, free_, BlockBytes, Blocks) { reset_free(); }
+
+private:
+    alignas(64) uint8_t bytes_[BlockBytes * Blocks];
+    std::atomic<uint32_t> free_[(Blocks + 31) / 32];
+};
+
+// 같은 종류의 worker Agent 묶음 앞의 분배 주소. 발신자는 Router의 ID로 보내고, 전송 경로가 대상 메일박스를
+// 고르기 전에 worker 하나로 바꾸므로 Router 자신의 메일박스와 방문을 거치지 않음 (추가 hop/복사 없음).
+// 해제된 worker는 건너뜀. Router는 broadcast 대상에서 빠지고, 구독하면 publish를 worker 하나에 전달
+class Router : public Agent {
+public:
+    static constexpr std::size_t MAX_WORKERS = MINI_SO_ROUTER_MAX_WORKERS;
+    
+    explicit Router(RoutePolicy policy = RoutePolicy::ROUND_ROBIN) noexcept : policy_(policy) {
+        router_ = this;
+    }
+    
+    // 등록 전에 구성 (전송과 동시에 바꾸지 않음)
+    bool add_worker(AgentId worker) noexcept {
+        if (worker == INVALID_AGENT_ID || count_ >= MAX_WORKERS) [[unlikely]] {
+            return false;
+        }
+        workers_[count_++] = worker;
+        return true;
+    }
+    void clear_workers() noexcept { count_ = 0; }
+    
+    constexpr RoutePolicy policy() const noexcept { return policy_; }
+    constexpr std::size_t worker_count() const noexcept { return count_; }
+    constexpr AgentId worker(std::size_t i) const noexcept { return i < count_ ? workers_[i] : INVALID_AGENT_ID; }
+    
+    // 라우팅된 전송은 메일박스에 들어오지 않음 (send_raw 등 우회 경로로 온 메시지는 거부)
+    bool handle_message(const MessageBase&) noexcept override { return false; }
+    
+private:
+    friend class Environment;
+    
+    std::array<AgentId, MAX_WORKERS> workers_{};
+    uint8_t count_ = 0;
+    RoutePolicy policy_;
+    std::atomic<uint32_t> cursor_{0};  // ROUND_ROBIN/LEAST_DEPTH 시작 위치
+};
+
+namespace detail {
+    // level 클래스에서 꺼낸 Agent 한 번 방문
+    inline void visit_agent(Agent& agent, std::size_t level) noexcept {
+        if (level < static_cast<std::size_t>(agent.priority())) [[unlikely]] {
+            // 승격 방문: 승격 메시지가 배치 한도 뒤에 있어도 이번 방문에 처리되도록
+            // 현재 대기 중인 메시지 수만큼 처리 (메일박스 용량으로 유계)
+            agent.process_messages(static_cast<uint32_t>(agent.message_queue_.size()));
+        } else {
+            agent.process_messages();
+        }
+    }
+    
+    // EDF: 기한 메시지가 대기 중인 Agent 중 가장 이른 기한의 Agent를 우선순위 클래스보다 먼저 방문.
+    // 기한 메시지가 FIFO 뒤쪽에 있어도 이번 방문에 처리되도록 현재 대기 중인 메시지 수만큼 처리.
+    // ready 비트를 가져오지 못하면(다른 워커가 방문 중) false - 호출자는 클래스 순서로 진행
+    template<std::size_t N>
+    bool run_deadline_agent(ReadySet& ready, std::array<Agent*, N>& agents) noexcept {
+        std::size_t best = N;
+        HiresTime best_deadline = 0;
+        ready.for_each_deadline([&](std::size_t index) noexcept {
+            Agent* agent = index < N ? agents[index] : nullptr;
+            HiresTime deadline;
+            if (!agent || !agent->message_queue_.bound_to(&ready) ||
+                !agent->message_queue_.earliest_deadline(deadline)) [[unlikely]] {
+                ready.clear_deadline(index);  // 이미 처리된 기한의 늦은 표시
+                if (agent && agent->message_queue_.pending_deadlines() > 0) ready.mark_deadline(index);
+                return;
             }
-            
-            // 순환 초기화 방지
-            if (state_ == InitState::INITIALIZING) [[unlikely]] {
-                state_ = InitState::FAILED;
-                return false;
+            if (best == N || hires_before(deadline, best_deadline)) {
+                best = index;
+                best_deadline = deadline;
             }
+        });
+        
+        std::size_t level;
+        if (best == N || !ready.claim(best, level)) {
+            return false;
+        }
+        Agent& agent = *agents[best];
+        agent.process_messages(static_cast<uint32_t>(agent.message_queue_.size()));
+        if (agent.has_messages()) {
+            ready.mark(best, static_cast<std::size_t>(agent.priority()));
+        }
+        return true;
+    }
+    
+    // level 클래스에서 ready Agent 하나를 꺼내 처리.
+    // 메시지가 남은 Agent는 자신의 클래스로 다시 표시되어 다음 방문을 기다림.
+    template<std::size_t N>
+    bool run_ready_agent(ReadySet& ready, std::size_t level, std::array<Agent*, N>& agents) noexcept {
+        std::size_t index;
+        while (ready.take_next(level, index)) {
+            Agent* agent = agents[index];
+            // 디스패처로 옮겨간 Agent의 늦은 비트는 무시 (다른 스레드에서 처리됨)
+            if (!agent || !agent->message_queue_.bound_to(&ready)) [[unlikely]] continue;
             
-            // 너무 많은 재시도 방지
-            if (++init_attempt_count_ > 3) [[unlikely]] {
-                state_ = InitState::FAILED;
-                return false;
+            visit_agent(*agent, level);
+            if (agent->has_messages()) {
+                ready.mark(index, static_cast<std::size_t>(agent->priority()));
             }
+            return true;
+        }
+        return false;
+    }
+    
+    // 스케줄링 라운드: ready Agent가 있는 가장 높은 클래스에서 최대
+    // MINI_SO_PRIORITY_QUANTUM개 Agent를 처리한 뒤 반환 (호출자가 다시 상위부터 확인)
+    template<std::size_t N>
+    bool run_ready_round(ReadySet& ready, std::array<Agent*, N>& agents) noexcept {
+        if (ready.any_deadline() && run_deadline_agent(ready, agents)) [[unlikely]] {
+            return true;
+        }
+        for (std::size_t level = 0; level < ReadySet::LEVELS; ++level) {
+            if (!ready.any(level)) continue;
             
-            // 초기화 시작
-            state_ = InitState::INITIALIZING;
-            
-            bool success = Derived::do_initialize();
-            state_ = success ? InitState::INITIALIZED : InitState::FAILED;
-            
-            return success;
+            bool processed = false;
+            for (std::size_t visit = 0; visit < MINI_SO_PRIORITY_QUANTUM; ++visit) {
+                if (!run_ready_agent(ready, level, agents)) break;
+                processed = true;
+            }
+            if (processed) return true;
+        }
+        return false;
+    }
+    
+    // 가장 높은 클래스의 ready Agent 하나만 처리
+    template<std::size_t N>
+    bool run_ready_one(ReadySet& ready, std::array<Agent*, N>& agents) noexcept {
+        if (ready.any_deadline() && run_deadline_agent(ready, agents)) [[unlikely]] {
+            return true;
+        }
+        for (std::size_t level = 0; level < ReadySet::LEVELS; ++level) {
+            if (run_ready_agent(ready, level, agents)) return true;
+        }
+        return false;
+    }
+    
+    // 메시지 타입 우선순위가 대상 Agent보다 높으면 승격 클래스에도 표시
+    // (Agent가 연결된 스케줄러 - Environment 또는 디스패처 - 의 ReadySet)
+    template<typename T>
+    void mark_message_priority(Agent& agent) noexcept {
+        constexpr Priority priority = MessagePriority<T>::value;
+        if constexpr (priority != Priority::LOW) {
+            if (priority < agent.priority()) {
+                agent.message_queue_.mark_ready(static_cast<std::size_t>(priority));
+            }
+        }
+    }
+    
+    // try_send/send_for 전송 한도: 가득 차면 대상 과부하 정책 대신 wait(틱)까지 공간을 기다리고
+    // (0 = 즉시 실패) MUTEX 메일박스 잠금도 wait까지만 기다림. result는 마지막 push 결과
+    struct SendControl {
+        TickType_t wait;
+        QueueResult result = QueueResult::SUCCESS;
+        bool throttled = false;  // 토큰 버킷 한도가 버림
+    };
+    
+    // 전달 실패한 SendControl의 결과 해석 (push 실패가 없었으면 수신 필터 거부)
+    constexpr SendResult send_failure(const SendControl& control) noexcept {
+        if (control.throttled) return SendResult::THROTTLED;
+        switch (control.result) {
+            case QueueResult::SUCCESS: return SendResult::FILTERED;
+            case QueueResult::QUEUE_FULL: return SendResult::QUEUE_FULL;
+            case QueueResult::MESSAGE_TOO_LARGE: return SendResult::MESSAGE_TOO_LARGE;
+            default: return SendResult::BUSY;  // MUTEX 잠금 한도 초과
+        }
+    }
+    
+    // 공간이 생기거나 timeout(틱)까지 push(Agent&) 재시도 - 성공하면 true (BLOCKED/TIMED_OUT 집계는 호출자)
+    template<typename Push>
+    bool deliver_blocking(Agent& target, TickType_t timeout, Push&& push) noexcept {
+        auto& queue = target.message_queue_;
+        TaskHandle_t self = xTaskGetCurrentTaskHandle();
+        const TimePoint start = now();
+        for (;;) {
+            // 등록 후 재시도 - 그 사이 소비자가 비운 공간도 놓치지 않음
+            const bool registered = queue.add_space_waiter(self);
+            const bool delivered = push(target) == QueueResult::SUCCESS;
+            const Duration elapsed = now() - start;
+            if (!delivered && elapsed < timeout) {
+                ulTaskNotifyTake(pdTRUE, registered ? timeout - elapsed : 1);
+            }
+            if (registered) queue.remove_space_waiter(self);
+            if (delivered) return true;
+            if (elapsed >= timeout) return false;
+        }
+    }
+    
+    // 가득 찬 메일박스에 과부하 정책 적용. push(Agent&)는 레코드 하나를 큐잉,
+    // value는 KEEP_LATEST로 덮어쓸 복사 레코드 (핸들 전송이면 nullptr - DROP_OLDEST로 동작).
+    // 반환: 메시지를 받은 Agent (REDIRECT면 overflow 대상), 실패 시 nullptr
+    template<typename Push>
+    Agent* deliver_overloaded(Agent& target, OverloadPolicy policy, const MessageBase* value, uint16_t size,
+                              Push&& push) noexcept {
+        using Event = Agent::OverloadEvent;
+        auto& queue = target.message_queue_;
+        
+        switch (policy) {
+            case OverloadPolicy::KEEP_LATEST:
+            case OverloadPolicy::DROP_OLDEST: {
+                // 소비자가 방문 중이면 곧 공간이 생기므로 새 메시지만 버림
+                if (!queue.try_lock_consumer()) break;
+                bool delivered = false;
+                if (policy == OverloadPolicy::KEEP_LATEST && value && queue.replace_latest(*value, size)) {
+                    target.count_overload(Event::COALESCED);
+                    delivered = true;
+                }
+                while (!delivered && queue.evict_front()) {
+                    target.count_overload(Event::EVICTED);
+                    delivered = push(target) == QueueResult::SUCCESS;
+                }
+                queue.unlock_consumer();
+                if (delivered) return &target;
+                break;
+            }
+            case OverloadPolicy::BLOCK:
+                if (deliver_blocking(target, target.overload_timeout(), push)) {
+                    target.count_overload(Event::BLOCKED);
+                    return &target;
+                }
+                target.count_overload(Event::TIMED_OUT);
+                break;
+            case OverloadPolicy::REDIRECT:
+                if (Agent* overflow = target.overflow_target()) {
+                    if (push(*overflow) == QueueResult::SUCCESS) {
+                        target.count_overload(Event::REDIRECTED);
+                        return overflow;
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+        target.count_overload(Event::DROPPED);
+        return nullptr;
+    }
+    
+    // try_send/send_for의 가득 찬 경로: 정책 대신 control.wait까지 대기 (0이면 push 한 번)
+    template<typename Push>
+    Agent* deliver_controlled(Agent& target, SendControl& control, Push&& push) noexcept {
+        using Event = Agent::OverloadEvent;
+        if (control.wait > 0) {
+            QueueResult last = QueueResult::QUEUE_FULL;
+            if (deliver_blocking(target, control.wait, [&](Agent& agent) noexcept { return last = push(agent); })) {
+                target.count_overload(Event::BLOCKED);
+                return &target;
+            }
+            target.count_overload(Event::TIMED_OUT);
+            control.result = last;
+        } else {
+            control.result = push(target);
+            if (control.result == QueueResult::SUCCESS) return &target;
+        }
+        target.count_overload(Event::DROPPED);
+        return nullptr;
+    }
+    
+    // 메일박스 전송 공통 경로 - 성공 경로는 push 한 번, 가득 차면 T 또는 대상 Agent의 정책 적용
+    template<typename T, typename Push>
+    Agent* deliver(Agent& target, const MessageBase* value, uint16_t size, Push&& push) noexcept {
+        const QueueResult result = push(target);
+        if (result == QueueResult::SUCCESS) [[likely]] {
+            return &target;
+        }
+        if (result != QueueResult::QUEUE_FULL) [[unlikely]] {
+            target.count_overload(Agent::OverloadEvent::DROPPED);
+            return nullptr;
+        }
+        constexpr OverloadPolicy type_policy = MessageOverload<T>::value;
+        return deliver_overloaded(target, type_policy != OverloadPolicy::DEFAULT ? type_policy : target.overload_policy(),
+                                  value, size, push);
+    }
+    
+    // MessageCoalesce<T>: 대상의 최신 값 cell에 쓰고, 대기 표지가 없을 때만 메일박스에 표지를 넣음.
+    // 배정할 cell이 없으면(타입 수 > MINI_SO_LATEST_CELLS) 일반 레코드로 전송.
+    // 메일박스가 가득 차면 control.wait까지 표지 push를 다시 시도. 그래도 실패하면 값은 cell에 남아
+    // 대기 값으로 집계(coalesced)하고, 소비자가 메일박스를 비운 뒤 표지를 다시 넣어 전달함
+    template<typename T, typename Make>
+    Agent* deliver_latest(Agent& target, Make&& make, SendControl* control) noexcept {
+        constexpr uint16_t size = sizeof(Message<T>);
+        static_assert(size <= LatestCells::BYTES, "Coalesced message too large (increase MINI_SO_LATEST_BYTES)");
+        static_assert(std::is_trivially_copyable_v<T>, "Coalesced messages are copied between cells and handlers");
+        
+        alignas(Message<T>) uint8_t storage[sizeof(Message<T>)];
+        Message<T>* msg = make(storage);
+        bool notify = false;
+        const uint8_t cell = target.latest_.store(MESSAGE_TYPE_ID(T), *msg, size, notify);
+        if (cell == LatestCells::NO_CELL) [[unlikely]] {
+            if (control) {
+                return deliver_controlled(target, *control, [&](Agent& agent) noexcept {
+                    return agent.message_queue_.push(*msg, size, control->wait);
+                });
+            }
+            return deliver<T>(target, msg, size, [&](Agent& agent) noexcept { return agent.message_queue_.push(*msg, size); });
+        }
+        if (!notify) {
+            target.count_overload(Agent::OverloadEvent::COALESCED);  // 대기 값 교체
+            return &target;
+        }
+        
+        Message<LatestNotice> notice(LatestNotice{cell}, msg->sender_id());
+        notice.header.set_sent_at(msg->timestamp());  // 대기 시간은 첫 미소비 값 기준
+        const TickType_t lock_wait = control ? control->wait : portMAX_DELAY;
+        auto push = [&](Agent& agent) noexcept { return agent.message_queue_.push(notice, sizeof(notice), lock_wait); };
+        const QueueResult pushed = push(target);
+        if (pushed != QueueResult::SUCCESS &&
+            !(pushed == QueueResult::QUEUE_FULL && control && control->wait > 0 &&
+              deliver_blocking(target, control->wait, push))) [[unlikely]] {
+            target.latest_.cancel_notice(cell);
+            target.count_overload(Agent::OverloadEvent::COALESCED);
+        }
+        return &target;
+    }
+    
+    // TypedMailbox: 헤더/필드 열에 저장하고, 대기 표지가 없을 때만 메인 메일박스에 표지를 넣음.
+    // 메인 메일박스가 가득 차면 control.wait까지 표지 push를 다시 시도. 그래도 실패하면 값은 box에 남고
+    // (전달된 것으로 봄) 소비자가 메인 메일박스를 비운 뒤 표지를 다시 넣음 - has_messages()가 방문을 유지
+    template<typename T, typename Make>
+    Agent* deliver_typed(Agent& target, TypedMailboxBase& box, Make&& make, SendControl* control) noexcept {
+        alignas(Message<T>) uint8_t storage[sizeof(Message<T>)];
+        Message<T>* msg = make(storage);
+        if (!box.push(*msg)) [[unlikely]] {
+            target.count_overload(Agent::OverloadEvent::DROPPED);
+            if (control) control->result = QueueResult::QUEUE_FULL;
+            return nullptr;
+        }
+        if (box.claim_notice()) {
+            Message<TypedNotice> notice(TypedNotice{box.index()}, msg->sender_id());
+            notice.header.set_sent_at(msg->timestamp());
+            const TickType_t lock_wait = control ? control->wait : portMAX_DELAY;
+            auto push = [&](Agent& agent) noexcept { return agent.message_queue_.push(notice, sizeof(notice), lock_wait); };
+            const QueueResult pushed = push(target);
+            if (pushed != QueueResult::SUCCESS &&
+                !(pushed == QueueResult::QUEUE_FULL && control && control->wait > 0 &&
+                  deliver_blocking(target, control->wait, push))) [[unlikely]] {
+                box.cancel_notice();
+            }
+        }
+        return &target;
+    }
+    
+    // 대상 Agent의 T 수신 필터 (없으면 nullptr)
+    template<typename T>
+    const ReceiveFilters::Entry* receive_filter(const Agent& target) noexcept {
+        if (!target.receive_filters_.active()) [[likely]] {
+            return nullptr;
+        }
+        return target.receive_filters_.find(MESSAGE_TYPE_ID(T));
+    }
+    
+    // target이 속한 Environment의 토큰 버킷 한도 표 (Environment 정의 뒤에 구현)
+    inline RateLimiter& rate_limiter(const Agent& target) noexcept;
+    
+    inline bool rate_limited(const Agent& target) noexcept {
+        if constexpr (RateLimiter::CAPACITY == 0) {
+            return false;
+        } else {
+            return rate_limiter(target).active();
+        }
+    }
+    
+    // 한도 판정 - 통과면 true. 거부면 Throttle에 따라 대기 중인 메시지 교체(msg가 없으면 data로 생성) 또는 버림,
+    // 대상 overload 카운터(coalesced/throttled)와 한도 카운터에 집계하고 false (coalesced에 교체 여부)
+    template<typename T>
+    bool rate_admits(Agent& target, AgentId sender, const T& data, const Message<T>* msg, bool& coalesced) noexcept {
+        RateLimiter& limits = rate_limiter(target);
+        std::size_t denied = RateLimiter::NONE;
+        const RateLimiter::Verdict verdict = limits.admit(sender, target.id(), MESSAGE_TYPE_ID(T), denied);
+        if (verdict == RateLimiter::Verdict::PASS) [[likely]] {
+            return true;
+        }
+        coalesced = false;
+        if (verdict == RateLimiter::Verdict::COALESCE) {
+            auto& queue = target.message_queue_;
+            if (queue.try_lock_consumer()) {
+                if (msg) {
+                    coalesced = queue.replace_latest(*msg, sizeof(Message<T>));
+                } else if constexpr (std::is_copy_constructible_v<T> && sizeof(Message<T>) <= MINI_SO_MAX_MESSAGE_SIZE) {
+                    const Message<T> value(data, sender);
+                    coalesced = queue.replace_latest(value, sizeof(Message<T>));
+                }
+                queue.unlock_consumer();
+            }
+        }
+        limits.settle(denied, coalesced);
+        target.count_overload(coalesced ? Agent::OverloadEvent::COALESCED : Agent::OverloadEvent::THROTTLED);
+        return false;
+    }
+    
+    // 값이 이미 있는 전송 경로(풀/공유 payload)용 - 필터가 없거나 통과하고 한도 안이면 true
+    template<typename T>
+    bool receive_accepts(Agent& target, const T& data, AgentId sender) noexcept {
+        const ReceiveFilters::Entry* filter = receive_filter<T>(target);
+        if (filter && !target.receive_filters_.accepts(*filter, &data, sender)) {
+            return false;
+        }
+        bool coalesced = false;
+        return !rate_limited(target) || rate_admits<T>(target, sender, data, nullptr, coalesced);
+    }
+    
+    template<typename T, typename Make>
+    Agent* deliver_accepted(Agent& target, Make&& make, SendControl* control = nullptr) noexcept;
+    
+    // 제자리 전송 공통 경로 - make(void* where)가 Message<T>를 생성하고 포인터를 반환.
+    // 성공 경로는 메일박스 슬롯에 직접 생성하고, 가득 찬 경우에만 스택에 한 번 생성해
+    // 과부하 정책(KEEP_LATEST 덮어쓰기, BLOCK 재시도, REDIRECT)에 사용.
+    // 대상에 T 수신 필터나 토큰 버킷 한도가 있으면 스택에 먼저 생성해 술어/한도를 평가하고 통과한 값만 이동.
+    // COALESCE 한도로 대기 메시지를 교체했으면 대상을 반환 (전달된 것으로 봄).
+    // control이 있으면 과부하 정책 대신 그 한도로 전송 (필터 거부는 result를 SUCCESS로 남김)
+    template<typename T, typename Make>
+    Agent* deliver_in_place(Agent& target, Make&& make, SendControl* control = nullptr) noexcept {
+        if constexpr (std::is_move_constructible_v<T>) {
+            const ReceiveFilters::Entry* filter = receive_filter<T>(target);
+            if (filter || rate_limited(target)) [[unlikely]] {
+                alignas(Message<T>) uint8_t storage[sizeof(Message<T>)];
+                Message<T>* msg = make(storage);
+                Agent* receiver = nullptr;
+                bool coalesced = false;
+                if (!filter || target.receive_filters_.accepts(*filter, &msg->data, msg->sender_id())) {
+                    if (!rate_limited(target) || rate_admits<T>(target, msg->sender_id(), msg->data, msg, coalesced)) {
+                        receiver = deliver_accepted<T>(target, [&](void* where) noexcept {
+                            return new (where) Message<T>(std::move(*msg));
+                        }, control);
+                    } else if (coalesced) {
+                        receiver = &target;
+                    } else if (control) {
+                        control->throttled = true;
+                    }
+                }
+                msg->~Message<T>();
+                return receiver;
+            }
+        }
+        return deliver_accepted<T>(target, make, control);
+    }
+    
+    template<typename T, typename Make>
+    Agent* deliver_accepted(Agent& target, Make&& make, SendControl* control) noexcept {
+        constexpr uint16_t size = sizeof(Message<T>);
+        static_assert(size <= MINI_SO_MAX_MESSAGE_SIZE, "Message too large");
+        
+        if constexpr (MessageCoalesce<T>::value && LatestCells::CELLS > 0) {
+            return deliver_latest<T>(target, make, control);
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (target.typed_mailboxes_) [[unlikely]] {
+                if (TypedMailboxBase* box = target.typed_mailbox(MESSAGE_TYPE_ID(T))) {
+                    return deliver_typed<T>(target, *box, make, control);
+                }
+            }
+        }
+        
+        const TickType_t lock_wait = control ? control->wait : portMAX_DELAY;
+        const QueueResult result = target.message_queue_.push_in_place(size, [&](void* payload) noexcept {
+            make(payload);
+        }, lock_wait);
+        if (result == QueueResult::SUCCESS) [[likely]] {
+            return &target;
+        }
+        if (result != QueueResult::QUEUE_FULL || (control && control->wait == 0)) [[unlikely]] {
+            target.count_overload(Agent::OverloadEvent::DROPPED);
+            if (control) control->result = result;
+            return nullptr;
+        }
+        
+        alignas(Message<T>) uint8_t storage[sizeof(Message<T>)];
+        Message<T>* msg = make(storage);
+        auto push = [&](Agent& agent) noexcept { return agent.message_queue_.push(*msg, size, lock_wait); };
+        Agent* receiver = nullptr;
+        if (control) {
+            receiver = deliver_controlled(target, *control, push);
+        } else {
+            constexpr OverloadPolicy type_policy = MessageOverload<T>::value;
+            receiver = deliver_overloaded(
+                target, type_policy != OverloadPolicy::DEFAULT ? type_policy : target.overload_policy(), msg, size, push);
+        }
+        msg->~Message<T>();
+        return receiver;
+    }
+}
+
+// ============================================================================
+// Message Pool - Phase 3: Zero-overhead 메시지 생명주기 최적화
+// ============================================================================
+namespace detail {
+// Lock-free 메시지 풀 (고정 크기)
+// 빈 슬롯은 인덱스 기반 Treiber 스택으로 연결. 스택 머리는 [ABA 태그 16비트 | 인덱스 16비트]
+// 한 워드라 Cortex-M3/M4에서도 32비트 CAS 하나로 push/pop.
+// allocate/deallocate/available_count 모두 O(1) - 슬롯은 포인터 차이로 계산.
+template<typename T, std::size_t PoolSize>
+class MessagePool {
+    // 완화된 타입 제약 - virtual 상속을 지원하기 위해 제약 완화
+    static_assert(std::is_destructible_v<T>, "Message type must be destructible");
+    static_assert(PoolSize > 0 && PoolSize <= 256, "Pool size must be between 1 and 256");
+    
+private:
+    static constexpr uint32_t INDEX_MASK = 0xFFFFu;
+    static constexpr uint16_t EMPTY = 0xFFFFu;
+    
+    struct Slot {
+        alignas(T) uint8_t data[sizeof(T)];
+    };
+    
+    static constexpr uint32_t pack(uint32_t tag, uint16_t index) noexcept { return (tag << 16) | index; }
+    
+    alignas(64) std::array<Slot, PoolSize> slots_;
+    std::array<std::atomic<uint16_t>, PoolSize> next_;    // 빈 슬롯 연결 (스택 안에서만 유효)
+    std::array<std::atomic<bool>, PoolSize> in_use_;      // 이중 해제 방지
+    alignas(64) std::atomic<uint32_t> head_;              // [태그 | 맨 위 빈 슬롯]
+    std::atomic<uint32_t> available_{PoolSize};
+    
+public:
+    MessagePool() noexcept : head_(pack(0, 0)) {
+        for (std::size_t i = 0; i < PoolSize; ++i) {
+            next_[i].store(i + 1 < PoolSize ? static_cast<uint16_t>(i + 1) : EMPTY, std::memory_order_relaxed);
+            in_use_[i].store(false, std::memory_order_relaxed);
+        }
+    }
+    
+    // 메시지 할당 - 빈 스택 pop (풀 고갈 시 nullptr)
+    T* allocate() noexcept {
+        uint32_t head = head_.load(std::memory_order_acquire);
+        for (;;) {
+            const uint16_t index = static_cast<uint16_t>(head & INDEX_MASK);
+            if (index == EMPTY) [[unlikely]] {
+                return nullptr;
+            }
+            // 다른 태스크가 먼저 꺼냈다면 next가 낡았어도 태그가 달라져 CAS 실패
+            const uint16_t next = next_[index].load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, pack((head >> 16) + 1, next),
+                                            std::memory_order_acquire, std::memory_order_acquire)) {
+                in_use_[index].store(true, std::memory_order_relaxed);
+                available_.fetch_sub(1, std::memory_order_relaxed);
+                return reinterpret_cast<T*>(slots_[index].data);
+            }
+        }
+    }
+    
+    // 메시지 해제 - 포인터로 슬롯 계산 후 빈 스택 push (풀 밖 포인터나 이중 해제는 무시)
+    void deallocate(T* ptr) noexcept {
+        const std::size_t index = slot_index(ptr);
+        if (index >= PoolSize) [[unlikely]] return;
+        if (!in_use_[index].exchange(false, std::memory_order_relaxed)) [[unlikely]] return;
+        
+        available_.fetch_add(1, std::memory_order_relaxed);
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        do {
+            next_[index].store(static_cast<uint16_t>(head & INDEX_MASK), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, pack((head >> 16) + 1, static_cast<uint16_t>(index)),
+                                              std::memory_order_release, std::memory_order_relaxed));
+    }
+    
+    // 풀 소속 여부 (size-class arena 등 여러 풀을 둘 때 해제 대상 판별)
+    bool owns(const void* ptr) const noexcept { return slot_index(ptr) < PoolSize; }
+    
+    // 풀 상태 조회
+    constexpr std::size_t capacity() const noexcept { return PoolSize; }
+    
+    std::size_t available_count() const noexcept {
+        return available_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // 풀 슬롯이 아니면 PoolSize 반환
+    std::size_t slot_index(const void* ptr) const noexcept {
+        const auto address = reinterpret_cast<uintptr_t>(ptr);
+        const auto base = reinterpret_cast<uintptr_t>(slots_.data());
+        if (address < base) return PoolSize;
+        const uintptr_t offset = address - base;
+        if (offset % sizeof(Slot) != 0) return PoolSize;
+        const std::size_t index = static_cast<std::size_t>(offset / sizeof(Slot));
+        return index < PoolSize ? index : PoolSize;
+    }
+};
+
+// 공유 size-class arena 블록
+template<std::size_t Size>
+struct alignas(alignof(std::max_align_t)) ArenaBlock {
+    uint8_t bytes[Size];
+};
+
+// arena 클래스 하나 - 처음 사용하는 타입이 생길 때만 인스턴스화.
+// 풀은 템플릿 정적 멤버라 GCC가 section 속성을 무시함 - 빠른 RAM 배치는 -fdata-sections가 만드는
+// .bss._ZN7mini_so6detail* 섹션 이름을 링커 스크립트에서 고름 (bench/target/mini_so_placement.ld)
+template<std::size_t Class>
+struct ArenaClass {
+    static constexpr std::size_t BLOCK_SIZE = std::size_t{16} << Class;
+    static inline MessagePool<ArenaBlock<BLOCK_SIZE>, MINI_SO_ARENA_SLOTS> pool_;
+    static inline std::atomic<uint32_t> exhausted_{0};
+};
+
+// arena 클래스 상태 스냅샷
+struct ArenaClassStats {
+    uint16_t block_size;
+    uint16_t capacity;
+    uint16_t available;
+    uint32_t exhausted;    // 클래스가 비어 있던 할당 시도 (상위 클래스로 넘어감)
+};
+
+// 공유 size-class arena (16/32/64/128바이트). MessagePoolSize<T> = 0인 타입이 사용.
+// 맞는 클래스가 비면 상위 클래스로 넘어가고, 반환 시 블록 주소로 소속 클래스를 찾음.
+class MessageArena {
+public:
+    static constexpr std::size_t CLASS_COUNT = 4;
+    static constexpr std::size_t MAX_BLOCK_SIZE = std::size_t{16} << (CLASS_COUNT - 1);
+    
+    static constexpr std::size_t class_for(std::size_t size) noexcept {
+        std::size_t size_class = 0;
+        while (size_class < CLASS_COUNT && (std::size_t{16} << size_class) < size) {
+            ++size_class;
+        }
+        return size_class;
+    }
+    
+    // Class부터 위로 빈 블록을 찾음, 모두 고갈 시 nullptr
+    template<std::size_t Class>
+    static void* allocate() noexcept {
+        if constexpr (Class >= CLASS_COUNT) {
+            return nullptr;
+        } else {
+            if (void* block = ArenaClass<Class>::pool_.allocate()) [[likely]] {
+                return block;
+            }
+            ArenaClass<Class>::exhausted_.fetch_add(1, std::memory_order_relaxed);
+            return allocate<Class + 1>();
+        }
+    }
+    
+    template<std::size_t Class>
+    static void deallocate(void* block) noexcept {
+        if constexpr (Class < CLASS_COUNT) {
+            using Pool = ArenaClass<Class>;
+            if (Pool::pool_.owns(block)) [[likely]] {
+                Pool::pool_.deallocate(static_cast<ArenaBlock<Pool::BLOCK_SIZE>*>(block));
+                return;
+            }
+            deallocate<Class + 1>(block);
+        }
+    }
+    
+    template<std::size_t Class>
+    static ArenaClassStats class_stats() noexcept {
+        static_assert(Class < CLASS_COUNT, "Arena class out of range");
+        using Pool = ArenaClass<Class>;
+        return ArenaClassStats{static_cast<uint16_t>(Pool::BLOCK_SIZE),
+                               static_cast<uint16_t>(Pool::pool_.capacity()),
+                               static_cast<uint16_t>(Pool::pool_.available_count()),
+                               Pool::exhausted_.load(std::memory_order_relaxed)};
+    }
+};
+
+// 전역 메시지 풀 관리자 - MessagePoolSize<T> 슬롯의 전용 풀, 0이면 공유 arena
+template<typename T>
+class GlobalMessagePool {
+private:
+    static constexpr std::size_t POOL_SIZE = MessagePoolSize<T>::value;
+    static constexpr bool USES_ARENA = POOL_SIZE == 0;
+    static constexpr std::size_t ARENA_CLASS = MessageArena::class_for(sizeof(Message<T>));
+    
+    static_assert(!USES_ARENA || sizeof(Message<T>) <= MessageArena::MAX_BLOCK_SIZE,
+                  "Message too large for the size-class arena; give it a dedicated pool");
+    static_assert(!USES_ARENA || alignof(Message<T>) <= alignof(std::max_align_t),
+                  "Over-aligned message cannot use the size-class arena");
+    
+    // 전용 풀 - arena 타입은 사용하지 않으므로 인스턴스화되지 않음
+    static inline MessagePool<Message<T>, (USES_ARENA ? 1 : POOL_SIZE)> pool_;
+    static inline std::atomic<uint32_t> exhausted_{0};
+    
+public:
+    // 고갈 시 nullptr (exhausted_count 증가)
+    static Message<T>* allocate() noexcept {
+        Message<T>* msg;
+        if constexpr (USES_ARENA) {
+            msg = static_cast<Message<T>*>(MessageArena::allocate<ARENA_CLASS>());
+        } else {
+            msg = pool_.allocate();
+        }
+        if (!msg) [[unlikely]] {
+            exhausted_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return msg;
+    }
+    
+    static void deallocate(Message<T>* msg) noexcept {
+        if constexpr (USES_ARENA) {
+            MessageArena::deallocate<ARENA_CLASS>(msg);
+        } else {
+            pool_.deallocate(msg);
+        }
+    }
+    
+    // MessageHandle::release 용 (큐에서 소비 완료 후 호출)
+    static void release(MessageBase* msg) noexcept {
+        deallocate(static_cast<Message<T>*>(msg));
+    }
+    
+    // arena 타입은 처음 맞는 클래스 기준
+    static std::size_t available_count() noexcept {
+        if constexpr (USES_ARENA) {
+            return MessageArena::class_stats<ARENA_CLASS>().available;
+        } else {
+            return pool_.available_count();
+        }
+    }
+    
+    static constexpr std::size_t capacity() noexcept {
+        return USES_ARENA ? std::size_t{MINI_SO_ARENA_SLOTS} : POOL_SIZE;
+    }
+    
+    static constexpr bool uses_arena() noexcept { return USES_ARENA; }
+    
+    // 풀(또는 arena 전체)이 고갈되어 할당하지 못한 횟수
+    static uint32_t exhausted_count() noexcept {
+        return exhausted_.load(std::memory_order_relaxed);
+    }
+};
+
+// 불변 공유 메시지 - 여러 메일박스가 같은 풀 슬롯을 핸들로 참조.
+// 참조 카운트 = 슬롯을 가리키는 큐 핸들 수 (+ 팬아웃 중인 발신자 1)
+template<typename T>
+struct SharedMessage : Message<T> {
+    std::atomic<uint32_t> refs;
+    
+    SharedMessage(const T& msg_data, AgentId sender) noexcept
+        : Message<T>(msg_data, sender), refs(1) {}
+};
+
+// 공유 메시지 풀 - 마지막 소비자의 release가 슬롯을 반환
+template<typename T>
+class GlobalSharedMessagePool {
+private:
+    static inline MessagePool<SharedMessage<T>, MINI_SO_SHARED_POOL_SIZE> pool_;
+    
+public:
+    // refs = 1 (호출자 소유) 상태로 생성, 풀 고갈 시 nullptr
+    static SharedMessage<T>* create(const T& data, AgentId sender) noexcept {
+        SharedMessage<T>* shared = pool_.allocate();
+        if (!shared) [[unlikely]] return nullptr;
+        return new (shared) SharedMessage<T>(data, sender);
+    }
+    
+    static void retain(SharedMessage<T>* shared) noexcept {
+        shared->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // MessageHandle::release 용 - 소비자마다 한 번, 발신자 참조도 같은 경로로 해제
+    static void release(MessageBase* msg) noexcept {
+        auto* shared = static_cast<SharedMessage<T>*>(msg);
+        if (shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            shared->~SharedMessage<T>();
+            pool_.deallocate(shared);
+        }
+    }
+    
+    static MessageHandle handle(SharedMessage<T>* shared) noexcept {
+        return MessageHandle{shared, &GlobalSharedMessagePool<T>::release,
+                             static_cast<uint16_t>(sizeof(Message<T>))};
+    }
+    
+    static std::size_t available_count() noexcept {
+        return pool_.available_count();
+    }
+    
+    static constexpr std::size_t capacity() noexcept {
+        return pool_.capacity();
+    }
+};
+
+// UniqueBuffer/BufferRef 블록 - Message<T>(헤더 + payload)가 블록 안에 있고 메일박스에는 핸들만 들어감.
+// refs = 블록을 가리키는 UniqueBuffer/BufferRef와 큐 핸들 수
+template<typename T>
+struct BufferBlock : Message<T> {
+    std::atomic<uint32_t> refs;
+    
+    BufferBlock() noexcept : Message<T>(INVALID_AGENT_ID, DefaultInit{}), refs(1) {}
+};
+
+// 타입별 버퍼 블록 풀 (BufferPoolSize<T>개) - 마지막 참조의 release가 블록을 반환
+template<typename T>
+class GlobalBufferPool {
+private:
+    static_assert(sizeof(Message<T>) <= 0xFFFF, "Buffer message too large for a mailbox handle");
+    
+    static inline MessagePool<BufferBlock<T>, BufferPoolSize<T>::value> pool_;
+    static inline std::atomic<uint32_t> exhausted_{0};
+    
+public:
+    // refs = 1 (호출자 소유), 고갈 시 nullptr (exhausted_count 증가)
+    static BufferBlock<T>* acquire() noexcept {
+        BufferBlock<T>* block = pool_.allocate();
+        if (!block) [[unlikely]] {
+            exhausted_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return new (block) BufferBlock<T>();
+    }
+    
+    static void retain(BufferBlock<T>* block) noexcept {
+        block->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // MessageHandle::release 용 - 큐 핸들과 UniqueBuffer/BufferRef가 같은 경로로 해제
+    static void release(MessageBase* msg) noexcept {
+        auto* block = static_cast<BufferBlock<T>*>(static_cast<Message<T>*>(msg));
+        if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            block->~BufferBlock<T>();
+            pool_.deallocate(block);
+        }
+    }
+    
+    // 핸들러가 받은 메시지가 이 풀의 블록이면 그 블록, 아니면 nullptr
+    static BufferBlock<T>* block_of(const MessageBase& msg) noexcept {
+        if (msg.type_id() != MESSAGE_TYPE_ID(T)) return nullptr;
+        auto* block = static_cast<BufferBlock<T>*>(static_cast<Message<T>*>(const_cast<MessageBase*>(&msg)));
+        return pool_.owns(block) ? block : nullptr;
+    }
+    
+    static MessageHandle handle(BufferBlock<T>* block) noexcept {
+        return MessageHandle{block, &GlobalBufferPool<T>::release, static_cast<uint16_t>(sizeof(Message<T>))};
+    }
+    
+    static std::size_t available_count() noexcept { return pool_.available_count(); }
+    static constexpr std::size_t capacity() noexcept { return pool_.capacity(); }
+    static uint32_t exhausted_count() noexcept { return exhausted_.load(std::memory_order_relaxed); }
+};
+}   // namespace detail
+
+// 풀링된 메시지 래퍼
+template<typename T>
+class PooledMessage {
+private:
+    Message<T>* msg_;
+    bool owns_message_;
+    
+public:
+    // 풀에서 할당. 고갈 시 메시지 없는 핸들 반환 (is_pooled() == false, 접근 불가) -
+    // 발신자들이 하나의 대체 버퍼를 공유해 서로 덮어쓰지 않도록 호출자가 다른 경로를 선택
+    static PooledMessage<T> create(const T& data, AgentId sender = INVALID_AGENT_ID) noexcept {
+        Message<T>* msg = detail::GlobalMessagePool<T>::allocate();
+        if (!msg) [[unlikely]] {
+            return PooledMessage<T>(nullptr, false);
+        }
+        // Placement new로 메시지 생성
+        new (msg) Message<T>(data, sender);
+        return PooledMessage<T>(msg, true);
+    }
+    
+    // 이동 생성자
+    PooledMessage(PooledMessage&& other) noexcept 
+        : msg_(other.msg_), owns_message_(other.owns_message_) {
+        other.msg_ = nullptr;
+        other.owns_message_ = false;
+    }
+    
+    // 복사 금지
+    PooledMessage(const PooledMessage&) = delete;
+    PooledMessage& operator=(const PooledMessage&) = delete;
+    PooledMessage& operator=(PooledMessage&&) = delete;
+    
+    // 소멸자에서 자동 해제
+    ~PooledMessage() noexcept {
+        if (msg_ && owns_message_) {
+            detail::GlobalMessagePool<T>::deallocate(msg_);
+        }
+    }
+    
+    // 메시지 접근
+    const Message<T>& get() const noexcept { return *msg_; }
+    Message<T>& get() noexcept { return *msg_; }
+    
+    const Message<T>* operator->() const noexcept { return msg_; }
+    Message<T>* operator->() noexcept { return msg_; }
+    
+    const Message<T>& operator*() const noexcept { return *msg_; }
+    Message<T>& operator*() noexcept { return *msg_; }
+    
+    bool is_pooled() const noexcept { return owns_message_; }
+    
+    // 큐 핸들 생성 (풀 메시지인 경우에만 유효)
+    detail::MessageHandle handle() const noexcept {
+        return detail::MessageHandle{msg_, &detail::GlobalMessagePool<T>::release,
+                                     static_cast<uint16_t>(sizeof(Message<T>))};
+    }
+    
+    // 소유권 포기 - 큐가 핸들을 보관하게 된 경우 호출 (소멸자에서 해제하지 않음)
+    void detach() noexcept { owns_message_ = false; }
+    
+private:
+    explicit PooledMessage(Message<T>* msg, bool owns) noexcept 
+        : msg_(msg), owns_message_(owns) {}
+};
+
+// 소유권 이전 버퍼 (DMA 오디오 프레임, 카메라 라인 등 MINI_SO_MAX_MESSAGE_SIZE보다 큰 payload).
+// 타입별 블록 풀에서 블록 하나를 단독 소유하며 payload는 0으로 채우지 않음 - DMA가 data를 채운 뒤
+// send_buffer로 넘기면 메일박스에는 핸들만 복사되고, 마지막 핸들러가 끝나면 블록이 풀로 돌아감.
+// 수신 측은 평소처럼 Message<T>로 받음. 이동 전용
+template<typename T>
+class UniqueBuffer {
+public:
+    UniqueBuffer() noexcept = default;
+    
+    // 고갈 시 빈 버퍼 (detail::GlobalBufferPool<T>::exhausted_count 증가)
+    static UniqueBuffer acquire() noexcept { return UniqueBuffer(detail::GlobalBufferPool<T>::acquire()); }
+    
+    UniqueBuffer(UniqueBuffer&& other) noexcept : block_(other.detach()) {}
+    UniqueBuffer& operator=(UniqueBuffer&& other) noexcept {
+        if (this != &other) {
+            reset();
+            block_ = other.detach();
+        }
+        return *this;
+    }
+    UniqueBuffer(const UniqueBuffer&) = delete;
+    UniqueBuffer& operator=(const UniqueBuffer&) = delete;
+    ~UniqueBuffer() noexcept { reset(); }
+    
+    void reset() noexcept {
+        if (block_) detail::GlobalBufferPool<T>::release(detach());
+    }
+    
+    explicit operator bool() const noexcept { return block_ != nullptr; }
+    T* get() noexcept { return block_ ? &block_->data : nullptr; }
+    T& operator*() noexcept { return block_->data; }
+    T* operator->() noexcept { return &block_->data; }
+    
+    // 전송 경로용: 블록 참조를 넘겨받음 (빈 버퍼가 됨)
+    detail::BufferBlock<T>* detach() noexcept {
+        detail::BufferBlock<T>* block = block_;
+        block_ = nullptr;
+        return block;
+    }
+    detail::BufferBlock<T>* block() const noexcept { return block_; }
+    
+private:
+    explicit UniqueBuffer(detail::BufferBlock<T>* block) noexcept : block_(block) {}
+    
+    detail::BufferBlock<T>* block_ = nullptr;
+};
+
+// 버퍼 블록의 읽기 전용 공유 참조 - 핸들러가 받은 버퍼 메시지를 복사 없이 다음 단계로 넘기거나
+// 여러 구독자에게 같은 블록을 발행할 때. 복사하면 참조 카운트 증가
+template<typename T>
+class BufferRef {
+public:
+    BufferRef() noexcept = default;
+    
+    // 채운 UniqueBuffer를 읽기 전용으로 공유
+    BufferRef(UniqueBuffer<T>&& unique) noexcept : block_(unique.detach()) {}
+    
+    // 핸들러 안에서: msg가 버퍼 블록이면 참조 추가, 아니면(일반 복사 메시지) 빈 참조
+    static BufferRef from(const MessageBase& msg) noexcept {
+        detail::BufferBlock<T>* block = detail::GlobalBufferPool<T>::block_of(msg);
+        if (block) detail::GlobalBufferPool<T>::retain(block);
+        return BufferRef(block);
+    }
+    
+    BufferRef(const BufferRef& other) noexcept : block_(other.block_) {
+        if (block_) detail::GlobalBufferPool<T>::retain(block_);
+    }
+    BufferRef(BufferRef&& other) noexcept : block_(other.detach()) {}
+    BufferRef& operator=(BufferRef other) noexcept {
+        reset();
+        block_ = other.detach();
+        return *this;
+    }
+    ~BufferRef() noexcept { reset(); }
+    
+    void reset() noexcept {
+        if (block_) detail::GlobalBufferPool<T>::release(detach());
+    }
+    
+    explicit operator bool() const noexcept { return block_ != nullptr; }
+    const T* get() const noexcept { return block_ ? &block_->data : nullptr; }
+    const T& operator*() const noexcept { return block_->data; }
+    const T* operator->() const noexcept { return &block_->data; }
+    
+    detail::BufferBlock<T>* detach() noexcept {
+        detail::BufferBlock<T>* block = block_;
+        block_ = nullptr;
+        return block;
+    }
+    detail::BufferBlock<T>* block() const noexcept { return block_; }
+    
+private:
+    explicit BufferRef(detail::BufferBlock<T>* block) noexcept : block_(block) {}
+    
+    detail::BufferBlock<T>* block_ = nullptr;
+};
+
+namespace detail {
+    // 버퍼 블록 참조 하나를 target 메일박스로 전달 (핸들 push, 복사 없음).
+    // 큐 핸들이 참조 하나를 가짐 - 호출자 참조는 그대로 (성공 후 호출자가 해제)
+    template<typename T>
+    Agent* push_buffer(Agent& target, BufferBlock<T>* block) noexcept {
+        if (!receive_accepts(target, block->data, block->sender_id())) [[unlikely]] {
+            return nullptr;
+        }
+        GlobalBufferPool<T>::retain(block);
+        const MessageHandle handle = GlobalBufferPool<T>::handle(block);
+        Agent* receiver = deliver<T>(target, nullptr, 0, [&](Agent& agent) noexcept {
+            return agent.message_queue_.push_handle(handle);
+        });
+        if (!receiver) [[unlikely]] {
+            GlobalBufferPool<T>::release(block);  // 호출자 참조가 남아 있어 반환되지 않음
+            return nullptr;
+        }
+        mark_message_priority<T>(*receiver);
+        return receiver;
+    }
+    
+    // 풀링된 메시지 전송 공통 경로: 풀 슬롯에 한 번 생성하고 큐에는 핸들만 저장.
+    // 수신 Agent가 풀 저장소에서 직접 읽고 handle_message 반환 후 슬롯 반환.
+    // 풀 고갈 시에는 일반 복사 경로로 전송. MINI_SO_MAX_MESSAGE_SIZE보다 큰 메시지도
+    // 핸들만 큐잉되므로 전송 가능 (풀 고갈 시 실패).
+    // 반환: 메시지를 받은 Agent (과부하 REDIRECT 포함), 실패 시 nullptr
+    template<typename T>
+    Agent* push_pooled(Agent& target, AgentId sender_id, const T& message) noexcept {
+        static_assert(sizeof(Message<T>) <= 0xFFFF, "Message too large");
+        if (!receive_accepts(target, message, sender_id)) [[unlikely]] {
+            return nullptr;  // 풀 슬롯을 잡기 전에 거부
+        }
+        
+        auto pooled_msg = PooledMessage<T>::create(message, sender_id);
+        if (!pooled_msg.is_pooled()) [[unlikely]] {
+            // 풀 고갈: 메일박스 레코드에 직접 생성. 레코드에 들어가지 않는 대형 메시지는 실패
+            if constexpr (sizeof(Message<T>) <= MINI_SO_MAX_MESSAGE_SIZE) {
+                return deliver_accepted<T>(target, [&](void* where) noexcept {
+                    auto* typed_msg = new (where) Message<T>(message, sender_id);
+                    typed_msg->mark_sent();
+                    return typed_msg;
+                });
+            } else {
+                return nullptr;
+            }
+        }
+        pooled_msg->mark_sent();
+        
+        const MessageHandle handle = pooled_msg.handle();
+        Agent* receiver = deliver<T>(target, nullptr, 0, [&](Agent& agent) noexcept {
+            return agent.message_queue_.push_handle(handle);
+        });
+        if (receiver) [[likely]] {
+            pooled_msg.detach();
+        }
+        return receiver;  // 실패 시 소멸자가 슬롯 반환
+    }
+    
+    // 공유 payload 팬아웃: 메시지를 공유 풀 슬롯에 한 번 생성하고 각 대상 메일박스에는
+    // 핸들만 저장 - 비용이 payload 크기와 무관. for_each_target(deliver)는 대상 Agent마다
+    // deliver(Agent&)를 호출. 공유 풀 고갈 시 대상별 push_pooled로 전송. 반환: 전달 수
+    template<typename T, typename ForEachTarget>
+    std::size_t fan_out_shared(AgentId sender_id, const T& message, ForEachTarget&& for_each_target) noexcept {
+        static_assert(sizeof(Message<T>) <= 0xFFFF, "Message too large");
+        std::size_t delivered = 0;
+        
+        SharedMessage<T>* shared = GlobalSharedMessagePool<T>::create(message, sender_id);
+        if (!shared) [[unlikely]] {
+            for_each_target([&](Agent& agent) noexcept {
+                if (Agent* receiver = push_pooled(agent, sender_id, message)) {
+                    mark_message_priority<T>(*receiver);
+                    ++delivered;
+                }
+            });
+            return delivered;
+        }
+        
+        shared->mark_sent();
+        const MessageHandle handle = GlobalSharedMessagePool<T>::handle(shared);
+        for_each_target([&](Agent& agent) noexcept {
+            if (!receive_accepts(agent, message, sender_id)) [[unlikely]] {
+                return;
+            }
+            // push 전에 참조 추가 - 소비자가 즉시 release해도 발신자 참조가 슬롯을 유지
+            GlobalSharedMessagePool<T>::retain(shared);
+            Agent* receiver = deliver<T>(agent, nullptr, 0, [&](Agent& target) noexcept {
+                return target.message_queue_.push_handle(handle);
+            });
+            if (!receiver) [[unlikely]] {
+                GlobalSharedMessagePool<T>::release(shared);
+                return;
+            }
+            mark_message_priority<T>(*receiver);
+            ++delivered;
+        });
+        GlobalSharedMessagePool<T>::release(shared);  // 발신자 참조 해제
+        return delivered;
+    }
+}
+
+// ============================================================================
+// Static Environment - Phase 3: 컴파일 타임 Agent 등록 최적화
+// ============================================================================
+namespace detail {
+    // 컴파일 타임 Agent 카운터
+    template<typename... Agents>
+    struct AgentCounter {
+        static constexpr std::size_t count = sizeof...(Agents);
+    };
+    
+    // 컴파일 타임 Agent 타입 검증
+    template<typename T>
+    constexpr bool is_valid_agent() noexcept {
+        return std::is_base_of_v<Agent, T> && !std::is_abstract_v<T>;
+    }
+    
+    // 컴파일 타임 Agent 리스트 유효성 검사
+    template<typename... Agents>
+    constexpr bool all_valid_agents() noexcept {
+        return (is_valid_agent<Agents>() && ...);
+    }
+}
+
+// Agent가 처리하는 메시지 타입 목록 - Agent 안에서 using handled_messages = MessageList<...>;
+// StaticEnvironment가 이 목록으로 send<T>/publish<T> 경로를 컴파일 타임에 결정
+template<typename... Msgs>
+struct MessageList {
+    static constexpr std::size_t size = sizeof...(Msgs);
+};
+
+namespace detail {
+    template<typename A, typename = void>
+    struct declares_handled_messages : std::false_type {};
+    template<typename A>
+    struct declares_handled_messages<A, std::void_t<typename A::handled_messages>> : std::true_type {};
+    
+    template<typename T, typename List>
+    struct message_list_contains : std::false_type {};
+    template<typename T, typename... Msgs>
+    struct message_list_contains<T, MessageList<Msgs...>> : std::bool_constant<(std::is_same_v<T, Msgs> || ...)> {};
+    
+    // A가 handled_messages에 T를 선언했는지 (선언이 없으면 false)
+    template<typename A, typename T>
+    constexpr bool agent_handles() noexcept {
+        if constexpr (declares_handled_messages<A>::value) {
+            return message_list_contains<T, typename A::handled_messages>::value;
+        } else {
+            return false;
+        }
+    }
+    
+    // A::handle_message / handle_batch가 public이면 한정 호출 (가상 호출 없음, 인라인 가능)
+    template<typename A, typename = void>
+    struct has_public_handler : std::false_type {};
+    template<typename A>
+    struct has_public_handler<A, std::void_t<decltype(std::declval<A&>().A::handle_message(
+        std::declval<const MessageBase&>()))>> : std::true_type {};
+    
+    template<typename A, typename = void>
+    struct has_public_batch_handler : std::false_type {};
+    template<typename A>
+    struct has_public_batch_handler<A, std::void_t<decltype(std::declval<A&>().A::handle_batch(
+        std::declval<Span<const MessageBase* const>>()))>> : std::true_type {};
+    
+    // 구체 타입 A로 방문 1회 - vtable을 거치지 않고 A의 핸들러를 직접 호출
+    template<typename A>
+    void process_static(A& agent, uint32_t max_messages) noexcept {
+        agent.process_messages_with(max_messages,
+            [&agent](const MessageBase& msg) noexcept {
+                if constexpr (has_public_handler<A>::value) {
+                    return agent.A::handle_message(msg);
+                } else {
+                    return static_cast<Agent&>(agent).handle_message(msg);
+                }
+            },
+            [&agent](Span<const MessageBase* const> batch) noexcept {
+                if constexpr (has_public_batch_handler<A>::value) {
+                    return agent.A::handle_batch(batch);
+                } else {
+                    return static_cast<Agent&>(agent).handle_batch(batch);
+                }
+            });
+    }
+}
+
+// ============================================================================
+// TypedAgent - CRTP 정적 디스패치
+// ============================================================================
+// 처리 타입 목록 Msgs로 타입 ID 비교를 컴파일 타임에 펼치고 Derived::on(const T&)을 직접 호출.
+// on은 bool(false = 처리 안 함) 또는 void(항상 처리) 반환, 목록에 없는 타입은 on_unhandled로.
+// 스케줄러 진입점 process_messages만 가상이고 방문 안의 메시지별 디스패치는 인라인 가능.
+//
+//     class Motor : public mini_so::TypedAgent<Motor, MotorCommand, ControlTick> {
+//     public:
+//         void on(const MotorCommand& cmd) noexcept;
+//         bool on(const ControlTick& tick) noexcept;
+//     };
+template<typename Derived, typename... Msgs>
+class TypedAgent : public Agent {
+    static_assert(sizeof...(Msgs) > 0, "TypedAgent needs at least one message type");
+    static_assert(((detail::type_count<Msgs, Msgs...>() == 1) && ...), "Each message type may appear only once");
+    
+public:
+    // StaticEnvironment 경로 결정용
+    using handled_messages = MessageList<Msgs...>;
+    
+    using Agent::process_messages;
+    
+    // 방문 1회 - Derived 타입으로 직접 디스패치 (메시지마다 vtable을 거치지 않음)
+    void process_messages(uint32_t max_messages) noexcept override {
+        detail::process_static(derived(), max_messages);
+    }
+    
+    // 런타임 경로(외부에서 Agent&로 호출)용 - 같은 정적 디스패치
+    bool handle_message(const MessageBase& msg) noexcept override {
+        return dispatch(msg);
+    }
+    
+    std::size_t handle_batch(Span<const MessageBase* const> batch) noexcept override {
+        std::size_t handled = 0;
+        for (const MessageBase* msg : batch) {
+            if (dispatch(*msg)) {
+                handled++;
+            }
+        }
+        return handled;
+    }
+    
+    // 목록에 없는 타입 (Derived에서 같은 이름으로 가려 재정의)
+    bool on_unhandled(const MessageBase&) noexcept { return false; }
+    
+protected:
+    bool dispatch(const MessageBase& msg) noexcept {
+        const MessageId type_id = msg.type_id();
+        bool handled = false;
+        const bool matched = ((type_id == MESSAGE_TYPE_ID(Msgs) && (handled = invoke<Msgs>(msg), true)) || ...);
+        return matched ? handled : derived().on_unhandled(msg);
+    }
+    
+private:
+    Derived& derived() noexcept { return static_cast<Derived&>(*this); }
+    
+    template<typename T>
+    bool invoke(const MessageBase& msg) noexcept {
+        const T& data = static_cast<const Message<T>&>(msg).data;
+        if constexpr (std::is_same_v<decltype(derived().on(data)), bool>) {
+            return derived().on(data);
+        } else {
+            derived().on(data);
+            return true;
+        }
+    }
+};
+
+// Static Environment - 토폴로지가 고정된 펌웨어용 컴파일 타임 배선.
+// Agent를 tuple로 직접 소유하며 ID = 타입 목록 순서 (등록/해제/뮤텍스 없음).
+// handled_messages를 선언한 Agent로 향하는 send<T>/publish<T>는 대상이 컴파일 타임에 정해져
+// 메일박스 push가 인라인되고, 디스패치는 구체 타입 핸들러를 직접 호출.
+// Agent 편의 메서드(Agent::send_message 등)는 전역 Environment로 가므로 정적 배선 안에서는 env의 send 사용.
+template<typename... StaticAgents>
+class StaticEnvironment {
+    static_assert(detail::all_valid_agents<StaticAgents...>(), 
+                  "All template parameters must be valid Agent types");
+    static_assert(sizeof...(StaticAgents) > 0, "StaticEnvironment needs at least one agent");
+    static_assert(sizeof...(StaticAgents) <= MINI_SO_MAX_AGENTS,
+                  "Too many static agents defined");
+    static_assert(((detail::type_count<StaticAgents, StaticAgents...>() == 1) && ...),
+                  "Each agent type may appear only once");
+    static_assert((std::is_default_constructible_v<StaticAgents> && ...),
+                  "Static agents are constructed in place and must be default constructible");
+    
+private:
+    using Agents = std::tuple<StaticAgents...>;
+    using Indices = std::index_sequence_for<StaticAgents...>;
+    
+    Agents agents_;
+    detail::ReadySet ready_;
+    static inline bool env_initialized_ = false;
+    
+    template<typename T>
+    static constexpr std::size_t handler_count() noexcept {
+        return (std::size_t{0} + ... + (detail::agent_handles<StaticAgents, T>() ? 1 : 0));
+    }
+    
+public:
+    static constexpr std::size_t AGENT_COUNT = sizeof...(StaticAgents);
+    
+    StaticEnvironment() noexcept {
+        bind_agents(Indices{});
+    }
+    
+    StaticEnvironment(const StaticEnvironment&) = delete;
+    StaticEnvironment& operator=(const StaticEnvironment&) = delete;
+    
+    // 컴파일 타임 ID / Agent 접근
+    template<typename A>
+    static constexpr AgentId id_of() noexcept {
+        static_assert(detail::type_count<A, StaticAgents...>() == 1, "Agent type must be in the StaticAgents list");
+        return static_cast<AgentId>(detail::first_true<std::is_same_v<A, StaticAgents>...>());
+    }
+    
+    template<typename A>
+    A& agent() noexcept { return std::get<A>(agents_); }
+    
+    template<typename A>
+    const A& agent() const noexcept { return std::get<A>(agents_); }
+    
+    Agent* get_agent(AgentId id) noexcept {
+        Agent* found = nullptr;
+        with_agent(id, [&found](Agent& agent) noexcept { found = &agent; });
+        return found;
+    }
+    
+    // 대상 Agent 타입 지정: 대상 메일박스 슬롯에 직접 생성 (ID 조회 없음)
+    template<typename Target, typename T, typename... Args>
+    bool send_to(AgentId sender_id, Args&&... args) noexcept {
+        static_assert(detail::type_count<Target, StaticAgents...>() == 1, "Target must be in the StaticAgents list");
+        static_assert(!detail::declares_handled_messages<Target>::value || detail::agent_handles<Target, T>(),
+                      "Target does not list this message in handled_messages");
+        return emplace_into<T>(std::get<Target>(agents_), sender_id, std::forward<Args>(args)...);
+    }
+    
+    // handled_messages로 T를 선언한 유일한 Agent에게 전송 (경로는 컴파일 타임에 결정)
+    template<typename T, typename... Args>
+    bool send(AgentId sender_id, Args&&... args) noexcept {
+        static_assert(handler_count<T>() == 1,
+                      "send<T> needs exactly one agent listing T in handled_messages (use send_to or publish)");
+        constexpr std::size_t index = detail::first_true<detail::agent_handles<StaticAgents, T>()...>();
+        return emplace_into<T>(std::get<index>(agents_), sender_id, std::forward<Args>(args)...);
+    }
+    
+    // T를 선언한 모든 Agent에게 전송 (발신자 제외). 반환: 전달 수
+    template<typename T>
+    std::size_t publish(AgentId sender_id, const T& message) noexcept {
+        static_assert(handler_count<T>() > 0, "No agent lists this message in handled_messages");
+        return publish_to(sender_id, message, Indices{});
+    }
+    
+    // 런타임 ID 경로 (기존 호환) - ID → 타입은 컴파일 타임에 펼친 비교
+    template<typename T>
+    bool send_message(AgentId sender_id, AgentId target_id, const T& message) noexcept {
+        return send_emplace<T>(sender_id, target_id, message);
+    }
+    
+    template<typename T, typename... Args>
+    bool send_emplace(AgentId sender_id, AgentId target_id, Args&&... args) noexcept {
+        bool sent = false;
+        with_agent(target_id, [&](auto& agent) noexcept {
+            sent = emplace_into<T>(agent, sender_id, std::forward<Args>(args)...);
+        });
+        return sent;
+    }
+    
+    template<typename T>
+    void broadcast_message(AgentId sender_id, const T& message) noexcept {
+        for_each_agent([&](AgentId id, auto& agent) noexcept {
+            if (id != sender_id) emplace_into<T>(agent, sender_id, message);
+        });
+    }
+    
+    // Phase 2.2: 풀링된 메시지 전송 (Zero-allocation)
+    template<typename T>
+    bool send_pooled_message(AgentId sender_id, AgentId target_id, const T& message) noexcept {
+        Agent* receiver = nullptr;
+        with_agent(target_id, [&](Agent& agent) noexcept {
+            receiver = detail::push_pooled(agent, sender_id, message);
+        });
+        if (!receiver) [[unlikely]] {
+            return false;
+        }
+        detail::mark_message_priority<T>(*receiver);
+        return true;
+    }
+    
+    // 공유 payload 한 개를 모든 Agent 메일박스가 핸들로 참조
+    template<typename T>
+    void broadcast_pooled_message(AgentId sender_id, const T& message) noexcept {
+        detail::fan_out_shared(sender_id, message, [&](auto&& deliver) noexcept {
+            for_each_agent([&](AgentId id, Agent& agent) noexcept {
+                if (id != sender_id) deliver(agent);
+            });
+        });
+    }
+    
+    // 스케줄링: Environment와 같은 ReadySet 규칙 (상위 클래스 우선, 클래스당 MINI_SO_PRIORITY_QUANTUM)
+    bool process_one_message() noexcept {
+        for (std::size_t level = 0; level < detail::ReadySet::LEVELS; ++level) {
+            if (run_ready_agent(level)) return true;
+        }
+        return false;
+    }
+    
+    void process_all_messages() noexcept {
+        while (run_ready_round()) {
+        }
+    }
+    
+    void run() noexcept {
+        process_all_messages();
+    }
+    
+    bool initialize() noexcept {
+        if (env_initialized_) {
+            return true;
+        }
+        env_initialized_ = true;
+        return true;
+    }
+    
+    constexpr std::size_t agent_count() const noexcept { return AGENT_COUNT; }
+    
+    std::size_t total_pending_messages() const noexcept {
+        return std::apply([](const auto&... agent) noexcept {
+            return (std::size_t{0} + ... + agent.message_queue_.size());
+        }, agents_);
+    }
+    
+private:
+    template<std::size_t... Is>
+    void bind_agents(std::index_sequence<Is...>) noexcept {
+        ((std::get<Is>(agents_).initialize(static_cast<AgentId>(Is)),
+          std::get<Is>(agents_).message_queue_.bind_ready_set(&ready_, Is)), ...);
+    }
+    
+    template<typename T, typename A, typename... Args>
+    static bool emplace_into(A& agent, AgentId sender_id, Args&&... args) noexcept {
+        Agent* receiver = detail::deliver_in_place<T>(agent, [&](void* where) noexcept {
+            auto* typed_msg = new (where) Message<T>(sender_id, std::forward<Args>(args)...);
+            typed_msg->mark_sent();
+            return typed_msg;
+        });
+        if (!receiver) [[unlikely]] {
+            return false;
+        }
+        detail::mark_message_priority<T>(*receiver);
+        return true;
+    }
+    
+    template<typename T, std::size_t... Is>
+    std::size_t publish_to(AgentId sender_id, const T& message, std::index_sequence<Is...>) noexcept {
+        std::size_t delivered = 0;
+        auto deliver = [&](auto index, auto& agent) noexcept {
+            using A = std::remove_reference_t<decltype(agent)>;
+            if constexpr (detail::agent_handles<A, T>()) {
+                if (decltype(index)::value != sender_id && emplace_into<T>(agent, sender_id, message)) {
+                    delivered++;
+                }
+            }
+        };
+        (deliver(std::integral_constant<std::size_t, Is>{}, std::get<Is>(agents_)), ...);
+        return delivered;
+    }
+    
+    // id의 Agent를 구체 타입으로 fn에 전달. 반환: id가 유효했는지
+    template<typename Fn>
+    bool with_agent(AgentId id, Fn&& fn) noexcept {
+        return with_agent(id, fn, Indices{});
+    }
+    
+    template<typename Fn, std::size_t... Is>
+    bool with_agent(AgentId id, Fn& fn, std::index_sequence<Is...>) noexcept {
+        return ((id == Is && (fn(std::get<Is>(agents_)), true)) || ...);
+    }
+    
+    template<typename Fn>
+    void for_each_agent(Fn&& fn) noexcept {
+        for_each_agent(fn, Indices{});
+    }
+    
+    template<typename Fn, std::size_t... Is>
+    void for_each_agent(Fn& fn, std::index_sequence<Is...>) noexcept {
+        (fn(static_cast<AgentId>(Is), std::get<Is>(agents_)), ...);
+    }
+    
+    // level 클래스에서 ready Agent 하나를 꺼내 구체 타입으로 방문
+    bool run_ready_agent(std::size_t level) noexcept {
+        std::size_t index;
+        while (ready_.take_next(level, index)) {
+            if (visit_ready(index, level, Indices{})) return true;
+        }
+        return false;
+    }
+    
+    template<std::size_t... Is>
+    bool visit_ready(std::size_t index, std::size_t level, std::index_sequence<Is...>) noexcept {
+        return ((index == Is && visit(std::get<Is>(agents_), Is, level)) || ...);
+    }
+    
+    template<typename A>
+    bool visit(A& agent, std::size_t index, std::size_t level) noexcept {
+        // 디스패처로 옮겨간 Agent의 늦은 비트는 무시
+        if (!agent.message_queue_.bound_to(&ready_)) [[unlikely]] return false;
+        
+        // 승격 방문은 현재 대기 중인 메시지 수만큼 (detail::visit_agent와 같은 규칙)
+        const uint32_t max_messages = level < static_cast<std::size_t>(agent.priority())
+            ? static_cast<uint32_t>(agent.message_queue_.size())
+            : agent.quantum_messages();
+        detail::process_static(agent, max_messages);
+        if (agent.has_messages()) {
+            ready_.mark(index, static_cast<std::size_t>(agent.priority()));
+        }
+        return true;
+    }
+    
+    bool run_ready_round() noexcept {
+        for (std::size_t level = 0; level < detail::ReadySet::LEVELS; ++level) {
+            if (!ready_.any(level)) continue;
+            
+            bool processed = false;
+            for (std::size_t visit_count = 0; visit_count < MINI_SO_PRIORITY_QUANTUM; ++visit_count) {
+                if (!run_ready_agent(level)) break;
+                processed = true;
+            }
+            if (processed) return true;
+        }
+        return false;
+    }
+};
+
+// ============================================================================
+// Mbox - 타입별 구독자 비트맵 (publish/subscribe)
+// ============================================================================
+// 메시지 타입마다 구독 Agent 비트맵을 유지해 발행 시 관심 있는 Agent에게만 전달.
+// 타입 슬롯은 open addressing 해시 테이블 - 첫 구독 시 CAS로 점유되며 해제되지 않음
+// (구독자가 0이 되어도 슬롯 유지). 조회/구독/해제 모두 lock-free, 할당 없음.
+template<std::size_t MaxTypes>
+class BasicMbox {
+public:
+    static constexpr std::size_t WORD_BITS = 32;
+    static constexpr std::size_t WORDS = (MINI_SO_MAX_AGENTS + WORD_BITS - 1) / WORD_BITS;
+    static constexpr std::size_t MAX_TYPES = MaxTypes;
+    
+    BasicMbox() noexcept {
+        for (auto& entry : entries_) {
+            entry.type.store(INVALID_MESSAGE_ID, std::memory_order_relaxed);
+        }
+    }
+    
+    // false: 타입 슬롯 부족 (MINI_SO_MAX_SUBSCRIBED_TYPES 증가 필요) 또는 잘못된 id
+    // 구독 비트는 슬롯 인덱스 기준 (detail::agent_index) - 세대 검증은 Environment가 담당
+    bool subscribe(MessageId type, AgentId agent) noexcept {
+        const std::size_t index = detail::agent_index(agent);
+        if (index >= MINI_SO_MAX_AGENTS) [[unlikely]] return false;
+        Entry* entry = insert(type);
+        if (!entry) [[unlikely]] return false;
+        entry->subscribers[index / WORD_BITS].fetch_or(1u << (index % WORD_BITS), std::memory_order_acq_rel);
+        return true;
+    }
+    
+    void unsubscribe(MessageId type, AgentId agent) noexcept {
+        const std::size_t index = detail::agent_index(agent);
+        if (index >= MINI_SO_MAX_AGENTS) [[unlikely]] return;
+        if (Entry* entry = find(type)) {
+            entry->subscribers[index / WORD_BITS].fetch_and(~(1u << (index % WORD_BITS)), std::memory_order_acq_rel);
+        }
+    }
+    
+    // Agent 등록 해제 시 모든 타입에서 제거
+    // 사용자 Mbox도 슬롯이 재사용되기 전에 호출해야 새 Agent가 옛 구독을 물려받지 않음
+    void unsubscribe_all(AgentId agent) noexcept {
+        const std::size_t index = detail::agent_index(agent);
+        if (index >= MINI_SO_MAX_AGENTS) [[unlikely]] return;
+        for (auto& entry : entries_) {
+            entry.subscribers[index / WORD_BITS].fetch_and(~(1u << (index % WORD_BITS)), std::memory_order_acq_rel);
+        }
+    }
+    
+    bool is_subscribed(MessageId type, AgentId agent) const noexcept {
+        const std::size_t index = detail::agent_index(agent);
+        if (index >= MINI_SO_MAX_AGENTS) [[unlikely]] return false;
+        const Entry* entry = find(type);
+        return entry && (entry->subscribers[index / WORD_BITS].load(std::memory_order_acquire) &
+                         (1u << (index % WORD_BITS))) != 0;
+    }
+    
+    // 이 타입을 한 번이라도 구독한 적이 있는지 (구독 기반 broadcast 전환 기준)
+    bool has_topic(MessageId type) const noexcept {
+        return find(type) != nullptr;
+    }
+    
+    std::size_t subscriber_count(MessageId type) const noexcept {
+        const Entry* entry = find(type);
+        if (!entry) return 0;
+        std::size_t count = 0;
+        for (const auto& word : entry->subscribers) {
+            for (uint32_t bits = word.load(std::memory_order_acquire); bits; bits &= bits - 1) {
+                ++count;
+            }
+        }
+        return count;
+    }
+    
+    // 구독자 스냅샷을 순회 - fn(슬롯 인덱스). 반환: 호출 횟수
+    template<typename Fn>
+    std::size_t for_each_subscriber(MessageId type, Fn&& fn) const noexcept {
+        const Entry* entry = find(type);
+        if (!entry) return 0;
+        std::size_t visited = 0;
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            for (uint32_t bits = entry->subscribers[w].load(std::memory_order_acquire); bits; bits &= bits - 1) {
+                fn(static_cast<AgentId>(w * WORD_BITS + static_cast<std::size_t>(__builtin_ctz(bits))));
+                ++visited;
+            }
+        }
+        return visited;
+    }
+    
+private:
+    struct Entry {
+        std::atomic<MessageId> type;
+        std::array<std::atomic<uint32_t>, WORDS> subscribers{};
+    };
+    
+    // 타입 ID 해시 위치부터 선형 탐사 (빈 슬롯을 만나면 미구독 타입)
+    const Entry* find(MessageId type) const noexcept {
+        if (type == INVALID_MESSAGE_ID) [[unlikely]] return nullptr;
+        for (std::size_t probe = 0; probe < MaxTypes; ++probe) {
+            const Entry& entry = entries_[(type + probe) % MaxTypes];
+            const MessageId current = entry.type.load(std::memory_order_acquire);
+            if (current == type) return &entry;
+            if (current == INVALID_MESSAGE_ID) return nullptr;
+        }
+        return nullptr;
+    }
+    
+    Entry* find(MessageId type) noexcept {
+        return const_cast<Entry*>(static_cast<const BasicMbox*>(this)->find(type));
+    }
+    
+    // 빈 슬롯을 CAS로 점유 - 동시에 같은 타입을 넣으면 한쪽이 상대 슬롯을 사용
+    Entry* insert(MessageId type) noexcept {
+        if (type == INVALID_MESSAGE_ID) [[unlikely]] return nullptr;
+        for (std::size_t probe = 0; probe < MaxTypes; ++probe) {
+            Entry& entry = entries_[(type + probe) % MaxTypes];
+            MessageId current = entry.type.load(std::memory_order_acquire);
+            if (current == INVALID_MESSAGE_ID &&
+                entry.type.compare_exchange_strong(current, type, std::memory_order_acq_rel)) {
+                return &entry;
+            }
+            if (current == type) return &entry;
+        }
+        return nullptr;
+    }
+    
+    std::array<Entry, MaxTypes> entries_;
+};
+
+using Mbox = BasicMbox<MINI_SO_MAX_SUBSCRIBED_TYPES>;
+
+// ============================================================================
+// Timer Wheel - 지연/주기 메시지 (계층형 타이밍 휠)
+// ============================================================================
+namespace detail {
+    // 4단계 × 64슬롯 휠 (now() 틱 단위). 노드는 정적 풀의 이중 연결 리스트로
+    // 슬롯에 매달리므로 arm/cancel은 O(1), 할당 없음. advance()는 경과 틱마다
+    // 상위 단계 슬롯을 하위로 내리고(cascade) 0단계 슬롯의 타이머를 발사.
+    // 발사는 advance()를 호출한 태스크(Environment::run)에서 send_message로 수행.
+    class TimerWheel {
+    public:
+        static constexpr std::size_t SLOT_BITS = 6;
+        static constexpr std::size_t SLOTS = std::size_t{1} << SLOT_BITS;
+        static constexpr std::size_t LEVELS = 4;
+        static constexpr std::size_t MAX_TIMERS = MINI_SO_MAX_TIMERS;
+        static constexpr std::size_t PAYLOAD_SIZE = MINI_SO_TIMER_PAYLOAD_SIZE;
+        static constexpr Duration MAX_DELAY = 0x7FFFFFFFu;  // wrap-safe 비교 한도
+        
+        static_assert(MAX_TIMERS > 0 && MAX_TIMERS < 0xFFFF, "MINI_SO_MAX_TIMERS must be 1..65534");
+        
+        // payload(T)를 대상에게 전송 - 타입별 템플릿 함수 포인터
+        using Post = bool (*)(Environment& env, AgentId sender_id, AgentId target_id, const void* payload) noexcept;
+        
+        TimerWheel() noexcept;
+        ~TimerWheel() noexcept;
+        
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+        
+        // delay 후 첫 발사, period > 0이면 이후 period마다 반복. 노드 고갈 시 INVALID_TIMER_ID
+        TimerId arm(AgentId sender_id, AgentId target_id, Post post, const void* payload,
+                    std::size_t size, Duration delay, Duration period) noexcept;
+        bool cancel(TimerId id) noexcept;
+        void cancel_target(AgentId target_id) noexcept;  // Agent 등록 해제 시
+        
+        // 휠 시간을 current까지 진행하고 만료된 타이머를 발사 - 반환: 발사 수
+        std::size_t advance(Environment& env, TimePoint current) noexcept;
+        
+        std::size_t active() const noexcept { return active_; }
+        
+        // 가장 이른 만료까지 남은 틱 (타이머가 없으면 false) - 노드 풀 순회 O(MAX_TIMERS)
+        bool next_expiry(TimePoint current, Duration& remaining) noexcept;
+        
+    private:
+        static constexpr uint16_t NIL = 0xFFFF;
+        
+        struct Node {
+            alignas(8) uint8_t payload[PAYLOAD_SIZE];
+            Post post = nullptr;          // nullptr = 빈 노드
+            TimePoint expiry = 0;
+            Duration period = 0;
+            AgentId sender_id = INVALID_AGENT_ID;
+            AgentId target_id = INVALID_AGENT_ID;
+            uint16_t prev = NIL;
+            uint16_t next = NIL;
+            uint16_t generation = 0;
+            uint16_t bucket = NIL;        // level * SLOTS + slot, NIL = 슬롯에 없음
+        };
+        
+        void link(uint16_t index) noexcept;
+        void unlink(uint16_t index) noexcept;
+        void release(uint16_t index) noexcept;
+        void cascade(std::size_t level) noexcept;
+        std::size_t expire_current(Environment& env) noexcept;
+        
+        std::array<Node, MAX_TIMERS> nodes_;
+        std::array<uint16_t, LEVELS * SLOTS> heads_;
+        uint16_t free_ = NIL;
+        TimePoint current_ = 0;
+        std::size_t active_ = 0;
+        SemaphoreHandle_t mutex_;
+        MutexStorage mutex_storage_;
+    };
+    
+    template<typename T>
+    bool post_timer_message(Environment& env, AgentId sender_id, AgentId target_id, const void* payload) noexcept;
+}
+
+// ============================================================================
+// ISR Mailbox - 인터럽트에서 보낸 메시지의 지연 전달 (deferred dispatch)
+// ============================================================================
+namespace detail {
+    // 고정 슬롯 MPSC ring (슬롯별 sequence). 생산자는 ISR(중첩 가능) 또는 태스크, 소비자는
+    // Environment::run을 호출하는 태스크 하나. 생산자는 뮤텍스/블록/할당 없이 tail CAS 한 번으로
+    // 슬롯을 잡고 payload 복사 후 sequence로 게시 - CAS 재시도는 더 높은 우선순위 ISR이 끼어든
+    // 경우뿐이라 중첩 깊이로 제한됨. 가득 차면 즉시 false.
+    // drain()은 게시 순서대로 타이머와 같은 Post 함수(send_message)로 대상 메일박스에 전달.
+    class IsrMailbox {
+    public:
+        static constexpr std::size_t SLOTS = MINI_SO_ISR_QUEUE_SIZE;
+        static constexpr std::size_t PAYLOAD_SIZE = MINI_SO_ISR_PAYLOAD_SIZE;
+        
+        static_assert(SLOTS >= 2 && (SLOTS & (SLOTS - 1)) == 0, "MINI_SO_ISR_QUEUE_SIZE must be a power of two >= 2");
+        
+        using Post = TimerWheel::Post;
+        
+        IsrMailbox() noexcept {
+            for (std::size_t i = 0; i < SLOTS; ++i) {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        
+        IsrMailbox(const IsrMailbox&) = delete;
+        IsrMailbox& operator=(const IsrMailbox&) = delete;
+        
+        // ISR/태스크 어디서나 호출 가능 (wait 없음)
+        bool push(AgentId sender_id, AgentId target_id, Post post, const void* payload, std::size_t size) noexcept {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            Slot* slot;
+            for (;;) {
+                slot = &slots_[pos & MASK];
+                const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+                if (diff == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) [[unlikely]] {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;  // 소비자가 아직 비우지 않은 슬롯 - 가득 참
+                } else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+            
+            std::memcpy(slot->payload, payload, size);
+            slot->post = post;
+            slot->sender_id = sender_id;
+            slot->target_id = target_id;
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+        
+        bool pending() const noexcept {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            return slots_[head & MASK].sequence.load(std::memory_order_acquire) == head + 1;
+        }
+        
+        // 게시된 메시지를 대상 메일박스로 전달 - 반환: 꺼낸 수. 다른 태스크가 비우는 중이면 0
+        std::size_t drain(Environment& env) noexcept {
+            if (draining_.exchange(true, std::memory_order_acquire)) [[unlikely]] return 0;
+            std::size_t head = head_.load(std::memory_order_relaxed);
+            std::size_t drained = 0;
+            for (;;) {
+                Slot& slot = slots_[head & MASK];
+                if (slot.sequence.load(std::memory_order_acquire) != head + 1) break;
+                slot.post(env, slot.sender_id, slot.target_id, slot.payload);  // 해제된 대상이면 false로 버림
+                slot.sequence.store(head + SLOTS, std::memory_order_release);
+                ++head;
+                ++drained;
+            }
+            head_.store(head, std::memory_order_relaxed);
+            draining_.store(false, std::memory_order_release);
+            return drained;
+        }
+        
+        uint32_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+        
+    private:
+        static constexpr std::size_t MASK = SLOTS - 1;
+        
+        struct Slot {
+            alignas(8) uint8_t payload[PAYLOAD_SIZE];
+            Post post = nullptr;
+            AgentId sender_id = INVALID_AGENT_ID;
+            AgentId target_id = INVALID_AGENT_ID;
+            std::atomic<std::size_t> sequence{0};  // == pos: 빈 슬롯, == pos + 1: 게시됨
+        };
+        
+        std::array<Slot, SLOTS> slots_;
+        alignas(64) std::atomic<std::size_t> tail_{0};  // 생산자 예약 위치
+        alignas(64) std::atomic<std::size_t> head_{0};  // 소비 위치 (drain 전용)
+        std::atomic<bool> draining_{false};
+        std::atomic<uint32_t> dropped_{0};              // 가득 차서 거부된 수
+    };
+}
+
+// ============================================================================
+// Latency Histograms - enqueue→dispatch 지연과 핸들러 시간 분포
+// ============================================================================
+// Log-linear 히스토그램: 2의 거듭제곱 구간(octave)마다 2^SubBits개의 선형 버킷.
+// 상대 오차 ≤ 2^-SubBits, 값 2^MaxBits 이상은 마지막 버킷에 포함.
+// record()는 relaxed atomic 증가 하나 (여러 디스패처 워커에서 동시에 기록 가능).
+template<std::size_t SubBits = 3, std::size_t MaxBits = 24>
+class LogLinearHistogram {
+    static_assert(SubBits >= 1 && SubBits < MaxBits && MaxBits <= 32, "Invalid histogram resolution");
+    
+public:
+    static constexpr std::size_t SUB_BUCKETS = std::size_t{1} << SubBits;
+    static constexpr std::size_t BUCKETS = (MaxBits - SubBits + 1) * SUB_BUCKETS;
+    
+    void record(uint32_t value) noexcept {
+        counts_[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+        uint32_t seen = max_.load(std::memory_order_relaxed);
+        while (value > seen && !max_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+        }
+    }
+    
+    uint32_t count() const noexcept { return total_.load(std::memory_order_relaxed); }
+    uint32_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+    
+    // per_mille 분위 값의 상한 (500 = p50, 990 = p99, 999 = p99.9). 기록이 없으면 0
+    uint32_t value_at(uint32_t per_mille) const noexcept {
+        const uint64_t total = count();
+        if (total == 0) return 0;
+        
+        const uint64_t rank = (total * per_mille + 999) / 1000;  // 올림
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= rank && seen > 0) {
+                const uint32_t upper = bucket_upper(i);
+                return upper < max() ? upper : max();
+            }
+        }
+        return max();
+    }
+    
+    uint32_t p50() const noexcept { return value_at(500); }
+    uint32_t p99() const noexcept { return value_at(990); }
+    uint32_t p999() const noexcept { return value_at(999); }
+    
+    void reset() noexcept {
+        for (auto& bucket : counts_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        total_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+    
+    // 버킷 i에 들어가는 최대값 (내보내기/출력용)
+    static constexpr uint32_t bucket_upper(std::size_t i) noexcept {
+        if (i < 2 * SUB_BUCKETS) return static_cast<uint32_t>(i);
+        const std::size_t shift = i / SUB_BUCKETS - 1;
+        const uint64_t mantissa = i - shift * SUB_BUCKETS;  // [SUB_BUCKETS, 2 * SUB_BUCKETS)
+        const uint64_t upper = ((mantissa + 1) << shift) - 1;
+        return upper > 0xFFFFFFFFu ? 0xFFFFFFFFu : static_cast<uint32_t>(upper);
+    }
+    
+    uint32_t bucket_count(std::size_t i) const noexcept {
+        return i < BUCKETS ? counts_[i].load(std::memory_order_relaxed) : 0;
+    }
+    
+private:
+    // 상위 SubBits+1 비트로 버킷 결정: index = shift * SUB + (value >> shift)
+    static constexpr std::size_t bucket_of(uint32_t value) noexcept {
+        if (value < 2 * SUB_BUCKETS) return value;
+        const std::size_t msb = 31 - static_cast<std::size_t>(__builtin_clz(value));
+        if (msb >= MaxBits) return BUCKETS - 1;
+        const std::size_t shift = msb - SubBits;
+        return shift * SUB_BUCKETS + (value >> shift);
+    }
+    
+    std::array<std::atomic<uint32_t>, BUCKETS> counts_{};
+    std::atomic<uint32_t> total_{0};
+    std::atomic<uint32_t> max_{0};
+};
+
+using LatencyHistogram = LogLinearHistogram<>;
+
+// 큐 대기(enqueue→dispatch)와 핸들러 실행 시간 쌍 (단위: 마이크로초, hires 클럭)
+struct LatencyProfile {
+    LatencyHistogram queue;
+    LatencyHistogram handler;
+    
+    void reset() noexcept {
+        queue.reset();
+        handler.reset();
+    }
+};
+
+// Agent별, 메시지 타입별 LatencyProfile. 타입 슬롯은 첫 기록 시 CAS로 점유되며
+// MINI_SO_LATENCY_TYPES를 넘는 타입은 Agent별 히스토그램에만 기록됨.
+class LatencyMonitor {
+public:
+    LatencyMonitor() noexcept {
+        for (auto& type : types_) {
+            type.store(INVALID_MESSAGE_ID, std::memory_order_relaxed);
+        }
+    }
+    
+    void record(AgentId agent_id, MessageId type_id, Duration queue_latency, Duration handler_time) noexcept {
+        const std::size_t index = detail::agent_index(agent_id);
+        if (index < MINI_SO_MAX_AGENTS) [[likely]] {
+            agents_[index].queue.record(queue_latency);
+            agents_[index].handler.record(handler_time);
+        }
+        if (LatencyProfile* profile = type_profile(type_id, true)) {
+            profile->queue.record(queue_latency);
+            profile->handler.record(handler_time);
+        }
+    }
+    
+    const LatencyProfile* agent(AgentId agent_id) const noexcept {
+        const std::size_t index = detail::agent_index(agent_id);
+        return index < MINI_SO_MAX_AGENTS ? &agents_[index] : nullptr;
+    }
+    
+    // 기록된 적 없는 타입이면 nullptr
+    const LatencyProfile* type(MessageId type_id) const noexcept {
+        return const_cast<LatencyMonitor*>(this)->type_profile(type_id, false);
+    }
+    
+    template<typename T>
+    const LatencyProfile* type() const noexcept { return type(MESSAGE_TYPE_ID(T)); }
+    
+    void reset() noexcept {
+        for (auto& profile : agents_) profile.reset();
+        for (auto& profile : type_profiles_) profile.reset();
+    }
+    
+    // 슬롯이 새 Agent에 재사용될 때 이전 Agent의 분포를 비움
+    void reset_agent(AgentId agent_id) noexcept {
+        const std::size_t index = detail::agent_index(agent_id);
+        if (index < MINI_SO_MAX_AGENTS) agents_[index].reset();
+    }
+    
+private:
+    LatencyProfile* type_profile(MessageId type_id, bool insert) noexcept {
+        if (type_id == INVALID_MESSAGE_ID) [[unlikely]] return nullptr;
+        for (std::size_t probe = 0; probe < MINI_SO_LATENCY_TYPES; ++probe) {
+            const std::size_t slot = (type_id + probe) % MINI_SO_LATENCY_TYPES;
+            MessageId current = types_[slot].load(std::memory_order_acquire);
+            if (current == INVALID_MESSAGE_ID && insert &&
+                types_[slot].compare_exchange_strong(current, type_id, std::memory_order_acq_rel)) {
+                return &type_profiles_[slot];
+            }
+            if (current == type_id) return &type_profiles_[slot];
+            if (current == INVALID_MESSAGE_ID) return nullptr;
+        }
+        return nullptr;
+    }
+    
+    std::array<LatencyProfile, MINI_SO_MAX_AGENTS> agents_;
+    std::array<std::atomic<MessageId>, MINI_SO_LATENCY_TYPES> types_;
+    std::array<LatencyProfile, MINI_SO_LATENCY_TYPES> type_profiles_;
+};
+
+// ============================================================================
+// Environment - Phase 3: Zero-overhead 환경 관리 (SIOF-Safe)
+// ============================================================================
+namespace detail {
+    class DispatcherBase;
+}
+
+// Agent 묶음 (SObjectizer coop): Environment::register_coop가 한 번의 잠금으로 전부 등록하거나
+// 전부 실패하고, deregister_coop가 자식 coop부터 한 번에 해제. coop와 Agent는 해제될 때까지 살아 있어야 함
+class Cooperation {
+public:
+    static constexpr std::size_t MAX_AGENTS = MINI_SO_COOP_MAX_AGENTS;
+    static constexpr Duration NO_WATCHDOG = 0;
+    
+    Cooperation() noexcept = default;
+    Cooperation(const Cooperation&) = delete;
+    Cooperation& operator=(const Cooperation&) = delete;
+    
+    // 등록 전에만 추가 가능. watchdog_timeout_ms > 0이면 등록 시 Watchdog 감시도 함께 시작
+    bool add(Agent& agent, Duration watchdog_timeout_ms = NO_WATCHDOG) noexcept {
+        if (registered_ || count_ >= MAX_AGENTS) [[unlikely]] {
+            return false;
+        }
+        agents_[count_] = &agent;
+        watchdog_ms_[count_] = watchdog_timeout_ms;
+        ids_[count_] = INVALID_AGENT_ID;
+        ++count_;
+        return true;
+    }
+    
+    constexpr bool registered() const noexcept { return registered_; }
+    constexpr std::size_t size() const noexcept { return count_; }
+    constexpr Agent* agent(std::size_t i) const noexcept { return i < count_ ? agents_[i] : nullptr; }
+    // 등록된 동안의 i번째 Agent ID (add 순서)
+    constexpr AgentId agent_id(std::size_t i) const noexcept { return i < count_ ? ids_[i] : INVALID_AGENT_ID; }
+    constexpr Cooperation* parent() const noexcept { return parent_; }
+    
+private:
+    friend class Environment;
+    
+    std::array<Agent*, MAX_AGENTS> agents_{};
+    std::array<AgentId, MAX_AGENTS> ids_{};
+    std::array<Duration, MAX_AGENTS> watchdog_ms_{};
+    uint8_t count_ = 0;
+    bool registered_ = false;
+    Cooperation* parent_ = nullptr;
+    Cooperation* first_child_ = nullptr;   // 등록 중인 자식 coop (단일 연결)
+    Cooperation* next_sibling_ = nullptr;
+};
+
+#if MINI_SO_ENABLE_LAZY_AGENTS
+// 지연 활성화 Agent 저장소: 정적 버퍼에서 bump 할당 (해제 없음). 대부분 활성화되지 않는 Agent들이
+// 공유하면 동시에 활성화될 크기만큼만 RAM을 잡음 - 모자라면 활성화가 실패하고 그 전송도 실패
+class LazyArenaBase {
+public:
+    LazyArenaBase(const LazyArenaBase&) = delete;
+    LazyArenaBase& operator=(const LazyArenaBase&) = delete;
+    
+    void* allocate(std::size_t size, std::size_t align) noexcept {
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(bytes_);
+        std::size_t offset = used_.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::size_t start = static_cast<std::size_t>(((base + offset + align - 1) & ~(align - 1)) - base);
+            if (start + size > capacity_) [[unlikely]] {
+                failures_.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            if (used_.compare_exchange_weak(offset, start + size, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+                return bytes_ + start;
+            }
+        }
+    }
+    
+    std::size_t used() const noexcept { return used_.load(std::memory_order_relaxed); }
+    constexpr std::size_t capacity() const noexcept { return capacity_; }
+    uint32_t failures() const noexcept { return failures_.load(std::memory_order_relaxed); }
+
+protected:
+    LazyArenaBase(uint8_t* bytes, std::size_t capacity) noexcept : bytes_(bytes), capacity_(capacity) {}
+    ~LazyArenaBase() = default;
+
+private:
+    uint8_t* bytes_;
+    std::size_t capacity_;
+    std::atomic<std::size_t> used_{0};
+    std::atomic<uint32_t> failures_{0};
+};
+
+template<std::size_t Bytes>
+class LazyArena : public LazyArenaBase {
+public:
+    LazyArena() noexcept : LazyArenaBase(bytes_, Bytes) {}
+
+private:
+    alignas(64) uint8_t bytes_[Bytes];
+};
+
+// Ts를 모두 활성화할 수 있는 LazyArena 크기 (타입마다 정렬 여유 포함)
+template<typename... Ts>
+constexpr std::size_t lazy_arena_bytes() noexcept {
+    return (std::size_t{0} + ... + (sizeof(Ts) + alignof(Ts) - 1));
+}
+
+// 지연 활성화 Agent 자리: register_lazy가 ID를 먼저 배정하고, 그 ID로 첫 메시지가 전달될 때
+// (send/publish 구독/타이머 발사/ISR 전달/Router 선택) 전송하는 문맥에서 Agent를 생성해 슬롯에 올림.
+// 활성화 전에는 Agent 객체도 메일박스도 없음. 한 번 활성화되면 해제 후에도 객체는 남음 (재등록 시 재사용)
+class LazyAgent {
+public:
+    LazyAgent(const LazyAgent&) = delete;
+    LazyAgent& operator=(const LazyAgent&) = delete;
+    
+    constexpr AgentId id() const noexcept { return id_; }
+    bool active() const noexcept { return state_.load(std::memory_order_acquire) == ACTIVE; }
+    Agent* agent() const noexcept { return active() ? agent_ : nullptr; }
+    // 생성 실패 횟수 (저장소 부족, 메일박스 없음) - 실패한 전달마다 다시 시도
+    uint32_t failures() const noexcept { return failures_.load(std::memory_order_relaxed); }
+
+protected:
+    LazyAgent() noexcept = default;
+    virtual ~LazyAgent() = default;
+    
+    // 저장소에 Agent 생성 (등록 전) - nullptr = 실패
+    virtual Agent* construct() noexcept = 0;
+    virtual void destroy(Agent& agent) noexcept = 0;
+
+private:
+    friend class Environment;
+    enum : uint8_t { IDLE, ACTIVATING, ACTIVE };
+    
+    std::atomic<uint8_t> state_{IDLE};
+    std::atomic<uint32_t> failures_{0};
+    Agent* agent_ = nullptr;
+    AgentId id_ = INVALID_AGENT_ID;
+};
+
+template<typename T>
+class Lazy final : public LazyAgent {
+    static_assert(std::is_base_of_v<Agent, T>, "Lazy<T> requires an Agent type");
+    static_assert(std::is_nothrow_default_constructible_v<T>, "Lazy agents are default-constructed on activation");
+
+public:
+    // 생성 직후, 슬롯에 올리기 전에 호출 - 메일박스 저장소, quantum, 수신 필터 등 (전송은 아직 불가)
+    using Setup = void (*)(T& agent) noexcept;
+    
+    explicit Lazy(LazyArenaBase& arena, Setup setup = nullptr) noexcept : arena_(arena), setup_(setup) {}
+    ~Lazy() override {
+        if (T* agent = get()) agent->~T();
+    }
+    
+    T* get() const noexcept { return static_cast<T*>(agent()); }
+
+private:
+    Agent* construct() noexcept override {
+        void* storage = arena_.allocate(sizeof(T), alignof(T));
+        if (!storage) [[unlikely]] return nullptr;
+        T* agent = new (storage) T();
+        if (setup_) setup_(*agent);
+        return agent;
+    }
+    void destroy(Agent& agent) noexcept override { static_cast<T&>(agent).~T(); }
+    
+    LazyArenaBase& arena_;
+    Setup setup_;
+};
+#endif
+
+class Environment {
+private:
+    // 세대 태그 슬롯 맵: agents_/generations_는 슬롯 인덱스로, live_는 살아있는 슬롯만 조밀하게
+    alignas(64) std::array<Agent*, MINI_SO_MAX_AGENTS> agents_;
+    std::array<uint16_t, MINI_SO_MAX_AGENTS> generations_{};  // 슬롯별 현재 세대
+    std::array<uint16_t, MINI_SO_MAX_AGENTS> free_{};         // 빈 슬롯 스택 (pop 순서 0, 1, 2, ...)
+    std::array<uint16_t, MINI_SO_MAX_AGENTS> live_{};         // 살아있는 슬롯 인덱스 (broadcast 순회)
+    std::array<uint16_t, MINI_SO_MAX_AGENTS> live_pos_{};     // 슬롯 -> live_ 위치 (O(1) 제거)
+    std::size_t free_count_ = 0;
+    std::size_t live_count_ = 0;
+#if MINI_SO_ENABLE_LAZY_AGENTS
+    std::array<LazyAgent*, MINI_SO_MAX_AGENTS> lazy_{};      // register_lazy 예약 (해제까지, 활성화 전 agents_는 nullptr)
+#endif
+    MailboxPoolBase* mailbox_pool_ = nullptr;  // 저장소 없는 Agent에 등록 시 메일박스 배정
+    SemaphoreHandle_t mutex_;
+    detail::MutexStorage mutex_storage_;
+    detail::ReadySet ready_;  // 메시지가 있는 Agent 비트맵 (디스패처에 묶이지 않은 Agent)
+    Mbox mbox_;               // 기본 타입 Mbox (subscribe/publish, 구독 기반 broadcast)
+    detail::RateLimiter rate_limits_;  // 발신자/구독 토큰 버킷 (전송 경로에서 메일박스 전에 평가)
+    detail::TimerWheel timers_;  // send_delayed/send_periodic (run()에서 진행)
+    detail::IsrMailbox isr_;     // send_from_isr (run()에서 대상 메일박스로 전달)
+    std::atomic<bool> stop_requested_{false};  // run_forever() 종료 요청
+#if MINI_SO_ENABLE_LATENCY_HISTOGRAMS
+    LatencyMonitor latency_;  // Agent::process_messages가 메시지마다 기록
+#endif
+    
+    friend class detail::DispatcherBase;  // Agent를 디스패처 ReadySet으로 옮길 때 사용
+    
+    // 슬롯 관리 (mutex_ 안에서): 빈 슬롯에 agent 배정해 인덱스 반환 / 슬롯 해제와 ID 무효화
+    std::size_t claim_slot(Agent* agent) noexcept;
+    void release_slot(std::size_t index) noexcept;
+    // 잠금 밖: 배정된 슬롯의 Agent 초기화와 ReadySet 연결
+    void activate_slot(std::size_t index, Agent& agent) noexcept;
+    // 저장소 없는 Agent에 풀 블록 연결 (등록 전) / 해제된 Agent의 풀 블록 반납
+    bool attach_pooled_mailbox(Agent& agent) noexcept;
+    void detach_pooled_mailbox(Agent& agent) noexcept;
+#if MINI_SO_ENABLE_LAZY_AGENTS
+    // 예약된 지연 Agent를 생성해 슬롯에 올림 (첫 전달 시) - 실패면 nullptr
+    Agent* activate_lazy(std::size_t index) noexcept;
+#endif
+    
+    // Phase 3: 성능 통계 (조건부 컴파일)
+#if MINI_SO_ENABLE_METRICS
+    uint64_t total_messages_sent_ = 0;     // 64-bit for long-term operation
+    uint64_t total_messages_processed_ = 0; // 64-bit for long-term operation
+    uint32_t max_processing_time_us_ = 0;
+    uint32_t runs_since_collect_ = 0;  // PerformanceAgent 카운터 수집 주기
+#endif
+    
+    friend class System;
+    System* system_ = nullptr;  // 이 Environment의 System (System 생성자가 연결)
+    
+public:
+    // 독립 Environment (코어/서브시스템별): 자기 슬롯 표, ReadySet, 타이머, 수신함, 카운터를 가짐.
+    // 다른 Environment의 Agent에는 RemoteMailbox로 보냄. 정적 수명으로 둘 것 (Agent가 포인터를 보관)
+    Environment() noexcept;
+    ~Environment() noexcept;
+    Environment(const Environment&) = delete;
+    Environment& operator=(const Environment&) = delete;
+    
+    // SIOF-Safe Pure Meyers' Singleton (기본 Environment)
+    static Environment& instance() noexcept {
+        static Environment env;
+        return env;
+    }
+    
+    // SIOF-Safe 초기화
+    bool initialize() noexcept;
+    
+    // Phase 3: noexcept Agent 관리
+    AgentId register_agent(Agent* agent) noexcept;
+    void unregister_agent(AgentId id) noexcept;
+    Agent* get_agent(AgentId id) noexcept;
+    
+    // 이 Environment의 System - 없으면 nullptr (기본 Environment는 System::instance())
+    System* system() noexcept;
+    
+    // 메일박스 저장소가 없는 Agent(mailbox_bytes() == 0)에 등록 시 블록을 배정할 풀 - 첫 등록 전에.
+    // 블록이 모자라면 그 등록이 실패. 해제 시 반납되므로 그 Agent로 보내는 태스크가 없을 때 해제할 것
+    void set_mailbox_pool(MailboxPoolBase* pool) noexcept { mailbox_pool_ = pool; }
+    MailboxPoolBase* mailbox_pool() const noexcept { return mailbox_pool_; }
+    
+    // Cooperation: 빈 슬롯이 모자라거나 메일박스 저장소를 얻지 못한 Agent가 있으면 아무것도 등록하지 않음.
+    // parent가 있으면 등록된 coop여야 하고, 부모를 해제하면 이 coop도 먼저 해제됨
+    bool register_coop(Cooperation& coop, Cooperation* parent = nullptr) noexcept;
+    // 자식 coop → 자신 순서로 해제. drain이면 해제 전에 대기 메시지를 호출 태스크에서 처리
+    // (최대 MINI_SO_COOP_DRAIN_ROUNDS 라운드, 그 뒤 남은 메시지는 버림)
+    void deregister_coop(Cooperation& coop, bool drain = true) noexcept;
+    
+#if MINI_SO_ENABLE_LAZY_AGENTS
+    // 지연 활성화 Agent 예약: ID를 바로 배정하고 첫 메시지 전달 시 생성 (해제는 unregister_agent).
+    // 이미 활성화된 적 있는 lazy는 남아 있는 객체를 바로 등록
+    AgentId register_lazy(LazyAgent& lazy) noexcept;
+#endif
+    
+    // Phase 3: Zero-overhead 메시지 라우팅
+    template<typename T>
+    bool send_message(AgentId sender_id, AgentId target_id, const T& message) noexcept;
+    
+    // 제자리 전송: Message<T>(sender, args...)를 대상 메일박스 레코드에 직접 생성
+    template<typename T, typename... Args>
+    bool send_emplace(AgentId sender_id, AgentId target_id, Args&&... args) noexcept;
+    
+    // 대기 없는 전송: 가득 차면 과부하 정책(BLOCK 포함)을 적용하지 않고 바로 QUEUE_FULL,
+    // MUTEX 메일박스 잠금도 기다리지 않음 (BUSY)
+    template<typename T>
+    SendResult try_send(AgentId sender_id, AgentId target_id, const T& message) noexcept {
+        return send_for(sender_id, target_id, message, 0);
+    }
+    
+    // 한도 있는 전송: 가득 차면 과부하 정책 대신 timeout(틱)까지 공간을 기다림
+    // (MUTEX 메일박스는 push 시도마다 잠금도 timeout까지)
+    template<typename T>
+    SendResult send_for(AgentId sender_id, AgentId target_id, const T& message, TickType_t timeout) noexcept;
+    
+    template<typename T>
+    void broadcast_message(AgentId sender_id, const T& message) noexcept;
+    
+    // 구독: 기본 Mbox에 타입 T 구독 등록 (false = 구독 타입 슬롯 부족)
+    template<typename T>
+    bool subscribe(AgentId agent_id) noexcept {
+        return live_slot(agent_id) && mbox_.subscribe(MESSAGE_TYPE_ID(T), agent_id);
+    }
+    
+    template<typename T>
+    void unsubscribe(AgentId agent_id) noexcept { mbox_.unsubscribe(MESSAGE_TYPE_ID(T), agent_id); }
+    
+    Mbox& default_mbox() noexcept { return mbox_; }
+    
+    // 토큰 버킷 한도 (MINI_SO_MAX_RATE_LIMITS): sender/receiver/type의 INVALID_AGENT_ID/INVALID_MESSAGE_ID는 "모두".
+    // 발신자 (sender, INVALID, INVALID), 발신자+타입 (sender, INVALID, T), 구독 (INVALID, receiver, T).
+    // 초과 메시지는 메일박스 전에 버리거나(SHED) 대기 중인 값과 합침(COALESCE). 같은 키면 교체(버킷 가득 참).
+    // 한도 Agent가 해제되면 함께 제거. false: 표가 가득 참, 등록되지 않은 Agent, 키가 모두 "모두"
+    bool set_rate_limit(AgentId sender, AgentId receiver, MessageId type, const RateLimit& limit) noexcept {
+        if ((sender != INVALID_AGENT_ID && !live_slot(sender)) ||
+            (receiver != INVALID_AGENT_ID && !live_slot(receiver))) [[unlikely]] {
+            return false;
+        }
+        return rate_limits_.set(sender, receiver, type, limit);
+    }
+    void clear_rate_limit(AgentId sender, AgentId receiver, MessageId type) noexcept {
+        rate_limits_.remove(sender, receiver, type);
+    }
+    bool rate_limit_stats(AgentId sender, AgentId receiver, MessageId type, ThrottleStats& out) const noexcept {
+        return rate_limits_.stats(sender, receiver, type, out);
+    }
+    // 모든 한도가 메일박스 전에 거부한 메시지 수 (버림 + 교체)
+    uint32_t throttled() const noexcept { return rate_limits_.throttled(); }
+    detail::RateLimiter& rate_limits() noexcept { return rate_limits_; }
+    
+    // 발행: T 구독자에게만 전달 (구독한 발신자 자신 포함) - 반환: 전달된 수
+    template<typename T>
+    std::size_t publish(AgentId sender_id, const T& message) noexcept { return publish(mbox_, sender_id, message); }
+    
+    // 사용자 정의 Mbox로 발행 (Agent 그룹별 채널)
+    template<typename T, std::size_t MaxTypes>
+    std::size_t publish(const BasicMbox<MaxTypes>& mbox, AgentId sender_id, const T& message) noexcept;
+    
+    // 공유 payload 발행: 구독자 메일박스에는 참조 카운트 핸들만 저장
+    template<typename T>
+    std::size_t publish_pooled(AgentId sender_id, const T& message) noexcept {
+        return detail::fan_out_shared(sender_id, message, [&](auto&& deliver) noexcept {
+            mbox_.for_each_subscriber(MESSAGE_TYPE_ID(T), [&](AgentId target) noexcept {
+                if (Agent* agent = slot_agent(target)) deliver(*agent);
+            });
+        });
+    }
+    
+    // 지연 전송: delay 틱 후 target에게 message 복사본 전송 (run()/process_timers()에서 발사)
+    template<typename T>
+    TimerId send_delayed(AgentId sender_id, AgentId target_id, const T& message, Duration delay) noexcept {
+        return arm_timer(sender_id, target_id, message, delay, 0);
+    }
+    
+    // 주기 전송: delay 후 첫 전송, 이후 period마다 (만료 시각 기준이라 드리프트 없음)
+    template<typename T>
+    TimerId send_periodic(AgentId sender_id, AgentId target_id, const T& message, Duration period) noexcept {
+        return arm_timer(sender_id, target_id, message, period, period);
+    }
+    
+    template<typename T>
+    TimerId send_periodic(AgentId sender_id, AgentId target_id, const T& message,
+                          Duration delay, Duration period) noexcept {
+        return arm_timer(sender_id, target_id, message, delay, period);
+    }
+    
+    bool cancel_timer(TimerId id) noexcept { return timers_.cancel(id); }
+    
+    // ISR 안전 전송: 대기 없이 인터럽트 메일박스에 복사하고 대기 중인 Environment 루프 태스크를
+    // 깨움. 대상 메일박스 전달은 그 태스크의 다음 run()에서 수행. 가득 찼거나 대상이 없으면 false.
+    // higher_priority_woken이 nullptr이면 직접 portYIELD_FROM_ISR 호출, 아니면 값만 누적
+    // (ISR 안에서 여러 번 보내고 마지막에 한 번 yield할 때)
+    template<typename T>
+    bool send_from_isr(AgentId sender_id, AgentId target_id, const T& message,
+                       BaseType_t* higher_priority_woken = nullptr) noexcept;
+    
+    // 다른 Environment(다른 코어의 태스크)에서 이 Environment의 Agent로 보냄 - RemoteMailbox::send가 호출.
+    // ISR 수신함에 넣고 대기 중인 루프 태스크를 깨움. 대상 확인은 전달(run) 때 (해제된 대상이면 버림)
+    template<typename T>
+    bool send_remote(AgentId sender_id, AgentId target_id, const T& message) noexcept;
+    
+    // ISR 메일박스에 쌓인 메시지를 대상 메일박스로 전달 (run()이 매 루프 호출) - 반환: 전달 수
+    std::size_t process_isr_messages() noexcept { return isr_.pending() ? isr_.drain(*this) : 0; }
+    uint32_t isr_dropped() const noexcept { return isr_.dropped(); }
+    
+    // 만료된 타이머 발사 (run()이 매 루프 호출) - 반환: 발사 수
+    std::size_t process_timers() noexcept {
+        return timers_.active() > 0 ? timers_.advance(*this, now()) : 0;  // 타이머가 없으면 시계도 읽지 않음
+    }
+    std::size_t active_timers() const noexcept { return timers_.active(); }
+    
+    // 메시지 이미지(Message<T>의 바이트 복사본, size = sizeof(Message<T>))를 타입 없이 그대로 전송 -
+    // 프로세스 간 전송처럼 T를 모르는 경로용. 과부하 시 대상 Agent의 정책만 적용
+    // (MessageOverload<T>/MessagePriority<T>는 적용되지 않음)
+    bool send_raw(AgentId target_id, const MessageBase& message, uint16_t size) noexcept;
+    
+    // 배치 전송: 메일박스 구간을 한 번에 예약해 메시지를 제자리 생성
+    // 반환값 < messages.size()이면 메일박스가 가득 차서 앞에서부터 일부만 전송됨
+    template<typename T>
+    std::size_t send_batch(AgentId sender_id, AgentId target_id, Span<const T> messages) noexcept;
+    
+    template<typename T, std::size_t N>
+    std::size_t send_batch(AgentId sender_id, AgentId target_id, const std::array<T, N>& messages) noexcept {
+        return send_batch(sender_id, target_id, Span<const T>(messages));
+    }
+    
+    // Phase 2.2: 풀링된 메시지 전송 (Zero-allocation)
+    template<typename T>
+    bool send_pooled_message(AgentId sender_id, AgentId target_id, const T& message) noexcept {
+        Agent* target = route(live_agent(target_id), sender_id, &message);
+        if (!target) [[unlikely]] {
+            return false;
+        }
+        
+        Agent* receiver = detail::push_pooled(*target, sender_id, message);
+        if (!receiver) [[unlikely]] {
+            return false;
+        }
+        detail::mark_message_priority<T>(*receiver);
+        return true;
+    }
+    
+    // 기한 메시지: 전송 시각(header timestamp) + budget_us까지 처리되어야 하는 메시지. 대상 스케줄러는
+    // 기한 메시지가 대기 중인 Agent를 가장 이른 기한 순(EDF)으로 우선순위 클래스보다 먼저 방문하고,
+    // 기한을 넘겨 디스패치되면 Agent::deadline_misses에 집계한 뒤 on_miss에 따라 전달/폐기/보고.
+    // MessageCoalesce<T>/TypedMailbox를 거치지 않는 일반 레코드 (트레일러만큼 큼)
+    template<typename T>
+    bool send_with_deadline(AgentId sender_id, AgentId target_id, const T& message, Duration budget_us,
+                            DeadlineMiss on_miss = DeadlineMiss::DELIVER) noexcept {
+        static_assert(sizeof(Message<T>) <= MINI_SO_MAX_MESSAGE_SIZE, "Message too large");
+        Agent* target = route(live_agent(target_id), sender_id, &message);
+        if (!target || !detail::receive_accepts(*target, message, sender_id)) [[unlikely]] {
+            return false;
+        }
+        
+#if MINI_SO_ENABLE_METRICS
+        total_messages_sent_++;
+#endif
+        const HiresTime sent = hires_now();
+        const HiresTime deadline = sent + hires_from_us(budget_us);
+        Message<T> msg(message, sender_id);
+        msg.header.set_sent_at(sent);
+        constexpr uint16_t size = sizeof(Message<T>);
+        Agent* receiver = detail::deliver<T>(*target, &msg, size, [&](Agent& agent) noexcept {
+            return agent.message_queue_.push_deadline(msg, size, deadline, on_miss);
+        });
+        if (!receiver) [[unlikely]] {
+            return false;
+        }
+        detail::mark_message_priority<T>(*receiver);
+        return true;
+    }
+    
+    // 소유권 이전 버퍼 전송: 메일박스에는 블록 핸들만 저장 (payload 복사 없음).
+    // 성공 시 buffer는 비워지고 블록은 수신 측 핸들러가 끝나면 풀로 반환, 실패 시 호출자가 계속 소유
+    template<typename T>
+    bool send_buffer(AgentId sender_id, AgentId target_id, UniqueBuffer<T>&& buffer) noexcept {
+        detail::BufferBlock<T>* block = buffer.block();
+        Agent* target = route(live_agent(target_id), sender_id);
+        if (!block || !target) [[unlikely]] {
+            return false;
+        }
+        
+        block->header.set_sender(sender_id);
+        block->mark_sent();
+        if (!detail::push_buffer(*target, block)) [[unlikely]] {
+            return false;
+        }
+        buffer.reset();
+        return true;
+    }
+    
+    // 받은 버퍼(BufferRef::from)를 다음 단계로 전달 - 헤더(원 발신자, 타임스탬프)는 그대로
+    template<typename T>
+    bool send_buffer(AgentId target_id, BufferRef<T>&& buffer) noexcept {
+        detail::BufferBlock<T>* block = buffer.block();
+        Agent* target = block ? route(live_agent(target_id), block->header.sender()) : nullptr;
+        if (!block || !target) [[unlikely]] {
+            return false;
+        }
+        
+        if (!detail::push_buffer(*target, block)) [[unlikely]] {
+            return false;
+        }
+        buffer.reset();
+        return true;
+    }
+    
+    // 버퍼 발행: T 구독자 메일박스마다 같은 블록 핸들 (수신 측은 읽기 전용으로 다룸).
+    // 한 곳 이상 전달되면 buffer는 비워짐 - 반환: 전달 수
+    template<typename T>
+    std::size_t publish_buffer(AgentId sender_id, UniqueBuffer<T>&& buffer) noexcept {
+        detail::BufferBlock<T>* block = buffer.block();
+        if (!block) [[unlikely]] {
+            return 0;
+        }
+        
+        block->header.set_sender(sender_id);
+        block->mark_sent();
+        const std::size_t delivered = publish_block(block);
+        if (delivered > 0) buffer.reset();
+        return delivered;
+    }
+    
+    // 받은 버퍼를 구독자에게 다시 발행 - 헤더는 그대로
+    template<typename T>
+    std::size_t publish_buffer(BufferRef<T>&& buffer) noexcept {
+        detail::BufferBlock<T>* block = buffer.block();
+        if (!block) [[unlikely]] {
+            return 0;
+        }
+        
+        const std::size_t delivered = publish_block(block);
+        if (delivered > 0) buffer.reset();
+        return delivered;
+    }
+    
+    // 타입 T에 구독이 있으면 구독자(발신자 제외)에게만, 없으면 모든 Agent에게 전송
+    // payload는 공유 풀 슬롯 하나, 각 메일박스에는 참조 카운트 핸들만 저장
+    template<typename T>
+    void broadcast_pooled_message(AgentId sender_id, const T& message) noexcept {
+        constexpr MessageId type = MESSAGE_TYPE_ID(T);
+        detail::fan_out_shared(sender_id, message, [&](auto&& deliver) noexcept {
+            if (mbox_.has_topic(type)) {
+                mbox_.for_each_subscriber(type, [&](AgentId target) noexcept {
+                    if (slot_id(target) == sender_id) return;
+                    if (Agent* agent = route(slot_agent(target), sender_id, &message)) deliver(*agent);
+                });
+                return;
+            }
+            for_each_agent([&](AgentId id, Agent& agent) noexcept {
+                if (id != sender_id && !agent.as_router()) deliver(agent);
+            });
+        });
+    }
+    
+    // Phase 3: 최적화된 시스템 실행
+    bool process_one_message() noexcept;
+    void process_all_messages() noexcept;
+    void run() noexcept;  // 통합된 고성능 루프
+    
+    // Tickless idle 루프: run() 후 처리할 Agent가 없으면 메시지 도착, 가장 이른 타이머
+    // 만료, 워치독 점검 시점, timeout 중 먼저 오는 때까지 task notification으로 블록.
+    // 깨어나면 run()을 한 번 더 수행. 반환: timeout 전에 깨어났으면 true
+    bool run_until_idle(TickType_t timeout = portMAX_DELAY) noexcept;
+    void run_forever() noexcept;   // request_stop()까지 run_until_idle 반복
+    void request_stop() noexcept;  // 다른 태스크/핸들러에서 호출 가능
+    
+    // 처리할 메시지가 생길 때까지 호출 태스크를 블록 (task notification)
+    bool wait_for_messages(TickType_t timeout = portMAX_DELAY) noexcept { return ready_.wait(timeout); }
+    bool has_ready_agents() const noexcept { return ready_.any(); }
+    
+    // Phase 3: constexpr 상태 조회 - 현재 등록된 Agent 수 (해제된 슬롯 제외)
+    constexpr std::size_t agent_count() const noexcept { return live_count_; }
+    std::size_t total_pending_messages() const noexcept;
+    
+    // 적응형 quantum Agent들이 목표로 하는 스케줄링 라운드 시간 (디스패처 포함 전역, 마이크로초)
+    void set_round_budget_us(uint32_t budget_us) noexcept {
+        detail::round_budget_us().store(budget_us > 0 ? budget_us : 1, std::memory_order_relaxed);
+    }
+    uint32_t round_budget_us() const noexcept { return detail::round_budget_us().load(std::memory_order_relaxed); }
+    
+    // Agent 메일박스 텔레메트리 (미등록 ID면 모두 0)
+    MailboxStats mailbox_stats(AgentId id) const noexcept {
+        const Agent* agent = resident_agent(id);
+        return agent ? agent->mailbox_stats() : MailboxStats{};
+    }
+    // StatusResponse의 메일박스 요약 채우기: high-water 점유율이 가장 높은 Agent, push 실패/포화 시간 합
+    void fill_mailbox_status(system_messages::StatusResponse& response) const noexcept;
+    
+    // 등록된 Agent 순회 - fn(AgentId, Agent&), 순서는 등록/해제에 따라 바뀔 수 있음
+    template<typename Fn>
+    void for_each_agent(Fn&& fn) const noexcept {
+        for (std::size_t i = 0; i < live_count_; ++i) {
+            const std::size_t index = live_[i];
+            if (Agent* agent = agents_[index]) fn(slot_id(index), *agent);
+        }
+    }
+    
+    // Phase 3: 공개 메트릭 접근 (모니터링용)
+#if MINI_SO_ENABLE_METRICS
+    constexpr uint64_t total_messages_sent() const noexcept { return total_messages_sent_; }
+    constexpr uint64_t total_messages_processed() const noexcept { return total_messages_processed_; }
+    constexpr uint32_t max_processing_time_us() const noexcept { return max_processing_time_us_; }
+#endif
+
+#if MINI_SO_ENABLE_LATENCY_HISTOGRAMS
+    LatencyMonitor& latency() noexcept { return latency_; }
+    const LatencyMonitor& latency() const noexcept { return latency_; }
+#endif
+
+private:
+    template<typename T>
+    TimerId arm_timer(AgentId sender_id, AgentId target_id, const T& message,
+                      Duration delay, Duration period) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "Timer messages are copied into the timer node");
+        static_assert(sizeof(T) <= detail::TimerWheel::PAYLOAD_SIZE,
+                      "Timer message too large (increase MINI_SO_TIMER_PAYLOAD_SIZE)");
+        static_assert(alignof(T) <= 8, "Timer message alignment exceeds 8 bytes");
+        
+        if (!live_slot(target_id)) [[unlikely]] {  // 지연 Agent는 발사 시점에 활성화
+            return INVALID_TIMER_ID;
+        }
+        TimerId id = timers_.arm(sender_id, target_id, &detail::post_timer_message<T>,
+                                 &message, sizeof(T), delay, period);
+        if (id != INVALID_TIMER_ID) [[likely]] {
+            ready_.wake_all();  // idle 대기 중이면 새 기한으로 다시 계산
+        }
+        return id;
+    }
+    
+    // 다음 타이머 기한(워치독 heartbeat 기한 포함)과 limit 중 짧은 대기 틱 수
+    TickType_t idle_ticks(TickType_t limit) noexcept;
+    
+    // 버퍼 블록을 T 구독자마다 핸들로 전달 - 반환: 전달 수
+    template<typename T>
+    std::size_t publish_block(detail::BufferBlock<T>* block) noexcept {
+        std::size_t delivered = 0;
+        mbox_.for_each_subscriber(MESSAGE_TYPE_ID(T), [&](AgentId target) noexcept {
+            Agent* agent = slot_agent(target);
+            if (agent && detail::push_buffer(*agent, block)) ++delivered;
+        });
+        return delivered;
+    }
+    
+    // 살아있는 ID면 Agent, 해제됐거나 재사용된 슬롯의 옛 ID면 nullptr (세대 비교 한 번).
+    // 전달 경로용 - 예약만 된 지연 Agent는 여기서 활성화
+    Agent* live_agent(AgentId id) const noexcept {
+        const std::size_t index = detail::agent_index(id);
+        if (index >= MINI_SO_MAX_AGENTS ||
+            generations_[index] != (id >> detail::AGENT_INDEX_BITS)) [[unlikely]] {
+            return nullptr;
+        }
+        return slot_agent(index);
+    }
+    
+    // 전달하지 않는 조회(통계 등)용 - 지연 Agent를 활성화하지 않음
+    Agent* resident_agent(AgentId id) const noexcept {
+        const std::size_t index = detail::agent_index(id);
+        if (index >= MINI_SO_MAX_AGENTS ||
+            generations_[index] != (id >> detail::AGENT_INDEX_BITS)) [[unlikely]] {
+            return nullptr;
+        }
+        return agents_[index];
+    }
+    
+    // 등록 또는 예약된 ID인지 (구독, 타이머/ISR 예약, 해제 - 지연 Agent를 활성화하지 않음)
+    bool live_slot(AgentId id) const noexcept {
+        if (resident_agent(id)) [[likely]] return true;
+#if MINI_SO_ENABLE_LAZY_AGENTS
+        const std::size_t index = detail::agent_index(id);
+        return index < MINI_SO_MAX_AGENTS && generations_[index] == (id >> detail::AGENT_INDEX_BITS) &&
+               lazy_[index] != nullptr;
+#else
+        return false;
+#endif
+    }
+    
+    // 슬롯 인덱스의 Agent (구독자 순회) - 예약만 된 지연 Agent면 활성화.
+    // 지연 슬롯은 lazy의 상태(acquire)로 읽음 - 다른 태스크가 생성한 객체를 완성된 뒤에만 봄
+    Agent* slot_agent(std::size_t index) const noexcept {
+#if MINI_SO_ENABLE_LAZY_AGENTS
+        if (LazyAgent* lazy = lazy_[index]) [[unlikely]] {
+            if (Agent* agent = lazy->agent()) return agent;
+            return const_cast<Environment*>(this)->activate_lazy(index);  // 한 번뿐인 상태 변경 - 조회 API는 const 유지
+        }
+#endif
+        return agents_[index];
+    }
+    
+    // Router 대상이면 살아 있는 worker로 바꿈 (중첩 Router는 MAX_ROUTE_HOPS 단계까지).
+    // 키는 value의 MessageRouteKey<T> (value가 없거나 키 정의가 없으면 발신자 ID)
+    static constexpr std::size_t MAX_ROUTE_HOPS = 4;
+    template<typename T = void>
+    Agent* route(Agent* target, AgentId sender_id, const T* value = nullptr) noexcept {
+        uint32_t key = sender_id;
+        if constexpr (!std::is_void_v<T>) {
+            if constexpr (MessageRouteKey<T>::defined) {
+                if (value) key = MessageRouteKey<T>::key(*value);
+            }
+        }
+        for (std::size_t hop = 0; target && target->as_router() && hop < MAX_ROUTE_HOPS; ++hop) {
+            target = select_worker(*target->as_router(), key);
+        }
+        return target && !target->as_router() ? target : nullptr;
+    }
+    Agent* select_worker(Router& router, uint32_t key) noexcept;
+    
+    AgentId slot_id(std::size_t index) const noexcept {
+        return detail::make_agent_id(index, generations_[index]);
+    }
+    
+    // static 포인터 제거 (InitializationGuard가 상태 관리)
+};
+
+// 다른 Environment에 등록된 Agent의 명시적 주소. 전송은 대상 Environment의 인터럽트 수신함(잠금 없는 MPSC ring)에
+// 복사하고 대상 루프 태스크를 깨울 뿐이라, 발신 코어는 대상의 슬롯 표/메일박스/카운터를 건드리지 않음
+// (공유되는 것은 수신함 tail 한 줄). 대상 메일박스 전달은 대상 run()이 자기 코어에서 수행.
+// send_from_isr와 같은 수신함과 제약 (trivially copyable, MINI_SO_ISR_PAYLOAD_SIZE 이하, 가득 차면 false).
+// 발신자 ID는 발신 Environment 기준 그대로 전달되므로 응답에는 반대 방향 RemoteMailbox를 씀
+namespace detail {
+    inline RateLimiter& rate_limiter(const Agent& target) noexcept { return target.environment().rate_limits(); }
+}
+
+class RemoteMailbox {
+public:
+    constexpr RemoteMailbox() noexcept = default;
+    constexpr RemoteMailbox(Environment& env, AgentId target_id) noexcept : env_(&env), target_id_(target_id) {}
+    
+    template<typename T>
+    bool send(AgentId sender_id, const T& message) const noexcept {
+        return env_ && env_->send_remote(sender_id, target_id_, message);
+    }
+    
+    constexpr Environment* environment() const noexcept { return env_; }
+    constexpr AgentId target_id() const noexcept { return target_id_; }
+    constexpr explicit operator bool() const noexcept { return env_ != nullptr && target_id_ != INVALID_AGENT_ID; }
+
+private:
+    Environment* env_ = nullptr;
+    AgentId target_id_ = INVALID_AGENT_ID;
+};
+
+// ============================================================================
+// Pipeline - 선형 단계 체인의 직접 호출 융합
+// ============================================================================
+// 단계(마지막 제외)는 다음 단계로 보낼 타입의 Outlet<T>를 outlet()으로 노출하고, 핸들러 안에서 send.
+// 두 단계가 같은 배타 실행기(ReadySet::exclusive - Environment::run, OneThreadDispatcher,
+// ThreadPoolDispatcher<1>)에 묶여 있으면 send는 다음 단계 핸들러를 호출 스택에서 바로 부르고
+// (enqueue/memcpy/ready 표시/스캔 없음), 아니면 평소처럼 메일박스로 보냄. 판단은 send마다 하므로
+// 단계를 나중에 다른 디스패처로 bind/unbind해도 그대로 맞음.
+//
+//     class Filter : public mini_so::TypedAgent<Filter, RawSample> {
+//     public:
+//         void on(const RawSample& s) noexcept { out_.send(Filtered{smooth(s)}); }
+//         mini_so::Outlet<Filtered>& outlet() noexcept { return out_; }
+//     private:
+//         mini_so::Outlet<Filtered> out_;
+//     };
+//
+//     mini_so::Pipeline line(sensor, filter, controller, actuator);  // 등록(+bind) 후
+//     line.connect();
+//
+// 직접 호출 조건 (하나라도 아니면 메일박스): 보내는 단계가 지금 방문 중(소비자 역할 점유),
+// 다음 단계가 같은 배타 set에 묶임, 다음 단계 메일박스와 T의 최신 값 cell/타입 전용 메일박스가 비어 있음
+// (앞서 메일박스로 간 메시지보다 먼저 처리되지 않도록), 다음 단계에 T의 수신 필터와 속도 한도가 없음,
+// 다음 단계 소비자 역할을 얻음. 융합된 단계는 앞 단계의 방문 안에서 실행되므로
+// 우선순위/quantum은 적용되지 않고 스택은 단계 수만큼 깊어짐.
+template<typename... Stages>
+class Pipeline;
+
+class OutletBase {
+public:
+    bool connected() const noexcept { return next_ != nullptr; }
+    AgentId target_id() const noexcept { return next_id_; }
+    
+    // 다음 단계가 같은 배타 실행기에 있는지 (메일박스/방문 상태 조건 제외)
+    bool colocated() const noexcept {
+        const Agent* next = next_;
+        if (!next || next->id() != next_id_) return false;
+        const detail::ReadySet* set = owner_->message_queue_.ready_set();
+        return set && set->exclusive() && next->message_queue_.bound_to(set);
+    }
+    
+    uint32_t fused_count() const noexcept { return fused_.load(std::memory_order_relaxed); }
+    uint32_t mailbox_count() const noexcept { return mailed_.load(std::memory_order_relaxed); }
+
+protected:
+    OutletBase() noexcept = default;
+    ~OutletBase() noexcept = default;
+    
+    OutletBase(const OutletBase&) = delete;
+    OutletBase& operator=(const OutletBase&) = delete;
+    
+    // 직접 호출 가능하면 다음 단계 소비자 역할을 잡고 true (leave로 반환)
+    bool try_enter() noexcept {
+        if (!colocated() || !owner_->message_queue_.consumer_locked()) return false;
+        MessageQueue& queue = next_->message_queue_;
+        if (!queue.empty() || !queue.try_lock_consumer()) return false;
+        if (!queue.empty()) [[unlikely]] {  // 잠그는 사이 다른 생산자가 넣음 - 순서 유지
+            queue.unlock_consumer();
+            return false;
+        }
+        return true;
+    }
+    
+    void leave(MessageId type_id, HiresTime start, bool handled) noexcept {
+        Agent& next = *next_;
+        trace::record(handled ? trace::EventKind::HANDLED : trace::EventKind::REJECTED,
+                      type_id, owner_->id(), next.id(), 0);
+        Observer::on_dispatch_end(type_id, next.id(), handled);
+#if MINI_SO_ENABLE_METRICS
+        if (handled) next.count_visit(hires_since_us(start), 1);
+#else
+        (void)start;
+#endif
+        next.message_queue_.unlock_consumer();
+        fused_.store(fused_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    
+    void note_mailbox() noexcept { mailed_.store(mailed_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+    
+    void link(Agent* owner, Agent* next) noexcept {
+        owner_ = owner;
+        next_id_ = next ? next->id() : INVALID_AGENT_ID;
+        next_ = next;
+    }
+    
+    Agent* owner_ = nullptr;
+    Agent* next_ = nullptr;
+    AgentId next_id_ = INVALID_AGENT_ID;
+    // 쓰기는 소유 단계의 핸들러뿐 - RMW 없이 load+store
+    std::atomic<uint32_t> fused_{0};
+    std::atomic<uint32_t> mailed_{0};
+};
+
+template<typename T>
+class Outlet : public OutletBase {
+public:
+    using message_type = T;
+    
+    Outlet() noexcept = default;
+    
+    // 소유 단계의 핸들러 안에서 호출. 반환: 전달됨 (직접 호출했거나 메일박스에 들어감)
+    bool send(const T& data) noexcept {
+        if (invoke_ && fusable() && try_enter()) [[likely]] {
+            const MessageId type_id = MESSAGE_TYPE_ID(T);
+            trace::record(trace::EventKind::DISPATCH, type_id, owner_->id(), next_id_, 0);
+            Observer::on_dispatch_begin(type_id, owner_->id(), next_id_, 0);
+            const HiresTime start = MINI_SO_ENABLE_METRICS ? hires_now() : 0;
+            const bool handled = invoke_(*next_, owner_->id(), data);
+            leave(type_id, start, handled);
+            return true;
+        }
+        if (!owner_ || next_id_ == INVALID_AGENT_ID) [[unlikely]] {
+            return false;
+        }
+        note_mailbox();
+        return owner_->environment().send_message(owner_->id(), next_id_, data);
+    }
+
+private:
+    template<typename... Stages>
+    friend class Pipeline;
+    
+    using Invoke = bool (*)(Agent& next, AgentId sender, const T& data) noexcept;
+    
+    // 전송 경로가 T를 다음 단계에 그대로 넣지 않으면 메일박스 경로: 수신 필터/속도 한도가 있음,
+    // 최신 값 cell이나 타입 전용 메일박스에 아직 처리되지 않은 T가 있음 (직접 호출이 앞지르지 않도록)
+    bool fusable() const noexcept {
+        const Agent* next = next_;
+        if (!next || detail::receive_filter<T>(*next) || detail::rate_limited(*next)) return false;
+        if constexpr (MessageCoalesce<T>::value && detail::LatestCells::CELLS > 0) {
+            if (next->latest_.pending(MESSAGE_TYPE_ID(T))) return false;
+        }
+        if (next->typed_mailboxes_) [[unlikely]] {
+            const detail::TypedMailboxBase* box = next->typed_mailbox(MESSAGE_TYPE_ID(T));
+            if (box && !box->empty()) return false;
+        }
+        return true;
+    }
+    
+    // Next가 TypedAgent처럼 T를 처리 목록에 선언하고 on(const T&)이 공개면 on을 바로 호출 (Message 생성/타입 비교 없음),
+    // 아니면 스택의 Message<T>로 Next::handle_message를 한정 호출 (공개가 아니면 가상 호출)
+    template<typename Next, typename = void>
+    struct has_typed_on : std::false_type {};
+    template<typename Next>
+    struct has_typed_on<Next, std::void_t<decltype(std::declval<Next&>().on(std::declval<const T&>()))>>
+        : std::bool_constant<detail::agent_handles<Next, T>()> {};
+    
+    template<typename Next>
+    static bool invoke(Agent& agent, AgentId sender, const T& data) noexcept {
+        Next& next = static_cast<Next&>(agent);
+        if constexpr (has_typed_on<Next>::value) {
+            if constexpr (std::is_same_v<decltype(next.on(data)), bool>) {
+                return next.on(data);
+            } else {
+                next.on(data);
+                return true;
+            }
+        } else {
+            const Message<T> msg(data, sender);
+            if constexpr (detail::has_public_handler<Next>::value) {
+                return next.Next::handle_message(msg);
+            } else {
+                return agent.handle_message(msg);
+            }
+        }
+    }
+    
+    template<typename Next>
+    void attach(Agent& owner, Next& next) noexcept {
+        invoke_ = &Outlet::invoke<Next>;
+        link(&owner, &next);
+    }
+    
+    void detach() noexcept {
+        link(nullptr, nullptr);
+        invoke_ = nullptr;
+    }
+    
+    Invoke invoke_ = nullptr;
+};
+
+template<typename... Stages>
+class Pipeline {
+    static constexpr std::size_t STAGES = sizeof...(Stages);
+    static_assert(STAGES >= 2, "Pipeline needs at least two stages");
+    static_assert((std::is_base_of_v<Agent, Stages> && ...), "Pipeline stages must be Agents");
+    
+    using Tuple = std::tuple<Stages*...>;
+    template<std::size_t I>
+    using Stage = std::tuple_element_t<I, std::tuple<Stages...>>;
+    template<std::size_t I>
+    using StageOutlet = std::remove_reference_t<decltype(std::declval<Stage<I>&>().outlet())>;
+    template<std::size_t I>
+    using HopMessage = typename StageOutlet<I>::message_type;
+    
+    template<std::size_t... Is>
+    static constexpr bool hops_valid(std::index_sequence<Is...>) noexcept {
+        return ((std::is_base_of_v<Outlet<HopMessage<Is>>, StageOutlet<Is>> &&
+                 (!detail::declares_handled_messages<Stage<Is + 1>>::value ||
+                  detail::agent_handles<Stage<Is + 1>, HopMessage<Is>>())) && ...);
+    }
+    
+public:
+    explicit Pipeline(Stages&... stages) noexcept : stages_(&stages...) {
+        static_assert(hops_valid(std::make_index_sequence<STAGES - 1>{}),
+                      "Each stage but the last needs outlet() returning Outlet<T>&, and T must be handled by the next stage");
+    }
+    
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+    
+    // 단계 출력을 다음 단계에 연결 - 모든 단계가 같은 Environment에 등록된 뒤 호출.
+    // 하나라도 미등록/다른 Environment면 연결하지 않고 false
+    bool connect() noexcept {
+        if (!registered(std::make_index_sequence<STAGES>{})) [[unlikely]] {
+            return false;
+        }
+        connect_hops(std::make_index_sequence<STAGES - 1>{});
+        return true;
+    }
+    
+    // 단계 해제 전에 호출 - 이후 send는 false
+    void disconnect() noexcept { disconnect_hops(std::make_index_sequence<STAGES - 1>{}); }
+    
+    static constexpr std::size_t stage_count() noexcept { return STAGES; }
+    
+    // 지금 직접 호출로 융합되는 구간 수 (0..STAGES-1)
+    std::size_t fused_hops() const noexcept { return fused_hops(std::make_index_sequence<STAGES - 1>{}); }
+
+private:
+    template<std::size_t... Is>
+    bool registered(std::index_sequence<Is...>) const noexcept {
+        Environment& env = std::get<0>(stages_)->environment();
+        return ((std::get<Is>(stages_)->id() != INVALID_AGENT_ID &&
+                 &std::get<Is>(stages_)->environment() == &env &&
+                 env.get_agent(std::get<Is>(stages_)->id()) == std::get<Is>(stages_)) && ...);
+    }
+    
+    template<std::size_t... Is>
+    void connect_hops(std::index_sequence<Is...>) noexcept {
+        (std::get<Is>(stages_)->outlet().attach(*std::get<Is>(stages_), *std::get<Is + 1>(stages_)), ...);
+    }
+    
+    template<std::size_t... Is>
+    void disconnect_hops(std::index_sequence<Is...>) noexcept {
+        (std::get<Is>(stages_)->outlet().detach(), ...);
+    }
+    
+    template<std::size_t... Is>
+    std::size_t fused_hops(std::index_sequence<Is...>) const noexcept {
+        return (std::size_t{0} + ... + (std::get<Is>(stages_)->outlet().colocated() ? 1 : 0));
+    }
+    
+    Tuple stages_;
+};
+
+// ============================================================================
+// Emergency System Recovery - 현대적 Fail-Safe 메커니즘
+// ============================================================================
+namespace emergency {
+    // 크리티컬 실패 원인
+    enum class CriticalFailure : uint32_t {
+        MUTEX_CREATION_FAILED = 0x1001,
+        MEMORY_EXHAUSTION = 0x1002,
+        HEAP_CORRUPTION = 0x1003,
+        FREERTOS_INIT_FAILED = 0x1004,
+        SYSTEM_AGENT_FAILURE = 0x1005
+    };
+    
+    // 실패 컨텍스트 정보
+    struct FailureContext {
+        CriticalFailure reason;
+        const char* file;
+        int line;
+        const char* function;
+        TimePoint timestamp;
+        uint32_t heap_free_bytes;
+        uint32_t stack_usage;
+        char additional_info[64];
+        
+        FailureContext() noexcept 
+            : reason(CriticalFailure::MUTEX_CREATION_FAILED)
+            , file(nullptr)
+            , line(0)
+            , function(nullptr)
+            , timestamp(0)
+            , heap_free_bytes(0)
+            , stack_usage(0) {
+            additional_info[0] = '\0';
+        }
+    };
+    
+    // Emergency mode 상태
+    struct EmergencyState {
+        bool is_active;
+        TimePoint entered_time;
+        uint32_t restart_countdown_ms;
+        bool restart_scheduled;
+        FailureContext last_failure;
+        
+        EmergencyState() noexcept 
+            : is_active(false)
+            , entered_time(0)
+            , restart_countdown_ms(0)
+            , restart_scheduled(false) {}
+    };
+    
+    // 실패 컨텍스트 저장 (Flash 메모리 등에 저장)
+    void save_failure_context(CriticalFailure reason, const char* file, int line, const char* function = nullptr) noexcept;
+    
+    // Emergency mode 진입
+    void enter_emergency_mode() noexcept;
+    
+    // 제어된 재시작 스케줄링
+    void schedule_controlled_restart(uint32_t delay_ms) noexcept;
+    
+    // Emergency mode에서 최소 기능 실행 - 중요 Agent 라운드 하나 후 MINI_SO_EMERGENCY_PERIOD_MS 주기에 맞춰 대기
+    void run_emergency_loop() noexcept;
+    
+    // 시스템 상태 체크
+    bool is_emergency_mode() noexcept;
+    
+    // 마지막 실패 정보 조회
+    const FailureContext& get_last_failure() noexcept;
+    
+    // 실패 로그 출력 (UART 등)
+    void emergency_log_failure(const FailureContext& context) noexcept;
+    
+    // save_failure_context가 로그 출력 뒤 호출 (보존 저장소 기록 등, nullptr = 해제).
+    // 재시작 직전일 수 있으므로 동기적으로 기록해야 함
+    using FailureHook = void (*)(const FailureContext& context) noexcept;
+    void set_failure_hook(FailureHook hook) noexcept;
+    
+    // ---- 비상 디스패치 (degraded mode) ----
+    // 비상 모드 동안 중요 Agent만 정적 전용 메일박스(lock-free MPSC)에서 run_emergency_loop 태스크가 실행.
+    // 전송과 디스패치 모두 Environment 표, 대상 메일박스, 메시지 풀, 라우터/필터/한도, 타이머를 거치지 않음
+    constexpr std::size_t critical_mailbox_bytes() noexcept {
+        if constexpr (MINI_SO_EMERGENCY_MAILBOX_BYTES != 0) {
+            return MINI_SO_EMERGENCY_MAILBOX_BYTES;
+        } else {
+            std::size_t bytes = 1;
+            while (bytes < 2 * (detail::MAILBOX_RECORD_ALIGN + MINI_SO_MAX_MESSAGE_SIZE)) bytes <<= 1;
+            return bytes;
+        }
+    }
+    constexpr std::size_t CRITICAL_MAILBOX_BYTES = critical_mailbox_bytes();
+    static_assert((CRITICAL_MAILBOX_BYTES & (CRITICAL_MAILBOX_BYTES - 1)) == 0 &&
+                  CRITICAL_MAILBOX_BYTES >= detail::MAILBOX_RECORD_ALIGN + MINI_SO_MAX_MESSAGE_SIZE,
+                  "MINI_SO_EMERGENCY_MAILBOX_BYTES must be a power of two holding one MINI_SO_MAX_MESSAGE_SIZE record (0 = auto)");
+    using CriticalMailbox = BasicMessageQueue<QueuePolicy::MPSC, CRITICAL_MAILBOX_BYTES>;
+    
+    // 중요 Agent 지정 (등록 후, 비상 모드 전 설정 단계). 표 순서(먼저 빈 칸) = 라운드 방문 순서.
+    // false: 표가 가득 참(MINI_SO_EMERGENCY_AGENTS), 등록되지 않은 Agent, 같은 ID가 이미 있음
+    bool set_critical(Agent& agent) noexcept;
+    void clear_critical(Agent& agent) noexcept;
+    bool is_critical(AgentId agent_id) noexcept;
+    
+    // send<T> 구현용 - 비상 모드가 아니거나 중요 Agent가 아니면 nullptr
+    CriticalMailbox* critical_mailbox(AgentId agent_id) noexcept;
+    void note_rejected() noexcept;
+    
+    // 비상 경로 전송 (ISR 포함 어느 문맥에서나). 비상 모드 중에만 받으며 전달은 다음 라운드.
+    // false: 비상 모드 아님, 중요 Agent 아님, 전용 메일박스 가득 참
+    template<typename T>
+    bool send(AgentId target_id, const T& message, AgentId sender_id = INVALID_AGENT_ID) noexcept {
+        static_assert(sizeof(Message<T>) + CriticalMailbox::RECORD_HEADER_SIZE <= CRITICAL_MAILBOX_BYTES,
+                      "Message does not fit the emergency mailbox");
+        CriticalMailbox* mailbox = critical_mailbox(target_id);
+        if (!mailbox || mailbox->template emplace<T>(sender_id, message) != QueueResult::SUCCESS) [[unlikely]] {
+            note_rejected();
+            return false;
+        }
+        return true;
+    }
+    
+    struct DegradedStats {
+        uint32_t rounds;          // run_emergency_loop 라운드 수
+        uint32_t delivered;       // 중요 Agent 핸들러에 전달한 메시지
+        uint32_t rejected;        // send 실패 (모드 아님/대상 아님/가득 참)
+        uint32_t deferred;        // 예산 초과 또는 Agent 방문 중이라 다음 라운드로 넘긴 Agent 방문
+        uint32_t max_round_us;    // 가장 긴 라운드 (hires 클럭)
+    };
+    DegradedStats degraded_stats() noexcept;
+}
+
+#if MINI_SO_ENABLE_WARM_RESTART
+// ============================================================================
+// Warm Restart - 보존 RAM 스냅샷으로 재시작 후 수 ms 안에 운용 복귀
+// ============================================================================
+// 이미지: [ImageHeader 16B][Record 4B + payload(4바이트 정렬) ...], CRC-32 범위 = 레코드 영역.
+// run_emergency_loop가 재시작 직전(인터럽트 off) save를 호출하고, 다음 부팅의 Environment 생성자가
+// 이미지를 검증해 한 번만 채택 (채택 즉시 보존 이미지는 무효화 - 이후 콜드 리셋에서 옛 상태 재사용 안 함).
+// 레코드는 AgentId로 찾으므로 부팅마다 같은 순서로 등록해야 함 (정적 펌웨어 구성이면 ID가 같음)
+namespace warm {
+    constexpr uint32_t IMAGE_MAGIC = 0x4D52574Du;  // "MWRM" (리틀 엔디언)
+    constexpr std::size_t IMAGE_BYTES = MINI_SO_WARM_RESTART_BYTES;
+    static_assert(IMAGE_BYTES % 4 == 0 && IMAGE_BYTES >= 8, "MINI_SO_WARM_RESTART_BYTES must be a multiple of 4 (>= 8)");
+    
+    struct ImageHeader {
+        uint32_t magic;
+        uint32_t length;     // 레코드 영역에서 사용한 바이트
+        uint32_t crc;
+        uint16_t records;
+        uint16_t skipped;    // 공간이 모자라 저장하지 못한 Agent 수
+    };
+    
+    struct Record {
+        AgentId agent;
+        uint16_t size;       // payload 바이트 (정렬 패딩 제외)
+    };
+    
+    // 등록된 Agent를 모두 snapshot해 보존 이미지에 기록 - false: 공간이 모자라 일부 Agent를 건너뜀
+    // (저장된 레코드는 유효). 다른 태스크가 Agent 상태를 바꾸지 않는 문맥에서 호출
+    bool save(Environment& env = Environment::instance()) noexcept;
+    
+    // 보존 이미지 검증 후 채택 - 반환: 유효한 이미지 여부. Environment 생성자가 호출하며,
+    // 호스트 시험은 save 뒤 다시 호출해 재부팅을 흉내냄 (이미 등록된 Agent에는 적용되지 않음)
+    bool adopt() noexcept;
+    
+    // 채택한 이미지에서 id 레코드를 agent->restore로 전달 (1회) - Environment 등록 경로가 호출
+    bool restore_agent(AgentId id, Agent& agent) noexcept;
+    
+    bool warm_boot() noexcept;               // 이번 부팅이 유효한 이미지를 채택했는지
+    std::size_t restored_count() noexcept;   // restore가 받아들인 Agent 수
+    std::size_t pending_count() noexcept;    // 아직 등록되지 않은 Agent의 레코드 수
+    void discard() noexcept;                 // 남은 레코드 폐기 (이후 등록은 콜드 시작)
+}
+#endif
+
+// ============================================================================
+// System Services - Phase 3: 순수 Agent 기반 시스템 서비스
+// ============================================================================
+
+// Phase 3: 오류 처리 Agent - 순수 메시지 기반
+class ErrorAgent : public Agent {
+public:
+    struct ErrorEntry {
+        system_messages::ErrorReport::Level level;
+        uint32_t error_code;
+        AgentId source_agent;
+        TimePoint timestamp;
+    };
+    
+    // 로그에 들어간 에러마다 ErrorAgent 컨텍스트에서 호출 (FlightRecorder 등 - 짧게 끝내야 함)
+    using ErrorSink = void (*)(void* context, const ErrorEntry& entry) noexcept;
+    
+private:
+    std::array<ErrorEntry, 32> error_log_;
+    std::size_t error_count_ = 0;
+    std::size_t next_index_ = 0;  // 순환 버퍼 인덱스
+    system_messages::ErrorReport::Level max_level_ = system_messages::ErrorReport::INFO;
+    ErrorSink sink_ = nullptr;
+    void* sink_context_ = nullptr;
+    
+    void log_error(system_messages::ErrorReport::Level level, uint32_t code, AgentId source) noexcept;
+    
+public:
+    bool handle_message(const MessageBase& msg) noexcept override;
+    void report_error(system_messages::ErrorReport::Level level, uint32_t code, AgentId source) noexcept;
+    
+    void set_sink(ErrorSink sink, void* context) noexcept {
+        sink_ = sink;
+        sink_context_ = context;
+    }
+    
+    constexpr std::size_t error_count() const noexcept { return error_count_; }
+    constexpr std::size_t logged_errors() const noexcept { 
+        // 실제 로그된 에러 수 (최대 32개)
+        return std::min(error_count_, error_log_.size()); 
+    }
+    constexpr system_messages::ErrorReport::Level max_level() const noexcept { return max_level_; }
+    constexpr bool is_healthy() const noexcept { return max_level_ <= system_messages::ErrorReport::WARNING; }
+};
+
+// Phase 3: 성능 모니터링 Agent - 고성능 메트릭
+// 디스패치 경로는 Agent 로컬 카운터만 갱신하고, PerformanceAgent가 주기적으로(및 조회 시)
+// 스냅샷을 끌어와 증분을 64비트 합계로 누적. record_performance/PerformanceMetric은 외부 측정용
+class PerformanceAgent : public Agent {
+private:
+    uint32_t max_processing_time_us_ = 0;
+    uint64_t total_messages_ = 0;      // 64-bit for long-term operation (584M years)
+    uint64_t busy_time_us_ = 0;
+    uint32_t cycle_count_ = 0;
+    TimePoint last_report_time_ = 0;
+    
+#if MINI_SO_ENABLE_METRICS
+    // 마지막 수집 시점 Agent별 카운터 (owner가 바뀌면 새 Agent로 보고 0부터)
+    struct Seen {
+        const Agent* owner = nullptr;
+        AgentCounters counters{0, 0, 0, 0};
+    };
+    std::array<Seen, MINI_SO_MAX_AGENTS> seen_{};
+#endif
+    
+public:
+    bool handle_message(const MessageBase& msg) noexcept override;
+    void record_performance(uint32_t processing_time_us, uint32_t message_count) noexcept;
+    
+    // 등록된 모든 Agent의 카운터 증분을 누적 (run()이 MINI_SO_METRICS_COLLECT_RUNS마다 호출)
+    void collect() noexcept;
+    
+    uint32_t max_processing_time_us() noexcept { collect(); return max_processing_time_us_; }
+    uint64_t total_messages() noexcept { collect(); return total_messages_; }
+    uint64_t busy_time_us() noexcept { collect(); return busy_time_us_; }
+    uint32_t cycle_count() noexcept { collect(); return cycle_count_; }
+};
+
+namespace detail {
+    // 감시 대상의 heartbeat 기한 (WatchdogAgent가 타이머 휠로 자신에게 보냄)
+    struct WatchdogDeadline {
+        uint16_t index;  // 감시 슬롯 (agent_index)
+        uint16_t epoch;  // 재등록마다 증가 - 취소와 경합한 옛 기한 무시
+    };
+}
+
+// Phase 3: Watchdog Agent - 효율적 모니터링
+// 감시 대상마다 타이머 휠에 기한 하나. Heartbeat는 AgentId 인덱스로 마지막 시각만 기록하고(O(1), 휠 조작 없음),
+// 기한이 만료되면 그 사이 heartbeat가 있었는지 보고 남은 시간으로 다시 걸거나 타임아웃을 보고.
+// 따라서 기한이 실제로 지나기 전에는 아무 일도 하지 않음 (timeout당 최대 한 번 깨어남).
+// 감시 대상 하나당 타이머 노드 하나(MINI_SO_MAX_TIMERS)를 사용하며 System::initialize() 후 등록해야 함
+class WatchdogAgent : public Agent {
+private:
+    struct MonitoredAgent {
+        AgentId agent_id = INVALID_AGENT_ID;  // INVALID = 빈 슬롯
+        TimePoint last_heartbeat = 0;
+        Duration timeout_ms = 0;
+        TimerId timer = INVALID_TIMER_ID;
+        uint16_t epoch = 0;
+        bool active = false;
+    };
+    
+    std::array<MonitoredAgent, MINI_SO_MAX_AGENTS> monitored_;  // detail::agent_index(id)로 직접 색인
+    std::size_t monitored_count_ = 0;
+    Duration default_timeout_ms_ = 5000;
+    
+    bool arm_deadline(std::size_t index, Duration delay) noexcept;
+    bool on_deadline(const detail::WatchdogDeadline& deadline) noexcept;
+    void report_timeout(MonitoredAgent& agent) noexcept;
+    
+public:
+    bool handle_message(const MessageBase& msg) noexcept override;
+    void register_for_monitoring(AgentId agent_id, Duration timeout_ms = 0) noexcept;
+    void unregister_from_monitoring(AgentId agent_id) noexcept;
+    // 기한 만료를 기다리지 않고 모든 감시 대상을 즉시 점검 (진단용 - 평소에는 타이머가 처리)
+    void check_timeouts() noexcept;
+    
+    constexpr bool is_healthy() const noexcept;
+    constexpr std::size_t monitored_count() const noexcept { return monitored_count_; }
+};
+
+// ============================================================================
+// Initialization Order Management - Phase 3: 컴파일 타임 의존성 해결
+// ============================================================================
+namespace detail {
+    // 초기화 상태 추적
+    enum class InitState : uint8_t {
+        NOT_INITIALIZED = 0,
+        INITIALIZING = 1,
+        INITIALIZED = 2,
+        FAILED = 3
+    };
+    
+    // CRTP 기반 초기화 순서 보장
+    template<typename Derived>
+    class InitializationGuard {
+    private:
+        static inline InitState state_ = InitState::NOT_INITIALIZED;
+        static inline uint32_t init_attempt_count_ = 0;
+        
+    public:
+        static bool is_initialized() noexcept {
+            return state_ == InitState::INITIALIZED;
+        }
+        
+        static bool is_failed() noexcept {
+            return state_ == InitState::FAILED;
+        }
+        
+        static bool ensure_initialized() noexcept {
+            // 이미 초기화됨
+            if (state_ == InitState::INITIALIZED) [[likely]] {
+                return true;
+            }
+            
+            // 실패 상태면 재시도 금지
+            if (state_ == InitState::FAILED) [[unlikely]] {
+                return false;
+            }
+            
+            // 순환 초기화 방지
+            if (state_ == InitState::INITIALIZING) [[unlikely]] {
+                state_ = InitState::FAILED;
+                return false;
+            }
+            
+            // 너무 많은 재시도 방지
+            if (++init_attempt_count_ > 3) [[unlikely]] {
+                state_ = InitState::FAILED;
+                return false;
+            }
+            
+            // 초기화 시작
+            state_ = InitState::INITIALIZING;
+            
+            bool success = Derived::do_initialize();
+            state_ = success ? InitState::INITIALIZED : InitState::FAILED;
+            
+            return success;
+        }
+        
+        static void reset() noexcept {
+            state_ = InitState::NOT_INITIALIZED;
+            init_attempt_count_ = 0;
+        }
+    };
+    
+    // 초기화 의존성 체크
+    template<typename... Dependencies>
+    constexpr bool check_dependencies_initialized() noexcept {
+        return (Dependencies::is_initialized() && ...);
+    }
+    
+    // 의존성 기반 초기화
+    template<typename... Dependencies>
+    bool ensure_dependencies_initialized() noexcept {
+        return (Dependencies::ensure_initialized() && ...);
+    }
+}
+
+// ============================================================================
+// System - Phase 3: SIOF-Safe 시스템 관리자 (의존성 보장)
+// ============================================================================
+class System {
+private:
+    ErrorAgent error_agent_;
+    PerformanceAgent performance_agent_;
+    WatchdogAgent watchdog_agent_;
+    
+    AgentId error_agent_id_ = INVALID_AGENT_ID;
+    AgentId performance_agent_id_ = INVALID_AGENT_ID;
+    AgentId watchdog_agent_id_ = INVALID_AGENT_ID;
+    
+    Environment& env_;
+    bool initialized_ = false;
+    
+public:
+    // Environment마다 하나 - 생성 시 env.system()으로 연결되고, initialize()가 시스템 Agent를 env에 등록
+    explicit System(Environment& env) noexcept : env_(env) { env.system_ = this; }
+    System(const System&) = delete;
+    System& operator=(const System&) = delete;
+    
+    // SIOF-Safe Pure Meyers' Singleton (기본 Environment의 System)
+    static System& instance() noexcept {
+        static System system(Environment::instance());
+        return system;
+    }
+    
+    Environment& environment() const noexcept { return env_; }
+    
+    // SIOF-Safe 초기화 (의존성 보장)
+    bool initialize() noexcept;
+    
+    void shutdown() noexcept;
+    constexpr bool is_initialized() const noexcept { return initialized_; }
+    
+    // Phase 3: 직접 Agent 접근 (Zero-overhead)
+    constexpr ErrorAgent& error() noexcept { return error_agent_; }
+    constexpr PerformanceAgent& performance() noexcept { return performance_agent_; }
+    constexpr WatchdogAgent& watchdog() noexcept { return watchdog_agent_; }
+    
+    // Phase 3: 편의 메서드 (inline으로 Zero-overhead)
+    void report_error(system_messages::ErrorReport::Level level, uint32_t code, AgentId source = INVALID_AGENT_ID) noexcept {
+        error_agent_.report_error(level, code, source);
+    }
+    
+    void record_performance(uint32_t processing_time_us, uint32_t message_count = 1) noexcept {
+        performance_agent_.record_performance(processing_time_us, message_count);
+    }
+    
+    void heartbeat(AgentId agent_id) noexcept {
+        system_messages::Heartbeat hb{agent_id};
+        env_.send_message(agent_id, watchdog_agent_id_, hb);
+    }
+    
+    // Phase 3: 시스템 상태 조회 (constexpr)
+    constexpr bool is_healthy() const noexcept {
+        return error_agent_.is_healthy() && watchdog_agent_.is_healthy();
+    }
+    
+private:
+    // static 포인터 제거 (InitializationGuard가 상태 관리)
+};
+
+// ============================================================================
+// Template Implementations - Phase 3: Zero-overhead 구현
+// ============================================================================
+
+// Message Queue 구현 (용량/정책별 템플릿)
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+constexpr BasicMessageQueue<Policy, CapacityBytes>::BasicMessageQueue() noexcept {
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        mutex_ = detail::create_mutex(mutex_storage_);
+        if (!mutex_) [[unlikely]] {
+            // 현대적 Fail-Safe: 정보 보존 + 제어된 복구
+            emergency::save_failure_context(
+                emergency::CriticalFailure::MUTEX_CREATION_FAILED,
+                __FILE__, __LINE__, __FUNCTION__);
+            
+            emergency::enter_emergency_mode();
+            emergency::schedule_controlled_restart(5000);  // 5초 후 재시작
+            
+            // 최후의 안전 정지 (기존 안전성 유지)
+            taskDISABLE_INTERRUPTS();
+            for(;;);
+        }
+    }
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline BasicMessageQueue<Policy, CapacityBytes>::~BasicMessageQueue() noexcept {
+    if (mutex_) {
+        vSemaphoreDelete(mutex_);
+    }
+}
+
+// 생산자 예약
+//   SPSC/MUTEX: 단일 생산자(또는 뮤텍스 보유)이므로 tail_을 직접 읽음, 게시는 commit에서
+//   MPSC: CAS로 [tail, tail + len) 구간을 선점, 게시는 헤더의 COMMITTED 플래그
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline bool BasicMessageQueue<Policy, CapacityBytes>::reserve(std::size_t record_len, std::size_t& record_pos) noexcept {
+    std::size_t granted;
+    return reserve_run(record_len, 1, record_pos, granted);
+}
+
+// 배치 예약: 버퍼 끝까지 연속으로 들어가는 만큼만 한 번의 CAS로 선점
+// (레코드는 버퍼 끝을 넘지 않아야 하므로 나머지는 호출자가 다시 예약 - padding 후 시작부터)
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline bool BasicMessageQueue<Policy, CapacityBytes>::reserve_run(std::size_t record_len, std::size_t max_count,
+                                                                  std::size_t& record_pos, std::size_t& granted) noexcept {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    std::size_t padding;
+    std::size_t count;
+    
+    for (;;) {
+        // 버퍼 끝까지 남은 연속 공간이 부족하면 padding 후 처음부터
+        std::size_t contiguous = capacity_ - (pos & mask_);
+        padding = contiguous < record_len ? contiguous : 0;
+        if (padding > 0) {
+            contiguous = capacity_;
+        }
+        
+        std::size_t head = head_.load(std::memory_order_acquire);
+        std::size_t used = pos + padding - head;
+        if (used + record_len > capacity_) [[unlikely]] {
+            return false;
+        }
+        
+        count = (capacity_ - used) / record_len;
+        std::size_t run = contiguous / record_len;
+        if (count > run) count = run;
+        if (count > max_count) count = max_count;
+        
+        if constexpr (Policy == QueuePolicy::MPSC) {
+            if (tail_.compare_exchange_weak(pos, pos + padding + count * record_len,
+                                            std::memory_order_relaxed)) {
+                break;
+            }
+            // 실패 시 pos가 최신 tail로 갱신됨 - 재시도
+        } else {
+            break;
+        }
+    }
+    
+    if (padding > 0) {
+        header_at(pos).store(PADDING | COMMITTED, std::memory_order_release);
+        if constexpr (Policy != QueuePolicy::MPSC) {
+            tail_.store(pos + padding, std::memory_order_release);
+        }
+    }
+    
+    record_pos = pos + padding;
+    granted = count;
+    return true;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline void BasicMessageQueue<Policy, CapacityBytes>::commit(std::size_t record_pos, uint16_t size,
+                                                             uint32_t flags) noexcept {
+    // 게시 전에 카운트 증가: 소비자의 감소가 항상 뒤에 오도록 (underflow 방지)
+    const uint32_t records = count_.fetch_add(1, std::memory_order_relaxed) + 1;
+    
+    // payload 기록 후 게시 (소비자의 acquire와 짝)
+    header_at(record_pos).store(COMMITTED | flags | size, std::memory_order_release);
+    if constexpr (Policy != QueuePolicy::MPSC) {
+        tail_.store(record_pos + stored_bytes(flags | size), std::memory_order_release);
+    }
+    note_pushed(records);
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+template<typename Write>
+inline QueueResult BasicMessageQueue<Policy, CapacityBytes>::push_record(uint16_t size, uint32_t flags,
+                                                                         Write&& write, TickType_t lock_wait) noexcept {
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        if (xSemaphoreTake(mutex_, lock_wait) != pdTRUE) [[unlikely]] {
+            return Result::INVALID_MESSAGE;
+        }
+    }
+    
+    Result result = Result::QUEUE_FULL;
+    std::size_t record_pos;
+    if (reserve(stored_bytes(flags | size), record_pos)) [[likely]] {
+        write(payload_at(record_pos));
+        commit(record_pos, size, flags);
+        result = Result::SUCCESS;
+    }
+    
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        xSemaphoreGive(mutex_);
+    }
+    
+    if (result == Result::SUCCESS) [[likely]] {
+        mark_ready(ready_level());
+    }
+    return result;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline QueueResult BasicMessageQueue<Policy, CapacityBytes>::push(const MessageBase& msg, uint16_t size,
+                                                                  TickType_t lock_wait) noexcept {
+    if (size > MINI_SO_MAX_MESSAGE_SIZE) [[unlikely]] {
+        trace_push(msg.header, Result::MESSAGE_TOO_LARGE);
+        return Result::MESSAGE_TOO_LARGE;
+    }
+    const Result result = push_record(size, 0, [&](void* payload) noexcept {
+        std::memcpy(payload, &msg, size);
+    }, lock_wait);
+    trace_push(msg.header, result);
+    return result;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline QueueResult BasicMessageQueue<Policy, CapacityBytes>::push_handle(const detail::MessageHandle& handle) noexcept {
+    if (!handle.message || !handle.release) [[unlikely]] {
+        note_failed(Result::INVALID_MESSAGE);
+        return Result::INVALID_MESSAGE;
+    }
+    const Result result = push_record(sizeof(handle), HANDLE, [&](void* payload) noexcept {
+        std::memcpy(payload, &handle, sizeof(handle));
+    });
+    trace_push(handle.message->header, result);
+    return result;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+template<typename Fn>
+inline QueueResult BasicMessageQueue<Policy, CapacityBytes>::push_in_place(uint16_t size, Fn&& construct,
+                                                                           TickType_t lock_wait) noexcept {
+    if (size > MINI_SO_MAX_MESSAGE_SIZE) [[unlikely]] {
+        note_failed(Result::MESSAGE_TOO_LARGE);
+        return Result::MESSAGE_TOO_LARGE;
+    }
+    MessageHeader header{INVALID_MESSAGE_ID, INVALID_AGENT_ID};
+    const Result result = push_record(size, 0, [&](void* payload) noexcept {
+        construct(payload);
+        // 게시 전(소비자가 아직 볼 수 없을 때) 헤더 보관
+        header = static_cast<const MessageBase*>(payload)->header;
+    }, lock_wait);
+    trace_push(header, result);
+    return result;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+template<typename T, typename... Args>
+inline QueueResult BasicMessageQueue<Policy, CapacityBytes>::emplace(AgentId sender, Args&&... args) noexcept {
+    static_assert(sizeof(Message<T>) <= MINI_SO_MAX_MESSAGE_SIZE, "Message too large");
+    static_assert(alignof(Message<T>) <= RECORD_ALIGN, "Message alignment exceeds mailbox record alignment");
+    return push_in_place(sizeof(Message<T>), [&](void* payload) noexcept {
+        auto* msg = new (payload) Message<T>(sender, std::forward<Args>(args)...);
+        msg->mark_sent();
+    });
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline QueueResult BasicMessageQueue<Policy, CapacityBytes>::push_deadline(const MessageBase& msg, uint16_t size,
+                                                                           HiresTime deadline, DeadlineMiss miss) noexcept {
+    if (size > MINI_SO_MAX_MESSAGE_SIZE) [[unlikely]] {
+        trace_push(msg.header, Result::MESSAGE_TOO_LARGE);
+        return Result::MESSAGE_TOO_LARGE;
+    }
+    
+    // 게시 전에 대기 기한 등록: 소비자의 해제가 항상 뒤에 오도록 (카운트 underflow 방지)
+    note_deadline(deadline);
+    const uint32_t flags = DEADLINE | (static_cast<uint32_t>(miss) << MISS_SHIFT);
+    const Result result = push_record(size, flags, [&](void* payload) noexcept {
+        std::memcpy(payload, &msg, size);
+        std::memcpy(static_cast<uint8_t*>(payload) + ((size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1)),
+                    &deadline, sizeof(deadline));
+    });
+    if (result == Result::SUCCESS) [[likely]] {
+        if (detail::ReadySet* set = ready_set_.load(std::memory_order_acquire)) {
+            set->mark_deadline(ready_index_);
+        }
+    } else {
+        finish_deadline();
+    }
+    trace_push(msg.header, result);
+    return result;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline void BasicMessageQueue<Policy, CapacityBytes>::note_deadline(HiresTime deadline) noexcept {
+    if (deadlines_pending_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        earliest_deadline_.store(deadline, std::memory_order_release);
+        return;
+    }
+    HiresTime current = earliest_deadline_.load(std::memory_order_relaxed);
+    while (hires_before(deadline, current) &&
+           !earliest_deadline_.compare_exchange_weak(current, deadline, std::memory_order_acq_rel)) {
+    }
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline void BasicMessageQueue<Policy, CapacityBytes>::finish_deadline() noexcept {
+    if (deadlines_pending_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    if (detail::ReadySet* set = ready_set_.load(std::memory_order_acquire)) {
+        set->clear_deadline(ready_index_);
+        if (deadlines_pending_.load(std::memory_order_acquire) > 0) {
+            set->mark_deadline(ready_index_);  // 해제와 경합한 새 기한 레코드
+        }
+    }
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+template<typename Fn>
+inline std::size_t BasicMessageQueue<Policy, CapacityBytes>::push_batch(uint16_t size, std::size_t count,
+                                                                        Fn&& construct) noexcept {
+    if (size > MINI_SO_MAX_MESSAGE_SIZE || count == 0) [[unlikely]] {
+        if (count > 0) note_failed(Result::MESSAGE_TOO_LARGE, static_cast<uint32_t>(count));
+        return 0;
+    }
+    
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+            note_failed(Result::INVALID_MESSAGE, static_cast<uint32_t>(count));
+            return 0;
+        }
+    }
+    
+    const std::size_t record_len = record_bytes(size);
+    std::size_t pushed = 0;
+    
+    while (pushed < count) {
+        std::size_t record_pos;
+        std::size_t granted;
+        if (!reserve_run(record_len, count - pushed, record_pos, granted)) {
+            break;  // 메일박스 부족 - 부분 성공
+        }
+        
+        for (std::size_t i = 0; i < granted; ++i) {
+            void* payload = payload_at(record_pos + i * record_len);
+            construct(payload, pushed + i);
+            // 게시 전(소비자가 아직 볼 수 없을 때) 기록
+            trace_push(static_cast<const MessageBase*>(payload)->header, Result::SUCCESS);
+        }
+        
+        // 게시 전에 카운트 증가 (commit과 동일한 순서), 헤더는 레코드 순서대로 게시
+        const uint32_t records = count_.fetch_add(static_cast<uint32_t>(granted), std::memory_order_relaxed) +
+                                 static_cast<uint32_t>(granted);
+        for (std::size_t i = 0; i < granted; ++i) {
+            header_at(record_pos + i * record_len).store(COMMITTED | size, std::memory_order_release);
+        }
+        if constexpr (Policy != QueuePolicy::MPSC) {
+            tail_.store(record_pos + granted * record_len, std::memory_order_release);
+        }
+        note_pushed(records);
+        pushed += granted;
+    }
+    
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        xSemaphoreGive(mutex_);
+    }
+    if (pushed < count) [[unlikely]] {
+        note_failed(Result::QUEUE_FULL, static_cast<uint32_t>(count - pushed));
+    }
+    
+    if (pushed > 0) [[likely]] {
+        mark_ready(ready_level());
+    }
+    return pushed;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline bool BasicMessageQueue<Policy, CapacityBytes>::front(std::size_t& head, uint32_t& state) noexcept {
+    // MUTEX 정책도 상태 조회 구간만 잠금 - 핸들러 실행 중에는 뮤텍스를 보유하지 않음
+    // (핸들러가 자기 자신에게 send해도 교착 없음)
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+            return false;
+        }
+    }
+    
+    bool found = false;
+    head = head_.load(std::memory_order_relaxed);
+    
+    for (;;) {
+        if constexpr (Policy != QueuePolicy::MPSC) {
+            if (head == tail_.load(std::memory_order_acquire)) break;
+        }
+        
+        // 예약만 되고 아직 게시되지 않은 레코드는 비어있는 것으로 간주 (FIFO 유지)
+        state = header_at(head).load(std::memory_order_acquire);
+        if (!(state & COMMITTED)) break;
+        
+        if (!(state & PADDING)) {
+            found = true;
+            break;
+        }
+        
+        // padding 레코드 반환 후 버퍼 시작으로 이동
+        std::size_t consumed = capacity_ - (head & mask_);
+        if constexpr (Policy == QueuePolicy::MPSC) {
+            std::memset(&buffer_[head & mask_], 0, consumed);
+        } else {
+            header_at(head).store(0, std::memory_order_relaxed);
+        }
+        head += consumed;
+        head_.store(head, std::memory_order_release);
+    }
+    
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        xSemaphoreGive(mutex_);
+    }
+    return found;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline void BasicMessageQueue<Policy, CapacityBytes>::release_front(std::size_t head, uint32_t state) noexcept {
+    std::size_t consumed = stored_bytes(state);
+    
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+            return;
+        }
+    }
+    
+    // MPSC: 이후 레코드 헤더가 이 구간 어디에든 놓일 수 있으므로 반환 전에 0으로 초기화
+    if constexpr (Policy == QueuePolicy::MPSC) {
+        std::memset(&buffer_[head & mask_], 0, consumed);
+    } else {
+        header_at(head).store(0, std::memory_order_relaxed);
+    }
+    head_.store(head + consumed, std::memory_order_release);
+    count_.fetch_sub(1, std::memory_order_release);
+    
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        xSemaphoreGive(mutex_);
+    }
+    note_released();
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline bool BasicMessageQueue<Policy, CapacityBytes>::evict_front() noexcept {
+    std::size_t head;
+    uint32_t state;
+    if (!front(head, state)) {
+        return false;
+    }
+    
+    if (state & HANDLE) {
+        detail::MessageHandle handle;
+        std::memcpy(&handle, payload_at(head), sizeof(handle));
+        release_front(head, state);
+        handle.release(handle.message);
+    } else {
+        release_front(head, state);
+        if (state & DEADLINE) finish_deadline();
+    }
+    return true;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline bool BasicMessageQueue<Policy, CapacityBytes>::replace_latest(const MessageBase& msg, uint16_t size) noexcept {
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+            return false;
+        }
+    }
+    
+    // 게시된 레코드만 앞에서부터 훑음 (소비자는 잠겨 있고 생산자는 뒤쪽만 씀)
+    const MessageId type_id = msg.type_id();
+    std::size_t pos = head_.load(std::memory_order_relaxed);
+    const std::size_t tail = tail_.load(std::memory_order_acquire);  // 이후 예약분은 제외
+    std::size_t latest = 0;
+    bool found = false;
+    while (pos < tail) {
+        const uint32_t state = header_at(pos).load(std::memory_order_acquire);
+        if (!(state & COMMITTED)) break;
+        if (state & PADDING) {
+            pos += capacity_ - (pos & mask_);
+            continue;
+        }
+        if (!(state & (HANDLE | DEADLINE)) && (state & SIZE_MASK) == size &&
+            reinterpret_cast<const MessageBase*>(payload_at(pos))->type_id() == type_id) {
+            latest = pos;
+            found = true;
+        }
+        pos += stored_bytes(state);
+    }
+    if (found) {
+        std::memcpy(payload_at(latest), &msg, size);
+    }
+    
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        xSemaphoreGive(mutex_);
+    }
+    return found;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+template<typename Fn, typename Late>
+inline void BasicMessageQueue<Policy, CapacityBytes>::consume_deadline(std::size_t head, uint32_t state,
+                                                                       Fn&& fn, Late&& late) noexcept {
+    const auto* msg = static_cast<const MessageBase*>(static_cast<const void*>(payload_at(head)));
+    HiresTime deadline;
+    std::memcpy(&deadline, trailer_at(head, state), sizeof(deadline));
+    
+    bool deliver = true;
+    if (hires_before(deadline, hires_now())) [[unlikely]] {
+        const auto miss = static_cast<DeadlineMiss>((state & MISS_MASK) >> MISS_SHIFT);
+        late(*msg, miss, deadline);
+        deliver = miss == DeadlineMiss::DELIVER;
+    }
+    if (deliver) {
+        fn(*msg, static_cast<uint16_t>(state & SIZE_MASK));
+    }
+    release_front(head, state);
+    finish_deadline();
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+template<typename Fn, typename Late>
+inline bool BasicMessageQueue<Policy, CapacityBytes>::consume(Fn&& fn, Late&& late) noexcept {
+    std::size_t head;
+    uint32_t state;
+    if (!front(head, state)) {
+        return false;
+    }
+    if (state & DEADLINE) [[unlikely]] {
+        consume_deadline(head, state, fn, late);
+        return true;
+    }
+    
+    const void* payload = payload_at(head);
+    if (state & HANDLE) {
+        // 풀 메시지: 풀 저장소에서 직접 처리 후 슬롯 반환
+        detail::MessageHandle handle;
+        std::memcpy(&handle, payload, sizeof(handle));
+        fn(static_cast<const MessageBase&>(*handle.message), handle.size);
+        release_front(head, state);
+        handle.release(handle.message);
+    } else {
+        fn(*static_cast<const MessageBase*>(payload), static_cast<uint16_t>(state & SIZE_MASK));
+        release_front(head, state);
+    }
+    return true;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+template<typename Fn, typename Late>
+inline std::size_t BasicMessageQueue<Policy, CapacityBytes>::consume_run(std::size_t max_count, Fn&& fn,
+                                                                         Late&& late) noexcept {
+    std::size_t head;
+    uint32_t state;
+    if (max_count == 0 || !front(head, state)) {
+        return 0;
+    }
+    if (state & DEADLINE) [[unlikely]] {
+        consume_deadline(head, state, [&fn](const MessageBase& msg, uint16_t) noexcept {
+            const MessageBase* single = &msg;
+            fn(Span<const MessageBase* const>(&single, 1));
+        }, late);
+        return 1;
+    }
+    if (max_count > MINI_SO_MAX_BATCH) {
+        max_count = MINI_SO_MAX_BATCH;
+    }
+    
+    auto message_at = [this](std::size_t pos, uint32_t record_state) noexcept -> const MessageBase* {
+        const void* payload = payload_at(pos);
+        if (record_state & HANDLE) {
+            detail::MessageHandle handle;
+            std::memcpy(&handle, payload, sizeof(handle));
+            return handle.message;
+        }
+        return static_cast<const MessageBase*>(payload);
+    };
+    
+    // padding 전까지 게시된 연속 레코드 중 첫 메시지와 타입이 같은 것만 수집
+    std::array<const MessageBase*, MINI_SO_MAX_BATCH> run;
+    run[0] = message_at(head, state);
+    const MessageId type_id = run[0]->type_id();
+    std::size_t count = 1;
+    std::size_t end = head + stored_bytes(state);
+    
+    bool locked = true;
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        locked = xSemaphoreTake(mutex_, portMAX_DELAY) == pdTRUE;
+    }
+    while (locked && count < max_count) {
+        if constexpr (Policy != QueuePolicy::MPSC) {
+            if (end == tail_.load(std::memory_order_acquire)) break;
+        }
+        if ((end & mask_) == 0) break;  // 버퍼 끝 - 다음 run에서 이어 처리
+        
+        uint32_t next_state = header_at(end).load(std::memory_order_acquire);
+        if (!(next_state & COMMITTED) || (next_state & (PADDING | DEADLINE))) break;
+        
+        const MessageBase* next = message_at(end, next_state);
+        if (next->type_id() != type_id) break;
+        
+        run[count++] = next;
+        end += stored_bytes(next_state);
+    }
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        if (locked) {
+            xSemaphoreGive(mutex_);
+        }
+    }
+    
+    fn(Span<const MessageBase* const>(run.data(), count));
+    
+    // 풀 슬롯을 먼저 반환한 뒤 (핸들은 레코드 안에 있음) 구간 전체를 한 번에 해제
+    for (std::size_t pos = head; pos != end; ) {
+        uint32_t record_state = header_at(pos).load(std::memory_order_relaxed);
+        if (record_state & HANDLE) {
+            detail::MessageHandle handle;
+            std::memcpy(&handle, payload_at(pos), sizeof(handle));
+            handle.release(handle.message);
+        }
+        pos += stored_bytes(record_state);
+    }
+    
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+            return count;
+        }
+    }
+    if constexpr (Policy == QueuePolicy::MPSC) {
+        std::memset(&buffer_[head & mask_], 0, end - head);
+    } else {
+        for (std::size_t pos = head; pos != end; ) {
+            uint32_t record_state = header_at(pos).load(std::memory_order_relaxed);
+            header_at(pos).store(0, std::memory_order_relaxed);
+            pos += stored_bytes(record_state);
+        }
+    }
+    head_.store(end, std::memory_order_release);
+    count_.fetch_sub(static_cast<uint32_t>(count), std::memory_order_release);
+    if constexpr (Policy == QueuePolicy::MUTEX) {
+        xSemaphoreGive(mutex_);
+    }
+    note_released();
+    return count;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline bool BasicMessageQueue<Policy, CapacityBytes>::pop(uint8_t* buffer, uint16_t& size) noexcept {
+    // 입력 유효성 검사 (Zero-overhead when inlined)
+    if (!buffer) [[unlikely]] {
+        return false;
+    }
+    
+    bool copied = false;
+    bool consumed = consume([&](const MessageBase& msg, uint16_t msg_size) noexcept {
+        if (msg_size <= MINI_SO_MAX_MESSAGE_SIZE) [[likely]] {
+            std::memcpy(buffer, &msg, msg_size);
+            size = msg_size;
+            copied = true;
+        }
+    });
+    return consumed && copied;
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline void BasicMessageQueue<Policy, CapacityBytes>::clear() noexcept {
+    // 소비자 측 drain: 진행 중인 생산자와 경합하지 않도록 하나씩 해제 (풀 핸들 포함)
+    while (consume([](const MessageBase&, uint16_t) noexcept {})) {
+    }
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline void BasicMessageQueue<Policy, CapacityBytes>::note_pushed(uint32_t records) noexcept {
+#if MINI_SO_MAILBOX_STATS
+    // 최댓값 갱신은 드묾 - 평소에는 relaxed load 두 번
+    uint32_t seen = high_water_.load(std::memory_order_relaxed);
+    while (records > seen && !high_water_.compare_exchange_weak(seen, records, std::memory_order_relaxed)) {
+    }
+    const std::size_t used = used_bytes();
+    seen = high_water_bytes_.load(std::memory_order_relaxed);
+    while (used > seen && !high_water_bytes_.compare_exchange_weak(seen, static_cast<uint32_t>(used),
+                                                                   std::memory_order_relaxed)) {
+    }
+    if (used * 100u >= capacity_ * MINI_SO_MAILBOX_SATURATION_PERCENT &&
+        saturated_since_.load(std::memory_order_relaxed) == 0) [[unlikely]] {
+        HiresTime since = hires_now();
+        HiresTime expected = 0;
+        if (saturated_since_.compare_exchange_strong(expected, since ? since : 1, std::memory_order_relaxed)) {
+            saturations_.fetch_add(1, std::memory_order_relaxed);
         }
-        
-        static void reset() noexcept {
-            state_ = InitState::NOT_INITIALIZED;
-            init_attempt_count_ = 0;
+    }
+#else
+    (void)records;
+#endif
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline void BasicMessageQueue<Policy, CapacityBytes>::note_failed(Result result, uint32_t count) noexcept {
+#if MINI_SO_MAILBOX_STATS
+    const std::size_t index = static_cast<std::size_t>(result) - 1;
+    if (index < push_failures_.size()) {
+        push_failures_[index].fetch_add(count, std::memory_order_relaxed);
+    }
+#else
+    (void)result;
+    (void)count;
+#endif
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline void BasicMessageQueue<Policy, CapacityBytes>::note_released() noexcept {
+#if MINI_SO_MAILBOX_STATS
+    if (saturated_since_.load(std::memory_order_relaxed) != 0 &&
+        used_bytes() * 100u < capacity_ * MINI_SO_MAILBOX_SATURATION_PERCENT) [[unlikely]] {
+        if (const HiresTime since = saturated_since_.exchange(0, std::memory_order_relaxed)) {
+            saturated_us_.fetch_add(hires_since_us(since), std::memory_order_relaxed);
         }
-    };
-    
-    // 초기화 의존성 체크
-    template<typename... Dependencies>
-    constexpr bool check_dependencies_initialized() noexcept {
-        return (Dependencies::is_initialized() && ...);
     }
-    
-    // 의존성 기반 초기화
-    template<typename... Dependencies>
-    bool ensure_dependencies_initialized() noexcept {
-        return (Dependencies::ensure_initialized() && ...);
+#endif
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline MailboxStats BasicMessageQueue<Policy, CapacityBytes>::stats() const noexcept {
+    MailboxStats stats{};
+    stats.capacity_bytes = static_cast<uint32_t>(capacity_);
+#if MINI_SO_MAILBOX_STATS
+    stats.high_water = high_water_.load(std::memory_order_relaxed);
+    stats.high_water_bytes = high_water_bytes_.load(std::memory_order_relaxed);
+    stats.full = push_failures_[0].load(std::memory_order_relaxed);
+    stats.too_large = push_failures_[1].load(std::memory_order_relaxed);
+    stats.invalid = push_failures_[2].load(std::memory_order_relaxed);
+    stats.saturations = saturations_.load(std::memory_order_relaxed);
+    stats.saturated_us = saturated_us_.load(std::memory_order_relaxed);
+    if (const HiresTime since = saturated_since_.load(std::memory_order_relaxed)) {
+        stats.saturated_us += hires_since_us(since);
     }
+#endif
+    return stats;
 }
 
-// ============================================================================
-// System - Phase 3: SIOF-Safe 시스템 관리자 (의존성 보장)
-// ============================================================================
-class System {
-private:
-    ErrorAgent error_agent_;
-    PerformanceAgent performance_agent_;
-    WatchdogAgent watchdog_agent_;
+// high-water는 현재 점유로 다시 시작, 진행 중인 포화 구간은 지금부터 다시 잼
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline void BasicMessageQueue<Policy, CapacityBytes>::reset_stats() noexcept {
+#if MINI_SO_MAILBOX_STATS
+    high_water_.store(static_cast<uint32_t>(size()), std::memory_order_relaxed);
+    high_water_bytes_.store(static_cast<uint32_t>(used_bytes()), std::memory_order_relaxed);
+    for (auto& counter : push_failures_) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    saturations_.store(0, std::memory_order_relaxed);
+    saturated_us_.store(0, std::memory_order_relaxed);
+    HiresTime since = saturated_since_.load(std::memory_order_relaxed);
+    if (since != 0) {
+        const HiresTime restart = hires_now();
+        saturated_since_.compare_exchange_strong(since, restart ? restart : 1, std::memory_order_relaxed);
+    }
+#endif
+}
+
+template<QueuePolicy Policy, std::size_t CapacityBytes>
+inline bool BasicMessageQueue<Policy, CapacityBytes>::attach_storage(uint8_t* buffer, std::size_t bytes) noexcept {
+    if (!buffer || bytes < RECORD_HEADER_SIZE + RECORD_ALIGN || (bytes & (bytes - 1)) != 0 ||
+        (reinterpret_cast<uintptr_t>(buffer) & (RECORD_ALIGN - 1)) != 0) [[unlikely]] {
+        return false;
+    }
+    if (head_.load(std::memory_order_acquire) != tail_.load(std::memory_order_acquire)) [[unlikely]] {
+        return false;
+    }
+    std::memset(buffer, 0, bytes);
+    buffer_ = buffer;
+    capacity_ = bytes;
+    mask_ = bytes - 1;
+    return true;
+}
+
+template<typename OnMessage, typename OnBatch>
+inline void Agent::process_messages_with(uint32_t max_messages, OnMessage&& on_message, OnBatch&& on_batch) noexcept {
+    // 생산자가 과부하 처리(evict/replace) 중이면 이번 방문은 건너뜀 (메시지가 남아 다시 표시됨)
+    if (!message_queue_.try_lock_consumer()) [[unlikely]] {
+        return;
+    }
     
-    AgentId error_agent_id_ = INVALID_AGENT_ID;
-    AgentId performance_agent_id_ = INVALID_AGENT_ID;
-    AgentId watchdog_agent_id_ = INVALID_AGENT_ID;
+    // trace 비활성화 + NullObserver면 빈 함수로 사라짐
+    auto trace_dispatch = [this](const MessageBase& msg) noexcept {
+        trace::record(trace::EventKind::DISPATCH, msg.type_id(), msg.sender_id(), id_, message_queue_.size());
+        Observer::on_dispatch_begin(msg.type_id(), msg.sender_id(), id_, message_queue_.size());
+    };
+    auto trace_exit = [this](const MessageBase& msg, bool handled) noexcept {
+        trace::record(handled ? trace::EventKind::HANDLED : trace::EventKind::REJECTED,
+                      msg.type_id(), msg.sender_id(), id_, message_queue_.size());
+        Observer::on_dispatch_end(msg.type_id(), id_, handled);
+    };
     
-    bool initialized_ = false;
+    uint32_t messages_processed = 0;
+    uint32_t messages_consumed = 0;
     
-    System() = default;
+    auto on_late = [this](const MessageBase& msg, DeadlineMiss miss, HiresTime) noexcept {
+        count_deadline_miss(msg, miss);
+    };
     
-public:
-    // SIOF-Safe Pure Meyers' Singleton
-    static System& instance() noexcept {
-        static System system;
-        return system;
-    }
+    // 남은 메시지가 있고 대기 표지가 없는 box에 표지를 다시 넣음 - 실패하면 has_messages()가 다음 방문을 예약
+    auto requeue_notice = [this](detail::TypedMailboxBase& box) noexcept {
+        if (!box.empty() && box.claim_notice()) {
+            Message<detail::TypedNotice> notice(detail::TypedNotice{box.index()}, id_);
+            if (message_queue_.push(notice, sizeof(notice)) != QueueResult::SUCCESS) [[unlikely]] {
+                box.cancel_notice();
+            }
+        }
+    };
     
-    // SIOF-Safe 초기화 (의존성 보장)
-    bool initialize() noexcept;
+    // 타입 전용 메일박스 표지: 표지를 먼저 내린 뒤 box를 quantum만큼 비우고, 남으면 표지를 다시 넣음.
+    // 처리 수는 소비한 메시지 수로 집계 (표지 자체의 1건 포함)
+    auto handle_notice = [this, &messages_processed, &requeue_notice](const MessageBase& msg) noexcept -> bool {
+        const uint8_t index = static_cast<const Message<detail::TypedNotice>&>(msg).data.box;
+        detail::TypedMailboxBase* box = typed_mailboxes_;
+        while (box && box->index() != index) {
+            box = box->next();
+        }
+        if (!box) [[unlikely]] {
+            return false;
+        }
+        box->cancel_notice();
+        const std::size_t consumed = handle_typed(*box, quantum_messages_);
+        requeue_notice(*box);
+        if (consumed > 1) {
+            messages_processed += static_cast<uint32_t>(consumed - 1);
+        }
+        return consumed > 0;
+    };
     
-    void shutdown() noexcept;
-    constexpr bool is_initialized() const noexcept { return initialized_; }
+    // 최신 값 표지는 cell의 현재 값으로 바꿔 전달 (이미 전달한 값이면 건너뜀)
+    auto handle = [this, &on_message, &handle_notice](const MessageBase& msg) noexcept -> bool {
+        if constexpr (detail::LatestCells::CELLS > 0) {
+            if (msg.type_id() == MESSAGE_TYPE_ID(detail::LatestNotice)) [[unlikely]] {
+                detail::LatestCells::Buffer latest;
+                uint16_t size = 0;
+                const MessageBase* resolved = latest_.resolve(msg, size, latest);
+                return resolved && on_message(*resolved);
+            }
+        }
+        if (typed_mailboxes_ && msg.type_id() == MESSAGE_TYPE_ID(detail::TypedNotice)) [[unlikely]] {
+            return handle_notice(msg);
+        }
+        return on_message(msg);
+    };
+    auto handle_run = [this, &handle, &on_batch](Span<const MessageBase* const> batch) noexcept -> std::size_t {
+        const MessageId type_id = batch[0]->type_id();
+        if ((detail::LatestCells::CELLS > 0 && type_id == MESSAGE_TYPE_ID(detail::LatestNotice)) ||
+            (typed_mailboxes_ && type_id == MESSAGE_TYPE_ID(detail::TypedNotice))) [[unlikely]] {
+            std::size_t handled = 0;
+            for (const MessageBase* msg : batch) {
+                handled += handle(*msg) ? 1 : 0;
+            }
+            return handled;
+        }
+        return on_batch(batch);
+    };
     
-    // Phase 3: 직접 Agent 접근 (Zero-overhead)
-    constexpr ErrorAgent& error() noexcept { return error_agent_; }
-    constexpr PerformanceAgent& performance() noexcept { return performance_agent_; }
-    constexpr WatchdogAgent& watchdog() noexcept { return watchdog_agent_; }
+    const HiresTime start_time = hires_now();
     
-    // Phase 3: 편의 메서드 (inline으로 Zero-overhead)
-    void report_error(system_messages::ErrorReport::Level level, uint32_t code, AgentId source = INVALID_AGENT_ID) noexcept {
-        error_agent_.report_error(level, code, source);
-    }
+    // 메일박스(또는 풀) 저장소에서 직접 처리 - 스택 버퍼로 복사하지 않음
+#if MINI_SO_ENABLE_LATENCY_HISTOGRAMS
+    LatencyMonitor& latency = environment().latency();
     
-    void record_performance(uint32_t processing_time_us, uint32_t message_count = 1) noexcept {
-        performance_agent_.record_performance(processing_time_us, message_count);
-    }
+    // timestamp 0 = 전송 시각 없이 큐에 직접 넣은 메시지 (대기 시간 기록 제외)
+    auto record_latency = [this, &latency](const MessageBase& msg, HiresTime dispatched, Duration handler_time) noexcept {
+        if (msg.timestamp() != 0) [[likely]] {
+            latency.record(id_, msg.type_id(), hires_elapsed_us(msg.timestamp(), dispatched), handler_time);
+        }
+    };
     
-    void heartbeat(AgentId agent_id) noexcept {
-        system_messages::Heartbeat hb{agent_id};
-        Environment::instance().send_message(agent_id, watchdog_agent_id_, hb);
+    auto dispatch = [&handle, &messages_processed, &trace_dispatch, &trace_exit, &record_latency](const MessageBase& msg, uint16_t) noexcept {
+        trace_dispatch(msg);
+        const HiresTime dispatched = hires_now();
+        const bool handled = handle(msg);
+        if (handled) {
+            messages_processed++;
+        }
+        record_latency(msg, dispatched, hires_since_us(dispatched));
+        trace_exit(msg, handled);
+    };
+    
+    // 배치는 핸들러 시간을 메시지 수로 나눠 각 메시지에 기록
+    auto dispatch_batch = [&handle_run, &messages_processed, &trace_dispatch, &trace_exit, &record_latency](Span<const MessageBase* const> batch) noexcept {
+        trace_dispatch(*batch[0]);
+        const HiresTime dispatched = hires_now();
+        const std::size_t handled = handle_run(batch);
+        messages_processed += static_cast<uint32_t>(handled);
+        trace_exit(*batch[0], handled > 0);
+        const Duration per_message = hires_since_us(dispatched) / static_cast<Duration>(batch.size());
+        for (const MessageBase* msg : batch) {
+            record_latency(*msg, dispatched, per_message);
+        }
+    };
+#else
+    auto dispatch = [&handle, &messages_processed, &trace_dispatch, &trace_exit](const MessageBase& msg, uint16_t) noexcept {
+        trace_dispatch(msg);
+        const bool handled = handle(msg);
+        if (handled) {
+            messages_processed++;
+        }
+        trace_exit(msg, handled);
+    };
+    
+    // 배치는 DISPATCH/종료 이벤트 한 쌍 (첫 메시지 기준)
+    auto dispatch_batch = [&handle_run, &messages_processed, &trace_dispatch, &trace_exit](Span<const MessageBase* const> batch) noexcept {
+        trace_dispatch(*batch[0]);
+        const std::size_t handled = handle_run(batch);
+        messages_processed += static_cast<uint32_t>(handled);
+        trace_exit(*batch[0], handled > 0);
+    };
+#endif
+    
+    // 과도한 처리 방지 (임베디드 시스템 고려) - 처리 여부와 무관하게 소비 수로 제한
+    while (messages_consumed < max_messages) {
+        if (batch_receive_) {
+            std::size_t consumed = message_queue_.consume_run(max_messages - messages_consumed, dispatch_batch, on_late);
+            if (consumed == 0) break;
+            messages_consumed += static_cast<uint32_t>(consumed);
+        } else {
+            if (!message_queue_.consume(dispatch, on_late)) break;
+            messages_consumed++;
+        }
+        
+        // 시간 예산 초과 시 다음 방문으로 양보
+        if (quantum_time_ > 0 && hires_since_us(start_time) >= quantum_time_) [[unlikely]] {
+            break;
+        }
     }
     
-    // Phase 3: 시스템 상태 조회 (constexpr)
-    constexpr bool is_healthy() const noexcept {
-        return error_agent_.is_healthy() && watchdog_agent_.is_healthy();
+    // 메인 메일박스가 가득 차 표지를 넣지 못한 box/최신 값 cell - 비운 뒤 다시 넣음
+    if (typed_mailboxes_) [[unlikely]] {
+        for (detail::TypedMailboxBase* box = typed_mailboxes_; box; box = box->next()) {
+            requeue_notice(*box);
+        }
+    }
+    if (latest_.requeue_pending()) [[unlikely]] {
+        latest_.requeue([this](uint8_t cell) noexcept {
+            Message<detail::LatestNotice> notice(detail::LatestNotice{cell}, id_);
+            return message_queue_.push(notice, sizeof(notice)) == QueueResult::SUCCESS;
+        });
     }
     
-private:
-    // static 포인터 제거 (InitializationGuard가 상태 관리)
-};
+    message_queue_.unlock_consumer();
+    message_queue_.notify_space();  // BLOCK 정책 발신자
+    
+    if (messages_consumed > 0 && (MINI_SO_ENABLE_METRICS || adaptive_max_ > 0)) {
+        const uint32_t elapsed_us = hires_since_us(start_time);
+        // 승격/EDF 방문(quantum보다 큰 한도)도 메시지당 시간 표본으로 사용
+        if (adaptive_max_ > 0) {
+            adapt_quantum(elapsed_us, messages_consumed);
+        }
+#if MINI_SO_ENABLE_METRICS
+        if (messages_processed > 0) {
+            count_visit(elapsed_us, messages_processed);
+        }
+#endif
+    }
+}
 
-// ============================================================================
-// Template Implementations - Phase 3: Zero-overhead 구현
-// ============================================================================
+template<typename T>
+inline bool Agent::send_message(AgentId target_id, const T& message) noexcept {
+    return environment().send_message(id_, target_id, message);
+}
+
+template<typename T>
+inline SendResult Agent::try_send(AgentId target_id, const T& message) noexcept {
+    return environment().try_send(id_, target_id, message);
+}
 
 template<typename T>
-inline void Agent::send_message(AgentId target_id, const T& message) noexcept {
-    Environment::instance().send_message(id_, target_id, message);
+inline SendResult Agent::send_for(AgentId target_id, const T& message, TickType_t timeout) noexcept {
+    return environment().send_for(id_, target_id, message, timeout);
+}
+
+template<typename T, typename... Args>
+inline bool Agent::send_emplace(AgentId target_id, Args&&... args) noexcept {
+    return environment().send_emplace<T>(id_, target_id, std::forward<Args>(args)...);
 }
 
 template<typename T>
 inline void Agent::broadcast_message(const T& message) noexcept {
-    Environment::instance().broadcast_message(id_, message);
+    environment().broadcast_message(id_, message);
+}
+
+template<typename T>
+inline TimerId Agent::send_delayed(AgentId target_id, const T& message, Duration delay) noexcept {
+    return environment().send_delayed(id_, target_id, message, delay);
+}
+
+template<typename T>
+inline TimerId Agent::send_periodic(AgentId target_id, const T& message, Duration period) noexcept {
+    return environment().send_periodic(id_, target_id, message, period);
+}
+
+inline bool Agent::cancel_timer(TimerId id) noexcept {
+    return environment().cancel_timer(id);
+}
+
+template<typename T>
+inline bool detail::post_timer_message(Environment& env, AgentId sender_id, AgentId target_id,
+                                       const void* payload) noexcept {
+    return env.send_message(sender_id, target_id, *static_cast<const T*>(payload));
+}
+
+template<typename T>
+inline bool Agent::subscribe() noexcept {
+    return environment().subscribe<T>(id_);
+}
+
+template<typename T>
+inline void Agent::unsubscribe() noexcept {
+    environment().unsubscribe<T>(id_);
+}
+
+template<typename T>
+inline bool Agent::subscribe(const RateLimit& limit) noexcept {
+    return environment().set_rate_limit(INVALID_AGENT_ID, id_, MESSAGE_TYPE_ID(T), limit) && subscribe<T>();
+}
+
+inline bool Agent::limit_send(const RateLimit& limit) noexcept {
+    return environment().set_rate_limit(id_, INVALID_AGENT_ID, INVALID_MESSAGE_ID, limit);
+}
+
+template<typename T>
+inline bool Agent::limit_send(const RateLimit& limit) noexcept {
+    return environment().set_rate_limit(id_, INVALID_AGENT_ID, MESSAGE_TYPE_ID(T), limit);
+}
+
+template<typename T>
+inline bool Agent::set_receive_filter(bool (*predicate)(const T& data, AgentId sender) noexcept) noexcept {
+    using Predicate = bool (*)(const T&, AgentId) noexcept;
+    detail::ReceiveFilters::Entry entry;
+    entry.type = MESSAGE_TYPE_ID(T);
+    entry.predicate = reinterpret_cast<void (*)()>(predicate);
+    entry.test = [](const detail::ReceiveFilters::Entry& self, const void* data, AgentId sender) noexcept {
+        return reinterpret_cast<Predicate>(self.predicate)(*static_cast<const T*>(data), sender);
+    };
+    return predicate && receive_filters_.set(entry);
+}
+
+template<typename T, typename Context>
+inline bool Agent::set_receive_filter(bool (*predicate)(const T& data, AgentId sender,
+                                                        const detail::identity_t<Context>& context) noexcept,
+                                      const Context& context) noexcept {
+    using Predicate = bool (*)(const T&, AgentId, const Context&) noexcept;
+    detail::ReceiveFilters::Entry entry;
+    entry.type = MESSAGE_TYPE_ID(T);
+    entry.predicate = reinterpret_cast<void (*)()>(predicate);
+    entry.context = &context;
+    entry.test = [](const detail::ReceiveFilters::Entry& self, const void* data, AgentId sender) noexcept {
+        return reinterpret_cast<Predicate>(self.predicate)(*static_cast<const T*>(data), sender,
+                                                           *static_cast<const Context*>(self.context));
+    };
+    return predicate && receive_filters_.set(entry);
+}
+
+template<typename T>
+inline std::size_t Agent::publish(const T& message) noexcept {
+    return environment().publish(id_, message);
+}
+
+template<typename T>
+inline std::size_t Agent::send_batch(AgentId target_id, Span<const T> messages) noexcept {
+    return environment().send_batch(id_, target_id, messages);
 }
 
 // Phase 2.2: Agent 풀링된 메시지 전송 구현
 template<typename T>
 inline void Agent::send_pooled_message(AgentId target_id, const T& message) noexcept {
-    Environment::instance().send_pooled_message(id_, target_id, message);
+    environment().send_pooled_message(id_, target_id, message);
+}
+
+template<typename T>
+inline bool Agent::send_with_deadline(AgentId target_id, const T& message, Duration budget_us,
+                                      DeadlineMiss on_miss) noexcept {
+    return environment().send_with_deadline(id_, target_id, message, budget_us, on_miss);
+}
+
+template<typename T>
+inline bool Agent::send_buffer(AgentId target_id, UniqueBuffer<T>&& buffer) noexcept {
+    return environment().send_buffer(id_, target_id, std::move(buffer));
+}
+
+template<typename T>
+inline std::size_t Agent::publish_buffer(UniqueBuffer<T>&& buffer) noexcept {
+    return environment().publish_buffer(id_, std::move(buffer));
 }
 
 template<typename T>
 inline void Agent::broadcast_pooled_message(const T& message) noexcept {
-    Environment::instance().broadcast_pooled_message(id_, message);
+    environment().broadcast_pooled_message(id_, message);
 }
 
 template<typename T>
 inline bool Environment::send_message(AgentId sender_id, AgentId target_id, const T& message) noexcept {
-    if (target_id >= agent_count_ || !agents_[target_id]) [[unlikely]] {
+    return send_emplace<T>(sender_id, target_id, message);
+}
+
+template<typename T, typename... Args>
+inline bool Environment::send_emplace(AgentId sender_id, AgentId target_id, Args&&... args) noexcept {
+    Agent* target = live_agent(target_id);
+    if (!target) [[unlikely]] {
+        return false;
+    }
+    if (target->as_router()) [[unlikely]] {
+        // 키 분배는 값이 필요하므로 한 번 생성해 고른 worker에게 보냄
+        if constexpr (MessageRouteKey<T>::defined) {
+            const T value(std::forward<Args>(args)...);
+            Agent* worker = route(target, sender_id, &value);
+            return worker && send_emplace<T>(sender_id, worker->id(), value);
+        } else {
+            target = route<T>(target, sender_id);
+            if (!target) [[unlikely]] {
+                return false;
+            }
+        }
+    }
+    
+#if MINI_SO_ENABLE_METRICS
+    total_messages_sent_++;
+#endif
+    
+    // 대상 메일박스 슬롯에 직접 생성 (가득 차면 과부하 정책)
+    Agent* receiver = detail::deliver_in_place<T>(*target, [&](void* where) noexcept {
+        auto* typed_msg = new (where) Message<T>(sender_id, std::forward<Args>(args)...);
+        typed_msg->mark_sent();  // 타임스탬프 설정
+        return typed_msg;
+    });
+    
+    if (!receiver) [[unlikely]] {
+        return false;
+    }
+    detail::mark_message_priority<T>(*receiver);
+    return true;
+}
+
+template<typename T>
+inline SendResult Environment::send_for(AgentId sender_id, AgentId target_id, const T& message,
+                                        TickType_t timeout) noexcept {
+    Agent* target = route(live_agent(target_id), sender_id, &message);
+    if (!target) [[unlikely]] {
+        return SendResult::NO_SUCH_AGENT;  // Router는 살아 있는 worker가 없을 때
+    }
+    if (MessageQueue::record_bytes(sizeof(Message<T>)) > target->message_queue_.capacity_bytes()) [[unlikely]] {
+        return SendResult::MESSAGE_TOO_LARGE;  // 비어 있어도 들어가지 않음
+    }
+    
+#if MINI_SO_ENABLE_METRICS
+    total_messages_sent_++;
+#endif
+    
+    detail::SendControl control{timeout};
+    Agent* receiver = detail::deliver_in_place<T>(*target, [&](void* where) noexcept {
+        auto* typed_msg = new (where) Message<T>(sender_id, message);
+        typed_msg->mark_sent();
+        return typed_msg;
+    }, &control);
+    
+    if (!receiver) [[unlikely]] {
+        return detail::send_failure(control);
+    }
+    detail::mark_message_priority<T>(*receiver);
+    return SendResult::SENT;
+}
+
+inline bool Environment::send_raw(AgentId target_id, const MessageBase& message, uint16_t size) noexcept {
+    Agent* target = route(live_agent(target_id), message.sender_id());
+    if (!target || size < sizeof(MessageBase) || size > MINI_SO_MAX_MESSAGE_SIZE) [[unlikely]] {
         return false;
     }
     
-    // Create message with explicit heap allocation to avoid stack issues
-    alignas(8) static thread_local uint8_t msg_buffer[MINI_SO_MAX_MESSAGE_SIZE];
+#if MINI_SO_ENABLE_METRICS
+    total_messages_sent_++;
+#endif
     
-    // Construct message in static buffer
-    Message<T>* typed_msg = new (msg_buffer) Message<T>(message, sender_id);
-    typed_msg->mark_sent();  // 타임스탬프 설정
+    auto push = [&](Agent& agent) noexcept { return agent.message_queue_.push(message, size); };
+    const QueueResult result = push(*target);
+    if (result == QueueResult::SUCCESS) [[likely]] {
+        return true;
+    }
+    if (result != QueueResult::QUEUE_FULL) [[unlikely]] {
+        target->count_overload(Agent::OverloadEvent::DROPPED);
+        return false;
+    }
+    return detail::deliver_overloaded(*target, target->overload_policy(), &message, size, push) != nullptr;
+}
+
+template<typename T>
+inline std::size_t Environment::send_batch(AgentId sender_id, AgentId target_id, Span<const T> messages) noexcept {
+    Agent* target = live_agent(target_id);
+    if (!target || messages.empty()) [[unlikely]] {
+        return 0;
+    }
     
     constexpr uint16_t msg_size = sizeof(Message<T>);
     static_assert(msg_size <= MINI_SO_MAX_MESSAGE_SIZE, "Message too large");
     
+    // 메시지별 전송 (전달된 것만 반환값에 포함): Router(메시지마다 worker 선택), 수신 필터/토큰 버킷 한도,
+    // 최신 값 cell(MessageCoalesce)이나 타입 전용 메일박스로 가는 T - 모두 send_emplace의 전달 경로를 따름
+    bool per_message = target->as_router() || detail::receive_filter<T>(*target) || detail::rate_limited(*target) ||
+                       (target->typed_mailboxes_ && target->typed_mailbox(MESSAGE_TYPE_ID(T)));
+    if constexpr (MessageCoalesce<T>::value && detail::LatestCells::CELLS > 0) {
+        per_message = true;
+    }
+    const auto send_each = [&](std::size_t from) noexcept {
+        std::size_t delivered = 0;
+        for (std::size_t i = from; i < messages.size(); ++i) {
+            delivered += send_emplace<T>(sender_id, target_id, messages[i]) ? 1 : 0;
+        }
+        return delivered;
+    };
+    if (per_message) [[unlikely]] {
+        return send_each(0);
+    }
+    
+    // 배치 전체가 같은 전송 시각을 가짐
+    const HiresTime timestamp = hires_now();
+    std::size_t sent = target->message_queue_.push_batch(
+        msg_size, messages.size(), [&](void* payload, std::size_t i) noexcept {
+            auto* typed_msg = new (payload) Message<T>(messages[i], sender_id);
+            typed_msg->header.set_sent_at(timestamp);
+        });
+    
 #if MINI_SO_ENABLE_METRICS
-    total_messages_sent_++;
+    total_messages_sent_ += sent;
 #endif
     
-    // Pass the buffer directly to avoid any reference issues
-    MessageQueue::Result result = agents_[target_id]->message_queue_.push(*typed_msg, msg_size);
+    if (sent > 0) [[likely]] {
+        detail::mark_message_priority<T>(*target);
+    }
+    // 공간이 모자라 남은 메시지는 메시지별 전송 - T/대상 과부하 정책과 overload 카운터 적용
+    if (sent < messages.size()) [[unlikely]] {
+        sent += send_each(sent);
+    }
+    return sent;
+}
+
+template<typename T>
+inline bool Environment::send_from_isr(AgentId sender_id, AgentId target_id, const T& message,
+                                       BaseType_t* higher_priority_woken) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>, "ISR messages are copied into the interrupt mailbox");
+    static_assert(sizeof(T) <= detail::IsrMailbox::PAYLOAD_SIZE,
+                  "ISR message too large (increase MINI_SO_ISR_PAYLOAD_SIZE)");
+    static_assert(alignof(T) <= 8, "ISR message alignment exceeds 8 bytes");
+    
+    if (!live_slot(target_id) ||  // ISR에서는 활성화하지 않음 - 전달(run) 때 태스크 문맥에서
+        !isr_.push(sender_id, target_id, &detail::post_timer_message<T>, &message, sizeof(T))) [[unlikely]] {
+        return false;
+    }
     
-    // Explicitly destroy the object (though not strictly necessary for POD types)
-    typed_msg->~Message<T>();
+    BaseType_t woken = pdFALSE;
+    ready_.wake_from_isr(&woken);
+    if (higher_priority_woken) {
+        *higher_priority_woken |= woken;
+    } else {
+        portYIELD_FROM_ISR(woken);
+    }
+    return true;
+}
+
+template<typename T>
+inline bool Environment::send_remote(AgentId sender_id, AgentId target_id, const T& message) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>, "Remote messages are copied into the interrupt mailbox");
+    static_assert(sizeof(T) <= detail::IsrMailbox::PAYLOAD_SIZE,
+                  "Remote message too large (increase MINI_SO_ISR_PAYLOAD_SIZE)");
+    static_assert(alignof(T) <= 8, "Remote message alignment exceeds 8 bytes");
     
-    return result == MessageQueue::Result::SUCCESS;
+    if (!isr_.push(sender_id, target_id, &detail::post_timer_message<T>, &message, sizeof(T))) [[unlikely]] {
+        return false;
+    }
+    ready_.wake_one();
+    return true;
+}
+
+template<typename T, std::size_t MaxTypes>
+inline std::size_t Environment::publish(const BasicMbox<MaxTypes>& mbox, AgentId sender_id, const T& message) noexcept {
+    std::size_t delivered = 0;
+    mbox.for_each_subscriber(MESSAGE_TYPE_ID(T), [&](AgentId target) noexcept {
+        delivered += send_message(sender_id, slot_id(target), message) ? 1 : 0;
+    });
+    return delivered;
 }
 
+// 타입 T에 구독이 있으면 구독자(발신자 제외)에게만 - O(구독자 수)
+// 구독이 한 번도 없던 타입은 기존처럼 모든 Agent에게 전송
 template<typename T>
 inline void Environment::broadcast_message(AgentId sender_id, const T& message) noexcept {
-    for (std::size_t i = 0; i < agent_count_; ++i) {
-        if (agents_[i] && i != sender_id) {
-            send_message(sender_id, static_cast<AgentId>(i), message);
-        }
+    constexpr MessageId type = MESSAGE_TYPE_ID(T);
+    if (mbox_.has_topic(type)) {
+        mbox_.for_each_subscriber(type, [&](AgentId target) noexcept {
+            const AgentId id = slot_id(target);
+            if (id != sender_id) send_message(sender_id, id, message);
+        });
+        return;
     }
+    for_each_agent([&](AgentId id, Agent& agent) noexcept {
+        if (id != sender_id && !agent.as_router()) send_message(sender_id, id, message);  // worker는 직접 받음
+    });
 }
 
 // Phase 3: 인라인 성능 메서드들
+inline Environment& Agent::environment() const noexcept {
+    return environment_ ? *environment_ : Environment::instance();
+}
+
+inline System* Environment::system() noexcept {
+    if (system_) [[likely]] return system_;
+    return this == &instance() ? &System::instance() : nullptr;  // 기본 Environment는 처음 쓸 때 생성
+}
+
 inline void Agent::report_performance(uint32_t processing_time_us, uint32_t message_count) noexcept {
-    System::instance().record_performance(processing_time_us, message_count);
+    if (System* system = environment().system()) system->record_performance(processing_time_us, message_count);
 }
 
 inline void Agent::heartbeat() noexcept {
-    System::instance().heartbeat(id_);
+    if (System* system = environment().system()) system->heartbeat(id_);
 }
 
 constexpr bool WatchdogAgent::is_healthy() const noexcept {
     // 모니터링 중인 Agent가 없거나, 적어도 하나가 활성 상태면 건강함
     return monitored_count_ == 0 || 
            [this]() constexpr {
-               for (std::size_t i = 0; i < monitored_count_; ++i) {
-                   if (monitored_[i].active) return true;
+               for (const auto& agent : monitored_) {
+                   if (agent.active) return true;
                }
                return false;
            }();
@@ -0,0 +1,403 @@
+/**
+ * @file state_agent.h
+ * @brief Mini SObjectizer 계층형 상태 머신 Agent - 컴파일 타임 핸들러 테이블
+ *
+ * SObjectizer 스타일 상태:
+ * - 상태별 메시지 핸들러 테이블 (on<Msg, &Derived::handler>)
+ * - 진입/종료 훅 (on_enter / on_leave), 진입은 상위 → 하위, 종료는 하위 → 상위 순서
+ * - 상태 범위 timeout (state_timeout<ms, Target>): 상태(또는 하위 상태)에 머무는 동안만 유효
+ * - 하위 상태가 처리하지 않은 메시지는 상위 상태 테이블로 전달
+ *
+ * 각 상태 테이블은 MessageId로 정렬된 constexpr 배열로 생성되며, 디스패치는 현재 상태부터
+ * 상위로 올라가며 이진 탐색 (switch/if 중첩 없음).
+ *
+ *     enum class Flight : uint8_t { GROUNDED, AIRBORNE, HOVERING, CRUISING, COUNT };
+ *
+ *     class Drone : public mini_so::StateAgent<Drone, Flight, Flight::COUNT> {
+ *     public:
+ *         Drone() noexcept : StateAgent(Flight::GROUNDED) {}
+ *         void on_takeoff(const Takeoff&) noexcept { transition_to(Flight::HOVERING); }
+ *         ...
+ *         using states = mini_so::state_table<
+ *             mini_so::state<Flight::GROUNDED, mini_so::on<Takeoff, &Drone::on_takeoff>>,
+ *             mini_so::state<Flight::AIRBORNE, mini_so::on<Land, &Drone::on_land>>,
+ *             mini_so::substate<Flight::HOVERING, Flight::AIRBORNE, mini_so::on_enter<&Drone::hold>,
+ *                               mini_so::state_timeout<5000, Flight::GROUNDED>>,
+ *             mini_so::substate<Flight::CRUISING, Flight::AIRBORNE, mini_so::on<Waypoint, &Drone::on_waypoint>>>;
+ *     };
+ */
+
+#pragma once
+
+#include "../mini_sobjectizer.h"
+
+namespace mini_so {
+
+// ============================================================================
+// State Table 선언 요소
+// ============================================================================
+
+// 메시지 핸들러: bool (Derived::*)(const Msg&) noexcept (false = 상위 상태로 전달)
+//               또는 void (Derived::*)(const Msg&) noexcept (항상 처리됨)
+template<typename Msg, auto Handler> struct on {};
+
+// 상태 진입/종료 훅: void (Derived::*)() noexcept (on_exit는 libc 함수와 충돌하므로 on_leave)
+template<auto Fn> struct on_enter {};
+template<auto Fn> struct on_leave {};
+
+// 상태에 timeout ms 동안 머무르면 Target으로 전이 (하위 상태로의 이동은 유지로 간주)
+template<Duration Timeout, auto Target> struct state_timeout {};
+
+// 최상위 상태 / 부모가 있는 하위 상태
+template<auto Id, typename... Items> struct state {};
+template<auto Id, auto Parent, typename... Items> struct substate {};
+
+template<typename... States> struct state_table {};
+
+namespace detail {
+    constexpr uint8_t NO_STATE = 0xFF;
+    
+    // 상태 범위 timeout 메시지 (자기 자신에게 send_delayed)
+    struct StateTimeout {
+        uint8_t state;
+        uint8_t reserved;
+        uint16_t epoch;  // 진입마다 증가 - 취소와 경합한 늦은 만료 무시
+    };
+    
+    template<typename Derived>
+    struct StateEntry {
+        MessageId type_id;
+        bool (*handler)(Derived&, const MessageBase&) noexcept;
+    };
+    
+    template<typename Derived>
+    struct StateInfo {
+        uint8_t parent = NO_STATE;
+        uint8_t timeout_target = NO_STATE;
+        bool declared = false;
+        Duration timeout = 0;
+        const StateEntry<Derived>* entries = nullptr;
+        std::size_t entry_count = 0;
+        void (*entry)(Derived&) noexcept = nullptr;
+        void (*exit)(Derived&) noexcept = nullptr;
+    };
+    
+    template<typename Derived, typename Msg, auto Handler>
+    bool invoke_state_handler(Derived& self, const MessageBase& msg) noexcept {
+        const Msg& data = static_cast<const Message<Msg>&>(msg).data;
+        using Result = decltype((self.*Handler)(data));
+        if constexpr (std::is_same_v<Result, bool>) {
+            return (self.*Handler)(data);
+        } else {
+            (self.*Handler)(data);
+            return true;
+        }
+    }
+    
+    template<typename Derived, auto Fn>
+    void invoke_state_hook(Derived& self) noexcept {
+        (self.*Fn)();
+    }
+    
+    // 항목 분류
+    template<typename Item> struct is_handler : std::false_type {};
+    template<typename Msg, auto Handler> struct is_handler<on<Msg, Handler>> : std::true_type {};
+    
+    template<typename Derived, typename Msg, auto Handler>
+    constexpr StateEntry<Derived> make_handler_entry(on<Msg, Handler>*) noexcept {
+        return StateEntry<Derived>{MESSAGE_TYPE_ID(Msg), &invoke_state_handler<Derived, Msg, Handler>};
+    }
+    
+    template<typename Derived, typename Item>
+    constexpr StateEntry<Derived> make_state_entry() noexcept {
+        if constexpr (is_handler<Item>::value) {
+            return make_handler_entry<Derived>(static_cast<Item*>(nullptr));
+        } else {
+            return StateEntry<Derived>{INVALID_MESSAGE_ID, nullptr};
+        }
+    }
+    
+    template<typename Derived, typename Item>
+    constexpr void apply_state_item(StateInfo<Derived>&, Item*) noexcept {}
+    
+    template<typename Derived, auto Fn>
+    constexpr void apply_state_item(StateInfo<Derived>& info, on_enter<Fn>*) noexcept {
+        info.entry = &invoke_state_hook<Derived, Fn>;
+    }
+    
+    template<typename Derived, auto Fn>
+    constexpr void apply_state_item(StateInfo<Derived>& info, on_leave<Fn>*) noexcept {
+        info.exit = &invoke_state_hook<Derived, Fn>;
+    }
+    
+    template<typename Derived, Duration Timeout, auto Target>
+    constexpr void apply_state_item(StateInfo<Derived>& info, state_timeout<Timeout, Target>*) noexcept {
+        info.timeout = Timeout;
+        info.timeout_target = static_cast<uint8_t>(Target);
+    }
+    
+    // 한 상태의 핸들러 테이블 (MessageId 오름차순, 삽입 정렬 - 컴파일 타임)
+    template<typename Derived, typename... Items>
+    struct StateHandlers {
+        static constexpr std::size_t count = (std::size_t{0} + ... + (is_handler<Items>::value ? 1u : 0u));
+        
+        static constexpr std::array<StateEntry<Derived>, (count > 0 ? count : 1)> build() noexcept {
+            std::array<StateEntry<Derived>, (count > 0 ? count : 1)> sorted{};
+            const StateEntry<Derived> all[] = {make_state_entry<Derived, Items>()..., StateEntry<Derived>{}};
+            std::size_t size = 0;
+            for (const auto& entry : all) {
+                if (!entry.handler) continue;
+                std::size_t pos = size++;
+                while (pos > 0 && sorted[pos - 1].type_id > entry.type_id) {
+                    sorted[pos] = sorted[pos - 1];
+                    --pos;
+                }
+                sorted[pos] = entry;
+            }
+            return sorted;
+        }
+        
+        static constexpr bool unique() noexcept {
+            for (std::size_t i = 1; i < count; ++i) {
+                if (table[i - 1].type_id == table[i].type_id) return false;
+            }
+            return true;
+        }
+        
+        static constexpr std::array<StateEntry<Derived>, (count > 0 ? count : 1)> table = build();
+        static_assert(unique(), "A state declares two handlers for the same message type (or an id collision)");
+    };
+    
+    template<typename Derived, uint8_t Parent, typename... Items>
+    constexpr StateInfo<Derived> make_state_info() noexcept {
+        using Handlers = StateHandlers<Derived, Items...>;
+        StateInfo<Derived> info{};
+        info.parent = Parent;
+        info.declared = true;
+        info.entries = Handlers::table.data();
+        info.entry_count = Handlers::count;
+        (apply_state_item<Derived>(info, static_cast<Items*>(nullptr)), ...);
+        return info;
+    }
+    
+    // state/substate → StateInfo
+    template<typename Derived, typename State> struct StateTraits;
+    
+    template<typename Derived, auto Id, typename... Items>
+    struct StateTraits<Derived, state<Id, Items...>> {
+        static constexpr uint8_t id = static_cast<uint8_t>(Id);
+        static constexpr StateInfo<Derived> info() noexcept { return make_state_info<Derived, NO_STATE, Items...>(); }
+    };
+    
+    template<typename Derived, auto Id, auto Parent, typename... Items>
+    struct StateTraits<Derived, substate<Id, Parent, Items...>> {
+        static constexpr uint8_t id = static_cast<uint8_t>(Id);
+        static constexpr StateInfo<Derived> info() noexcept {
+            return make_state_info<Derived, static_cast<uint8_t>(Parent), Items...>();
+        }
+    };
+    
+    template<typename Derived, std::size_t Count, typename Table> struct StateMachineTable;
+    
+    template<typename Derived, std::size_t Count, typename... States>
+    struct StateMachineTable<Derived, Count, state_table<States...>> {
+        static constexpr std::array<StateInfo<Derived>, Count> build() noexcept {
+            std::array<StateInfo<Derived>, Count> infos{};
+            ((infos[StateTraits<Derived, States>::id] = StateTraits<Derived, States>::info()), ...);
+            return infos;
+        }
+        
+        // 모든 id가 범위 안, 중복 없음, 부모/timeout 대상이 선언된 상태, 부모 사슬에 순환 없음
+        static constexpr bool valid() noexcept {
+            const uint8_t ids[] = {StateTraits<Derived, States>::id..., NO_STATE};
+            std::array<bool, Count> seen{};
+            for (std::size_t i = 0; i + 1 < sizeof(ids); ++i) {
+                if (ids[i] >= Count || seen[ids[i]]) return false;
+                seen[ids[i]] = true;
+            }
+            const auto infos = build();
+            for (std::size_t i = 0; i < Count; ++i) {
+                if (!infos[i].declared) continue;
+                if (infos[i].parent != NO_STATE && (infos[i].parent >= Count || !infos[infos[i].parent].declared)) return false;
+                if (infos[i].timeout_target != NO_STATE &&
+                    (infos[i].timeout_target >= Count || !infos[infos[i].timeout_target].declared)) return false;
+                std::size_t depth = 0;
+                for (uint8_t s = infos[i].parent; s != NO_STATE; s = infos[s].parent) {
+                    if (++depth > Count) return false;
+                }
+            }
+            return true;
+        }
+        
+        static_assert(Count > 0 && Count < NO_STATE, "State count must fit in uint8_t");
+        static_assert(valid(), "Invalid state table: duplicate/out-of-range id, undeclared parent or target, or a parent cycle");
+        static constexpr std::array<StateInfo<Derived>, Count> infos = build();
+    };
+}
+
+// ============================================================================
+// StateAgent - 계층형 상태 머신 Agent
+// ============================================================================
+// Derived는 using states = state_table<...>; 를 선언 (핸들러 선언 뒤에 위치).
+// StateId는 0..StateCount-1 값을 갖는 enum. 상태 머신은 첫 메시지 처리 시(또는 start())
+// 초기 상태로 진입. 핸들러/훅 안에서 transition_to() 호출 가능 (훅 안의 전이는 현재 전이 후 수행).
+template<typename Derived, typename StateId, StateId StateCount>
+class StateAgent : public Agent {
+    static constexpr std::size_t COUNT = static_cast<std::size_t>(StateCount);
+
+public:
+    explicit StateAgent(StateId initial) noexcept : initial_(static_cast<uint8_t>(initial)) {}
+    
+    bool handle_message(const MessageBase& msg) noexcept override {
+        start();
+        if (msg.type_id() == MESSAGE_TYPE_ID(detail::StateTimeout)) [[unlikely]] {
+            return on_state_timeout(static_cast<const Message<detail::StateTimeout>&>(msg).data);
+        }
+        
+        for (uint8_t s = current_; s != detail::NO_STATE; s = infos()[s].parent) {
+            if (const auto* entry = find(infos()[s], msg.type_id())) {
+                if (entry->handler(self(), msg)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    
+    // 초기 상태로 진입 (상위 → 하위 entry 훅). 이미 시작했으면 무시
+    void start() noexcept {
+        if (current_ != detail::NO_STATE) [[likely]] return;
+        enter_path(detail::NO_STATE, initial_);
+        current_ = initial_;
+        run_pending();
+    }
+    
+    // 현재 상태 (시작 전에는 초기 상태)
+    StateId current_state() const noexcept {
+        return static_cast<StateId>(current_ != detail::NO_STATE ? current_ : initial_);
+    }
+    
+    // 현재 상태가 s 또는 s의 하위 상태인지
+    bool in_state(StateId s) const noexcept {
+        for (uint8_t c = current_; c != detail::NO_STATE; c = infos()[c].parent) {
+            if (c == static_cast<uint8_t>(s)) return true;
+        }
+        return false;
+    }
+
+protected:
+    // 공통 조상까지 종료 훅(하위 → 상위), 대상까지 진입 훅(상위 → 하위).
+    // 자기 자신으로의 전이는 종료 후 재진입 (timeout 재시작)
+    // 반환: 선언되지 않은 상태면 false (전이 없음)
+    bool transition_to(StateId target) noexcept {
+        const uint8_t next = static_cast<uint8_t>(target);
+        if (next >= COUNT || !infos()[next].declared) [[unlikely]] return false;
+        pending_ = next;
+        if (!transitioning_) run_pending();
+        return true;
+    }
+
+private:
+    // Derived::states는 Derived가 완성된 뒤(멤버 함수 인스턴스화 시점)에만 참조
+    static constexpr const std::array<detail::StateInfo<Derived>, COUNT>& infos() noexcept {
+        return detail::StateMachineTable<Derived, COUNT, typename Derived::states>::infos;
+    }
+    
+    Derived& self() noexcept { return static_cast<Derived&>(*this); }
+    
+    static const detail::StateEntry<Derived>* find(const detail::StateInfo<Derived>& info, MessageId type_id) noexcept {
+        std::size_t lo = 0;
+        std::size_t hi = info.entry_count;
+        while (lo < hi) {
+            const std::size_t mid = (lo + hi) / 2;
+            const MessageId id = info.entries[mid].type_id;
+            if (id == type_id) return &info.entries[mid];
+            if (id < type_id) lo = mid + 1; else hi = mid;
+        }
+        return nullptr;
+    }
+    
+    // 상태 s까지의 깊이 (최상위 = 1)
+    static std::size_t depth_of(uint8_t s) noexcept {
+        std::size_t depth = 0;
+        for (; s != detail::NO_STATE; s = infos()[s].parent) ++depth;
+        return depth;
+    }
+    
+    static uint8_t common_ancestor(uint8_t a, uint8_t b) noexcept {
+        std::size_t da = depth_of(a);
+        std::size_t db = depth_of(b);
+        while (da > db) { a = infos()[a].parent; --da; }
+        while (db > da) { b = infos()[b].parent; --db; }
+        while (a != b) { a = infos()[a].parent; b = infos()[b].parent; }
+        return a;
+    }
+    
+    void run_pending() noexcept {
+        transitioning_ = true;
+        // 훅 안에서 요청된 전이도 차례로 수행 (훅이 계속 전이하면 상태 수만큼으로 제한)
+        for (std::size_t round = 0; pending_ != detail::NO_STATE && round <= COUNT; ++round) {
+            const uint8_t next = pending_;
+            pending_ = detail::NO_STATE;
+            
+            // 자기 전이: 자신을 종료/재진입하도록 공통 조상을 부모로
+            const uint8_t ancestor = next == current_ ? infos()[next].parent : common_ancestor(current_, next);
+            exit_path(current_, ancestor);
+            current_ = next;
+            enter_path(ancestor, next);
+        }
+        transitioning_ = false;
+    }
+    
+    void exit_path(uint8_t from, uint8_t ancestor) noexcept {
+        for (uint8_t s = from; s != ancestor; s = infos()[s].parent) {
+            if (infos()[s].timeout > 0 && timers_[s] != INVALID_TIMER_ID) {
+                cancel_timer(timers_[s]);
+                timers_[s] = INVALID_TIMER_ID;
+            }
+            if (infos()[s].exit) infos()[s].exit(self());
+        }
+    }
+    
+    // ancestor 아래부터 target까지 상위 → 하위 순서로 진입
+    void enter_path(uint8_t ancestor, uint8_t target) noexcept {
+        std::array<uint8_t, COUNT> path{};
+        std::size_t length = 0;
+        for (uint8_t s = target; s != ancestor && length < COUNT; s = infos()[s].parent) {
+            path[length++] = s;
+        }
+        while (length > 0) {
+            const uint8_t s = path[--length];
+            epochs_[s]++;
+            if (infos()[s].timeout > 0 && id() != INVALID_AGENT_ID) {
+                timers_[s] = send_delayed(id(), detail::StateTimeout{s, 0, epochs_[s]}, infos()[s].timeout);
+            }
+            if (infos()[s].entry) infos()[s].entry(self());
+        }
+    }
+    
+    bool on_state_timeout(const detail::StateTimeout& timeout) noexcept {
+        const uint8_t s = timeout.state;
+        if (s >= COUNT || timeout.epoch != epochs_[s] || !in_state(static_cast<StateId>(s))) {
+            return true;  // 이미 떠난 상태의 늦은 만료
+        }
+        timers_[s] = INVALID_TIMER_ID;
+        transition_to(static_cast<StateId>(infos()[s].timeout_target));
+        return true;
+    }
+    
+    uint8_t initial_;
+    uint8_t current_ = detail::NO_STATE;
+    uint8_t pending_ = detail::NO_STATE;
+    bool transitioning_ = false;
+    std::array<uint16_t, COUNT> epochs_{};
+    std::array<TimerId, COUNT> timers_ = make_timers();
+    
+    static constexpr std::array<TimerId, COUNT> make_timers() noexcept {
+        std::array<TimerId, COUNT> timers{};
+        for (auto& timer : timers) timer = INVALID_TIMER_ID;
+        return timers;
+    }
+};
+
+} // namespace mini_so
@@ -0,0 +1,456 @@
+/**
+ * @file transport.h
+ * @brief Mini SObjectizer 노드 간 전송 - UART/CAN/SPI 링크 위의 Message<T> 프레이밍
+ *
+ * 구성:
+ * - Link:               바이트 링크 드라이버 인터페이스 (DMA 전송 시작, 완료는 transmit_complete로 통지)
+ * - Transport<Schema>:  스키마에 있는 타입만 전송. 송신 레코드를 이중 프레임 버퍼에 모아 CRC-32를
+ *                       붙여 한 번에 전송하고, 수신 바이트 스트림을 프레임으로 재조립해 CRC 검증 후
+ *                       로컬 Environment의 대상 Agent에게 send_message로 주입
+ * - RemoteAgent<T>:     원격 Agent를 대신하는 로컬 proxy 메일박스. 이 Agent로 보낸 메시지는 방문마다
+ *                       한 프레임에 모여(batching) 원격 노드의 remote_id Agent에게 전달
+ *
+ * 프레임: [FrameHeader 8B][Record ...][CRC-32 4B]  (CRC 범위 = 헤더 + 레코드)
+ * 레코드: [RecordHeader 8B][payload, 8바이트 정렬 패딩]
+ * payload는 메일박스의 Message<T>에서 프레임 버퍼로 memcpy 한 번 (중간 직렬화 버퍼 없음), 수신 측은
+ * 프레임 버퍼의 정렬된 payload를 그대로 send_message에 넘김. 정수 필드는 호스트 바이트 순서이므로
+ * 양쪽 노드는 같은 엔디안이고 같은 MINI_SO_MESSAGE_SCHEMA로 빌드되어야 함 (type_id = 타입 이름 해시).
+ *
+ *     MINI_SO_MESSAGE_SCHEMA(BusMessages, SensorReading, MotorCommand);
+ *
+ *     UartLink uart;                                      // Link 구현, DMA TX 완료 ISR에서 bus.transmit_complete()
+ *     mini_so::Transport<BusMessages> bus(uart, NODE_ID);
+ *     mini_so::RemoteAgent<decltype(bus)> motor(bus, REMOTE_MOTOR_ID);
+ *     AgentId motor_id = env.register_agent(&motor);      // 로컬 Agent는 motor_id로 send_message
+ *
+ *     // RX: UART ISR → xStreamBufferSendFromISR(rx_stream, ...), RX 태스크에서
+ *     //     n = xStreamBufferReceive(rx_stream, chunk, sizeof(chunk), portMAX_DELAY); bus.receive(chunk, n);
+ */
+
+#pragma once
+
+#include "../mini_sobjectizer.h"
+
+// ============================================================================
+// Transport Configuration
+// ============================================================================
+// 프레임 버퍼 크기 (헤더 + 레코드 + CRC, 8의 배수). 송신 이중 버퍼 + 수신 버퍼 각각 이 크기
+#ifndef MINI_SO_TRANSPORT_FRAME_BYTES
+#define MINI_SO_TRANSPORT_FRAME_BYTES 256
+#endif
+
+// Transport 하나에 연결할 수 있는 RemoteAgent 수 (수신 메시지의 발신자를 proxy ID로 변환)
+#ifndef MINI_SO_TRANSPORT_MAX_PROXIES
+#define MINI_SO_TRANSPORT_MAX_PROXIES 8
+#endif
+
+namespace mini_so {
+
+// ============================================================================
+// Wire Format
+// ============================================================================
+namespace transport {
+    constexpr uint16_t FRAME_MAGIC = 0x534D;  // 'M','S' (little-endian 바이트 순서)
+    constexpr uint8_t FRAME_VERSION = 1;
+    constexpr std::size_t RECORD_ALIGN = 8;
+    constexpr std::size_t CRC_BYTES = 4;
+    
+    struct FrameHeader {
+        uint16_t magic;
+        uint8_t version;
+        uint8_t source_node;
+        uint16_t record_count;
+        uint16_t length;        // 레코드 영역 바이트 수
+    };
+    
+    // MessageHeader의 type_id/sender_id + 수신 노드 대상 + payload 크기 (timestamp는 노드 로컬 값이라 제외)
+    struct RecordHeader {
+        MessageId type_id;
+        AgentId sender_id;      // 송신 노드의 Agent ID
+        AgentId target_id;      // 수신 노드의 Agent ID
+        uint16_t size;          // payload 바이트 (패딩 제외)
+    };
+    
+    static_assert(sizeof(FrameHeader) == 8 && sizeof(RecordHeader) == 8, "Wire headers must be 8 bytes");
+    
+    constexpr std::size_t record_bytes(std::size_t payload_size) noexcept {
+        return sizeof(RecordHeader) + ((payload_size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1));
+    }
+    
+    // CRC-32 (IEEE 802.3, reflected 0xEDB88320) - 4비트 테이블 (64바이트), 이어서 계산하려면 이전 값 전달
+    uint32_t crc32(const void* data, std::size_t size, uint32_t crc = 0) noexcept;
+    
+    struct Stats {
+        uint32_t frames_sent;
+        uint32_t records_sent;
+        uint32_t frames_received;
+        uint32_t records_received;
+        uint32_t crc_errors;       // CRC 불일치 또는 잘못된 길이로 버린 프레임
+        uint32_t unknown_records;  // 스키마 밖 타입 또는 크기 불일치
+        uint32_t tx_dropped;       // 프레임 버퍼 부족(이전 프레임 전송 중) 또는 링크 전송 실패
+    };
+    
+    // 전송 완료 후 미뤄진 flush를 proxy에게 요청 (send_from_isr로 방문을 깨움, 링크로는 나가지 않음)
+    struct FlushRequest {};
+}
+
+// ============================================================================
+// Link - 바이트 링크 드라이버
+// ============================================================================
+class Link {
+public:
+    virtual ~Link() = default;
+    
+    // frame[0..size) 전송 시작 (DMA 권장). 전송이 끝나면 드라이버가 Transport::transmit_complete()를
+    // 호출 (ISR 가능) - 그 전까지 버퍼는 유지됨. 시작하지 못하면 false (프레임은 버려짐)
+    virtual bool transmit(const uint8_t* frame, std::size_t size) noexcept = 0;
+};
+
+// ============================================================================
+// Transport - 스키마 타입의 프레임 송수신
+// ============================================================================
+template<typename Schema, std::size_t FrameBytes = MINI_SO_TRANSPORT_FRAME_BYTES>
+class Transport;
+
+template<typename... Types, std::size_t FrameBytes>
+class Transport<MessageSchema<Types...>, FrameBytes> {
+public:
+    using Schema = MessageSchema<Types...>;
+    
+    static constexpr std::size_t FRAME_BYTES = FrameBytes;
+    static constexpr std::size_t RECORD_CAPACITY = FrameBytes - sizeof(transport::FrameHeader) - transport::CRC_BYTES;
+    static constexpr std::size_t MAX_PROXIES = MINI_SO_TRANSPORT_MAX_PROXIES;
+    
+    static_assert((std::is_trivially_copyable_v<Types> && ...), "Transported messages must be trivially copyable");
+    static_assert(((alignof(Types) <= transport::RECORD_ALIGN) && ...), "Transported message alignment exceeds 8 bytes");
+    static_assert(FrameBytes % transport::RECORD_ALIGN == 0 && FrameBytes <= 0xFFFF, "Frame size must be a multiple of 8 (< 64KB)");
+    static_assert(((transport::record_bytes(sizeof(Types)) <= RECORD_CAPACITY) && ...),
+                  "Message too large for one frame (increase MINI_SO_TRANSPORT_FRAME_BYTES)");
+    
+    Transport(Link& link, uint8_t node_id) noexcept
+        : link_(link), node_id_(node_id), mutex_(detail::create_mutex(mutex_storage_)) {}
+    
+    ~Transport() noexcept {
+        if (mutex_) {
+            vSemaphoreDelete(mutex_);
+        }
+    }
+    
+    Transport(const Transport&) = delete;
+    Transport& operator=(const Transport&) = delete;
+    
+    constexpr uint8_t node_id() const noexcept { return node_id_; }
+    
+    // ------------------------------------------------------------------------
+    // 송신 (proxy 방문 컨텍스트)
+    // ------------------------------------------------------------------------
+    
+    // 채우는 중인 프레임에 레코드 추가 - 공간이 없으면 먼저 flush. 스키마 밖 타입이면 false
+    bool enqueue(const MessageBase& msg, AgentId remote_target) noexcept {
+        const MessageId index = Schema::index_of(msg.type_id());
+        if (index == INVALID_MESSAGE_ID) [[unlikely]] {
+            count(stats_.unknown_records);
+            return false;
+        }
+        
+        const uint16_t size = SIZES[index];
+        const std::size_t need = transport::record_bytes(size);
+        if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+            return false;
+        }
+        
+        if (fill_used_ + need > RECORD_CAPACITY && !flush_locked()) [[unlikely]] {
+            xSemaphoreGive(mutex_);
+            count(stats_.tx_dropped);
+            return false;
+        }
+        
+        uint8_t* record = buffers_[fill_].data + sizeof(transport::FrameHeader) + fill_used_;
+        const transport::RecordHeader header{msg.type_id(), msg.sender_id(), remote_target, size};
+        std::memcpy(record, &header, sizeof(header));
+        std::memcpy(record + sizeof(header), PAYLOADS[index](msg), size);
+        std::memset(record + sizeof(header) + size, 0, need - sizeof(header) - size);
+        fill_used_ += need;
+        fill_count_++;
+        
+        xSemaphoreGive(mutex_);
+        return true;
+    }
+    
+    // 모인 레코드를 한 프레임으로 전송 - 이전 프레임이 아직 전송 중이면 false (레코드는 유지).
+    // retry_agent가 있으면 전송 완료 시 그 Agent에게 FlushRequest를 보내 다시 flush하게 함.
+    // 보낼 레코드가 없으면 true
+    bool flush(AgentId retry_agent = INVALID_AGENT_ID) noexcept {
+        if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+            return false;
+        }
+        const bool flushed = flush_locked();
+        if (!flushed && retry_agent != INVALID_AGENT_ID) {
+            retry_agent_.store(retry_agent, std::memory_order_release);
+        }
+        xSemaphoreGive(mutex_);
+        return flushed;
+    }
+    
+    // Link 드라이버의 전송 완료 통지 (ISR 가능) - 미뤄진 flush가 있으면 proxy 방문을 깨움.
+    // higher_priority_woken: Environment::send_from_isr와 같음 (nullptr이면 내부에서 yield)
+    void transmit_complete(BaseType_t* higher_priority_woken = nullptr) noexcept {
+        in_flight_.store(false, std::memory_order_release);
+        const AgentId retry = retry_agent_.exchange(INVALID_AGENT_ID, std::memory_order_acq_rel);
+        if (retry != INVALID_AGENT_ID) {
+            Environment::instance().send_from_isr(INVALID_AGENT_ID, retry, transport::FlushRequest{},
+                                                  higher_priority_woken);
+        }
+    }
+    
+    bool transmitting() const noexcept { return in_flight_.load(std::memory_order_acquire); }
+    std::size_t pending_records() const noexcept { return fill_count_; }
+    
+    // ------------------------------------------------------------------------
+    // 수신 (RX 태스크 컨텍스트, 단일 호출자)
+    // ------------------------------------------------------------------------
+    
+    // 수신 바이트를 조각 단위로 공급 - 프레임이 완성되면 CRC 검증 후 레코드를 로컬 Agent에 주입.
+    // magic으로 프레임 경계를 다시 찾으므로 잡음/유실 바이트 뒤에도 복구됨. 반환: 주입한 메시지 수
+    std::size_t receive(const uint8_t* data, std::size_t size) noexcept {
+        std::size_t delivered = 0;
+        std::size_t offset = 0;
+        while (offset < size) {
+            if (rx_used_ < sizeof(transport::FrameHeader)) {
+                accept_header_byte(data[offset++]);
+                continue;
+            }
+            
+            const std::size_t wanted = rx_expected_ - rx_used_;
+            const std::size_t chunk = wanted < size - offset ? wanted : size - offset;
+            std::memcpy(rx_.data + rx_used_, data + offset, chunk);
+            rx_used_ += chunk;
+            offset += chunk;
+            if (rx_used_ == rx_expected_) {
+                delivered += deliver_frame();
+                rx_used_ = 0;
+            }
+        }
+        return delivered;
+    }
+    
+    // ------------------------------------------------------------------------
+    // proxy 연결 - 원격 remote_id가 보낸 메시지는 proxy의 로컬 ID를 발신자로 주입 (답장 가능)
+    // ------------------------------------------------------------------------
+    bool attach(const Agent& proxy, AgentId remote_id) noexcept {
+        for (auto& entry : proxies_) {
+            if (!entry.proxy) {
+                entry.remote_id = remote_id;
+                entry.proxy = &proxy;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void detach(const Agent& proxy) noexcept {
+        for (auto& entry : proxies_) {
+            if (entry.proxy == &proxy) entry.proxy = nullptr;
+        }
+    }
+    
+    transport::Stats stats() const noexcept {
+        return transport::Stats{load(stats_.frames_sent), load(stats_.records_sent), load(stats_.frames_received),
+                                load(stats_.records_received), load(stats_.crc_errors), load(stats_.unknown_records),
+                                load(stats_.tx_dropped)};
+    }
+
+private:
+    using Post = detail::TimerWheel::Post;
+    using Payload = const void* (*)(const MessageBase& msg) noexcept;
+    
+    template<typename T>
+    static const void* payload_of(const MessageBase& msg) noexcept {
+        return &static_cast<const Message<T>&>(msg).data;
+    }
+    
+    // 스키마 인덱스 순서의 타입별 테이블
+    static constexpr std::array<uint16_t, Schema::size> SIZES{{static_cast<uint16_t>(sizeof(Types))...}};
+    static constexpr std::array<Payload, Schema::size> PAYLOADS{{&payload_of<Types>...}};
+    static constexpr std::array<Post, Schema::size> INJECTS{{&detail::post_timer_message<Types>...}};
+    
+    struct alignas(transport::RECORD_ALIGN) FrameBuffer {
+        uint8_t data[FrameBytes];
+    };
+    
+    struct Proxy {
+        const Agent* proxy = nullptr;
+        AgentId remote_id = INVALID_AGENT_ID;
+    };
+    
+    struct Counters {
+        std::atomic<uint32_t> frames_sent{0};
+        std::atomic<uint32_t> records_sent{0};
+        std::atomic<uint32_t> frames_received{0};
+        std::atomic<uint32_t> records_received{0};
+        std::atomic<uint32_t> crc_errors{0};
+        std::atomic<uint32_t> unknown_records{0};
+        std::atomic<uint32_t> tx_dropped{0};
+    };
+    
+    static void count(std::atomic<uint32_t>& counter, uint32_t amount = 1) noexcept {
+        counter.fetch_add(amount, std::memory_order_relaxed);
+    }
+    static uint32_t load(const std::atomic<uint32_t>& counter) noexcept {
+        return counter.load(std::memory_order_relaxed);
+    }
+    
+    // mutex_ 보유 중: 채운 버퍼를 완성해 전송하고 다른 버퍼로 교체
+    bool flush_locked() noexcept {
+        if (fill_count_ == 0) return true;
+        if (in_flight_.load(std::memory_order_acquire)) return false;
+        
+        FrameBuffer& frame = buffers_[fill_];
+        const transport::FrameHeader header{transport::FRAME_MAGIC, transport::FRAME_VERSION, node_id_,
+                                            static_cast<uint16_t>(fill_count_), static_cast<uint16_t>(fill_used_)};
+        std::memcpy(frame.data, &header, sizeof(header));
+        const std::size_t body = sizeof(header) + fill_used_;
+        const uint32_t crc = transport::crc32(frame.data, body);
+        std::memcpy(frame.data + body, &crc, sizeof(crc));
+        
+        const std::size_t records = fill_count_;
+        fill_ ^= 1u;
+        fill_used_ = 0;
+        fill_count_ = 0;
+        
+        in_flight_.store(true, std::memory_order_release);
+        if (!link_.transmit(frame.data, body + transport::CRC_BYTES)) [[unlikely]] {
+            in_flight_.store(false, std::memory_order_release);
+            count(stats_.tx_dropped, static_cast<uint32_t>(records));
+            return true;  // 프레임은 버려졌지만 버퍼는 다시 사용 가능
+        }
+        count(stats_.frames_sent);
+        count(stats_.records_sent, static_cast<uint32_t>(records));
+        return true;
+    }
+    
+    // 헤더 바이트 누적 - magic이 맞지 않으면 다음 바이트부터 다시 찾음
+    void accept_header_byte(uint8_t byte) noexcept {
+        constexpr uint8_t MAGIC_LOW = static_cast<uint8_t>(transport::FRAME_MAGIC & 0xFF);
+        constexpr uint8_t MAGIC_HIGH = static_cast<uint8_t>(transport::FRAME_MAGIC >> 8);
+        
+        if (rx_used_ == 1 && byte != MAGIC_HIGH) {
+            rx_used_ = 0;  // 이 바이트가 새 프레임의 첫 바이트일 수 있음
+        }
+        if (rx_used_ == 0 && byte != MAGIC_LOW) {
+            return;
+        }
+        rx_.data[rx_used_++] = byte;
+        
+        if (rx_used_ == sizeof(transport::FrameHeader)) {
+            transport::FrameHeader header;
+            std::memcpy(&header, rx_.data, sizeof(header));
+            if (header.version != transport::FRAME_VERSION || header.length > RECORD_CAPACITY) [[unlikely]] {
+                count(stats_.crc_errors);
+                rx_used_ = 0;
+                return;
+            }
+            rx_expected_ = sizeof(header) + header.length + transport::CRC_BYTES;
+        }
+    }
+    
+    std::size_t deliver_frame() noexcept {
+        transport::FrameHeader header;
+        std::memcpy(&header, rx_.data, sizeof(header));
+        const std::size_t body = sizeof(header) + header.length;
+        uint32_t crc;
+        std::memcpy(&crc, rx_.data + body, sizeof(crc));
+        if (crc != transport::crc32(rx_.data, body)) [[unlikely]] {
+            count(stats_.crc_errors);
+            return 0;
+        }
+        count(stats_.frames_received);
+        
+        std::size_t delivered = 0;
+        std::size_t offset = sizeof(header);
+        for (uint16_t i = 0; i < header.record_count; ++i) {
+            if (offset + sizeof(transport::RecordHeader) > body) [[unlikely]] break;
+            transport::RecordHeader record;
+            std::memcpy(&record, rx_.data + offset, sizeof(record));
+            const std::size_t length = transport::record_bytes(record.size);
+            if (offset + length > body) [[unlikely]] break;
+            
+            const MessageId index = Schema::index_of(record.type_id);
+            if (index == INVALID_MESSAGE_ID || SIZES[index] != record.size) [[unlikely]] {
+                count(stats_.unknown_records);
+            } else if (INJECTS[index](Environment::instance(), local_sender(record.sender_id), record.target_id,
+                                      rx_.data + offset + sizeof(record))) {
+                delivered++;
+            }
+            offset += length;
+        }
+        count(stats_.records_received, static_cast<uint32_t>(delivered));
+        return delivered;
+    }
+    
+    AgentId local_sender(AgentId remote_sender) const noexcept {
+        for (const auto& entry : proxies_) {
+            if (entry.proxy && entry.remote_id == remote_sender) return entry.proxy->id();
+        }
+        return INVALID_AGENT_ID;
+    }
+    
+    Link& link_;
+    const uint8_t node_id_;
+    detail::MutexStorage mutex_storage_;  // mutex_보다 먼저 초기화
+    SemaphoreHandle_t mutex_;
+    
+    // 송신: fill_ 버퍼를 채우는 동안 다른 버퍼는 DMA 전송 중일 수 있음
+    std::array<FrameBuffer, 2> buffers_{};
+    std::size_t fill_ = 0;
+    std::size_t fill_used_ = 0;     // 레코드 영역 사용 바이트
+    std::size_t fill_count_ = 0;
+    std::atomic<bool> in_flight_{false};
+    std::atomic<AgentId> retry_agent_{INVALID_AGENT_ID};  // 전송 완료 시 깨울 proxy
+    
+    // 수신 재조립
+    FrameBuffer rx_{};
+    std::size_t rx_used_ = 0;
+    std::size_t rx_expected_ = 0;
+    
+    std::array<Proxy, MAX_PROXIES> proxies_{};
+    Counters stats_;
+};
+
+// ============================================================================
+// RemoteAgent - 원격 Agent의 로컬 proxy 메일박스
+// ============================================================================
+// 로컬 Environment에 등록하면 다른 Agent는 이 proxy의 ID로 평소처럼 send_message/publish.
+// 방문(visit) 한 번에 처리한 메시지는 같은 프레임에 모이고 방문 끝에 flush (프레임 하나에 여러 메시지).
+// 원격 노드가 remote_id에서 보낸 메시지는 이 proxy의 ID를 발신자로 주입되므로 그대로 답장 가능.
+template<typename TransportT>
+class RemoteAgent : public Agent {
+public:
+    RemoteAgent(TransportT& transport, AgentId remote_id) noexcept
+        : transport_(transport), remote_id_(remote_id) {
+        transport_.attach(*this, remote_id);
+    }
+    
+    ~RemoteAgent() override { transport_.detach(*this); }
+    
+    constexpr AgentId remote_id() const noexcept { return remote_id_; }
+    
+    using Agent::process_messages;
+    void process_messages(uint32_t max_messages) noexcept override {
+        Agent::process_messages(max_messages);
+        transport_.flush(id());  // 전송 중이면 완료 통지가 FlushRequest로 다시 방문시킴
+    }
+    
+    bool handle_message(const MessageBase& msg) noexcept override {
+        if (msg.type_id() == MESSAGE_TYPE_ID(transport::FlushRequest)) {
+            return true;  // 방문 끝의 flush만 필요
+        }
+        return transport_.enqueue(msg, remote_id_);
+    }
+
+private:
+    TransportT& transport_;
+    const AgentId remote_id_;
+};
+
+} // namespace mini_so
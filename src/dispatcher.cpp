@@ -0,0 +1,166 @@
+/**
+ * @file dispatcher.cpp
+ * @brief Mini SObjectizer Dispatcher Implementation
+ *
+ * Implementation components:
+ * - WorkerThread: FreeRTOS task (core-pinned on SMP ports) / host std::thread
+ * - DispatcherBase: Agent binding between Environment and dispatcher ReadySets
+ * - OneThreadDispatcher: single worker serving one agent group
+ *
+ * Template dispatchers (ThreadPoolDispatcher, ActiveObjectDispatcher) are
+ * implemented in dispatcher.h.
+ */
+
+#include "mini_sobjectizer/dispatcher/dispatcher.h"
+
+namespace mini_so {
+
+namespace detail {
+
+// ============================================================================
+// WorkerThread Implementation
+// ============================================================================
+
+bool WorkerThread::start(Entry entry, void* arg, const WorkerConfig& config) noexcept {
+    if (started_) [[unlikely]] {
+        return false;
+    }
+    
+    entry_ = entry;
+    arg_ = arg;
+    exited_.store(false, std::memory_order_release);
+
+#ifdef UNIT_TEST
+    // 호스트: 코어 고정 없이 std::thread로 실행
+    (void)config;
+    thread_ = std::thread([this]() noexcept { run(); });
+#else
+#if defined(ESP_PLATFORM)
+    // ESP-IDF: 스택 크기는 바이트 단위
+    BaseType_t created = xTaskCreatePinnedToCore(
+        &WorkerThread::task_entry, config.name, config.stack_words * sizeof(StackType_t),
+        this, config.priority, &task_,
+        config.core == ANY_CORE ? tskNO_AFFINITY : static_cast<BaseType_t>(config.core));
+#else
+    BaseType_t created = xTaskCreate(
+        &WorkerThread::task_entry, config.name, static_cast<configSTACK_DEPTH_TYPE>(config.stack_words),
+        this, config.priority, &task_);
+#if defined(configUSE_CORE_AFFINITY) && (configUSE_CORE_AFFINITY == 1) && (configNUMBER_OF_CORES > 1)
+    // SMP FreeRTOS (RP2040 등): 생성 직후 코어 마스크 고정
+    if (created == pdPASS && config.core != ANY_CORE) {
+        vTaskCoreAffinitySet(task_, static_cast<UBaseType_t>(1u << config.core));
+    }
+#endif
+#endif
+    if (created != pdPASS) [[unlikely]] {
+        task_ = nullptr;
+        return false;
+    }
+#endif
+
+    started_ = true;
+    return true;
+}
+
+void WorkerThread::join() noexcept {
+    if (!started_) {
+        return;
+    }
+
+#ifdef UNIT_TEST
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+#else
+    // 태스크는 entry 반환 후 스스로 삭제됨 - 종료 표시만 기다림
+    while (!exited()) {
+        yield();
+    }
+    task_ = nullptr;
+#endif
+    started_ = false;
+}
+
+void WorkerThread::yield() noexcept {
+#ifdef UNIT_TEST
+    std::this_thread::yield();
+#else
+    vTaskDelay(1);
+#endif
+}
+
+#ifndef UNIT_TEST
+void WorkerThread::task_entry(void* self) {
+    static_cast<WorkerThread*>(self)->run();
+    vTaskDelete(nullptr);
+}
+#endif
+
+// ============================================================================
+// DispatcherBase Implementation
+// ============================================================================
+
+bool DispatcherBase::attach(Agent& agent, ReadySet& set) noexcept {
+    const std::size_t index = detail::agent_index(agent.id());
+    if (index >= MINI_SO_MAX_AGENTS || agents_[index]) [[unlikely]] {
+        return false;
+    }
+    
+    Environment& env = agent.environment();
+    if (env.get_agent(agent.id()) != &agent) [[unlikely]] {
+        return false;  // Environment에 등록되지 않은 Agent
+    }
+    
+    agents_[index] = &agent;
+    bound_count_++;
+    
+    // 이후 push는 이 디스패처의 ReadySet을 표시, Environment의 남은 비트는 제거 (슬롯 인덱스 기준)
+    agent.message_queue_.bind_ready_set(&set, index);
+    env.ready_.clear(index);
+    return true;
+}
+
+bool DispatcherBase::detach(Agent& agent) noexcept {
+    if (!is_bound(agent)) [[unlikely]] {
+        return false;
+    }
+    
+    const std::size_t index = detail::agent_index(agent.id());
+    agents_[index] = nullptr;
+    bound_count_--;
+    
+    agent.message_queue_.bind_ready_set(&agent.environment().ready_, index);
+    return true;
+}
+
+} // namespace detail
+
+// ============================================================================
+// OneThreadDispatcher Implementation
+// ============================================================================
+
+bool OneThreadDispatcher::start() noexcept {
+    if (running()) {
+        return true;
+    }
+    
+    running_.store(true, std::memory_order_release);
+    if (!worker_.start(&OneThreadDispatcher::worker_entry, this, config_)) [[unlikely]] {
+        running_.store(false, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+void OneThreadDispatcher::stop() noexcept {
+    stop_workers(&worker_, 1);
+}
+
+void OneThreadDispatcher::worker_entry(void* self) noexcept {
+    auto* dispatcher = static_cast<OneThreadDispatcher*>(self);
+    dispatcher->worker_loop([dispatcher]() noexcept {
+        return detail::run_ready_round(dispatcher->ready_, dispatcher->agents_);
+    });
+}
+
+} // namespace mini_so
@@ -0,0 +1,354 @@
+/**
+ * @file flight_recorder.cpp
+ * @brief Mini SObjectizer Flight Recorder Implementation
+ *
+ * Implementation components:
+ * - FlightRecorder mount: page scan, write position recovery, boot counter
+ * - Staging / flush: double-buffered record staging, batched page programming
+ * - Readback: oldest-first record iteration with CRC validation
+ *
+ * Storage drivers (FlightStorage, RetainedStorage) and the periodic flush agent
+ * are implemented in flight_recorder.h.
+ */
+
+#include "mini_sobjectizer/diag/flight_recorder.h"
+#include "mini_sobjectizer/transport/transport.h"
+
+namespace mini_so {
+
+namespace {
+    // 연결된 recorder (emergency hook은 컨텍스트 없는 함수 포인터)
+    FlightRecorder* g_attached_recorder = nullptr;
+    
+    // 헤더 앞 4바이트(size, kind, check) + payload
+    uint32_t record_crc(const flight::RecordHeader& header, const void* payload) noexcept {
+        const uint32_t crc = transport::crc32(&header, offsetof(flight::RecordHeader, crc));
+        return transport::crc32(payload, header.size, crc);
+    }
+    
+    // 끝에서부터 capacity - 1자까지 (파일 이름은 경로를 뺀 부분)
+    void copy_text(char* out, std::size_t capacity, const char* text) noexcept {
+        std::size_t length = 0;
+        if (text) {
+            length = std::strlen(text);
+            if (length >= capacity) length = capacity - 1;
+            std::memcpy(out, text, length);
+        }
+        std::memset(out + length, 0, capacity - length);
+    }
+    
+    const char* base_name(const char* path) noexcept {
+        if (!path) return nullptr;
+        const char* name = path;
+        for (const char* it = path; *it; ++it) {
+            if (*it == '/' || *it == '\\') name = it + 1;
+        }
+        return name;
+    }
+}
+
+// ============================================================================
+// Mount
+// ============================================================================
+
+bool FlightRecorder::mount() noexcept {
+    const std::size_t pages = storage_.page_count();
+    const std::size_t page_size = storage_.page_size();
+    if (pages < 2 || page_size < sizeof(flight::PageHeader) + flight::record_bytes(MAX_RECORD)) [[unlikely]] {
+        return false;
+    }
+    
+    // 가장 큰 순번의 페이지가 현재 페이지
+    bool found = false;
+    for (std::size_t page = 0; page < pages; ++page) {
+        flight::PageHeader header{};
+        if (!storage_.read(page, 0, &header, sizeof(header)) || header.magic != flight::PAGE_MAGIC) {
+            continue;
+        }
+        if (!found || static_cast<int32_t>(header.sequence - sequence_) > 0) {
+            page_ = page;
+            sequence_ = header.sequence;
+            boot_ = header.boot;
+            found = true;
+        }
+    }
+    
+    if (found) {
+        // 현재 페이지의 마지막 유효 레코드 뒤가 쓰기 위치. 끊긴 레코드가 있으면 다음 기록은 새 페이지
+        flight::RecordHeader header{};
+        alignas(8) uint8_t payload[MAX_RECORD];
+        std::size_t offset = sizeof(flight::PageHeader);
+        while (offset + sizeof(header) <= page_size && read_record(page_, offset, header, payload)) {
+            if (static_cast<flight::RecordKind>(header.kind) == flight::RecordKind::BOOT &&
+                header.size >= sizeof(flight::BootRecord)) {
+                boot_ = reinterpret_cast<const flight::BootRecord*>(payload)->boot_count;
+            }
+            offset += flight::record_bytes(header.size);
+        }
+        if (offset + sizeof(header) <= page_size) {
+            storage_.read(page_, offset, &header, sizeof(header));
+            if (header.size != flight::ERASED_SIZE || header.kind != 0xFF) {
+                offset = page_size;
+            }
+        }
+        write_offset_ = offset;
+    } else {
+        page_ = pages - 1;   // 첫 기록이 페이지 0을 엶
+        sequence_ = 0;
+        write_offset_ = page_size;
+    }
+    
+    mounted_ = true;
+    boot_++;
+    const flight::BootRecord boot{boot_, 0};
+    append(flight::RecordKind::BOOT, &boot, sizeof(boot));
+    flush();
+    return write_errors_.load(std::memory_order_relaxed) == 0;
+}
+
+void FlightRecorder::attach(ErrorAgent& errors) noexcept {
+    g_attached_recorder = this;
+    errors.set_sink(&error_sink, this);
+    emergency::set_failure_hook(&failure_hook);
+}
+
+void FlightRecorder::detach(ErrorAgent& errors) noexcept {
+    errors.set_sink(nullptr, nullptr);
+    if (g_attached_recorder == this) {
+        g_attached_recorder = nullptr;
+        emergency::set_failure_hook(nullptr);
+    }
+}
+
+void FlightRecorder::failure_hook(const emergency::FailureContext& context) noexcept {
+    if (FlightRecorder* recorder = g_attached_recorder) {
+        recorder->record_failure(context);
+    }
+}
+
+void FlightRecorder::error_sink(void* context, const ErrorAgent::ErrorEntry& entry) noexcept {
+    static_cast<FlightRecorder*>(context)->record_error(entry);
+}
+
+// ============================================================================
+// Staging
+// ============================================================================
+
+bool FlightRecorder::append(flight::RecordKind kind, const void* data, std::size_t size) noexcept {
+    if (size > MAX_RECORD) [[unlikely]] {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // 생산자끼리는 대기하지 않음 - 경합이면 버림 (디스패치 경로를 멈추지 않음)
+    if (append_lock_.test_and_set(std::memory_order_acquire)) [[unlikely]] {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    Staging& staging = staging_[active_.load(std::memory_order_relaxed)];
+    const std::size_t length = flight::record_bytes(size);
+    if (staging.used + length > STAGING_BYTES) [[unlikely]] {
+        append_lock_.clear(std::memory_order_release);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    flight::RecordHeader header{};
+    header.size = static_cast<uint16_t>(size);
+    header.kind = static_cast<uint8_t>(kind);
+    header.check = static_cast<uint8_t>(~header.kind);
+    header.crc = record_crc(header, data);
+    
+    uint8_t* out = &staging.bytes[staging.used];
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), data, size);
+    std::memset(out + sizeof(header) + size, 0, length - sizeof(header) - size);
+    staging.used += length;
+    
+    append_lock_.clear(std::memory_order_release);
+    return true;
+}
+
+void FlightRecorder::record_error(const ErrorAgent::ErrorEntry& entry) noexcept {
+    const flight::ErrorRecord record{entry.error_code, entry.timestamp, entry.source_agent,
+                                     static_cast<uint8_t>(entry.level), 0};
+    append(flight::RecordKind::ERROR, &record, sizeof(record));
+}
+
+void FlightRecorder::record_failure(const emergency::FailureContext& context) noexcept {
+    flight::FailureRecord record{};
+    record.reason = static_cast<uint32_t>(context.reason);
+    record.line = context.line;
+    record.timestamp = context.timestamp;
+    record.heap_free_bytes = context.heap_free_bytes;
+    record.stack_usage = context.stack_usage;
+    copy_text(record.file, sizeof(record.file), base_name(context.file));
+    copy_text(record.function, sizeof(record.function), context.function);
+    copy_text(record.info, sizeof(record.info), context.additional_info);
+    append(flight::RecordKind::FAILURE, &record, sizeof(record));
+    flush();
+}
+
+// ============================================================================
+// Flush
+// ============================================================================
+
+std::size_t FlightRecorder::flush() noexcept {
+    if (!mounted_ || flush_lock_.test_and_set(std::memory_order_acquire)) {
+        return 0;
+    }
+    
+    collect_trace();
+    
+    // 생산자가 쓰는 중이면 이번에는 교체하지 않음 (우선순위 역전 없이 다음 flush에서)
+    std::size_t written = 0;
+    if (!append_lock_.test_and_set(std::memory_order_acquire)) {
+        const uint8_t index = active_.load(std::memory_order_relaxed);
+        active_.store(static_cast<uint8_t>(index ^ 1), std::memory_order_relaxed);
+        append_lock_.clear(std::memory_order_release);
+        
+        Staging& staging = staging_[index];
+        const uint32_t before = records_written_.load(std::memory_order_relaxed);
+        program_staged(staging);
+        staging.used = 0;
+        written = records_written_.load(std::memory_order_relaxed) - before;
+    }
+    
+    flush_lock_.clear(std::memory_order_release);
+    return written;
+}
+
+void FlightRecorder::collect_trace() noexcept {
+#if MINI_SO_ENABLE_TRACE
+    constexpr std::size_t PER_RECORD = MAX_RECORD / sizeof(trace::Event);
+    static_assert(PER_RECORD > 0, "MINI_SO_FLIGHT_MAX_RECORD must hold a trace event");
+    
+    for (std::size_t core = 0; core < trace::core_count(); ++core) {
+        trace::Event batch[PER_RECORD];
+        std::size_t count = 0;
+        uint32_t last = trace_seen_[core];
+        bool full = false;
+        auto emit = [&]() noexcept {
+            if (count > 0 && !full) {
+                full = !append(flight::RecordKind::TRACE, batch, count * sizeof(trace::Event));
+            }
+            count = 0;
+        };
+        trace::ring(core).for_each([&](const trace::Event& event) noexcept {
+            if (event.sequence == 0 || static_cast<int32_t>(event.sequence - trace_seen_[core]) <= 0) {
+                return;  // 덮어써졌거나 이미 기록함
+            }
+            batch[count++] = event;
+            last = event.sequence;
+            if (count == PER_RECORD) emit();
+        });
+        emit();
+        trace_seen_[core] = last;
+    }
+#endif
+}
+
+bool FlightRecorder::open_page(std::size_t page) noexcept {
+    const flight::PageHeader header{flight::PAGE_MAGIC, sequence_ + 1, boot_, 0};
+    if (!storage_.erase(page) || !storage_.program(page, 0, &header, sizeof(header))) [[unlikely]] {
+        write_errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    pages_erased_.fetch_add(1, std::memory_order_relaxed);
+    page_ = page;
+    sequence_ = header.sequence;
+    write_offset_ = sizeof(header);
+    return true;
+}
+
+void FlightRecorder::program_staged(const Staging& staging) noexcept {
+    const std::size_t pages = storage_.page_count();
+    const std::size_t page_size = storage_.page_size();
+    std::size_t pos = 0;
+    while (pos < staging.used) {
+        flight::RecordHeader header;
+        std::memcpy(&header, &staging.bytes[pos], sizeof(header));
+        const std::size_t length = flight::record_bytes(header.size);
+        
+        // 레코드는 페이지를 넘지 않음 - 가장 오래된 페이지를 지워 다음 페이지로
+        if (write_offset_ + length > page_size && !open_page((page_ + 1) % pages)) [[unlikely]] {
+            write_offset_ = page_size;
+            return;  // 나머지는 버림 (다음 flush에서 다음 페이지 재시도)
+        }
+        if (!storage_.program(page_, write_offset_, &staging.bytes[pos], length)) [[unlikely]] {
+            write_errors_.fetch_add(1, std::memory_order_relaxed);
+            write_offset_ = page_size;
+            return;
+        }
+        write_offset_ += length;
+        pos += length;
+        records_written_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// Readback
+// ============================================================================
+
+FlightRecorder::Cursor FlightRecorder::begin() const noexcept {
+    // 현재 페이지 다음이 가장 오래된 페이지 (round-robin)
+    const std::size_t pages = storage_.page_count();
+    return Cursor{0, pages > 0 ? (page_ + 1) % pages : 0, 0};
+}
+
+bool FlightRecorder::read_record(std::size_t page, std::size_t offset, flight::RecordHeader& header,
+                                 uint8_t* payload) const noexcept {
+    const std::size_t page_size = storage_.page_size();
+    if (offset + sizeof(header) > page_size || !storage_.read(page, offset, &header, sizeof(header))) {
+        return false;
+    }
+    if (header.size > MAX_RECORD || header.check != static_cast<uint8_t>(~header.kind) ||
+        offset + flight::record_bytes(header.size) > page_size) {
+        return false;  // 지워진 영역 또는 끊긴 레코드
+    }
+    return storage_.read(page, offset + sizeof(header), payload, header.size) &&
+           record_crc(header, payload) == header.crc;
+}
+
+bool FlightRecorder::next(Cursor& cursor, flight::RecordHeader& header, uint8_t* payload,
+                          uint32_t& boot) const noexcept {
+    const std::size_t pages = storage_.page_count();
+    while (cursor.visited < pages) {
+        if (cursor.offset == 0) {
+            flight::PageHeader page_header{};
+            if (storage_.read(cursor.page, 0, &page_header, sizeof(page_header)) &&
+                page_header.magic == flight::PAGE_MAGIC) {
+                cursor.offset = sizeof(page_header);
+                boot = page_header.boot;
+            }
+        }
+        if (cursor.offset != 0 && read_record(cursor.page, cursor.offset, header, payload)) {
+            cursor.offset += flight::record_bytes(header.size);
+            return true;
+        }
+        cursor.visited++;
+        cursor.page = (cursor.page + 1) % pages;
+        cursor.offset = 0;
+    }
+    return false;
+}
+
+bool FlightRecorder::last_failure(flight::FailureRecord& failure) const noexcept {
+    bool found = false;
+    for_each([&](const flight::Record& record) noexcept {
+        if (record.kind == flight::RecordKind::FAILURE && record.boot < boot_) {
+            if (const auto* data = record.as<flight::FailureRecord>()) {
+                failure = *data;
+                found = true;
+            }
+        }
+    });
+    return found;
+}
+
+flight::Stats FlightRecorder::stats() const noexcept {
+    return flight::Stats{records_written_.load(std::memory_order_relaxed), pages_erased_.load(std::memory_order_relaxed),
+                         dropped_.load(std::memory_order_relaxed), write_errors_.load(std::memory_order_relaxed)};
+}
+
+} // namespace mini_so
@@ -8,6 +8,7 @@
  * Key features:
  * - Dummy implementations of semaphore functions (always return success)
  * - Task-related function simulations
+ * - Per-thread task notifications (blocking, for host dispatcher threads)
  * - Virtual implementations of time-related functions
  * 
  * Usage:
@@ -23,6 +24,10 @@
 
 #ifdef UNIT_TEST
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 extern "C" {
 
 // Mock FreeRTOS types and constants
@@ -46,6 +51,11 @@ SemaphoreHandle_t xSemaphoreCreateMutex(void) {
     return (SemaphoreHandle_t)0x12345678;
 }
 
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(void* pxMutexBuffer) {
+    // The control block itself serves as the handle
+    return (SemaphoreHandle_t)pxMutexBuffer;
+}
+
 BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait) {
     (void)xSemaphore;
     (void)xTicksToWait;
@@ -74,6 +84,66 @@ void taskDISABLE_INTERRUPTS(void) {
     // Nothing to do in mock - interrupts don't exist on host
 }
 
+} // extern "C"
+
+// Task notification per host thread (dispatcher workers run on std::thread).
+// Slots are never freed so a late notify to an exited thread stays valid.
+struct MockTaskNotification {
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t count = 0;
+};
+
+static MockTaskNotification* current_notification() {
+    static thread_local MockTaskNotification* slot = new MockTaskNotification();
+    return slot;
+}
+
+extern "C" {
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return (TaskHandle_t)current_notification();
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify) {
+    auto* slot = static_cast<MockTaskNotification*>(xTaskToNotify);
+    if (!slot) return pdFALSE;
+    {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->count++;
+    }
+    slot->cv.notify_one();
+    return pdTRUE;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t* pxHigherPriorityTaskWoken) {
+    if (xTaskNotifyGive(xTaskToNotify) == pdTRUE && pxHigherPriorityTaskWoken) {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+    // 1 tick = 1ms (configTICK_RATE_HZ 1000). Single-threaded callers only block
+    // for the given timeout since nothing else can notify them.
+    auto* slot = current_notification();
+    std::unique_lock<std::mutex> lock(slot->mutex);
+    if (slot->count == 0 && xTicksToWait != 0) {
+        auto ready = [slot] { return slot->count > 0; };
+        if (xTicksToWait == portMAX_DELAY) {
+            slot->cv.wait(lock, ready);
+        } else {
+            slot->cv.wait_for(lock, std::chrono::milliseconds(xTicksToWait), ready);
+        }
+    }
+    uint32_t count = slot->count;
+    if (xClearCountOnExit) {
+        slot->count = 0;
+    } else if (slot->count > 0) {
+        slot->count--;
+    }
+    return count;
+}
+
 void vTaskDelay(TickType_t xTicksToDelay) {
     (void)xTicksToDelay;
     // In real implementation this would yield to other tasks
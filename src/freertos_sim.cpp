@@ -0,0 +1,430 @@
+/**
+ * @file freertos_sim.cpp
+ * @brief Threaded FreeRTOS Simulator for Host Concurrency Testing
+ *
+ * Drop-in replacement for freertos_mock.cpp (link one or the other) that maps
+ * FreeRTOS primitives onto real host threads:
+ * - Tasks run on std::thread (started by vTaskStartScheduler, or immediately
+ *   when created after the scheduler started)
+ * - Mutexes block with timeouts and track their owner
+ * - Queues copy fixed-size items with blocking send/receive
+ * - Task notifications block per task (threads not created through
+ *   xTaskCreate, e.g. host dispatcher workers, get a task record lazily)
+ * - Ticks are real milliseconds since start
+ *
+ * Usage:
+ * - Configure with -DMINI_SO_HOST_SIMULATOR=ON (examples/bench link this file)
+ * - Combine with -DMINI_SO_ENABLE_TSAN=ON to let ThreadSanitizer check the
+ *   lock-free queue paths under real contention
+ *
+ * @note Host-only. Priorities are recorded but not enforced.
+ */
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+#ifdef UNIT_TEST
+
+#include "mini_sobjectizer/host/freertos_sim.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using SimClock = std::chrono::steady_clock;
+
+const SimClock::time_point& sim_epoch() {
+    static const SimClock::time_point epoch = SimClock::now();
+    return epoch;
+}
+
+// 1 tick = 1 ms; portMAX_DELAY = 무기한
+template<typename Lock, typename Predicate>
+bool wait_ticks(std::condition_variable& cv, Lock& lock, TickType_t ticks, Predicate ready) {
+    if (ticks == portMAX_DELAY) {
+        cv.wait(lock, ready);
+        return true;
+    }
+    return cv.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+struct SimTask {
+    TaskFunction_t entry = nullptr;
+    void* parameters = nullptr;
+    char name[16] = "host";
+    UBaseType_t priority = 0;
+    std::thread thread;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t notification = 0;
+    bool deleted = false;
+    bool scheduled = false;   // xTaskCreate로 생성 (스케줄러 live 카운트 대상)
+    bool finished = false;
+};
+
+// 태스크 레코드는 해제하지 않음 (종료된 태스크에 대한 늦은 notify/query도 유효)
+struct Scheduler {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<SimTask*> pending;
+    std::size_t live = 0;
+    bool started = false;
+    bool end_requested = false;
+};
+
+Scheduler& scheduler() {
+    static Scheduler* instance = new Scheduler();
+    return *instance;
+}
+
+thread_local SimTask* current_task_slot = nullptr;
+
+SimTask* current_task() {
+    if (!current_task_slot) {
+        current_task_slot = new SimTask();
+    }
+    return current_task_slot;
+}
+
+// 호출 전 task->mutex 보유 - 태스크당 한 번만 live 카운트 감소
+void task_finished(SimTask* task) {
+    if (!task->scheduled || task->finished) return;
+    task->finished = true;
+    Scheduler& sched = scheduler();
+    std::lock_guard<std::mutex> lock(sched.mutex);
+    if (sched.live > 0) sched.live--;
+    sched.cv.notify_all();
+}
+
+// 삭제된 태스크는 FreeRTOS처럼 다시 실행되지 않도록 여기서 영구 정지
+void park_if_deleted(SimTask* task) {
+    std::unique_lock<std::mutex> lock(task->mutex);
+    if (!task->deleted) return;
+    task_finished(task);
+    task->cv.wait(lock, [] { return false; });
+}
+
+void run_task(SimTask* task) {
+    current_task_slot = task;
+    task->entry(task->parameters);
+    // FreeRTOS 태스크는 반환하면 안 되지만 호스트 테스트 편의상 종료로 처리
+    std::lock_guard<std::mutex> lock(task->mutex);
+    task->deleted = true;
+    task_finished(task);
+}
+
+void launch(SimTask* task) {
+    task->thread = std::thread(run_task, task);
+    task->thread.detach();
+}
+
+struct SimMutex {
+    std::mutex mutex;
+    std::condition_variable cv;
+    SimTask* owner = nullptr;
+    bool in_place = false;  // xSemaphoreCreateMutexStatic 버퍼에 생성됨
+};
+
+static_assert(sizeof(SimMutex) <= sizeof(StaticSemaphore_t) && alignof(SimMutex) <= alignof(StaticSemaphore_t),
+              "StaticSemaphore_t too small for the simulated mutex");
+
+struct SimQueue {
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<std::vector<uint8_t>> items;
+    UBaseType_t length = 0;
+    UBaseType_t item_size = 0;
+};
+
+} // namespace
+
+extern "C" {
+
+// ============================================================================
+// Mutexes
+// ============================================================================
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return static_cast<SemaphoreHandle_t>(new SimMutex());
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* pxMutexBuffer) {
+    if (!pxMutexBuffer) return nullptr;
+    auto* mutex = new (pxMutexBuffer) SimMutex();
+    mutex->in_place = true;
+    return static_cast<SemaphoreHandle_t>(mutex);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait) {
+    auto* mutex = static_cast<SimMutex*>(xSemaphore);
+    if (!mutex) return pdFALSE;
+    SimTask* self = current_task();
+    park_if_deleted(self);
+
+    std::unique_lock<std::mutex> lock(mutex->mutex);
+    if (mutex->owner == self) {
+        // FreeRTOS 표준 뮤텍스는 재귀 불가 - 실제 타겟에서는 교착
+        std::fprintf(stderr, "freertos_sim: task '%s' took mutex %p twice (deadlock on target)\n",
+                     self->name, xSemaphore);
+        std::abort();
+    }
+    if (!wait_ticks(mutex->cv, lock, xTicksToWait, [mutex] { return mutex->owner == nullptr; })) {
+        return pdFALSE;
+    }
+    mutex->owner = self;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+    auto* mutex = static_cast<SimMutex*>(xSemaphore);
+    if (!mutex) return pdFALSE;
+    {
+        std::lock_guard<std::mutex> lock(mutex->mutex);
+        if (mutex->owner != current_task()) return pdFALSE;
+        mutex->owner = nullptr;
+    }
+    mutex->cv.notify_one();
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore) {
+    auto* mutex = static_cast<SimMutex*>(xSemaphore);
+    if (mutex && mutex->in_place) {
+        mutex->~SimMutex();
+        return;
+    }
+    delete mutex;
+}
+
+// ============================================================================
+// Time
+// ============================================================================
+
+TickType_t xTaskGetTickCount(void) {
+    return static_cast<TickType_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(SimClock::now() - sim_epoch()).count());
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+    SimTask* self = current_task();
+    park_if_deleted(self);
+    if (xTicksToDelay == 0) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(xTicksToDelay));
+    }
+    park_if_deleted(self);
+}
+
+void taskDISABLE_INTERRUPTS(void) {
+    // Nothing to do - interrupts don't exist on host
+}
+
+// ============================================================================
+// Tasks
+// ============================================================================
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char* pcName, uint32_t usStackDepth,
+                       void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pxCreatedTask) {
+    (void)usStackDepth;
+    if (!pxTaskCode) return pdFAIL;
+
+    auto* task = new SimTask();
+    task->entry = pxTaskCode;
+    task->parameters = pvParameters;
+    task->priority = uxPriority;
+    task->scheduled = true;
+    if (pcName) {
+        std::strncpy(task->name, pcName, sizeof(task->name) - 1);
+    }
+    if (pxCreatedTask) {
+        *pxCreatedTask = static_cast<TaskHandle_t>(task);
+    }
+
+    Scheduler& sched = scheduler();
+    std::lock_guard<std::mutex> lock(sched.mutex);
+    sched.live++;
+    if (sched.started) {
+        launch(task);
+    } else {
+        sched.pending.push_back(task);
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+    SimTask* self = current_task();
+    auto* task = xTaskToDelete ? static_cast<SimTask*>(xTaskToDelete) : self;
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->deleted = true;
+    }
+    task->cv.notify_all();
+    if (task == self) {
+        park_if_deleted(self);
+    }
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return static_cast<TaskHandle_t>(current_task());
+}
+
+const char* pcTaskGetName(TaskHandle_t xTaskToQuery) {
+    auto* task = xTaskToQuery ? static_cast<SimTask*>(xTaskToQuery) : current_task();
+    return task->name;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask) {
+    auto* task = xTask ? static_cast<SimTask*>(xTask) : current_task();
+    return task->priority;
+}
+
+void vTaskStartScheduler(void) {
+    Scheduler& sched = scheduler();
+    std::unique_lock<std::mutex> lock(sched.mutex);
+    sched.started = true;
+    for (SimTask* task : sched.pending) {
+        launch(task);
+    }
+    sched.pending.clear();
+    sched.cv.wait(lock, [&sched] { return sched.live == 0 || sched.end_requested; });
+    sched.started = false;
+    sched.end_requested = false;
+}
+
+void vTaskEndScheduler(void) {
+    Scheduler& sched = scheduler();
+    std::lock_guard<std::mutex> lock(sched.mutex);
+    sched.end_requested = true;
+    sched.cv.notify_all();
+}
+
+// ============================================================================
+// Task notifications
+// ============================================================================
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify) {
+    auto* task = static_cast<SimTask*>(xTaskToNotify);
+    if (!task) return pdFALSE;
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notification++;
+    }
+    task->cv.notify_all();
+    return pdTRUE;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t* pxHigherPriorityTaskWoken) {
+    if (xTaskNotifyGive(xTaskToNotify) == pdTRUE && pxHigherPriorityTaskWoken) {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+    SimTask* self = current_task();
+    park_if_deleted(self);
+
+    std::unique_lock<std::mutex> lock(self->mutex);
+    if (self->notification == 0 && xTicksToWait != 0) {
+        wait_ticks(self->cv, lock, xTicksToWait, [self] { return self->notification > 0 || self->deleted; });
+        if (self->deleted) {
+            lock.unlock();
+            park_if_deleted(self);
+        }
+    }
+    uint32_t count = self->notification;
+    if (xClearCountOnExit) {
+        self->notification = 0;
+    } else if (self->notification > 0) {
+        self->notification--;
+    }
+    return count;
+}
+
+// ============================================================================
+// Queues
+// ============================================================================
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+    if (uxQueueLength == 0) return nullptr;
+    auto* queue = new SimQueue();
+    queue->length = uxQueueLength;
+    queue->item_size = uxItemSize;
+    return static_cast<QueueHandle_t>(queue);
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait) {
+    auto* queue = static_cast<SimQueue*>(xQueue);
+    if (!queue) return pdFALSE;
+    park_if_deleted(current_task());
+
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!wait_ticks(queue->not_full, lock, xTicksToWait,
+                    [queue] { return queue->items.size() < queue->length; })) {
+        return errQUEUE_FULL;
+    }
+    const auto* bytes = static_cast<const uint8_t*>(pvItemToQueue);
+    queue->items.emplace_back(bytes, bytes + queue->item_size);
+    lock.unlock();
+    queue->not_empty.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait) {
+    auto* queue = static_cast<SimQueue*>(xQueue);
+    if (!queue) return pdFALSE;
+    park_if_deleted(current_task());
+
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!wait_ticks(queue->not_empty, lock, xTicksToWait, [queue] { return !queue->items.empty(); })) {
+        return pdFALSE;
+    }
+    std::memcpy(pvBuffer, queue->items.front().data(), queue->item_size);
+    queue->items.pop_front();
+    lock.unlock();
+    queue->not_full.notify_one();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue) {
+    auto* queue = static_cast<SimQueue*>(xQueue);
+    if (!queue) return 0;
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return static_cast<UBaseType_t>(queue->items.size());
+}
+
+void vQueueDelete(QueueHandle_t xQueue) {
+    delete static_cast<SimQueue*>(xQueue);
+}
+
+// ============================================================================
+// FreeRTOS hook functions
+// ============================================================================
+
+void vApplicationMallocFailedHook(void) {
+    std::fprintf(stderr, "freertos_sim: malloc failed hook called\n");
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName) {
+    (void)xTask;
+    std::fprintf(stderr, "freertos_sim: stack overflow hook called (%s)\n", pcTaskName ? pcTaskName : "?");
+}
+
+void vApplicationIdleHook(void) {
+}
+
+void vApplicationTickHook(void) {
+}
+
+} // extern "C"
+
+#endif // UNIT_TEST
@@ -34,6 +34,9 @@ struct SensorReading {
     uint32_t timestamp;
 };
 
+// Control logic only needs the freshest reading - unconsumed readings are overwritten in place
+MINI_SO_MESSAGE_COALESCE(SensorReading);
+
 struct ActuatorCommand {
     enum Action { START_MOTOR, STOP_MOTOR, OPEN_VALVE, CLOSE_VALVE } action;
     uint16_t parameter;  // speed, angle, etc.
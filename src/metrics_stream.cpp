@@ -0,0 +1,320 @@
+/**
+ * @file metrics_stream.cpp
+ * @brief Mini SObjectizer Metrics Stream Implementation
+ *
+ * Implementation components:
+ * - Snapshot collection: environment, agent, pool, arena and error counters into a sorted key table
+ * - Delta encoding: merge walk against the previous snapshot, frame splitting, keyframes
+ * - Decoding: frame validation and sorted table updates on the receiving side
+ *
+ * The sink interface and the periodic emit agent are implemented in metrics_stream.h.
+ */
+
+#include "mini_sobjectizer/diag/metrics_stream.h"
+#include "mini_sobjectizer/transport/transport.h"
+
+#include <algorithm>
+
+namespace mini_so {
+
+// ============================================================================
+// MetricsStream
+// ============================================================================
+
+bool MetricsStream::add_pool(uint16_t id, Probe in_use, Probe failures) noexcept {
+    if (!in_use || pool_count_ >= MAX_POOLS) [[unlikely]] {
+        return false;
+    }
+    for (std::size_t i = 0; i < pool_count_; ++i) {
+        if (pools_[i].id == id) [[unlikely]] return false;
+    }
+    pools_[pool_count_++] = PoolProbe{id, in_use, failures};
+    return true;
+}
+
+void MetricsStream::push(uint32_t key, uint32_t value) noexcept {
+    if (current_count_ >= FIELDS) [[unlikely]] {
+        truncated_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    current_[current_count_++] = metrics::Field{key, value};
+}
+
+std::size_t MetricsStream::collect() noexcept {
+    using metrics::Group;
+    using metrics::make_key;
+    current_count_ = 0;
+
+    push(make_key(Group::ENVIRONMENT, 0, metrics::AGENTS), static_cast<uint32_t>(env_.agent_count()));
+#if MINI_SO_ENABLE_METRICS
+    push(make_key(Group::ENVIRONMENT, 0, metrics::SENT), static_cast<uint32_t>(env_.total_messages_sent()));
+    push(make_key(Group::ENVIRONMENT, 0, metrics::PROCESSED), static_cast<uint32_t>(env_.total_messages_processed()));
+    push(make_key(Group::ENVIRONMENT, 0, metrics::MAX_LOOP_US), env_.max_processing_time_us());
+#endif
+    push(make_key(Group::ENVIRONMENT, 0, metrics::ISR_DROPPED), env_.isr_dropped());
+    push(make_key(Group::ENVIRONMENT, 0, metrics::THROTTLED), env_.throttled());
+
+    env_.for_each_agent([&](AgentId id, const Agent& agent) noexcept {
+        const auto key = [id](uint8_t metric) noexcept { return make_key(Group::AGENT, id, metric); };
+#if MINI_SO_ENABLE_METRICS
+        const AgentCounters counters = agent.counters();
+        push(key(metrics::MESSAGES), counters.messages);
+        push(key(metrics::VISITS), counters.visits);
+        push(key(metrics::BUSY_US), counters.busy_time_us);
+        push(key(metrics::MAX_VISIT_US), counters.max_visit_us);
+#endif
+#if MINI_SO_MAILBOX_STATS
+        const MailboxStats mailbox = agent.mailbox_stats();
+        push(key(metrics::HIGH_WATER_BYTES), mailbox.high_water_bytes);
+        push(key(metrics::PUSH_FAILURES), mailbox.push_failures());
+        push(key(metrics::SATURATIONS), mailbox.saturations);
+#endif
+        push(key(metrics::DROPPED), agent.overload_stats().dropped);
+        push(key(metrics::DEADLINE_MISSES), agent.deadline_misses());
+        push(key(metrics::THROTTLED_SENDS), agent.overload_stats().throttled);
+#if MINI_SO_ENABLE_LATENCY_HISTOGRAMS
+        if (const LatencyProfile* profile = env_.latency().agent(id)) {
+            push(key(metrics::QUEUE_P99_US), profile->queue.p99());
+            push(key(metrics::HANDLER_P99_US), profile->handler.p99());
+            push(key(metrics::HANDLER_MAX_US), profile->handler.max());
+        }
+#endif
+    });
+
+    const auto arena = [&](uint32_t size_class, const detail::ArenaClassStats& stats) noexcept {
+        push(make_key(Group::ARENA, size_class, metrics::IN_USE), static_cast<uint32_t>(stats.capacity - stats.available));
+        push(make_key(Group::ARENA, size_class, metrics::FAILURES), stats.exhausted);
+    };
+    arena(0, detail::MessageArena::class_stats<0>());
+    arena(1, detail::MessageArena::class_stats<1>());
+    arena(2, detail::MessageArena::class_stats<2>());
+    arena(3, detail::MessageArena::class_stats<3>());
+
+    if (const MailboxPoolBase* pool = env_.mailbox_pool()) {
+        push(make_key(Group::MAILBOX_POOL, 0, metrics::IN_USE), static_cast<uint32_t>(pool->blocks() - pool->available()));
+        push(make_key(Group::MAILBOX_POOL, 0, metrics::FAILURES), pool->failures());
+    }
+
+    if (System* system = env_.system()) {
+        const ErrorAgent& errors = system->error();
+        push(make_key(Group::ERRORS, 0, metrics::ERROR_COUNT), static_cast<uint32_t>(errors.error_count()));
+        push(make_key(Group::ERRORS, 0, metrics::MAX_LEVEL), static_cast<uint32_t>(errors.max_level()));
+    }
+
+    for (std::size_t i = 0; i < pool_count_; ++i) {
+        const PoolProbe& pool = pools_[i];
+        push(make_key(Group::POOL, pool.id, metrics::IN_USE), pool.in_use());
+        if (pool.failures) push(make_key(Group::POOL, pool.id, metrics::FAILURES), pool.failures());
+    }
+
+    // Agent는 live 순서(등록/해제에 따라 바뀜)로 모이므로 key 순으로 정렬 - 대부분 이미 정렬된 짧은 표
+    std::sort(current_.begin(), current_.begin() + current_count_,
+              [](const metrics::Field& a, const metrics::Field& b) noexcept { return a.key < b.key; });
+    return current_count_;
+}
+
+void MetricsStream::begin_frame(Encoder& encoder, uint8_t flags) noexcept {
+    encoder.offset = sizeof(metrics::FrameHeader);
+    encoder.entries = 0;
+    encoder.last_key = 0;
+    encoder.flags = flags;
+}
+
+bool MetricsStream::put(Encoder& encoder, uint32_t key, bool removed, uint32_t delta) noexcept {
+    // 항목이 들어갈 자리가 없으면 지금 프레임을 보내고 이어지는 sequence로 새 프레임 (키프레임 표시는 첫 프레임만)
+    if (encoder.offset + metrics::MAX_ENTRY_BYTES + metrics::CRC_BYTES > FRAME_BYTES || encoder.entries == 0xFFFF) {
+        if (!finish_frame(encoder)) [[unlikely]] return false;
+        begin_frame(encoder, 0);
+    }
+    encoder.offset += metrics::put_varint(&frame_[encoder.offset], ((key - encoder.last_key) << 1) | (removed ? 1u : 0u));
+    if (!removed) {
+        encoder.offset += metrics::put_varint(&frame_[encoder.offset], metrics::zigzag(static_cast<int32_t>(delta)));
+    }
+    encoder.last_key = key;
+    encoder.entries++;
+    return true;
+}
+
+bool MetricsStream::finish_frame(Encoder& encoder) noexcept {
+    const metrics::FrameHeader header{
+        metrics::FRAME_MAGIC, metrics::VERSION, encoder.flags, sequence_++, encoder.entries, time_ms_,
+        static_cast<uint16_t>(encoder.offset - sizeof(metrics::FrameHeader)), 0};
+    std::memcpy(frame_, &header, sizeof(header));
+    const uint32_t crc = transport::crc32(frame_, encoder.offset);
+    std::memcpy(&frame_[encoder.offset], &crc, sizeof(crc));
+    const std::size_t size = encoder.offset + sizeof(crc);
+
+    if (!sink_.write(frame_, size)) [[unlikely]] {
+        sink_failures_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    frames_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(static_cast<uint32_t>(size), std::memory_order_relaxed);
+    if (encoder.flags & metrics::KEYFRAME) keyframes_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+std::size_t MetricsStream::emit() noexcept {
+    if (emit_lock_.test_and_set(std::memory_order_acquire)) [[unlikely]] {
+        return 0;
+    }
+
+    snapshots_.fetch_add(1, std::memory_order_relaxed);
+    time_ms_ = now();
+    const std::size_t count = collect();
+    const uint32_t frames_before = frames_.load(std::memory_order_relaxed);
+
+    const bool keyframe = keyframe_pending_.exchange(false, std::memory_order_relaxed) ||
+                          ++since_keyframe_ >= KEYFRAME_INTERVAL;
+    const std::size_t previous = keyframe ? 0 : previous_count_;  // 키프레임은 빈 표 기준
+
+    Encoder encoder;
+    begin_frame(encoder, keyframe ? metrics::KEYFRAME : 0);
+    bool ok = true;
+
+    // key 순 merge: 이전에만 있음 = 제거, 현재에만 있음 = 새 항목 (0 기준), 둘 다 = 값이 바뀐 경우만
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (ok && (i < count || j < previous)) {
+        if (j < previous && (i >= count || previous_[j].key < current_[i].key)) {
+            ok = put(encoder, previous_[j].key, true, 0);
+            ++j;
+        } else if (j < previous && previous_[j].key == current_[i].key) {
+            if (current_[i].value != previous_[j].value) {
+                ok = put(encoder, current_[i].key, false, current_[i].value - previous_[j].value);
+            }
+            ++i;
+            ++j;
+        } else {
+            ok = put(encoder, current_[i].key, false, current_[i].value);
+            ++i;
+        }
+    }
+    if (ok && (encoder.entries > 0 || keyframe)) {
+        ok = finish_frame(encoder);
+    }
+
+    if (ok) {
+        std::copy(current_.begin(), current_.begin() + count, previous_.begin());
+        previous_count_ = count;
+        if (keyframe) since_keyframe_ = 0;
+    } else {
+        // 수신 측 상태를 알 수 없음 - 다음 스냅샷을 키프레임으로 다시 맞춤
+        keyframe_pending_.store(true, std::memory_order_relaxed);
+    }
+
+    const std::size_t sent = frames_.load(std::memory_order_relaxed) - frames_before;
+    emit_lock_.clear(std::memory_order_release);
+    return sent;
+}
+
+metrics::Stats MetricsStream::stats() const noexcept {
+    return metrics::Stats{
+        snapshots_.load(std::memory_order_relaxed),
+        frames_.load(std::memory_order_relaxed),
+        keyframes_.load(std::memory_order_relaxed),
+        bytes_.load(std::memory_order_relaxed),
+        sink_failures_.load(std::memory_order_relaxed),
+        truncated_.load(std::memory_order_relaxed)
+    };
+}
+
+// ============================================================================
+// MetricsDecoderBase
+// ============================================================================
+
+std::size_t MetricsDecoderBase::lower_bound(uint32_t key) const noexcept {
+    std::size_t low = 0;
+    std::size_t high = count_;
+    while (low < high) {
+        const std::size_t mid = low + (high - low) / 2;
+        if (fields_[mid].key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool MetricsDecoderBase::value(uint32_t key, uint32_t& value) const noexcept {
+    const std::size_t index = lower_bound(key);
+    if (index >= count_ || fields_[index].key != key) return false;
+    value = fields_[index].value;
+    return true;
+}
+
+MetricsDecoderBase::Result MetricsDecoderBase::apply(const uint8_t* frame, std::size_t size) noexcept {
+    metrics::FrameHeader header;
+    if (!frame || size < sizeof(header) + metrics::CRC_BYTES) [[unlikely]] {
+        return Result::BAD_FRAME;
+    }
+    std::memcpy(&header, frame, sizeof(header));
+    const std::size_t body_end = sizeof(header) + header.body_bytes;
+    if (header.magic != metrics::FRAME_MAGIC || header.version != metrics::VERSION ||
+        body_end + metrics::CRC_BYTES != size) [[unlikely]] {
+        return Result::BAD_FRAME;
+    }
+    uint32_t crc;
+    std::memcpy(&crc, frame + body_end, sizeof(crc));
+    if (crc != transport::crc32(frame, body_end)) [[unlikely]] {
+        return Result::BAD_FRAME;
+    }
+
+    const bool keyframe = (header.flags & metrics::KEYFRAME) != 0;
+    if (!keyframe && (!synced_ || header.sequence != static_cast<uint16_t>(sequence_ + 1))) {
+        synced_ = false;
+        return Result::OUT_OF_SYNC;
+    }
+    if (keyframe) count_ = 0;
+
+    // CRC가 맞은 프레임은 끝까지 적용 - 중간 손상(인코더 버그)이면 동기화를 풀어 다음 키프레임을 기다림
+    Result result = Result::APPLIED;
+    std::size_t offset = sizeof(header);
+    uint32_t key = 0;
+    for (uint16_t entry = 0; entry < header.entries; ++entry) {
+        uint32_t tag;
+        std::size_t n = metrics::get_varint(frame + offset, body_end - offset, tag);
+        if (n == 0) [[unlikely]] {
+            synced_ = false;
+            return Result::BAD_FRAME;
+        }
+        offset += n;
+        key += tag >> 1;
+        const std::size_t index = lower_bound(key);
+        const bool present = index < count_ && fields_[index].key == key;
+
+        if (tag & 1u) {  // 제거
+            if (present) {
+                std::memmove(&fields_[index], &fields_[index + 1], (count_ - index - 1) * sizeof(metrics::Field));
+                count_--;
+            }
+            continue;
+        }
+
+        uint32_t delta;
+        n = metrics::get_varint(frame + offset, body_end - offset, delta);
+        if (n == 0) [[unlikely]] {
+            synced_ = false;
+            return Result::BAD_FRAME;
+        }
+        offset += n;
+        const uint32_t change = static_cast<uint32_t>(metrics::unzigzag(delta));
+        if (present) {
+            fields_[index].value += change;
+        } else if (count_ < capacity_) {
+            std::memmove(&fields_[index + 1], &fields_[index], (count_ - index) * sizeof(metrics::Field));
+            fields_[index] = metrics::Field{key, change};
+            count_++;
+        } else {
+            result = Result::FULL;
+        }
+    }
+
+    sequence_ = header.sequence;
+    time_ms_ = header.time_ms;
+    synced_ = result == Result::APPLIED;
+    return result;
+}
+
+} // namespace mini_so
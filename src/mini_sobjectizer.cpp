@@ -5,7 +5,7 @@
  * Core implementation components:
  * - Environment: Singleton agent manager
  * - Agent: Base actor class for message handling
- * - MessageQueue: Lock-free circular buffer
+ * - MessageQueue: Lock-free SPSC/MPSC variable-size record ring (mutex policy optional)
  * - Emergency System: Real-time failure recovery
  * - Metrics: Performance monitoring
  * 
@@ -19,6 +19,12 @@
 #include "mini_sobjectizer/mini_sobjectizer.h"
 #include <cstring>
 #include <cstdio>  // Safe string formatting with snprintf
+#if MINI_SO_HIRES_CLOCK == MINI_SO_HIRES_STEADY
+#include <chrono>
+#endif
+#if MINI_SO_ENABLE_WARM_RESTART
+#include "mini_sobjectizer/transport/transport.h"  // transport::crc32 (보존 이미지 검증)
+#endif
 
 namespace mini_so {
 
@@ -31,6 +37,54 @@ namespace mini_so {
 namespace emergency {
     // 전역 Emergency 상태 (정적 메모리에 저장)
     static EmergencyState g_emergency_state;
+    static FailureHook g_failure_hook = nullptr;
+    
+    // 비상 디스패치 표 - 정적 메모리, 설정 단계에서만 채움. 전용 메일박스는 상수 초기화(.bss)
+    struct CriticalSlot {
+        std::atomic<Agent*> agent{nullptr};
+        AgentId id = INVALID_AGENT_ID;
+        CriticalMailbox mailbox;
+    };
+    static std::array<CriticalSlot, MINI_SO_EMERGENCY_AGENTS> g_critical;
+    static std::atomic<bool> g_dispatch_open{false};  // enter_emergency_mode 후 send 수락
+    
+    // 쓰기: 라운드는 비상 태스크 하나뿐 (load+store), rejected는 여러 발신자 (fetch_add)
+    static std::atomic<uint32_t> g_rounds{0};
+    static std::atomic<uint32_t> g_delivered{0};
+    static std::atomic<uint32_t> g_rejected{0};
+    static std::atomic<uint32_t> g_deferred{0};
+    static std::atomic<uint32_t> g_max_round_us{0};
+    
+    // 중요 Agent 한 라운드 - Agent당 최대 MINI_SO_EMERGENCY_BUDGET개, 표 순서로 방문
+    static void run_critical_round() noexcept {
+        const HiresTime start = hires_now();
+        uint32_t delivered = 0;
+        uint32_t deferred = 0;
+        for (CriticalSlot& slot : g_critical) {
+            Agent* agent = slot.agent.load(std::memory_order_acquire);
+            if (!agent || slot.mailbox.empty()) continue;
+            // 일반 디스패처가 아직 방문 중이면 핸들러를 겹쳐 실행하지 않고 다음 라운드 (기다리지 않음)
+            if (!agent->message_queue_.try_lock_consumer()) [[unlikely]] {
+                ++deferred;
+                continue;
+            }
+            uint32_t count = 0;
+            while (count < MINI_SO_EMERGENCY_BUDGET &&
+                   slot.mailbox.consume([agent](const MessageBase& msg, uint16_t) noexcept { agent->handle_message(msg); })) {
+                ++count;
+            }
+            agent->message_queue_.unlock_consumer();
+            delivered += count;
+            if (!slot.mailbox.empty()) ++deferred;
+        }
+        const uint32_t elapsed = hires_since_us(start);
+        g_rounds.store(g_rounds.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        g_delivered.store(g_delivered.load(std::memory_order_relaxed) + delivered, std::memory_order_relaxed);
+        g_deferred.store(g_deferred.load(std::memory_order_relaxed) + deferred, std::memory_order_relaxed);
+        if (elapsed > g_max_round_us.load(std::memory_order_relaxed)) {
+            g_max_round_us.store(elapsed, std::memory_order_relaxed);
+        }
+    }
     
     // 시스템 정보 수집 헬퍼
     uint32_t get_free_heap_size() noexcept {
@@ -67,6 +121,13 @@ namespace emergency {
         
         // 로그 출력
         emergency_log_failure(ctx);
+        if (g_failure_hook) {
+            g_failure_hook(ctx);
+        }
+    }
+    
+    void set_failure_hook(FailureHook hook) noexcept {
+        g_failure_hook = hook;
     }
     
     void enter_emergency_mode() noexcept {
@@ -75,6 +136,7 @@ namespace emergency {
         g_emergency_state.is_active = true;
         g_emergency_state.entered_time = now();
         g_emergency_state.restart_scheduled = false;
+        g_dispatch_open.store(true, std::memory_order_release);
         
         printf("[EMERGENCY] System entered emergency mode at %u\n", g_emergency_state.entered_time);
         
@@ -99,6 +161,12 @@ namespace emergency {
     void run_emergency_loop() noexcept {
         if (!g_emergency_state.is_active) return;
         
+#ifndef UNIT_TEST
+        const TickType_t round_start = xTaskGetTickCount();
+#endif
+        // 중요 Agent 먼저 - 상태 출력/재시작 판단보다 안전 메시지가 앞섬
+        run_critical_round();
+        
         static TimePoint last_status_time = 0;
         TimePoint current_time = now();
         
@@ -116,14 +184,19 @@ namespace emergency {
                 
                 // 최종 하드 락 (안전한 상태로 정지)
                 taskDISABLE_INTERRUPTS();
+#if MINI_SO_ENABLE_WARM_RESTART
+                warm::save();  // 인터럽트 off - 더 이상 Agent 상태가 바뀌지 않는 시점
+#endif
                 for(;;);  // 워치독이 시스템을 재시작할 것임
             }
         }
         
         // 최소 기능 유지 (예: UART 통신, LED 상태 표시)
-        // yield to other emergency tasks
+        // 라운드 시작 기준 주기로 대기 - 핸들러 시간만큼 주기가 늘어나지 않음
 #ifndef UNIT_TEST
-        vTaskDelay(pdMS_TO_TICKS(10));
+        const TickType_t period = pdMS_TO_TICKS(MINI_SO_EMERGENCY_PERIOD_MS);
+        const TickType_t spent = xTaskGetTickCount() - round_start;
+        vTaskDelay(spent < period ? period - spent : 1);
 #endif
     }
     
@@ -135,6 +208,60 @@ namespace emergency {
         return g_emergency_state.last_failure;
     }
     
+    bool set_critical(Agent& agent) noexcept {
+        const AgentId id = agent.id();
+        if (id == INVALID_AGENT_ID) [[unlikely]] return false;
+        CriticalSlot* free_slot = nullptr;
+        for (CriticalSlot& slot : g_critical) {
+            Agent* current = slot.agent.load(std::memory_order_relaxed);
+            if (current && slot.id == id) return current == &agent;
+            if (!current && !free_slot) free_slot = &slot;
+        }
+        if (!free_slot) return false;
+        free_slot->id = id;
+        free_slot->mailbox.clear();
+        free_slot->agent.store(&agent, std::memory_order_release);
+        return true;
+    }
+    
+    void clear_critical(Agent& agent) noexcept {
+        for (CriticalSlot& slot : g_critical) {
+            if (slot.agent.load(std::memory_order_relaxed) == &agent) {
+                slot.agent.store(nullptr, std::memory_order_release);
+                slot.id = INVALID_AGENT_ID;
+            }
+        }
+    }
+    
+    bool is_critical(AgentId agent_id) noexcept {
+        for (const CriticalSlot& slot : g_critical) {
+            if (slot.agent.load(std::memory_order_acquire) && slot.id == agent_id) return true;
+        }
+        return false;
+    }
+    
+    CriticalMailbox* critical_mailbox(AgentId agent_id) noexcept {
+        if (!g_dispatch_open.load(std::memory_order_acquire)) return nullptr;
+        for (CriticalSlot& slot : g_critical) {
+            if (slot.agent.load(std::memory_order_acquire) && slot.id == agent_id) return &slot.mailbox;
+        }
+        return nullptr;
+    }
+    
+    void note_rejected() noexcept {
+        g_rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    DegradedStats degraded_stats() noexcept {
+        return DegradedStats{
+            g_rounds.load(std::memory_order_relaxed),
+            g_delivered.load(std::memory_order_relaxed),
+            g_rejected.load(std::memory_order_relaxed),
+            g_deferred.load(std::memory_order_relaxed),
+            g_max_round_us.load(std::memory_order_relaxed)
+        };
+    }
+    
     void emergency_log_failure(const FailureContext& context) noexcept {
         printf("[CRITICAL FAILURE] =================\n");
         printf("Reason: %u\n", static_cast<uint32_t>(context.reason));
@@ -148,81 +275,238 @@ namespace emergency {
         printf("Additional: %s\n", context.additional_info);
         printf("=====================================\n");
         
-        // TODO: Flash memory나 EEPROM에 저장 (재부팅 후에도 유지)
-        // save_to_flash(&context, sizeof(context));
+        // 재부팅 후에도 유지되는 기록은 set_failure_hook (diag/flight_recorder.h)
+    }
+}
+
+#if MINI_SO_ENABLE_WARM_RESTART
+// ============================================================================
+// Warm Restart Implementation
+// ============================================================================
+namespace warm {
+    namespace {
+        // 일부러 초기화하지 않음 - 콜드 부팅의 임의 값은 magic/CRC 검사가 버림
+        struct RetainedImage {
+            ImageHeader header;
+            alignas(4) uint8_t bytes[IMAGE_BYTES];
+        };
+        RetainedImage g_image MINI_SO_RETAINED;
+        
+        // 채택한 레코드 (이번 부팅 RAM) - 레코드마다 복원 1회
+        struct Adopted {
+            std::size_t length = 0;
+            std::size_t records = 0;
+            std::size_t pending = 0;
+            std::size_t restored = 0;
+            bool valid = false;
+            std::array<uint8_t, IMAGE_BYTES / sizeof(Record)> used{};
+        };
+        Adopted& adopted() noexcept {
+            static Adopted instance;
+            return instance;
+        }
+        
+        constexpr std::size_t padded(std::size_t size) noexcept { return (size + 3) & ~std::size_t{3}; }
+    }
+    
+    bool save(Environment& env) noexcept {
+        g_image.header.magic = 0;  // 기록 중에 끊기면 이전 이미지도 무효
+        std::size_t length = 0;
+        std::size_t records = 0;
+        std::size_t skipped = 0;
+        env.for_each_agent([&](AgentId id, Agent& agent) noexcept {
+            if (length + sizeof(Record) >= IMAGE_BYTES) [[unlikely]] {
+                skipped++;
+                return;
+            }
+            const std::size_t capacity = std::min<std::size_t>(IMAGE_BYTES - length - sizeof(Record), 0xFFFF);
+            const std::size_t size = agent.snapshot(&g_image.bytes[length + sizeof(Record)], capacity);
+            if (size == 0) return;
+            if (size > capacity) [[unlikely]] {  // 계약 위반 - 레코드로 남기지 않음
+                skipped++;
+                return;
+            }
+            const Record record{id, static_cast<uint16_t>(size)};
+            std::memcpy(&g_image.bytes[length], &record, sizeof(record));
+            length += sizeof(Record) + padded(size);  // 둘 다 4의 배수라 IMAGE_BYTES를 넘지 않음
+            records++;
+        });
+        
+        g_image.header.length = static_cast<uint32_t>(length);
+        g_image.header.records = static_cast<uint16_t>(records);
+        g_image.header.skipped = static_cast<uint16_t>(skipped);
+        g_image.header.crc = transport::crc32(g_image.bytes, length, 0);
+        g_image.header.magic = IMAGE_MAGIC;  // 마지막에 기록 - 중간에 끊긴 저장은 무효
+        return skipped == 0;
+    }
+    
+    bool adopt() noexcept {
+        Adopted& state = adopted();
+        state = Adopted{};
+        const ImageHeader header = g_image.header;
+        g_image.header.magic = 0;  // 한 번만 채택
+        if (header.magic != IMAGE_MAGIC || header.length > IMAGE_BYTES ||
+            header.crc != transport::crc32(g_image.bytes, header.length, 0)) {
+            return false;
+        }
+        // 레코드 경계 검증 - CRC가 맞아도 다른 빌드가 남긴 이미지일 수 있음
+        std::size_t offset = 0;
+        std::size_t records = 0;
+        while (offset < header.length) {
+            Record record;
+            if (offset + sizeof(record) > header.length) return false;
+            std::memcpy(&record, &g_image.bytes[offset], sizeof(record));
+            if (offset + sizeof(record) + record.size > header.length) return false;
+            offset += sizeof(record) + padded(record.size);
+            records++;
+        }
+        if (records != header.records) return false;
+        
+        state.length = header.length;
+        state.records = records;
+        state.pending = records;
+        state.valid = true;
+        return true;
+    }
+    
+    bool restore_agent(AgentId id, Agent& agent) noexcept {
+        Adopted& state = adopted();
+        if (state.pending == 0) [[likely]] return false;
+        std::size_t offset = 0;
+        for (std::size_t i = 0; offset < state.length; ++i) {
+            Record record;
+            std::memcpy(&record, &g_image.bytes[offset], sizeof(record));
+            const uint8_t* payload = &g_image.bytes[offset + sizeof(record)];
+            offset += sizeof(record) + padded(record.size);
+            if (record.agent != id || state.used[i]) continue;
+            state.used[i] = 1;
+            state.pending--;
+            if (!agent.restore(payload, record.size)) return false;
+            state.restored++;
+            return true;
+        }
+        return false;
     }
+    
+    bool warm_boot() noexcept { return adopted().valid; }
+    std::size_t restored_count() noexcept { return adopted().restored; }
+    std::size_t pending_count() noexcept { return adopted().pending; }
+    void discard() noexcept { adopted().pending = 0; }
+}
+#endif
+
+// ============================================================================
+// High-resolution Clock - 호스트 steady_clock
+// ============================================================================
+
+#if MINI_SO_HIRES_CLOCK == MINI_SO_HIRES_STEADY
+HiresTime hires_now() noexcept {
+    using namespace std::chrono;
+    return static_cast<HiresTime>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
 }
+#endif
 
 // ============================================================================
 // MessageQueue Implementation - Phase 3: Zero-overhead
 // ============================================================================
 
-MessageQueue::MessageQueue() noexcept {
-    mutex_ = xSemaphoreCreateMutex();
+// BasicMessageQueue는 용량별 템플릿이므로 헤더에서 구현됨 (Template Implementations)
+
+// ============================================================================
+// Agent Implementation - Phase 3: Zero-overhead messaging
+// ============================================================================
+
+void Agent::process_messages(uint32_t max_messages) noexcept {
+    process_messages_with(max_messages,
+        [this](const MessageBase& msg) noexcept { return handle_message(msg); },
+        [this](Span<const MessageBase* const> batch) noexcept { return handle_batch(batch); });
+}
+
+void Agent::count_deadline_miss(const MessageBase& msg, DeadlineMiss miss) noexcept {
+    deadline_misses_.fetch_add(1, std::memory_order_relaxed);
+    trace::record(trace::EventKind::DROP, msg.type_id(), msg.sender_id(), id_, message_queue_.size());
+    if (miss == DeadlineMiss::ESCALATE) {
+        if (System* system = environment().system()) system->report_error(
+            system_messages::ErrorReport::WARNING,
+            1002, // DEADLINE_MISSED
+            id_
+        );
+    }
+}
+
+// ============================================================================
+// TimerWheel Implementation - 계층형 타이밍 휠
+// ============================================================================
+
+namespace detail {
+
+TimerWheel::TimerWheel() noexcept {
+    mutex_ = detail::create_mutex(mutex_storage_);
     if (!mutex_) [[unlikely]] {
-        // 현대적 Fail-Safe: 정보 보존 + 제어된 복구
         emergency::save_failure_context(
             emergency::CriticalFailure::MUTEX_CREATION_FAILED,
             __FILE__, __LINE__, __FUNCTION__);
-        
         emergency::enter_emergency_mode();
-        emergency::schedule_controlled_restart(5000);  // 5초 후 재시작
-        
-        // 최후의 안전 정지 (기존 안전성 유지)
-        taskDISABLE_INTERRUPTS();
-        for(;;);
     }
     
-    // Cache-friendly initialization
-    for (auto& entry : queue_) {
-        entry.valid = false;
-        entry.size = 0;
+    heads_.fill(NIL);
+    // 빈 노드 free list (next로 연결)
+    for (std::size_t i = 0; i < MAX_TIMERS; ++i) {
+        nodes_[i].next = (i + 1 < MAX_TIMERS) ? static_cast<uint16_t>(i + 1) : NIL;
     }
+    free_ = 0;
 }
 
-MessageQueue::~MessageQueue() noexcept {
+TimerWheel::~TimerWheel() noexcept {
     if (mutex_) {
         vSemaphoreDelete(mutex_);
     }
 }
 
-MessageQueue::Result MessageQueue::push(const MessageBase& msg, uint16_t size) noexcept {
-    if (size > MINI_SO_MAX_MESSAGE_SIZE) [[unlikely]] {
-        return Result::MESSAGE_TOO_LARGE;
+TimerId TimerWheel::arm(AgentId sender_id, AgentId target_id, Post post, const void* payload,
+                        std::size_t size, Duration delay, Duration period) noexcept {
+    if (!post || size > PAYLOAD_SIZE) [[unlikely]] {
+        return INVALID_TIMER_ID;
     }
     
+    const TimePoint armed_at = now();
     if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
-        return Result::INVALID_MESSAGE;
+        return INVALID_TIMER_ID;
     }
     
-    if (count_ >= MINI_SO_MAX_QUEUE_SIZE) [[unlikely]] {
+    if (free_ == NIL) [[unlikely]] {
         xSemaphoreGive(mutex_);
-        return Result::QUEUE_FULL;
+        return INVALID_TIMER_ID;  // 노드 고갈 (MINI_SO_MAX_TIMERS 증가 필요)
     }
     
-    // Zero-overhead: 캐시 정렬된 안전한 메모리 복사
-    QueueEntry& entry = queue_[tail_];
-    
-    // 메모리 안전성: 크기 재검증 (Defense in depth)
-    if (size <= MINI_SO_MAX_MESSAGE_SIZE) [[likely]] {
-        std::memcpy(entry.data, &msg, size);
-        entry.size = size;
-        entry.valid = true;
-        
-        tail_ = (tail_ + 1) % MINI_SO_MAX_QUEUE_SIZE;
-        count_++;
-    } else {
-        xSemaphoreGive(mutex_);
-        return Result::MESSAGE_TOO_LARGE;
+    // 활성 타이머가 없으면 휠 시간을 현재로 맞춤 (유휴 구간을 틱 단위로 따라가지 않도록)
+    if (active_ == 0) {
+        current_ = armed_at;
     }
     
+    const uint16_t index = free_;
+    Node& node = nodes_[index];
+    free_ = node.next;
+    
+    std::memcpy(node.payload, payload, size);
+    node.post = post;
+    node.sender_id = sender_id;
+    node.target_id = target_id;
+    node.period = period < MAX_DELAY ? period : MAX_DELAY;
+    node.expiry = armed_at + (delay == 0 ? 1 : (delay < MAX_DELAY ? delay : MAX_DELAY));
+    link(index);
+    active_++;
+    
+    const TimerId id = (static_cast<TimerId>(node.generation) << 16) | index;
     xSemaphoreGive(mutex_);
-    return Result::SUCCESS;
+    return id;
 }
 
-bool MessageQueue::pop(uint8_t* buffer, uint16_t& size) noexcept {
-    // 입력 유효성 검사 (Zero-overhead when inlined)
-    if (!buffer) [[unlikely]] {
+bool TimerWheel::cancel(TimerId id) noexcept {
+    const uint16_t index = static_cast<uint16_t>(id & 0xFFFFu);
+    const uint16_t generation = static_cast<uint16_t>(id >> 16);
+    if (id == INVALID_TIMER_ID || index >= MAX_TIMERS) [[unlikely]] {
         return false;
     }
     
@@ -230,86 +514,182 @@ bool MessageQueue::pop(uint8_t* buffer, uint16_t& size) noexcept {
         return false;
     }
     
-    if (count_ == 0) [[unlikely]] {
-        xSemaphoreGive(mutex_);
-        return false;
+    Node& node = nodes_[index];
+    const bool armed = node.post && node.generation == generation;
+    if (armed) {
+        unlink(index);
+        release(index);
+    }
+    xSemaphoreGive(mutex_);
+    return armed;
+}
+
+void TimerWheel::cancel_target(AgentId target_id) noexcept {
+    if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+        return;
     }
     
-    QueueEntry& entry = queue_[head_];
-    if (!entry.valid) [[unlikely]] {
-        xSemaphoreGive(mutex_);
-        return false;
+    for (std::size_t i = 0; i < MAX_TIMERS; ++i) {
+        if (nodes_[i].post && nodes_[i].target_id == target_id) {
+            unlink(static_cast<uint16_t>(i));
+            release(static_cast<uint16_t>(i));
+        }
+    }
+    xSemaphoreGive(mutex_);
+}
+
+std::size_t TimerWheel::advance(Environment& env, TimePoint current) noexcept {
+    if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+        return 0;
     }
     
-    // 메모리 안전성: 크기 검증 후 복사
-    if (entry.size <= MINI_SO_MAX_MESSAGE_SIZE) [[likely]] {
-        size = entry.size;
-        std::memcpy(buffer, entry.data, entry.size);
-        entry.valid = false;
-        entry.size = 0;  // Zero-overhead 클리어
+    std::size_t fired = 0;
+    while (static_cast<int32_t>(current - current_) > 0) {
+        if (active_ == 0) {
+            current_ = current;
+            break;
+        }
         
-        head_ = (head_ + 1) % MINI_SO_MAX_QUEUE_SIZE;
-        count_--;
-    } else {
-        // 손상된 엔트리 복구
-        entry.valid = false;
-        entry.size = 0;
-        head_ = (head_ + 1) % MINI_SO_MAX_QUEUE_SIZE;
-        count_--;
-        xSemaphoreGive(mutex_);
-        return false;
+        current_++;
+        // 상위 단계부터 내려야 같은 틱에 하위 슬롯으로 떨어진 타이머도 처리됨
+        for (std::size_t level = LEVELS - 1; level > 0; --level) {
+            if ((current_ & ((TimePoint{1} << (SLOT_BITS * level)) - 1)) == 0) {
+                cascade(level);
+            }
+        }
+        fired += expire_current(env);
     }
     
     xSemaphoreGive(mutex_);
-    return true;
+    return fired;
 }
 
-void MessageQueue::clear() noexcept {
-    if (xSemaphoreTake(mutex_, portMAX_DELAY) == pdTRUE) {
-        for (auto& entry : queue_) {
-            entry.valid = false;
-        }
-        head_ = 0;
-        tail_ = 0;
-        count_ = 0;
-        xSemaphoreGive(mutex_);
+bool TimerWheel::next_expiry(TimePoint current, Duration& remaining) noexcept {
+    if (active_ == 0) {
+        return false;
     }
+    if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+        return false;
+    }
+    
+    bool found = false;
+    Duration earliest = MAX_DELAY;
+    for (const Node& node : nodes_) {
+        if (!node.post) continue;
+        const int32_t delta = static_cast<int32_t>(node.expiry - current);
+        const Duration wait = delta > 0 ? static_cast<Duration>(delta) : 0;
+        if (wait < earliest) earliest = wait;
+        found = true;
+    }
+    xSemaphoreGive(mutex_);
+    
+    remaining = earliest;
+    return found;
 }
 
-// ============================================================================
-// Agent Implementation - Phase 3: Zero-overhead messaging
-// ============================================================================
+void TimerWheel::link(uint16_t index) noexcept {
+    Node& node = nodes_[index];
+    if (static_cast<int32_t>(node.expiry - current_) < 0) {
+        node.expiry = current_;
+    }
+    
+    // 남은 틱 수로 단계 선택, 슬롯은 만료 시각의 해당 자릿수 (cascade 시점 ≤ 만료 시각)
+    const Duration delta = node.expiry - current_;
+    std::size_t level = 0;
+    while (level + 1 < LEVELS && delta >= (Duration{1} << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    
+    const std::size_t slot = (node.expiry >> (SLOT_BITS * level)) & (SLOTS - 1);
+    const uint16_t bucket = static_cast<uint16_t>(level * SLOTS + slot);
+    node.bucket = bucket;
+    node.prev = NIL;
+    node.next = heads_[bucket];
+    if (node.next != NIL) {
+        nodes_[node.next].prev = index;
+    }
+    heads_[bucket] = index;
+}
 
-void Agent::process_messages() noexcept {
-    alignas(8) uint8_t buffer[MINI_SO_MAX_MESSAGE_SIZE];
-    uint16_t size;
+void TimerWheel::unlink(uint16_t index) noexcept {
+    Node& node = nodes_[index];
+    if (node.bucket == NIL) {
+        return;
+    }
     
-    uint32_t messages_processed = 0;
-    TimePoint start_time = now();
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.bucket] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    }
+    node.prev = NIL;
+    node.next = NIL;
+    node.bucket = NIL;
+}
+
+void TimerWheel::release(uint16_t index) noexcept {
+    Node& node = nodes_[index];
+    node.post = nullptr;
+    node.generation++;  // 이전 ID로의 cancel 무효화
+    node.next = free_;
+    free_ = index;
+    active_--;
+}
+
+void TimerWheel::cascade(std::size_t level) noexcept {
+    const std::size_t bucket = level * SLOTS + ((current_ >> (SLOT_BITS * level)) & (SLOTS - 1));
+    uint16_t index = heads_[bucket];
+    heads_[bucket] = NIL;
     
-    while (message_queue_.pop(buffer, size)) {
-        MessageBase* msg = reinterpret_cast<MessageBase*>(buffer);
-        if (msg && handle_message(*msg)) {
-            messages_processed++;
-        }
-        
-        // 과도한 처리 방지 (임베디드 시스템 고려)
-        if (messages_processed >= 8) break;
+    while (index != NIL) {
+        const uint16_t next = nodes_[index].next;
+        link(index);
+        index = next;
     }
+}
+
+std::size_t TimerWheel::expire_current(Environment& env) noexcept {
+    const std::size_t bucket = current_ & (SLOTS - 1);
+    uint16_t index = heads_[bucket];
+    heads_[bucket] = NIL;
     
-    if (messages_processed > 0) {
-        TimePoint end_time = now();
-        uint32_t processing_time_us = (end_time - start_time) * 1000;
-        report_performance(processing_time_us, messages_processed);
+    std::size_t fired = 0;
+    while (index != NIL) {
+        Node& node = nodes_[index];
+        const uint16_t next = node.next;
+        node.bucket = NIL;
+        
+        // 대상 메일박스가 가득 차도 주기 타이머는 유지 (다음 주기에 재시도)
+        node.post(env, node.sender_id, node.target_id, node.payload);
+        fired++;
+        
+        if (node.period > 0) {
+            node.expiry += node.period;
+            if (static_cast<int32_t>(node.expiry - current_) <= 0) {
+                node.expiry = current_ + node.period;  // 밀린 주기는 건너뜀
+            }
+            link(index);
+        } else {
+            release(index);
+        }
+        index = next;
     }
+    return fired;
 }
 
+} // namespace detail
+
 // ============================================================================
 // Environment Implementation - Phase 3: High-performance runtime
 // ============================================================================
 
 Environment::Environment() noexcept {
-    mutex_ = xSemaphoreCreateMutex();
+    hires_clock_init();  // 타임스탬프/측정 경로가 쓰기 전에 사이클 카운터 활성화
+    
+    mutex_ = detail::create_mutex(mutex_storage_);
     if (!mutex_) [[unlikely]] {
         // 현대적 Fail-Safe: Environment 실패는 더욱 심각
         emergency::save_failure_context(
@@ -327,6 +707,16 @@ Environment::Environment() noexcept {
     for (auto& agent : agents_) {
         agent = nullptr;
     }
+    // 스택 top이 슬롯 0 - 해제가 없으면 ID는 등록 순서대로 0, 1, 2, ...
+    for (std::size_t i = 0; i < MINI_SO_MAX_AGENTS; ++i) {
+        free_[i] = static_cast<uint16_t>(MINI_SO_MAX_AGENTS - 1 - i);
+    }
+    free_count_ = MINI_SO_MAX_AGENTS;
+    ready_.set_exclusive(true);  // run()은 한 태스크에서만 - 파이프라인 단계 직접 호출 허용
+    
+#if MINI_SO_ENABLE_WARM_RESTART
+    warm::adopt();  // 등록 전에 - 각 Agent는 activate_slot에서 자기 레코드를 받음
+#endif
 }
 
 bool Environment::initialize() noexcept {
@@ -347,101 +737,415 @@ Environment::~Environment() noexcept {
 }
 
 AgentId Environment::register_agent(Agent* agent) noexcept {
-    if (!agent) [[unlikely]] {
+    if (!agent || !attach_pooled_mailbox(*agent)) [[unlikely]] {  // 메일박스 저장소 없음 (MINI_SO_MAILBOX_BYTES=0)
         return INVALID_AGENT_ID;
     }
     
     if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+        detach_pooled_mailbox(*agent);
         return INVALID_AGENT_ID;
     }
     
-    if (agent_count_ >= MINI_SO_MAX_AGENTS) [[unlikely]] {
+    if (free_count_ == 0) [[unlikely]] {
         xSemaphoreGive(mutex_);
+        detach_pooled_mailbox(*agent);
         return INVALID_AGENT_ID;
     }
     
-    AgentId id = static_cast<AgentId>(agent_count_);
-    agents_[agent_count_] = agent;
-    agent_count_++;
+    const std::size_t index = claim_slot(agent);
+    xSemaphoreGive(mutex_);
+    
+    activate_slot(index, *agent);
+    return slot_id(index);
+}
+
+#if MINI_SO_ENABLE_LAZY_AGENTS
+AgentId Environment::register_lazy(LazyAgent& lazy) noexcept {
+    if (Agent* agent = lazy.agent()) {  // 해제 후 재등록 - 생성된 객체를 그대로 사용
+        lazy.id_ = register_agent(agent);
+        return lazy.id_;
+    }
+    if (live_slot(lazy.id_)) [[unlikely]] {  // 이미 예약됨
+        return INVALID_AGENT_ID;
+    }
     
+    if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+        return INVALID_AGENT_ID;
+    }
+    if (free_count_ == 0) [[unlikely]] {
+        xSemaphoreGive(mutex_);
+        return INVALID_AGENT_ID;
+    }
+    const std::size_t index = claim_slot(nullptr);
+    lazy_[index] = &lazy;
+    lazy.id_ = slot_id(index);
     xSemaphoreGive(mutex_);
+    return lazy.id_;
+}
+
+Agent* Environment::activate_lazy(std::size_t index) noexcept {
+    LazyAgent* lazy = lazy_[index];
+    uint8_t state = LazyAgent::IDLE;
+    if (!lazy->state_.compare_exchange_strong(state, LazyAgent::ACTIVATING, std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+        // 다른 태스크가 생성 중 - 틱 단위로 쉬어 낮은 우선순위 생성자도 끝낼 수 있게 함
+        while (state == LazyAgent::ACTIVATING) {
+            vTaskDelay(1);
+            state = lazy->state_.load(std::memory_order_acquire);
+        }
+        return state == LazyAgent::ACTIVE ? lazy->agent_ : nullptr;
+    }
     
-    agent->initialize(id);
-    return id;
+    Agent* agent = lazy->construct();
+    if (agent && !attach_pooled_mailbox(*agent)) [[unlikely]] {  // 메일박스 저장소 없음 (Setup 또는 풀에서)
+        lazy->destroy(*agent);
+        agent = nullptr;
+    }
+    if (!agent) [[unlikely]] {
+        lazy->failures_.fetch_add(1, std::memory_order_relaxed);
+        lazy->state_.store(LazyAgent::IDLE, std::memory_order_release);
+        return nullptr;
+    }
+    
+    // 초기화와 ReadySet 연결을 마친 뒤 공개 - 다른 발신자는 ACTIVE를 볼 때까지 위 대기 경로로 들어옴
+    activate_slot(index, *agent);
+    lazy->agent_ = agent;
+    agents_[index] = agent;  // 스케줄러/순회 경로용 (전달 경로는 lazy_로 읽음)
+    lazy->state_.store(LazyAgent::ACTIVE, std::memory_order_release);
+    return agent;
 }
+#endif
 
 void Environment::unregister_agent(AgentId id) noexcept {
-    if (id >= agent_count_) [[unlikely]] return;
+    if (!live_slot(id)) [[unlikely]] return;  // 이미 해제됐거나 옛 세대의 ID
     
     if (xSemaphoreTake(mutex_, portMAX_DELAY) == pdTRUE) {
-        if (agents_[id]) {
-            agents_[id]->message_queue_.clear();
-            agents_[id] = nullptr;
+        if (live_slot(id)) {
+            release_slot(detail::agent_index(id));
         }
         xSemaphoreGive(mutex_);
     }
 }
 
-Agent* Environment::get_agent(AgentId id) noexcept {
-    if (id >= agent_count_) [[unlikely]] {
+std::size_t Environment::claim_slot(Agent* agent) noexcept {
+    // 빈 슬롯 pop - 이전 사용자의 unregister에서 세대가 이미 올라가 있음
+    const std::size_t index = free_[--free_count_];
+    agents_[index] = agent;
+    live_pos_[index] = static_cast<uint16_t>(live_count_);
+    live_[live_count_++] = static_cast<uint16_t>(index);
+#if MINI_SO_ENABLE_LATENCY_HISTOGRAMS
+    latency_.reset_agent(slot_id(index));
+#endif
+    return index;
+}
+
+void Environment::activate_slot(std::size_t index, Agent& agent) noexcept {
+    agent.initialize(slot_id(index), this);
+#if MINI_SO_ENABLE_WARM_RESTART
+    if (this == &instance()) {  // 스냅샷은 기본 Environment의 ID로 기록됨
+        warm::restore_agent(slot_id(index), agent);  // ReadySet 연결 전 - 첫 메시지보다 먼저
+    }
+#endif
+    agent.message_queue_.bind_ready_set(&ready_, index);
+}
+
+bool Environment::attach_pooled_mailbox(Agent& agent) noexcept {
+    if (agent.mailbox_bytes() > 0) [[likely]] return true;
+    if (!mailbox_pool_) return false;
+    uint8_t* block = mailbox_pool_->acquire();
+    if (!block) [[unlikely]] return false;
+    if (!agent.set_mailbox_storage(block, mailbox_pool_->block_bytes())) [[unlikely]] {
+        mailbox_pool_->release(block);
+        return false;
+    }
+    return true;
+}
+
+void Environment::detach_pooled_mailbox(Agent& agent) noexcept {
+    if (mailbox_pool_ && mailbox_pool_->release(agent.message_queue_.storage())) {
+        agent.message_queue_.detach_storage();
+    }
+}
+
+void Environment::release_slot(std::size_t index) noexcept {
+    Agent* agent = agents_[index];
+    const AgentId id = slot_id(index);
+    if (agent) {  // 활성화 전 지연 Agent 예약은 메일박스가 없음
+        agent->message_queue_.bind_ready_set(nullptr, 0);
+        agent->message_queue_.clear();
+        agent->latest_.reset();
+        for (detail::TypedMailboxBase* box = agent->typed_mailboxes_; box; box = box->next()) {
+            box->discard();
+        }
+        detach_pooled_mailbox(*agent);
+        emergency::clear_critical(*agent);
+    }
+#if MINI_SO_ENABLE_LAZY_AGENTS
+    lazy_[index] = nullptr;
+#endif
+    agents_[index] = nullptr;
+    ready_.clear(index);
+    mbox_.unsubscribe_all(id);
+    rate_limits_.remove_agent(id);
+    timers_.cancel_target(id);
+    
+    // 세대를 올려 옛 ID를 무효화하고 live_에서 swap-remove, 슬롯은 free 스택으로
+    generations_[index] = detail::next_agent_generation(index, generations_[index]);
+    const std::size_t pos = live_pos_[index];
+    const uint16_t last = live_[--live_count_];
+    live_[pos] = last;
+    live_pos_[last] = static_cast<uint16_t>(pos);
+    free_[free_count_++] = static_cast<uint16_t>(index);
+}
+
+bool Environment::register_coop(Cooperation& coop, Cooperation* parent) noexcept {
+    if (coop.registered_ || coop.count_ == 0 || (parent && !parent->registered_)) [[unlikely]] {
+        return false;
+    }
+    // 풀 블록은 전부 얻었을 때만 유지 (실패 시 이미 받은 블록 반납)
+    const auto detach_all = [&](std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count; ++i) detach_pooled_mailbox(*coop.agents_[i]);
+    };
+    for (std::size_t i = 0; i < coop.count_; ++i) {
+        if (!attach_pooled_mailbox(*coop.agents_[i])) [[unlikely]] {
+            detach_all(i);
+            return false;
+        }
+    }
+    
+    if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+        detach_all(coop.count_);
+        return false;
+    }
+    if (free_count_ < coop.count_) [[unlikely]] {
+        xSemaphoreGive(mutex_);
+        detach_all(coop.count_);
+        return false;
+    }
+    std::array<std::size_t, Cooperation::MAX_AGENTS> slots;
+    for (std::size_t i = 0; i < coop.count_; ++i) {
+        slots[i] = claim_slot(coop.agents_[i]);
+        coop.ids_[i] = slot_id(slots[i]);
+    }
+    coop.registered_ = true;
+    coop.parent_ = parent;
+    coop.first_child_ = nullptr;
+    if (parent) {
+        coop.next_sibling_ = parent->first_child_;
+        parent->first_child_ = &coop;
+    }
+    xSemaphoreGive(mutex_);
+    
+    for (std::size_t i = 0; i < coop.count_; ++i) {
+        activate_slot(slots[i], *coop.agents_[i]);
+    }
+    for (std::size_t i = 0; i < coop.count_; ++i) {
+        if (coop.watchdog_ms_[i] > 0) {
+            if (System* sys = system()) sys->watchdog().register_for_monitoring(coop.ids_[i], coop.watchdog_ms_[i]);
+        }
+    }
+    return true;
+}
+
+void Environment::deregister_coop(Cooperation& coop, bool drain) noexcept {
+    if (!coop.registered_) [[unlikely]] return;
+    
+    // 자식 작업이 부모 Agent에 보고할 수 있도록 자식부터
+    while (Cooperation* child = coop.first_child_) {
+        deregister_coop(*child, drain);
+    }
+    
+    for (std::size_t round = 0; drain && round < MINI_SO_COOP_DRAIN_ROUNDS; ++round) {
+        bool pending = false;
+        for (std::size_t i = 0; i < coop.count_; ++i) {
+            Agent* agent = live_agent(coop.ids_[i]);
+            const std::size_t queued = agent ? agent->message_queue_.size() : 0;
+            if (queued > 0) {
+                agent->process_messages(static_cast<uint32_t>(queued));
+                pending = true;
+            }
+        }
+        if (!pending) break;
+    }
+    
+    for (std::size_t i = 0; i < coop.count_; ++i) {
+        if (coop.watchdog_ms_[i] > 0) {
+            if (System* sys = system()) sys->watchdog().unregister_from_monitoring(coop.ids_[i]);
+        }
+    }
+    
+    if (xSemaphoreTake(mutex_, portMAX_DELAY) != pdTRUE) [[unlikely]] {
+        return;
+    }
+    for (std::size_t i = 0; i < coop.count_; ++i) {
+        if (live_agent(coop.ids_[i])) {  // 개별 unregister_agent로 먼저 해제된 멤버는 건너뜀
+            release_slot(detail::agent_index(coop.ids_[i]));
+        }
+        coop.ids_[i] = INVALID_AGENT_ID;
+    }
+    if (Cooperation* parent = coop.parent_) {
+        Cooperation** link = &parent->first_child_;
+        while (*link && *link != &coop) link = &(*link)->next_sibling_;
+        if (*link) *link = coop.next_sibling_;
+    }
+    coop.registered_ = false;
+    coop.parent_ = nullptr;
+    coop.next_sibling_ = nullptr;
+    xSemaphoreGive(mutex_);
+}
+
+Agent* Environment::select_worker(Router& router, uint32_t key) noexcept {
+    const std::size_t count = router.count_;
+    if (count == 0) [[unlikely]] {
+        return nullptr;
+    }
+    
+    if (router.policy_ == RoutePolicy::KEY_HASH) {
+        // 같은 키는 항상 같은 시작 위치 - 해제된 worker만 다음 칸으로 넘김
+        const std::size_t start = (key * 0x9E3779B1u) % count;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (Agent* worker = live_agent(router.workers_[(start + i) % count])) return worker;
+        }
+        return nullptr;
+    }
+    
+    const std::size_t start = router.cursor_.fetch_add(1, std::memory_order_relaxed) % count;
+    if (router.policy_ == RoutePolicy::ROUND_ROBIN) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (Agent* worker = live_agent(router.workers_[(start + i) % count])) return worker;
+        }
         return nullptr;
     }
-    return agents_[id];
+    
+    // LEAST_DEPTH: 메일박스 레코드 수 비교, 같으면 차례로 돌린 시작 위치에 가까운 쪽
+    Agent* best = nullptr;
+    std::size_t best_depth = SIZE_MAX;
+    for (std::size_t i = 0; i < count; ++i) {
+        Agent* worker = live_agent(router.workers_[(start + i) % count]);
+        if (!worker) continue;
+        const std::size_t depth = worker->message_queue_.size();
+        if (depth < best_depth) {
+            best = worker;
+            best_depth = depth;
+            if (depth == 0) break;
+        }
+    }
+    return best;
+}
+
+Agent* Environment::get_agent(AgentId id) noexcept {
+    return live_agent(id);
 }
 
 bool Environment::process_one_message() noexcept {
-    for (std::size_t i = 0; i < agent_count_; ++i) {
-        if (agents_[i] && !agents_[i]->message_queue_.empty()) {
-            agents_[i]->process_messages();
+    if (detail::run_ready_one(ready_, agents_)) {
 #if MINI_SO_ENABLE_METRICS
-            total_messages_processed_++;
+        total_messages_processed_++;
 #endif
-            return true;
-        }
+        return true;
     }
     return false;
 }
 
 void Environment::process_all_messages() noexcept {
-    bool has_messages = true;
-    while (has_messages) {
-        has_messages = false;
-        for (std::size_t i = 0; i < agent_count_; ++i) {
-            if (agents_[i] && !agents_[i]->message_queue_.empty()) {
-                agents_[i]->process_messages();
-                has_messages = true;
-            }
-        }
+    // 라운드마다 가장 높은 ready 클래스부터 다시 확인 (상위 클래스 우선 소진)
+    while (detail::run_ready_round(ready_, agents_)) {
     }
 }
 
 void Environment::run() noexcept {
 #if MINI_SO_ENABLE_METRICS
-    TimePoint loop_start = now();
+    const HiresTime loop_start = hires_now();
 #endif
     
-    // 메시지 처리
-    process_all_messages();
+    // 인터럽트에서 보낸 메시지, 만료된 지연/주기 메시지를 메일박스로 전달
+    process_isr_messages();
+    process_timers();
     
-    // Watchdog 체크 (System을 통해)
-    System::instance().watchdog().check_timeouts();
+    // 메시지 처리 (Watchdog 기한도 타이머 메시지로 도착)
+    process_all_messages();
     
 #if MINI_SO_ENABLE_METRICS
-    TimePoint loop_end = now();
-    uint32_t processing_time_us = (loop_end - loop_start) * 1000;
+    const uint32_t processing_time_us = hires_since_us(loop_start);
     if (processing_time_us > max_processing_time_us_) {
         max_processing_time_us_ = processing_time_us;
     }
+    
+    // Agent 로컬 카운터를 주기적으로 끌어옴 (wrap 전에 누적)
+    if (++runs_since_collect_ >= MINI_SO_METRICS_COLLECT_RUNS) {
+        runs_since_collect_ = 0;
+        if (System* sys = system()) sys->performance().collect();
+    }
 #endif
 }
 
+bool Environment::run_until_idle(TickType_t timeout) noexcept {
+    run();
+    
+    // 대기 등록 후 기한 계산/재확인 - 그 사이의 push·arm·request_stop도 깨움을 유실하지 않음
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    std::atomic<TaskHandle_t>* slot = ready_.add_waiter(self);
+    
+    const TickType_t wait_ticks = idle_ticks(timeout);
+    bool woken = true;
+    if (!ready_.any() && !isr_.pending() && !stop_requested_.load(std::memory_order_acquire) && wait_ticks > 0) {
+        // 기한으로 줄어든 대기는 기한 도달 자체가 할 일이므로 깨어남으로 취급
+        Observer::on_idle(slot ? wait_ticks : 1);
+        woken = ulTaskNotifyTake(pdTRUE, slot ? wait_ticks : 1) > 0 || wait_ticks < timeout;
+    }
+    ready_.remove_waiter(slot, self);
+    
+    if (woken && !stop_requested_.load(std::memory_order_acquire)) {
+        run();
+    }
+    return woken;
+}
+
+void Environment::run_forever() noexcept {
+    stop_requested_.store(false, std::memory_order_release);
+    while (!stop_requested_.load(std::memory_order_acquire)) {
+        run_until_idle(portMAX_DELAY);
+    }
+}
+
+void Environment::request_stop() noexcept {
+    stop_requested_.store(true);
+    ready_.wake_all();
+}
+
+TickType_t Environment::idle_ticks(TickType_t limit) noexcept {
+    const TimePoint current = now();
+    TickType_t ticks = limit;
+    
+    Duration remaining;
+    if (timers_.next_expiry(current, remaining) && remaining < ticks) {
+        ticks = remaining;
+    }
+    return ticks;
+}
+
+void Environment::fill_mailbox_status(system_messages::StatusResponse& response) const noexcept {
+    response.fullest_percent = 0;
+    response.fullest_agent = INVALID_AGENT_ID;
+    response.push_failures = 0;
+    response.saturated_us = 0;
+    for_each_agent([&](AgentId id, const Agent& agent) noexcept {
+        const MailboxStats stats = agent.mailbox_stats();
+        const uint32_t percent = stats.high_water_percent();
+        if (response.fullest_agent == INVALID_AGENT_ID || percent > response.fullest_percent) {
+            response.fullest_percent = static_cast<uint8_t>(percent);
+            response.fullest_agent = id;
+        }
+        response.push_failures += stats.push_failures();
+        response.saturated_us += stats.saturated_us;
+    });
+}
+
 std::size_t Environment::total_pending_messages() const noexcept {
     std::size_t total = 0;
-    for (std::size_t i = 0; i < agent_count_; ++i) {
-        if (agents_[i]) {
-            total += agents_[i]->message_queue_.size();
-        }
-    }
+    for_each_agent([&](AgentId, const Agent& agent) noexcept {
+        total += agent.message_queue_.size();
+    });
     return total;
 }
 
@@ -452,29 +1156,35 @@ std::size_t Environment::total_pending_messages() const noexcept {
 bool ErrorAgent::handle_message(const MessageBase& msg) noexcept {
     if (msg.type_id() == MESSAGE_TYPE_ID(system_messages::ErrorReport)) {
         const auto& error_msg = static_cast<const Message<system_messages::ErrorReport>&>(msg);
-        
-        // 순환 버퍼로 항상 최신 32개 에러 유지
-        ErrorEntry& entry = error_log_[next_index_];
-        entry.level = error_msg.data.level;
-        entry.error_code = error_msg.data.error_code;
-        entry.source_agent = error_msg.data.source_agent;
-        entry.timestamp = now();
-        
-        // 인덱스 업데이트 (순환)
-        next_index_ = (next_index_ + 1) % error_log_.size();
-        error_count_++;
-        
-        // 최고 레벨 업데이트
-        if (error_msg.data.level > max_level_) {
-            max_level_ = error_msg.data.level;
-        }
-        
+        log_error(error_msg.data.level, error_msg.data.error_code, error_msg.data.source_agent);
         return true;
     }
     
     return false;
 }
 
+void ErrorAgent::log_error(system_messages::ErrorReport::Level level, uint32_t code, AgentId source) noexcept {
+    // 순환 버퍼로 항상 최신 32개 에러 유지
+    ErrorEntry& entry = error_log_[next_index_];
+    entry.level = level;
+    entry.error_code = code;
+    entry.source_agent = source;
+    entry.timestamp = now();
+    
+    // 인덱스 업데이트 (순환)
+    next_index_ = (next_index_ + 1) % error_log_.size();
+    error_count_++;
+    
+    // 최고 레벨 업데이트
+    if (level > max_level_) {
+        max_level_ = level;
+    }
+    
+    if (sink_) {
+        sink_(sink_context_, entry);
+    }
+}
+
 void ErrorAgent::report_error(system_messages::ErrorReport::Level level, uint32_t code, AgentId source) noexcept {
     system_messages::ErrorReport error;
     error.level = level;
@@ -485,20 +1195,8 @@ void ErrorAgent::report_error(system_messages::ErrorReport::Level level, uint32_
     if (id() != INVALID_AGENT_ID) {
         send_message(id(), error);
     } else {
-        // 직접 저장 (초기화 중인 경우) - 순환 버퍼 적용
-        ErrorEntry& entry = error_log_[next_index_];
-        entry.level = level;
-        entry.error_code = code;
-        entry.source_agent = source;
-        entry.timestamp = now();
-        
-        // 인덱스 업데이트 (순환)
-        next_index_ = (next_index_ + 1) % error_log_.size();
-        error_count_++;
-        
-        if (level > max_level_) {
-            max_level_ = level;
-        }
+        // 직접 저장 (초기화 중인 경우)
+        log_error(level, code, source);
     }
 }
 
@@ -534,6 +1232,33 @@ void PerformanceAgent::record_performance(uint32_t processing_time_us, uint32_t
     }
 }
 
+void PerformanceAgent::collect() noexcept {
+#if MINI_SO_ENABLE_METRICS
+    Environment& env = environment();
+    env.for_each_agent([&](AgentId id, const Agent& agent) noexcept {
+        const std::size_t index = detail::agent_index(id);
+        if (index >= seen_.size()) return;
+        
+        // 슬롯이 재사용되면 owner가 달라져 기준값을 새로 잡음
+        Seen& seen = seen_[index];
+        if (seen.owner != &agent) {
+            seen.owner = &agent;
+            seen.counters = AgentCounters{0, 0, 0, 0};
+        }
+        
+        // 32비트 차이는 wrap과 무관하게 정확 (수집 간격 내 2^32 미만 가정)
+        const AgentCounters current = agent.counters();
+        total_messages_ += current.messages - seen.counters.messages;
+        busy_time_us_ += current.busy_time_us - seen.counters.busy_time_us;
+        cycle_count_ += current.visits - seen.counters.visits;
+        if (current.max_visit_us > max_processing_time_us_) {
+            max_processing_time_us_ = current.max_visit_us;
+        }
+        seen.counters = current;
+    });
+#endif
+}
+
 // ============================================================================
 // WatchdogAgent Implementation - Phase 3: Efficient monitoring
 // ============================================================================
@@ -542,52 +1267,109 @@ bool WatchdogAgent::handle_message(const MessageBase& msg) noexcept {
     if (msg.type_id() == MESSAGE_TYPE_ID(system_messages::Heartbeat)) {
         const auto& heartbeat_msg = static_cast<const Message<system_messages::Heartbeat>&>(msg);
         
-        // 해당 Agent의 heartbeat 업데이트
-        for (std::size_t i = 0; i < monitored_count_; ++i) {
-            if (monitored_[i].agent_id == heartbeat_msg.data.source_agent && monitored_[i].active) {
-                monitored_[i].last_heartbeat = now();
-                break;
-            }
+        // 해당 Agent의 heartbeat 시각만 갱신 - 기한은 만료 시 다시 계산
+        const AgentId source = heartbeat_msg.data.source_agent;
+        const std::size_t index = detail::agent_index(source);
+        if (index < monitored_.size() && monitored_[index].agent_id == source && monitored_[index].active) {
+            monitored_[index].last_heartbeat = now();
         }
         
         return true;
     }
     
+    if (msg.type_id() == MESSAGE_TYPE_ID(detail::WatchdogDeadline)) {
+        return on_deadline(static_cast<const Message<detail::WatchdogDeadline>&>(msg).data);
+    }
+    
     return false;
 }
 
 void WatchdogAgent::register_for_monitoring(AgentId agent_id, Duration timeout_ms) noexcept {
-    if (monitored_count_ < monitored_.size()) {
-        MonitoredAgent& agent = monitored_[monitored_count_];
-        agent.agent_id = agent_id;
-        agent.last_heartbeat = now();
-        agent.timeout_ms = timeout_ms > 0 ? timeout_ms : default_timeout_ms_;
-        agent.active = true;
+    const std::size_t index = detail::agent_index(agent_id);
+    if (agent_id == INVALID_AGENT_ID || index >= monitored_.size()) [[unlikely]] {
+        return;
+    }
+    
+    MonitoredAgent& agent = monitored_[index];
+    if (agent.agent_id == INVALID_AGENT_ID) {
         monitored_count_++;
     }
+    if (agent.timer != INVALID_TIMER_ID) {
+        cancel_timer(agent.timer);  // 재등록 - 이미 발사된 옛 기한은 epoch로 무시
+    }
+    agent.agent_id = agent_id;
+    agent.last_heartbeat = now();
+    agent.timeout_ms = timeout_ms > 0 ? timeout_ms : default_timeout_ms_;
+    agent.epoch++;
+    agent.active = true;
+    arm_deadline(index, agent.timeout_ms + 1);  // elapsed > timeout이 되는 첫 시점
 }
 
-void WatchdogAgent::check_timeouts() noexcept {
-    TimePoint current_time = now();
-    if (current_time - last_check_time_ < 100) { // 100ms 최소 간격
+bool WatchdogAgent::arm_deadline(std::size_t index, Duration delay) noexcept {
+    MonitoredAgent& agent = monitored_[index];
+    agent.timer = send_delayed(id(), detail::WatchdogDeadline{static_cast<uint16_t>(index), agent.epoch}, delay);
+    return agent.timer != INVALID_TIMER_ID;
+}
+
+bool WatchdogAgent::on_deadline(const detail::WatchdogDeadline& deadline) noexcept {
+    if (deadline.index >= monitored_.size()) [[unlikely]] {
+        return false;
+    }
+    MonitoredAgent& agent = monitored_[deadline.index];
+    if (!agent.active || agent.epoch != deadline.epoch) {
+        return true;  // 재등록/타임아웃 뒤의 옛 기한
+    }
+    agent.timer = INVALID_TIMER_ID;
+    
+    // 기한 사이에 heartbeat가 있었으면 마지막 heartbeat 기준으로 다시 걸기
+    const Duration elapsed = now() - agent.last_heartbeat;
+    if (elapsed <= agent.timeout_ms) {
+        arm_deadline(deadline.index, agent.timeout_ms - elapsed + 1);
+    } else {
+        report_timeout(agent);
+    }
+    return true;
+}
+
+void WatchdogAgent::report_timeout(MonitoredAgent& agent) noexcept {
+    // 타임아웃 발생 - 순수 메시지 기반 오류 보고
+    if (System* system = environment().system()) system->report_error(
+        system_messages::ErrorReport::CRITICAL, 
+        1001, // AGENT_TIMEOUT
+        agent.agent_id
+    );
+    
+    agent.active = false;
+    if (agent.timer != INVALID_TIMER_ID) {
+        cancel_timer(agent.timer);
+        agent.timer = INVALID_TIMER_ID;
+    }
+}
+
+void WatchdogAgent::unregister_from_monitoring(AgentId agent_id) noexcept {
+    const std::size_t index = detail::agent_index(agent_id);
+    if (agent_id == INVALID_AGENT_ID || index >= monitored_.size()) [[unlikely]] {
         return;
     }
-    last_check_time_ = current_time;
-    
-    for (std::size_t i = 0; i < monitored_count_; ++i) {
-        MonitoredAgent& agent = monitored_[i];
-        if (agent.active) {
-            Duration elapsed = current_time - agent.last_heartbeat;
-            if (elapsed > agent.timeout_ms) {
-                // 타임아웃 발생 - 순수 메시지 기반 오류 보고
-                System::instance().report_error(
-                    system_messages::ErrorReport::CRITICAL, 
-                    1001, // AGENT_TIMEOUT
-                    agent.agent_id
-                );
-                
-                agent.active = false;
-            }
+    
+    MonitoredAgent& agent = monitored_[index];
+    if (agent.agent_id != agent_id) {
+        return;  // 감시 중이 아니거나 같은 슬롯의 다른 세대
+    }
+    if (agent.timer != INVALID_TIMER_ID) {
+        cancel_timer(agent.timer);
+    }
+    const uint16_t epoch = static_cast<uint16_t>(agent.epoch + 1);  // 이미 발사된 기한 무시
+    agent = MonitoredAgent{};
+    agent.epoch = epoch;
+    monitored_count_--;
+}
+
+void WatchdogAgent::check_timeouts() noexcept {
+    const TimePoint current_time = now();
+    for (MonitoredAgent& agent : monitored_) {
+        if (agent.active && current_time - agent.last_heartbeat > agent.timeout_ms) {
+            report_timeout(agent);
         }
     }
 }
@@ -600,37 +1382,27 @@ void WatchdogAgent::check_timeouts() noexcept {
 // ensure_initialized()를 호출하여 InitializationGuard 활용
 
 bool System::initialize() noexcept {
-    static bool initialized = false;
-    if (initialized) {
+    if (initialized_) {
         return true;
     }
     
     // Environment 먼저 초기화 보장 (SIOF-Safe)
-    Environment& env = Environment::instance();
-    if (!env.initialize()) {
+    if (!env_.initialize()) {
         return false;
     }
     
-    // 직접 초기화 구현
-    if (instance().initialized_) {
-        initialized = true;
-        return true;
-    }
+    // System Agent 등록 (이 System의 Environment에)
+    error_agent_id_ = env_.register_agent(&error_agent_);
+    performance_agent_id_ = env_.register_agent(&performance_agent_);
+    watchdog_agent_id_ = env_.register_agent(&watchdog_agent_);
     
-    // System Agent 등록
-    System& sys = instance();
-    sys.error_agent_id_ = env.register_agent(&sys.error_agent_);
-    sys.performance_agent_id_ = env.register_agent(&sys.performance_agent_);
-    sys.watchdog_agent_id_ = env.register_agent(&sys.watchdog_agent_);
-    
-    if (sys.error_agent_id_ == INVALID_AGENT_ID || 
-        sys.performance_agent_id_ == INVALID_AGENT_ID ||
-        sys.watchdog_agent_id_ == INVALID_AGENT_ID) [[unlikely]] {
+    if (error_agent_id_ == INVALID_AGENT_ID || 
+        performance_agent_id_ == INVALID_AGENT_ID ||
+        watchdog_agent_id_ == INVALID_AGENT_ID) [[unlikely]] {
         return false;
     }
     
-    sys.initialized_ = true;
-    initialized = true;
+    initialized_ = true;
     return true;
 }
 
@@ -639,7 +1411,7 @@ void System::shutdown() noexcept {
         return;
     }
     
-    Environment& env = Environment::instance();
+    Environment& env = env_;
     
     if (error_agent_id_ != INVALID_AGENT_ID) {
         env.unregister_agent(error_agent_id_);
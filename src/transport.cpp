@@ -0,0 +1,45 @@
+/**
+ * @file transport.cpp
+ * @brief Mini SObjectizer Transport Implementation
+ *
+ * Implementation components:
+ * - transport::crc32: frame check sequence (IEEE 802.3, nibble table)
+ *
+ * Framing, batching and injection (Transport, RemoteAgent) are templates
+ * over the message schema and are implemented in transport.h.
+ */
+
+#include "mini_sobjectizer/transport/transport.h"
+
+namespace mini_so {
+
+namespace transport {
+
+// ============================================================================
+// CRC-32 Implementation
+// ============================================================================
+
+namespace {
+    // 4비트 단위 테이블 - 256엔트리(1KB) 대신 64바이트, 바이트당 조회 2회
+    constexpr uint32_t CRC_NIBBLE_TABLE[16] = {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+        0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+        0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+        0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu,
+    };
+}
+
+uint32_t crc32(const void* data, std::size_t size, uint32_t crc) noexcept {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ CRC_NIBBLE_TABLE[crc & 0x0F];
+        crc = (crc >> 4) ^ CRC_NIBBLE_TABLE[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+} // namespace transport
+
+} // namespace mini_so
@@ -0,0 +1,137 @@
+/**
+ * @file test_coro_agent.cpp
+ * @brief C++20 코루틴 Agent (coro/coro_agent.h) - request/sleep_for 재개와 timeout
+ *
+ * - spawn()은 첫 co_await까지 실행하고, 응답 메시지가 도착하면 같은 코루틴이 응답 값으로 재개됨
+ * - sleep_for는 자신에게 보낸 wake 메시지로 재개, 그동안 다른 메시지 처리는 막히지 않음
+ * - 응답이 없으면 timeout 뒤 nullopt로 재개, 완료된 frame은 arena에 반환
+ */
+#include "mini_sobjectizer/coro/coro_agent.h"
+#include "test_support.h"
+
+using namespace mini_so;
+
+namespace {
+    struct HealthTick { uint32_t round; };
+    struct StatusRequest { uint32_t query; };
+    struct StatusResponse { uint32_t value; };
+    struct Other { uint32_t value; };
+    
+    // StatusRequest에 query + 100으로 응답
+    struct Motor : Agent {
+        bool handle_message(const MessageBase& msg) noexcept override {
+            if (msg.type_id() != MESSAGE_TYPE_ID(StatusRequest)) return false;
+            const uint32_t query = static_cast<const Message<StatusRequest>&>(msg).data.query;
+            return send_message(msg.sender_id(), StatusResponse{query + 100});
+        }
+    };
+    
+    // 요청을 받기만 하고 응답하지 않음
+    struct Silent : Agent {
+        bool handle_message(const MessageBase&) noexcept override { return true; }
+    };
+    
+    class Supervisor : public CoroAgent<Supervisor> {
+    public:
+        AgentId target = INVALID_AGENT_ID;
+        uint32_t stage = 0;          // 코루틴 진행 단계
+        bool answered = false;
+        uint32_t response = 0;
+        bool slept = false;
+        uint32_t others = 0;
+        
+        bool on_message(const MessageBase& msg) noexcept {
+            if (msg.type_id() == MESSAGE_TYPE_ID(HealthTick)) {
+                return spawn(check(static_cast<const Message<HealthTick>&>(msg).data.round));
+            }
+            if (msg.type_id() == MESSAGE_TYPE_ID(Other)) {
+                ++others;
+                return true;
+            }
+            return false;
+        }
+        
+    private:
+        CoTask check(uint32_t round) noexcept {
+            stage = 1;
+            std::optional<StatusResponse> status = co_await request<StatusResponse>(target, StatusRequest{round}, 50);
+            stage = 2;
+            answered = status.has_value();
+            if (!status) co_return;
+            response = status->value;
+            slept = co_await sleep_for(20);
+            stage = 3;
+        }
+    };
+    
+    // 대기 코루틴이 재개될 때까지 타이머를 돌림 (UNIT_TEST 시계는 now() 호출마다 10틱)
+    bool run_until_resumed(Environment& env, const Supervisor& supervisor) {
+        for (int i = 0; i < 100 && supervisor.waiting() > 0; ++i) {
+            env.run();
+        }
+        return supervisor.waiting() == 0;
+    }
+    
+    void check_request_and_sleep() {
+        Environment& env = Environment::instance();
+        static Motor motor;
+        static Supervisor supervisor;
+        env.register_agent(&motor);
+        env.register_agent(&supervisor);
+        supervisor.target = motor.id();
+        
+        MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, supervisor.id(), HealthTick{7}));
+        env.process_all_messages();
+        // 응답으로 재개된 뒤 sleep_for에서 다시 중단
+        MINI_SO_CHECK(supervisor.stage == 2 && supervisor.answered && supervisor.response == 107);
+        MINI_SO_CHECK(supervisor.waiting() == 1);
+        MINI_SO_CHECK(coro_arena().in_use() == 1);
+        
+        // 자는 동안에도 다른 메시지는 처리됨
+        MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, supervisor.id(), Other{1}));
+        env.process_all_messages();
+        MINI_SO_CHECK(supervisor.others == 1 && supervisor.stage == 2);
+        
+        MINI_SO_CHECK(run_until_resumed(env, supervisor));
+        MINI_SO_CHECK(supervisor.stage == 3 && supervisor.slept);
+        MINI_SO_CHECK(coro_arena().in_use() == 0);
+        
+        env.unregister_agent(supervisor.id());
+        env.unregister_agent(motor.id());
+    }
+    
+    void check_request_timeout() {
+        Environment& env = Environment::instance();
+        static Silent silent;
+        static Supervisor supervisor;
+        env.register_agent(&silent);
+        env.register_agent(&supervisor);
+        supervisor.target = silent.id();
+        
+        MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, supervisor.id(), HealthTick{1}));
+        env.process_all_messages();
+        MINI_SO_CHECK(supervisor.stage == 1 && supervisor.waiting() == 1);
+        
+        MINI_SO_CHECK(run_until_resumed(env, supervisor));
+        MINI_SO_CHECK(supervisor.stage == 2 && !supervisor.answered);
+        MINI_SO_CHECK(coro_arena().in_use() == 0);
+        
+        // 없는 대상에게 보낸 요청은 중단 없이 nullopt
+        supervisor.stage = 0;
+        supervisor.target = INVALID_AGENT_ID;
+        MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, supervisor.id(), HealthTick{2}));
+        env.process_all_messages();
+        MINI_SO_CHECK(supervisor.stage == 2 && !supervisor.answered && supervisor.waiting() == 0);
+        
+        env.unregister_agent(supervisor.id());
+        env.unregister_agent(silent.id());
+    }
+}
+
+int main() {
+    System::instance().initialize();
+    check_request_and_sleep();
+    check_request_timeout();
+    MINI_SO_CHECK(coro_arena().failed() == 0);
+    return MINI_SO_TEST_RESULT("coroutine agent");
+}
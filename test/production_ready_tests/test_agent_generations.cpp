@@ -0,0 +1,94 @@
+/**
+ * @file test_agent_generations.cpp
+ * @brief 세대 태그 AgentId - 해제 후 슬롯 재사용 시 옛 ID 거부
+ *
+ * - 해제된 슬롯은 다음 등록이 재사용하고 ID의 세대 비트가 바뀜 (인덱스는 같음)
+ * - 옛 ID로의 전송/조회/구독/해제는 재사용된 슬롯의 새 Agent에 닿지 않음
+ * - 해제 시 구독과 타이머가 함께 정리됨
+ * - 세대가 한 바퀴 돌아도 INVALID_AGENT_ID는 발급되지 않음
+ */
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#include "test_support.h"
+
+using namespace mini_so;
+
+namespace {
+    struct Ping { uint32_t value; };
+    
+    struct Counter : Agent {
+        uint32_t received = 0;
+        bool handle_message(const MessageBase& msg) noexcept override {
+            if (msg.type_id() != MESSAGE_TYPE_ID(Ping)) return false;
+            ++received;
+            return true;
+        }
+    };
+}
+
+int main() {
+    Environment& env = Environment::instance();
+    System::instance().initialize();
+    
+    static Counter first, second, third;
+    const AgentId first_id = env.register_agent(&first);
+    MINI_SO_CHECK(first_id != INVALID_AGENT_ID && first.id() == first_id);
+    MINI_SO_CHECK(first.subscribe<Ping>());
+    MINI_SO_CHECK(first.send_periodic(first_id, Ping{0}, 50) != INVALID_TIMER_ID);
+    const std::size_t timers_before = env.active_timers();
+    
+    env.unregister_agent(first_id);
+    MINI_SO_CHECK(env.get_agent(first_id) == nullptr);
+    MINI_SO_CHECK(env.active_timers() == timers_before - 1);  // 대상 타이머 취소
+    
+    // 같은 슬롯을 새 세대로 재사용
+    const AgentId second_id = env.register_agent(&second);
+    MINI_SO_CHECK(second_id != first_id);
+    MINI_SO_CHECK(detail::agent_index(second_id) == detail::agent_index(first_id));
+    MINI_SO_CHECK(env.get_agent(second_id) == &second);
+    MINI_SO_CHECK(env.get_agent(first_id) == nullptr);
+    
+    // 옛 ID로 보낸 메시지는 새 Agent에 전달되지 않음
+    MINI_SO_CHECK(!env.send_message(INVALID_AGENT_ID, first_id, Ping{1}));
+    MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, first_id, Ping{2}) == SendResult::NO_SUCH_AGENT);
+    MINI_SO_CHECK(env.send_delayed(INVALID_AGENT_ID, first_id, Ping{3}, 10) == INVALID_TIMER_ID);
+    MINI_SO_CHECK(!env.subscribe<Ping>(first_id));
+    
+    // 이전 Agent의 구독은 슬롯과 함께 정리됨 - 발행이 새 Agent에 닿지 않음
+    MINI_SO_CHECK(env.publish(INVALID_AGENT_ID, Ping{4}) == 0);
+    MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, second_id, Ping{5}));
+    env.process_all_messages();
+    MINI_SO_CHECK(second.received == 1);
+    MINI_SO_CHECK(first.received == 0);
+    
+    // 옛 ID의 해제 요청은 무시됨
+    env.unregister_agent(first_id);
+    MINI_SO_CHECK(env.get_agent(second_id) == &second);
+    
+    // 다른 슬롯은 영향 없음
+    const AgentId third_id = env.register_agent(&third);
+    MINI_SO_CHECK(third_id != INVALID_AGENT_ID);
+    MINI_SO_CHECK(detail::agent_index(third_id) != detail::agent_index(second_id));
+    
+    // 세대를 한 바퀴 이상 돌려도 유효한 ID만 발급되고, 직전 ID와 겹치지 않음
+    const std::size_t slot = detail::agent_index(second_id);
+    AgentId previous = second_id;
+    bool ids_valid = true;
+    bool slot_reused = true;
+    for (uint32_t cycle = 0; cycle < detail::AGENT_GENERATIONS + 2; ++cycle) {
+        env.unregister_agent(previous);
+        const AgentId next = env.register_agent(&second);
+        ids_valid = ids_valid && next != INVALID_AGENT_ID && next != previous;
+        slot_reused = slot_reused && detail::agent_index(next) == slot;
+        previous = next;
+    }
+    MINI_SO_CHECK(ids_valid);
+    MINI_SO_CHECK(slot_reused);
+    MINI_SO_CHECK(env.get_agent(previous) == &second);
+    MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, previous, Ping{6}));
+    env.process_all_messages();
+    MINI_SO_CHECK(second.received == 2);
+    
+    env.unregister_agent(previous);
+    env.unregister_agent(third_id);
+    return MINI_SO_TEST_RESULT("agent generations");
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_batch_kernels.cpp
+ * @brief 메시지 배치 센서 커널 (dsp/batch_kernels.h) - SIMD 백엔드 결과를 스칼라 기준과 비교
+ *
+ * - sum/mean/min_max/outside_mask/count_outside: 4-lane 본체와 나머지 꼬리가 모두 걸리는 길이들
+ *   (정수 값이라 부분합 순서와 무관하게 합이 정확)
+ * - BatchView: handle_batch 배치의 float 필드를 열로 모음, 열 선택
+ * - MovingAverage: 창이 차기 전/후 평균
+ * - set_batch_receive Agent가 받은 배치에 커널 적용
+ */
+#include "mini_sobjectizer/dsp/batch_kernels.h"
+#include "test_support.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace mini_so;
+
+namespace {
+    struct Reading {
+        float temperature;
+        uint32_t sequence;
+        float pressure;
+    };
+    
+    // -7..+12 반복 정수 값
+    float sample(std::size_t i) { return static_cast<float>(static_cast<int>((i * 7) % 20) - 7); }
+    
+    void check_kernels() {
+        float data[130];
+        for (std::size_t i = 0; i < 130; ++i) data[i] = sample(i);
+        
+        for (std::size_t n = 0; n <= 130; ++n) {
+            const Span<const float> x(data, n);
+            float total = 0.0f;
+            float low = n > 0 ? data[0] : 0.0f;
+            float high = low;
+            std::size_t outside = 0;
+            uint64_t mask = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                total += data[i];
+                low = data[i] < low ? data[i] : low;
+                high = data[i] > high ? data[i] : high;
+                const bool out = data[i] < -2.0f || data[i] > 8.0f;
+                outside += out ? 1 : 0;
+                if (i < 64 && out) mask |= uint64_t{1} << i;
+            }
+            MINI_SO_CHECK(dsp::sum(x) == total);
+            MINI_SO_CHECK(dsp::mean(x) == (n > 0 ? total / static_cast<float>(n) : 0.0f));
+            const dsp::MinMax range = dsp::min_max(x);
+            MINI_SO_CHECK(range.min == low && range.max == high);
+            MINI_SO_CHECK(dsp::outside_mask(x, -2.0f, 8.0f) == mask);
+            MINI_SO_CHECK(dsp::count_outside(x, -2.0f, 8.0f) == outside);
+        }
+        
+        // 경계 값은 범위 안
+        const float edges[5] = {-2.0f, 8.0f, -2.5f, 8.5f, 3.0f};
+        MINI_SO_CHECK(dsp::outside_mask(Span<const float>(edges, 5), -2.0f, 8.0f) == 0b01100);
+    }
+    
+    void check_batch_view() {
+        std::vector<Message<Reading>> messages;
+        messages.reserve(MINI_SO_MAX_BATCH + 2);
+        const MessageBase* batch[MINI_SO_MAX_BATCH + 2];
+        for (std::size_t i = 0; i < MINI_SO_MAX_BATCH + 2; ++i) {
+            messages.emplace_back(Reading{sample(i), static_cast<uint32_t>(i), 1000.0f + static_cast<float>(i)},
+                                  INVALID_AGENT_ID);
+            batch[i] = &messages[i];
+        }
+        
+        const dsp::BatchView<Reading, &Reading::temperature, &Reading::pressure> view(Span<const MessageBase* const>(batch, 5));
+        MINI_SO_CHECK(view.size() == 5);
+        const Span<const float> temperature = view.column<&Reading::temperature>();
+        const Span<const float> pressure = view.column<&Reading::pressure>();
+        MINI_SO_CHECK(temperature.size() == 5 && pressure.size() == 5);
+        for (std::size_t i = 0; i < 5; ++i) {
+            MINI_SO_CHECK(temperature[i] == sample(i) && pressure[i] == 1000.0f + static_cast<float>(i));
+        }
+        MINI_SO_CHECK(dsp::sum(pressure) == 5010.0f);
+        
+        // 행 수는 MINI_SO_MAX_BATCH까지
+        const dsp::BatchView<Reading, &Reading::pressure> full(
+            Span<const MessageBase* const>(batch, MINI_SO_MAX_BATCH + 2));
+        MINI_SO_CHECK(full.size() == MINI_SO_MAX_BATCH);
+    }
+    
+    void check_moving_average() {
+        dsp::MovingAverage<4> average;
+        MINI_SO_CHECK(average.value() == 0.0f && average.count() == 0);
+        const float first[2] = {2.0f, 4.0f};
+        average.add(Span<const float>(first, 2));
+        MINI_SO_CHECK(average.count() == 2 && average.value() == 3.0f);
+        const float more[4] = {6.0f, 8.0f, 10.0f, 12.0f};
+        average.add(Span<const float>(more, 4));  // 창 가득: 6, 8, 10, 12
+        MINI_SO_CHECK(average.count() == 4 && average.value() == 9.0f);
+        average.reset();
+        MINI_SO_CHECK(average.count() == 0);
+    }
+    
+    // 배치 수신 Agent: 같은 타입 연속 메시지를 뷰로 모아 커널 적용
+    struct Monitor : Agent {
+        float temperature_sum = 0.0f;
+        std::size_t alarms = 0;
+        std::size_t batches = 0;
+        std::size_t rows = 0;
+        
+        Monitor() noexcept { set_batch_receive(true); }
+        
+        bool handle_message(const MessageBase&) noexcept override { return false; }
+        
+        std::size_t handle_batch(Span<const MessageBase* const> batch) noexcept override {
+            if (batch[0]->type_id() != MESSAGE_TYPE_ID(Reading)) return Agent::handle_batch(batch);
+            const dsp::BatchView<Reading, &Reading::temperature, &Reading::pressure> view(batch);
+            temperature_sum += dsp::sum(view.column<&Reading::temperature>());
+            alarms += dsp::count_outside(view.column<&Reading::pressure>(), 950.0f, 1050.0f);
+            ++batches;
+            rows += view.size();
+            return view.size();
+        }
+    };
+    
+    void check_batch_agent() {
+        Environment& env = Environment::instance();
+        static Monitor monitor;
+        env.register_agent(&monitor);
+        float expected = 0.0f;
+        for (uint32_t i = 0; i < 10; ++i) {
+            const float pressure = i % 4 == 0 ? 900.0f : 1000.0f;  // 0, 4, 8 알람
+            MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, monitor.id(), Reading{sample(i), i, pressure}));
+            expected += sample(i);
+        }
+        env.process_all_messages();
+        MINI_SO_CHECK(monitor.rows == 10 && monitor.batches >= 1 && monitor.batches < 10);
+        MINI_SO_CHECK(monitor.temperature_sum == expected && monitor.alarms == 3);
+        env.unregister_agent(monitor.id());
+    }
+}
+
+int main() {
+    MINI_SO_CHECK(std::strlen(MINI_SO_DSP_BACKEND) > 0);
+    check_kernels();
+    check_batch_view();
+    check_moving_average();
+    check_batch_agent();
+    return MINI_SO_TEST_RESULT("batch kernels");
+}
@@ -0,0 +1,101 @@
+/**
+ * @file test_emergency_dispatch.cpp
+ * @brief 비상 모드의 critical Agent 라운드 - 전용 메일박스, 라운드당 예산, 소비자 점유 시 보류
+ *
+ * - 등록된 Agent만 critical 지정 가능, 비상 모드 밖이나 critical이 아닌 대상에는 emergency::send 거부
+ * - 한 라운드에 Agent당 최대 MINI_SO_EMERGENCY_BUDGET개, 나머지는 다음 라운드
+ * - 소비자 역할이 점유 중이면 이번 라운드는 보류(deferred)하고 다음 라운드에 전달
+ * - 전용 메일박스가 가득 차면 거부 (rejected), 일반 전송 경로는 영향 없음
+ * - 해제하면 critical 지정도 풀림
+ */
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#include "test_support.h"
+
+using namespace mini_so;
+
+namespace {
+    struct Stop { uint32_t code; };
+    struct Status { uint32_t value; };
+    
+    struct Actuator : Agent {
+        uint32_t stops = 0;
+        uint32_t last = 0;
+        AgentId sender = INVALID_AGENT_ID;
+        bool handle_message(const MessageBase& msg) noexcept override {
+            if (msg.type_id() != MESSAGE_TYPE_ID(Stop)) return false;
+            ++stops;
+            last = static_cast<const Message<Stop>&>(msg).data.code;
+            sender = msg.sender_id();
+            return true;
+        }
+    };
+    
+    struct Monitor : Agent {
+        uint32_t received = 0;
+        bool handle_message(const MessageBase&) noexcept override {
+            ++received;
+            return true;
+        }
+    };
+}
+
+int main() {
+    Environment& env = Environment::instance();
+    System::instance().initialize();
+    
+    static Actuator brake, valve;
+    static Monitor monitor;
+    Actuator unregistered;
+    MINI_SO_CHECK(!emergency::set_critical(unregistered));
+    
+    env.register_agent(&brake);
+    env.register_agent(&valve);
+    env.register_agent(&monitor);
+    MINI_SO_CHECK(emergency::set_critical(brake));
+    MINI_SO_CHECK(emergency::set_critical(brake));  // 중복 지정은 그대로 성공
+    MINI_SO_CHECK(emergency::set_critical(valve));
+    MINI_SO_CHECK(emergency::is_critical(brake.id()) && !emergency::is_critical(monitor.id()));
+    
+    MINI_SO_CHECK(!emergency::send(brake.id(), Stop{1}));  // 비상 모드가 아님
+    emergency::enter_emergency_mode();
+    MINI_SO_CHECK(emergency::send(brake.id(), Stop{7}, monitor.id()));
+    MINI_SO_CHECK(!emergency::send(monitor.id(), Stop{1}));  // critical이 아님
+    
+    // 라운드당 예산
+    for (uint32_t i = 0; i < MINI_SO_EMERGENCY_BUDGET + 2; ++i) emergency::send(valve.id(), Stop{10 + i});
+    emergency::run_emergency_loop();
+    MINI_SO_CHECK(brake.stops == 1 && brake.last == 7 && brake.sender == monitor.id());
+    MINI_SO_CHECK(valve.stops == MINI_SO_EMERGENCY_BUDGET);
+    emergency::run_emergency_loop();
+    MINI_SO_CHECK(valve.stops == MINI_SO_EMERGENCY_BUDGET + 2 && valve.last == 10 + MINI_SO_EMERGENCY_BUDGET + 1);
+    
+    // 소비자 점유 중이면 보류 후 다음 라운드에 전달
+    MINI_SO_CHECK(brake.message_queue_.try_lock_consumer());
+    MINI_SO_CHECK(emergency::send(brake.id(), Stop{8}));
+    emergency::run_emergency_loop();
+    MINI_SO_CHECK(brake.stops == 1);
+    brake.message_queue_.unlock_consumer();
+    emergency::run_emergency_loop();
+    MINI_SO_CHECK(brake.stops == 2 && brake.last == 8);
+    
+    // 전용 메일박스가 가득 차면 거부
+    uint32_t accepted = 0;
+    for (uint32_t i = 0; i < 1000; ++i) accepted += emergency::send(brake.id(), Stop{1});
+    MINI_SO_CHECK(accepted > 0 && accepted < 1000);
+    
+    // 일반 전송 경로는 그대로
+    MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, monitor.id(), Status{1}));
+    env.process_all_messages();
+    MINI_SO_CHECK(monitor.received == 1);
+    
+    env.unregister_agent(valve.id());
+    MINI_SO_CHECK(!emergency::is_critical(valve.id()));
+    
+    const emergency::DegradedStats stats = emergency::degraded_stats();
+    MINI_SO_CHECK(stats.rounds == 4);
+    MINI_SO_CHECK(stats.delivered == 1 + MINI_SO_EMERGENCY_BUDGET + 2 + 1);
+    MINI_SO_CHECK(stats.rejected == 2 + (1000 - accepted));
+    MINI_SO_CHECK(stats.deferred >= 1);
+    
+    return MINI_SO_TEST_RESULT("emergency dispatch");
+}
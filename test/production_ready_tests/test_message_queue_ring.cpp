@@ -0,0 +1,183 @@
+/**
+ * @file test_message_queue_ring.cpp
+ * @brief MUTEX/SPSC/MPSC 가변 크기 레코드 ring - wraparound와 동시 생산자
+ *
+ * - 크기가 다른 레코드를 용량의 여러 배만큼 넣고 빼며 wrap padding 뒤에도 순서/내용 유지
+ * - 가득 찬 ring은 QUEUE_FULL, MINI_SO_MAX_MESSAGE_SIZE 초과는 MESSAGE_TOO_LARGE
+ * - attach_storage: 작은 외부 버퍼로 교체하면 그 용량 기준으로 QUEUE_FULL
+ * - MPSC: 생산자 스레드 4개 동시 push, 소비자 하나 - 생산자별 순서 유지, 유실/중복 없음
+ */
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#include "test_support.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mini_so;
+
+namespace {
+    struct Small { uint32_t seq; };
+    struct Medium { uint32_t seq; uint8_t fill[20]; };
+    struct Large { uint32_t seq; uint8_t fill[60]; };
+    struct Stamp { uint32_t producer; uint32_t seq; };
+    struct Oversized { uint32_t seq; uint8_t fill[MINI_SO_MAX_MESSAGE_SIZE]; };
+    
+    template<typename Queue, typename T>
+    QueueResult push_value(Queue& queue, uint32_t seq) {
+        T value{};
+        value.seq = seq;
+        const Message<T> msg(value, INVALID_AGENT_ID);
+        return queue.push(msg, sizeof(msg));
+    }
+    
+    // 세 크기를 번갈아 넣어 레코드 경계가 버퍼 끝과 맞지 않게 함
+    template<typename Queue>
+    QueueResult push_mixed(Queue& queue, uint32_t seq) {
+        switch (seq % 3) {
+            case 0: return push_value<Queue, Small>(queue, seq);
+            case 1: return push_value<Queue, Medium>(queue, seq);
+            default: return push_value<Queue, Large>(queue, seq);
+        }
+    }
+    
+    template<typename Queue>
+    bool pop_mixed(Queue& queue, uint32_t& seq) {
+        alignas(8) uint8_t buffer[MINI_SO_MAX_MESSAGE_SIZE];
+        uint16_t size = 0;
+        if (!queue.pop(buffer, size)) return false;
+        const MessageBase& msg = *reinterpret_cast<const MessageBase*>(buffer);
+        if (msg.type_id() == MESSAGE_TYPE_ID(Small) && size == sizeof(Message<Small>)) {
+            seq = static_cast<const Message<Small>&>(msg).data.seq;
+        } else if (msg.type_id() == MESSAGE_TYPE_ID(Medium) && size == sizeof(Message<Medium>)) {
+            seq = static_cast<const Message<Medium>&>(msg).data.seq;
+        } else if (msg.type_id() == MESSAGE_TYPE_ID(Large) && size == sizeof(Message<Large>)) {
+            seq = static_cast<const Message<Large>&>(msg).data.seq;
+        } else {
+            seq = 0xFFFFFFFFu;
+        }
+        return true;
+    }
+    
+    template<QueuePolicy Policy>
+    void check_wraparound() {
+        using Queue = BasicMessageQueue<Policy, 512>;
+        static Queue queue;
+        uint32_t next_push = 0;
+        uint32_t next_pop = 0;
+        // 3개 넣고 2개 빼며 점유를 늘렸다가 가득 차면 비우기를 반복 - 용량의 수십 배를 통과
+        for (int round = 0; round < 200; ++round) {
+            for (int i = 0; i < 3; ++i) {
+                if (push_mixed(queue, next_push) == QueueResult::SUCCESS) ++next_push;
+            }
+            for (int i = 0; i < 2; ++i) {
+                uint32_t seq = 0;
+                if (pop_mixed(queue, seq)) {
+                    MINI_SO_CHECK(seq == next_pop);
+                    ++next_pop;
+                }
+            }
+            if (queue.full()) {
+                uint32_t seq = 0;
+                while (pop_mixed(queue, seq)) {
+                    MINI_SO_CHECK(seq == next_pop);
+                    ++next_pop;
+                }
+            }
+        }
+        uint32_t seq = 0;
+        while (pop_mixed(queue, seq)) {
+            MINI_SO_CHECK(seq == next_pop);
+            ++next_pop;
+        }
+        MINI_SO_CHECK(next_push > 200);
+        MINI_SO_CHECK(next_pop == next_push);
+        MINI_SO_CHECK(queue.empty() && queue.used_bytes() == 0);
+        
+        // 가득 차면 QUEUE_FULL, 비우면 다시 받음
+        QueueResult last = QueueResult::SUCCESS;
+        std::size_t accepted = 0;
+        while ((last = push_value<Queue, Large>(queue, 0)) == QueueResult::SUCCESS) ++accepted;
+        MINI_SO_CHECK(last == QueueResult::QUEUE_FULL);
+        MINI_SO_CHECK(accepted > 0 && accepted == queue.size());
+        queue.clear();
+        MINI_SO_CHECK(queue.empty());
+        MINI_SO_CHECK((push_value<Queue, Large>(queue, 1)) == QueueResult::SUCCESS);
+        
+        MINI_SO_CHECK((push_value<Queue, Oversized>(queue, 2)) == QueueResult::MESSAGE_TOO_LARGE);
+        MINI_SO_CHECK(queue.size() == 1);
+        queue.clear();
+    }
+    
+    void check_external_storage() {
+        static BasicMessageQueue<QueuePolicy::MPSC, 512> queue;
+        // 외부 버퍼는 2의 거듭제곱 + 8바이트 정렬만 받음
+        alignas(8) static uint8_t tiny[64];
+        MINI_SO_CHECK(!queue.attach_storage(tiny, 48));
+        MINI_SO_CHECK(queue.attach_storage(tiny, sizeof(tiny)));
+        MINI_SO_CHECK(queue.capacity_bytes() == sizeof(tiny));
+        MINI_SO_CHECK((push_value<decltype(queue), Large>(queue, 1)) == QueueResult::QUEUE_FULL);
+        MINI_SO_CHECK((push_value<decltype(queue), Small>(queue, 2)) == QueueResult::SUCCESS);
+        uint32_t seq = 0;
+        MINI_SO_CHECK(pop_mixed(queue, seq) && seq == 2);
+        queue.detach_storage();
+        MINI_SO_CHECK(queue.capacity_bytes() == 512);
+        MINI_SO_CHECK((push_value<decltype(queue), Large>(queue, 3)) == QueueResult::SUCCESS);
+        queue.clear();
+    }
+    
+    void check_concurrent_producers() {
+        constexpr uint32_t PRODUCERS = 4;
+        constexpr uint32_t PER_PRODUCER = 20000;
+        static BasicMessageQueue<QueuePolicy::MPSC, 1024> queue;
+        std::atomic<bool> go{false};
+        std::vector<std::thread> producers;
+        for (uint32_t p = 0; p < PRODUCERS; ++p) {
+            producers.emplace_back([&, p] {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                for (uint32_t seq = 0; seq < PER_PRODUCER;) {
+                    const Message<Stamp> msg(Stamp{p, seq}, INVALID_AGENT_ID);
+                    if (queue.push(msg, sizeof(msg)) == QueueResult::SUCCESS) {
+                        ++seq;
+                    } else {
+                        std::this_thread::yield();  // 가득 참 - 소비자가 비울 때까지
+                    }
+                }
+            });
+        }
+        
+        uint32_t expected[PRODUCERS] = {};
+        uint32_t received = 0;
+        bool ordered = true;
+        go.store(true, std::memory_order_release);
+        while (received < PRODUCERS * PER_PRODUCER) {
+            alignas(8) uint8_t buffer[MINI_SO_MAX_MESSAGE_SIZE];
+            uint16_t size = 0;
+            if (!queue.pop(buffer, size)) {
+                std::this_thread::yield();
+                continue;
+            }
+            const Stamp& stamp = reinterpret_cast<const Message<Stamp>*>(buffer)->data;
+            if (stamp.producer >= PRODUCERS || stamp.seq != expected[stamp.producer]) {
+                ordered = false;
+            } else {
+                ++expected[stamp.producer];
+            }
+            ++received;
+        }
+        for (std::thread& producer : producers) producer.join();
+        
+        MINI_SO_CHECK(ordered);
+        for (uint32_t p = 0; p < PRODUCERS; ++p) MINI_SO_CHECK(expected[p] == PER_PRODUCER);
+        MINI_SO_CHECK(queue.empty());
+    }
+}
+
+int main() {
+    check_wraparound<QueuePolicy::MUTEX>();
+    check_wraparound<QueuePolicy::SPSC>();
+    check_wraparound<QueuePolicy::MPSC>();
+    check_external_storage();
+    check_concurrent_producers();
+    return MINI_SO_TEST_RESULT("message queue ring");
+}
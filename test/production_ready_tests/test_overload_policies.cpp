@@ -0,0 +1,222 @@
+/**
+ * @file test_overload_policies.cpp
+ * @brief 가득 찬 메일박스의 과부하 정책 - 단건 전송과 send_batch
+ *
+ * - DROP_NEWEST(기본): 새 메시지를 버리고 대기 메시지 유지
+ * - DROP_OLDEST: 가장 오래된 메시지를 밀어내고 새 메시지 전달
+ * - KEEP_LATEST: 대기 중인 같은 타입 메시지 값을 교체
+ * - BLOCK: timeout까지 기다린 뒤 실패 (소비자가 같은 태스크라 공간이 생기지 않음)
+ * - REDIRECT: overflow 대상으로 전달
+ * - MessageOverload<T>가 Agent 정책보다 우선, MessageCoalesce<T>는 최신 값 하나만 전달
+ *   (메일박스가 가득 차 표지를 넣지 못한 값도 비운 뒤 전달)
+ * - send_batch도 같은 정책을 적용 (배치 예약 경로가 정책을 우회하지 않음)
+ */
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#include "test_support.h"
+
+using namespace mini_so;
+
+namespace {
+    struct Cmd { uint32_t value; };
+    struct Urgent { uint32_t value; };
+    struct Level { uint32_t value; };
+}
+
+MINI_SO_MESSAGE_OVERLOAD(Urgent, DROP_OLDEST);
+MINI_SO_MESSAGE_COALESCE(Level);
+
+namespace {
+    struct Sink : Agent {
+        uint32_t cmds = 0;
+        uint32_t urgents = 0;
+        uint32_t levels = 0;
+        uint32_t first = 0xFFFFFFFFu;
+        uint32_t last = 0;
+        
+        bool handle_message(const MessageBase& msg) noexcept override {
+            uint32_t value = 0;
+            if (msg.type_id() == MESSAGE_TYPE_ID(Cmd)) {
+                value = static_cast<const Message<Cmd>&>(msg).data.value;
+                ++cmds;
+            } else if (msg.type_id() == MESSAGE_TYPE_ID(Urgent)) {
+                value = static_cast<const Message<Urgent>&>(msg).data.value;
+                ++urgents;
+            } else if (msg.type_id() == MESSAGE_TYPE_ID(Level)) {
+                value = static_cast<const Message<Level>&>(msg).data.value;
+                ++levels;
+            } else {
+                return false;
+            }
+            if (first == 0xFFFFFFFFu) first = value;
+            last = value;
+            return true;
+        }
+        
+        void reset_counts() noexcept {
+            cmds = urgents = levels = last = 0;
+            first = 0xFFFFFFFFu;
+        }
+    };
+    
+    Environment& env() noexcept { return Environment::instance(); }
+    
+    // 기본 정책(DROP_NEWEST)으로 처리 없이 가득 채움 - 반환: 받아들여진 개수 (값 0..n-1).
+    // 마지막 실패한 시도 하나가 dropped에 집계됨
+    uint32_t fill(Sink& sink) {
+        uint32_t accepted = 0;
+        while (env().send_message(INVALID_AGENT_ID, sink.id(), Cmd{accepted})) ++accepted;
+        return accepted;
+    }
+    
+    void check_drop_newest() {
+        static Sink sink;
+        env().register_agent(&sink);
+        MINI_SO_CHECK(sink.overload_policy() == OverloadPolicy::DROP_NEWEST);
+        const uint32_t capacity = fill(sink);
+        MINI_SO_CHECK(capacity > 1);
+        MINI_SO_CHECK(!env().send_message(INVALID_AGENT_ID, sink.id(), Cmd{1000}));
+        env().process_all_messages();
+        MINI_SO_CHECK(sink.overload_stats().dropped == 2);
+        MINI_SO_CHECK(sink.cmds == capacity && sink.first == 0 && sink.last == capacity - 1);
+        env().unregister_agent(sink.id());
+    }
+    
+    void check_drop_oldest() {
+        static Sink sink;
+        env().register_agent(&sink);
+        const uint32_t capacity = fill(sink);
+        sink.set_overload_policy(OverloadPolicy::DROP_OLDEST);
+        for (uint32_t i = 0; i < 3; ++i) {
+            MINI_SO_CHECK(env().send_message(INVALID_AGENT_ID, sink.id(), Cmd{1000 + i}));
+        }
+        env().process_all_messages();
+        const OverloadStats stats = sink.overload_stats();
+        MINI_SO_CHECK(stats.evicted == 3 && stats.dropped == 1);
+        MINI_SO_CHECK(sink.cmds == capacity && sink.first == 3 && sink.last == 1002);
+        env().unregister_agent(sink.id());
+    }
+    
+    void check_keep_latest() {
+        static Sink sink;
+        env().register_agent(&sink);
+        const uint32_t capacity = fill(sink);
+        sink.set_overload_policy(OverloadPolicy::KEEP_LATEST);
+        MINI_SO_CHECK(env().send_message(INVALID_AGENT_ID, sink.id(), Cmd{1000}));
+        MINI_SO_CHECK(env().send_message(INVALID_AGENT_ID, sink.id(), Cmd{1001}));
+        env().process_all_messages();
+        const OverloadStats stats = sink.overload_stats();
+        MINI_SO_CHECK(stats.coalesced == 2 && stats.evicted == 0);
+        // 가장 최근 대기 메시지(capacity - 1)의 값이 교체됨 - 개수와 앞부분 순서는 그대로
+        MINI_SO_CHECK(sink.cmds == capacity && sink.first == 0 && sink.last == 1001);
+        env().unregister_agent(sink.id());
+    }
+    
+    void check_block_timeout() {
+        static Sink sink;
+        env().register_agent(&sink);
+        const uint32_t capacity = fill(sink);
+        sink.set_overload_policy(OverloadPolicy::BLOCK);
+        sink.set_overload_timeout(50);
+        MINI_SO_CHECK(!env().send_message(INVALID_AGENT_ID, sink.id(), Cmd{1000}));
+        const OverloadStats stats = sink.overload_stats();
+        MINI_SO_CHECK(stats.timed_out == 1 && stats.blocked == 0 && stats.dropped == 2);
+        env().process_all_messages();
+        MINI_SO_CHECK(sink.cmds == capacity && sink.last == capacity - 1);
+        env().unregister_agent(sink.id());
+    }
+    
+    void check_redirect() {
+        static Sink sink, spill;
+        env().register_agent(&sink);
+        env().register_agent(&spill);
+        fill(sink);
+        sink.set_overload_policy(OverloadPolicy::REDIRECT);
+        sink.set_overflow_target(&spill);
+        MINI_SO_CHECK(env().send_message(INVALID_AGENT_ID, sink.id(), Cmd{1000}));
+        env().process_all_messages();
+        MINI_SO_CHECK(sink.overload_stats().redirected == 1);
+        MINI_SO_CHECK(spill.cmds == 1 && spill.last == 1000);
+        
+        // 대상이 없으면 버림
+        fill(sink);
+        sink.set_overflow_target(nullptr);
+        MINI_SO_CHECK(!env().send_message(INVALID_AGENT_ID, sink.id(), Cmd{1001}));
+        env().process_all_messages();
+        env().unregister_agent(spill.id());
+        env().unregister_agent(sink.id());
+    }
+    
+    void check_type_policies() {
+        static Sink sink;
+        env().register_agent(&sink);
+        fill(sink);
+        // Agent는 DROP_NEWEST지만 Urgent는 DROP_OLDEST
+        MINI_SO_CHECK(env().send_message(INVALID_AGENT_ID, sink.id(), Urgent{7}));
+        MINI_SO_CHECK(sink.overload_stats().evicted == 1);
+        env().process_all_messages();
+        MINI_SO_CHECK(sink.urgents == 1 && sink.last == 7);
+        
+        // 최신 값 타입: 대기 표지 하나만 큐잉, 핸들러는 마지막 값만
+        sink.reset_counts();
+        for (uint32_t i = 1; i <= 5; ++i) {
+            MINI_SO_CHECK(env().send_message(INVALID_AGENT_ID, sink.id(), Level{i}));
+        }
+        env().process_all_messages();
+        MINI_SO_CHECK(sink.levels == 1 && sink.last == 5);
+        MINI_SO_CHECK(sink.overload_stats().coalesced == 4);
+        
+        // 메일박스가 가득 차 표지를 넣지 못해도 값은 cell에 남아 (coalesced) 메일박스를 비운 뒤 전달됨
+        sink.reset_counts();
+        const uint32_t capacity = fill(sink);
+        MINI_SO_CHECK(env().send_message(INVALID_AGENT_ID, sink.id(), Level{8}));
+        MINI_SO_CHECK(env().try_send(INVALID_AGENT_ID, sink.id(), Level{9}) == SendResult::SENT);
+        MINI_SO_CHECK(sink.overload_stats().coalesced == 6);
+        env().process_all_messages();
+        MINI_SO_CHECK(sink.cmds == capacity && sink.levels == 1 && sink.last == 9);
+        MINI_SO_CHECK(!sink.has_messages());
+        env().unregister_agent(sink.id());
+    }
+    
+    void check_send_batch() {
+        static Sink sink;
+        env().register_agent(&sink);
+        
+        static Cmd cmds[400];
+        for (uint32_t i = 0; i < 400; ++i) cmds[i] = Cmd{i};
+        
+        // DROP_NEWEST: 앞에서부터 들어간 만큼만, 나머지는 dropped
+        const std::size_t sent = env().send_batch(INVALID_AGENT_ID, sink.id(), Span<const Cmd>(cmds, 400));
+        MINI_SO_CHECK(sent > 0 && sent < 400);
+        MINI_SO_CHECK(sink.overload_stats().dropped == 400 - sent);
+        env().process_all_messages();
+        MINI_SO_CHECK(sink.cmds == sent && sink.last == sent - 1);
+        
+        // DROP_OLDEST: 모두 받아들이고 앞의 메시지를 밀어냄 - 마지막 값이 도착
+        sink.reset_counts();
+        sink.set_overload_policy(OverloadPolicy::DROP_OLDEST);
+        MINI_SO_CHECK(env().send_batch(INVALID_AGENT_ID, sink.id(), Span<const Cmd>(cmds, 400)) == 400);
+        MINI_SO_CHECK(sink.overload_stats().evicted == 400 - sent);
+        env().process_all_messages();
+        MINI_SO_CHECK(sink.cmds == sent && sink.last == 399);
+        
+        // 최신 값 타입 배치는 한 번만 전달
+        sink.reset_counts();
+        const Level levels[5] = {{1}, {2}, {3}, {4}, {5}};
+        MINI_SO_CHECK(env().send_batch(INVALID_AGENT_ID, sink.id(), Span<const Level>(levels, 5)) == 5);
+        env().process_all_messages();
+        MINI_SO_CHECK(sink.levels == 1 && sink.last == 5);
+        env().unregister_agent(sink.id());
+    }
+}
+
+int main() {
+    System::instance().initialize();
+    check_drop_newest();
+    check_drop_oldest();
+    check_keep_latest();
+    check_block_timeout();
+    check_redirect();
+    check_type_policies();
+    check_send_batch();
+    return MINI_SO_TEST_RESULT("overload policies");
+}
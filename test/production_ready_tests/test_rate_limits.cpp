@@ -0,0 +1,163 @@
+/**
+ * @file test_rate_limits.cpp
+ * @brief 토큰 버킷 한도 - 발신자 / 발신자+타입 / 구독 키, SHED와 COALESCE
+ *
+ * - SHED: 초과 메시지는 메일박스 전에 버려지고 THROTTLED, 수신 Agent의 throttled에 집계
+ * - COALESCE: 초과 메시지가 대기 중인 같은 타입 메시지 값을 교체 - 마지막 값이 전달됨
+ * - 보충 속도(per second)에 따라 다시 통과, 한도 Agent 해제 시 항목 제거
+ * - 여러 발신 스레드가 같은 한도를 동시에 써도 버킷 크기만큼만 통과, 다른 한도의 거부가 돌려준 토큰도 유지
+ */
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#include "test_support.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mini_so;
+
+namespace {
+    struct Ping { uint32_t value; };
+    struct Pong { uint32_t value; };
+    
+    struct Receiver : Agent {
+        uint32_t pings = 0;
+        uint32_t pongs = 0;
+        uint32_t last = 0;
+        bool handle_message(const MessageBase& msg) noexcept override {
+            if (msg.type_id() == MESSAGE_TYPE_ID(Ping)) {
+                ++pings;
+                last = static_cast<const Message<Ping>&>(msg).data.value;
+                return true;
+            }
+            if (msg.type_id() == MESSAGE_TYPE_ID(Pong)) {
+                ++pongs;
+                return true;
+            }
+            return false;
+        }
+    };
+    
+    struct Sender : Agent {
+        bool handle_message(const MessageBase&) noexcept override { return true; }
+    };
+    
+    // threads개 스레드가 동시에 admit을 attempts번씩 - 반환: 통과 수
+    uint32_t admit_concurrently(detail::RateLimiter& limits, AgentId sender, AgentId receiver, MessageId type,
+                                uint32_t threads, uint32_t attempts) {
+        std::atomic<bool> go{false};
+        std::atomic<uint32_t> passed{0};
+        std::vector<std::thread> workers;
+        for (uint32_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                for (uint32_t i = 0; i < attempts; ++i) {
+                    std::size_t denied = detail::RateLimiter::NONE;
+                    if (limits.admit(sender, receiver, type, denied) == detail::RateLimiter::Verdict::PASS) {
+                        passed.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        go.store(true, std::memory_order_release);
+        for (auto& worker : workers) worker.join();
+        return passed.load();
+    }
+    
+    void check_concurrent_admit() {
+        static detail::RateLimiter limits;
+        constexpr AgentId SENDER = 1;
+        constexpr AgentId RECEIVER = 2;
+        const MessageId type = MESSAGE_TYPE_ID(Ping);
+        
+        // 보충 없는 버킷 하나를 4 스레드가 경합 - 정확히 버킷 크기만큼 통과
+        MINI_SO_CHECK(limits.set(SENDER, INVALID_AGENT_ID, INVALID_MESSAGE_ID, RateLimit{0, 500}));
+        MINI_SO_CHECK(admit_concurrently(limits, SENDER, RECEIVER, type, 8, 4000) == 500);
+        
+        // 두 한도가 겹침: 구독 한도(300)가 거부한 메시지는 발신자 한도에 토큰을 돌려줌
+        MINI_SO_CHECK(limits.set(SENDER, INVALID_AGENT_ID, INVALID_MESSAGE_ID, RateLimit{0, 500}));
+        MINI_SO_CHECK(limits.set(INVALID_AGENT_ID, RECEIVER, type, RateLimit{0, 300}));
+        MINI_SO_CHECK(admit_concurrently(limits, SENDER, RECEIVER, type, 8, 4000) == 300);
+        limits.remove(INVALID_AGENT_ID, RECEIVER, type);
+        MINI_SO_CHECK(admit_concurrently(limits, SENDER, RECEIVER, type, 8, 4000) == 200);
+        
+        ThrottleStats stats{};
+        MINI_SO_CHECK(limits.stats(SENDER, INVALID_AGENT_ID, INVALID_MESSAGE_ID, stats));
+        MINI_SO_CHECK(stats.passed == 1000);
+    }
+}
+
+int main() {
+    Environment& env = Environment::instance();
+    System::instance().initialize();
+    
+    static Receiver receiver;
+    static Sender sender, other;
+    env.register_agent(&receiver);
+    env.register_agent(&sender);
+    env.register_agent(&other);
+    
+    // 모든 키가 "모두"인 한도는 거부
+    MINI_SO_CHECK(!env.set_rate_limit(INVALID_AGENT_ID, INVALID_AGENT_ID, MESSAGE_TYPE_ID(Ping), RateLimit{0, 1}));
+    
+    // 발신자 한도 (보충 없음, 버킷 3) - SHED
+    MINI_SO_CHECK(sender.limit_send(RateLimit{0, 3}));
+    uint32_t passed = 0;
+    for (uint32_t i = 0; i < 10; ++i) passed += sender.send_message(receiver.id(), Ping{i});
+    MINI_SO_CHECK(passed == 3);
+    MINI_SO_CHECK(other.send_message(receiver.id(), Ping{100}));  // 다른 발신자는 영향 없음
+    MINI_SO_CHECK(sender.try_send(receiver.id(), Pong{1}) == SendResult::THROTTLED);
+    env.process_all_messages();
+    MINI_SO_CHECK(receiver.pings == 4);
+    
+    ThrottleStats stats{};
+    MINI_SO_CHECK(env.rate_limit_stats(sender.id(), INVALID_AGENT_ID, INVALID_MESSAGE_ID, stats));
+    MINI_SO_CHECK(stats.passed == 3 && stats.shed == 8 && stats.coalesced == 0);
+    MINI_SO_CHECK(receiver.overload_stats().throttled == 8);
+    env.clear_rate_limit(sender.id(), INVALID_AGENT_ID, INVALID_MESSAGE_ID);
+    MINI_SO_CHECK(sender.send_message(receiver.id(), Pong{2}));
+    env.process_all_messages();
+    
+    // 발신자+타입 한도 - 다른 타입은 통과
+    receiver.pings = receiver.pongs = 0;
+    MINI_SO_CHECK(sender.limit_send<Ping>(RateLimit{0, 1}));
+    for (uint32_t i = 0; i < 4; ++i) {
+        sender.send_message(receiver.id(), Ping{i});
+        sender.send_message(receiver.id(), Pong{i});
+    }
+    env.process_all_messages();
+    MINI_SO_CHECK(receiver.pings == 1 && receiver.pongs == 4);
+    env.clear_rate_limit(sender.id(), INVALID_AGENT_ID, MESSAGE_TYPE_ID(Ping));
+    
+    // 구독 한도 + COALESCE - 초과분이 대기 메시지 값을 교체, 마지막 값이 도착
+    receiver.pings = 0;
+    MINI_SO_CHECK(receiver.subscribe<Ping>(RateLimit{0, 2, Throttle::COALESCE}));
+    for (uint32_t i = 0; i < 6; ++i) env.publish(sender.id(), Ping{200 + i});
+    env.process_all_messages();
+    MINI_SO_CHECK(receiver.pings == 2 && receiver.last == 205);
+    MINI_SO_CHECK(env.rate_limit_stats(INVALID_AGENT_ID, receiver.id(), MESSAGE_TYPE_ID(Ping), stats));
+    MINI_SO_CHECK(stats.passed == 2 && stats.coalesced == 4 && stats.shed == 0);
+    
+    // 대기 메시지가 없으면 COALESCE도 버림
+    for (uint32_t i = 0; i < 2; ++i) env.publish(sender.id(), Ping{300 + i});
+    env.process_all_messages();
+    MINI_SO_CHECK(receiver.pings == 2);
+    MINI_SO_CHECK(env.rate_limit_stats(INVALID_AGENT_ID, receiver.id(), MESSAGE_TYPE_ID(Ping), stats));
+    MINI_SO_CHECK(stats.shed == 2);
+    
+    // 보충: 100/s, UNIT_TEST 시계는 now() 호출마다 10틱 - 대략 호출마다 토큰 하나
+    MINI_SO_CHECK(env.set_rate_limit(INVALID_AGENT_ID, receiver.id(), MESSAGE_TYPE_ID(Ping), RateLimit{100, 1}));
+    receiver.pings = 0;
+    passed = 0;
+    for (uint32_t i = 0; i < 10; ++i) passed += sender.send_message(receiver.id(), Ping{i});
+    env.process_all_messages();
+    MINI_SO_CHECK(passed >= 5 && receiver.pings == passed);
+    MINI_SO_CHECK(env.throttled() > 0);
+    
+    // 한도 Agent 해제 시 항목도 제거
+    env.unregister_agent(receiver.id());
+    MINI_SO_CHECK(!env.rate_limit_stats(INVALID_AGENT_ID, receiver.id(), MESSAGE_TYPE_ID(Ping), stats));
+    
+    check_concurrent_admit();
+    return MINI_SO_TEST_RESULT("rate limits");
+}
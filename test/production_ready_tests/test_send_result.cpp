@@ -0,0 +1,107 @@
+/**
+ * @file test_send_result.cpp
+ * @brief try_send / send_for의 SendResult 코드
+ *
+ * - SENT, NO_SUCH_AGENT(해제된 옛 ID), FILTERED(수신 필터), THROTTLED(발신 한도)
+ * - MESSAGE_TOO_LARGE: 빈 메일박스에도 들어가지 않는 레코드 (작은 외부 메일박스)
+ * - QUEUE_FULL: try_send는 BLOCK 정책이어도 기다리지 않음, send_for는 timeout까지 기다린 뒤 실패
+ * - BUSY는 MUTEX 메일박스 잠금 한도 초과에서만 - 기본(MPSC) 메일박스 구성에서는 발생하지 않음
+ */
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#include "test_support.h"
+
+using namespace mini_so;
+
+namespace {
+    struct Cmd { uint32_t value; };
+    struct Bulk { uint8_t bytes[96]; };
+    
+    struct Sink : Agent {
+        uint32_t cmds = 0;
+        uint32_t last = 0;
+        bool handle_message(const MessageBase& msg) noexcept override {
+            if (msg.type_id() == MESSAGE_TYPE_ID(Cmd)) {
+                ++cmds;
+                last = static_cast<const Message<Cmd>&>(msg).data.value;
+            }
+            return true;
+        }
+    };
+    
+    // 작은 외부 메일박스 - Bulk 레코드는 비어 있어도 들어가지 않음
+    struct SmallSink : Agent {
+        alignas(8) uint8_t mailbox[64];
+        SmallSink() noexcept { set_mailbox_storage(mailbox, sizeof(mailbox)); }
+        bool handle_message(const MessageBase&) noexcept override { return true; }
+    };
+    
+    bool only_even(const Cmd& cmd, AgentId) noexcept { return cmd.value % 2 == 0; }
+}
+
+int main() {
+    Environment& env = Environment::instance();
+    System::instance().initialize();
+    
+    static Sink sink, sender;
+    static SmallSink small;
+    env.register_agent(&sink);
+    env.register_agent(&sender);
+    env.register_agent(&small);
+    
+    MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, sink.id(), Cmd{1}) == SendResult::SENT);
+    MINI_SO_CHECK(sender.try_send(sink.id(), Cmd{2}) == SendResult::SENT);
+    env.process_all_messages();
+    MINI_SO_CHECK(sink.cmds == 2 && sink.last == 2);
+    
+    // 해제된 Agent의 옛 ID
+    static Sink gone;
+    const AgentId gone_id = env.register_agent(&gone);
+    env.unregister_agent(gone_id);
+    MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, gone_id, Cmd{3}) == SendResult::NO_SUCH_AGENT);
+    MINI_SO_CHECK(env.send_for(INVALID_AGENT_ID, gone_id, Cmd{3}, 10) == SendResult::NO_SUCH_AGENT);
+    
+    // 크기 초과: 메일박스 용량보다 큰 레코드는 기다려도 소용없음
+    MINI_SO_CHECK(small.mailbox_bytes() == 64);
+    MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, small.id(), Bulk{}) == SendResult::MESSAGE_TOO_LARGE);
+    MINI_SO_CHECK(env.send_for(INVALID_AGENT_ID, small.id(), Bulk{}, 10) == SendResult::MESSAGE_TOO_LARGE);
+    MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, small.id(), Cmd{4}) == SendResult::SENT);
+    
+    // 수신 필터 거부
+    MINI_SO_CHECK(sink.set_receive_filter<Cmd>(&only_even));
+    MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, sink.id(), Cmd{5}) == SendResult::FILTERED);
+    MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, sink.id(), Cmd{6}) == SendResult::SENT);
+    MINI_SO_CHECK(sink.filtered_count() == 1);
+    sink.clear_receive_filter<Cmd>();
+    env.process_all_messages();
+    MINI_SO_CHECK(sink.cmds == 3 && sink.last == 6);
+    
+    // 발신 한도 (보충 없음, 버킷 1)
+    MINI_SO_CHECK(sender.limit_send(RateLimit{0, 1}));
+    MINI_SO_CHECK(sender.try_send(sink.id(), Cmd{8}) == SendResult::SENT);
+    MINI_SO_CHECK(sender.try_send(sink.id(), Cmd{10}) == SendResult::THROTTLED);
+    MINI_SO_CHECK(sender.send_for(sink.id(), Cmd{12}, 10) == SendResult::THROTTLED);
+    env.clear_rate_limit(sender.id(), INVALID_AGENT_ID, INVALID_MESSAGE_ID);
+    env.process_all_messages();
+    MINI_SO_CHECK(sink.cmds == 4 && sink.last == 8);
+    
+    // 가득 참: BLOCK 정책이어도 try_send는 즉시, send_for는 timeout 후 QUEUE_FULL
+    sink.set_overload_policy(OverloadPolicy::BLOCK);
+    sink.set_overload_timeout(1000);
+    uint32_t accepted = 0;
+    while (env.try_send(INVALID_AGENT_ID, sink.id(), Cmd{accepted}) == SendResult::SENT) ++accepted;
+    MINI_SO_CHECK(accepted > 0);
+    MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, sink.id(), Cmd{0}) == SendResult::QUEUE_FULL);
+    MINI_SO_CHECK(sink.overload_stats().blocked == 0);
+    
+    const TimePoint before = now();
+    MINI_SO_CHECK(env.send_for(INVALID_AGENT_ID, sink.id(), Cmd{0}, 30) == SendResult::QUEUE_FULL);
+    MINI_SO_CHECK(now() - before > 30);  // 실제로 timeout까지 재시도
+    
+    env.process_all_messages();
+    MINI_SO_CHECK(sink.cmds == 4 + accepted);
+    MINI_SO_CHECK(env.send_for(INVALID_AGENT_ID, sink.id(), Cmd{99}, 30) == SendResult::SENT);
+    env.process_all_messages();
+    MINI_SO_CHECK(sink.last == 99);
+    
+    return MINI_SO_TEST_RESULT("send result");
+}
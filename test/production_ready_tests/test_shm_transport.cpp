@@ -0,0 +1,135 @@
+/**
+ * @file test_shm_transport.cpp
+ * @brief 호스트 공유 메모리 전송 (host/shm_transport.h) - ring wraparound와 proxy 왕복
+ *
+ * - ShmRing: 끝에 맞지 않는 레코드는 padding 뒤 처음부터, 가득 차면 push 실패, 순서/내용 유지
+ * - ShmChannel 두 개(A/B)를 한 프로세스에서 같은 세그먼트에 열어 연결 (매핑은 각각):
+ *   A의 proxy로 보낸 메시지가 B 쪽 대상 Agent에 도착하고, 답장은 B의 proxy를 거쳐 돌아옴.
+ *   수신 측 발신자는 로컬 proxy ID로 바뀜
+ */
+#include "mini_sobjectizer/host/shm_transport.h"
+#include "test_support.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace mini_so;
+
+namespace {
+    struct Cmd { uint32_t value; };
+    struct Reply { uint32_t value; };
+    struct Bulk { uint8_t bytes[80]; };
+    
+    void check_ring() {
+        static detail::ShmRing<1024> ring;
+        // 크기가 다른 레코드로 여러 바퀴 - wrap padding 뒤에도 순서/내용 유지
+        uint32_t pushed = 0;
+        uint32_t drained = 0;
+        bool in_order = true;
+        for (int round = 0; round < 100; ++round) {
+            for (int i = 0; i < 3; ++i) {
+                const Message<Cmd> small(Cmd{pushed}, INVALID_AGENT_ID);
+                Message<Bulk> large(Bulk{}, INVALID_AGENT_ID);
+                std::memcpy(large.data.bytes, &pushed, sizeof(pushed));
+                const bool ok = pushed % 2 ? ring.push(7, small, sizeof(small)) : ring.push(7, large, sizeof(large));
+                if (ok) ++pushed;
+            }
+            ring.drain(2, [&](AgentId target, const MessageBase& msg, uint16_t size) noexcept {
+                uint32_t value = 0xFFFFFFFFu;
+                if (msg.type_id() == MESSAGE_TYPE_ID(Cmd) && size == sizeof(Message<Cmd>)) {
+                    value = static_cast<const Message<Cmd>&>(msg).data.value;
+                } else if (msg.type_id() == MESSAGE_TYPE_ID(Bulk) && size == sizeof(Message<Bulk>)) {
+                    std::memcpy(&value, static_cast<const Message<Bulk>&>(msg).data.bytes, sizeof(value));
+                }
+                in_order = in_order && target == 7 && value == drained;
+                ++drained;
+            });
+        }
+        MINI_SO_CHECK(in_order && pushed > 100 && drained > 100);
+        
+        // 가득 차면 push 실패, 비우면 다시 받음
+        const Message<Bulk> large(Bulk{}, INVALID_AGENT_ID);
+        std::size_t accepted = 0;
+        while (ring.push(1, large, sizeof(large))) ++accepted;
+        MINI_SO_CHECK(accepted > 0 && accepted < 1024 / sizeof(large) + 1);
+        ring.drain(SIZE_MAX, [](AgentId, const MessageBase&, uint16_t) noexcept {});
+        MINI_SO_CHECK(ring.head.load() == ring.tail.load());
+        MINI_SO_CHECK(ring.push(1, large, sizeof(large)));
+    }
+    
+    // B 쪽 Agent: Cmd를 받으면 발신자(로컬 proxy)에게 value + 1로 답장
+    struct Motor : Agent {
+        uint32_t cmds = 0;
+        AgentId last_sender = INVALID_AGENT_ID;
+        bool handle_message(const MessageBase& msg) noexcept override {
+            if (msg.type_id() != MESSAGE_TYPE_ID(Cmd)) return false;
+            ++cmds;
+            last_sender = msg.sender_id();
+            return send_message(msg.sender_id(), Reply{static_cast<const Message<Cmd>&>(msg).data.value + 1});
+        }
+    };
+    
+    // A 쪽 Agent: 답장 수신
+    struct Controller : Agent {
+        uint32_t replies = 0;
+        uint32_t last = 0;
+        AgentId last_sender = INVALID_AGENT_ID;
+        bool handle_message(const MessageBase& msg) noexcept override {
+            if (msg.type_id() != MESSAGE_TYPE_ID(Reply)) return false;
+            ++replies;
+            last = static_cast<const Message<Reply>&>(msg).data.value;
+            last_sender = msg.sender_id();
+            return true;
+        }
+    };
+    
+    void check_round_trip() {
+        char name[64];
+        std::snprintf(name, sizeof(name), "/mini_so_test_%d", static_cast<int>(::getpid()));
+        ShmChannel::unlink(name);
+        
+        Environment& env = Environment::instance();
+        static Controller controller;
+        static Motor motor;
+        env.register_agent(&controller);
+        env.register_agent(&motor);
+        {
+            ShmChannel side_a(name, ShmSide::A);
+            ShmChannel side_b(name, ShmSide::B);
+            MINI_SO_CHECK(side_a.ready() && side_b.ready());
+            
+            ShmRemoteAgent motor_proxy(side_a, motor.id());            // A에서 본 motor
+            ShmRemoteAgent controller_proxy(side_b, controller.id());  // B에서 본 controller
+            const AgentId motor_proxy_id = env.register_agent(&motor_proxy);
+            const AgentId controller_proxy_id = env.register_agent(&controller_proxy);
+            MINI_SO_CHECK(motor_proxy_id != INVALID_AGENT_ID && controller_proxy_id != INVALID_AGENT_ID);
+            
+            for (uint32_t i = 0; i < 5; ++i) {
+                MINI_SO_CHECK(env.send_message(controller.id(), motor_proxy_id, Cmd{10 * i}));
+            }
+            env.process_all_messages();            // proxy → A→B ring
+            MINI_SO_CHECK(side_b.has_pending() && !side_a.has_pending());
+            MINI_SO_CHECK(side_b.poll(2) == 2);    // 한 번에 주입할 양 제한
+            MINI_SO_CHECK(side_b.poll() == 3);
+            env.process_all_messages();            // motor 처리, 답장 → B→A ring
+            MINI_SO_CHECK(motor.cmds == 5 && motor.last_sender == controller_proxy_id);
+            MINI_SO_CHECK(side_a.poll() == 5);
+            env.process_all_messages();
+            MINI_SO_CHECK(controller.replies == 5 && controller.last == 41);
+            MINI_SO_CHECK(controller.last_sender == motor_proxy_id);
+            MINI_SO_CHECK(side_a.dropped() == 0 && side_b.dropped() == 0);
+            
+            env.unregister_agent(controller_proxy_id);
+            env.unregister_agent(motor_proxy_id);
+        }
+        ShmChannel::unlink(name);
+        env.unregister_agent(motor.id());
+        env.unregister_agent(controller.id());
+    }
+}
+
+int main() {
+    check_ring();
+    check_round_trip();
+    return MINI_SO_TEST_RESULT("shm transport");
+}
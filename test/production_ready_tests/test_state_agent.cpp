@@ -0,0 +1,141 @@
+/**
+ * @file test_state_agent.cpp
+ * @brief 계층형 상태 머신 Agent (state/state_agent.h) - 전이, 진입/종료 훅 순서, 상태 범위 timeout
+ *
+ * - 첫 메시지에서 초기 상태로 진입, 전이는 공통 조상까지 on_leave(하위 → 상위), 대상까지 on_enter(상위 → 하위)
+ * - 하위 상태가 false를 반환한 메시지는 부모 상태 테이블로 전달
+ * - 훅 안에서 요청한 전이는 현재 전이가 끝난 뒤 수행, 자기 전이는 종료 후 재진입
+ * - state_timeout은 상태(또는 하위 상태)에 머무는 동안만 유효 - 형제 하위 상태로 옮기면 취소
+ */
+#include "mini_sobjectizer/state/state_agent.h"
+#include "test_support.h"
+
+#include <string>
+
+using namespace mini_so;
+
+namespace {
+    struct Takeoff { uint32_t unused; };
+    struct Land { uint32_t unused; };
+    struct Waypoint { uint32_t index; };
+    struct Boost { uint32_t unused; };
+    
+    enum class Flight : uint8_t { GROUNDED, AIRBORNE, HOVERING, CRUISING, CLIMBING, COUNT };
+    
+    class Drone : public StateAgent<Drone, Flight, Flight::COUNT> {
+    public:
+        std::string log;                 // 훅 순서: +진입 / -종료 (상태 첫 글자)
+        uint32_t airborne_waypoints = 0;
+        
+        Drone() noexcept : StateAgent(Flight::GROUNDED) {}
+        
+        void on_takeoff(const Takeoff&) noexcept { transition_to(Flight::HOVERING); }
+        void on_land(const Land&) noexcept { transition_to(Flight::GROUNDED); }
+        // index 0은 HOVERING이 처리하지 않음 - AIRBORNE 테이블로
+        bool on_hover_waypoint(const Waypoint& wp) noexcept {
+            if (wp.index == 0) return false;
+            transition_to(Flight::CRUISING);
+            return true;
+        }
+        void on_airborne_waypoint(const Waypoint&) noexcept { ++airborne_waypoints; }
+        void on_boost(const Boost&) noexcept { transition_to(Flight::CRUISING); }  // 자기 전이
+        
+        void enter_grounded() noexcept { log += "+G"; }
+        void leave_grounded() noexcept { log += "-G"; }
+        void enter_airborne() noexcept { log += "+A"; }
+        void leave_airborne() noexcept { log += "-A"; }
+        void enter_hovering() noexcept { log += "+H"; }
+        void leave_hovering() noexcept { log += "-H"; }
+        void enter_cruising() noexcept { log += "+C"; }
+        void leave_cruising() noexcept { log += "-C"; }
+        // 진입 훅 안의 전이 - CLIMBING 진입이 끝난 뒤 CRUISING으로
+        void enter_climbing() noexcept {
+            log += "+L";
+            transition_to(Flight::CRUISING);
+        }
+        void leave_climbing() noexcept { log += "-L"; }
+        
+        using states = state_table<
+            state<Flight::GROUNDED, on<Takeoff, &Drone::on_takeoff>,
+                  on_enter<&Drone::enter_grounded>, on_leave<&Drone::leave_grounded>>,
+            state<Flight::AIRBORNE, on<Land, &Drone::on_land>, on<Waypoint, &Drone::on_airborne_waypoint>,
+                  on_enter<&Drone::enter_airborne>, on_leave<&Drone::leave_airborne>>,
+            substate<Flight::HOVERING, Flight::AIRBORNE, on<Waypoint, &Drone::on_hover_waypoint>,
+                     on_enter<&Drone::enter_hovering>, on_leave<&Drone::leave_hovering>,
+                     state_timeout<50, Flight::GROUNDED>>,
+            substate<Flight::CRUISING, Flight::AIRBORNE, on<Boost, &Drone::on_boost>,
+                     on_enter<&Drone::enter_cruising>, on_leave<&Drone::leave_cruising>>,
+            substate<Flight::CLIMBING, Flight::AIRBORNE,
+                     on_enter<&Drone::enter_climbing>, on_leave<&Drone::leave_climbing>>>;
+        
+        bool climb() noexcept { return transition_to(Flight::CLIMBING); }
+    };
+    
+    template<typename T>
+    void deliver(Environment& env, const Drone& drone, const T& message) {
+        MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, drone.id(), message));
+        env.process_all_messages();
+    }
+    
+    // UNIT_TEST 시계는 now() 호출마다 10틱 - timeout(50) 몇 배만큼 타이머를 돌림
+    void run_timers(Environment& env) {
+        for (int i = 0; i < 40; ++i) env.run();
+    }
+}
+
+int main() {
+    Environment& env = Environment::instance();
+    System::instance().initialize();
+    static Drone drone;
+    env.register_agent(&drone);
+    
+    // 첫 메시지 전에는 진입하지 않음
+    MINI_SO_CHECK(drone.current_state() == Flight::GROUNDED && drone.log.empty());
+    
+    // GROUNDED → HOVERING: 최상위 종료 후 AIRBORNE, HOVERING 순서로 진입
+    deliver(env, drone, Takeoff{});
+    MINI_SO_CHECK(drone.log == "+G-G+A+H");
+    MINI_SO_CHECK(drone.current_state() == Flight::HOVERING && drone.in_state(Flight::AIRBORNE));
+    MINI_SO_CHECK(!drone.in_state(Flight::GROUNDED));
+    
+    // 하위 상태가 거부한 메시지는 부모 상태가 처리
+    deliver(env, drone, Waypoint{0});
+    MINI_SO_CHECK(drone.airborne_waypoints == 1 && drone.current_state() == Flight::HOVERING);
+    
+    // 형제 하위 상태로: AIRBORNE은 유지, HOVERING의 timeout은 취소
+    drone.log.clear();
+    deliver(env, drone, Waypoint{1});
+    MINI_SO_CHECK(drone.log == "-H+C" && drone.current_state() == Flight::CRUISING);
+    run_timers(env);
+    MINI_SO_CHECK(drone.current_state() == Flight::CRUISING);
+    
+    // 자기 전이는 종료 후 재진입
+    drone.log.clear();
+    deliver(env, drone, Boost{});
+    MINI_SO_CHECK(drone.log == "-C+C" && drone.current_state() == Flight::CRUISING);
+    
+    // 진입 훅 안의 전이는 현재 전이가 끝난 뒤 수행
+    drone.log.clear();
+    MINI_SO_CHECK(drone.climb());
+    MINI_SO_CHECK(drone.log == "-C+L-L+C" && drone.current_state() == Flight::CRUISING);
+    
+    // 공통 조상(없음)까지 하위 → 상위 종료
+    drone.log.clear();
+    deliver(env, drone, Land{});
+    MINI_SO_CHECK(drone.log == "-C-A+G" && drone.current_state() == Flight::GROUNDED);
+    
+    // 어느 상태 테이블에도 없는 메시지는 처리되지 않음
+    const Message<Land> stray(Land{}, INVALID_AGENT_ID);
+    MINI_SO_CHECK(!drone.handle_message(stray));
+    
+    // HOVERING에 timeout 동안 머무르면 GROUNDED로
+    drone.log.clear();
+    deliver(env, drone, Takeoff{});
+    MINI_SO_CHECK(drone.current_state() == Flight::HOVERING);
+    run_timers(env);
+    MINI_SO_CHECK(drone.current_state() == Flight::GROUNDED);
+    MINI_SO_CHECK(drone.log == "-G+A+H-H-A+G");
+    
+    env.unregister_agent(drone.id());
+    return MINI_SO_TEST_RESULT("state agent");
+}
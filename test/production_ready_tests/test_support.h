@@ -0,0 +1,32 @@
+/**
+ * @file test_support.h
+ * @brief production_ready_tests 공용 검사 매크로 (외부 프레임워크 없음)
+ *
+ * 실패한 검사는 위치와 식을 출력하고 계속 진행, MINI_SO_TEST_RESULT()가 실패 수로 종료 코드를 정함.
+ */
+#pragma once
+
+#include <cstdio>
+
+namespace mini_so_test {
+    inline int& failures() noexcept {
+        static int count = 0;
+        return count;
+    }
+    
+    inline int result(const char* name) noexcept {
+        std::printf("[%s] %s (%d failure%s)\n", failures() == 0 ? "PASS" : "FAIL", name, failures(),
+                    failures() == 1 ? "" : "s");
+        return failures() == 0 ? 0 : 1;
+    }
+}
+
+#define MINI_SO_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            ++mini_so_test::failures(); \
+            std::printf("  %s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+        } \
+    } while (0)
+
+#define MINI_SO_TEST_RESULT(name) mini_so_test::result(name)
@@ -0,0 +1,100 @@
+/**
+ * @file test_timer_wheel.cpp
+ * @brief 계층형 타이머 휠 - 단계 cascade, 주기 재설정, 취소
+ *
+ * - 0단계(5틱), 1단계(300틱, >= 64), 2단계(5000틱, >= 4096) 타이머가 정확한 틱에 한 번씩 발사
+ * - 주기 타이머(70틱)는 매 주기 재설정되어 경계를 넘어도 간격 유지
+ * - 취소된 타이머와 해제된 대상의 타이머는 발사되지 않음
+ *
+ * 휠을 직접 한 틱씩 진행하고 Post 함수에서 발사 틱을 기록 (Environment 전송 경로는 거치지 않음)
+ */
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#include "test_support.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace mini_so;
+
+namespace {
+    struct Fire {
+        uint32_t tag;
+        TimePoint tick;
+    };
+    
+    std::vector<Fire> g_fires;
+    TimePoint g_tick = 0;
+    
+    bool record_fire(Environment&, AgentId, AgentId, const void* payload) noexcept {
+        uint32_t tag = 0;
+        std::memcpy(&tag, payload, sizeof(tag));
+        g_fires.push_back(Fire{tag, g_tick});
+        return true;
+    }
+    
+    // UNIT_TEST의 now()는 호출마다 10씩 증가 - arm이 읽을 값을 미리 계산
+    TimerId arm_tagged(detail::TimerWheel& wheel, uint32_t tag, Duration delay, Duration period,
+                       TimePoint& armed_at, AgentId target = 1) {
+        armed_at = now() + 10;
+        return wheel.arm(INVALID_AGENT_ID, target, &record_fire, &tag, sizeof(tag), delay, period);
+    }
+    
+    std::vector<TimePoint> fires_of(uint32_t tag) {
+        std::vector<TimePoint> ticks;
+        for (const Fire& fire : g_fires) {
+            if (fire.tag == tag) ticks.push_back(fire.tick);
+        }
+        return ticks;
+    }
+}
+
+int main() {
+    Environment& env = Environment::instance();
+    static detail::TimerWheel wheel;
+    
+    TimePoint at_short = 0, at_level1 = 0, at_level2 = 0, at_periodic = 0, at_cancelled = 0, at_target = 0;
+    MINI_SO_CHECK(arm_tagged(wheel, 1, 5, 0, at_short) != INVALID_TIMER_ID);
+    MINI_SO_CHECK(arm_tagged(wheel, 2, 300, 0, at_level1) != INVALID_TIMER_ID);
+    MINI_SO_CHECK(arm_tagged(wheel, 3, 5000, 0, at_level2) != INVALID_TIMER_ID);
+    MINI_SO_CHECK(arm_tagged(wheel, 4, 70, 70, at_periodic) != INVALID_TIMER_ID);
+    const TimerId cancelled = arm_tagged(wheel, 5, 100, 0, at_cancelled);
+    MINI_SO_CHECK(arm_tagged(wheel, 6, 200, 50, at_target, 7) != INVALID_TIMER_ID);
+    MINI_SO_CHECK(wheel.active() == 6);
+    
+    MINI_SO_CHECK(wheel.cancel(cancelled));
+    MINI_SO_CHECK(!wheel.cancel(cancelled));  // 두 번째 취소는 실패
+    wheel.cancel_target(7);
+    MINI_SO_CHECK(wheel.active() == 4);
+    
+    Duration remaining = 0;
+    MINI_SO_CHECK(wheel.next_expiry(at_short, remaining) && remaining == 5);
+    
+    const TimePoint end = at_short + 5200;
+    for (g_tick = at_short + 1; g_tick != end + 1; ++g_tick) {
+        wheel.advance(env, g_tick);
+    }
+    
+    const std::vector<TimePoint> short_fires = fires_of(1);
+    const std::vector<TimePoint> level1_fires = fires_of(2);
+    const std::vector<TimePoint> level2_fires = fires_of(3);
+    MINI_SO_CHECK(short_fires.size() == 1 && short_fires[0] == at_short + 5);
+    MINI_SO_CHECK(level1_fires.size() == 1 && level1_fires[0] == at_level1 + 300);
+    MINI_SO_CHECK(level2_fires.size() == 1 && level2_fires[0] == at_level2 + 5000);
+    MINI_SO_CHECK(fires_of(5).empty() && fires_of(6).empty());
+    
+    // 주기 타이머: 첫 발사 delay, 이후 period 간격 (1단계 슬롯 경계를 여러 번 넘음)
+    const std::vector<TimePoint> periodic = fires_of(4);
+    MINI_SO_CHECK(periodic.size() == (end - at_periodic) / 70);
+    for (std::size_t i = 0; i < periodic.size(); ++i) {
+        MINI_SO_CHECK(periodic[i] == at_periodic + 70 * (i + 1));
+    }
+    MINI_SO_CHECK(wheel.active() == 1);  // 주기 타이머만 남음
+    
+    // 한 번에 크게 진행해도 틱 단위로 따라가며 주기마다 발사
+    g_fires.clear();
+    g_tick = end + 700;
+    MINI_SO_CHECK(wheel.advance(env, g_tick) == 10);
+    MINI_SO_CHECK(fires_of(4).size() == 10);
+    
+    return MINI_SO_TEST_RESULT("timer wheel");
+}
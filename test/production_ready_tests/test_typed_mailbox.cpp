@@ -0,0 +1,95 @@
+/**
+ * @file test_typed_mailbox.cpp
+ * @brief 타입 전용 메일박스(TypedMailbox) - 표지 경로와 가득 찬 메인 메일박스
+ *
+ * - T 전송은 box에 들어가고 메인 메일박스에는 표지 하나만 남음
+ * - 메인 메일박스가 가득 차 표지를 넣지 못해도 값은 box에 남아, 메인을 비운 뒤 전달됨
+ * - box가 가득 차면 새 메시지를 버림 (dropped, try_send는 QUEUE_FULL)
+ */
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#include "test_support.h"
+
+using namespace mini_so;
+
+namespace {
+    struct Cmd { uint32_t value; };
+    struct Reading { uint32_t value; };
+    
+    struct Sink : Agent {
+        TypedMailbox<Reading, 8> readings_box;
+        uint32_t cmds = 0;
+        uint32_t readings = 0;
+        uint32_t last_reading = 0;
+        
+        Sink() noexcept { attach_mailbox(readings_box); }
+        
+        bool handle_message(const MessageBase& msg) noexcept override {
+            if (msg.type_id() == MESSAGE_TYPE_ID(Cmd)) {
+                ++cmds;
+                return true;
+            }
+            if (msg.type_id() == MESSAGE_TYPE_ID(Reading)) {
+                ++readings;
+                last_reading = static_cast<const Message<Reading>&>(msg).data.value;
+                return true;
+            }
+            return false;
+        }
+    };
+    
+    void check_notice_path() {
+        Environment& env = Environment::instance();
+        static Sink sink;
+        MINI_SO_CHECK(env.register_agent(&sink) != INVALID_AGENT_ID);
+        
+        MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, sink.id(), Reading{1}));
+        MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, sink.id(), Reading{2}));
+        MINI_SO_CHECK(sink.readings_box.size() == 2);
+        MINI_SO_CHECK(env.total_pending_messages() == 1);  // 표지 하나
+        env.process_all_messages();
+        MINI_SO_CHECK(sink.readings == 2 && sink.last_reading == 2);
+        MINI_SO_CHECK(!sink.has_messages());
+        
+        // box가 가득 차면 새 메시지를 버림
+        for (uint32_t i = 0; i < 8; ++i) {
+            MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, sink.id(), Reading{10 + i}));
+        }
+        MINI_SO_CHECK(!env.send_message(INVALID_AGENT_ID, sink.id(), Reading{99}));
+        MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, sink.id(), Reading{99}) == SendResult::QUEUE_FULL);
+        MINI_SO_CHECK(sink.overload_stats().dropped == 2);
+        env.process_all_messages();
+        MINI_SO_CHECK(sink.readings == 10 && sink.last_reading == 17);
+        
+        env.unregister_agent(sink.id());
+    }
+    
+    void check_full_main_mailbox() {
+        Environment& env = Environment::instance();
+        static Sink sink;
+        MINI_SO_CHECK(env.register_agent(&sink) != INVALID_AGENT_ID);
+        
+        uint32_t accepted = 0;
+        while (env.send_message(INVALID_AGENT_ID, sink.id(), Cmd{accepted})) ++accepted;
+        MINI_SO_CHECK(accepted > 1);
+        
+        // 표지를 넣을 자리가 없어도 값은 box에 남아 전달된 것으로 봄
+        MINI_SO_CHECK(env.send_message(INVALID_AGENT_ID, sink.id(), Reading{1}));
+        MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, sink.id(), Reading{2}) == SendResult::SENT);
+        MINI_SO_CHECK(sink.readings_box.size() == 2);
+        MINI_SO_CHECK(env.total_pending_messages() == accepted);
+        
+        env.process_all_messages();
+        MINI_SO_CHECK(sink.cmds == accepted);
+        MINI_SO_CHECK(sink.readings == 2 && sink.last_reading == 2);
+        MINI_SO_CHECK(sink.readings_box.empty() && !sink.has_messages());
+        MINI_SO_CHECK(sink.overload_stats().dropped == 1);  // fill의 마지막 Cmd 시도만
+        
+        env.unregister_agent(sink.id());
+    }
+}
+
+int main() {
+    check_notice_path();
+    check_full_main_mailbox();
+    return MINI_SO_TEST_RESULT("typed mailbox");
+}
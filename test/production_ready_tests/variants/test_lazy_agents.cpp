@@ -0,0 +1,76 @@
+/**
+ * @file test_lazy_agents.cpp
+ * @brief 지연 활성화 Agent - 첫 전달(send_message, send_batch, publish)에서 생성
+ *
+ * MINI_SO_ENABLE_LAZY_AGENTS=1 변형 빌드 (test/CMakeLists.txt의 add_mini_so_variant_test)
+ *
+ * - register_lazy는 ID만 배정, 구독/조회는 활성화하지 않음
+ * - send_batch의 첫 메시지가 Agent를 생성하고 배치 전체가 그 메일박스에 전달됨
+ * - 해제 후 같은 Lazy를 다시 등록하면 남은 객체를 그대로 사용
+ */
+#include "mini_sobjectizer/mini_sobjectizer.h"
+#include "test_support.h"
+
+#if !MINI_SO_ENABLE_LAZY_AGENTS
+#error "test_lazy_agents requires MINI_SO_ENABLE_LAZY_AGENTS=1"
+#endif
+
+using namespace mini_so;
+
+namespace {
+    struct Cmd { uint32_t value; };
+    
+    struct Maintenance : Agent {
+        uint32_t received = 0;
+        uint32_t last = 0;
+        bool handle_message(const MessageBase& msg) noexcept override {
+            if (msg.type_id() != MESSAGE_TYPE_ID(Cmd)) return false;
+            ++received;
+            last = static_cast<const Message<Cmd>&>(msg).data.value;
+            return true;
+        }
+    };
+}
+
+int main() {
+    Environment& env = Environment::instance();
+    System::instance().initialize();
+    
+    static LazyArena<2 * lazy_arena_bytes<Maintenance>()> arena;
+    static Lazy<Maintenance> batch_target(arena);
+    static Lazy<Maintenance> topic_target(arena);
+    
+    const AgentId batch_id = env.register_lazy(batch_target);
+    const AgentId topic_id = env.register_lazy(topic_target);
+    MINI_SO_CHECK(batch_id != INVALID_AGENT_ID && topic_id != INVALID_AGENT_ID);
+    MINI_SO_CHECK(env.register_lazy(batch_target) == INVALID_AGENT_ID);  // 이미 예약됨
+    MINI_SO_CHECK(env.subscribe<Cmd>(topic_id));
+    MINI_SO_CHECK(!batch_target.active() && !topic_target.active());
+    
+    // 배치 전송이 활성화 후 전체를 전달
+    const Cmd cmds[3] = {{1}, {2}, {3}};
+    MINI_SO_CHECK(env.send_batch(INVALID_AGENT_ID, batch_id, Span<const Cmd>(cmds, 3)) == 3);
+    MINI_SO_CHECK(batch_target.active() && !topic_target.active());
+    env.process_all_messages();
+    MINI_SO_CHECK(batch_target.get()->received == 3 && batch_target.get()->last == 3);
+    
+    // 발행 구독자도 전달 시점에 활성화
+    MINI_SO_CHECK(env.publish(INVALID_AGENT_ID, Cmd{9}) == 1);
+    MINI_SO_CHECK(topic_target.active());
+    env.process_all_messages();
+    MINI_SO_CHECK(topic_target.get()->received == 1 && topic_target.get()->last == 9);
+    MINI_SO_CHECK(batch_target.failures() == 0 && arena.failures() == 0);
+    
+    // 해제 후 재등록 - 같은 객체, 새 ID
+    Maintenance* const created = batch_target.get();
+    env.unregister_agent(batch_id);
+    const AgentId again_id = env.register_lazy(batch_target);
+    MINI_SO_CHECK(again_id != INVALID_AGENT_ID && again_id != batch_id);
+    MINI_SO_CHECK(env.get_agent(again_id) == created);
+    MINI_SO_CHECK(env.try_send(INVALID_AGENT_ID, batch_id, Cmd{4}) == SendResult::NO_SUCH_AGENT);
+    MINI_SO_CHECK(env.send_batch(INVALID_AGENT_ID, again_id, Span<const Cmd>(cmds, 2)) == 2);
+    env.process_all_messages();
+    MINI_SO_CHECK(created->received == 5 && created->last == 2);
+    
+    return MINI_SO_TEST_RESULT("lazy agents");
+}
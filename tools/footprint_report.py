@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Mini SObjectizer 펌웨어 크기 보고 -> JSON.
+
+전체 이미지(text/data/bss)와 mini_so:: 네임스페이스 심볼 합계(헤더 템플릿 인스턴스 포함),
+라이브러리 아카이브의 오브젝트별 크기를 함께 기록. "~5KB code, 16 bytes BSS" 같은
+문서 수치를 업그레이드 전에 같은 기준으로 확인하기 위한 용도.
+
+    python3 tools/footprint_report.py --elf fw.elf --archive libmini_sobjectizer_target.a \\
+        [--nm arm-none-eabi-nm] [--size arm-none-eabi-size] [--cpu cortex-m4] [--out footprint.json]
+"""
+
+import argparse
+import json
+import subprocess
+import sys
+
+# nm 심볼 타입 -> 영역
+REGIONS = {"t": "text", "r": "text", "w": "text", "d": "data", "b": "bss"}
+
+
+def berkeley_sizes(size_tool, path):
+    """size -B 출력: [(text, data, bss, filename), ...]"""
+    output = subprocess.run([size_tool, "-B", path], check=True, capture_output=True, text=True).stdout
+    rows = []
+    for line in output.splitlines()[1:]:
+        fields = line.split(None, 5)
+        if len(fields) < 6:
+            continue
+        rows.append((int(fields[0]), int(fields[1]), int(fields[2]), fields[5].strip()))
+    return rows
+
+
+def framework_symbols(nm_tool, elf):
+    """링크된 이미지에서 mini_so:: 심볼의 영역별 크기 합계와 큰 심볼 목록."""
+    output = subprocess.run([nm_tool, "-S", "-C", "--size-sort", elf],
+                            check=True, capture_output=True, text=True).stdout
+    totals = {"text": 0, "data": 0, "bss": 0}
+    largest = []
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) < 4:
+            continue
+        size, kind, name = int(fields[1], 16), fields[2].lower(), fields[3]
+        region = REGIONS.get(kind)
+        if region is None or "mini_so::" not in name:
+            continue
+        totals[region] += size
+        largest.append({"name": name, "region": region, "bytes": size})
+    largest.sort(key=lambda symbol: symbol["bytes"], reverse=True)
+    return totals, largest[:20]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--elf", required=True)
+    parser.add_argument("--archive", required=True)
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--size", default="arm-none-eabi-size")
+    parser.add_argument("--cpu", default="")
+    parser.add_argument("--out")
+    args = parser.parse_args()
+
+    image = berkeley_sizes(args.size, args.elf)[0]
+    objects = berkeley_sizes(args.size, args.archive)
+    totals, largest = framework_symbols(args.nm, args.elf)
+
+    report = {
+        "cpu": args.cpu,
+        "image": {"text": image[0], "data": image[1], "bss": image[2]},
+        "framework": totals,
+        "objects": [{"object": name.split(" (ex ")[0], "text": text, "data": data, "bss": bss}
+                    for text, data, bss, name in objects],
+        "largest_symbols": largest,
+    }
+
+    text = json.dumps(report, indent=2)
+    if args.out:
+        with open(args.out, "w") as out:
+            out.write(text + "\n")
+    print("mini_so footprint: text=%d data=%d bss=%d (image text=%d data=%d bss=%d)" % (
+        totals["text"], totals["data"], totals["bss"], image[0], image[1], image[2]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
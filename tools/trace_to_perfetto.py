@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Mini SObjectizer trace dump -> Chrome trace JSON (Perfetto / chrome://tracing).
+
+입력: trace::dump_all() 바이너리 스트림 (코어별 [DumpHeader][Event x N], 리틀 엔디언)
+출력: Agent(target)별 트랙 - DISPATCH~HANDLED/REJECTED 구간 + SEND/DROP 인스턴트 이벤트
+
+    python3 tools/trace_to_perfetto.py dump.bin > trace.json
+"""
+
+import json
+import struct
+import sys
+
+MAGIC = 0x544F534D
+HEADER = struct.Struct("<IHHII")
+EVENT = struct.Struct("<IIII")
+KINDS = {1: "send", 2: "drop", 3: "dispatch", 4: "handled", 5: "rejected"}
+INVALID_AGENT = 0xFFFF
+
+
+def parse(data):
+    offset = 0
+    while offset + HEADER.size <= len(data):
+        magic, version, core, count, hz = HEADER.unpack_from(data, offset)
+        if magic != MAGIC or version != 1:
+            raise ValueError("bad trace header at offset %d" % offset)
+        offset += HEADER.size
+        for _ in range(count):
+            timestamp, info, agents, sequence = EVENT.unpack_from(data, offset)
+            offset += EVENT.size
+            if sequence == 0:
+                continue  # 덤프 중 덮어써진 슬롯
+            yield core, hz, sequence, timestamp, info >> 16, (info >> 8) & 0xFF, info & 0xFF, agents >> 16, agents & 0xFFFF
+
+
+def convert(data):
+    events = []
+    base = {}
+    last = {}
+    for core, hz, sequence, timestamp, type_id, kind, depth, sender, target in parse(data):
+        # 32비트 카운터 wrap 보정 (동시 기록으로 인한 작은 역전은 wrap이 아님)
+        previous = last.get(core)
+        wraps = base.get(core, 0)
+        if previous is not None and previous - timestamp > 0x80000000:
+            wraps += 1
+            base[core] = wraps
+        last[core] = timestamp
+        ts_us = ((wraps << 32) + timestamp) * 1e6 / hz
+
+        name = KINDS.get(kind, "unknown")
+        tid = target if target != INVALID_AGENT else 0xFFFF
+        args = {"type": "0x%04X" % type_id, "sender": sender, "depth": depth, "seq": sequence}
+        if kind == 3:
+            events.append({"name": "type 0x%04X" % type_id, "ph": "B", "ts": ts_us, "pid": core, "tid": tid, "args": args})
+        elif kind in (4, 5):
+            events.append({"name": "type 0x%04X" % type_id, "ph": "E", "ts": ts_us, "pid": core, "tid": tid,
+                           "args": {"result": name}})
+        else:
+            events.append({"name": name, "ph": "i", "s": "t", "ts": ts_us, "pid": core, "tid": tid, "args": args})
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write("usage: %s dump.bin\n" % argv[0])
+        return 2
+    with open(argv[1], "rb") as stream:
+        json.dump(convert(stream.read()), sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))